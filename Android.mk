@@ -33,6 +33,7 @@ LOCAL_SRC_FILES := \
     source/rotate_win.cc        \
     source/row_any.cc           \
     source/row_common.cc        \
+    source/row_dispatch.cc      \
     source/row_gcc.cc           \
     source/row_neon.cc          \
     source/row_neon64.cc        \
@@ -50,6 +50,18 @@ extern "C" {
 #define HAS_HAMMINGDISTANCE_AVX2
 #endif
 
+// The following are available for GCC and clang x64:
+#if !defined(LIBYUV_DISABLE_X86) && defined(__x86_64__) && \
+    !defined(LIBYUV_ENABLE_ROWWIN)
+#define HAS_SSIMSUMSROW_SSE2
+#if defined(CLANG_HAS_AVX2) || defined(GCC_HAS_AVX2)
+#define HAS_SSIMSUMSROW_AVX2
+#endif
+#if defined(CLANG_HAS_AVX512) || defined(GCC_HAS_AVX512)
+#define HAS_SSIMSUMSROW_AVX512BW
+#endif
+#endif
+
 // The following are available for Neon:
 #if !defined(LIBYUV_DISABLE_NEON) && \
     (defined(__ARM_NEON__) || defined(LIBYUV_NEON) || defined(__aarch64__))
@@ -99,6 +111,37 @@ uint32_t SumSquareError_NEON_DotProd(const uint8_t* src_a,
                                      const uint8_t* src_b,
                                      int count);
 
+// Sums of a, b, a * a, b * b and a * b for each 4x4 block of a 4 row strip.
+// dst_sums holds 5 planes of width / 4 sums, sums_stride elements apart.
+void SsimSumsRow_C(const uint8_t* src_a,
+                   int stride_a,
+                   const uint8_t* src_b,
+                   int stride_b,
+                   uint32_t* dst_sums,
+                   int sums_stride,
+                   int width);
+void SsimSumsRow_SSE2(const uint8_t* src_a,
+                      int stride_a,
+                      const uint8_t* src_b,
+                      int stride_b,
+                      uint32_t* dst_sums,
+                      int sums_stride,
+                      int width);
+void SsimSumsRow_AVX2(const uint8_t* src_a,
+                      int stride_a,
+                      const uint8_t* src_b,
+                      int stride_b,
+                      uint32_t* dst_sums,
+                      int sums_stride,
+                      int width);
+void SsimSumsRow_AVX512BW(const uint8_t* src_a,
+                          int stride_a,
+                          const uint8_t* src_b,
+                          int stride_b,
+                          uint32_t* dst_sums,
+                          int sums_stride,
+                          int width);
+
 uint32_t HashDjb2_C(const uint8_t* src, int count, uint32_t seed);
 uint32_t HashDjb2_SSE41(const uint8_t* src, int count, uint32_t seed);
 uint32_t HashDjb2_AVX2(const uint8_t* src, int count, uint32_t seed);
@@ -14,6 +14,7 @@
 #include "libyuv/basic_types.h"
 
 #include "libyuv/rotate.h"  // For enum RotationMode.
+#include "libyuv/scale.h"   // For enum FilterMode.
 
 // TODO(fbarchard): fix WebRTC source to include following libyuv headers:
 #include "libyuv/convert_argb.h"      // For WebRTC I420ToARGB. b/620
@@ -1117,6 +1118,74 @@ int MJPGToNV12(const uint8_t* sample,
                int dst_width,
                int dst_height);
 
+// MJPG to I420 and NV12 scaled to dst_width by dst_height.  The frame is
+// decoded with the largest libjpeg DCT scaling (1/2, 1/4 or 1/8) that is not
+// smaller than the destination, which skips most of the IDCT work of a full
+// size decode, and then scaled the rest of the way with filtering.
+LIBYUV_API
+int MJPGToI420Scaled(const uint8_t* sample,
+                     size_t sample_size,
+                     uint8_t* dst_y,
+                     int dst_stride_y,
+                     uint8_t* dst_u,
+                     int dst_stride_u,
+                     uint8_t* dst_v,
+                     int dst_stride_v,
+                     int src_width,
+                     int src_height,
+                     int dst_width,
+                     int dst_height,
+                     enum FilterMode filtering);
+
+LIBYUV_API
+int MJPGToNV12Scaled(const uint8_t* sample,
+                     size_t sample_size,
+                     uint8_t* dst_y,
+                     int dst_stride_y,
+                     uint8_t* dst_uv,
+                     int dst_stride_uv,
+                     int src_width,
+                     int src_height,
+                     int dst_width,
+                     int dst_height,
+                     enum FilterMode filtering);
+
+// MJPG to I420 and NV12 for the crop_width by crop_height rectangle at
+// crop_x, crop_y of the frame.  Scanlines above and iMCU columns beside the
+// rectangle are skipped without an IDCT where libjpeg supports it, and
+// decoding stops after the last row of the rectangle, so decode time scales
+// with the area of the rectangle.  Even crop_x and crop_y give the same
+// result as cropping a full decode.
+LIBYUV_API
+int MJPGToI420Crop(const uint8_t* sample,
+                   size_t sample_size,
+                   uint8_t* dst_y,
+                   int dst_stride_y,
+                   uint8_t* dst_u,
+                   int dst_stride_u,
+                   uint8_t* dst_v,
+                   int dst_stride_v,
+                   int src_width,
+                   int src_height,
+                   int crop_x,
+                   int crop_y,
+                   int crop_width,
+                   int crop_height);
+
+LIBYUV_API
+int MJPGToNV12Crop(const uint8_t* sample,
+                   size_t sample_size,
+                   uint8_t* dst_y,
+                   int dst_stride_y,
+                   uint8_t* dst_uv,
+                   int dst_stride_uv,
+                   int src_width,
+                   int src_height,
+                   int crop_x,
+                   int crop_y,
+                   int crop_width,
+                   int crop_height);
+
 // Query size of MJPG in pixels.
 LIBYUV_API
 int MJPGSize(const uint8_t* sample,
@@ -1124,6 +1193,69 @@ int MJPGSize(const uint8_t* sample,
              int* width,
              int* height);
 
+// MJPG decoding session for a stream of camera frames.  A session keeps the
+// jpeg decoder state and row buffers alive between frames, so that decoding a
+// frame of the same geometry as the previous one does no setup beyond parsing
+// its header.  A session may only be used by one thread at a time.
+struct MJPGSession;
+
+// Returns NULL if memory is exhausted.
+LIBYUV_API
+struct MJPGSession* MJPGSessionCreate(void);
+
+// Decode frames with restart markers with up to max_jobs concurrent jobs on
+// executor, as the MT scalers do.  A NULL executor decodes sequentially.
+LIBYUV_API
+void MJPGSessionSetExecutor(struct MJPGSession* session,
+                            ScaleExecutor executor,
+                            void* executor_context,
+                            int max_jobs);
+
+LIBYUV_API
+void MJPGSessionDestroy(struct MJPGSession* session);
+
+// MJPGToI420, MJPGToNV21 and MJPGToNV12 decoding with a session.
+LIBYUV_API
+int MJPGSessionToI420(struct MJPGSession* session,
+                      const uint8_t* sample,
+                      size_t sample_size,
+                      uint8_t* dst_y,
+                      int dst_stride_y,
+                      uint8_t* dst_u,
+                      int dst_stride_u,
+                      uint8_t* dst_v,
+                      int dst_stride_v,
+                      int src_width,
+                      int src_height,
+                      int dst_width,
+                      int dst_height);
+
+LIBYUV_API
+int MJPGSessionToNV21(struct MJPGSession* session,
+                      const uint8_t* sample,
+                      size_t sample_size,
+                      uint8_t* dst_y,
+                      int dst_stride_y,
+                      uint8_t* dst_vu,
+                      int dst_stride_vu,
+                      int src_width,
+                      int src_height,
+                      int dst_width,
+                      int dst_height);
+
+LIBYUV_API
+int MJPGSessionToNV12(struct MJPGSession* session,
+                      const uint8_t* sample,
+                      size_t sample_size,
+                      uint8_t* dst_y,
+                      int dst_stride_y,
+                      uint8_t* dst_uv,
+                      int dst_stride_uv,
+                      int src_width,
+                      int src_height,
+                      int dst_width,
+                      int dst_height);
+
 // Convert camera sample to I420 with cropping, rotation and vertical flip.
 // "src_size" is needed to parse MJPG.
 // "dst_stride_y" number of bytes in a row of the dst_y plane.
@@ -1164,6 +1296,108 @@ int ConvertToI420(const uint8_t* sample,
                   enum RotationMode rotation,
                   uint32_t fourcc);
 
+// Bytes of scratch that ConvertToI420Scratch needs for a crop of crop_width
+// by crop_height, whatever the rotation and fourcc, or -1 if the size is not
+// supported.
+LIBYUV_API
+int ConvertToI420ScratchSize(int crop_width, int crop_height);
+
+// As ConvertToI420, with scratch, a caller buffer of scratch_size bytes, for
+// the temporary I420 image used when the fourcc cannot be rotated in one pass
+// or the conversion is in place, so that no memory is allocated.  A NULL
+// scratch allocates as ConvertToI420 does.  Returns -1 if scratch is smaller
+// than ConvertToI420ScratchSize.
+LIBYUV_API
+int ConvertToI420Scratch(const uint8_t* sample,
+                         size_t sample_size,
+                         uint8_t* dst_y,
+                         int dst_stride_y,
+                         uint8_t* dst_u,
+                         int dst_stride_u,
+                         uint8_t* dst_v,
+                         int dst_stride_v,
+                         int crop_x,
+                         int crop_y,
+                         int src_width,
+                         int src_height,
+                         int crop_width,
+                         int crop_height,
+                         enum RotationMode rotation,
+                         uint32_t fourcc,
+                         uint8_t* scratch,
+                         int scratch_size);
+
+// Convert camera sample to a scaled frame in one pass, as ConvertToI420
+// (without rotation), I420Scale and a conversion from I420 would, but a band
+// of rows at a time so that no intermediate frame is written to memory.
+// "src_fourcc" is any fourcc that ConvertToI420 supports.
+// "crop_x" / "crop_y" / "crop_width" / "crop_height" is the source rectangle
+//   scaled to "dst_width" by "dst_height".
+// "dst_fourcc" is I420 or YV12 (dst_y, dst_u and dst_v planes), NV12 or NV21
+//   (dst_y and dst_u as the interleaved chroma plane) or ARGB or ABGR (dst_y
+//   as the packed plane).  Unused planes may be NULL.
+// Returns 0 for successful; -1 for invalid parameter. Non-zero for failure.
+LIBYUV_API
+int ConvertCropScale(const uint8_t* sample,
+                     size_t sample_size,
+                     int src_width,
+                     int src_height,
+                     uint32_t src_fourcc,
+                     int crop_x,
+                     int crop_y,
+                     int crop_width,
+                     int crop_height,
+                     uint8_t* dst_y,
+                     int dst_stride_y,
+                     uint8_t* dst_u,
+                     int dst_stride_u,
+                     uint8_t* dst_v,
+                     int dst_stride_v,
+                     int dst_width,
+                     int dst_height,
+                     enum FilterMode filtering,
+                     uint32_t dst_fourcc);
+
+// Bytes of scratch that ConvertCropScaleScratch needs, or -1 if the sizes or
+// fourccs are not supported.
+LIBYUV_API
+int ConvertCropScaleScratchSize(int src_width,
+                                int src_height,
+                                uint32_t src_fourcc,
+                                int crop_width,
+                                int crop_height,
+                                int dst_width,
+                                int dst_height,
+                                enum FilterMode filtering,
+                                uint32_t dst_fourcc);
+
+// As ConvertCropScale, with scratch, a caller buffer of scratch_size bytes,
+// for the window of converted rows and the band and row buffers, so that no
+// memory is allocated.  A NULL scratch allocates as ConvertCropScale does.
+// Returns -1 if scratch is smaller than ConvertCropScaleScratchSize.
+LIBYUV_API
+int ConvertCropScaleScratch(const uint8_t* sample,
+                            size_t sample_size,
+                            int src_width,
+                            int src_height,
+                            uint32_t src_fourcc,
+                            int crop_x,
+                            int crop_y,
+                            int crop_width,
+                            int crop_height,
+                            uint8_t* dst_y,
+                            int dst_stride_y,
+                            uint8_t* dst_u,
+                            int dst_stride_u,
+                            uint8_t* dst_v,
+                            int dst_stride_v,
+                            int dst_width,
+                            int dst_height,
+                            enum FilterMode filtering,
+                            uint32_t dst_fourcc,
+                            uint8_t* scratch,
+                            int scratch_size);
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
@@ -1142,6 +1142,34 @@ int MJPGToARGB(const uint8_t* sample,
                int dst_width,
                int dst_height);
 
+// MJPG to ARGB for the crop_width by crop_height rectangle at crop_x, crop_y
+// of the frame, decoding as little outside the rectangle as libjpeg allows.
+LIBYUV_API
+int MJPGToARGBCrop(const uint8_t* sample,
+                   size_t sample_size,
+                   uint8_t* dst_argb,
+                   int dst_stride_argb,
+                   int src_width,
+                   int src_height,
+                   int crop_x,
+                   int crop_y,
+                   int crop_width,
+                   int crop_height);
+
+// MJPGToARGB with a session from MJPGSessionCreate.
+struct MJPGSession;
+
+LIBYUV_API
+int MJPGSessionToARGB(struct MJPGSession* session,
+                      const uint8_t* sample,
+                      size_t sample_size,
+                      uint8_t* dst_argb,
+                      int dst_stride_argb,
+                      int src_width,
+                      int src_height,
+                      int dst_width,
+                      int dst_height);
+
 // Convert Android420 to ARGB.
 LIBYUV_API
 int Android420ToARGB(const uint8_t* src_y,
@@ -1868,6 +1896,156 @@ int NV21ToARGBMatrix(const uint8_t* src_y,
                      int width,
                      int height);
 
+// Convert I420 to ARGB with matrix and rotation, in a single pass.  Matches
+// I420Rotate followed by I420ToARGBMatrix, but rotates a band at a time in
+// cache instead of writing a rotated I420 frame.
+LIBYUV_API
+int I420ToARGBMatrixRotate(const uint8_t* src_y,
+                           int src_stride_y,
+                           const uint8_t* src_u,
+                           int src_stride_u,
+                           const uint8_t* src_v,
+                           int src_stride_v,
+                           uint8_t* dst_argb,
+                           int dst_stride_argb,
+                           const struct YuvConstants* yuvconstants,
+                           int width,
+                           int height,
+                           enum RotationMode mode);
+
+// Convert NV12 to ARGB with matrix and rotation, in a single pass.
+LIBYUV_API
+int NV12ToARGBMatrixRotate(const uint8_t* src_y,
+                           int src_stride_y,
+                           const uint8_t* src_uv,
+                           int src_stride_uv,
+                           uint8_t* dst_argb,
+                           int dst_stride_argb,
+                           const struct YuvConstants* yuvconstants,
+                           int width,
+                           int height,
+                           enum RotationMode mode);
+
+// Convert NV21 to ARGB with matrix and rotation, in a single pass.
+LIBYUV_API
+int NV21ToARGBMatrixRotate(const uint8_t* src_y,
+                           int src_stride_y,
+                           const uint8_t* src_vu,
+                           int src_stride_vu,
+                           uint8_t* dst_argb,
+                           int dst_stride_argb,
+                           const struct YuvConstants* yuvconstants,
+                           int width,
+                           int height,
+                           enum RotationMode mode);
+
+// Bytes of scratch needed by the *MatrixRotateScratch functions for the
+// given source size and rotation, or -1 if the arguments are not supported.
+LIBYUV_API
+int YUVToARGBMatrixRotateScratchSize(int width,
+                                     int height,
+                                     enum RotationMode mode);
+
+// As the *MatrixRotate functions, with scratch, a caller buffer of
+// scratch_size bytes, for the rotated band so that no memory is allocated.
+// Returns -1 if scratch_size is less than YUVToARGBMatrixRotateScratchSize.
+// A NULL scratch allocates as the *MatrixRotate functions do.
+LIBYUV_API
+int I420ToARGBMatrixRotateScratch(const uint8_t* src_y,
+                                  int src_stride_y,
+                                  const uint8_t* src_u,
+                                  int src_stride_u,
+                                  const uint8_t* src_v,
+                                  int src_stride_v,
+                                  uint8_t* dst_argb,
+                                  int dst_stride_argb,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum RotationMode mode,
+                                  uint8_t* scratch,
+                                  int scratch_size);
+
+LIBYUV_API
+int NV12ToARGBMatrixRotateScratch(const uint8_t* src_y,
+                                  int src_stride_y,
+                                  const uint8_t* src_uv,
+                                  int src_stride_uv,
+                                  uint8_t* dst_argb,
+                                  int dst_stride_argb,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum RotationMode mode,
+                                  uint8_t* scratch,
+                                  int scratch_size);
+
+LIBYUV_API
+int NV21ToARGBMatrixRotateScratch(const uint8_t* src_y,
+                                  int src_stride_y,
+                                  const uint8_t* src_vu,
+                                  int src_stride_vu,
+                                  uint8_t* dst_argb,
+                                  int dst_stride_argb,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum RotationMode mode,
+                                  uint8_t* scratch,
+                                  int scratch_size);
+
+// Convert I420 to ARGB with rotation.
+LIBYUV_API
+int I420ToARGBRotate(const uint8_t* src_y,
+                     int src_stride_y,
+                     const uint8_t* src_u,
+                     int src_stride_u,
+                     const uint8_t* src_v,
+                     int src_stride_v,
+                     uint8_t* dst_argb,
+                     int dst_stride_argb,
+                     int width,
+                     int height,
+                     enum RotationMode mode);
+
+// Convert I420 to ABGR with rotation.
+LIBYUV_API
+int I420ToABGRRotate(const uint8_t* src_y,
+                     int src_stride_y,
+                     const uint8_t* src_u,
+                     int src_stride_u,
+                     const uint8_t* src_v,
+                     int src_stride_v,
+                     uint8_t* dst_abgr,
+                     int dst_stride_abgr,
+                     int width,
+                     int height,
+                     enum RotationMode mode);
+
+// Convert NV12 to ARGB with rotation.
+LIBYUV_API
+int NV12ToARGBRotate(const uint8_t* src_y,
+                     int src_stride_y,
+                     const uint8_t* src_uv,
+                     int src_stride_uv,
+                     uint8_t* dst_argb,
+                     int dst_stride_argb,
+                     int width,
+                     int height,
+                     enum RotationMode mode);
+
+// Convert NV12 to ABGR with rotation.
+LIBYUV_API
+int NV12ToABGRRotate(const uint8_t* src_y,
+                     int src_stride_y,
+                     const uint8_t* src_uv,
+                     int src_stride_uv,
+                     uint8_t* dst_abgr,
+                     int dst_stride_abgr,
+                     int width,
+                     int height,
+                     enum RotationMode mode);
+
 // Convert NV12 to RGB565 with matrix.
 LIBYUV_API
 int NV12ToRGB565Matrix(const uint8_t* src_y,
@@ -2291,6 +2469,277 @@ int P210ToAR30MatrixFilter(const uint16_t* src_y,
                            int height,
                            enum FilterMode filter);
 
+// Bytes of scratch needed by the *MatrixFilterScratch functions for images of
+// the given width, or -1 if the width is not supported.  One buffer of this
+// size serves every function and filter.
+LIBYUV_API
+int YUVToRGBMatrixFilterScratchSize(int width);
+
+// As the *MatrixFilter functions, with scratch, a caller buffer of
+// scratch_size bytes, for the upsampled chroma rows so that no memory is
+// allocated.  Returns -1 if scratch_size is less than
+// YUVToRGBMatrixFilterScratchSize(width).  A NULL scratch allocates as the
+// *MatrixFilter functions do.
+LIBYUV_API
+int I422ToRGB24MatrixFilterScratch(const uint8_t* src_y,
+                                   int src_stride_y,
+                                   const uint8_t* src_u,
+                                   int src_stride_u,
+                                   const uint8_t* src_v,
+                                   int src_stride_v,
+                                   uint8_t* dst_rgb24,
+                                   int dst_stride_rgb24,
+                                   const struct YuvConstants* yuvconstants,
+                                   int width,
+                                   int height,
+                                   enum FilterMode filter,
+                                   uint8_t* scratch,
+                                   int scratch_size);
+
+LIBYUV_API
+int I420ToARGBMatrixFilterScratch(const uint8_t* src_y,
+                                  int src_stride_y,
+                                  const uint8_t* src_u,
+                                  int src_stride_u,
+                                  const uint8_t* src_v,
+                                  int src_stride_v,
+                                  uint8_t* dst_argb,
+                                  int dst_stride_argb,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum FilterMode filter,
+                                  uint8_t* scratch,
+                                  int scratch_size);
+
+LIBYUV_API
+int I422ToARGBMatrixFilterScratch(const uint8_t* src_y,
+                                  int src_stride_y,
+                                  const uint8_t* src_u,
+                                  int src_stride_u,
+                                  const uint8_t* src_v,
+                                  int src_stride_v,
+                                  uint8_t* dst_argb,
+                                  int dst_stride_argb,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum FilterMode filter,
+                                  uint8_t* scratch,
+                                  int scratch_size);
+
+LIBYUV_API
+int I420ToRGB24MatrixFilterScratch(const uint8_t* src_y,
+                                   int src_stride_y,
+                                   const uint8_t* src_u,
+                                   int src_stride_u,
+                                   const uint8_t* src_v,
+                                   int src_stride_v,
+                                   uint8_t* dst_rgb24,
+                                   int dst_stride_rgb24,
+                                   const struct YuvConstants* yuvconstants,
+                                   int width,
+                                   int height,
+                                   enum FilterMode filter,
+                                   uint8_t* scratch,
+                                   int scratch_size);
+
+LIBYUV_API
+int I010ToAR30MatrixFilterScratch(const uint16_t* src_y,
+                                  int src_stride_y,
+                                  const uint16_t* src_u,
+                                  int src_stride_u,
+                                  const uint16_t* src_v,
+                                  int src_stride_v,
+                                  uint8_t* dst_ar30,
+                                  int dst_stride_ar30,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum FilterMode filter,
+                                  uint8_t* scratch,
+                                  int scratch_size);
+
+LIBYUV_API
+int I210ToAR30MatrixFilterScratch(const uint16_t* src_y,
+                                  int src_stride_y,
+                                  const uint16_t* src_u,
+                                  int src_stride_u,
+                                  const uint16_t* src_v,
+                                  int src_stride_v,
+                                  uint8_t* dst_ar30,
+                                  int dst_stride_ar30,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum FilterMode filter,
+                                  uint8_t* scratch,
+                                  int scratch_size);
+
+LIBYUV_API
+int I010ToARGBMatrixFilterScratch(const uint16_t* src_y,
+                                  int src_stride_y,
+                                  const uint16_t* src_u,
+                                  int src_stride_u,
+                                  const uint16_t* src_v,
+                                  int src_stride_v,
+                                  uint8_t* dst_argb,
+                                  int dst_stride_argb,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum FilterMode filter,
+                                  uint8_t* scratch,
+                                  int scratch_size);
+
+LIBYUV_API
+int I210ToARGBMatrixFilterScratch(const uint16_t* src_y,
+                                  int src_stride_y,
+                                  const uint16_t* src_u,
+                                  int src_stride_u,
+                                  const uint16_t* src_v,
+                                  int src_stride_v,
+                                  uint8_t* dst_argb,
+                                  int dst_stride_argb,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum FilterMode filter,
+                                  uint8_t* scratch,
+                                  int scratch_size);
+
+LIBYUV_API
+int I420AlphaToARGBMatrixFilterScratch(const uint8_t* src_y,
+                                       int src_stride_y,
+                                       const uint8_t* src_u,
+                                       int src_stride_u,
+                                       const uint8_t* src_v,
+                                       int src_stride_v,
+                                       const uint8_t* src_a,
+                                       int src_stride_a,
+                                       uint8_t* dst_argb,
+                                       int dst_stride_argb,
+                                       const struct YuvConstants* yuvconstants,
+                                       int width,
+                                       int height,
+                                       int attenuate,
+                                       enum FilterMode filter,
+                                       uint8_t* scratch,
+                                       int scratch_size);
+
+LIBYUV_API
+int I422AlphaToARGBMatrixFilterScratch(const uint8_t* src_y,
+                                       int src_stride_y,
+                                       const uint8_t* src_u,
+                                       int src_stride_u,
+                                       const uint8_t* src_v,
+                                       int src_stride_v,
+                                       const uint8_t* src_a,
+                                       int src_stride_a,
+                                       uint8_t* dst_argb,
+                                       int dst_stride_argb,
+                                       const struct YuvConstants* yuvconstants,
+                                       int width,
+                                       int height,
+                                       int attenuate,
+                                       enum FilterMode filter,
+                                       uint8_t* scratch,
+                                       int scratch_size);
+
+LIBYUV_API
+int I010AlphaToARGBMatrixFilterScratch(const uint16_t* src_y,
+                                       int src_stride_y,
+                                       const uint16_t* src_u,
+                                       int src_stride_u,
+                                       const uint16_t* src_v,
+                                       int src_stride_v,
+                                       const uint16_t* src_a,
+                                       int src_stride_a,
+                                       uint8_t* dst_argb,
+                                       int dst_stride_argb,
+                                       const struct YuvConstants* yuvconstants,
+                                       int width,
+                                       int height,
+                                       int attenuate,
+                                       enum FilterMode filter,
+                                       uint8_t* scratch,
+                                       int scratch_size);
+
+LIBYUV_API
+int I210AlphaToARGBMatrixFilterScratch(const uint16_t* src_y,
+                                       int src_stride_y,
+                                       const uint16_t* src_u,
+                                       int src_stride_u,
+                                       const uint16_t* src_v,
+                                       int src_stride_v,
+                                       const uint16_t* src_a,
+                                       int src_stride_a,
+                                       uint8_t* dst_argb,
+                                       int dst_stride_argb,
+                                       const struct YuvConstants* yuvconstants,
+                                       int width,
+                                       int height,
+                                       int attenuate,
+                                       enum FilterMode filter,
+                                       uint8_t* scratch,
+                                       int scratch_size);
+
+LIBYUV_API
+int P010ToARGBMatrixFilterScratch(const uint16_t* src_y,
+                                  int src_stride_y,
+                                  const uint16_t* src_uv,
+                                  int src_stride_uv,
+                                  uint8_t* dst_argb,
+                                  int dst_stride_argb,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum FilterMode filter,
+                                  uint8_t* scratch,
+                                  int scratch_size);
+
+LIBYUV_API
+int P210ToARGBMatrixFilterScratch(const uint16_t* src_y,
+                                  int src_stride_y,
+                                  const uint16_t* src_uv,
+                                  int src_stride_uv,
+                                  uint8_t* dst_argb,
+                                  int dst_stride_argb,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum FilterMode filter,
+                                  uint8_t* scratch,
+                                  int scratch_size);
+
+LIBYUV_API
+int P010ToAR30MatrixFilterScratch(const uint16_t* src_y,
+                                  int src_stride_y,
+                                  const uint16_t* src_uv,
+                                  int src_stride_uv,
+                                  uint8_t* dst_ar30,
+                                  int dst_stride_ar30,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum FilterMode filter,
+                                  uint8_t* scratch,
+                                  int scratch_size);
+
+LIBYUV_API
+int P210ToAR30MatrixFilterScratch(const uint16_t* src_y,
+                                  int src_stride_y,
+                                  const uint16_t* src_uv,
+                                  int src_stride_uv,
+                                  uint8_t* dst_ar30,
+                                  int dst_stride_ar30,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum FilterMode filter,
+                                  uint8_t* scratch,
+                                  int scratch_size);
+
 // Convert camera sample to ARGB with cropping, rotation and vertical flip.
 // "sample_size" is needed to parse MJPG.
 // "dst_stride_argb" number of bytes in a row of the dst_argb plane.
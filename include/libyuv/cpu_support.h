@@ -57,6 +57,10 @@ extern "C" {
 #if (__GNUC__ > 4) || (__GNUC__ == 4 && (__GNUC_MINOR__ >= 7))
 #define GCC_HAS_AVX2 1
 #endif  // GNUC >= 4.7
+// gcc >= 7 required for AVX512.
+#if (__GNUC__ >= 7) && !defined(__clang__)
+#define GCC_HAS_AVX512 1
+#endif  // GNUC >= 7
 #endif  // __GNUC__
 
 // clang >= 3.4.0 required for AVX2.
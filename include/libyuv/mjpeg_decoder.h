@@ -12,6 +12,7 @@
 #define INCLUDE_LIBYUV_MJPEG_DECODER_H_
 
 #include "libyuv/basic_types.h"
+#include "libyuv/scale.h"  // For ScaleExecutor.
 
 #ifdef __cplusplus
 // NOTE: For a simplified public API use convert.h MJPGToI420().
@@ -54,6 +55,7 @@ struct BufferVector {
 };
 
 struct SetJmpErrorMgr;
+struct MJpegRestartWorker;
 
 // MJPEG ("Motion JPEG") is a pseudo-standard video codec where the frames are
 // simply independent JPEG images with a fixed huffman table (which is omitted).
@@ -93,6 +95,17 @@ class LIBYUV_API MJpegDecoder {
   // Returns height of the last loaded frame in pixels.
   int GetHeight();
 
+  // Decode frames at 1 / scale_denom of their size with libjpeg DCT scaling,
+  // which skips most of the IDCT work of a full size decode.  scale_denom may
+  // be 1, 2, 4 or 8.  Applies to frames loaded afterwards.
+  LIBYUV_BOOL SetScaleDenom(int scale_denom);
+
+  // Size of the decoded image in pixels: the frame size divided by the scale
+  // denominator, rounded up.
+  int GetOutputWidth();
+
+  int GetOutputHeight();
+
   // Returns format of the last loaded frame. The return value is one of the
   // kColorSpace* constants.
   int GetColorSpace();
@@ -105,6 +118,9 @@ class LIBYUV_API MJpegDecoder {
 
   int GetVertSampFactor(int component);
 
+  // Sub-sampling of the n-th decoded component relative to the output size.
+  // With DCT scaling libjpeg may decode chroma at a higher resolution than
+  // the sample factors give, e.g. a J420 frame at 1/2 size decodes as J444.
   int GetHorizSubSampFactor(int component);
 
   int GetVertSubSampFactor(int component);
@@ -132,11 +148,11 @@ class LIBYUV_API MJpegDecoder {
   LIBYUV_BOOL UnloadFrame();
 
   // Decodes the entire image into a one-buffer-per-color-component format.
-  // dst_width must match exactly. dst_height must be <= to image height; if
-  // less, the image is cropped. "planes" must have size equal to at least
-  // GetNumComponents() and they must point to non-overlapping buffers of size
-  // at least GetComponentSize(i). The pointers in planes are incremented
-  // to point to after the end of the written data.
+  // dst_width must match the output width exactly. dst_height must be <= to
+  // the output height; if less, the image is cropped. "planes" must have size
+  // equal to at least GetNumComponents() and they must point to
+  // non-overlapping buffers of size at least GetComponentSize(i). The pointers
+  // in planes are incremented to point to after the end of the written data.
   // TODO(fbarchard): Add dst_x, dst_y to allow specific rect to be decoded.
   LIBYUV_BOOL DecodeToBuffers(uint8_t** planes, int dst_width, int dst_height);
 
@@ -149,6 +165,36 @@ class LIBYUV_API MJpegDecoder {
                                int dst_width,
                                int dst_height);
 
+  // Decodes the rectangle at x, y of width by height pixels of the output
+  // image and passes it via repeated calls to a callback function, as
+  // DecodeToCallback does, with the same sub-sampling.  Chroma of a
+  // sub-sampled component comes from the sample that covers the left or top
+  // edge of the rectangle, so x and y should be multiples of the sub-sampling
+  // to match a full decode.  Only frames with 1 or 3 components are
+  // supported.  With libjpeg-turbo the scanlines above the rectangle are
+  // skipped and the iMCU columns beside it are cropped without an IDCT, and
+  // decoding stops after the last row of the rectangle.
+  LIBYUV_BOOL DecodeRectToCallback(CallbackFunction fn,
+                                   void* opaque,
+                                   int x,
+                                   int y,
+                                   int width,
+                                   int height);
+
+  // Decode frames with restart intervals on an executor, as the MT scalers
+  // do.  The scan is split at restart markers into up to max_jobs jobs that
+  // are decoded concurrently, each with its own libjpeg state.  Frames
+  // without restart markers on iMCU row boundaries are decoded sequentially.
+  // Applies to frames loaded afterwards. A NULL executor turns parallel
+  // decoding off.
+  void SetExecutor(ScaleExecutor executor,
+                   void* executor_context,
+                   int max_jobs);
+
+  // Number of restart intervals that the last loaded frame can be split
+  // into for parallel decoding, or 0 if it must be decoded sequentially.
+  int GetNumRestartSegments();
+
   // The helper function which recognizes the jpeg sub-sampling type.
   static JpegSubsamplingType JpegSubsamplingTypeHelper(
       int* subsample_x,
@@ -167,6 +213,10 @@ class LIBYUV_API MJpegDecoder {
 
   int GetComponentScanlinePadding(int component);
 
+  LIBYUV_BOOL FindRestartSegments();
+  LIBYUV_BOOL DecodeRestartSegments(uint8_t** planes, int dst_height);
+  static void DecodeRestartJob(void* job_context, int index);
+
   // A buffer holding the input data for a frame.
   Buffer buf_;
   BufferVector buf_vec_;
@@ -187,6 +237,28 @@ class LIBYUV_API MJpegDecoder {
   // output buffers. Large enough for just one iMCU row.
   uint8_t** databuf_;
   int* databuf_strides_;
+  int scale_denom_;  // DCT scaling of frames from LoadFrame.
+  // Scanlines and split planes for DecodeRectToCallback.
+  uint8_t* rectbuf_;
+  int rectbuf_size_;
+
+  // Parallel decoding of restart intervals.
+  ScaleExecutor executor_;
+  void* executor_context_;
+  int max_jobs_;
+  MJpegRestartWorker* workers_;  // max_jobs_ workers with libjpeg state.
+  // iMCU rows per restart interval, or 0 if the loaded frame has no restart
+  // markers on iMCU row boundaries.
+  int restart_rows_;
+  size_t scan_offset_;  // Offset of the entropy coded data of the scan.
+  // Offsets of the entropy coded data of each restart interval.
+  int num_segments_;
+  int segments_size_;
+  size_t* segment_begin_;
+  size_t* segment_end_;
+  // Frame buffer for DecodeToCallback when decoding in parallel.
+  uint8_t* framebuf_;
+  int framebuf_size_;
 };
 
 }  // namespace libyuv
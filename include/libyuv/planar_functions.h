@@ -839,6 +839,30 @@ int ARGBBlend(const uint8_t* src_argb0,
               int width,
               int height);
 
+// A layer for ARGBCompositeLayers.
+// Source is pre-multiplied by alpha using ARGBAttenuate.
+// x and y place the layer in the destination.  The layer may be smaller than
+// the destination or extend past its edges, and is clipped.
+struct ARGBLayer {
+  const uint8_t* src_argb;
+  int src_stride_argb;
+  int x;
+  int y;
+  int width;
+  int height;
+};
+
+// Alpha Blend a list of ARGB layers onto the destination in 1 pass.
+// layers[0] is blended first, so the last layer is on top.
+// Alpha of destination pixels covered by a layer is set to 255.
+LIBYUV_API
+int ARGBCompositeLayers(const struct ARGBLayer* layers,
+                        int num_layers,
+                        uint8_t* dst_argb,
+                        int dst_stride_argb,
+                        int width,
+                        int height);
+
 // Alpha Blend plane and store to destination.
 // Source is not pre-multiplied by alpha.
 LIBYUV_API
@@ -969,8 +993,9 @@ int ARGBComputeCumulativeSum(const uint8_t* src_argb,
                              int height);
 
 // Blur ARGB image.
-// dst_cumsum table of width * (height + 1) * 16 bytes aligned to
-//   16 byte boundary.
+// dst_cumsum table of width * (radius * 2 + 2) * 16 bytes aligned to
+//   16 byte boundary.  The table is a sliding window of rows.  If dst_cumsum
+//   is NULL the table is allocated internally.
 // dst_stride32_cumsum is number of ints in a row (width * 4).
 // radius is number of pixels around the center.  e.g. 1 = 3x3. 2=5x5.
 // Blur is optimized for radius of 5 (11x11) or less.
@@ -985,6 +1010,28 @@ int ARGBBlur(const uint8_t* src_argb,
              int height,
              int radius);
 
+// Integral image of a plane.  Each value is the sum of all source values
+// above and to the left of it, inclusive.  Sums wrap modulo 2^32, so the
+// difference of 4 corners is exact for any box up to 16843009 pixels.
+// dst_stride_sum is in uint32_t units.
+LIBYUV_API
+int IntegralPlane(const uint8_t* src_y,
+                  int src_stride_y,
+                  uint32_t* dst_sum,
+                  int dst_stride_sum,
+                  int width,
+                  int height);
+
+// Integral image of the squares of a plane, e.g. for variance or SSIM.
+// Box sums of squares are exact for boxes up to 66051 pixels.
+LIBYUV_API
+int IntegralPlaneSquared(const uint8_t* src_y,
+                         int src_stride_y,
+                         uint32_t* dst_sumsq,
+                         int dst_stride_sumsq,
+                         int width,
+                         int height);
+
 // Gaussian 5x5 blur a float plane.
 // Coefficients of 1, 4, 6, 4, 1.
 // Each destination pixel is a blur of the 5x5
@@ -998,6 +1045,27 @@ int GaussPlane_F32(const float* src,
                    int width,
                    int height);
 
+// Gaussian 5x5 blur an 8 bit plane in fixed point.
+// Coefficients of 1, 4, 6, 4, 1, rounded.
+// Source edges are clamped.
+LIBYUV_API
+int GaussPlane(const uint8_t* src,
+               int src_stride,
+               uint8_t* dst,
+               int dst_stride,
+               int width,
+               int height);
+
+// Gaussian 5x5 blur a 16 bit plane in fixed point.
+// Strides are in uint16_t.
+LIBYUV_API
+int GaussPlane_16(const uint16_t* src,
+                  int src_stride,
+                  uint16_t* dst,
+                  int dst_stride,
+                  int width,
+                  int height);
+
 // Multiply ARGB image by ARGB value.
 LIBYUV_API
 int ARGBShade(const uint8_t* src_argb,
@@ -1099,6 +1167,16 @@ int AR64Shuffle(const uint16_t* src_ar64,
                 int width,
                 int height);
 
+// Sobel edge magnitude of a Y plane.  Same as ARGBSobelToPlane on a gray
+// image, without the conversion to luma.  Edge pixels are replicated.
+LIBYUV_API
+int SobelPlane(const uint8_t* src_y,
+               int src_stride_y,
+               uint8_t* dst_y,
+               int dst_stride_y,
+               int width,
+               int height);
+
 // Sobel ARGB effect with planar output.
 LIBYUV_API
 int ARGBSobelToPlane(const uint8_t* src_argb,
@@ -155,6 +155,35 @@ int NV12ToI420Rotate(const uint8_t* src_y,
                      int height,
                      enum RotationMode mode);
 
+// Rotate NV12 input and store in NV12.  The UV plane is rotated as
+// interleaved pairs.  UV strides must be even.
+LIBYUV_API
+int NV12Rotate(const uint8_t* src_y,
+               int src_stride_y,
+               const uint8_t* src_uv,
+               int src_stride_uv,
+               uint8_t* dst_y,
+               int dst_stride_y,
+               uint8_t* dst_uv,
+               int dst_stride_uv,
+               int width,
+               int height,
+               enum RotationMode mode);
+
+// Rotate P010 input and store in P010.  Strides are in uint16_t elements.
+LIBYUV_API
+int P010Rotate(const uint16_t* src_y,
+               int src_stride_y,
+               const uint16_t* src_uv,
+               int src_stride_uv,
+               uint16_t* dst_y,
+               int dst_stride_y,
+               uint16_t* dst_uv,
+               int dst_stride_uv,
+               int width,
+               int height,
+               enum RotationMode mode);
+
 // Convert Android420 to I420 with rotation.
 // "rotation" can be 0, 90, 180 or 270.
 LIBYUV_API
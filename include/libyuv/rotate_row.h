@@ -41,6 +41,8 @@ extern "C" {
     !defined(LIBYUV_ENABLE_ROWWIN)
 #define HAS_TRANSPOSEWX8_FAST_SSSE3
 #define HAS_TRANSPOSEUVWX8_SSE2
+#define HAS_TRANSPOSEWX8_16_SSE2
+#define HAS_TRANSPOSEWX8_16_AVX2
 #endif
 
 #if !defined(LIBYUV_DISABLE_NEON) && \
@@ -231,6 +233,40 @@ void TransposeWx1_16_C(const uint16_t* src,
                        uint16_t* dst,
                        int dst_stride,
                        int width);
+void TransposeWx8_16_SSE2(const uint16_t* src,
+                          int src_stride,
+                          uint16_t* dst,
+                          int dst_stride,
+                          int width);
+void TransposeWx8_16_Any_SSE2(const uint16_t* src,
+                              int src_stride,
+                              uint16_t* dst,
+                              int dst_stride,
+                              int width);
+void TransposeWx8_16_AVX2(const uint16_t* src,
+                          int src_stride,
+                          uint16_t* dst,
+                          int dst_stride,
+                          int width);
+void TransposeWx8_16_Any_AVX2(const uint16_t* src,
+                              int src_stride,
+                              uint16_t* dst,
+                              int dst_stride,
+                              int width);
+
+// Bytes staged per chunk by RotateRow180.  A multiple of every SIMD width so
+// chunking keeps the alignment of the full row.
+#define kRotateChunkBytes 2048
+
+void RotateRow180(
+    const uint8_t* src_top,
+    const uint8_t* src_bot,
+    uint8_t* dst_top,
+    uint8_t* dst_bot,
+    int width,
+    int bpp,
+    void (*MirrorRow)(const uint8_t* src, uint8_t* dst, int width),
+    void (*CopyRow)(const uint8_t* src, uint8_t* dst, int count));
 
 // Transpose 32 bit values (ARGB)
 void Transpose4x4_32_NEON(const uint8_t* src,
@@ -413,6 +413,37 @@ extern "C" {
 #define HAS_RGBTOYMATRIXROW_AVX512BW
 #endif
 
+// The following are available for AVX2 gcc/clang x64 platforms:
+#if !defined(LIBYUV_DISABLE_X86) && defined(USE_ROW_GCC) && \
+    defined(__x86_64__) &&                                  \
+    (defined(CLANG_HAS_AVX2) || defined(GCC_HAS_AVX2)) &&   \
+    !defined(LIBYUV_ENABLE_ROWWIN)
+#define HAS_ARGBAFFINEFILTERROW_AVX2
+#define HAS_ARGBAFFINEROW_AVX2
+#define HAS_ARGBBLENDROW_AVX2
+#define HAS_COMPUTECUMULATIVESUMROW_AVX2
+#define HAS_CUMULATIVESUMTOAVERAGEROW_AVX2
+#define HAS_GAUSSCOL_8_AVX2
+#define HAS_GAUSSCOL_AVX2
+#define HAS_GAUSSCOL_F32_AVX2
+#define HAS_GAUSSROW_8_AVX2
+#define HAS_GAUSSROW_AVX2
+#define HAS_GAUSSROW_F32_AVX2
+#define HAS_INTEGRALROW_AVX2
+#define HAS_INTEGRALSQUAREDROW_AVX2
+#define HAS_SOBELPLANEROW_AVX2
+#define HAS_SOBELXROW_AVX2
+#define HAS_SOBELXYROW_AVX2
+#define HAS_SOBELYROW_AVX2
+#if defined(CLANG_HAS_AVX512) || defined(GCC_HAS_AVX512)
+#define HAS_ARGBAFFINEROW_AVX512BW
+#define HAS_ARGBBLENDROW_AVX512BW
+#define HAS_GAUSSCOL_F32_AVX512BW
+#define HAS_GAUSSROW_F32_AVX512BW
+#define HAS_SOBELPLANEROW_AVX512BW
+#endif
+#endif
+
 // The following are available on Neon platforms:
 #if !defined(LIBYUV_DISABLE_NEON) && \
     (defined(__aarch64__) || defined(__ARM_NEON__) || defined(LIBYUV_NEON))
@@ -1012,6 +1043,18 @@ struct ArgbConstants {
                         : malloc(var##_mem_size + 63);        /* NOLINT */ \
   uint8_t* var = (uint8_t*)(((intptr_t)var##_mem + 63) & ~63) /* NOLINT */
 
+// As align_buffer_64, but carves var from scratch, a caller buffer of at
+// least size + 63 bytes, when scratch is not NULL.
+#define align_buffer_64_scratch(var, size, scratch)                        \
+  size_t var##_mem_size = (size); /* NOLINT */                             \
+  void* var##_mem = ((scratch) || var##_mem_size > SIZE_MAX - 63)          \
+                        ? NULL                                             \
+                        : malloc(var##_mem_size + 63);        /* NOLINT */ \
+  uint8_t* var = (uint8_t*)(((intptr_t)((scratch) ? (void*)(scratch)       \
+                                                  : var##_mem) +           \
+                             63) &                                         \
+                            ~63) /* NOLINT */
+
 #define free_aligned_buffer_64(var) \
   free(var##_mem);                  \
   var = NULL
@@ -5189,6 +5232,14 @@ void ARGBBlendRow_SSSE3(const uint8_t* src_argb,
                         const uint8_t* src_argb1,
                         uint8_t* dst_argb,
                         int width);
+void ARGBBlendRow_AVX2(const uint8_t* src_argb,
+                       const uint8_t* src_argb1,
+                       uint8_t* dst_argb,
+                       int width);
+void ARGBBlendRow_AVX512BW(const uint8_t* src_argb,
+                           const uint8_t* src_argb1,
+                           uint8_t* dst_argb,
+                           int width);
 void ARGBBlendRow_NEON(const uint8_t* src_argb,
                        const uint8_t* src_argb1,
                        uint8_t* dst_argb,
@@ -6442,6 +6493,16 @@ void ComputeCumulativeSumRow_SSE2(const uint8_t* row,
                                   int32_t* cumsum,
                                   const int32_t* previous_cumsum,
                                   int width);
+void CumulativeSumToAverageRow_AVX2(const int32_t* topleft,
+                                    const int32_t* botleft,
+                                    int width,
+                                    int area,
+                                    uint8_t* dst,
+                                    int count);
+void ComputeCumulativeSumRow_AVX2(const uint8_t* row,
+                                  int32_t* cumsum,
+                                  const int32_t* previous_cumsum,
+                                  int width);
 
 void CumulativeSumToAverageRow_C(const int32_t* tl,
                                  const int32_t* bl,
@@ -6454,6 +6515,24 @@ void ComputeCumulativeSumRow_C(const uint8_t* row,
                                const int32_t* previous_cumsum,
                                int width);
 
+// Integral image rows of a single channel.  Sums wrap modulo 2^32.
+void IntegralRow_C(const uint8_t* src,
+                   uint32_t* dst,
+                   const uint32_t* previous,
+                   int width);
+void IntegralRow_AVX2(const uint8_t* src,
+                      uint32_t* dst,
+                      const uint32_t* previous,
+                      int width);
+void IntegralSquaredRow_C(const uint8_t* src,
+                          uint32_t* dst,
+                          const uint32_t* previous,
+                          int width);
+void IntegralSquaredRow_AVX2(const uint8_t* src,
+                             uint32_t* dst,
+                             const uint32_t* previous,
+                             int width);
+
 LIBYUV_API
 void ARGBAffineRow_C(const uint8_t* src_argb,
                      int src_argb_stride,
@@ -6466,6 +6545,51 @@ void ARGBAffineRow_SSE2(const uint8_t* src_argb,
                         uint8_t* dst_argb,
                         const float* src_dudv,
                         int width);
+LIBYUV_API
+void ARGBAffineRow_AVX2(const uint8_t* src_argb,
+                        int src_argb_stride,
+                        uint8_t* dst_argb,
+                        const float* uv_dudv,
+                        int width);
+LIBYUV_API
+void ARGBAffineRow_Any_AVX2(const uint8_t* src_argb,
+                            int src_argb_stride,
+                            uint8_t* dst_argb,
+                            const float* uv_dudv,
+                            int width);
+LIBYUV_API
+void ARGBAffineRow_AVX512BW(const uint8_t* src_argb,
+                            int src_argb_stride,
+                            uint8_t* dst_argb,
+                            const float* uv_dudv,
+                            int width);
+LIBYUV_API
+void ARGBAffineRow_Any_AVX512BW(const uint8_t* src_argb,
+                                int src_argb_stride,
+                                uint8_t* dst_argb,
+                                const float* uv_dudv,
+                                int width);
+// Bilinear filtered ARGBAffineRow.  Reads the pixel right of and below each
+// sample, so coordinates must be at least 1 pixel inside the right and
+// bottom edges.
+LIBYUV_API
+void ARGBAffineFilterRow_C(const uint8_t* src_argb,
+                           int src_argb_stride,
+                           uint8_t* dst_argb,
+                           const float* uv_dudv,
+                           int width);
+LIBYUV_API
+void ARGBAffineFilterRow_AVX2(const uint8_t* src_argb,
+                              int src_argb_stride,
+                              uint8_t* dst_argb,
+                              const float* uv_dudv,
+                              int width);
+LIBYUV_API
+void ARGBAffineFilterRow_Any_AVX2(const uint8_t* src_argb,
+                                  int src_argb_stride,
+                                  uint8_t* dst_argb,
+                                  const float* uv_dudv,
+                                  int width);
 
 // Used for I420Scale, ARGBScale, and ARGBInterpolate.
 void InterpolateRow_C(uint8_t* dst_ptr,
@@ -6561,6 +6685,11 @@ void SobelXRow_SSE2(const uint8_t* src_y0,
                     const uint8_t* src_y2,
                     uint8_t* dst_sobelx,
                     int width);
+void SobelXRow_AVX2(const uint8_t* src_y0,
+                    const uint8_t* src_y1,
+                    const uint8_t* src_y2,
+                    uint8_t* dst_sobelx,
+                    int width);
 void SobelXRow_NEON(const uint8_t* src_y0,
                     const uint8_t* src_y1,
                     const uint8_t* src_y2,
@@ -6574,6 +6703,10 @@ void SobelYRow_SSE2(const uint8_t* src_y0,
                     const uint8_t* src_y1,
                     uint8_t* dst_sobely,
                     int width);
+void SobelYRow_AVX2(const uint8_t* src_y0,
+                    const uint8_t* src_y1,
+                    uint8_t* dst_sobely,
+                    int width);
 void SobelYRow_NEON(const uint8_t* src_y0,
                     const uint8_t* src_y1,
                     uint8_t* dst_sobely,
@@ -6618,6 +6751,10 @@ void SobelXYRow_SSE2(const uint8_t* src_sobelx,
                      const uint8_t* src_sobely,
                      uint8_t* dst_argb,
                      int width);
+void SobelXYRow_AVX2(const uint8_t* src_sobelx,
+                     const uint8_t* src_sobely,
+                     uint8_t* dst_argb,
+                     int width);
 void SobelXYRow_NEON(const uint8_t* src_sobelx,
                      const uint8_t* src_sobely,
                      uint8_t* dst_argb,
@@ -6654,6 +6791,10 @@ void SobelXYRow_Any_SSE2(const uint8_t* y_buf,
                          const uint8_t* uv_buf,
                          uint8_t* dst_ptr,
                          int width);
+void SobelXYRow_Any_AVX2(const uint8_t* y_buf,
+                         const uint8_t* uv_buf,
+                         uint8_t* dst_ptr,
+                         int width);
 void SobelXYRow_Any_NEON(const uint8_t* y_buf,
                          const uint8_t* uv_buf,
                          uint8_t* dst_ptr,
@@ -6662,6 +6803,33 @@ void SobelXYRow_Any_LSX(const uint8_t* y_buf,
                         const uint8_t* uv_buf,
                         uint8_t* dst_ptr,
                         int width);
+// Fused Sobel magnitude of a 3 row luma window.  src pointers are 1 pixel
+// left of the output pixel, and width + 2 pixels are read from each row.
+void SobelPlaneRow_C(const uint8_t* src_y0,
+                     const uint8_t* src_y1,
+                     const uint8_t* src_y2,
+                     uint8_t* dst_y,
+                     int width);
+void SobelPlaneRow_AVX2(const uint8_t* src_y0,
+                        const uint8_t* src_y1,
+                        const uint8_t* src_y2,
+                        uint8_t* dst_y,
+                        int width);
+void SobelPlaneRow_AVX512BW(const uint8_t* src_y0,
+                            const uint8_t* src_y1,
+                            const uint8_t* src_y2,
+                            uint8_t* dst_y,
+                            int width);
+void SobelPlaneRow_Any_AVX2(const uint8_t* src_y0,
+                            const uint8_t* src_y1,
+                            const uint8_t* src_y2,
+                            uint8_t* dst_y,
+                            int width);
+void SobelPlaneRow_Any_AVX512BW(const uint8_t* src_y0,
+                                const uint8_t* src_y1,
+                                const uint8_t* src_y2,
+                                uint8_t* dst_y,
+                                int width);
 
 void ARGBPolynomialRow_C(const uint8_t* src_argb,
                          uint8_t* dst_argb,
@@ -6774,6 +6942,10 @@ void ScaleSamples_NEON(const float* src, float* dst, float scale, int width);
 
 void GaussRow_F32_NEON(const float* src, float* dst, int width);
 void GaussRow_F32_C(const float* src, float* dst, int width);
+void GaussRow_F32_AVX2(const float* src, float* dst, int width);
+void GaussRow_F32_Any_AVX2(const float* src, float* dst, int width);
+void GaussRow_F32_AVX512BW(const float* src, float* dst, int width);
+void GaussRow_F32_Any_AVX512BW(const float* src, float* dst, int width);
 
 void GaussCol_F32_NEON(const float* src0,
                        const float* src1,
@@ -6791,6 +6963,38 @@ void GaussCol_F32_C(const float* src0,
                     float* dst,
                     int width);
 
+void GaussCol_F32_AVX2(const float* src0,
+                       const float* src1,
+                       const float* src2,
+                       const float* src3,
+                       const float* src4,
+                       float* dst,
+                       int width);
+
+void GaussCol_F32_Any_AVX2(const float* src0,
+                           const float* src1,
+                           const float* src2,
+                           const float* src3,
+                           const float* src4,
+                           float* dst,
+                           int width);
+
+void GaussCol_F32_AVX512BW(const float* src0,
+                           const float* src1,
+                           const float* src2,
+                           const float* src3,
+                           const float* src4,
+                           float* dst,
+                           int width);
+
+void GaussCol_F32_Any_AVX512BW(const float* src0,
+                               const float* src1,
+                               const float* src2,
+                               const float* src3,
+                               const float* src4,
+                               float* dst,
+                               int width);
+
 void GaussRow_C(const uint32_t* src, uint16_t* dst, int width);
 void GaussRow_NEON(const uint32_t* src, uint16_t* dst, int width);
 void GaussCol_C(const uint16_t* src0,
@@ -6807,6 +7011,46 @@ void GaussCol_NEON(const uint16_t* src0,
                    const uint16_t* src4,
                    uint32_t* dst,
                    int width);
+void GaussRow_AVX2(const uint32_t* src, uint16_t* dst, int width);
+void GaussRow_Any_AVX2(const uint32_t* src, uint16_t* dst, int width);
+void GaussCol_AVX2(const uint16_t* src0,
+                   const uint16_t* src1,
+                   const uint16_t* src2,
+                   const uint16_t* src3,
+                   const uint16_t* src4,
+                   uint32_t* dst,
+                   int width);
+void GaussCol_Any_AVX2(const uint16_t* src0,
+                       const uint16_t* src1,
+                       const uint16_t* src2,
+                       const uint16_t* src3,
+                       const uint16_t* src4,
+                       uint32_t* dst,
+                       int width);
+void GaussRow_8_C(const uint16_t* src, uint8_t* dst, int width);
+void GaussRow_8_AVX2(const uint16_t* src, uint8_t* dst, int width);
+void GaussRow_8_Any_AVX2(const uint16_t* src, uint8_t* dst, int width);
+void GaussCol_8_C(const uint8_t* src0,
+                  const uint8_t* src1,
+                  const uint8_t* src2,
+                  const uint8_t* src3,
+                  const uint8_t* src4,
+                  uint16_t* dst,
+                  int width);
+void GaussCol_8_AVX2(const uint8_t* src0,
+                     const uint8_t* src1,
+                     const uint8_t* src2,
+                     const uint8_t* src3,
+                     const uint8_t* src4,
+                     uint16_t* dst,
+                     int width);
+void GaussCol_8_Any_AVX2(const uint8_t* src0,
+                         const uint8_t* src1,
+                         const uint8_t* src2,
+                         const uint8_t* src3,
+                         const uint8_t* src4,
+                         uint16_t* dst,
+                         int width);
 
 void ClampFloatToZero_SSE2(const float* src_x, float* dst_y, int width);
 
@@ -0,0 +1,149 @@
+/*
+ *  Copyright 2026 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef INCLUDE_LIBYUV_ROW_DISPATCH_H_
+#define INCLUDE_LIBYUV_ROW_DISPATCH_H_
+
+#include "libyuv/basic_types.h"
+#include "libyuv/rotate_row.h"
+#include "libyuv/row.h"
+#include "libyuv/scale_row.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Row kernels resolved once for a set of cpu flags, so that public functions
+// pick their kernels with a table lookup instead of testing cpu flags on
+// every call.  Each kernel entry holds the function for any width and the
+// function for widths that are a multiple of align.  The table is resolved
+// again when MaskCpuFlags changes the flags, so tests still select C or SIMD
+// paths with MaskCpuFlags.
+//
+// The table covers the I422ToARGB converters, plane transpose and the 8 bit
+// scalers: InterpolateRow, the plane and ARGB filter columns, and the plane,
+// ARGB and UV down by 2 rows.  Other families, including the 16 bit scalers
+// and most converters, still test cpu flags when they are called.  To move a
+// family onto the table, add an entry here, resolve it in
+// ResolveRowDispatch and replace the callers' cascades with ROW_KERNEL.
+
+typedef void (*I422ToARGBRowFunction)(const uint8_t* y_buf,
+                                      const uint8_t* u_buf,
+                                      const uint8_t* v_buf,
+                                      uint8_t* rgb_buf,
+                                      const struct YuvConstants* yuvconstants,
+                                      int width);
+typedef void (*TransposeWxNFunction)(const uint8_t* src,
+                                     int src_stride,
+                                     uint8_t* dst,
+                                     int dst_stride,
+                                     int width);
+typedef void (*TransposeWxHFunction)(const uint8_t* src,
+                                     int src_stride,
+                                     uint8_t* dst,
+                                     int dst_stride,
+                                     int width,
+                                     int height);
+typedef void (*ScaleRowDown2Function)(const uint8_t* src_ptr,
+                                      ptrdiff_t src_stride,
+                                      uint8_t* dst_ptr,
+                                      int dst_width);
+typedef void (*InterpolateRowFunction)(uint8_t* dst_ptr,
+                                       const uint8_t* src_ptr,
+                                       ptrdiff_t src_stride,
+                                       int width,
+                                       int source_y_fraction);
+typedef void (*ScaleFilterColsFunction)(uint8_t* dst_ptr,
+                                        const uint8_t* src_ptr,
+                                        int dst_width,
+                                        int x,
+                                        int dx);
+
+struct I422ToARGBRowKernel {
+  I422ToARGBRowFunction any;
+  I422ToARGBRowFunction full;
+  int align;
+};
+
+struct TransposeWxNKernel {
+  TransposeWxNFunction any;
+  TransposeWxNFunction full;
+  int align;
+};
+
+struct ScaleRowDown2Kernel {
+  ScaleRowDown2Function any;
+  ScaleRowDown2Function full;
+  int align;
+};
+
+struct InterpolateRowKernel {
+  InterpolateRowFunction any;
+  InterpolateRowFunction full;
+  int align;
+};
+
+struct ScaleFilterColsKernel {
+  ScaleFilterColsFunction any;
+  ScaleFilterColsFunction full;
+  int align;
+};
+
+// Transpose tiles are 16 rows where a Wx16 kernel exists, 8 otherwise.
+#if defined(HAS_TRANSPOSEWX16_LSX) || defined(HAS_TRANSPOSEWX16_NEON)
+#define TRANSPOSE_TILE_ROWS 16
+#else
+#define TRANSPOSE_TILE_ROWS 8
+#endif
+
+// Index of the ScaleRowDown2, ScaleARGBRowDown2 and ScaleUVRowDown2 kernels
+// for a filter.  Bilinear uses box.
+#define SCALEROWDOWN2_NONE 0
+#define SCALEROWDOWN2_LINEAR 1
+#define SCALEROWDOWN2_BOX 2
+
+struct RowDispatch {
+  int cpu_info;  // Flags the table was resolved for.
+  struct I422ToARGBRowKernel I422ToARGBRow;
+  struct TransposeWxNKernel TransposeWxN;  // TRANSPOSE_TILE_ROWS rows.
+  TransposeWxHFunction TransposeWxH;       // Whole plane kernel, or NULL.
+  struct ScaleRowDown2Kernel ScaleRowDown2[3];
+  struct InterpolateRowKernel InterpolateRow;  // Width in bytes.
+  // Filter columns need 16.16 x, so callers use the 64 bit C columns for
+  // sources 32768 or more pixels wide.
+  struct ScaleFilterColsKernel ScaleFilterCols;
+  struct ScaleFilterColsKernel ScaleARGBFilterCols;
+  struct ScaleRowDown2Kernel ScaleARGBRowDown2[3];
+  struct ScaleRowDown2Kernel ScaleUVRowDown2[3];
+};
+
+// Returns the table for the current cpu flags, resolving it on first use
+// of each set of flags.  A returned table is never modified, so it may be
+// used while other threads call GetRowDispatch.  Tables are kept for the
+// life of the process.  If a table can not be allocated the C table is
+// returned.
+LIBYUV_API
+const struct RowDispatch* GetRowDispatch(void);
+
+// Fill in a table for the given cpu flags.
+LIBYUV_API
+void ResolveRowDispatch(struct RowDispatch* dispatch, int cpu_info);
+
+// The kernel of an entry for a row of width elements.
+#define ROW_KERNEL(kernel, width) \
+  (IS_ALIGNED(width, (kernel).align) ? (kernel).full : (kernel).any)
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
+
+#endif  // INCLUDE_LIBYUV_ROW_DISPATCH_H_
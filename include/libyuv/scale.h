@@ -23,9 +23,15 @@ typedef enum FilterMode {
   kFilterNone = 0,      // Point sample; Fastest.
   kFilterLinear = 1,    // Filter horizontally only.
   kFilterBilinear = 2,  // Faster than box, but lower quality scaling down.
-  kFilterBox = 3        // Highest quality.
+  kFilterBox = 3,       // Averages pixels when scaling down.
+  kFilterBicubic = 4,   // Separable bicubic.  Sharper than bilinear.
+  kFilterLanczos3 = 5   // Separable 3 lobe Lanczos.  Highest quality.
 } FilterModeEnum;
 
+// kFilterBicubic and kFilterLanczos3 are separable polyphase filters,
+// supported by ScalePlane, ScalePlane_16, ARGBScale, UVScale and the scalers
+// built on them.  Scaling down by more than 10 times uses kFilterBox instead.
+
 // Scale a YUV plane.
 // Returns 0 if successful.
 LIBYUV_API
@@ -302,6 +308,248 @@ int NV24Scale(const uint8_t* src_y,
               int dst_height,
               enum FilterMode filtering);
 
+// Scaling one image to several sizes.
+// The source is read once, in bands of rows that stay in cache while every
+// destination scales the rows it needs from them.  A destination exactly half
+// the width and height of another, with kFilterBilinear or kFilterBox, is
+// scaled from that larger destination instead of the source, so each
+// destination matches I420Scale or NV12Scale from the source or from the
+// destination it is cascaded from.  Up to 8 destinations.
+// Returns 0 if successful.
+typedef struct I420ScaleDest {
+  uint8_t* dst_y;
+  int dst_stride_y;
+  uint8_t* dst_u;
+  int dst_stride_u;
+  uint8_t* dst_v;
+  int dst_stride_v;
+  int dst_width;
+  int dst_height;
+} I420ScaleDest;
+
+typedef struct NV12ScaleDest {
+  uint8_t* dst_y;
+  int dst_stride_y;
+  uint8_t* dst_uv;
+  int dst_stride_uv;
+  int dst_width;
+  int dst_height;
+} NV12ScaleDest;
+
+LIBYUV_API
+int I420ScaleMulti(const uint8_t* src_y,
+                   int src_stride_y,
+                   const uint8_t* src_u,
+                   int src_stride_u,
+                   const uint8_t* src_v,
+                   int src_stride_v,
+                   int src_width,
+                   int src_height,
+                   const struct I420ScaleDest* dst,
+                   int num_dst,
+                   enum FilterMode filtering);
+
+LIBYUV_API
+int NV12ScaleMulti(const uint8_t* src_y,
+                   int src_stride_y,
+                   const uint8_t* src_uv,
+                   int src_stride_uv,
+                   int src_width,
+                   int src_height,
+                   const struct NV12ScaleDest* dst,
+                   int num_dst,
+                   enum FilterMode filtering);
+
+// Multithreaded scaling.
+// The destination is split into horizontal bands that are scaled as
+// independent jobs, producing the same output as the single threaded
+// functions.  Jobs are handed to a caller supplied executor, which must call
+// job(job_context, i) once for each i in [0, count), possibly concurrently,
+// and return once all of them have finished.  If executor is NULL the jobs
+// run on the calling thread.
+typedef void (*ScaleJobFunc)(void* job_context, int index);
+typedef void (*ScaleExecutor)(void* executor_context,
+                              ScaleJobFunc job,
+                              void* job_context,
+                              int count);
+
+// Scale a plane using up to num_bands jobs.
+// Returns 0 if successful.
+LIBYUV_API
+int ScalePlaneMT(const uint8_t* src,
+                 int src_stride,
+                 int src_width,
+                 int src_height,
+                 uint8_t* dst,
+                 int dst_stride,
+                 int dst_width,
+                 int dst_height,
+                 enum FilterMode filtering,
+                 int num_bands,
+                 ScaleExecutor executor,
+                 void* executor_context);
+
+// Scale an I420 image using up to num_bands jobs per plane.
+LIBYUV_API
+int I420ScaleMT(const uint8_t* src_y,
+                int src_stride_y,
+                const uint8_t* src_u,
+                int src_stride_u,
+                const uint8_t* src_v,
+                int src_stride_v,
+                int src_width,
+                int src_height,
+                uint8_t* dst_y,
+                int dst_stride_y,
+                uint8_t* dst_u,
+                int dst_stride_u,
+                uint8_t* dst_v,
+                int dst_stride_v,
+                int dst_width,
+                int dst_height,
+                enum FilterMode filtering,
+                int num_bands,
+                ScaleExecutor executor,
+                void* executor_context);
+
+// Scale an NV12 image using up to num_bands jobs per plane.
+LIBYUV_API
+int NV12ScaleMT(const uint8_t* src_y,
+                int src_stride_y,
+                const uint8_t* src_uv,
+                int src_stride_uv,
+                int src_width,
+                int src_height,
+                uint8_t* dst_y,
+                int dst_stride_y,
+                uint8_t* dst_uv,
+                int dst_stride_uv,
+                int dst_width,
+                int dst_height,
+                enum FilterMode filtering,
+                int num_bands,
+                ScaleExecutor executor,
+                void* executor_context);
+
+// Scale plans.
+// A plan holds the slopes, row functions and row buffers for one source and
+// destination size, so that many images of the same size can be scaled
+// without repeating that setup.  Results match ScalePlane, ScalePlane_16,
+// ARGBScale and UVScale.  A plan may only be executed by one thread at a
+// time.
+typedef enum ScalePlanFormat {
+  kScalePlanPlane = 0,     // 8 bit plane, as ScalePlane.
+  kScalePlanPlane_16 = 1,  // 16 bit plane, as ScalePlane_16.
+  kScalePlanARGB = 2,      // ARGB, as ARGBScale.
+  kScalePlanUV = 3,        // Interleaved UV, as UVScale.
+} ScalePlanFormatEnum;
+
+struct ScalePlan;
+
+// Create a plan.  A negative src_height inverts the image.
+// Returns NULL if the sizes are not supported or memory is exhausted.
+LIBYUV_API
+struct ScalePlan* ScalePlanCreate(enum ScalePlanFormat format,
+                                  int src_width,
+                                  int src_height,
+                                  int dst_width,
+                                  int dst_height,
+                                  enum FilterMode filtering);
+
+// Scale an image with a kScalePlanPlane, kScalePlanARGB or kScalePlanUV plan.
+// Returns 0 if successful.
+LIBYUV_API
+int ScalePlanExecute(struct ScalePlan* plan,
+                     const uint8_t* src,
+                     int src_stride,
+                     uint8_t* dst,
+                     int dst_stride);
+
+// Scale an image with a kScalePlanPlane_16 plan.  Strides are in elements.
+LIBYUV_API
+int ScalePlanExecute_16(struct ScalePlan* plan,
+                        const uint16_t* src,
+                        int src_stride,
+                        uint16_t* dst,
+                        int dst_stride);
+
+LIBYUV_API
+void ScalePlanDestroy(struct ScalePlan* plan);
+
+// Scaling with caller scratch.
+// ScaleScratchSize returns the bytes of row buffer that scaling an image of
+// the format and sizes needs, 0 if none, or -1 if the sizes are not supported.
+// The scratch functions scale as ScalePlane, ScalePlane_16, ARGBScale, UVScale
+// and I420Scale, using scratch, a caller buffer of scratch_size bytes, as the
+// row buffer, so that no memory is allocated.  A NULL scratch allocates as the
+// functions without scratch do.  They return -1 if scratch is smaller than the
+// size returned for the same arguments.
+LIBYUV_API
+int ScaleScratchSize(enum ScalePlanFormat format,
+                     int src_width,
+                     int src_height,
+                     int dst_width,
+                     int dst_height,
+                     enum FilterMode filtering);
+
+// Scale an image of a kScalePlanPlane, kScalePlanARGB or kScalePlanUV format.
+LIBYUV_API
+int ScaleScratch(enum ScalePlanFormat format,
+                 const uint8_t* src,
+                 int src_stride,
+                 int src_width,
+                 int src_height,
+                 uint8_t* dst,
+                 int dst_stride,
+                 int dst_width,
+                 int dst_height,
+                 enum FilterMode filtering,
+                 uint8_t* scratch,
+                 int scratch_size);
+
+// Scale a 16 bit plane.  Strides are in elements.
+LIBYUV_API
+int ScaleScratch_16(const uint16_t* src,
+                    int src_stride,
+                    int src_width,
+                    int src_height,
+                    uint16_t* dst,
+                    int dst_stride,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering,
+                    uint8_t* scratch,
+                    int scratch_size);
+
+// Scratch for I420ScaleScratch, which serves all three planes.
+LIBYUV_API
+int I420ScaleScratchSize(int src_width,
+                         int src_height,
+                         int dst_width,
+                         int dst_height,
+                         enum FilterMode filtering);
+
+LIBYUV_API
+int I420ScaleScratch(const uint8_t* src_y,
+                     int src_stride_y,
+                     const uint8_t* src_u,
+                     int src_stride_u,
+                     const uint8_t* src_v,
+                     int src_stride_v,
+                     int src_width,
+                     int src_height,
+                     uint8_t* dst_y,
+                     int dst_stride_y,
+                     uint8_t* dst_u,
+                     int dst_stride_u,
+                     uint8_t* dst_v,
+                     int dst_stride_v,
+                     int dst_width,
+                     int dst_height,
+                     enum FilterMode filtering,
+                     uint8_t* scratch,
+                     int scratch_size);
+
 #ifdef __cplusplus
 // Legacy API.  Deprecated.
 LIBYUV_API
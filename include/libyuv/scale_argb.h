@@ -47,6 +47,8 @@ int ARGBScaleClip(const uint8_t* src_argb,
                   enum FilterMode filtering);
 
 // Scale with YUV conversion to ARGB and clipping.
+// src_fourcc may be I420, YV12, J420, H420 or U420 (or an alias of them).
+// dst_fourcc may be ARGB or ABGR.
 LIBYUV_API
 int YUVToARGBScaleClip(const uint8_t* src_y,
                        int src_stride_y,
@@ -68,6 +70,29 @@ int YUVToARGBScaleClip(const uint8_t* src_y,
                        int clip_height,
                        enum FilterMode filtering);
 
+// Warp an ARGB image with an affine transform, for example to rotate by a
+// small angle, deskew, zoom or pan.
+// matrix is 6 floats that map a destination pixel center (x + 0.5, y + 0.5)
+// to a source position, where source pixel (i, j) covers [i, i + 1) by
+// [j, j + 1):
+//   u = matrix[0] * (x + 0.5) + matrix[1] * (y + 0.5) + matrix[2]
+//   v = matrix[3] * (x + 0.5) + matrix[4] * (y + 0.5) + matrix[5]
+// kFilterNone samples the nearest pixel.  Other filters are bilinear, which
+// has only an AVX2 row; other CPUs, including ARM, filter in C.
+// Destination pixels that map outside the source are set to border_argb.
+LIBYUV_API
+int ARGBWarpAffine(const uint8_t* src_argb,
+                   int src_stride_argb,
+                   int src_width,
+                   int src_height,
+                   uint8_t* dst_argb,
+                   int dst_stride_argb,
+                   int dst_width,
+                   int dst_height,
+                   const float* matrix,
+                   enum FilterMode filtering,
+                   uint32_t border_argb);
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
@@ -34,6 +34,31 @@ int RGBScale(const uint8_t* src_rgb,
              int dst_height,
              enum FilterMode filtering);
 
+// Bytes of scratch needed by RGBScaleScratch, or -1 if the sizes are not
+// supported.
+LIBYUV_API
+int RGBScaleScratchSize(int src_width,
+                        int src_height,
+                        int dst_width,
+                        int dst_height,
+                        enum FilterMode filtering);
+
+// As RGBScale, with scratch, a caller buffer of scratch_size bytes, for the
+// ARGB bands so that no memory is allocated.  A NULL scratch allocates as
+// RGBScale does.
+LIBYUV_API
+int RGBScaleScratch(const uint8_t* src_rgb,
+                    int src_stride_rgb,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst_rgb,
+                    int dst_stride_rgb,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering,
+                    uint8_t* scratch,
+                    int scratch_size);
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
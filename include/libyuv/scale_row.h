@@ -80,6 +80,14 @@ extern "C" {
 #define HAS_SCALEUVROWUP2_BILINEAR_16_AVX2
 #endif
 
+// The following are available for gcc/clang x86_64 platforms.
+// They index source rows with 64 bit registers.
+#if !defined(LIBYUV_DISABLE_X86) && defined(__x86_64__) && \
+    (defined(CLANG_HAS_AVX2) || defined(GCC_HAS_AVX2))
+#define HAS_SCALEPOLYPHASECOLS_AVX2
+#define HAS_SCALEPOLYPHASEROWS_AVX2
+#endif
+
 // The following are available on all x86 platforms, but
 // require VS2012, clang 3.4 or gcc 4.7.
 // The code supports NaCL but requires a new compiler and validator.
@@ -256,6 +264,269 @@ void ScaleSlope(int src_width,
                 int* dx,
                 int* dy);
 
+// Scaler chosen by a ScalePlan for its sizes and filter.
+enum ScaleMethod {
+  kScaleMethodCopy,
+  kScaleMethodVertical,
+  kScaleMethodDown2,
+  kScaleMethodDown4,
+  kScaleMethodDown34,
+  kScaleMethodDown38,
+  kScaleMethodDownEven,
+  kScaleMethodDown4Box,
+  kScaleMethodBox,
+  kScaleMethodUp2Linear,
+  kScaleMethodUp2Bilinear,
+  kScaleMethodBilinearUp,
+  kScaleMethodBilinearDown,
+  kScaleMethodSimple,
+  kScaleMethodPolyphase,
+};
+
+// Setup for scaling images of one size, shared by ScalePlane, ScalePlane_16,
+// ARGBScale, UVScale and the public ScalePlan functions.  Filled in by
+// ScalePlanInit* before any pixels are touched.
+struct ScalePlan {
+  enum ScalePlanFormat format;
+  int src_width;   // Absolute source width.
+  int src_height;  // Absolute source height.
+  int invert;      // Source rows are read bottom up.
+  int dst_width;   // Width and height of the clipped destination.
+  int dst_height;
+  enum FilterMode filtering;  // Reduced filter.
+  enum ScaleMethod method;
+  // Source position of the first destination pixel and the step per pixel,
+  // as 16.16 fixed point, relative to src_offset.
+  int x;
+  int y;
+  int dx;
+  int dy;
+  // Offsets in pixels applied to src and dst before scaling.
+  int src_offset_x;
+  int src_offset_y;
+  int dst_offset_x;
+  int dst_offset_y;
+
+  // Row functions for the general scalers.
+  void (*InterpolateRow)(uint8_t* dst_ptr,
+                         const uint8_t* src_ptr,
+                         ptrdiff_t src_stride,
+                         int width,
+                         int source_y_fraction);
+  void (*InterpolateRow_16)(uint16_t* dst_ptr,
+                            const uint16_t* src_ptr,
+                            ptrdiff_t src_stride,
+                            int width,
+                            int source_y_fraction);
+  void (*ScaleCols)(uint8_t* dst_ptr,
+                    const uint8_t* src_ptr,
+                    int dst_width,
+                    int x,
+                    int dx);
+  void (*ScaleCols_16)(uint16_t* dst_ptr,
+                       const uint16_t* src_ptr,
+                       int dst_width,
+                       int x,
+                       int dx);
+  void (*ScaleAddRow)(const uint8_t* src_ptr, uint16_t* dst_ptr, int src_width);
+  void (*ScaleAddRow_16)(const uint16_t* src_ptr,
+                         uint32_t* dst_ptr,
+                         int src_width);
+  void (*ScaleAddCols)(int dst_width,
+                       int boxheight,
+                       int x,
+                       int dx,
+                       const uint16_t* src_ptr,
+                       uint8_t* dst_ptr);
+  void (*ScaleAddCols_16)(int dst_width,
+                          int boxheight,
+                          int x,
+                          int dx,
+                          const uint32_t* src_ptr,
+                          uint16_t* dst_ptr);
+  int interpolate_width;  // Bytes filtered per row by bilinear down.
+
+  // Polyphase filters.  Coefficients are computed for the whole destination
+  // size, which for an ARGB clip is larger than dst_width and dst_height.
+  void (*PolyphaseCols)(const uint8_t* src_ptr,
+                        uint16_t* dst_ptr,
+                        int dst_width,
+                        const int32_t* starts,
+                        const int16_t* coeffs,
+                        int taps);
+  void (*PolyphaseCols_16)(const uint16_t* src_ptr,
+                           uint16_t* dst_ptr,
+                           int dst_width,
+                           const int32_t* starts,
+                           const int16_t* coeffs,
+                           int taps);
+  void (*PolyphaseRows)(const uint16_t* const* src_rows,
+                        const int16_t* coeffs,
+                        int taps,
+                        uint8_t* dst_ptr,
+                        int width);
+  void (*PolyphaseRows_16)(const uint16_t* const* src_rows,
+                           const int16_t* coeffs,
+                           int taps,
+                           uint16_t* dst_ptr,
+                           int width);
+  int taps_x;
+  int taps_y;
+  int filter_dst_width;
+  int filter_dst_height;
+  int mirror;  // Source columns are read right to left.
+  // Coefficient tables built once in the row buffer of a plan from
+  // ScalePlanCreate, or NULL to build them in the row buffer of each run.
+  const uint8_t* polyphase_tables;
+
+  // Bytes of row buffer used by the scaler, and the buffer owned by a plan
+  // from ScalePlanCreate.
+  int row_size;
+  uint8_t* row_mem;
+  uint8_t* row;
+};
+
+// Fill in a plan, returning 0 if the sizes are supported.  The plan row
+// buffer is not allocated.
+int ScalePlanInitPlane(struct ScalePlan* plan,
+                       enum ScalePlanFormat format,
+                       int src_width,
+                       int src_height,
+                       int dst_width,
+                       int dst_height,
+                       enum FilterMode filtering);
+int ScalePlanInitARGB(struct ScalePlan* plan,
+                      int src_width,
+                      int src_height,
+                      int dst_width,
+                      int dst_height,
+                      int clip_x,
+                      int clip_y,
+                      int clip_width,
+                      int clip_height,
+                      enum FilterMode filtering);
+int ScalePlanInitUV(struct ScalePlan* plan,
+                    int src_width,
+                    int src_height,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering);
+
+// Scale an image with a plan, using row, of at least plan->row_size bytes,
+// as the row buffer.  Returns 0 if successful.
+int ScalePlanRunARGB(const struct ScalePlan* plan,
+                     const uint8_t* src,
+                     int src_stride,
+                     uint8_t* dst,
+                     int dst_stride,
+                     uint8_t* row);
+int ScalePlanRunUV(const struct ScalePlan* plan,
+                   const uint8_t* src,
+                   int src_stride,
+                   uint8_t* dst,
+                   int dst_stride,
+                   uint8_t* row);
+
+// Scale an image with a plan, allocating a row buffer for the call.
+int ScalePlanRunOnce(const struct ScalePlan* plan,
+                     const uint8_t* src,
+                     int src_stride,
+                     uint8_t* dst,
+                     int dst_stride);
+
+// Band heights that are a multiple of this start every band on a 3 row
+// group for ScalePlaneDown34/38 and on an even row for the 2x scalers.
+#define SCALE_BAND_ALIGN 12
+
+// Row streaming an 8 bit plane plan a band of destination rows at a time.
+// Source rows [*src_y_begin, *src_y_end) are read by destination rows
+// [dst_y_begin, dst_y_end), clamped to the source.
+void ScalePlanRowRangePlane(const struct ScalePlan* plan,
+                            int dst_y_begin,
+                            int dst_y_end,
+                            int* src_y_begin,
+                            int* src_y_end);
+// Scale destination rows [dst_y_begin, dst_y_end) to dst, which points to
+// row dst_y_begin of the destination.  src holds the source from row
+// src_y_begin.  dst_y_begin must be a multiple of SCALE_BAND_ALIGN.
+int ScalePlanRunBandPlane(const struct ScalePlan* plan,
+                          int dst_y_begin,
+                          int dst_y_end,
+                          const uint8_t* src,
+                          int src_stride,
+                          int src_y_begin,
+                          uint8_t* dst,
+                          int dst_stride,
+                          uint8_t* row);
+
+// Row streaming an ARGB plan a band of destination rows at a time.
+// Source rows [*src_y_begin, *src_y_end) are read by destination rows
+// [dst_y_begin, dst_y_end), clamped to the source.
+void ScalePlanRowRangeARGB(const struct ScalePlan* plan,
+                           int dst_y_begin,
+                           int dst_y_end,
+                           int* src_y_begin,
+                           int* src_y_end);
+// Destination rows per band, and the most source rows a band reads.
+int ScalePlanBandRowsARGB(const struct ScalePlan* plan, int* max_src_rows);
+// Scale destination rows [dst_y_begin, dst_y_end) to dst, which points to
+// row dst_y_begin of the destination.  src holds the source from row
+// src_y_begin and column src_x_begin.
+int ScalePlanRunBandARGB(const struct ScalePlan* plan,
+                         int dst_y_begin,
+                         int dst_y_end,
+                         const uint8_t* src,
+                         int src_stride,
+                         int src_x_begin,
+                         int src_y_begin,
+                         uint8_t* dst,
+                         int dst_stride,
+                         uint8_t* row);
+
+// Polyphase bicubic and Lanczos3 scaling, shared by the plane, ARGB and UV
+// plans.  Init selects the row functions and sets row_size, which holds the
+// horizontal and vertical coefficient tables followed by a ring of
+// horizontally filtered rows.  ScalePolyphaseTables builds the tables once
+// into a row buffer that outlives the run and points polyphase_tables at it;
+// otherwise each run builds the tables it needs.  ScalePolyphase scales rows
+// [dst_y_begin, dst_y_end) of the destination.  src points to pixel (0, 0) of
+// the source and dst to the first pixel of row dst_y_begin.  Strides are in
+// bytes.
+#define SCALE_POLYPHASE_MAX_TAPS 64
+void ScalePolyphaseInit(struct ScalePlan* plan,
+                        int dst_width,
+                        int dst_height);
+void ScalePolyphaseTables(struct ScalePlan* plan, uint8_t* row);
+void ScalePolyphase(const struct ScalePlan* plan,
+                    const uint8_t* src,
+                    ptrdiff_t src_stride,
+                    uint8_t* dst,
+                    ptrdiff_t dst_stride,
+                    int dst_y_begin,
+                    int dst_y_end,
+                    uint8_t* row);
+// Source rows [*src_y_begin, *src_y_end) read by destination rows
+// [dst_y_begin, dst_y_end).
+void ScalePolyphaseRowRange(const struct ScalePlan* plan,
+                            int dst_y_begin,
+                            int dst_y_end,
+                            int* src_y_begin,
+                            int* src_y_end);
+
+// Row streaming a UV plan.  Plans that scale up vertically or by 2
+// horizontally cannot be banded and must be run for the whole destination.
+int ScalePlanBandableUV(const struct ScalePlan* plan);
+// Scale destination rows [dst_y_begin, dst_y_end) to dst, which points to
+// row dst_y_begin of the destination.  src points to row 0 of the source.
+int ScalePlanRunBandUV(const struct ScalePlan* plan,
+                       int dst_y_begin,
+                       int dst_y_end,
+                       const uint8_t* src,
+                       int src_stride,
+                       uint8_t* dst,
+                       int dst_stride,
+                       uint8_t* row);
+
 void ScaleRowDown2_C(const uint8_t* src_ptr,
                      ptrdiff_t src_stride,
                      uint8_t* dst,
@@ -555,6 +826,44 @@ void ScaleUVFilterCols64_C(uint8_t* dst_uv,
                            int x32,
                            int dx);
 
+// Polyphase filter rows.  Cols filters taps source pixels from starts[i] for
+// each destination pixel i into a row of 16 bit intermediates.  Rows filters
+// taps intermediate rows into a destination row of width values.
+void ScalePolyphaseCols_C(const uint8_t* src_ptr,
+                          uint16_t* dst_ptr,
+                          int dst_width,
+                          const int32_t* starts,
+                          const int16_t* coeffs,
+                          int taps);
+void ScaleUVPolyphaseCols_C(const uint8_t* src_uv,
+                            uint16_t* dst_ptr,
+                            int dst_width,
+                            const int32_t* starts,
+                            const int16_t* coeffs,
+                            int taps);
+void ScaleARGBPolyphaseCols_C(const uint8_t* src_argb,
+                              uint16_t* dst_ptr,
+                              int dst_width,
+                              const int32_t* starts,
+                              const int16_t* coeffs,
+                              int taps);
+void ScalePolyphaseCols_16_C(const uint16_t* src_ptr,
+                             uint16_t* dst_ptr,
+                             int dst_width,
+                             const int32_t* starts,
+                             const int16_t* coeffs,
+                             int taps);
+void ScalePolyphaseRows_C(const uint16_t* const* src_rows,
+                          const int16_t* coeffs,
+                          int taps,
+                          uint8_t* dst_ptr,
+                          int width);
+void ScalePolyphaseRows_16_C(const uint16_t* const* src_rows,
+                             const int16_t* coeffs,
+                             int taps,
+                             uint16_t* dst_ptr,
+                             int width);
+
 // Specialized scalers for x86.
 void ScaleRowDown2_SSSE3(const uint8_t* src_ptr,
                          ptrdiff_t src_stride,
@@ -818,6 +1127,29 @@ void ScaleAddRow_Any_AVX2(const uint8_t* src_ptr,
                           uint16_t* dst_ptr,
                           int src_width);
 
+void ScalePolyphaseCols_AVX2(const uint8_t* src_ptr,
+                             uint16_t* dst_ptr,
+                             int dst_width,
+                             const int32_t* starts,
+                             const int16_t* coeffs,
+                             int taps);
+void ScalePolyphaseCols_Any_AVX2(const uint8_t* src_ptr,
+                                 uint16_t* dst_ptr,
+                                 int dst_width,
+                                 const int32_t* starts,
+                                 const int16_t* coeffs,
+                                 int taps);
+void ScalePolyphaseRows_AVX2(const uint16_t* const* src_rows,
+                             const int16_t* coeffs,
+                             int taps,
+                             uint8_t* dst_ptr,
+                             int width);
+void ScalePolyphaseRows_Any_AVX2(const uint16_t* const* src_rows,
+                                 const int16_t* coeffs,
+                                 int taps,
+                                 uint8_t* dst_ptr,
+                                 int width);
+
 void ScaleFilterCols_SSSE3(uint8_t* dst_ptr,
                            const uint8_t* src_ptr,
                            int dst_width,
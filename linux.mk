@@ -38,6 +38,7 @@ LOCAL_OBJ_FILES := \
 	source/rotate_win.o        \
 	source/row_any.o           \
 	source/row_common.o        \
+	source/row_dispatch.o      \
 	source/row_gcc.o           \
 	source/row_lasx.o          \
 	source/row_lsx.o           \
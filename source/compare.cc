@@ -329,59 +329,41 @@ double I420Psnr(const uint8_t* src_y_a,
 static const int64_t cc1 = 26634;   // (64^2*(.01*255)^2
 static const int64_t cc2 = 239708;  // (64^2*(.03*255)^2
 
-static double Ssim8x8_C(const uint8_t* src_a,
-                        int stride_a,
-                        const uint8_t* src_b,
-                        int stride_b) {
-  int64_t sum_a = 0;
-  int64_t sum_b = 0;
-  int64_t sum_sq_a = 0;
-  int64_t sum_sq_b = 0;
-  int64_t sum_axb = 0;
+// SSIM of an 8x8 window from its sums of a, b, a * a, b * b and a * b.
+static double Ssim8x8(int64_t sum_a,
+                      int64_t sum_b,
+                      int64_t sum_sq_a,
+                      int64_t sum_sq_b,
+                      int64_t sum_axb) {
+  const int64_t count = 64;
+  // scale the constants by number of pixels
+  const int64_t c1 = (cc1 * count * count) >> 12;
+  const int64_t c2 = (cc2 * count * count) >> 12;
 
-  int i;
-  for (i = 0; i < 8; ++i) {
-    int j;
-    for (j = 0; j < 8; ++j) {
-      sum_a += src_a[j];
-      sum_b += src_b[j];
-      sum_sq_a += src_a[j] * src_a[j];
-      sum_sq_b += src_b[j] * src_b[j];
-      sum_axb += src_a[j] * src_b[j];
-    }
-
-    src_a += stride_a;
-    src_b += stride_b;
-  }
-
-  {
-    const int64_t count = 64;
-    // scale the constants by number of pixels
-    const int64_t c1 = (cc1 * count * count) >> 12;
-    const int64_t c2 = (cc2 * count * count) >> 12;
-
-    const int64_t sum_a_x_sum_b = sum_a * sum_b;
+  const int64_t sum_a_x_sum_b = sum_a * sum_b;
 
-    const int64_t ssim_n = (2 * sum_a_x_sum_b + c1) *
-                           (2 * count * sum_axb - 2 * sum_a_x_sum_b + c2);
+  const int64_t ssim_n = (2 * sum_a_x_sum_b + c1) *
+                         (2 * count * sum_axb - 2 * sum_a_x_sum_b + c2);
 
-    const int64_t sum_a_sq = sum_a * sum_a;
-    const int64_t sum_b_sq = sum_b * sum_b;
+  const int64_t sum_a_sq = sum_a * sum_a;
+  const int64_t sum_b_sq = sum_b * sum_b;
 
-    const int64_t ssim_d =
-        (sum_a_sq + sum_b_sq + c1) *
-        (count * sum_sq_a - sum_a_sq + count * sum_sq_b - sum_b_sq + c2);
+  const int64_t ssim_d =
+      (sum_a_sq + sum_b_sq + c1) *
+      (count * sum_sq_a - sum_a_sq + count * sum_sq_b - sum_b_sq + c2);
 
-    if (ssim_d == 0) {
-      return DBL_MAX;
-    }
-    return (double)ssim_n / (double)ssim_d;
+  if (ssim_d == 0) {
+    return DBL_MAX;
   }
+  return (double)ssim_n / (double)ssim_d;
 }
 
 // We are using a 8x8 moving window with starting location of each 8x8 window
 // on the 4x4 pixel grid. Such arrangement allows the windows to overlap
 // block boundaries to penalize blocking artifacts.
+// Each window is made of 4 of the 4x4 blocks, so the sums of each block are
+// computed once, a strip of 4 rows at a time, and shared by the 4 windows
+// that overlap it.
 LIBYUV_API
 double CalcFrameSsim(const uint8_t* src_a,
                      int stride_a,
@@ -391,20 +373,76 @@ double CalcFrameSsim(const uint8_t* src_a,
                      int height) {
   int samples = 0;
   double ssim_total = 0;
-  double (*Ssim8x8)(const uint8_t* src_a, int stride_a, const uint8_t* src_b,
-                    int stride_b) = Ssim8x8_C;
+  // Number of windows across and down.  Windows start every 4 pixels while
+  // the start is less than width - 8.
+  const int windows_x = width > 8 ? (width - 5) / 4 : 0;
+  const int windows_y = height > 8 ? (height - 5) / 4 : 0;
+  const int sums_width = (windows_x + 1) * 4;
+  const int sums_stride = (windows_x + 1 + 15) & ~15;
+  int simd_width = 0;
+  void (*SsimSumsRow)(const uint8_t* src_a, int stride_a, const uint8_t* src_b,
+                      int stride_b, uint32_t* dst_sums, int sums_stride,
+                      int width) = SsimSumsRow_C;
+#if defined(HAS_SSIMSUMSROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    SsimSumsRow = SsimSumsRow_SSE2;
+    simd_width = sums_width & ~15;
+  }
+#endif
+#if defined(HAS_SSIMSUMSROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    SsimSumsRow = SsimSumsRow_AVX2;
+    simd_width = sums_width & ~31;
+  }
+#endif
+#if defined(HAS_SSIMSUMSROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    SsimSumsRow = SsimSumsRow_AVX512BW;
+    simd_width = sums_width & ~63;
+  }
+#endif
 
-  // sample point start with each 4x4 location
-  int i;
-  for (i = 0; i < height - 8; i += 4) {
-    int j;
-    for (j = 0; j < width - 8; j += 4) {
-      ssim_total += Ssim8x8(src_a + j, stride_a, src_b + j, stride_b);
-      samples++;
+  if (windows_x > 0 && windows_y > 0) {
+    // 2 strips of block sums, each 5 planes of sums_stride.
+    align_buffer_64(sums, sums_stride * 5 * 2 * sizeof(uint32_t));
+    uint32_t* sums0 = (uint32_t*)sums;
+    uint32_t* sums1 = sums0 + sums_stride * 5;
+    int i;
+    if (!sums) {
+      return 0.0;
     }
-
-    src_a += stride_a * 4;
-    src_b += stride_b * 4;
+    for (i = 0; i <= windows_y; ++i) {
+      uint32_t* tmp = sums0;
+      sums0 = sums1;
+      sums1 = tmp;
+      if (simd_width > 0) {
+        SsimSumsRow(src_a, stride_a, src_b, stride_b, sums1, sums_stride,
+                    simd_width);
+      }
+      if (sums_width > simd_width) {
+        SsimSumsRow_C(src_a + simd_width, stride_a, src_b + simd_width,
+                      stride_b, sums1 + simd_width / 4, sums_stride,
+                      sums_width - simd_width);
+      }
+      // sample point start with each 4x4 location
+      if (i > 0) {
+        int j;
+        for (j = 0; j < windows_x; ++j) {
+          int64_t window_sums[5];
+          int k;
+          for (k = 0; k < 5; ++k) {
+            const int o = k * sums_stride + j;
+            window_sums[k] = sums0[o] + sums0[o + 1] + sums1[o] + sums1[o + 1];
+          }
+          ssim_total += Ssim8x8(window_sums[0], window_sums[1], window_sums[2],
+                                window_sums[3], window_sums[4]);
+          samples++;
+        }
+      }
+      src_a += stride_a * 4;
+      src_b += stride_b * 4;
+    }
+    free_aligned_buffer_64(sums);
   }
 
   ssim_total /= samples;
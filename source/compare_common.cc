@@ -68,6 +68,42 @@ uint32_t HashDjb2_C(const uint8_t* src, int count, uint32_t seed) {
   return hash;
 }
 
+void SsimSumsRow_C(const uint8_t* src_a,
+                   int stride_a,
+                   const uint8_t* src_b,
+                   int stride_b,
+                   uint32_t* dst_sums,
+                   int sums_stride,
+                   int width) {
+  int x;
+  for (x = 0; x < width; x += 4) {
+    uint32_t sum_a = 0u;
+    uint32_t sum_b = 0u;
+    uint32_t sum_sq_a = 0u;
+    uint32_t sum_sq_b = 0u;
+    uint32_t sum_axb = 0u;
+    int i;
+    for (i = 0; i < 4; ++i) {
+      const uint8_t* a = src_a + i * stride_a + x;
+      const uint8_t* b = src_b + i * stride_b + x;
+      int j;
+      for (j = 0; j < 4; ++j) {
+        sum_a += a[j];
+        sum_b += b[j];
+        sum_sq_a += a[j] * a[j];
+        sum_sq_b += b[j] * b[j];
+        sum_axb += a[j] * b[j];
+      }
+    }
+    dst_sums[0] = sum_a;
+    dst_sums[sums_stride] = sum_b;
+    dst_sums[sums_stride * 2] = sum_sq_a;
+    dst_sums[sums_stride * 3] = sum_sq_b;
+    dst_sums[sums_stride * 4] = sum_axb;
+    ++dst_sums;
+  }
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
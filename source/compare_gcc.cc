@@ -354,6 +354,246 @@ uint32_t HashDjb2_SSE41(const uint8_t* src, int count, uint32_t seed) {
         "xmm7");
   return hash;
 }
+
+#ifdef HAS_SSIMSUMSROW_SSE2
+// Accumulate one row of 16 pixels into the 4x4 block sums.
+// xmm0/xmm1 hold word sums of a/b, xmm2/xmm3/xmm4 dword sums of a*a, b*b and
+// a*b.  Splitting even and odd bytes makes each pmaddwd dword cover 4 pixels.
+#define SSIMSUMSROW_SSE2(a, b)                    \
+  "movdqu      " a ",%%xmm6                  \n"  \
+  "movdqu      " b ",%%xmm8                  \n"  \
+  "movdqa      %%xmm6,%%xmm7                 \n"  \
+  "movdqa      %%xmm8,%%xmm9                 \n"  \
+  "pand        %%xmm5,%%xmm6                 \n"  \
+  "psrlw       $0x8,%%xmm7                   \n"  \
+  "pand        %%xmm5,%%xmm8                 \n"  \
+  "psrlw       $0x8,%%xmm9                   \n"  \
+  "paddw       %%xmm6,%%xmm0                 \n"  \
+  "paddw       %%xmm7,%%xmm0                 \n"  \
+  "paddw       %%xmm8,%%xmm1                 \n"  \
+  "paddw       %%xmm9,%%xmm1                 \n"  \
+  "movdqa      %%xmm6,%%xmm10                \n"  \
+  "pmaddwd     %%xmm6,%%xmm10                \n"  \
+  "paddd       %%xmm10,%%xmm2                \n"  \
+  "movdqa      %%xmm7,%%xmm10                \n"  \
+  "pmaddwd     %%xmm7,%%xmm10                \n"  \
+  "paddd       %%xmm10,%%xmm2                \n"  \
+  "movdqa      %%xmm8,%%xmm10                \n"  \
+  "pmaddwd     %%xmm8,%%xmm10                \n"  \
+  "paddd       %%xmm10,%%xmm3                \n"  \
+  "movdqa      %%xmm9,%%xmm10                \n"  \
+  "pmaddwd     %%xmm9,%%xmm10                \n"  \
+  "paddd       %%xmm10,%%xmm3                \n"  \
+  "pmaddwd     %%xmm8,%%xmm6                 \n"  \
+  "pmaddwd     %%xmm9,%%xmm7                 \n"  \
+  "paddd       %%xmm6,%%xmm4                 \n"  \
+  "paddd       %%xmm7,%%xmm4                 \n"
+
+void SsimSumsRow_SSE2(const uint8_t* src_a,
+                      int stride_a,
+                      const uint8_t* src_b,
+                      int stride_b,
+                      uint32_t* dst_sums,
+                      int sums_stride,
+                      int width) {
+  intptr_t sums_stride_bytes = (intptr_t)sums_stride * 4;
+  asm volatile(
+      "pcmpeqb     %%xmm5,%%xmm5                 \n"  // 0x00ff words
+      "psrlw       $0x8,%%xmm5                   \n"
+
+      LABELALIGN
+      "1:          \n"
+      "pxor        %%xmm0,%%xmm0                 \n"
+      "pxor        %%xmm1,%%xmm1                 \n"
+      "pxor        %%xmm2,%%xmm2                 \n"
+      "pxor        %%xmm3,%%xmm3                 \n"
+      "pxor        %%xmm4,%%xmm4                 \n"
+      SSIMSUMSROW_SSE2("(%0)", "(%1)")
+      SSIMSUMSROW_SSE2("(%0,%4,1)", "(%1,%5,1)")
+      SSIMSUMSROW_SSE2("(%0,%4,2)", "(%1,%5,2)")
+      SSIMSUMSROW_SSE2("(%0,%7,1)", "(%1,%8,1)")
+      "movdqa      %%xmm5,%%xmm6                 \n"  // 0x0001 words
+      "psrlw       $0x7,%%xmm6                   \n"
+      "pmaddwd     %%xmm6,%%xmm0                 \n"
+      "pmaddwd     %%xmm6,%%xmm1                 \n"
+      "movdqu      %%xmm0,(%2)                   \n"
+      "movdqu      %%xmm1,(%2,%6,1)              \n"
+      "movdqu      %%xmm2,(%2,%6,2)              \n"
+      "movdqu      %%xmm3,(%2,%9,1)              \n"
+      "movdqu      %%xmm4,(%2,%6,4)              \n"
+      "lea         0x10(%0),%0                   \n"
+      "lea         0x10(%1),%1                   \n"
+      "lea         0x10(%2),%2                   \n"
+      "sub         $0x10,%3                      \n"
+      "jg          1b                            \n"
+      : "+r"(src_a),                    // %0
+        "+r"(src_b),                    // %1
+        "+r"(dst_sums),                 // %2
+        "+r"(width)                     // %3
+      : "r"((intptr_t)(stride_a)),      // %4
+        "r"((intptr_t)(stride_b)),      // %5
+        "r"(sums_stride_bytes),         // %6
+        "r"((intptr_t)(stride_a) * 3),  // %7
+        "r"((intptr_t)(stride_b) * 3),  // %8
+        "r"(sums_stride_bytes * 3)      // %9
+      : "cc", "memory", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9", "xmm10");
+}
+#endif  // HAS_SSIMSUMSROW_SSE2
+
+#ifdef HAS_SSIMSUMSROW_AVX2
+#define SSIMSUMSROW_AVX2(a, b)                    \
+  "vmovdqu     " a ",%%ymm6                  \n"  \
+  "vmovdqu     " b ",%%ymm8                  \n"  \
+  "vpsrlw      $0x8,%%ymm6,%%ymm7            \n"  \
+  "vpand       %%ymm5,%%ymm6,%%ymm6          \n"  \
+  "vpsrlw      $0x8,%%ymm8,%%ymm9            \n"  \
+  "vpand       %%ymm5,%%ymm8,%%ymm8          \n"  \
+  "vpaddw      %%ymm6,%%ymm0,%%ymm0          \n"  \
+  "vpaddw      %%ymm7,%%ymm0,%%ymm0          \n"  \
+  "vpaddw      %%ymm8,%%ymm1,%%ymm1          \n"  \
+  "vpaddw      %%ymm9,%%ymm1,%%ymm1          \n"  \
+  "vpmaddwd    %%ymm6,%%ymm6,%%ymm10         \n"  \
+  "vpaddd      %%ymm10,%%ymm2,%%ymm2         \n"  \
+  "vpmaddwd    %%ymm7,%%ymm7,%%ymm10         \n"  \
+  "vpaddd      %%ymm10,%%ymm2,%%ymm2         \n"  \
+  "vpmaddwd    %%ymm8,%%ymm8,%%ymm10         \n"  \
+  "vpaddd      %%ymm10,%%ymm3,%%ymm3         \n"  \
+  "vpmaddwd    %%ymm9,%%ymm9,%%ymm10         \n"  \
+  "vpaddd      %%ymm10,%%ymm3,%%ymm3         \n"  \
+  "vpmaddwd    %%ymm8,%%ymm6,%%ymm6          \n"  \
+  "vpmaddwd    %%ymm9,%%ymm7,%%ymm7          \n"  \
+  "vpaddd      %%ymm6,%%ymm4,%%ymm4          \n"  \
+  "vpaddd      %%ymm7,%%ymm4,%%ymm4          \n"
+
+void SsimSumsRow_AVX2(const uint8_t* src_a,
+                      int stride_a,
+                      const uint8_t* src_b,
+                      int stride_b,
+                      uint32_t* dst_sums,
+                      int sums_stride,
+                      int width) {
+  intptr_t sums_stride_bytes = (intptr_t)sums_stride * 4;
+  asm volatile(
+      "vpcmpeqb    %%ymm5,%%ymm5,%%ymm5          \n"  // 0x00ff words
+      "vpsrlw      $0x8,%%ymm5,%%ymm5            \n"
+
+      LABELALIGN
+      "1:          \n"
+      "vpxor       %%ymm0,%%ymm0,%%ymm0          \n"
+      "vpxor       %%ymm1,%%ymm1,%%ymm1          \n"
+      "vpxor       %%ymm2,%%ymm2,%%ymm2          \n"
+      "vpxor       %%ymm3,%%ymm3,%%ymm3          \n"
+      "vpxor       %%ymm4,%%ymm4,%%ymm4          \n"
+      SSIMSUMSROW_AVX2("(%0)", "(%1)")
+      SSIMSUMSROW_AVX2("(%0,%4,1)", "(%1,%5,1)")
+      SSIMSUMSROW_AVX2("(%0,%4,2)", "(%1,%5,2)")
+      SSIMSUMSROW_AVX2("(%0,%7,1)", "(%1,%8,1)")
+      "vpsrlw      $0x7,%%ymm5,%%ymm6            \n"  // 0x0001 words
+      "vpmaddwd    %%ymm6,%%ymm0,%%ymm0          \n"
+      "vpmaddwd    %%ymm6,%%ymm1,%%ymm1          \n"
+      "vmovdqu     %%ymm0,(%2)                   \n"
+      "vmovdqu     %%ymm1,(%2,%6,1)              \n"
+      "vmovdqu     %%ymm2,(%2,%6,2)              \n"
+      "vmovdqu     %%ymm3,(%2,%9,1)              \n"
+      "vmovdqu     %%ymm4,(%2,%6,4)              \n"
+      "lea         0x20(%0),%0                   \n"
+      "lea         0x20(%1),%1                   \n"
+      "lea         0x20(%2),%2                   \n"
+      "sub         $0x20,%3                      \n"
+      "jg          1b                            \n"
+      "vzeroupper  \n"
+      : "+r"(src_a),                    // %0
+        "+r"(src_b),                    // %1
+        "+r"(dst_sums),                 // %2
+        "+r"(width)                     // %3
+      : "r"((intptr_t)(stride_a)),      // %4
+        "r"((intptr_t)(stride_b)),      // %5
+        "r"(sums_stride_bytes),         // %6
+        "r"((intptr_t)(stride_a) * 3),  // %7
+        "r"((intptr_t)(stride_b) * 3),  // %8
+        "r"(sums_stride_bytes * 3)      // %9
+      : "cc", "memory", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9", "xmm10");
+}
+#endif  // HAS_SSIMSUMSROW_AVX2
+
+#ifdef HAS_SSIMSUMSROW_AVX512BW
+#define SSIMSUMSROW_AVX512BW(a, b)                \
+  "vmovdqu64   " a ",%%zmm6                  \n"  \
+  "vmovdqu64   " b ",%%zmm8                  \n"  \
+  "vpsrlw      $0x8,%%zmm6,%%zmm7            \n"  \
+  "vpandd      %%zmm5,%%zmm6,%%zmm6          \n"  \
+  "vpsrlw      $0x8,%%zmm8,%%zmm9            \n"  \
+  "vpandd      %%zmm5,%%zmm8,%%zmm8          \n"  \
+  "vpaddw      %%zmm6,%%zmm0,%%zmm0          \n"  \
+  "vpaddw      %%zmm7,%%zmm0,%%zmm0          \n"  \
+  "vpaddw      %%zmm8,%%zmm1,%%zmm1          \n"  \
+  "vpaddw      %%zmm9,%%zmm1,%%zmm1          \n"  \
+  "vpmaddwd    %%zmm6,%%zmm6,%%zmm10         \n"  \
+  "vpaddd      %%zmm10,%%zmm2,%%zmm2         \n"  \
+  "vpmaddwd    %%zmm7,%%zmm7,%%zmm10         \n"  \
+  "vpaddd      %%zmm10,%%zmm2,%%zmm2         \n"  \
+  "vpmaddwd    %%zmm8,%%zmm8,%%zmm10         \n"  \
+  "vpaddd      %%zmm10,%%zmm3,%%zmm3         \n"  \
+  "vpmaddwd    %%zmm9,%%zmm9,%%zmm10         \n"  \
+  "vpaddd      %%zmm10,%%zmm3,%%zmm3         \n"  \
+  "vpmaddwd    %%zmm8,%%zmm6,%%zmm6          \n"  \
+  "vpmaddwd    %%zmm9,%%zmm7,%%zmm7          \n"  \
+  "vpaddd      %%zmm6,%%zmm4,%%zmm4          \n"  \
+  "vpaddd      %%zmm7,%%zmm4,%%zmm4          \n"
+
+void SsimSumsRow_AVX512BW(const uint8_t* src_a,
+                          int stride_a,
+                          const uint8_t* src_b,
+                          int stride_b,
+                          uint32_t* dst_sums,
+                          int sums_stride,
+                          int width) {
+  intptr_t sums_stride_bytes = (intptr_t)sums_stride * 4;
+  asm volatile(
+      "vpternlogd  $0xff,%%zmm5,%%zmm5,%%zmm5    \n"  // 0x00ff words
+      "vpsrlw      $0x8,%%zmm5,%%zmm5            \n"
+
+      LABELALIGN
+      "1:          \n"
+      "vpxord      %%zmm0,%%zmm0,%%zmm0          \n"
+      "vpxord      %%zmm1,%%zmm1,%%zmm1          \n"
+      "vpxord      %%zmm2,%%zmm2,%%zmm2          \n"
+      "vpxord      %%zmm3,%%zmm3,%%zmm3          \n"
+      "vpxord      %%zmm4,%%zmm4,%%zmm4          \n"
+      SSIMSUMSROW_AVX512BW("(%0)", "(%1)")
+      SSIMSUMSROW_AVX512BW("(%0,%4,1)", "(%1,%5,1)")
+      SSIMSUMSROW_AVX512BW("(%0,%4,2)", "(%1,%5,2)")
+      SSIMSUMSROW_AVX512BW("(%0,%7,1)", "(%1,%8,1)")
+      "vpsrlw      $0x7,%%zmm5,%%zmm6            \n"  // 0x0001 words
+      "vpmaddwd    %%zmm6,%%zmm0,%%zmm0          \n"
+      "vpmaddwd    %%zmm6,%%zmm1,%%zmm1          \n"
+      "vmovdqu64   %%zmm0,(%2)                   \n"
+      "vmovdqu64   %%zmm1,(%2,%6,1)              \n"
+      "vmovdqu64   %%zmm2,(%2,%6,2)              \n"
+      "vmovdqu64   %%zmm3,(%2,%9,1)              \n"
+      "vmovdqu64   %%zmm4,(%2,%6,4)              \n"
+      "lea         0x40(%0),%0                   \n"
+      "lea         0x40(%1),%1                   \n"
+      "lea         0x40(%2),%2                   \n"
+      "sub         $0x40,%3                      \n"
+      "jg          1b                            \n"
+      "vzeroupper  \n"
+      : "+r"(src_a),                    // %0
+        "+r"(src_b),                    // %1
+        "+r"(dst_sums),                 // %2
+        "+r"(width)                     // %3
+      : "r"((intptr_t)(stride_a)),      // %4
+        "r"((intptr_t)(stride_b)),      // %5
+        "r"(sums_stride_bytes),         // %6
+        "r"((intptr_t)(stride_a) * 3),  // %7
+        "r"((intptr_t)(stride_b) * 3),  // %8
+        "r"(sums_stride_bytes * 3)      // %9
+      : "cc", "memory", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9", "xmm10");
+}
+#endif  // HAS_SSIMSUMSROW_AVX512BW
 #endif  // defined(__x86_64__) || (defined(__i386__) && !defined(__pic__)))
 
 #ifdef __cplusplus
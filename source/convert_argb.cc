@@ -19,6 +19,7 @@
 #include "libyuv/planar_functions.h"  // For CopyPlane and ARGBShuffle.
 #include "libyuv/rotate_argb.h"
 #include "libyuv/row.h"
+#include "libyuv/row_dispatch.h"
 #include "libyuv/scale_row.h"  // For ScaleRowUp2_Linear and ScaleRowUp2_Bilinear
 #include "libyuv/video_common.h"
 
@@ -80,70 +81,7 @@ int I420ToARGBMatrix(const uint8_t* src_y,
     dst_argb = dst_argb + (ptrdiff_t)(height - 1) * dst_stride_argb;
     dst_stride_argb = -dst_stride_argb;
   }
-#if defined(HAS_I422TOARGBROW_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3)) {
-    I422ToARGBRow = I422ToARGBRow_Any_SSSE3;
-    if (IS_ALIGNED(width, 8)) {
-      I422ToARGBRow = I422ToARGBRow_SSSE3;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    I422ToARGBRow = I422ToARGBRow_Any_AVX2;
-    if (IS_ALIGNED(width, 16)) {
-      I422ToARGBRow = I422ToARGBRow_AVX2;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_AVX512BW)
-  if (TestCpuFlag(kCpuHasAVX512BW | kCpuHasAVX512VL) ==
-      (kCpuHasAVX512BW | kCpuHasAVX512VL)) {
-    I422ToARGBRow = I422ToARGBRow_Any_AVX512BW;
-    if (IS_ALIGNED(width, 32)) {
-      I422ToARGBRow = I422ToARGBRow_AVX512BW;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    I422ToARGBRow = I422ToARGBRow_Any_NEON;
-    if (IS_ALIGNED(width, 8)) {
-      I422ToARGBRow = I422ToARGBRow_NEON;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_SVE2)
-  if (TestCpuFlag(kCpuHasSVE2)) {
-    I422ToARGBRow = I422ToARGBRow_SVE2;
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_SME)
-  if (TestCpuFlag(kCpuHasSME)) {
-    I422ToARGBRow = I422ToARGBRow_SME;
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_LSX)
-  if (TestCpuFlag(kCpuHasLSX)) {
-    I422ToARGBRow = I422ToARGBRow_Any_LSX;
-    if (IS_ALIGNED(width, 16)) {
-      I422ToARGBRow = I422ToARGBRow_LSX;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_LASX)
-  if (TestCpuFlag(kCpuHasLASX)) {
-    I422ToARGBRow = I422ToARGBRow_Any_LASX;
-    if (IS_ALIGNED(width, 32)) {
-      I422ToARGBRow = I422ToARGBRow_LASX;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_RVV)
-  if (TestCpuFlag(kCpuHasRVV)) {
-    I422ToARGBRow = I422ToARGBRow_RVV;
-  }
-#endif
+  I422ToARGBRow = ROW_KERNEL(GetRowDispatch()->I422ToARGBRow, width);
 
   for (y = 0; y < height; ++y) {
     I422ToARGBRow(src_y, src_u, src_v, dst_argb, yuvconstants, width);
@@ -338,70 +276,7 @@ int I422ToARGBMatrix(const uint8_t* src_y,
     height = 1;
     src_stride_y = src_stride_u = src_stride_v = dst_stride_argb = 0;
   }
-#if defined(HAS_I422TOARGBROW_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3)) {
-    I422ToARGBRow = I422ToARGBRow_Any_SSSE3;
-    if (IS_ALIGNED(width, 8)) {
-      I422ToARGBRow = I422ToARGBRow_SSSE3;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    I422ToARGBRow = I422ToARGBRow_Any_AVX2;
-    if (IS_ALIGNED(width, 16)) {
-      I422ToARGBRow = I422ToARGBRow_AVX2;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_AVX512BW)
-  if (TestCpuFlag(kCpuHasAVX512BW | kCpuHasAVX512VL) ==
-      (kCpuHasAVX512BW | kCpuHasAVX512VL)) {
-    I422ToARGBRow = I422ToARGBRow_Any_AVX512BW;
-    if (IS_ALIGNED(width, 32)) {
-      I422ToARGBRow = I422ToARGBRow_AVX512BW;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    I422ToARGBRow = I422ToARGBRow_Any_NEON;
-    if (IS_ALIGNED(width, 8)) {
-      I422ToARGBRow = I422ToARGBRow_NEON;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_SVE2)
-  if (TestCpuFlag(kCpuHasSVE2)) {
-    I422ToARGBRow = I422ToARGBRow_SVE2;
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_SME)
-  if (TestCpuFlag(kCpuHasSME)) {
-    I422ToARGBRow = I422ToARGBRow_SME;
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_LSX)
-  if (TestCpuFlag(kCpuHasLSX)) {
-    I422ToARGBRow = I422ToARGBRow_Any_LSX;
-    if (IS_ALIGNED(width, 16)) {
-      I422ToARGBRow = I422ToARGBRow_LSX;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_LASX)
-  if (TestCpuFlag(kCpuHasLASX)) {
-    I422ToARGBRow = I422ToARGBRow_Any_LASX;
-    if (IS_ALIGNED(width, 32)) {
-      I422ToARGBRow = I422ToARGBRow_LASX;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_RVV)
-  if (TestCpuFlag(kCpuHasRVV)) {
-    I422ToARGBRow = I422ToARGBRow_RVV;
-  }
-#endif
+  I422ToARGBRow = ROW_KERNEL(GetRowDispatch()->I422ToARGBRow, width);
 
   for (y = 0; y < height; ++y) {
     I422ToARGBRow(src_y, src_u, src_v, dst_argb, yuvconstants, width);
@@ -5032,6 +4907,10 @@ int UYVYToARGB(const uint8_t* src_uyvy,
                           &kYuvI601Constants, width, height);
 }
 
+// Pixels converted per chunk by the Android420ToARGBMatrix fallback.  Even,
+// so that each chunk starts on a chroma sample.
+#define kAndroid420ChunkWidth 1024
+
 static void WeavePixels(const uint8_t* src_u,
                         const uint8_t* src_v,
                         int src_pixel_stride_uv,
@@ -5062,10 +4941,7 @@ int Android420ToARGBMatrix(const uint8_t* src_y,
                            int width,
                            int height) {
   int y;
-  uint8_t* dst_uv;
   const ptrdiff_t vu_off = src_v - src_u;
-  int halfwidth = (width + 1) >> 1;
-  int halfheight = (height + 1) >> 1;
   assert(yuvconstants);
   if (!src_y || !src_u || !src_v || !dst_argb || width <= 0 || height == 0 ||
       height == INT_MIN) {
@@ -5074,7 +4950,6 @@ int Android420ToARGBMatrix(const uint8_t* src_y,
   // Negative height means invert the image.
   if (height < 0) {
     height = -height;
-    halfheight = (height + 1) >> 1;
     dst_argb = dst_argb + (ptrdiff_t)(height - 1) * dst_stride_argb;
     dst_stride_argb = -dst_stride_argb;
   }
@@ -5097,23 +4972,28 @@ int Android420ToARGBMatrix(const uint8_t* src_y,
                             dst_stride_argb, yuvconstants, width, height);
   }
 
-  // General case fallback creates NV12
-  const uint64_t uv_size = (uint64_t)halfwidth * 2 * halfheight;
-  if (uv_size > SIZE_MAX)
-    return 1;
-  align_buffer_64(plane_uv, (size_t)uv_size);
-  if (!plane_uv)
-    return 1;
-  dst_uv = plane_uv;
-  for (y = 0; y < halfheight; ++y) {
-    WeavePixels(src_u, src_v, src_pixel_stride_uv, dst_uv, halfwidth);
-    src_u += src_stride_u;
-    src_v += src_stride_v;
-    dst_uv += halfwidth * 2;
+  // General case fallback weaves the chroma into NV12 through a stack chunk
+  // and converts a chunk of 2 rows at a time.
+  {
+    SIMD_ALIGNED(uint8_t row_uv[kAndroid420ChunkWidth]);
+    for (y = 0; y < height; y += 2) {
+      const int rows = height - y < 2 ? height - y : 2;
+      int x;
+      for (x = 0; x < width; x += kAndroid420ChunkWidth) {
+        int n = width - x < kAndroid420ChunkWidth ? width - x
+                                                  : kAndroid420ChunkWidth;
+        WeavePixels(src_u + (ptrdiff_t)(x / 2) * src_pixel_stride_uv,
+                    src_v + (ptrdiff_t)(x / 2) * src_pixel_stride_uv,
+                    src_pixel_stride_uv, row_uv, (n + 1) / 2);
+        NV12ToARGBMatrix(src_y + x, src_stride_y, row_uv, 0, dst_argb + x * 4,
+                         dst_stride_argb, yuvconstants, n, rows);
+      }
+      src_y += (ptrdiff_t)src_stride_y * 2;
+      src_u += src_stride_u;
+      src_v += src_stride_v;
+      dst_argb += (ptrdiff_t)dst_stride_argb * 2;
+    }
   }
-  NV12ToARGBMatrix(src_y, src_stride_y, plane_uv, halfwidth * 2, dst_argb,
-                   dst_stride_argb, yuvconstants, width, height);
-  free_aligned_buffer_64(plane_uv);
   return 0;
 }
 
@@ -6317,6 +6197,9 @@ static const uint8_t kDither565_4x4[16] = {
     0, 4, 1, 5, 6, 2, 7, 3, 1, 5, 0, 4, 7, 3, 6, 2,
 };
 
+// Pixels converted per chunk by I420ToRGB565Dither.
+#define kDitherChunkWidth 512
+
 // Convert I420 to RGB565 with dithering.
 LIBYUV_API
 int I420ToRGB565Dither(const uint8_t* src_y,
@@ -6353,70 +6236,7 @@ int I420ToRGB565Dither(const uint8_t* src_y,
     dither4x4 = kDither565_4x4;
   }
   memcpy(dither4, dither4x4, 16);
-#if defined(HAS_I422TOARGBROW_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3)) {
-    I422ToARGBRow = I422ToARGBRow_Any_SSSE3;
-    if (IS_ALIGNED(width, 8)) {
-      I422ToARGBRow = I422ToARGBRow_SSSE3;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    I422ToARGBRow = I422ToARGBRow_Any_AVX2;
-    if (IS_ALIGNED(width, 16)) {
-      I422ToARGBRow = I422ToARGBRow_AVX2;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_AVX512BW)
-  if (TestCpuFlag(kCpuHasAVX512BW | kCpuHasAVX512VL) ==
-      (kCpuHasAVX512BW | kCpuHasAVX512VL)) {
-    I422ToARGBRow = I422ToARGBRow_Any_AVX512BW;
-    if (IS_ALIGNED(width, 32)) {
-      I422ToARGBRow = I422ToARGBRow_AVX512BW;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    I422ToARGBRow = I422ToARGBRow_Any_NEON;
-    if (IS_ALIGNED(width, 8)) {
-      I422ToARGBRow = I422ToARGBRow_NEON;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_SVE2)
-  if (TestCpuFlag(kCpuHasSVE2)) {
-    I422ToARGBRow = I422ToARGBRow_SVE2;
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_SME)
-  if (TestCpuFlag(kCpuHasSME)) {
-    I422ToARGBRow = I422ToARGBRow_SME;
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_LSX)
-  if (TestCpuFlag(kCpuHasLSX)) {
-    I422ToARGBRow = I422ToARGBRow_Any_LSX;
-    if (IS_ALIGNED(width, 16)) {
-      I422ToARGBRow = I422ToARGBRow_LSX;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_LASX)
-  if (TestCpuFlag(kCpuHasLASX)) {
-    I422ToARGBRow = I422ToARGBRow_Any_LASX;
-    if (IS_ALIGNED(width, 32)) {
-      I422ToARGBRow = I422ToARGBRow_LASX;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_RVV)
-  if (TestCpuFlag(kCpuHasRVV)) {
-    I422ToARGBRow = I422ToARGBRow_RVV;
-  }
-#endif
+  I422ToARGBRow = ROW_KERNEL(GetRowDispatch()->I422ToARGBRow, width);
 #if defined(HAS_ARGBTORGB565DITHERROW_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
     ARGBToRGB565DitherRow = ARGBToRGB565DitherRow_Any_SSE2;
@@ -6463,13 +6283,17 @@ int I420ToRGB565Dither(const uint8_t* src_y,
   }
 #endif
   {
-    // Allocate a row of argb.
-    align_buffer_64(row_argb, width * 4);
-    if (!row_argb)
-      return 1;
+    // Convert a row of argb at a time through a stack chunk.  The chunk is a
+    // multiple of 4 pixels so the dither pattern lines up across chunks.
+    SIMD_ALIGNED(uint8_t row_argb[kDitherChunkWidth * 4]);
     for (y = 0; y < height; ++y) {
-      I422ToARGBRow(src_y, src_u, src_v, row_argb, &kYuvI601Constants, width);
-      ARGBToRGB565DitherRow(row_argb, dst_rgb565, dither4[y & 3], width);
+      int x;
+      for (x = 0; x < width; x += kDitherChunkWidth) {
+        int n = width - x < kDitherChunkWidth ? width - x : kDitherChunkWidth;
+        I422ToARGBRow(src_y + x, src_u + x / 2, src_v + x / 2, row_argb,
+                      &kYuvI601Constants, n);
+        ARGBToRGB565DitherRow(row_argb, dst_rgb565 + x * 2, dither4[y & 3], n);
+      }
       dst_rgb565 += dst_stride_rgb565;
       src_y += src_stride_y;
       if (y & 1) {
@@ -6477,7 +6301,6 @@ int I420ToRGB565Dither(const uint8_t* src_y,
         src_v += src_stride_v;
       }
     }
-    free_aligned_buffer_64(row_argb);
   }
   return 0;
 }
@@ -6647,7 +6470,8 @@ static int I420ToARGBMatrixBilinear(const uint8_t* src_y,
                                     int dst_stride_argb,
                                     const struct YuvConstants* yuvconstants,
                                     int width,
-                                    int height) {
+                                    int height,
+                                    uint8_t* scratch) {
   int y;
   void (*I444ToARGBRow)(const uint8_t* y_buf, const uint8_t* u_buf,
                         const uint8_t* v_buf, uint8_t* rgb_buf,
@@ -6753,7 +6577,7 @@ static int I420ToARGBMatrixBilinear(const uint8_t* src_y,
 
   // alloc 4 lines temp
   const int row_size = (width + 31) & ~31;
-  align_buffer_64(row, row_size * 4);
+  align_buffer_64_scratch(row, row_size * 4, scratch);
   uint8_t* temp_u_1 = row;
   uint8_t* temp_u_2 = row + row_size;
   uint8_t* temp_v_1 = row + row_size * 2;
@@ -6800,7 +6624,8 @@ static int I422ToARGBMatrixLinear(const uint8_t* src_y,
                                   int dst_stride_argb,
                                   const struct YuvConstants* yuvconstants,
                                   int width,
-                                  int height) {
+                                  int height,
+                                  uint8_t* scratch) {
   int y;
   void (*I444ToARGBRow)(const uint8_t* y_buf, const uint8_t* u_buf,
                         const uint8_t* v_buf, uint8_t* rgb_buf,
@@ -6894,7 +6719,7 @@ static int I422ToARGBMatrixLinear(const uint8_t* src_y,
 
   // alloc 2 lines temp
   const int row_size = (width + 31) & ~31;
-  align_buffer_64(row, row_size * 2);
+  align_buffer_64_scratch(row, row_size * 2, scratch);
   uint8_t* temp_u = row;
   uint8_t* temp_v = row + row_size;
   if (!row)
@@ -6924,7 +6749,8 @@ static int I420ToRGB24MatrixBilinear(const uint8_t* src_y,
                                      int dst_stride_rgb24,
                                      const struct YuvConstants* yuvconstants,
                                      int width,
-                                     int height) {
+                                     int height,
+                                     uint8_t* scratch) {
   int y;
   void (*I444ToRGB24Row)(const uint8_t* y_buf, const uint8_t* u_buf,
                          const uint8_t* v_buf, uint8_t* rgb_buf,
@@ -7030,7 +6856,7 @@ static int I420ToRGB24MatrixBilinear(const uint8_t* src_y,
 
   // alloc 4 lines temp
   const int row_size = (width + 31) & ~31;
-  align_buffer_64(row, row_size * 4);
+  align_buffer_64_scratch(row, row_size * 4, scratch);
   uint8_t* temp_u_1 = row;
   uint8_t* temp_u_2 = row + row_size;
   uint8_t* temp_v_1 = row + row_size * 2;
@@ -7077,7 +6903,8 @@ static int I010ToAR30MatrixBilinear(const uint16_t* src_y,
                                     int dst_stride_ar30,
                                     const struct YuvConstants* yuvconstants,
                                     int width,
-                                    int height) {
+                                    int height,
+                                    uint8_t* scratch) {
   int y;
   void (*I410ToAR30Row)(const uint16_t* y_buf, const uint16_t* u_buf,
                         const uint16_t* v_buf, uint8_t* rgb_buf,
@@ -7157,7 +6984,7 @@ static int I010ToAR30MatrixBilinear(const uint16_t* src_y,
 
   // alloc 4 lines temp
   const int row_size = (width + 31) & ~31;
-  align_buffer_64(row, row_size * 4 * sizeof(uint16_t));
+  align_buffer_64_scratch(row, row_size * 4 * sizeof(uint16_t), scratch);
   uint16_t* temp_u_1 = (uint16_t*)(row);
   uint16_t* temp_u_2 = (uint16_t*)(row) + row_size;
   uint16_t* temp_v_1 = (uint16_t*)(row) + row_size * 2;
@@ -7205,7 +7032,8 @@ static int I210ToAR30MatrixLinear(const uint16_t* src_y,
                                   int dst_stride_ar30,
                                   const struct YuvConstants* yuvconstants,
                                   int width,
-                                  int height) {
+                                  int height,
+                                  uint8_t* scratch) {
   int y;
   void (*I410ToAR30Row)(const uint16_t* y_buf, const uint16_t* u_buf,
                         const uint16_t* v_buf, uint8_t* rgb_buf,
@@ -7277,7 +7105,7 @@ static int I210ToAR30MatrixLinear(const uint16_t* src_y,
 
   // alloc 2 lines temp
   const int row_size = (width + 31) & ~31;
-  align_buffer_64(row, row_size * 2 * sizeof(uint16_t));
+  align_buffer_64_scratch(row, row_size * 2 * sizeof(uint16_t), scratch);
   uint16_t* temp_u = (uint16_t*)(row);
   uint16_t* temp_v = (uint16_t*)(row) + row_size;
   if (!row)
@@ -7306,7 +7134,8 @@ static int I010ToARGBMatrixBilinear(const uint16_t* src_y,
                                     int dst_stride_argb,
                                     const struct YuvConstants* yuvconstants,
                                     int width,
-                                    int height) {
+                                    int height,
+                                    uint8_t* scratch) {
   int y;
   void (*I410ToARGBRow)(const uint16_t* y_buf, const uint16_t* u_buf,
                         const uint16_t* v_buf, uint8_t* rgb_buf,
@@ -7386,7 +7215,7 @@ static int I010ToARGBMatrixBilinear(const uint16_t* src_y,
 
   // alloc 4 lines temp
   const int row_size = (width + 31) & ~31;
-  align_buffer_64(row, row_size * 4 * sizeof(uint16_t));
+  align_buffer_64_scratch(row, row_size * 4 * sizeof(uint16_t), scratch);
   uint16_t* temp_u_1 = (uint16_t*)(row);
   uint16_t* temp_u_2 = (uint16_t*)(row) + row_size;
   uint16_t* temp_v_1 = (uint16_t*)(row) + row_size * 2;
@@ -7433,7 +7262,8 @@ static int I210ToARGBMatrixLinear(const uint16_t* src_y,
                                   int dst_stride_argb,
                                   const struct YuvConstants* yuvconstants,
                                   int width,
-                                  int height) {
+                                  int height,
+                                  uint8_t* scratch) {
   int y;
   void (*I410ToARGBRow)(const uint16_t* y_buf, const uint16_t* u_buf,
                         const uint16_t* v_buf, uint8_t* rgb_buf,
@@ -7505,7 +7335,7 @@ static int I210ToARGBMatrixLinear(const uint16_t* src_y,
 
   // alloc 2 lines temp
   const int row_size = (width + 31) & ~31;
-  align_buffer_64(row, row_size * 2 * sizeof(uint16_t));
+  align_buffer_64_scratch(row, row_size * 2 * sizeof(uint16_t), scratch);
   uint16_t* temp_u = (uint16_t*)(row);
   uint16_t* temp_v = (uint16_t*)(row) + row_size;
   if (!row)
@@ -7539,7 +7369,8 @@ static int I420AlphaToARGBMatrixBilinear(
     const struct YuvConstants* yuvconstants,
     int width,
     int height,
-    int attenuate) {
+    int attenuate,
+    uint8_t* scratch) {
   int y;
   void (*I444AlphaToARGBRow)(const uint8_t* y_buf, const uint8_t* u_buf,
                              const uint8_t* v_buf, const uint8_t* a_buf,
@@ -7693,7 +7524,7 @@ static int I420AlphaToARGBMatrixBilinear(
 
   // alloc 4 lines temp
   const int row_size = (width + 31) & ~31;
-  align_buffer_64(row, row_size * 4);
+  align_buffer_64_scratch(row, row_size * 4, scratch);
   uint8_t* temp_u_1 = row;
   uint8_t* temp_u_2 = row + row_size;
   uint8_t* temp_v_1 = row + row_size * 2;
@@ -7762,7 +7593,8 @@ static int I422AlphaToARGBMatrixLinear(const uint8_t* src_y,
                                        const struct YuvConstants* yuvconstants,
                                        int width,
                                        int height,
-                                       int attenuate) {
+                                       int attenuate,
+                                       uint8_t* scratch) {
   int y;
   void (*I444AlphaToARGBRow)(const uint8_t* y_buf, const uint8_t* u_buf,
                              const uint8_t* v_buf, const uint8_t* a_buf,
@@ -7905,7 +7737,7 @@ static int I422AlphaToARGBMatrixLinear(const uint8_t* src_y,
 
   // alloc 2 lines temp
   const int row_size = (width + 31) & ~31;
-  align_buffer_64(row, row_size * 2);
+  align_buffer_64_scratch(row, row_size * 2, scratch);
   uint8_t* temp_u = row;
   uint8_t* temp_v = row + row_size;
   if (!row)
@@ -7944,7 +7776,8 @@ static int I010AlphaToARGBMatrixBilinear(
     const struct YuvConstants* yuvconstants,
     int width,
     int height,
-    int attenuate) {
+    int attenuate,
+    uint8_t* scratch) {
   int y;
   void (*I410AlphaToARGBRow)(const uint16_t* y_buf, const uint16_t* u_buf,
                              const uint16_t* v_buf, const uint16_t* a_buf,
@@ -8072,7 +7905,7 @@ static int I010AlphaToARGBMatrixBilinear(
 
   // alloc 4 lines temp
   const int row_size = (width + 31) & ~31;
-  align_buffer_64(row, row_size * 4 * sizeof(uint16_t));
+  align_buffer_64_scratch(row, row_size * 4 * sizeof(uint16_t), scratch);
   uint16_t* temp_u_1 = (uint16_t*)(row);
   uint16_t* temp_u_2 = (uint16_t*)(row) + row_size;
   uint16_t* temp_v_1 = (uint16_t*)(row) + row_size * 2;
@@ -8141,7 +7974,8 @@ static int I210AlphaToARGBMatrixLinear(const uint16_t* src_y,
                                        const struct YuvConstants* yuvconstants,
                                        int width,
                                        int height,
-                                       int attenuate) {
+                                       int attenuate,
+                                       uint8_t* scratch) {
   int y;
   void (*I410AlphaToARGBRow)(const uint16_t* y_buf, const uint16_t* u_buf,
                              const uint16_t* v_buf, const uint16_t* a_buf,
@@ -8261,7 +8095,7 @@ static int I210AlphaToARGBMatrixLinear(const uint16_t* src_y,
 
   // alloc 2 lines temp
   const int row_size = (width + 31) & ~31;
-  align_buffer_64(row, row_size * 2 * sizeof(uint16_t));
+  align_buffer_64_scratch(row, row_size * 2 * sizeof(uint16_t), scratch);
   uint16_t* temp_u = (uint16_t*)(row);
   uint16_t* temp_v = (uint16_t*)(row) + row_size;
   if (!row)
@@ -8293,7 +8127,8 @@ static int P010ToARGBMatrixBilinear(const uint16_t* src_y,
                                     int dst_stride_argb,
                                     const struct YuvConstants* yuvconstants,
                                     int width,
-                                    int height) {
+                                    int height,
+                                    uint8_t* scratch) {
   int y;
   void (*P410ToARGBRow)(
       const uint16_t* y_buf, const uint16_t* uv_buf, uint8_t* rgb_buf,
@@ -8367,7 +8202,7 @@ static int P010ToARGBMatrixBilinear(const uint16_t* src_y,
 
   // alloc 2 lines temp
   const int row_size = (2 * width + 31) & ~31;
-  align_buffer_64(row, row_size * 2 * sizeof(uint16_t));
+  align_buffer_64_scratch(row, row_size * 2 * sizeof(uint16_t), scratch);
   uint16_t* temp_uv_1 = (uint16_t*)(row);
   uint16_t* temp_uv_2 = (uint16_t*)(row) + row_size;
   if (!row)
@@ -8406,7 +8241,8 @@ static int P210ToARGBMatrixLinear(const uint16_t* src_y,
                                   int dst_stride_argb,
                                   const struct YuvConstants* yuvconstants,
                                   int width,
-                                  int height) {
+                                  int height,
+                                  uint8_t* scratch) {
   int y;
   void (*P410ToARGBRow)(
       const uint16_t* y_buf, const uint16_t* uv_buf, uint8_t* rgb_buf,
@@ -8478,7 +8314,7 @@ static int P210ToARGBMatrixLinear(const uint16_t* src_y,
 #endif
 
   const int row_size = (2 * width + 31) & ~31;
-  align_buffer_64(row, row_size * sizeof(uint16_t));
+  align_buffer_64_scratch(row, row_size * sizeof(uint16_t), scratch);
   uint16_t* temp_uv = (uint16_t*)(row);
   if (!row)
     return 1;
@@ -8503,7 +8339,8 @@ static int P010ToAR30MatrixBilinear(const uint16_t* src_y,
                                     int dst_stride_ar30,
                                     const struct YuvConstants* yuvconstants,
                                     int width,
-                                    int height) {
+                                    int height,
+                                    uint8_t* scratch) {
   int y;
   void (*P410ToAR30Row)(
       const uint16_t* y_buf, const uint16_t* uv_buf, uint8_t* rgb_buf,
@@ -8577,7 +8414,7 @@ static int P010ToAR30MatrixBilinear(const uint16_t* src_y,
 
   // alloc 2 lines temp
   const int row_size = (2 * width + 31) & ~31;
-  align_buffer_64(row, row_size * 2 * sizeof(uint16_t));
+  align_buffer_64_scratch(row, row_size * 2 * sizeof(uint16_t), scratch);
   uint16_t* temp_uv_1 = (uint16_t*)(row);
   uint16_t* temp_uv_2 = (uint16_t*)(row) + row_size;
   if (!row)
@@ -8616,7 +8453,8 @@ static int P210ToAR30MatrixLinear(const uint16_t* src_y,
                                   int dst_stride_ar30,
                                   const struct YuvConstants* yuvconstants,
                                   int width,
-                                  int height) {
+                                  int height,
+                                  uint8_t* scratch) {
   int y;
   void (*P410ToAR30Row)(
       const uint16_t* y_buf, const uint16_t* uv_buf, uint8_t* rgb_buf,
@@ -8688,7 +8526,7 @@ static int P210ToAR30MatrixLinear(const uint16_t* src_y,
 #endif
 
   const int row_size = (2 * width + 31) & ~31;
-  align_buffer_64(row, row_size * sizeof(uint16_t));
+  align_buffer_64_scratch(row, row_size * sizeof(uint16_t), scratch);
   uint16_t* temp_uv = (uint16_t*)(row);
   if (!row)
     return 1;
@@ -8715,7 +8553,8 @@ static int I422ToRGB24MatrixLinear(const uint8_t* src_y,
                                    int dst_stride_rgb24,
                                    const struct YuvConstants* yuvconstants,
                                    int width,
-                                   int height) {
+                                   int height,
+                                   uint8_t* scratch) {
   int y;
   void (*I444ToRGB24Row)(const uint8_t* y_buf, const uint8_t* u_buf,
                          const uint8_t* v_buf, uint8_t* rgb_buf,
@@ -8801,7 +8640,7 @@ static int I422ToRGB24MatrixLinear(const uint8_t* src_y,
 
   // alloc 2 lines temp
   const int row_size = (width + 31) & ~31;
-  align_buffer_64(row, row_size * 2);
+  align_buffer_64_scratch(row, row_size * 2, scratch);
   uint8_t* temp_u = row;
   uint8_t* temp_v = row + row_size;
   if (!row)
@@ -8821,6 +8660,52 @@ static int I422ToRGB24MatrixLinear(const uint8_t* src_y,
   return 0;
 }
 
+// The largest row buffer of the filter functions is 4 rows of 16 bit chroma.
+LIBYUV_API
+int YUVToRGBMatrixFilterScratchSize(int width) {
+  if (width <= 0 || width > (INT_MAX - 63) / 8 - 31) {
+    return -1;
+  }
+  return ((width + 31) & ~31) * 4 * (int)sizeof(uint16_t) + 63;
+}
+
+LIBYUV_API
+int I422ToRGB24MatrixFilterScratch(const uint8_t* src_y,
+                                   int src_stride_y,
+                                   const uint8_t* src_u,
+                                   int src_stride_u,
+                                   const uint8_t* src_v,
+                                   int src_stride_v,
+                                   uint8_t* dst_rgb24,
+                                   int dst_stride_rgb24,
+                                   const struct YuvConstants* yuvconstants,
+                                   int width,
+                                   int height,
+                                   enum FilterMode filter,
+                                   uint8_t* scratch,
+                                   int scratch_size) {
+  if (scratch && scratch_size < YUVToRGBMatrixFilterScratchSize(width)) {
+    return -1;
+  }
+  switch (filter) {
+    case kFilterNone:
+      return I422ToRGB24Matrix(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                               src_stride_v, dst_rgb24, dst_stride_rgb24,
+                               yuvconstants, width, height);
+    case kFilterBilinear:
+    case kFilterBox:
+    case kFilterBicubic:
+    case kFilterLanczos3:
+    case kFilterLinear:
+      return I422ToRGB24MatrixLinear(src_y, src_stride_y, src_u, src_stride_u,
+                                     src_v, src_stride_v, dst_rgb24,
+                                     dst_stride_rgb24, yuvconstants, width,
+                                     height, scratch);
+  }
+
+  return -1;
+}
+
 LIBYUV_API
 int I422ToRGB24MatrixFilter(const uint8_t* src_y,
                             int src_stride_y,
@@ -8834,17 +8719,47 @@ int I422ToRGB24MatrixFilter(const uint8_t* src_y,
                             int width,
                             int height,
                             enum FilterMode filter) {
+  return I422ToRGB24MatrixFilterScratch(src_y, src_stride_y, src_u,
+                                        src_stride_u, src_v, src_stride_v,
+                                        dst_rgb24, dst_stride_rgb24,
+                                        yuvconstants, width, height, filter,
+                                        NULL, 0);
+}
+
+LIBYUV_API
+int I420ToARGBMatrixFilterScratch(const uint8_t* src_y,
+                                  int src_stride_y,
+                                  const uint8_t* src_u,
+                                  int src_stride_u,
+                                  const uint8_t* src_v,
+                                  int src_stride_v,
+                                  uint8_t* dst_argb,
+                                  int dst_stride_argb,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum FilterMode filter,
+                                  uint8_t* scratch,
+                                  int scratch_size) {
+  if (scratch && scratch_size < YUVToRGBMatrixFilterScratchSize(width)) {
+    return -1;
+  }
   switch (filter) {
     case kFilterNone:
-      return I422ToRGB24Matrix(src_y, src_stride_y, src_u, src_stride_u, src_v,
-                               src_stride_v, dst_rgb24, dst_stride_rgb24,
-                               yuvconstants, width, height);
+      return I420ToARGBMatrix(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                              src_stride_v, dst_argb, dst_stride_argb,
+                              yuvconstants, width, height);
     case kFilterBilinear:
     case kFilterBox:
+    case kFilterBicubic:
+    case kFilterLanczos3:
+      return I420ToARGBMatrixBilinear(src_y, src_stride_y, src_u, src_stride_u,
+                                      src_v, src_stride_v, dst_argb,
+                                      dst_stride_argb, yuvconstants, width,
+                                      height, scratch);
     case kFilterLinear:
-      return I422ToRGB24MatrixLinear(
-          src_y, src_stride_y, src_u, src_stride_u, src_v, src_stride_v,
-          dst_rgb24, dst_stride_rgb24, yuvconstants, width, height);
+      // Actually we can do this, but probably there's no usage.
+      return -1;
   }
 
   return -1;
@@ -8863,19 +8778,44 @@ int I420ToARGBMatrixFilter(const uint8_t* src_y,
                            int width,
                            int height,
                            enum FilterMode filter) {
+  return I420ToARGBMatrixFilterScratch(src_y, src_stride_y, src_u, src_stride_u,
+                                       src_v, src_stride_v, dst_argb,
+                                       dst_stride_argb, yuvconstants, width,
+                                       height, filter, NULL, 0);
+}
+
+LIBYUV_API
+int I422ToARGBMatrixFilterScratch(const uint8_t* src_y,
+                                  int src_stride_y,
+                                  const uint8_t* src_u,
+                                  int src_stride_u,
+                                  const uint8_t* src_v,
+                                  int src_stride_v,
+                                  uint8_t* dst_argb,
+                                  int dst_stride_argb,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum FilterMode filter,
+                                  uint8_t* scratch,
+                                  int scratch_size) {
+  if (scratch && scratch_size < YUVToRGBMatrixFilterScratchSize(width)) {
+    return -1;
+  }
   switch (filter) {
     case kFilterNone:
-      return I420ToARGBMatrix(src_y, src_stride_y, src_u, src_stride_u, src_v,
+      return I422ToARGBMatrix(src_y, src_stride_y, src_u, src_stride_u, src_v,
                               src_stride_v, dst_argb, dst_stride_argb,
                               yuvconstants, width, height);
     case kFilterBilinear:
     case kFilterBox:
-      return I420ToARGBMatrixBilinear(
-          src_y, src_stride_y, src_u, src_stride_u, src_v, src_stride_v,
-          dst_argb, dst_stride_argb, yuvconstants, width, height);
+    case kFilterBicubic:
+    case kFilterLanczos3:
     case kFilterLinear:
-      // Actually we can do this, but probably there's no usage.
-      return -1;
+      return I422ToARGBMatrixLinear(src_y, src_stride_y, src_u, src_stride_u,
+                                    src_v, src_stride_v, dst_argb,
+                                    dst_stride_argb, yuvconstants, width,
+                                    height, scratch);
   }
 
   return -1;
@@ -8894,17 +8834,44 @@ int I422ToARGBMatrixFilter(const uint8_t* src_y,
                            int width,
                            int height,
                            enum FilterMode filter) {
+  return I422ToARGBMatrixFilterScratch(src_y, src_stride_y, src_u, src_stride_u,
+                                       src_v, src_stride_v, dst_argb,
+                                       dst_stride_argb, yuvconstants, width,
+                                       height, filter, NULL, 0);
+}
+
+LIBYUV_API
+int I420ToRGB24MatrixFilterScratch(const uint8_t* src_y,
+                                   int src_stride_y,
+                                   const uint8_t* src_u,
+                                   int src_stride_u,
+                                   const uint8_t* src_v,
+                                   int src_stride_v,
+                                   uint8_t* dst_rgb24,
+                                   int dst_stride_rgb24,
+                                   const struct YuvConstants* yuvconstants,
+                                   int width,
+                                   int height,
+                                   enum FilterMode filter,
+                                   uint8_t* scratch,
+                                   int scratch_size) {
+  if (scratch && scratch_size < YUVToRGBMatrixFilterScratchSize(width)) {
+    return -1;
+  }
   switch (filter) {
     case kFilterNone:
-      return I422ToARGBMatrix(src_y, src_stride_y, src_u, src_stride_u, src_v,
-                              src_stride_v, dst_argb, dst_stride_argb,
-                              yuvconstants, width, height);
+      return I420ToRGB24Matrix(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                               src_stride_v, dst_rgb24, dst_stride_rgb24,
+                               yuvconstants, width, height);
+    case kFilterLinear:  // TODO(fb): Implement Linear using Bilinear stride 0
     case kFilterBilinear:
     case kFilterBox:
-    case kFilterLinear:
-      return I422ToARGBMatrixLinear(
-          src_y, src_stride_y, src_u, src_stride_u, src_v, src_stride_v,
-          dst_argb, dst_stride_argb, yuvconstants, width, height);
+    case kFilterBicubic:
+    case kFilterLanczos3:
+      return I420ToRGB24MatrixBilinear(src_y, src_stride_y, src_u, src_stride_u,
+                                       src_v, src_stride_v, dst_rgb24,
+                                       dst_stride_rgb24, yuvconstants, width,
+                                       height, scratch);
   }
 
   return -1;
@@ -8923,17 +8890,45 @@ int I420ToRGB24MatrixFilter(const uint8_t* src_y,
                             int width,
                             int height,
                             enum FilterMode filter) {
+  return I420ToRGB24MatrixFilterScratch(src_y, src_stride_y, src_u,
+                                        src_stride_u, src_v, src_stride_v,
+                                        dst_rgb24, dst_stride_rgb24,
+                                        yuvconstants, width, height, filter,
+                                        NULL, 0);
+}
+
+LIBYUV_API
+int I010ToAR30MatrixFilterScratch(const uint16_t* src_y,
+                                  int src_stride_y,
+                                  const uint16_t* src_u,
+                                  int src_stride_u,
+                                  const uint16_t* src_v,
+                                  int src_stride_v,
+                                  uint8_t* dst_ar30,
+                                  int dst_stride_ar30,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum FilterMode filter,
+                                  uint8_t* scratch,
+                                  int scratch_size) {
+  if (scratch && scratch_size < YUVToRGBMatrixFilterScratchSize(width)) {
+    return -1;
+  }
   switch (filter) {
     case kFilterNone:
-      return I420ToRGB24Matrix(src_y, src_stride_y, src_u, src_stride_u, src_v,
-                               src_stride_v, dst_rgb24, dst_stride_rgb24,
-                               yuvconstants, width, height);
+      return I010ToAR30Matrix(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                              src_stride_v, dst_ar30, dst_stride_ar30,
+                              yuvconstants, width, height);
     case kFilterLinear:  // TODO(fb): Implement Linear using Bilinear stride 0
     case kFilterBilinear:
     case kFilterBox:
-      return I420ToRGB24MatrixBilinear(
-          src_y, src_stride_y, src_u, src_stride_u, src_v, src_stride_v,
-          dst_rgb24, dst_stride_rgb24, yuvconstants, width, height);
+    case kFilterBicubic:
+    case kFilterLanczos3:
+      return I010ToAR30MatrixBilinear(src_y, src_stride_y, src_u, src_stride_u,
+                                      src_v, src_stride_v, dst_ar30,
+                                      dst_stride_ar30, yuvconstants, width,
+                                      height, scratch);
   }
 
   return -1;
@@ -8952,20 +8947,47 @@ int I010ToAR30MatrixFilter(const uint16_t* src_y,
                            int width,
                            int height,
                            enum FilterMode filter) {
-  switch (filter) {
-    case kFilterNone:
-      return I010ToAR30Matrix(src_y, src_stride_y, src_u, src_stride_u, src_v,
-                              src_stride_v, dst_ar30, dst_stride_ar30,
-                              yuvconstants, width, height);
-    case kFilterLinear:  // TODO(fb): Implement Linear using Bilinear stride 0
-    case kFilterBilinear:
-    case kFilterBox:
-      return I010ToAR30MatrixBilinear(
-          src_y, src_stride_y, src_u, src_stride_u, src_v, src_stride_v,
-          dst_ar30, dst_stride_ar30, yuvconstants, width, height);
-  }
-
-  return -1;
+  return I010ToAR30MatrixFilterScratch(src_y, src_stride_y, src_u, src_stride_u,
+                                       src_v, src_stride_v, dst_ar30,
+                                       dst_stride_ar30, yuvconstants, width,
+                                       height, filter, NULL, 0);
+}
+
+LIBYUV_API
+int I210ToAR30MatrixFilterScratch(const uint16_t* src_y,
+                                  int src_stride_y,
+                                  const uint16_t* src_u,
+                                  int src_stride_u,
+                                  const uint16_t* src_v,
+                                  int src_stride_v,
+                                  uint8_t* dst_ar30,
+                                  int dst_stride_ar30,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum FilterMode filter,
+                                  uint8_t* scratch,
+                                  int scratch_size) {
+  if (scratch && scratch_size < YUVToRGBMatrixFilterScratchSize(width)) {
+    return -1;
+  }
+  switch (filter) {
+    case kFilterNone:
+      return I210ToAR30Matrix(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                              src_stride_v, dst_ar30, dst_stride_ar30,
+                              yuvconstants, width, height);
+    case kFilterBilinear:
+    case kFilterBox:
+    case kFilterBicubic:
+    case kFilterLanczos3:
+    case kFilterLinear:
+      return I210ToAR30MatrixLinear(src_y, src_stride_y, src_u, src_stride_u,
+                                    src_v, src_stride_v, dst_ar30,
+                                    dst_stride_ar30, yuvconstants, width,
+                                    height, scratch);
+  }
+
+  return -1;
 }
 
 LIBYUV_API
@@ -8981,17 +9003,44 @@ int I210ToAR30MatrixFilter(const uint16_t* src_y,
                            int width,
                            int height,
                            enum FilterMode filter) {
+  return I210ToAR30MatrixFilterScratch(src_y, src_stride_y, src_u, src_stride_u,
+                                       src_v, src_stride_v, dst_ar30,
+                                       dst_stride_ar30, yuvconstants, width,
+                                       height, filter, NULL, 0);
+}
+
+LIBYUV_API
+int I010ToARGBMatrixFilterScratch(const uint16_t* src_y,
+                                  int src_stride_y,
+                                  const uint16_t* src_u,
+                                  int src_stride_u,
+                                  const uint16_t* src_v,
+                                  int src_stride_v,
+                                  uint8_t* dst_argb,
+                                  int dst_stride_argb,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum FilterMode filter,
+                                  uint8_t* scratch,
+                                  int scratch_size) {
+  if (scratch && scratch_size < YUVToRGBMatrixFilterScratchSize(width)) {
+    return -1;
+  }
   switch (filter) {
     case kFilterNone:
-      return I210ToAR30Matrix(src_y, src_stride_y, src_u, src_stride_u, src_v,
-                              src_stride_v, dst_ar30, dst_stride_ar30,
+      return I010ToARGBMatrix(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                              src_stride_v, dst_argb, dst_stride_argb,
                               yuvconstants, width, height);
+    case kFilterLinear:  // TODO(fb): Implement Linear using Bilinear stride 0
     case kFilterBilinear:
     case kFilterBox:
-    case kFilterLinear:
-      return I210ToAR30MatrixLinear(
-          src_y, src_stride_y, src_u, src_stride_u, src_v, src_stride_v,
-          dst_ar30, dst_stride_ar30, yuvconstants, width, height);
+    case kFilterBicubic:
+    case kFilterLanczos3:
+      return I010ToARGBMatrixBilinear(src_y, src_stride_y, src_u, src_stride_u,
+                                      src_v, src_stride_v, dst_argb,
+                                      dst_stride_argb, yuvconstants, width,
+                                      height, scratch);
   }
 
   return -1;
@@ -9010,17 +9059,44 @@ int I010ToARGBMatrixFilter(const uint16_t* src_y,
                            int width,
                            int height,
                            enum FilterMode filter) {
+  return I010ToARGBMatrixFilterScratch(src_y, src_stride_y, src_u, src_stride_u,
+                                       src_v, src_stride_v, dst_argb,
+                                       dst_stride_argb, yuvconstants, width,
+                                       height, filter, NULL, 0);
+}
+
+LIBYUV_API
+int I210ToARGBMatrixFilterScratch(const uint16_t* src_y,
+                                  int src_stride_y,
+                                  const uint16_t* src_u,
+                                  int src_stride_u,
+                                  const uint16_t* src_v,
+                                  int src_stride_v,
+                                  uint8_t* dst_argb,
+                                  int dst_stride_argb,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum FilterMode filter,
+                                  uint8_t* scratch,
+                                  int scratch_size) {
+  if (scratch && scratch_size < YUVToRGBMatrixFilterScratchSize(width)) {
+    return -1;
+  }
   switch (filter) {
     case kFilterNone:
-      return I010ToARGBMatrix(src_y, src_stride_y, src_u, src_stride_u, src_v,
+      return I210ToARGBMatrix(src_y, src_stride_y, src_u, src_stride_u, src_v,
                               src_stride_v, dst_argb, dst_stride_argb,
                               yuvconstants, width, height);
-    case kFilterLinear:  // TODO(fb): Implement Linear using Bilinear stride 0
     case kFilterBilinear:
     case kFilterBox:
-      return I010ToARGBMatrixBilinear(
-          src_y, src_stride_y, src_u, src_stride_u, src_v, src_stride_v,
-          dst_argb, dst_stride_argb, yuvconstants, width, height);
+    case kFilterBicubic:
+    case kFilterLanczos3:
+    case kFilterLinear:
+      return I210ToARGBMatrixLinear(src_y, src_stride_y, src_u, src_stride_u,
+                                    src_v, src_stride_v, dst_argb,
+                                    dst_stride_argb, yuvconstants, width,
+                                    height, scratch);
   }
 
   return -1;
@@ -9039,17 +9115,49 @@ int I210ToARGBMatrixFilter(const uint16_t* src_y,
                            int width,
                            int height,
                            enum FilterMode filter) {
+  return I210ToARGBMatrixFilterScratch(src_y, src_stride_y, src_u, src_stride_u,
+                                       src_v, src_stride_v, dst_argb,
+                                       dst_stride_argb, yuvconstants, width,
+                                       height, filter, NULL, 0);
+}
+
+LIBYUV_API
+int I420AlphaToARGBMatrixFilterScratch(const uint8_t* src_y,
+                                       int src_stride_y,
+                                       const uint8_t* src_u,
+                                       int src_stride_u,
+                                       const uint8_t* src_v,
+                                       int src_stride_v,
+                                       const uint8_t* src_a,
+                                       int src_stride_a,
+                                       uint8_t* dst_argb,
+                                       int dst_stride_argb,
+                                       const struct YuvConstants* yuvconstants,
+                                       int width,
+                                       int height,
+                                       int attenuate,
+                                       enum FilterMode filter,
+                                       uint8_t* scratch,
+                                       int scratch_size) {
+  if (scratch && scratch_size < YUVToRGBMatrixFilterScratchSize(width)) {
+    return -1;
+  }
   switch (filter) {
     case kFilterNone:
-      return I210ToARGBMatrix(src_y, src_stride_y, src_u, src_stride_u, src_v,
-                              src_stride_v, dst_argb, dst_stride_argb,
-                              yuvconstants, width, height);
+      return I420AlphaToARGBMatrix(src_y, src_stride_y, src_u, src_stride_u,
+                                   src_v, src_stride_v, src_a, src_stride_a,
+                                   dst_argb, dst_stride_argb, yuvconstants,
+                                   width, height, attenuate);
+    case kFilterLinear:  // TODO(fb): Implement Linear using Bilinear stride 0
     case kFilterBilinear:
     case kFilterBox:
-    case kFilterLinear:
-      return I210ToARGBMatrixLinear(
-          src_y, src_stride_y, src_u, src_stride_u, src_v, src_stride_v,
-          dst_argb, dst_stride_argb, yuvconstants, width, height);
+    case kFilterBicubic:
+    case kFilterLanczos3:
+      return I420AlphaToARGBMatrixBilinear(src_y, src_stride_y, src_u,
+                                           src_stride_u, src_v, src_stride_v,
+                                           src_a, src_stride_a, dst_argb,
+                                           dst_stride_argb, yuvconstants, width,
+                                           height, attenuate, scratch);
   }
 
   return -1;
@@ -9071,19 +9179,51 @@ int I420AlphaToARGBMatrixFilter(const uint8_t* src_y,
                                 int height,
                                 int attenuate,
                                 enum FilterMode filter) {
+  return I420AlphaToARGBMatrixFilterScratch(src_y, src_stride_y, src_u,
+                                            src_stride_u, src_v, src_stride_v,
+                                            src_a, src_stride_a, dst_argb,
+                                            dst_stride_argb, yuvconstants,
+                                            width, height, attenuate, filter,
+                                            NULL, 0);
+}
+
+LIBYUV_API
+int I422AlphaToARGBMatrixFilterScratch(const uint8_t* src_y,
+                                       int src_stride_y,
+                                       const uint8_t* src_u,
+                                       int src_stride_u,
+                                       const uint8_t* src_v,
+                                       int src_stride_v,
+                                       const uint8_t* src_a,
+                                       int src_stride_a,
+                                       uint8_t* dst_argb,
+                                       int dst_stride_argb,
+                                       const struct YuvConstants* yuvconstants,
+                                       int width,
+                                       int height,
+                                       int attenuate,
+                                       enum FilterMode filter,
+                                       uint8_t* scratch,
+                                       int scratch_size) {
+  if (scratch && scratch_size < YUVToRGBMatrixFilterScratchSize(width)) {
+    return -1;
+  }
   switch (filter) {
     case kFilterNone:
-      return I420AlphaToARGBMatrix(src_y, src_stride_y, src_u, src_stride_u,
+      return I422AlphaToARGBMatrix(src_y, src_stride_y, src_u, src_stride_u,
                                    src_v, src_stride_v, src_a, src_stride_a,
                                    dst_argb, dst_stride_argb, yuvconstants,
                                    width, height, attenuate);
-    case kFilterLinear:  // TODO(fb): Implement Linear using Bilinear stride 0
     case kFilterBilinear:
     case kFilterBox:
-      return I420AlphaToARGBMatrixBilinear(
-          src_y, src_stride_y, src_u, src_stride_u, src_v, src_stride_v, src_a,
-          src_stride_a, dst_argb, dst_stride_argb, yuvconstants, width, height,
-          attenuate);
+    case kFilterBicubic:
+    case kFilterLanczos3:
+    case kFilterLinear:
+      return I422AlphaToARGBMatrixLinear(src_y, src_stride_y, src_u,
+                                         src_stride_u, src_v, src_stride_v,
+                                         src_a, src_stride_a, dst_argb,
+                                         dst_stride_argb, yuvconstants, width,
+                                         height, attenuate, scratch);
   }
 
   return -1;
@@ -9105,19 +9245,51 @@ int I422AlphaToARGBMatrixFilter(const uint8_t* src_y,
                                 int height,
                                 int attenuate,
                                 enum FilterMode filter) {
+  return I422AlphaToARGBMatrixFilterScratch(src_y, src_stride_y, src_u,
+                                            src_stride_u, src_v, src_stride_v,
+                                            src_a, src_stride_a, dst_argb,
+                                            dst_stride_argb, yuvconstants,
+                                            width, height, attenuate, filter,
+                                            NULL, 0);
+}
+
+LIBYUV_API
+int I010AlphaToARGBMatrixFilterScratch(const uint16_t* src_y,
+                                       int src_stride_y,
+                                       const uint16_t* src_u,
+                                       int src_stride_u,
+                                       const uint16_t* src_v,
+                                       int src_stride_v,
+                                       const uint16_t* src_a,
+                                       int src_stride_a,
+                                       uint8_t* dst_argb,
+                                       int dst_stride_argb,
+                                       const struct YuvConstants* yuvconstants,
+                                       int width,
+                                       int height,
+                                       int attenuate,
+                                       enum FilterMode filter,
+                                       uint8_t* scratch,
+                                       int scratch_size) {
+  if (scratch && scratch_size < YUVToRGBMatrixFilterScratchSize(width)) {
+    return -1;
+  }
   switch (filter) {
     case kFilterNone:
-      return I422AlphaToARGBMatrix(src_y, src_stride_y, src_u, src_stride_u,
+      return I010AlphaToARGBMatrix(src_y, src_stride_y, src_u, src_stride_u,
                                    src_v, src_stride_v, src_a, src_stride_a,
                                    dst_argb, dst_stride_argb, yuvconstants,
                                    width, height, attenuate);
+    case kFilterLinear:  // TODO(fb): Implement Linear using Bilinear stride 0
     case kFilterBilinear:
     case kFilterBox:
-    case kFilterLinear:
-      return I422AlphaToARGBMatrixLinear(
-          src_y, src_stride_y, src_u, src_stride_u, src_v, src_stride_v, src_a,
-          src_stride_a, dst_argb, dst_stride_argb, yuvconstants, width, height,
-          attenuate);
+    case kFilterBicubic:
+    case kFilterLanczos3:
+      return I010AlphaToARGBMatrixBilinear(src_y, src_stride_y, src_u,
+                                           src_stride_u, src_v, src_stride_v,
+                                           src_a, src_stride_a, dst_argb,
+                                           dst_stride_argb, yuvconstants, width,
+                                           height, attenuate, scratch);
   }
 
   return -1;
@@ -9139,19 +9311,51 @@ int I010AlphaToARGBMatrixFilter(const uint16_t* src_y,
                                 int height,
                                 int attenuate,
                                 enum FilterMode filter) {
+  return I010AlphaToARGBMatrixFilterScratch(src_y, src_stride_y, src_u,
+                                            src_stride_u, src_v, src_stride_v,
+                                            src_a, src_stride_a, dst_argb,
+                                            dst_stride_argb, yuvconstants,
+                                            width, height, attenuate, filter,
+                                            NULL, 0);
+}
+
+LIBYUV_API
+int I210AlphaToARGBMatrixFilterScratch(const uint16_t* src_y,
+                                       int src_stride_y,
+                                       const uint16_t* src_u,
+                                       int src_stride_u,
+                                       const uint16_t* src_v,
+                                       int src_stride_v,
+                                       const uint16_t* src_a,
+                                       int src_stride_a,
+                                       uint8_t* dst_argb,
+                                       int dst_stride_argb,
+                                       const struct YuvConstants* yuvconstants,
+                                       int width,
+                                       int height,
+                                       int attenuate,
+                                       enum FilterMode filter,
+                                       uint8_t* scratch,
+                                       int scratch_size) {
+  if (scratch && scratch_size < YUVToRGBMatrixFilterScratchSize(width)) {
+    return -1;
+  }
   switch (filter) {
     case kFilterNone:
-      return I010AlphaToARGBMatrix(src_y, src_stride_y, src_u, src_stride_u,
+      return I210AlphaToARGBMatrix(src_y, src_stride_y, src_u, src_stride_u,
                                    src_v, src_stride_v, src_a, src_stride_a,
                                    dst_argb, dst_stride_argb, yuvconstants,
                                    width, height, attenuate);
-    case kFilterLinear:  // TODO(fb): Implement Linear using Bilinear stride 0
     case kFilterBilinear:
     case kFilterBox:
-      return I010AlphaToARGBMatrixBilinear(
-          src_y, src_stride_y, src_u, src_stride_u, src_v, src_stride_v, src_a,
-          src_stride_a, dst_argb, dst_stride_argb, yuvconstants, width, height,
-          attenuate);
+    case kFilterBicubic:
+    case kFilterLanczos3:
+    case kFilterLinear:
+      return I210AlphaToARGBMatrixLinear(src_y, src_stride_y, src_u,
+                                         src_stride_u, src_v, src_stride_v,
+                                         src_a, src_stride_a, dst_argb,
+                                         dst_stride_argb, yuvconstants, width,
+                                         height, attenuate, scratch);
   }
 
   return -1;
@@ -9173,37 +9377,32 @@ int I210AlphaToARGBMatrixFilter(const uint16_t* src_y,
                                 int height,
                                 int attenuate,
                                 enum FilterMode filter) {
-  switch (filter) {
-    case kFilterNone:
-      return I210AlphaToARGBMatrix(src_y, src_stride_y, src_u, src_stride_u,
-                                   src_v, src_stride_v, src_a, src_stride_a,
-                                   dst_argb, dst_stride_argb, yuvconstants,
-                                   width, height, attenuate);
-    case kFilterBilinear:
-    case kFilterBox:
-    case kFilterLinear:
-      return I210AlphaToARGBMatrixLinear(
-          src_y, src_stride_y, src_u, src_stride_u, src_v, src_stride_v, src_a,
-          src_stride_a, dst_argb, dst_stride_argb, yuvconstants, width, height,
-          attenuate);
-  }
-
-  return -1;
+  return I210AlphaToARGBMatrixFilterScratch(src_y, src_stride_y, src_u,
+                                            src_stride_u, src_v, src_stride_v,
+                                            src_a, src_stride_a, dst_argb,
+                                            dst_stride_argb, yuvconstants,
+                                            width, height, attenuate, filter,
+                                            NULL, 0);
 }
 
 // TODO(fb): Verify this function works correctly.  P010 is like NV12 but 10 bit
 // UV is biplanar.
 LIBYUV_API
-int P010ToARGBMatrixFilter(const uint16_t* src_y,
-                           int src_stride_y,
-                           const uint16_t* src_uv,
-                           int src_stride_uv,
-                           uint8_t* dst_argb,
-                           int dst_stride_argb,
-                           const struct YuvConstants* yuvconstants,
-                           int width,
-                           int height,
-                           enum FilterMode filter) {
+int P010ToARGBMatrixFilterScratch(const uint16_t* src_y,
+                                  int src_stride_y,
+                                  const uint16_t* src_uv,
+                                  int src_stride_uv,
+                                  uint8_t* dst_argb,
+                                  int dst_stride_argb,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum FilterMode filter,
+                                  uint8_t* scratch,
+                                  int scratch_size) {
+  if (scratch && scratch_size < YUVToRGBMatrixFilterScratchSize(width)) {
+    return -1;
+  }
   switch (filter) {
     case kFilterNone:
       return P010ToARGBMatrix(src_y, src_stride_y, src_uv, src_stride_uv,
@@ -9212,16 +9411,18 @@ int P010ToARGBMatrixFilter(const uint16_t* src_y,
     case kFilterLinear:  // TODO(fb): Implement Linear using Bilinear stride 0
     case kFilterBilinear:
     case kFilterBox:
+    case kFilterBicubic:
+    case kFilterLanczos3:
       return P010ToARGBMatrixBilinear(src_y, src_stride_y, src_uv,
                                       src_stride_uv, dst_argb, dst_stride_argb,
-                                      yuvconstants, width, height);
+                                      yuvconstants, width, height, scratch);
   }
 
   return -1;
 }
 
 LIBYUV_API
-int P210ToARGBMatrixFilter(const uint16_t* src_y,
+int P010ToARGBMatrixFilter(const uint16_t* src_y,
                            int src_stride_y,
                            const uint16_t* src_uv,
                            int src_stride_uv,
@@ -9231,6 +9432,28 @@ int P210ToARGBMatrixFilter(const uint16_t* src_y,
                            int width,
                            int height,
                            enum FilterMode filter) {
+  return P010ToARGBMatrixFilterScratch(src_y, src_stride_y, src_uv,
+                                       src_stride_uv, dst_argb, dst_stride_argb,
+                                       yuvconstants, width, height, filter,
+                                       NULL, 0);
+}
+
+LIBYUV_API
+int P210ToARGBMatrixFilterScratch(const uint16_t* src_y,
+                                  int src_stride_y,
+                                  const uint16_t* src_uv,
+                                  int src_stride_uv,
+                                  uint8_t* dst_argb,
+                                  int dst_stride_argb,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum FilterMode filter,
+                                  uint8_t* scratch,
+                                  int scratch_size) {
+  if (scratch && scratch_size < YUVToRGBMatrixFilterScratchSize(width)) {
+    return -1;
+  }
   switch (filter) {
     case kFilterNone:
       return P210ToARGBMatrix(src_y, src_stride_y, src_uv, src_stride_uv,
@@ -9238,26 +9461,50 @@ int P210ToARGBMatrixFilter(const uint16_t* src_y,
                               height);
     case kFilterBilinear:
     case kFilterBox:
+    case kFilterBicubic:
+    case kFilterLanczos3:
     case kFilterLinear:
       return P210ToARGBMatrixLinear(src_y, src_stride_y, src_uv, src_stride_uv,
                                     dst_argb, dst_stride_argb, yuvconstants,
-                                    width, height);
+                                    width, height, scratch);
   }
 
   return -1;
 }
 
 LIBYUV_API
-int P010ToAR30MatrixFilter(const uint16_t* src_y,
+int P210ToARGBMatrixFilter(const uint16_t* src_y,
                            int src_stride_y,
                            const uint16_t* src_uv,
                            int src_stride_uv,
-                           uint8_t* dst_ar30,
-                           int dst_stride_ar30,
+                           uint8_t* dst_argb,
+                           int dst_stride_argb,
                            const struct YuvConstants* yuvconstants,
                            int width,
                            int height,
                            enum FilterMode filter) {
+  return P210ToARGBMatrixFilterScratch(src_y, src_stride_y, src_uv,
+                                       src_stride_uv, dst_argb, dst_stride_argb,
+                                       yuvconstants, width, height, filter,
+                                       NULL, 0);
+}
+
+LIBYUV_API
+int P010ToAR30MatrixFilterScratch(const uint16_t* src_y,
+                                  int src_stride_y,
+                                  const uint16_t* src_uv,
+                                  int src_stride_uv,
+                                  uint8_t* dst_ar30,
+                                  int dst_stride_ar30,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum FilterMode filter,
+                                  uint8_t* scratch,
+                                  int scratch_size) {
+  if (scratch && scratch_size < YUVToRGBMatrixFilterScratchSize(width)) {
+    return -1;
+  }
   switch (filter) {
     case kFilterNone:
       return P010ToAR30Matrix(src_y, src_stride_y, src_uv, src_stride_uv,
@@ -9266,16 +9513,18 @@ int P010ToAR30MatrixFilter(const uint16_t* src_y,
     case kFilterLinear:  // TODO(fb): Implement Linear using Bilinear stride 0
     case kFilterBilinear:
     case kFilterBox:
+    case kFilterBicubic:
+    case kFilterLanczos3:
       return P010ToAR30MatrixBilinear(src_y, src_stride_y, src_uv,
                                       src_stride_uv, dst_ar30, dst_stride_ar30,
-                                      yuvconstants, width, height);
+                                      yuvconstants, width, height, scratch);
   }
 
   return -1;
 }
 
 LIBYUV_API
-int P210ToAR30MatrixFilter(const uint16_t* src_y,
+int P010ToAR30MatrixFilter(const uint16_t* src_y,
                            int src_stride_y,
                            const uint16_t* src_uv,
                            int src_stride_uv,
@@ -9285,6 +9534,28 @@ int P210ToAR30MatrixFilter(const uint16_t* src_y,
                            int width,
                            int height,
                            enum FilterMode filter) {
+  return P010ToAR30MatrixFilterScratch(src_y, src_stride_y, src_uv,
+                                       src_stride_uv, dst_ar30, dst_stride_ar30,
+                                       yuvconstants, width, height, filter,
+                                       NULL, 0);
+}
+
+LIBYUV_API
+int P210ToAR30MatrixFilterScratch(const uint16_t* src_y,
+                                  int src_stride_y,
+                                  const uint16_t* src_uv,
+                                  int src_stride_uv,
+                                  uint8_t* dst_ar30,
+                                  int dst_stride_ar30,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum FilterMode filter,
+                                  uint8_t* scratch,
+                                  int scratch_size) {
+  if (scratch && scratch_size < YUVToRGBMatrixFilterScratchSize(width)) {
+    return -1;
+  }
   switch (filter) {
     case kFilterNone:
       return P210ToAR30Matrix(src_y, src_stride_y, src_uv, src_stride_uv,
@@ -9292,15 +9563,406 @@ int P210ToAR30MatrixFilter(const uint16_t* src_y,
                               height);
     case kFilterBilinear:
     case kFilterBox:
+    case kFilterBicubic:
+    case kFilterLanczos3:
     case kFilterLinear:
       return P210ToAR30MatrixLinear(src_y, src_stride_y, src_uv, src_stride_uv,
                                     dst_ar30, dst_stride_ar30, yuvconstants,
-                                    width, height);
+                                    width, height, scratch);
   }
 
   return -1;
 }
 
+LIBYUV_API
+int P210ToAR30MatrixFilter(const uint16_t* src_y,
+                           int src_stride_y,
+                           const uint16_t* src_uv,
+                           int src_stride_uv,
+                           uint8_t* dst_ar30,
+                           int dst_stride_ar30,
+                           const struct YuvConstants* yuvconstants,
+                           int width,
+                           int height,
+                           enum FilterMode filter) {
+  return P210ToAR30MatrixFilterScratch(src_y, src_stride_y, src_uv,
+                                       src_stride_uv, dst_ar30, dst_stride_ar30,
+                                       yuvconstants, width, height, filter,
+                                       NULL, 0);
+}
+
+// Destination rows made per band by the *Rotate converters.  The source for a
+// band is rotated into a small I420 frame that stays in cache, then converted
+// straight into the destination, so no rotated frame is written to memory.
+// Even, so bands start on a chroma row.
+static const int kRotateBandRows = 64;
+
+// Destination rows per band.  Bands from the far edge must start on a chroma
+// column or row, so an odd size rotated that way is done in one band.
+static int RotateBandRows(int width, int height, enum RotationMode mode) {
+  int dst_height = mode == kRotate180 ? height : width;
+  if ((mode == kRotate270 && (width & 1)) ||
+      (mode == kRotate180 && (height & 1)) || kRotateBandRows > dst_height) {
+    return dst_height;
+  }
+  return kRotateBandRows;
+}
+
+LIBYUV_API
+int YUVToARGBMatrixRotateScratchSize(int width,
+                                     int height,
+                                     enum RotationMode mode) {
+  int dst_width;
+  int band_rows;
+  uint64_t size;
+  if (width <= 0 || height == 0 || height == INT_MIN) {
+    return -1;
+  }
+  if (mode == kRotate0) {
+    return 0;
+  }
+  if (mode != kRotate90 && mode != kRotate180 && mode != kRotate270) {
+    return -1;
+  }
+  if (height < 0) {
+    height = -height;
+  }
+  dst_width = mode == kRotate180 ? width : height;
+  band_rows = RotateBandRows(width, height, mode);
+  size = (uint64_t)dst_width * band_rows +
+         (uint64_t)((dst_width + 1) >> 1) * ((band_rows + 1) >> 1) * 2 + 63;
+  if (size > INT_MAX) {
+    return -1;
+  }
+  return (int)size;
+}
+
+// Rotate and convert YUV to ARGB a band of rows at a time.  src_u is an
+// interleaved UV plane when nv is 1, or VU plane when nv is 2, and src_v is
+// then unused.  Matches rotating with I420Rotate and then converting.  The
+// band is carved from scratch when it is not NULL.
+static int YUVToARGBMatrixRotate(const uint8_t* src_y,
+                                 int src_stride_y,
+                                 const uint8_t* src_u,
+                                 int src_stride_u,
+                                 const uint8_t* src_v,
+                                 int src_stride_v,
+                                 int nv,
+                                 uint8_t* dst_argb,
+                                 int dst_stride_argb,
+                                 const struct YuvConstants* yuvconstants,
+                                 int width,
+                                 int height,
+                                 enum RotationMode mode,
+                                 uint8_t* scratch) {
+  int dst_width = mode == kRotate180 ? width : height;
+  int dst_height = mode == kRotate180 ? height : width;
+  int dst_halfwidth = (dst_width + 1) >> 1;
+  int uv_bpp = nv ? 2 : 1;
+  int band_rows = RotateBandRows(width, height, mode);
+  uint64_t band_y_size;
+  uint64_t band_uv_size;
+  int r;
+  band_y_size = (uint64_t)dst_width * band_rows;
+  band_uv_size = (uint64_t)dst_halfwidth * ((band_rows + 1) >> 1);
+  if (band_y_size + band_uv_size * 2 > SIZE_MAX) {
+    return -1;  // Invalid size.
+  }
+  align_buffer_64_scratch(band, (size_t)(band_y_size + band_uv_size * 2),
+                          scratch);
+  if (!band) {
+    return 1;
+  }
+  for (r = 0; r < dst_height; r += band_rows) {
+    int n = dst_height - r < band_rows ? dst_height - r : band_rows;
+    uint8_t* band_y = band;
+    uint8_t* band_u = band + band_y_size;
+    uint8_t* band_v = band_u + band_uv_size;
+    // Top left of the source that rotates into destination rows [r, r + n).
+    int x = mode == kRotate90 ? r : mode == kRotate270 ? width - r - n : 0;
+    int y = mode == kRotate180 ? height - r - n : 0;
+    const uint8_t* y_src = src_y + (ptrdiff_t)y * src_stride_y + x;
+    const uint8_t* u_src =
+        src_u + (ptrdiff_t)(y / 2) * src_stride_u + (x / 2) * uv_bpp;
+    const uint8_t* v_src =
+        nv ? NULL : src_v + (ptrdiff_t)(y / 2) * src_stride_v + x / 2;
+    int src_w = mode == kRotate180 ? width : n;
+    int src_h = mode == kRotate180 ? n : height;
+    if (nv == 2) {  // VU order.
+      band_u = band_v;
+      band_v = band + band_y_size;
+    }
+    if (nv) {
+      NV12ToI420Rotate(y_src, src_stride_y, u_src, src_stride_u, band_y,
+                       dst_width, band_u, dst_halfwidth, band_v, dst_halfwidth,
+                       src_w, src_h, mode);
+    } else {
+      I420Rotate(y_src, src_stride_y, u_src, src_stride_u, v_src,
+                 src_stride_v, band_y, dst_width, band_u, dst_halfwidth,
+                 band_v, dst_halfwidth, src_w, src_h, mode);
+    }
+    I420ToARGBMatrix(band, dst_width, band + band_y_size, dst_halfwidth,
+                     band + band_y_size + band_uv_size, dst_halfwidth,
+                     dst_argb + (ptrdiff_t)r * dst_stride_argb,
+                     dst_stride_argb, yuvconstants, dst_width, n);
+  }
+  free_aligned_buffer_64(band);
+  return 0;
+}
+
+LIBYUV_API
+int I420ToARGBMatrixRotateScratch(const uint8_t* src_y,
+                                  int src_stride_y,
+                                  const uint8_t* src_u,
+                                  int src_stride_u,
+                                  const uint8_t* src_v,
+                                  int src_stride_v,
+                                  uint8_t* dst_argb,
+                                  int dst_stride_argb,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum RotationMode mode,
+                                  uint8_t* scratch,
+                                  int scratch_size) {
+  if (!src_y || !src_u || !src_v || !dst_argb || width <= 0 || height == 0 ||
+      height == INT_MIN) {
+    return -1;
+  }
+  if (scratch &&
+      scratch_size < YUVToARGBMatrixRotateScratchSize(width, height, mode)) {
+    return -1;
+  }
+  if (mode == kRotate0) {
+    return I420ToARGBMatrix(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                            src_stride_v, dst_argb, dst_stride_argb,
+                            yuvconstants, width, height);
+  }
+  if (mode != kRotate90 && mode != kRotate180 && mode != kRotate270) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    int halfheight;
+    height = -height;
+    halfheight = (height + 1) >> 1;
+    src_y = src_y + (ptrdiff_t)(height - 1) * src_stride_y;
+    src_u = src_u + (ptrdiff_t)(halfheight - 1) * src_stride_u;
+    src_v = src_v + (ptrdiff_t)(halfheight - 1) * src_stride_v;
+    src_stride_y = -src_stride_y;
+    src_stride_u = -src_stride_u;
+    src_stride_v = -src_stride_v;
+  }
+  return YUVToARGBMatrixRotate(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                               src_stride_v, 0, dst_argb, dst_stride_argb,
+                               yuvconstants, width, height, mode, scratch);
+}
+
+LIBYUV_API
+int I420ToARGBMatrixRotate(const uint8_t* src_y,
+                           int src_stride_y,
+                           const uint8_t* src_u,
+                           int src_stride_u,
+                           const uint8_t* src_v,
+                           int src_stride_v,
+                           uint8_t* dst_argb,
+                           int dst_stride_argb,
+                           const struct YuvConstants* yuvconstants,
+                           int width,
+                           int height,
+                           enum RotationMode mode) {
+  return I420ToARGBMatrixRotateScratch(src_y, src_stride_y, src_u,
+                                       src_stride_u, src_v, src_stride_v,
+                                       dst_argb, dst_stride_argb, yuvconstants,
+                                       width, height, mode, NULL, 0);
+}
+
+// Shared by NV12ToARGBMatrixRotate and NV21ToARGBMatrixRotate.
+static int NVToARGBMatrixRotate(const uint8_t* src_y,
+                                int src_stride_y,
+                                const uint8_t* src_uv,
+                                int src_stride_uv,
+                                int nv,
+                                uint8_t* dst_argb,
+                                int dst_stride_argb,
+                                const struct YuvConstants* yuvconstants,
+                                int width,
+                                int height,
+                                enum RotationMode mode,
+                                uint8_t* scratch,
+                                int scratch_size) {
+  if (!src_y || !src_uv || !dst_argb || width <= 0 || height == 0 ||
+      height == INT_MIN) {
+    return -1;
+  }
+  if (scratch &&
+      scratch_size < YUVToARGBMatrixRotateScratchSize(width, height, mode)) {
+    return -1;
+  }
+  if (mode == kRotate0) {
+    return nv == 1 ? NV12ToARGBMatrix(src_y, src_stride_y, src_uv,
+                                      src_stride_uv, dst_argb,
+                                      dst_stride_argb, yuvconstants, width,
+                                      height)
+                   : NV21ToARGBMatrix(src_y, src_stride_y, src_uv,
+                                      src_stride_uv, dst_argb,
+                                      dst_stride_argb, yuvconstants, width,
+                                      height);
+  }
+  if (mode != kRotate90 && mode != kRotate180 && mode != kRotate270) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    src_y = src_y + (ptrdiff_t)(height - 1) * src_stride_y;
+    src_uv = src_uv + (ptrdiff_t)(((height + 1) >> 1) - 1) * src_stride_uv;
+    src_stride_y = -src_stride_y;
+    src_stride_uv = -src_stride_uv;
+  }
+  return YUVToARGBMatrixRotate(src_y, src_stride_y, src_uv, src_stride_uv,
+                               NULL, 0, nv, dst_argb, dst_stride_argb,
+                               yuvconstants, width, height, mode, scratch);
+}
+
+LIBYUV_API
+int NV12ToARGBMatrixRotateScratch(const uint8_t* src_y,
+                                  int src_stride_y,
+                                  const uint8_t* src_uv,
+                                  int src_stride_uv,
+                                  uint8_t* dst_argb,
+                                  int dst_stride_argb,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum RotationMode mode,
+                                  uint8_t* scratch,
+                                  int scratch_size) {
+  return NVToARGBMatrixRotate(src_y, src_stride_y, src_uv, src_stride_uv, 1,
+                              dst_argb, dst_stride_argb, yuvconstants, width,
+                              height, mode, scratch, scratch_size);
+}
+
+LIBYUV_API
+int NV12ToARGBMatrixRotate(const uint8_t* src_y,
+                           int src_stride_y,
+                           const uint8_t* src_uv,
+                           int src_stride_uv,
+                           uint8_t* dst_argb,
+                           int dst_stride_argb,
+                           const struct YuvConstants* yuvconstants,
+                           int width,
+                           int height,
+                           enum RotationMode mode) {
+  return NVToARGBMatrixRotate(src_y, src_stride_y, src_uv, src_stride_uv, 1,
+                              dst_argb, dst_stride_argb, yuvconstants, width,
+                              height, mode, NULL, 0);
+}
+
+LIBYUV_API
+int NV21ToARGBMatrixRotateScratch(const uint8_t* src_y,
+                                  int src_stride_y,
+                                  const uint8_t* src_vu,
+                                  int src_stride_vu,
+                                  uint8_t* dst_argb,
+                                  int dst_stride_argb,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height,
+                                  enum RotationMode mode,
+                                  uint8_t* scratch,
+                                  int scratch_size) {
+  return NVToARGBMatrixRotate(src_y, src_stride_y, src_vu, src_stride_vu, 2,
+                              dst_argb, dst_stride_argb, yuvconstants, width,
+                              height, mode, scratch, scratch_size);
+}
+
+LIBYUV_API
+int NV21ToARGBMatrixRotate(const uint8_t* src_y,
+                           int src_stride_y,
+                           const uint8_t* src_vu,
+                           int src_stride_vu,
+                           uint8_t* dst_argb,
+                           int dst_stride_argb,
+                           const struct YuvConstants* yuvconstants,
+                           int width,
+                           int height,
+                           enum RotationMode mode) {
+  return NVToARGBMatrixRotate(src_y, src_stride_y, src_vu, src_stride_vu, 2,
+                              dst_argb, dst_stride_argb, yuvconstants, width,
+                              height, mode, NULL, 0);
+}
+
+// Convert I420 to ARGB with rotation.
+LIBYUV_API
+int I420ToARGBRotate(const uint8_t* src_y,
+                     int src_stride_y,
+                     const uint8_t* src_u,
+                     int src_stride_u,
+                     const uint8_t* src_v,
+                     int src_stride_v,
+                     uint8_t* dst_argb,
+                     int dst_stride_argb,
+                     int width,
+                     int height,
+                     enum RotationMode mode) {
+  return I420ToARGBMatrixRotate(src_y, src_stride_y, src_u, src_stride_u,
+                                src_v, src_stride_v, dst_argb, dst_stride_argb,
+                                &kYuvI601Constants, width, height, mode);
+}
+
+// Convert I420 to ABGR with rotation.
+LIBYUV_API
+int I420ToABGRRotate(const uint8_t* src_y,
+                     int src_stride_y,
+                     const uint8_t* src_u,
+                     int src_stride_u,
+                     const uint8_t* src_v,
+                     int src_stride_v,
+                     uint8_t* dst_abgr,
+                     int dst_stride_abgr,
+                     int width,
+                     int height,
+                     enum RotationMode mode) {
+  return I420ToARGBMatrixRotate(src_y, src_stride_y, src_v,
+                                src_stride_v,  // Swap U and V
+                                src_u, src_stride_u, dst_abgr, dst_stride_abgr,
+                                &kYvuI601Constants,  // Use Yvu matrix
+                                width, height, mode);
+}
+
+// Convert NV12 to ARGB with rotation.
+LIBYUV_API
+int NV12ToARGBRotate(const uint8_t* src_y,
+                     int src_stride_y,
+                     const uint8_t* src_uv,
+                     int src_stride_uv,
+                     uint8_t* dst_argb,
+                     int dst_stride_argb,
+                     int width,
+                     int height,
+                     enum RotationMode mode) {
+  return NV12ToARGBMatrixRotate(src_y, src_stride_y, src_uv, src_stride_uv,
+                                dst_argb, dst_stride_argb, &kYuvI601Constants,
+                                width, height, mode);
+}
+
+// Convert NV12 to ABGR with rotation.
+LIBYUV_API
+int NV12ToABGRRotate(const uint8_t* src_y,
+                     int src_stride_y,
+                     const uint8_t* src_uv,
+                     int src_stride_uv,
+                     uint8_t* dst_abgr,
+                     int dst_stride_abgr,
+                     int width,
+                     int height,
+                     enum RotationMode mode) {
+  return NV21ToARGBMatrixRotate(src_y, src_stride_y, src_uv, src_stride_uv,
+                                dst_abgr, dst_stride_abgr, &kYvuI601Constants,
+                                width, height, mode);
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
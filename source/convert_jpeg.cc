@@ -12,7 +12,12 @@
 #include "libyuv/convert_argb.h"
 
 #ifdef HAVE_JPEG
+#include <new>  // For std::nothrow.
+
 #include "libyuv/mjpeg_decoder.h"
+#include "libyuv/planar_functions.h"  // For MergeUVPlane.
+#include "libyuv/row.h"               // For align_buffer_64.
+#include "libyuv/scale.h"
 #endif
 
 #ifdef __cplusplus
@@ -103,93 +108,166 @@ int MJPGSize(const uint8_t* src_mjpg,
   return ret ? 0 : -1;  // -1 for runtime failure.
 }
 
+// A session owns a decoder, so the jpeg state and row buffers are reused by
+// every frame of the stream.
+struct MJPGSession {
+  MJpegDecoder decoder;
+};
+
+LIBYUV_API
+struct MJPGSession* MJPGSessionCreate(void) {
+  return new (std::nothrow) MJPGSession;
+}
+
+LIBYUV_API
+void MJPGSessionSetExecutor(struct MJPGSession* session,
+                            ScaleExecutor executor,
+                            void* executor_context,
+                            int max_jobs) {
+  if (session) {
+    session->decoder.SetExecutor(executor, executor_context, max_jobs);
+  }
+}
+
+LIBYUV_API
+void MJPGSessionDestroy(struct MJPGSession* session) {
+  delete session;
+}
+
 // MJPG (Motion JPeg) to I420
 // TODO(fbarchard): review src_width and src_height requirement. dst_width and
 // dst_height may be enough.
-LIBYUV_API
-int MJPGToI420(const uint8_t* src_mjpg,
-               size_t src_size_mjpg,
-               uint8_t* dst_y,
-               int dst_stride_y,
-               uint8_t* dst_u,
-               int dst_stride_u,
-               uint8_t* dst_v,
-               int dst_stride_v,
-               int src_width,
-               int src_height,
-               int dst_width,
-               int dst_height) {
+static int MJPGDecodeToI420(MJpegDecoder* mjpeg_decoder,
+                            const uint8_t* src_mjpg,
+                            size_t src_size_mjpg,
+                            uint8_t* dst_y,
+                            int dst_stride_y,
+                            uint8_t* dst_u,
+                            int dst_stride_u,
+                            uint8_t* dst_v,
+                            int dst_stride_v,
+                            int src_width,
+                            int src_height,
+                            int dst_width,
+                            int dst_height) {
   if (src_size_mjpg == kUnknownDataSize) {
     // ERROR: MJPEG frame size unknown
     return -1;
   }
 
-  // TODO(fbarchard): Port MJpeg to C.
-  MJpegDecoder mjpeg_decoder;
-  LIBYUV_BOOL ret = mjpeg_decoder.LoadFrame(src_mjpg, src_size_mjpg);
-  if (ret && (mjpeg_decoder.GetWidth() != src_width ||
-              mjpeg_decoder.GetHeight() != src_height)) {
+  LIBYUV_BOOL ret = mjpeg_decoder->LoadFrame(src_mjpg, src_size_mjpg);
+  if (ret && (mjpeg_decoder->GetWidth() != src_width ||
+              mjpeg_decoder->GetHeight() != src_height)) {
     // ERROR: MJPEG frame has unexpected dimensions
-    mjpeg_decoder.UnloadFrame();
+    mjpeg_decoder->UnloadFrame();
     return 1;  // runtime failure
   }
   if (ret) {
     I420Buffers bufs = {dst_y, dst_stride_y, dst_u,     dst_stride_u,
                         dst_v, dst_stride_v, dst_width, dst_height};
     // YUV420
-    if (mjpeg_decoder.GetColorSpace() == MJpegDecoder::kColorSpaceYCbCr &&
-        mjpeg_decoder.GetNumComponents() == 3 &&
-        mjpeg_decoder.GetVertSampFactor(0) == 2 &&
-        mjpeg_decoder.GetHorizSampFactor(0) == 2 &&
-        mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-        mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-        mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-        mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegCopyI420, &bufs, dst_width,
-                                           dst_height);
+    if (mjpeg_decoder->GetColorSpace() == MJpegDecoder::kColorSpaceYCbCr &&
+        mjpeg_decoder->GetNumComponents() == 3 &&
+        mjpeg_decoder->GetVertSampFactor(0) == 2 &&
+        mjpeg_decoder->GetHorizSampFactor(0) == 2 &&
+        mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+        mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+        mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+        mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegCopyI420, &bufs, dst_width,
+                                            dst_height);
       // YUV422
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceYCbCr &&
-               mjpeg_decoder.GetNumComponents() == 3 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 2 &&
-               mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI422ToI420, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 3 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 2 &&
+               mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI422ToI420, &bufs, dst_width,
+                                            dst_height);
       // YUV444
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceYCbCr &&
-               mjpeg_decoder.GetNumComponents() == 3 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI444ToI420, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 3 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI444ToI420, &bufs, dst_width,
+                                            dst_height);
       // YUV400
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceGrayscale &&
-               mjpeg_decoder.GetNumComponents() == 1 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI400ToI420, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 1 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI400ToI420, &bufs, dst_width,
+                                            dst_height);
     } else {
       // TODO(fbarchard): Implement conversion for any other
       // colorspace/subsample factors that occur in practice. ERROR: Unable to
       // convert MJPEG frame because format is not supported
-      mjpeg_decoder.UnloadFrame();
+      mjpeg_decoder->UnloadFrame();
       return 1;
     }
   }
   return ret ? 0 : 1;
 }
 
+LIBYUV_API
+int MJPGToI420(const uint8_t* src_mjpg,
+               size_t src_size_mjpg,
+               uint8_t* dst_y,
+               int dst_stride_y,
+               uint8_t* dst_u,
+               int dst_stride_u,
+               uint8_t* dst_v,
+               int dst_stride_v,
+               int src_width,
+               int src_height,
+               int dst_width,
+               int dst_height) {
+  // TODO(fbarchard): Port MJpeg to C.
+  MJpegDecoder mjpeg_decoder;
+  return MJPGDecodeToI420(&mjpeg_decoder, src_mjpg, src_size_mjpg, dst_y,
+                          dst_stride_y, dst_u, dst_stride_u, dst_v,
+                          dst_stride_v, src_width, src_height, dst_width,
+                          dst_height);
+}
+
+LIBYUV_API
+int MJPGSessionToI420(struct MJPGSession* session,
+                      const uint8_t* src_mjpg,
+                      size_t src_size_mjpg,
+                      uint8_t* dst_y,
+                      int dst_stride_y,
+                      uint8_t* dst_u,
+                      int dst_stride_u,
+                      uint8_t* dst_v,
+                      int dst_stride_v,
+                      int src_width,
+                      int src_height,
+                      int dst_width,
+                      int dst_height) {
+  if (!session) {
+    return -1;
+  }
+  int r = MJPGDecodeToI420(&session->decoder, src_mjpg, src_size_mjpg, dst_y,
+                           dst_stride_y, dst_u, dst_stride_u, dst_v,
+                           dst_stride_v, src_width, src_height, dst_width,
+                           dst_height);
+  if (r != 0) {
+    // Return the decoder to its start state for the next frame.
+    session->decoder.UnloadFrame();
+  }
+  return r;
+}
+
 struct NV21Buffers {
   uint8_t* y;
   int y_stride;
@@ -248,86 +326,127 @@ static void JpegI400ToNV21(void* opaque,
 }
 
 // MJPG (Motion JPeg) to NV21
-LIBYUV_API
-int MJPGToNV21(const uint8_t* src_mjpg,
-               size_t src_size_mjpg,
-               uint8_t* dst_y,
-               int dst_stride_y,
-               uint8_t* dst_vu,
-               int dst_stride_vu,
-               int src_width,
-               int src_height,
-               int dst_width,
-               int dst_height) {
+static int MJPGDecodeToNV21(MJpegDecoder* mjpeg_decoder,
+                            const uint8_t* src_mjpg,
+                            size_t src_size_mjpg,
+                            uint8_t* dst_y,
+                            int dst_stride_y,
+                            uint8_t* dst_vu,
+                            int dst_stride_vu,
+                            int src_width,
+                            int src_height,
+                            int dst_width,
+                            int dst_height) {
   if (src_size_mjpg == kUnknownDataSize) {
     // ERROR: MJPEG frame size unknown
     return -1;
   }
 
-  // TODO(fbarchard): Port MJpeg to C.
-  MJpegDecoder mjpeg_decoder;
-  LIBYUV_BOOL ret = mjpeg_decoder.LoadFrame(src_mjpg, src_size_mjpg);
-  if (ret && (mjpeg_decoder.GetWidth() != src_width ||
-              mjpeg_decoder.GetHeight() != src_height)) {
+  LIBYUV_BOOL ret = mjpeg_decoder->LoadFrame(src_mjpg, src_size_mjpg);
+  if (ret && (mjpeg_decoder->GetWidth() != src_width ||
+              mjpeg_decoder->GetHeight() != src_height)) {
     // ERROR: MJPEG frame has unexpected dimensions
-    mjpeg_decoder.UnloadFrame();
+    mjpeg_decoder->UnloadFrame();
     return 1;  // runtime failure
   }
   if (ret) {
     NV21Buffers bufs = {dst_y,         dst_stride_y, dst_vu,
                         dst_stride_vu, dst_width,    dst_height};
     // YUV420
-    if (mjpeg_decoder.GetColorSpace() == MJpegDecoder::kColorSpaceYCbCr &&
-        mjpeg_decoder.GetNumComponents() == 3 &&
-        mjpeg_decoder.GetVertSampFactor(0) == 2 &&
-        mjpeg_decoder.GetHorizSampFactor(0) == 2 &&
-        mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-        mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-        mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-        mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI420ToNV21, &bufs, dst_width,
-                                           dst_height);
+    if (mjpeg_decoder->GetColorSpace() == MJpegDecoder::kColorSpaceYCbCr &&
+        mjpeg_decoder->GetNumComponents() == 3 &&
+        mjpeg_decoder->GetVertSampFactor(0) == 2 &&
+        mjpeg_decoder->GetHorizSampFactor(0) == 2 &&
+        mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+        mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+        mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+        mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI420ToNV21, &bufs, dst_width,
+                                            dst_height);
       // YUV422
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceYCbCr &&
-               mjpeg_decoder.GetNumComponents() == 3 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 2 &&
-               mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI422ToNV21, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 3 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 2 &&
+               mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI422ToNV21, &bufs, dst_width,
+                                            dst_height);
       // YUV444
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceYCbCr &&
-               mjpeg_decoder.GetNumComponents() == 3 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI444ToNV21, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 3 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI444ToNV21, &bufs, dst_width,
+                                            dst_height);
       // YUV400
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceGrayscale &&
-               mjpeg_decoder.GetNumComponents() == 1 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI400ToNV21, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 1 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI400ToNV21, &bufs, dst_width,
+                                            dst_height);
     } else {
       // Unknown colorspace.
-      mjpeg_decoder.UnloadFrame();
+      mjpeg_decoder->UnloadFrame();
       return 1;
     }
   }
   return ret ? 0 : 1;
 }
 
+LIBYUV_API
+int MJPGToNV21(const uint8_t* src_mjpg,
+               size_t src_size_mjpg,
+               uint8_t* dst_y,
+               int dst_stride_y,
+               uint8_t* dst_vu,
+               int dst_stride_vu,
+               int src_width,
+               int src_height,
+               int dst_width,
+               int dst_height) {
+  // TODO(fbarchard): Port MJpeg to C.
+  MJpegDecoder mjpeg_decoder;
+  return MJPGDecodeToNV21(&mjpeg_decoder, src_mjpg, src_size_mjpg, dst_y,
+                          dst_stride_y, dst_vu, dst_stride_vu, src_width,
+                          src_height, dst_width, dst_height);
+}
+
+LIBYUV_API
+int MJPGSessionToNV21(struct MJPGSession* session,
+                      const uint8_t* src_mjpg,
+                      size_t src_size_mjpg,
+                      uint8_t* dst_y,
+                      int dst_stride_y,
+                      uint8_t* dst_vu,
+                      int dst_stride_vu,
+                      int src_width,
+                      int src_height,
+                      int dst_width,
+                      int dst_height) {
+  if (!session) {
+    return -1;
+  }
+  int r = MJPGDecodeToNV21(&session->decoder, src_mjpg, src_size_mjpg, dst_y,
+                           dst_stride_y, dst_vu, dst_stride_vu, src_width,
+                           src_height, dst_width, dst_height);
+  if (r != 0) {
+    // Return the decoder to its start state for the next frame.
+    session->decoder.UnloadFrame();
+  }
+  return r;
+}
+
 static void JpegI420ToNV12(void* opaque,
                            const uint8_t* const* data,
                            const int* strides,
@@ -381,29 +500,27 @@ static void JpegI400ToNV12(void* opaque,
 }
 
 // MJPG (Motion JPEG) to NV12.
-LIBYUV_API
-int MJPGToNV12(const uint8_t* sample,
-               size_t sample_size,
-               uint8_t* dst_y,
-               int dst_stride_y,
-               uint8_t* dst_uv,
-               int dst_stride_uv,
-               int src_width,
-               int src_height,
-               int dst_width,
-               int dst_height) {
+static int MJPGDecodeToNV12(MJpegDecoder* mjpeg_decoder,
+                            const uint8_t* sample,
+                            size_t sample_size,
+                            uint8_t* dst_y,
+                            int dst_stride_y,
+                            uint8_t* dst_uv,
+                            int dst_stride_uv,
+                            int src_width,
+                            int src_height,
+                            int dst_width,
+                            int dst_height) {
   if (sample_size == kUnknownDataSize) {
     // ERROR: MJPEG frame size unknown
     return -1;
   }
 
-  // TODO(fbarchard): Port MJpeg to C.
-  MJpegDecoder mjpeg_decoder;
-  LIBYUV_BOOL ret = mjpeg_decoder.LoadFrame(sample, sample_size);
-  if (ret && (mjpeg_decoder.GetWidth() != src_width ||
-              mjpeg_decoder.GetHeight() != src_height)) {
+  LIBYUV_BOOL ret = mjpeg_decoder->LoadFrame(sample, sample_size);
+  if (ret && (mjpeg_decoder->GetWidth() != src_width ||
+              mjpeg_decoder->GetHeight() != src_height)) {
     // ERROR: MJPEG frame has unexpected dimensions
-    mjpeg_decoder.UnloadFrame();
+    mjpeg_decoder->UnloadFrame();
     return 1;  // runtime failure
   }
   if (ret) {
@@ -411,57 +528,289 @@ int MJPGToNV12(const uint8_t* sample,
     NV21Buffers bufs = {dst_y,         dst_stride_y, dst_uv,
                         dst_stride_uv, dst_width,    dst_height};
     // YUV420
-    if (mjpeg_decoder.GetColorSpace() == MJpegDecoder::kColorSpaceYCbCr &&
-        mjpeg_decoder.GetNumComponents() == 3 &&
-        mjpeg_decoder.GetVertSampFactor(0) == 2 &&
-        mjpeg_decoder.GetHorizSampFactor(0) == 2 &&
-        mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-        mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-        mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-        mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI420ToNV12, &bufs, dst_width,
-                                           dst_height);
+    if (mjpeg_decoder->GetColorSpace() == MJpegDecoder::kColorSpaceYCbCr &&
+        mjpeg_decoder->GetNumComponents() == 3 &&
+        mjpeg_decoder->GetVertSampFactor(0) == 2 &&
+        mjpeg_decoder->GetHorizSampFactor(0) == 2 &&
+        mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+        mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+        mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+        mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI420ToNV12, &bufs, dst_width,
+                                            dst_height);
       // YUV422
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceYCbCr &&
-               mjpeg_decoder.GetNumComponents() == 3 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 2 &&
-               mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI422ToNV12, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 3 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 2 &&
+               mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI422ToNV12, &bufs, dst_width,
+                                            dst_height);
       // YUV444
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceYCbCr &&
-               mjpeg_decoder.GetNumComponents() == 3 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI444ToNV12, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 3 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI444ToNV12, &bufs, dst_width,
+                                            dst_height);
       // YUV400
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceGrayscale &&
-               mjpeg_decoder.GetNumComponents() == 1 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI400ToNV12, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 1 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI400ToNV12, &bufs, dst_width,
+                                            dst_height);
     } else {
       // Unknown colorspace.
-      mjpeg_decoder.UnloadFrame();
+      mjpeg_decoder->UnloadFrame();
       return 1;
     }
   }
   return ret ? 0 : 1;
 }
 
+LIBYUV_API
+int MJPGToNV12(const uint8_t* sample,
+               size_t sample_size,
+               uint8_t* dst_y,
+               int dst_stride_y,
+               uint8_t* dst_uv,
+               int dst_stride_uv,
+               int src_width,
+               int src_height,
+               int dst_width,
+               int dst_height) {
+  // TODO(fbarchard): Port MJpeg to C.
+  MJpegDecoder mjpeg_decoder;
+  return MJPGDecodeToNV12(&mjpeg_decoder, sample, sample_size, dst_y,
+                          dst_stride_y, dst_uv, dst_stride_uv, src_width,
+                          src_height, dst_width, dst_height);
+}
+
+LIBYUV_API
+int MJPGSessionToNV12(struct MJPGSession* session,
+                      const uint8_t* sample,
+                      size_t sample_size,
+                      uint8_t* dst_y,
+                      int dst_stride_y,
+                      uint8_t* dst_uv,
+                      int dst_stride_uv,
+                      int src_width,
+                      int src_height,
+                      int dst_width,
+                      int dst_height) {
+  if (!session) {
+    return -1;
+  }
+  int r = MJPGDecodeToNV12(&session->decoder, sample, sample_size, dst_y,
+                           dst_stride_y, dst_uv, dst_stride_uv, src_width,
+                           src_height, dst_width, dst_height);
+  if (r != 0) {
+    // Return the decoder to its start state for the next frame.
+    session->decoder.UnloadFrame();
+  }
+  return r;
+}
+
+// Decoded component layouts that the callbacks below support, by the
+// sub-sampling of the decoded components rather than the sample factors of the
+// frame, as DCT scaling may decode chroma at a higher resolution.
+enum JpegLayout {
+  kJpegLayout420 = 0,
+  kJpegLayout422 = 1,
+  kJpegLayout444 = 2,
+  kJpegLayout400 = 3,
+};
+
+// Returns the JpegLayout of the loaded frame, or -1 if it is not supported.
+static int GetJpegLayout(MJpegDecoder* mjpeg_decoder) {
+  if (mjpeg_decoder->GetColorSpace() == MJpegDecoder::kColorSpaceGrayscale &&
+      mjpeg_decoder->GetNumComponents() == 1) {
+    return kJpegLayout400;
+  }
+  if (mjpeg_decoder->GetColorSpace() != MJpegDecoder::kColorSpaceYCbCr ||
+      mjpeg_decoder->GetNumComponents() != 3 ||
+      mjpeg_decoder->GetHorizSubSampFactor(0) != 1 ||
+      mjpeg_decoder->GetVertSubSampFactor(0) != 1) {
+    return -1;
+  }
+  int hs = mjpeg_decoder->GetHorizSubSampFactor(1);
+  int vs = mjpeg_decoder->GetVertSubSampFactor(1);
+  if (mjpeg_decoder->GetHorizSubSampFactor(2) != hs ||
+      mjpeg_decoder->GetVertSubSampFactor(2) != vs) {
+    return -1;
+  }
+  if (hs == 2 && vs == 2) {
+    return kJpegLayout420;
+  }
+  if (hs == 2 && vs == 1) {
+    return kJpegLayout422;
+  }
+  if (hs == 1 && vs == 1) {
+    return kJpegLayout444;
+  }
+  return -1;
+}
+
+static const MJpegDecoder::CallbackFunction kJpegToI420[] = {
+    &JpegCopyI420, &JpegI422ToI420, &JpegI444ToI420, &JpegI400ToI420};
+
+static const MJpegDecoder::CallbackFunction kJpegToNV12[] = {
+    &JpegI420ToNV12, &JpegI422ToNV12, &JpegI444ToNV12, &JpegI400ToNV12};
+
+// Decode with the largest DCT scaling that is not smaller than the
+// destination, then scale the rest of the way.  Decodes to NV12 if dst_uv is
+// not NULL, otherwise to I420.
+static int MJPGToScaled(const uint8_t* sample,
+                        size_t sample_size,
+                        uint8_t* dst_y,
+                        int dst_stride_y,
+                        uint8_t* dst_u,
+                        int dst_stride_u,
+                        uint8_t* dst_v,
+                        int dst_stride_v,
+                        uint8_t* dst_uv,
+                        int dst_stride_uv,
+                        int src_width,
+                        int src_height,
+                        int dst_width,
+                        int dst_height,
+                        enum FilterMode filtering) {
+  if (sample_size == kUnknownDataSize || !dst_y || src_width <= 0 ||
+      src_height <= 0 || dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+  int scale_denom = 8;
+  while (scale_denom > 1 &&
+         ((src_width + scale_denom - 1) / scale_denom < dst_width ||
+          (src_height + scale_denom - 1) / scale_denom < dst_height)) {
+    scale_denom /= 2;
+  }
+
+  MJpegDecoder mjpeg_decoder;
+  mjpeg_decoder.SetScaleDenom(scale_denom);
+  if (!mjpeg_decoder.LoadFrame(sample, sample_size)) {
+    return 1;
+  }
+  int layout = GetJpegLayout(&mjpeg_decoder);
+  if (mjpeg_decoder.GetWidth() != src_width ||
+      mjpeg_decoder.GetHeight() != src_height || layout < 0) {
+    // ERROR: MJPEG frame has unexpected dimensions or unsupported format.
+    mjpeg_decoder.UnloadFrame();
+    return 1;
+  }
+  int width = mjpeg_decoder.GetOutputWidth();
+  int height = mjpeg_decoder.GetOutputHeight();
+  if (width == dst_width && height == dst_height) {
+    LIBYUV_BOOL ret;
+    if (dst_uv) {
+      NV21Buffers bufs = {dst_y,         dst_stride_y, dst_uv,
+                          dst_stride_uv, dst_width,    dst_height};
+      ret = mjpeg_decoder.DecodeToCallback(kJpegToNV12[layout], &bufs, width,
+                                           height);
+    } else {
+      I420Buffers bufs = {dst_y, dst_stride_y, dst_u,     dst_stride_u,
+                          dst_v, dst_stride_v, dst_width, dst_height};
+      ret = mjpeg_decoder.DecodeToCallback(kJpegToI420[layout], &bufs, width,
+                                           height);
+    }
+    return ret ? 0 : 1;
+  }
+
+  // Decode to I420 at the DCT scaled size, followed by the scaled chroma
+  // planes for NV12.
+  int halfwidth = (width + 1) >> 1;
+  int halfheight = (height + 1) >> 1;
+  int dst_halfwidth = (dst_width + 1) >> 1;
+  int dst_halfheight = (dst_height + 1) >> 1;
+  size_t size_y = (size_t)width * height;
+  size_t size_uv = (size_t)halfwidth * halfheight;
+  size_t dst_size_uv = dst_uv ? (size_t)dst_halfwidth * dst_halfheight : 0;
+  align_buffer_64(buffer, size_y + size_uv * 2 + dst_size_uv * 2);
+  if (!buffer) {
+    mjpeg_decoder.UnloadFrame();
+    return 1;  // Out of memory runtime error.
+  }
+  uint8_t* tmp_y = buffer;
+  uint8_t* tmp_u = tmp_y + size_y;
+  uint8_t* tmp_v = tmp_u + size_uv;
+  I420Buffers bufs = {tmp_y, width, tmp_u, halfwidth,
+                      tmp_v, halfwidth, width, height};
+  int r = 1;  // Runtime failure unless the frame decodes.
+  if (mjpeg_decoder.DecodeToCallback(kJpegToI420[layout], &bufs, width,
+                                     height)) {
+    if (dst_uv) {
+      uint8_t* scaled_u = tmp_v + size_uv;
+      uint8_t* scaled_v = scaled_u + dst_size_uv;
+      r = I420Scale(tmp_y, width, tmp_u, halfwidth, tmp_v, halfwidth, width,
+                    height, dst_y, dst_stride_y, scaled_u, dst_halfwidth,
+                    scaled_v, dst_halfwidth, dst_width, dst_height, filtering);
+      if (r == 0) {
+        MergeUVPlane(scaled_u, dst_halfwidth, scaled_v, dst_halfwidth, dst_uv,
+                     dst_stride_uv, dst_halfwidth, dst_halfheight);
+      }
+    } else {
+      r = I420Scale(tmp_y, width, tmp_u, halfwidth, tmp_v, halfwidth, width,
+                    height, dst_y, dst_stride_y, dst_u, dst_stride_u, dst_v,
+                    dst_stride_v, dst_width, dst_height, filtering);
+    }
+  }
+  free_aligned_buffer_64(buffer);
+  return r;
+}
+
+LIBYUV_API
+int MJPGToI420Scaled(const uint8_t* sample,
+                     size_t sample_size,
+                     uint8_t* dst_y,
+                     int dst_stride_y,
+                     uint8_t* dst_u,
+                     int dst_stride_u,
+                     uint8_t* dst_v,
+                     int dst_stride_v,
+                     int src_width,
+                     int src_height,
+                     int dst_width,
+                     int dst_height,
+                     enum FilterMode filtering) {
+  if (!dst_u || !dst_v) {
+    return -1;
+  }
+  return MJPGToScaled(sample, sample_size, dst_y, dst_stride_y, dst_u,
+                      dst_stride_u, dst_v, dst_stride_v, NULL, 0, src_width,
+                      src_height, dst_width, dst_height, filtering);
+}
+
+LIBYUV_API
+int MJPGToNV12Scaled(const uint8_t* sample,
+                     size_t sample_size,
+                     uint8_t* dst_y,
+                     int dst_stride_y,
+                     uint8_t* dst_uv,
+                     int dst_stride_uv,
+                     int src_width,
+                     int src_height,
+                     int dst_width,
+                     int dst_height,
+                     enum FilterMode filtering) {
+  if (!dst_uv) {
+    return -1;
+  }
+  return MJPGToScaled(sample, sample_size, dst_y, dst_stride_y, NULL, 0, NULL,
+                      0, dst_uv, dst_stride_uv, src_width, src_height,
+                      dst_width, dst_height, filtering);
+}
+
 struct ARGBBuffers {
   uint8_t* argb;
   int argb_stride;
@@ -515,85 +864,228 @@ static void JpegI400ToARGB(void* opaque,
 // MJPG (Motion JPeg) to ARGB
 // TODO(fbarchard): review src_width and src_height requirement. dst_width and
 // dst_height may be enough.
-LIBYUV_API
-int MJPGToARGB(const uint8_t* src_mjpg,
-               size_t src_size_mjpg,
-               uint8_t* dst_argb,
-               int dst_stride_argb,
-               int src_width,
-               int src_height,
-               int dst_width,
-               int dst_height) {
+static int MJPGDecodeToARGB(MJpegDecoder* mjpeg_decoder,
+                            const uint8_t* src_mjpg,
+                            size_t src_size_mjpg,
+                            uint8_t* dst_argb,
+                            int dst_stride_argb,
+                            int src_width,
+                            int src_height,
+                            int dst_width,
+                            int dst_height) {
   if (src_size_mjpg == kUnknownDataSize) {
     // ERROR: MJPEG frame size unknown
     return -1;
   }
 
-  // TODO(fbarchard): Port MJpeg to C.
-  MJpegDecoder mjpeg_decoder;
-  LIBYUV_BOOL ret = mjpeg_decoder.LoadFrame(src_mjpg, src_size_mjpg);
-  if (ret && (mjpeg_decoder.GetWidth() != src_width ||
-              mjpeg_decoder.GetHeight() != src_height)) {
+  LIBYUV_BOOL ret = mjpeg_decoder->LoadFrame(src_mjpg, src_size_mjpg);
+  if (ret && (mjpeg_decoder->GetWidth() != src_width ||
+              mjpeg_decoder->GetHeight() != src_height)) {
     // ERROR: MJPEG frame has unexpected dimensions
-    mjpeg_decoder.UnloadFrame();
+    mjpeg_decoder->UnloadFrame();
     return 1;  // runtime failure
   }
   if (ret) {
     ARGBBuffers bufs = {dst_argb, dst_stride_argb, dst_width, dst_height};
     // YUV420
-    if (mjpeg_decoder.GetColorSpace() == MJpegDecoder::kColorSpaceYCbCr &&
-        mjpeg_decoder.GetNumComponents() == 3 &&
-        mjpeg_decoder.GetVertSampFactor(0) == 2 &&
-        mjpeg_decoder.GetHorizSampFactor(0) == 2 &&
-        mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-        mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-        mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-        mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI420ToARGB, &bufs, dst_width,
-                                           dst_height);
+    if (mjpeg_decoder->GetColorSpace() == MJpegDecoder::kColorSpaceYCbCr &&
+        mjpeg_decoder->GetNumComponents() == 3 &&
+        mjpeg_decoder->GetVertSampFactor(0) == 2 &&
+        mjpeg_decoder->GetHorizSampFactor(0) == 2 &&
+        mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+        mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+        mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+        mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI420ToARGB, &bufs, dst_width,
+                                            dst_height);
       // YUV422
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceYCbCr &&
-               mjpeg_decoder.GetNumComponents() == 3 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 2 &&
-               mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI422ToARGB, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 3 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 2 &&
+               mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI422ToARGB, &bufs, dst_width,
+                                            dst_height);
       // YUV444
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceYCbCr &&
-               mjpeg_decoder.GetNumComponents() == 3 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI444ToARGB, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 3 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI444ToARGB, &bufs, dst_width,
+                                            dst_height);
       // YUV400
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceGrayscale &&
-               mjpeg_decoder.GetNumComponents() == 1 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI400ToARGB, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 1 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI400ToARGB, &bufs, dst_width,
+                                            dst_height);
     } else {
       // TODO(fbarchard): Implement conversion for any other
       // colorspace/subsample factors that occur in practice. ERROR: Unable to
       // convert MJPEG frame because format is not supported
-      mjpeg_decoder.UnloadFrame();
+      mjpeg_decoder->UnloadFrame();
       return 1;
     }
   }
   return ret ? 0 : 1;
 }
 
+LIBYUV_API
+int MJPGToARGB(const uint8_t* src_mjpg,
+               size_t src_size_mjpg,
+               uint8_t* dst_argb,
+               int dst_stride_argb,
+               int src_width,
+               int src_height,
+               int dst_width,
+               int dst_height) {
+  // TODO(fbarchard): Port MJpeg to C.
+  MJpegDecoder mjpeg_decoder;
+  return MJPGDecodeToARGB(&mjpeg_decoder, src_mjpg, src_size_mjpg, dst_argb,
+                          dst_stride_argb, src_width, src_height, dst_width,
+                          dst_height);
+}
+
+LIBYUV_API
+int MJPGSessionToARGB(struct MJPGSession* session,
+                      const uint8_t* src_mjpg,
+                      size_t src_size_mjpg,
+                      uint8_t* dst_argb,
+                      int dst_stride_argb,
+                      int src_width,
+                      int src_height,
+                      int dst_width,
+                      int dst_height) {
+  if (!session) {
+    return -1;
+  }
+  int r = MJPGDecodeToARGB(&session->decoder, src_mjpg, src_size_mjpg, dst_argb,
+                           dst_stride_argb, src_width, src_height, dst_width,
+                           dst_height);
+  if (r != 0) {
+    // Return the decoder to its start state for the next frame.
+    session->decoder.UnloadFrame();
+  }
+  return r;
+}
+
+static const MJpegDecoder::CallbackFunction kJpegToARGB[] = {
+    &JpegI420ToARGB, &JpegI422ToARGB, &JpegI444ToARGB, &JpegI400ToARGB};
+
+// Decode a rectangle of the frame, passing the rows to the callback for the
+// layout of the frame.
+static int MJPGDecodeRect(const uint8_t* sample,
+                          size_t sample_size,
+                          int src_width,
+                          int src_height,
+                          int crop_x,
+                          int crop_y,
+                          int crop_width,
+                          int crop_height,
+                          const MJpegDecoder::CallbackFunction* callbacks,
+                          void* opaque) {
+  if (sample_size == kUnknownDataSize || crop_x < 0 || crop_y < 0 ||
+      crop_width <= 0 || crop_height <= 0 || crop_x + crop_width > src_width ||
+      crop_y + crop_height > src_height) {
+    return -1;
+  }
+  MJpegDecoder mjpeg_decoder;
+  if (!mjpeg_decoder.LoadFrame(sample, sample_size)) {
+    return 1;
+  }
+  if (mjpeg_decoder.GetWidth() != src_width ||
+      mjpeg_decoder.GetHeight() != src_height) {
+    // ERROR: MJPEG frame has unexpected dimensions
+    mjpeg_decoder.UnloadFrame();
+    return 1;  // runtime failure
+  }
+  int layout = GetJpegLayout(&mjpeg_decoder);
+  if (layout < 0) {
+    // ERROR: Unable to convert MJPEG frame because format is not supported
+    mjpeg_decoder.UnloadFrame();
+    return 1;
+  }
+  LIBYUV_BOOL ret = mjpeg_decoder.DecodeRectToCallback(
+      callbacks[layout], opaque, crop_x, crop_y, crop_width, crop_height);
+  return ret ? 0 : 1;
+}
+
+LIBYUV_API
+int MJPGToI420Crop(const uint8_t* sample,
+                   size_t sample_size,
+                   uint8_t* dst_y,
+                   int dst_stride_y,
+                   uint8_t* dst_u,
+                   int dst_stride_u,
+                   uint8_t* dst_v,
+                   int dst_stride_v,
+                   int src_width,
+                   int src_height,
+                   int crop_x,
+                   int crop_y,
+                   int crop_width,
+                   int crop_height) {
+  if (!dst_y || !dst_u || !dst_v) {
+    return -1;
+  }
+  I420Buffers bufs = {dst_y,        dst_stride_y, dst_u,      dst_stride_u,
+                      dst_v,        dst_stride_v, crop_width, crop_height};
+  return MJPGDecodeRect(sample, sample_size, src_width, src_height, crop_x,
+                        crop_y, crop_width, crop_height, kJpegToI420, &bufs);
+}
+
+LIBYUV_API
+int MJPGToNV12Crop(const uint8_t* sample,
+                   size_t sample_size,
+                   uint8_t* dst_y,
+                   int dst_stride_y,
+                   uint8_t* dst_uv,
+                   int dst_stride_uv,
+                   int src_width,
+                   int src_height,
+                   int crop_x,
+                   int crop_y,
+                   int crop_width,
+                   int crop_height) {
+  if (!dst_y || !dst_uv) {
+    return -1;
+  }
+  NV21Buffers bufs = {dst_y,         dst_stride_y, dst_uv,
+                      dst_stride_uv, crop_width,   crop_height};
+  return MJPGDecodeRect(sample, sample_size, src_width, src_height, crop_x,
+                        crop_y, crop_width, crop_height, kJpegToNV12, &bufs);
+}
+
+LIBYUV_API
+int MJPGToARGBCrop(const uint8_t* sample,
+                   size_t sample_size,
+                   uint8_t* dst_argb,
+                   int dst_stride_argb,
+                   int src_width,
+                   int src_height,
+                   int crop_x,
+                   int crop_y,
+                   int crop_width,
+                   int crop_height) {
+  if (!dst_argb) {
+    return -1;
+  }
+  ARGBBuffers bufs = {dst_argb, dst_stride_argb, crop_width, crop_height};
+  return MJPGDecodeRect(sample, sample_size, src_width, src_height, crop_x,
+                        crop_y, crop_width, crop_height, kJpegToARGB, &bufs);
+}
+
 #endif  // HAVE_JPEG
 
 #ifdef __cplusplus
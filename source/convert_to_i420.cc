@@ -14,7 +14,10 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include "libyuv/row.h"
+#include "libyuv/scale_row.h"
 #include "libyuv/video_common.h"
 
 #ifdef __cplusplus
@@ -22,28 +25,56 @@ namespace libyuv {
 extern "C" {
 #endif
 
+// Size of the temporary I420 image for a crop of crop_width by crop_height,
+// or 0 if it does not fit in a size_t.
+static size_t I420BufferSize(int crop_width, int abs_crop_height) {
+  size_t y_size = (size_t)crop_width * abs_crop_height;
+  size_t uv_size = (size_t)((crop_width + 1) / 2) * ((abs_crop_height + 1) / 2);
+  if (uv_size > SIZE_MAX / 2 || y_size > SIZE_MAX - uv_size * 2) {
+    return 0;
+  }
+  return y_size + uv_size * 2;
+}
+
+LIBYUV_API
+int ConvertToI420ScratchSize(int crop_width, int crop_height) {
+  size_t size;
+  if (crop_width <= 0 || crop_height == 0 || crop_height == INT_MIN) {
+    return -1;
+  }
+  size = I420BufferSize(crop_width,
+                        (crop_height < 0) ? -crop_height : crop_height);
+  if (size == 0 || size > INT_MAX) {
+    return -1;
+  }
+  return (int)size;
+}
+
 // Convert camera sample to I420 with cropping, rotation and vertical flip.
 // src_width is used for source stride computation
 // src_height is used to compute location of planes, and indicate inversion
 // sample_size is measured in bytes and is the size of the frame.
 //   With MJPEG it is the compressed size of the frame.
+// scratch, if not NULL, holds the temporary I420 image used for rotation.
 LIBYUV_API
-int ConvertToI420(const uint8_t* sample,
-                  size_t sample_size,
-                  uint8_t* dst_y,
-                  int dst_stride_y,
-                  uint8_t* dst_u,
-                  int dst_stride_u,
-                  uint8_t* dst_v,
-                  int dst_stride_v,
-                  int crop_x,
-                  int crop_y,
-                  int src_width,
-                  int src_height,
-                  int crop_width,
-                  int crop_height,
-                  enum RotationMode rotation,
-                  uint32_t fourcc) {
+int ConvertToI420Scratch(const uint8_t* sample,
+                         size_t sample_size,
+                         uint8_t* dst_y,
+                         int dst_stride_y,
+                         uint8_t* dst_u,
+                         int dst_stride_u,
+                         uint8_t* dst_v,
+                         int dst_stride_v,
+                         int crop_x,
+                         int crop_y,
+                         int src_width,
+                         int src_height,
+                         int crop_width,
+                         int crop_height,
+                         enum RotationMode rotation,
+                         uint32_t fourcc,
+                         uint8_t* scratch,
+                         int scratch_size) {
   if (src_height == INT_MIN || crop_height == INT_MIN) {
     return -1;
   }
@@ -87,15 +118,23 @@ int ConvertToI420(const uint8_t* sample,
     size_t y_size = (size_t)crop_width * abs_crop_height;
     size_t uv_size =
         (size_t)((crop_width + 1) / 2) * ((abs_crop_height + 1) / 2);
-    if (uv_size > SIZE_MAX / 2 || y_size > SIZE_MAX - uv_size * 2) {
+    const size_t rotate_buffer_size =
+        I420BufferSize(crop_width, abs_crop_height);
+    if (rotate_buffer_size == 0) {
       return -1;  // Invalid size.
     }
-    const size_t rotate_buffer_size = y_size + uv_size * 2;
-    rotate_buffer = (uint8_t*)malloc(rotate_buffer_size);
-    if (!rotate_buffer) {
-      return 1;  // Out of memory runtime error.
+    if (scratch) {
+      if (scratch_size < 0 || (size_t)scratch_size < rotate_buffer_size) {
+        return -1;  // Scratch too small.
+      }
+      dst_y = scratch;
+    } else {
+      rotate_buffer = (uint8_t*)malloc(rotate_buffer_size);
+      if (!rotate_buffer) {
+        return 1;  // Out of memory runtime error.
+      }
+      dst_y = rotate_buffer;
     }
-    dst_y = rotate_buffer;
     dst_u = dst_y + y_size;
     dst_v = dst_u + uv_size;
     dst_stride_y = crop_width;
@@ -297,6 +336,445 @@ int ConvertToI420(const uint8_t* sample,
   return r;
 }
 
+LIBYUV_API
+int ConvertToI420(const uint8_t* sample,
+                  size_t sample_size,
+                  uint8_t* dst_y,
+                  int dst_stride_y,
+                  uint8_t* dst_u,
+                  int dst_stride_u,
+                  uint8_t* dst_v,
+                  int dst_stride_v,
+                  int crop_x,
+                  int crop_y,
+                  int src_width,
+                  int src_height,
+                  int crop_width,
+                  int crop_height,
+                  enum RotationMode rotation,
+                  uint32_t fourcc) {
+  return ConvertToI420Scratch(sample, sample_size, dst_y, dst_stride_y, dst_u,
+                              dst_stride_u, dst_v, dst_stride_v, crop_x,
+                              crop_y, src_width, src_height, crop_width,
+                              crop_height, rotation, fourcc, NULL, 0);
+}
+
+// Destination rows scaled per band by ConvertCropScale.  A multiple of
+// 2 * SCALE_BAND_ALIGN so that chroma bands are aligned too.
+#define CROP_SCALE_BAND_ROWS 48
+
+// Crop rows [*y_begin, *y_end) read by luma rows [dst_y_begin, dst_y_end)
+// and the chroma rows under them.  Begin and end are even, except an end at
+// an odd crop_height, so converted chroma rows pair with the same luma rows
+// as converting the whole crop.
+static void CropScaleRowRange(const struct ScalePlan* plan_y,
+                              const struct ScalePlan* plan_uv,
+                              int dst_y_begin,
+                              int dst_y_end,
+                              int crop_height,
+                              int* y_begin,
+                              int* y_end) {
+  int uv_end = dst_y_end == plan_y->dst_height ? plan_uv->dst_height
+                                               : dst_y_end / 2;
+  int luma_begin, luma_end, uv_begin_src, uv_end_src;
+  ScalePlanRowRangePlane(plan_y, dst_y_begin, dst_y_end, &luma_begin,
+                         &luma_end);
+  ScalePlanRowRangePlane(plan_uv, dst_y_begin / 2, uv_end, &uv_begin_src,
+                         &uv_end_src);
+  luma_begin = luma_begin < uv_begin_src * 2 ? luma_begin : uv_begin_src * 2;
+  luma_end = luma_end > uv_end_src * 2 ? luma_end : uv_end_src * 2;
+  luma_end = (luma_end + 1) & ~1;
+  *y_begin = luma_begin & ~1;
+  *y_end = luma_end > crop_height ? crop_height : luma_end;
+}
+
+// Set up the plans of a crop and scale and return in *buffer_size the bytes
+// of conversion window, band and row buffer that it needs.  Returns 0 if
+// successful or -1 if the sizes or fourccs are not supported.
+static int CropScaleInit(struct ScalePlan* plan_y,
+                         struct ScalePlan* plan_uv,
+                         int src_width,
+                         int src_height,
+                         uint32_t format,
+                         int crop_width,
+                         int crop_height,
+                         int dst_width,
+                         int dst_height,
+                         enum FilterMode filtering,
+                         uint32_t dst_format,
+                         int* window_rows,
+                         uint64_t* buffer_size) {
+  if (src_width <= 0 || src_height == 0 || src_height == INT_MIN ||
+      src_width > INT_MAX / 4 || crop_width <= 0 || crop_height <= 0 ||
+      crop_width > src_width || dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+  const int abs_src_height = (src_height < 0) ? -src_height : src_height;
+  if (crop_height > abs_src_height) {
+    return -1;
+  }
+  switch (dst_format) {
+    case FOURCC_I420:
+    case FOURCC_YV12:
+    case FOURCC_NV12:
+    case FOURCC_NV21:
+    case FOURCC_ARGB:
+    case FOURCC_ABGR:
+      break;
+    default:
+      return -1;
+  }
+
+  const int crop_halfwidth = (crop_width + 1) / 2;
+  const int crop_halfheight = (crop_height + 1) / 2;
+  const int dst_halfwidth = (dst_width + 1) / 2;
+  const int dst_halfheight = (dst_height + 1) / 2;
+  if (ScalePlanInitPlane(plan_y, kScalePlanPlane, crop_width, crop_height,
+                         dst_width, dst_height, filtering) ||
+      ScalePlanInitPlane(plan_uv, kScalePlanPlane, crop_halfwidth,
+                         crop_halfheight, dst_halfwidth, dst_halfheight,
+                         filtering)) {
+    return -1;
+  }
+
+  // Planar I420 is scaled straight from the sample.  MJPEG is decoded whole
+  // into the window, as it cannot be decoded a band at a time.
+  const LIBYUV_BOOL direct =
+      (format == FOURCC_I420 || format == FOURCC_YV12) && src_height > 0;
+  int y;
+  *window_rows = 0;
+  if (format == FOURCC_MJPG) {
+    *window_rows = crop_height;
+  } else if (!direct) {
+    for (y = 0; y < dst_height; y += CROP_SCALE_BAND_ROWS) {
+      const int y_end = y + CROP_SCALE_BAND_ROWS < dst_height
+                            ? y + CROP_SCALE_BAND_ROWS
+                            : dst_height;
+      int s0, s1;
+      CropScaleRowRange(plan_y, plan_uv, y, y_end, crop_height, &s0, &s1);
+      *window_rows = s1 - s0 > *window_rows ? s1 - s0 : *window_rows;
+    }
+  }
+
+  // Destination bands are scaled in place for I420 and the luma of NV12.
+  // Chroma for NV12, and all planes for ARGB, are scaled to band buffers.
+  const LIBYUV_BOOL argb_dst =
+      dst_format == FOURCC_ARGB || dst_format == FOURCC_ABGR;
+  const LIBYUV_BOOL nv_dst =
+      dst_format == FOURCC_NV12 || dst_format == FOURCC_NV21;
+  const int window_stride_y = (crop_width + 63) & ~63;
+  const int window_stride_uv = (crop_halfwidth + 63) & ~63;
+  const int band_stride_y = argb_dst ? (dst_width + 63) & ~63 : 0;
+  const int band_stride_uv =
+      (argb_dst || nv_dst) ? (dst_halfwidth + 63) & ~63 : 0;
+  const int row_size = plan_y->row_size > plan_uv->row_size
+                           ? plan_y->row_size
+                           : plan_uv->row_size;
+  // Band buffers have a row more for the 2x bilinear scaler, which writes
+  // the first row of the next band instead of the first row of its own.
+  *buffer_size =
+      (uint64_t)window_stride_y * *window_rows +
+      (uint64_t)window_stride_uv * ((*window_rows + 1) / 2) * 2 +
+      (uint64_t)band_stride_y * (CROP_SCALE_BAND_ROWS + 1) +
+      (uint64_t)band_stride_uv * (CROP_SCALE_BAND_ROWS / 2 + 1) * 2 +
+      ((row_size + 63) & ~63);
+  return 0;
+}
+
+LIBYUV_API
+int ConvertCropScaleScratchSize(int src_width,
+                                int src_height,
+                                uint32_t src_fourcc,
+                                int crop_width,
+                                int crop_height,
+                                int dst_width,
+                                int dst_height,
+                                enum FilterMode filtering,
+                                uint32_t dst_fourcc) {
+  struct ScalePlan plan_y;
+  struct ScalePlan plan_uv;
+  int window_rows;
+  uint64_t buffer_size;
+  if (CropScaleInit(&plan_y, &plan_uv, src_width, src_height,
+                    CanonicalFourCC(src_fourcc), crop_width, crop_height,
+                    dst_width, dst_height, filtering,
+                    CanonicalFourCC(dst_fourcc), &window_rows, &buffer_size) ||
+      buffer_size > INT_MAX - 63) {
+    return -1;
+  }
+  return (int)buffer_size + 63;
+}
+
+// Convert camera sample to a scaled frame in bands, so that the cropped
+// rows, converted to I420, stay in cache between conversion and scaling.
+// A window of converted rows slides down the crop; rows still needed by the
+// next band are moved to the top of the window and only new rows are
+// converted, so each source row is converted once.
+// scratch, if not NULL, holds the window, band and row buffers.
+LIBYUV_API
+int ConvertCropScaleScratch(const uint8_t* sample,
+                            size_t sample_size,
+                            int src_width,
+                            int src_height,
+                            uint32_t src_fourcc,
+                            int crop_x,
+                            int crop_y,
+                            int crop_width,
+                            int crop_height,
+                            uint8_t* dst_y,
+                            int dst_stride_y,
+                            uint8_t* dst_u,
+                            int dst_stride_u,
+                            uint8_t* dst_v,
+                            int dst_stride_v,
+                            int dst_width,
+                            int dst_height,
+                            enum FilterMode filtering,
+                            uint32_t dst_fourcc,
+                            uint8_t* scratch,
+                            int scratch_size) {
+  struct ScalePlan plan_y;
+  struct ScalePlan plan_uv;
+  const uint32_t format = CanonicalFourCC(src_fourcc);
+  const uint32_t dst_format = CanonicalFourCC(dst_fourcc);
+  int window_rows;
+  uint64_t buffer_size;
+  int r = 0;
+  if (!sample || !dst_y || crop_x < 0 || crop_y < 0 ||
+      CropScaleInit(&plan_y, &plan_uv, src_width, src_height, format,
+                    crop_width, crop_height, dst_width, dst_height, filtering,
+                    dst_format, &window_rows, &buffer_size)) {
+    return -1;
+  }
+  const int abs_src_height = (src_height < 0) ? -src_height : src_height;
+  if (crop_x > src_width - crop_width ||
+      crop_y > abs_src_height - crop_height) {
+    return -1;
+  }
+  if ((dst_format == FOURCC_I420 || dst_format == FOURCC_YV12) &&
+      (!dst_u || !dst_v)) {
+    return -1;
+  }
+  if ((dst_format == FOURCC_NV12 || dst_format == FOURCC_NV21) && !dst_u) {
+    return -1;
+  }
+#if UINT64_MAX > SIZE_MAX
+  if (buffer_size > SIZE_MAX) {
+    return -1;  // Invalid size.
+  }
+#endif
+  if (scratch && (uint64_t)scratch_size < buffer_size + 63) {
+    return -1;  // Scratch too small.
+  }
+  if (dst_format == FOURCC_YV12) {
+    uint8_t* dst_tmp = dst_u;
+    int stride_tmp = dst_stride_u;
+    dst_u = dst_v;
+    dst_stride_u = dst_stride_v;
+    dst_v = dst_tmp;
+    dst_stride_v = stride_tmp;
+  }
+
+  const int crop_halfwidth = (crop_width + 1) / 2;
+  const int dst_halfwidth = (dst_width + 1) / 2;
+  const int dst_halfheight = (dst_height + 1) / 2;
+  const LIBYUV_BOOL direct =
+      (format == FOURCC_I420 || format == FOURCC_YV12) && src_height > 0;
+  const LIBYUV_BOOL argb_dst =
+      dst_format == FOURCC_ARGB || dst_format == FOURCC_ABGR;
+  const LIBYUV_BOOL nv_dst =
+      dst_format == FOURCC_NV12 || dst_format == FOURCC_NV21;
+  const int window_stride_y = (crop_width + 63) & ~63;
+  const int window_stride_uv = (crop_halfwidth + 63) & ~63;
+  const int band_stride_y = argb_dst ? (dst_width + 63) & ~63 : 0;
+  const int band_stride_uv =
+      (argb_dst || nv_dst) ? (dst_halfwidth + 63) & ~63 : 0;
+  const uint64_t window_size_y = (uint64_t)window_stride_y * window_rows;
+  const uint64_t window_size_uv =
+      (uint64_t)window_stride_uv * ((window_rows + 1) / 2);
+  // A row more for the 2x bilinear scaler, as in CropScaleInit.
+  const uint64_t band_size_y =
+      (uint64_t)band_stride_y * (CROP_SCALE_BAND_ROWS + 1);
+  const uint64_t band_size_uv =
+      (uint64_t)band_stride_uv * (CROP_SCALE_BAND_ROWS / 2 + 1);
+  const int row_size =
+      plan_y.row_size > plan_uv.row_size ? plan_y.row_size : plan_uv.row_size;
+  int y;
+  align_buffer_64_scratch(buffer, (size_t)buffer_size, scratch);
+  if (!buffer) {
+    return 1;  // Out of memory runtime error.
+  }
+  uint8_t* window_y = buffer;
+  uint8_t* window_u = window_y + window_size_y;
+  uint8_t* window_v = window_u + window_size_uv;
+  uint8_t* band_y = window_v + window_size_uv;
+  uint8_t* band_u = band_y + band_size_y;
+  uint8_t* band_v = band_u + band_size_uv;
+  uint8_t* row = row_size ? band_v + band_size_uv : NULL;
+  int stride_y = window_stride_y;
+  int stride_uv = window_stride_uv;
+  int window_begin = 0;  // Crop rows held by the window.
+  int window_end = 0;
+
+  if (direct) {
+    const int halfwidth = (src_width + 1) / 2;
+    const uint8_t* src_u = sample + (ptrdiff_t)src_width * src_height +
+                           (ptrdiff_t)halfwidth * (crop_y / 2) + crop_x / 2;
+    const uint8_t* src_v =
+        src_u + (ptrdiff_t)halfwidth * ((src_height + 1) / 2);
+    window_y = (uint8_t*)(sample + (ptrdiff_t)src_width * crop_y + crop_x);
+    window_u = (uint8_t*)(format == FOURCC_YV12 ? src_v : src_u);
+    window_v = (uint8_t*)(format == FOURCC_YV12 ? src_u : src_v);
+    stride_y = src_width;
+    stride_uv = halfwidth;
+    window_end = crop_height;
+  } else if (format == FOURCC_MJPG) {
+    r = ConvertToI420(sample, sample_size, window_y, stride_y, window_u,
+                      stride_uv, window_v, stride_uv, crop_x, crop_y,
+                      src_width, src_height, crop_width, crop_height, kRotate0,
+                      format);
+    window_end = crop_height;
+  }
+
+  for (y = 0; y < dst_height && r == 0; y += CROP_SCALE_BAND_ROWS) {
+    const int y_end = y + CROP_SCALE_BAND_ROWS < dst_height
+                          ? y + CROP_SCALE_BAND_ROWS
+                          : dst_height;
+    const int uv_begin = y / 2;
+    const int uv_end = y_end == dst_height ? dst_halfheight : y_end / 2;
+    int s0, s1;
+    CropScaleRowRange(&plan_y, &plan_uv, y, y_end, crop_height, &s0, &s1);
+    if (window_end < s1) {
+      // Keep the rows from s0 that the window already holds.
+      if (s0 >= window_end) {
+        window_begin = window_end = s0;
+      } else if (s0 > window_begin) {
+        const int keep = window_end - s0;
+        const int skip = s0 - window_begin;
+        memmove(window_y, window_y + (ptrdiff_t)skip * stride_y,
+                (size_t)keep * stride_y);
+        memmove(window_u, window_u + (ptrdiff_t)(skip / 2) * stride_uv,
+                (size_t)((keep + 1) / 2) * stride_uv);
+        memmove(window_v, window_v + (ptrdiff_t)(skip / 2) * stride_uv,
+                (size_t)((keep + 1) / 2) * stride_uv);
+        window_begin = s0;
+      }
+      const int offset = window_end - window_begin;
+      const int rows = s1 - window_end;
+      if (src_height < 0) {
+        // Crop rows counted from the bottom of the inverted crop.
+        r = ConvertToI420(
+            sample, sample_size, window_y + (ptrdiff_t)offset * stride_y,
+            stride_y, window_u + (ptrdiff_t)(offset / 2) * stride_uv,
+            stride_uv, window_v + (ptrdiff_t)(offset / 2) * stride_uv,
+            stride_uv, crop_x, crop_y + crop_height - s1, src_width,
+            src_height, crop_width, rows, kRotate0, format);
+      } else {
+        r = ConvertToI420(
+            sample, sample_size, window_y + (ptrdiff_t)offset * stride_y,
+            stride_y, window_u + (ptrdiff_t)(offset / 2) * stride_uv,
+            stride_uv, window_v + (ptrdiff_t)(offset / 2) * stride_uv,
+            stride_uv, crop_x, crop_y + window_end, src_width, src_height,
+            crop_width, rows, kRotate0, format);
+      }
+      window_end = s1;
+      if (r != 0) {
+        break;
+      }
+    }
+
+    uint8_t* out_y = argb_dst ? band_y : dst_y + (ptrdiff_t)y * dst_stride_y;
+    uint8_t* out_u = band_u;
+    uint8_t* out_v = band_v;
+    int out_stride_y = argb_dst ? band_stride_y : dst_stride_y;
+    int out_stride_u = band_stride_uv;
+    int out_stride_v = band_stride_uv;
+    if (!argb_dst && !nv_dst) {
+      out_u = dst_u + (ptrdiff_t)uv_begin * dst_stride_u;
+      out_v = dst_v + (ptrdiff_t)uv_begin * dst_stride_v;
+      out_stride_u = dst_stride_u;
+      out_stride_v = dst_stride_v;
+    }
+    r = ScalePlanRunBandPlane(&plan_y, y, y_end, window_y, stride_y,
+                              window_begin, out_y, out_stride_y, row);
+    if (r == 0) {
+      r = ScalePlanRunBandPlane(&plan_uv, uv_begin, uv_end, window_u,
+                                stride_uv, window_begin / 2, out_u,
+                                out_stride_u, row);
+    }
+    if (r == 0) {
+      r = ScalePlanRunBandPlane(&plan_uv, uv_begin, uv_end, window_v,
+                                stride_uv, window_begin / 2, out_v,
+                                out_stride_v, row);
+    }
+    if (r != 0) {
+      break;
+    }
+    switch (dst_format) {
+      case FOURCC_NV12:
+        MergeUVPlane(band_u, band_stride_uv, band_v, band_stride_uv,
+                     dst_u + (ptrdiff_t)uv_begin * dst_stride_u, dst_stride_u,
+                     dst_halfwidth, uv_end - uv_begin);
+        break;
+      case FOURCC_NV21:
+        MergeUVPlane(band_v, band_stride_uv, band_u, band_stride_uv,
+                     dst_u + (ptrdiff_t)uv_begin * dst_stride_u, dst_stride_u,
+                     dst_halfwidth, uv_end - uv_begin);
+        break;
+      case FOURCC_ARGB:
+        r = I420ToARGB(band_y, band_stride_y, band_u, band_stride_uv, band_v,
+                       band_stride_uv, dst_y + (ptrdiff_t)y * dst_stride_y,
+                       dst_stride_y, dst_width, y_end - y);
+        break;
+      case FOURCC_ABGR:
+        r = I420ToABGR(band_y, band_stride_y, band_u, band_stride_uv, band_v,
+                       band_stride_uv, dst_y + (ptrdiff_t)y * dst_stride_y,
+                       dst_stride_y, dst_width, y_end - y);
+        break;
+      default:
+        break;
+    }
+    if (plan_y.method == kScaleMethodUp2Bilinear && argb_dst) {
+      memcpy(band_y, band_y + (ptrdiff_t)(y_end - y) * band_stride_y,
+             band_stride_y);
+    }
+    if (plan_uv.method == kScaleMethodUp2Bilinear && (argb_dst || nv_dst)) {
+      memcpy(band_u, band_u + (ptrdiff_t)(uv_end - uv_begin) * band_stride_uv,
+             band_stride_uv);
+      memcpy(band_v, band_v + (ptrdiff_t)(uv_end - uv_begin) * band_stride_uv,
+             band_stride_uv);
+    }
+  }
+  free_aligned_buffer_64(buffer);
+  return r;
+}
+
+LIBYUV_API
+int ConvertCropScale(const uint8_t* sample,
+                     size_t sample_size,
+                     int src_width,
+                     int src_height,
+                     uint32_t src_fourcc,
+                     int crop_x,
+                     int crop_y,
+                     int crop_width,
+                     int crop_height,
+                     uint8_t* dst_y,
+                     int dst_stride_y,
+                     uint8_t* dst_u,
+                     int dst_stride_u,
+                     uint8_t* dst_v,
+                     int dst_stride_v,
+                     int dst_width,
+                     int dst_height,
+                     enum FilterMode filtering,
+                     uint32_t dst_fourcc) {
+  return ConvertCropScaleScratch(
+      sample, sample_size, src_width, src_height, src_fourcc, crop_x, crop_y,
+      crop_width, crop_height, dst_y, dst_stride_y, dst_u, dst_stride_u, dst_v,
+      dst_stride_v, dst_width, dst_height, filtering, dst_fourcc, NULL, 0);
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
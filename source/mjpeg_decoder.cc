@@ -25,7 +25,8 @@
 
 #endif
 
-#include <stdio.h>  // For jpeglib.h.
+#include <stdio.h>   // For jpeglib.h.
+#include <string.h>  // For memchr and memcpy.
 
 // C++ build requires extern C for jpeg internals.
 #ifdef __cplusplus
@@ -38,10 +39,29 @@ extern "C" {
 }  // extern "C"
 #endif
 
-#include "libyuv/planar_functions.h"  // For CopyPlane().
+#include "libyuv/planar_functions.h"  // For CopyPlane() and SplitRGBPlane().
 
 namespace libyuv {
 
+// Size of the scaled IDCT output, per block, after jpeg_calc_output_dimensions.
+// libjpeg-turbo 1.5 added jpeg_skip_scanlines and jpeg_crop_scanline.
+#if defined(LIBJPEG_TURBO_VERSION_NUMBER) && \
+    LIBJPEG_TURBO_VERSION_NUMBER >= 1005000
+#define HAVE_JPEG_SKIP_SCANLINES
+#endif
+
+#if JPEG_LIB_VERSION >= 70
+#define MIN_DCT_H_SCALED_SIZE(cinfo) ((cinfo)->min_DCT_h_scaled_size)
+#define MIN_DCT_V_SCALED_SIZE(cinfo) ((cinfo)->min_DCT_v_scaled_size)
+#define DCT_H_SCALED_SIZE(comp) ((comp)->DCT_h_scaled_size)
+#define DCT_V_SCALED_SIZE(comp) ((comp)->DCT_v_scaled_size)
+#else
+#define MIN_DCT_H_SCALED_SIZE(cinfo) ((cinfo)->min_DCT_scaled_size)
+#define MIN_DCT_V_SCALED_SIZE(cinfo) ((cinfo)->min_DCT_scaled_size)
+#define DCT_H_SCALED_SIZE(comp) ((comp)->DCT_scaled_size)
+#define DCT_V_SCALED_SIZE(comp) ((comp)->DCT_scaled_size)
+#endif
+
 #ifdef HAVE_SETJMP
 struct SetJmpErrorMgr {
   jpeg_error_mgr base;  // Must be at the top
@@ -63,6 +83,73 @@ void skip_input_data(jpeg_decompress_struct* cinfo, long num_bytes);  // NOLINT
 void term_source(jpeg_decompress_struct* cinfo);
 void ErrorHandler(jpeg_common_struct* cinfo);
 void OutputHandler(jpeg_common_struct* cinfo);
+static void SetDecodeParameters(jpeg_decompress_struct* cinfo);
+
+#ifdef HAVE_SETJMP
+// State of one parallel restart interval decode job. Each job decodes a
+// synthetic stream made of the frame header and its own restart intervals.
+struct MJpegRestartWorker {
+  MJpegRestartWorker();
+  ~MJpegRestartWorker();
+
+  jpeg_decompress_struct decompress_struct;
+  jpeg_source_mgr source_mgr;
+  SetJmpErrorMgr error_mgr;
+  Buffer buf;
+  BufferVector buf_vec;
+  uint8_t* stream;
+  size_t stream_size;
+  uint8_t* databuf[MAX_COMPS_IN_SCAN];
+  int databuf_size[MAX_COMPS_IN_SCAN];
+  JSAMPROW scanlines[MAX_COMPS_IN_SCAN][MAX_SAMP_FACTOR * DCTSIZE];
+  JSAMPARRAY planes[MAX_COMPS_IN_SCAN];
+  LIBYUV_BOOL ok;
+};
+
+MJpegRestartWorker::MJpegRestartWorker()
+    : stream(NULL), stream_size(0), ok(LIBYUV_FALSE) {
+  decompress_struct.err = jpeg_std_error(&error_mgr.base);
+  error_mgr.base.error_exit = &ErrorHandler;
+  error_mgr.base.output_message = &OutputHandler;
+  decompress_struct.client_data = &buf_vec;
+  source_mgr.init_source = &init_source;
+  source_mgr.fill_input_buffer = &fill_input_buffer;
+  source_mgr.skip_input_data = &skip_input_data;
+  source_mgr.resync_to_restart = &jpeg_resync_to_restart;
+  source_mgr.term_source = &term_source;
+  jpeg_create_decompress(&decompress_struct);
+  decompress_struct.src = &source_mgr;
+  buf_vec.buffers = &buf;
+  buf_vec.len = 1;
+  buf_vec.pos = 0;
+  for (int i = 0; i < MAX_COMPS_IN_SCAN; ++i) {
+    databuf[i] = NULL;
+    databuf_size[i] = 0;
+    planes[i] = scanlines[i];
+  }
+}
+
+MJpegRestartWorker::~MJpegRestartWorker() {
+  jpeg_destroy_decompress(&decompress_struct);
+  delete[] stream;
+  for (int i = 0; i < MAX_COMPS_IN_SCAN; ++i) {
+    delete[] databuf[i];
+  }
+}
+
+// Destination of a parallel decode, shared by all jobs.
+struct MJpegRestartJobs {
+  MJpegDecoder* decoder;
+  int first_segment;
+  int num_segments;
+  int num_jobs;
+  int end_imcu_row;  // iMCU rows past the crop are not decoded.
+  // Rows [row_begin, row_end) of each component are written to planes.
+  uint8_t* planes[MAX_COMPS_IN_SCAN];
+  int row_begin[MAX_COMPS_IN_SCAN];
+  int row_end[MAX_COMPS_IN_SCAN];
+};
+#endif
 
 MJpegDecoder::MJpegDecoder()
     : has_scanline_padding_(LIBYUV_FALSE),
@@ -70,7 +157,22 @@ MJpegDecoder::MJpegDecoder()
       scanlines_(NULL),
       scanlines_sizes_(NULL),
       databuf_(NULL),
-      databuf_strides_(NULL) {
+      databuf_strides_(NULL),
+      scale_denom_(1),
+      rectbuf_(NULL),
+      rectbuf_size_(0),
+      executor_(NULL),
+      executor_context_(NULL),
+      max_jobs_(0),
+      workers_(NULL),
+      restart_rows_(0),
+      scan_offset_(0),
+      num_segments_(0),
+      segments_size_(0),
+      segment_begin_(NULL),
+      segment_end_(NULL),
+      framebuf_(NULL),
+      framebuf_size_(0) {
   decompress_struct_ = new jpeg_decompress_struct;
   source_mgr_ = new jpeg_source_mgr;
 #ifdef HAVE_SETJMP
@@ -98,8 +200,13 @@ MJpegDecoder::~MJpegDecoder() {
   delete source_mgr_;
 #ifdef HAVE_SETJMP
   delete error_mgr_;
+  delete[] workers_;
 #endif
   DestroyOutputBuffers();
+  delete[] segment_begin_;
+  delete[] segment_end_;
+  delete[] framebuf_;
+  delete[] rectbuf_;
 }
 
 LIBYUV_BOOL MJpegDecoder::LoadFrame(const uint8_t* src, size_t src_len) {
@@ -122,6 +229,10 @@ LIBYUV_BOOL MJpegDecoder::LoadFrame(const uint8_t* src, size_t src_len) {
     // ERROR: Bad MJPEG header
     return LIBYUV_FALSE;
   }
+  // Compute the output and per component DCT sizes for the scale.
+  decompress_struct_->scale_num = 1;
+  decompress_struct_->scale_denom = scale_denom_;
+  jpeg_calc_output_dimensions(decompress_struct_);
   AllocOutputBuffers(GetNumComponents());
   for (int i = 0; i < num_outbufs_; ++i) {
     int scanlines_size = GetComponentScanlinesPerImcuRow(i);
@@ -157,6 +268,11 @@ LIBYUV_BOOL MJpegDecoder::LoadFrame(const uint8_t* src, size_t src_len) {
       has_scanline_padding_ = LIBYUV_TRUE;
     }
   }
+  restart_rows_ = 0;
+  num_segments_ = 0;
+  if (executor_) {
+    FindRestartSegments();
+  }
   return LIBYUV_TRUE;
 }
 
@@ -178,6 +294,23 @@ int MJpegDecoder::GetHeight() {
   return decompress_struct_->image_height;
 }
 
+LIBYUV_BOOL MJpegDecoder::SetScaleDenom(int scale_denom) {
+  if (scale_denom != 1 && scale_denom != 2 && scale_denom != 4 &&
+      scale_denom != 8) {
+    return LIBYUV_FALSE;
+  }
+  scale_denom_ = scale_denom;
+  return LIBYUV_TRUE;
+}
+
+int MJpegDecoder::GetOutputWidth() {
+  return decompress_struct_->output_width;
+}
+
+int MJpegDecoder::GetOutputHeight() {
+  return decompress_struct_->output_height;
+}
+
 // Returns format of the last loaded frame. The return value is one of the
 // kColorSpace* constants.
 int MJpegDecoder::GetColorSpace() {
@@ -198,16 +331,25 @@ int MJpegDecoder::GetVertSampFactor(int component) {
   return decompress_struct_->comp_info[component].v_samp_factor;
 }
 
+// Components with a larger DCT scaled size than the smallest are upsampled by
+// the IDCT, which reduces their sub-sampling.
 int MJpegDecoder::GetHorizSubSampFactor(int component) {
-  return decompress_struct_->max_h_samp_factor / GetHorizSampFactor(component);
+  jpeg_component_info* comp = &decompress_struct_->comp_info[component];
+  return (decompress_struct_->max_h_samp_factor *
+          MIN_DCT_H_SCALED_SIZE(decompress_struct_)) /
+         (comp->h_samp_factor * DCT_H_SCALED_SIZE(comp));
 }
 
 int MJpegDecoder::GetVertSubSampFactor(int component) {
-  return decompress_struct_->max_v_samp_factor / GetVertSampFactor(component);
+  jpeg_component_info* comp = &decompress_struct_->comp_info[component];
+  return (decompress_struct_->max_v_samp_factor *
+          MIN_DCT_V_SCALED_SIZE(decompress_struct_)) /
+         (comp->v_samp_factor * DCT_V_SCALED_SIZE(comp));
 }
 
 int MJpegDecoder::GetImageScanlinesPerImcuRow() {
-  return decompress_struct_->max_v_samp_factor * DCTSIZE;
+  return decompress_struct_->max_v_samp_factor *
+         MIN_DCT_V_SCALED_SIZE(decompress_struct_);
 }
 
 int MJpegDecoder::GetComponentScanlinesPerImcuRow(int component) {
@@ -217,12 +359,12 @@ int MJpegDecoder::GetComponentScanlinesPerImcuRow(int component) {
 
 int MJpegDecoder::GetComponentWidth(int component) {
   int hs = GetHorizSubSampFactor(component);
-  return DivideAndRoundUp(GetWidth(), hs);
+  return DivideAndRoundUp(GetOutputWidth(), hs);
 }
 
 int MJpegDecoder::GetComponentHeight(int component) {
   int vs = GetVertSubSampFactor(component);
-  return DivideAndRoundUp(GetHeight(), vs);
+  return DivideAndRoundUp(GetOutputHeight(), vs);
 }
 
 // Get width in bytes padded out to a multiple of DCTSIZE
@@ -250,10 +392,13 @@ LIBYUV_BOOL MJpegDecoder::UnloadFrame() {
 LIBYUV_BOOL MJpegDecoder::DecodeToBuffers(uint8_t** planes,
                                           int dst_width,
                                           int dst_height) {
-  if (dst_width != GetWidth() || dst_height > GetHeight()) {
+  if (dst_width != GetOutputWidth() || dst_height > GetOutputHeight()) {
     // ERROR: Bad dimensions
     return LIBYUV_FALSE;
   }
+  if (DecodeRestartSegments(planes, dst_height)) {
+    return LIBYUV_TRUE;
+  }
 #ifdef HAVE_SETJMP
   if (setjmp(error_mgr_->setjmp_buffer)) {
     // We called into jpeglib, it experienced an error sometime during this
@@ -270,7 +415,7 @@ LIBYUV_BOOL MJpegDecoder::DecodeToBuffers(uint8_t** planes,
   // Compute amount of lines to skip to implement vertical crop.
   // TODO(fbarchard): Ensure skip is a multiple of maximum component
   // subsample. ie 2
-  int skip = (GetHeight() - dst_height) / 2;
+  int skip = (GetOutputHeight() - dst_height) / 2;
   if (skip > 0) {
     // There is no API to skip lines in the output data, so we read them
     // into the temp buffer.
@@ -340,10 +485,39 @@ LIBYUV_BOOL MJpegDecoder::DecodeToCallback(CallbackFunction fn,
                                            void* opaque,
                                            int dst_width,
                                            int dst_height) {
-  if (dst_width != GetWidth() || dst_height > GetHeight()) {
+  if (dst_width != GetOutputWidth() || dst_height > GetOutputHeight()) {
     // ERROR: Bad dimensions
     return LIBYUV_FALSE;
   }
+  if (restart_rows_ > 0) {
+    // Decode the restart intervals in parallel into a frame buffer and pass
+    // all rows to the callback at once.
+    uint8_t* planes[MAX_COMPS_IN_SCAN];
+    uint8_t* plane_rows[MAX_COMPS_IN_SCAN];
+    int strides[MAX_COMPS_IN_SCAN];
+    int framebuf_size = 0;
+    for (int i = 0; i < num_outbufs_; ++i) {
+      strides[i] = GetComponentWidth(i);
+      framebuf_size += strides[i] *
+                       DivideAndRoundUp(dst_height, GetVertSubSampFactor(i));
+    }
+    if (framebuf_size > framebuf_size_) {
+      delete[] framebuf_;
+      framebuf_ = new uint8_t[framebuf_size];
+      framebuf_size_ = framebuf_size;
+    }
+    uint8_t* data = framebuf_;
+    for (int i = 0; i < num_outbufs_; ++i) {
+      planes[i] = data;
+      plane_rows[i] = data;
+      data +=
+          strides[i] * DivideAndRoundUp(dst_height, GetVertSubSampFactor(i));
+    }
+    if (DecodeRestartSegments(plane_rows, dst_height)) {
+      (*fn)(opaque, planes, strides, dst_height);
+      return LIBYUV_TRUE;
+    }
+  }
 #ifdef HAVE_SETJMP
   if (setjmp(error_mgr_->setjmp_buffer)) {
     // We called into jpeglib, it experienced an error sometime during this
@@ -358,7 +532,7 @@ LIBYUV_BOOL MJpegDecoder::DecodeToCallback(CallbackFunction fn,
   SetScanlinePointers(databuf_);
   int lines_left = dst_height;
   // TODO(fbarchard): Compute amount of lines to skip to implement vertical crop
-  int skip = (GetHeight() - dst_height) / 2;
+  int skip = (GetOutputHeight() - dst_height) / 2;
   if (skip > 0) {
     while (skip >= GetImageScanlinesPerImcuRow()) {
       if (!DecodeImcuRow()) {
@@ -413,6 +587,146 @@ LIBYUV_BOOL MJpegDecoder::DecodeToCallback(CallbackFunction fn,
   return FinishDecode();
 }
 
+// Rows of the rectangle passed to the callback per call. A multiple of the
+// vertical sub-sampling, so each call gets whole rows of every component.
+static const int kRectBandRows = 16;
+
+// Point sample a plane of replicated chroma down to its sub-sampled size.
+// Works in place: each sample moves to a lower or equal offset.
+static void SubSamplePlane(uint8_t* plane,
+                           int width,
+                           int height,
+                           int subsample_x,
+                           int subsample_y) {
+  int dst_width = (width + subsample_x - 1) / subsample_x;
+  uint8_t* dst = plane;
+  int x;
+  int y;
+  for (y = 0; y < height; y += subsample_y) {
+    const uint8_t* src = plane + y * width;
+    for (x = 0; x < dst_width; ++x) {
+      dst[x] = src[x * subsample_x];
+    }
+    dst += dst_width;
+  }
+}
+
+LIBYUV_BOOL MJpegDecoder::DecodeRectToCallback(CallbackFunction fn,
+                                               void* opaque,
+                                               int x,
+                                               int y,
+                                               int width,
+                                               int height) {
+  int num_components = GetNumComponents();
+  if (x < 0 || y < 0 || width <= 0 || height <= 0 ||
+      x + width > GetOutputWidth() || y + height > GetOutputHeight() ||
+      (num_components != 1 && num_components != 3)) {
+    // ERROR: Bad rectangle or unsupported format
+    return LIBYUV_FALSE;
+  }
+  for (int i = 0; i < num_components; ++i) {
+    if (kRectBandRows % GetVertSubSampFactor(i)) {
+      // ERROR: Unsupported sub-sampling
+      return LIBYUV_FALSE;
+    }
+  }
+#ifdef HAVE_SETJMP
+  if (setjmp(error_mgr_->setjmp_buffer)) {
+    // We called into jpeglib, it experienced an error sometime during this
+    // function call, and we called longjmp() and rewound the stack to here.
+    // Return error.
+    return LIBYUV_FALSE;
+  }
+#endif
+  // jpeg_skip_scanlines and jpeg_crop_scanline are not supported for raw
+  // data, so decode scanlines in the color space of the frame. Upsampling
+  // without fancy filtering replicates chroma samples, and point sampling
+  // them restores the sub-sampled planes.
+  SetDecodeParameters(decompress_struct_);
+  decompress_struct_->raw_data_out = FALSE;
+  decompress_struct_->out_color_space = decompress_struct_->jpeg_color_space;
+  if (!jpeg_start_decompress(decompress_struct_)) {
+    return LIBYUV_FALSE;
+  }
+  JDIMENSION xoffset = (JDIMENSION)x;
+  JDIMENSION crop_width = (JDIMENSION)width;
+#ifdef HAVE_JPEG_SKIP_SCANLINES
+  // Rounds xoffset down and crop_width up to whole iMCU columns.
+  jpeg_crop_scanline(decompress_struct_, &xoffset, &crop_width);
+#else
+  xoffset = 0;
+  crop_width = decompress_struct_->output_width;
+#endif
+  int scanline_size = (int)crop_width * num_components;
+  int plane_size = num_components == 1 ? 0 : width * kRectBandRows;
+  int rectbuf_size = scanline_size * kRectBandRows + plane_size * 3;
+  if (rectbuf_size > rectbuf_size_) {
+    delete[] rectbuf_;
+    rectbuf_ = new uint8_t[rectbuf_size];
+    rectbuf_size_ = rectbuf_size;
+  }
+  JSAMPROW scanlines[kRectBandRows];
+  for (int i = 0; i < kRectBandRows; ++i) {
+    scanlines[i] = rectbuf_ + i * scanline_size;
+  }
+
+#ifdef HAVE_JPEG_SKIP_SCANLINES
+  if (y > 0 && jpeg_skip_scanlines(decompress_struct_, (JDIMENSION)y) !=
+                   (JDIMENSION)y) {
+    FinishDecode();
+    return LIBYUV_FALSE;
+  }
+#else
+  // Read the scanlines above the rectangle and discard them.
+  while ((int)decompress_struct_->output_scanline < y) {
+    if (!jpeg_read_scanlines(decompress_struct_, scanlines, 1)) {
+      FinishDecode();
+      return LIBYUV_FALSE;
+    }
+  }
+#endif
+
+  const uint8_t* planes[3];
+  int strides[3];
+  uint8_t* split = rectbuf_ + scanline_size * kRectBandRows;
+  if (num_components == 1) {
+    planes[0] = rectbuf_ + (x - (int)xoffset);
+    strides[0] = scanline_size;
+  } else {
+    for (int i = 0; i < 3; ++i) {
+      planes[i] = split + i * plane_size;
+      strides[i] = (width + GetHorizSubSampFactor(i) - 1) /
+                   GetHorizSubSampFactor(i);
+    }
+  }
+  for (int lines_left = height; lines_left > 0;) {
+    int rows = lines_left < kRectBandRows ? lines_left : kRectBandRows;
+    for (int row = 0; row < rows;) {
+      JDIMENSION lines = jpeg_read_scanlines(decompress_struct_,
+                                             scanlines + row, rows - row);
+      if (lines == 0) {
+        FinishDecode();
+        return LIBYUV_FALSE;
+      }
+      row += (int)lines;
+    }
+    if (num_components == 3) {
+      SplitRGBPlane(rectbuf_ + (x - (int)xoffset) * 3, scanline_size,
+                    split, width, split + plane_size, width,
+                    split + plane_size * 2, width, width, rows);
+      for (int i = 0; i < 3; ++i) {
+        if (GetHorizSubSampFactor(i) > 1 || GetVertSubSampFactor(i) > 1) {
+          SubSamplePlane(split + i * plane_size, width, rows,
+                         GetHorizSubSampFactor(i), GetVertSubSampFactor(i));
+        }
+      }
+    }
+    (*fn)(opaque, planes, strides, rows);
+    lines_left -= rows;
+  }
+  return FinishDecode();
+}
+
 void init_source(j_decompress_ptr cinfo) {
   fill_input_buffer(cinfo);
 }
@@ -513,16 +827,20 @@ void MJpegDecoder::DestroyOutputBuffers() {
 }
 
 // JDCT_IFAST and do_block_smoothing improve performance substantially.
-LIBYUV_BOOL MJpegDecoder::StartDecode() {
-  decompress_struct_->raw_data_out = TRUE;
-  decompress_struct_->dct_method = JDCT_IFAST;  // JDCT_ISLOW is default
-  decompress_struct_->dither_mode = JDITHER_NONE;
+static void SetDecodeParameters(jpeg_decompress_struct* cinfo) {
+  cinfo->raw_data_out = TRUE;
+  cinfo->dct_method = JDCT_IFAST;  // JDCT_ISLOW is default
+  cinfo->dither_mode = JDITHER_NONE;
   // Not applicable to 'raw':
-  decompress_struct_->do_fancy_upsampling = (boolean)(LIBYUV_FALSE);
+  cinfo->do_fancy_upsampling = (boolean)(LIBYUV_FALSE);
   // Only for buffered mode:
-  decompress_struct_->enable_2pass_quant = (boolean)(LIBYUV_FALSE);
+  cinfo->enable_2pass_quant = (boolean)(LIBYUV_FALSE);
   // Blocky but fast:
-  decompress_struct_->do_block_smoothing = (boolean)(LIBYUV_FALSE);
+  cinfo->do_block_smoothing = (boolean)(LIBYUV_FALSE);
+}
+
+LIBYUV_BOOL MJpegDecoder::StartDecode() {
+  SetDecodeParameters(decompress_struct_);
 
   if (!jpeg_start_decompress(decompress_struct_)) {
     // ERROR: Couldn't start JPEG decompressor";
@@ -554,6 +872,287 @@ inline LIBYUV_BOOL MJpegDecoder::DecodeImcuRow() {
                             GetImageScanlinesPerImcuRow());
 }
 
+void MJpegDecoder::SetExecutor(ScaleExecutor executor,
+                               void* executor_context,
+                               int max_jobs) {
+#ifdef HAVE_SETJMP
+  if (!executor || max_jobs < 2) {
+    executor = NULL;
+    max_jobs = 0;
+  }
+  if (max_jobs != max_jobs_) {
+    delete[] workers_;
+    workers_ = max_jobs ? new MJpegRestartWorker[max_jobs] : NULL;
+    max_jobs_ = max_jobs;
+  }
+  executor_ = executor;
+  executor_context_ = executor_context;
+#else
+  (void)executor;
+  (void)executor_context;
+  (void)max_jobs;
+#endif
+}
+
+int MJpegDecoder::GetNumRestartSegments() {
+  return restart_rows_ > 0 ? num_segments_ : 0;
+}
+
+// Locate the entropy coded data of each restart interval in the scan. The
+// frame can be decoded in parallel if it is a single interleaved baseline scan
+// and every restart interval covers whole iMCU rows.
+LIBYUV_BOOL MJpegDecoder::FindRestartSegments() {
+#ifdef HAVE_SETJMP
+  jpeg_decompress_struct* cinfo = decompress_struct_;
+  if (cinfo->progressive_mode || cinfo->arith_code ||
+      cinfo->restart_interval == 0 ||
+      cinfo->comps_in_scan != cinfo->num_components ||
+      cinfo->num_components > MAX_COMPS_IN_SCAN) {
+    return LIBYUV_FALSE;
+  }
+  for (int i = 0; i < num_outbufs_; ++i) {
+    if (GetComponentScanlinesPerImcuRow(i) * GetVertSubSampFactor(i) !=
+        GetImageScanlinesPerImcuRow()) {
+      return LIBYUV_FALSE;
+    }
+  }
+  int mcus_per_row;
+  if (cinfo->comps_in_scan == 1) {
+    // A non-interleaved MCU is one block.
+    if (cinfo->comp_info[0].v_samp_factor != 1) {
+      return LIBYUV_FALSE;
+    }
+    mcus_per_row = DivideAndRoundUp(GetWidth(), DCTSIZE);
+  } else {
+    mcus_per_row =
+        DivideAndRoundUp(GetWidth(), cinfo->max_h_samp_factor * DCTSIZE);
+  }
+  if (mcus_per_row <= 0 ||
+      (int)(cinfo->restart_interval) % mcus_per_row != 0) {
+    return LIBYUV_FALSE;
+  }
+  int restart_rows = (int)(cinfo->restart_interval) / mcus_per_row;
+  int num_segments =
+      DivideAndRoundUp((int)(cinfo->total_iMCU_rows), restart_rows);
+  if (num_segments < 2) {
+    return LIBYUV_FALSE;
+  }
+  if (num_segments > segments_size_) {
+    delete[] segment_begin_;
+    delete[] segment_end_;
+    segment_begin_ = new size_t[num_segments];
+    segment_end_ = new size_t[num_segments];
+    segments_size_ = num_segments;
+  }
+
+  // jpeg_read_header stops after the SOS marker, at the entropy coded data.
+  const uint8_t* data = buf_.data;
+  size_t len = (size_t)(buf_.len);
+  if (cinfo->src->next_input_byte < data ||
+      cinfo->src->next_input_byte > data + len) {
+    return LIBYUV_FALSE;
+  }
+  size_t pos = (size_t)(cinfo->src->next_input_byte - data);
+  scan_offset_ = pos;
+  size_t begin = pos;
+  size_t end = len;
+  int n = 0;
+  while (pos + 1 < len) {
+    const uint8_t* marker =
+        (const uint8_t*)(memchr(data + pos, 0xff, len - pos));
+    if (!marker || marker + 1 >= data + len) {
+      break;
+    }
+    pos = (size_t)(marker - data);
+    uint8_t code = marker[1];
+    if (code == 0x00) {  // Stuffed 0xff data byte.
+      pos += 2;
+    } else if (code == 0xff) {  // Fill byte.
+      pos += 1;
+    } else if (code >= 0xd0 && code <= 0xd7) {  // RSTn ends an interval.
+      if (code != 0xd0 + (n & 7) || n + 1 >= num_segments) {
+        return LIBYUV_FALSE;
+      }
+      segment_begin_[n] = begin;
+      segment_end_[n] = pos;
+      ++n;
+      pos += 2;
+      begin = pos;
+    } else {  // EOI or any other marker ends the scan.
+      end = pos;
+      break;
+    }
+  }
+  segment_begin_[n] = begin;
+  segment_end_[n] = end;
+  ++n;
+  if (n != num_segments) {
+    return LIBYUV_FALSE;
+  }
+  num_segments_ = num_segments;
+  restart_rows_ = restart_rows;
+  return LIBYUV_TRUE;
+#else
+  return LIBYUV_FALSE;
+#endif
+}
+
+// Decode the restart intervals that intersect the crop on the executor.
+// Returns false, with nothing written, if the caller must decode sequentially.
+LIBYUV_BOOL MJpegDecoder::DecodeRestartSegments(uint8_t** planes,
+                                                int dst_height) {
+#ifdef HAVE_SETJMP
+  if (!executor_ || restart_rows_ <= 0) {
+    return LIBYUV_FALSE;
+  }
+  // Same vertical crop as the sequential decode.
+  int skip = (GetOutputHeight() - dst_height) / 2;
+  int imcu_lines = GetImageScanlinesPerImcuRow();
+  int first_segment = skip / imcu_lines / restart_rows_;
+  int end_imcu_row = DivideAndRoundUp(skip + dst_height, imcu_lines);
+  int num_segments =
+      DivideAndRoundUp(end_imcu_row, restart_rows_) - first_segment;
+  if (num_segments < 2) {
+    return LIBYUV_FALSE;
+  }
+  MJpegRestartJobs jobs;
+  jobs.decoder = this;
+  jobs.first_segment = first_segment;
+  jobs.num_segments = num_segments;
+  jobs.num_jobs = num_segments < max_jobs_ ? num_segments : max_jobs_;
+  jobs.end_imcu_row = end_imcu_row;
+  for (int i = 0; i < num_outbufs_; ++i) {
+    int vs = GetVertSubSampFactor(i);
+    if (skip % vs != 0) {
+      return LIBYUV_FALSE;
+    }
+    jobs.planes[i] = planes[i];
+    jobs.row_begin[i] = skip / vs;
+    jobs.row_end[i] = DivideAndRoundUp(skip + dst_height, vs);
+  }
+  (*executor_)(executor_context_, &MJpegDecoder::DecodeRestartJob, &jobs,
+               jobs.num_jobs);
+  for (int j = 0; j < jobs.num_jobs; ++j) {
+    if (!workers_[j].ok) {
+      return LIBYUV_FALSE;
+    }
+  }
+  for (int i = 0; i < num_outbufs_; ++i) {
+    planes[i] += (jobs.row_end[i] - jobs.row_begin[i]) * GetComponentWidth(i);
+  }
+  // Return the frame decoder to its start state, as FinishDecode does.
+  jpeg_abort_decompress(decompress_struct_);
+  return LIBYUV_TRUE;
+#else
+  (void)planes;
+  (void)dst_height;
+  return LIBYUV_FALSE;
+#endif
+}
+
+void MJpegDecoder::DecodeRestartJob(void* job_context, int index) {
+#ifdef HAVE_SETJMP
+  MJpegRestartJobs* jobs = static_cast<MJpegRestartJobs*>(job_context);
+  MJpegDecoder* decoder = jobs->decoder;
+  MJpegRestartWorker* worker = &decoder->workers_[index];
+  jpeg_decompress_struct* cinfo = &worker->decompress_struct;
+  int segment =
+      jobs->first_segment + jobs->num_segments * index / jobs->num_jobs;
+  int end_segment =
+      jobs->first_segment + jobs->num_segments * (index + 1) / jobs->num_jobs;
+  worker->ok = LIBYUV_FALSE;
+
+  // Build a stream of the frame header followed by this job's restart
+  // intervals, with the restart markers renumbered from RST0.
+  size_t stream_size = decoder->scan_offset_ + 2;
+  for (int s = segment; s < end_segment; ++s) {
+    stream_size += decoder->segment_end_[s] - decoder->segment_begin_[s] + 2;
+  }
+  if (stream_size > worker->stream_size) {
+    delete[] worker->stream;
+    worker->stream = new uint8_t[stream_size];
+    worker->stream_size = stream_size;
+  }
+  uint8_t* dst = worker->stream;
+  memcpy(dst, decoder->buf_.data, decoder->scan_offset_);
+  dst += decoder->scan_offset_;
+  for (int s = segment; s < end_segment; ++s) {
+    size_t size = decoder->segment_end_[s] - decoder->segment_begin_[s];
+    memcpy(dst, decoder->buf_.data + decoder->segment_begin_[s], size);
+    dst += size;
+    dst[0] = 0xff;
+    dst[1] = (s + 1 < end_segment) ? (uint8_t)(0xd0 + ((s - segment) & 7))
+                                   : 0xd9;  // EOI
+    dst += 2;
+  }
+  worker->buf.data = worker->stream;
+  worker->buf.len = (int)(dst - worker->stream);
+  worker->buf_vec.pos = 0;
+
+  if (setjmp(worker->error_mgr.setjmp_buffer)) {
+    // jpeglib failed on this job. The caller decodes sequentially instead.
+    return;
+  }
+  jpeg_abort_decompress(cinfo);
+  if (jpeg_read_header(cinfo, TRUE) != JPEG_HEADER_OK) {
+    return;
+  }
+  SetDecodeParameters(cinfo);
+  cinfo->scale_num = decoder->decompress_struct_->scale_num;
+  cinfo->scale_denom = decoder->decompress_struct_->scale_denom;
+  if (!jpeg_start_decompress(cinfo)) {
+    return;
+  }
+  int num_components = decoder->num_outbufs_;
+  for (int i = 0; i < num_components; ++i) {
+    int stride = decoder->GetComponentStride(i);
+    int size = decoder->GetComponentScanlinesPerImcuRow(i) * stride;
+    if (size > worker->databuf_size[i]) {
+      delete[] worker->databuf[i];
+      worker->databuf[i] = new uint8_t[size];
+      worker->databuf_size[i] = size;
+    }
+    for (int j = 0; j < decoder->GetComponentScanlinesPerImcuRow(i); ++j) {
+      worker->scanlines[i][j] = worker->databuf[i] + j * stride;
+    }
+  }
+
+  int imcu_lines = decoder->GetImageScanlinesPerImcuRow();
+  int row = segment * decoder->restart_rows_;
+  int end_row = end_segment * decoder->restart_rows_;
+  if (end_row > jobs->end_imcu_row) {
+    end_row = jobs->end_imcu_row;
+  }
+  for (; row < end_row; ++row) {
+    if ((unsigned int)(imcu_lines) !=
+        jpeg_read_raw_data(cinfo, worker->planes, imcu_lines)) {
+      jpeg_abort_decompress(cinfo);
+      return;
+    }
+    // Copy the part of the iMCU row that is inside the crop.
+    for (int i = 0; i < num_components; ++i) {
+      int rows = decoder->GetComponentScanlinesPerImcuRow(i);
+      int width = decoder->GetComponentWidth(i);
+      int y = row * rows;
+      int begin = y > jobs->row_begin[i] ? y : jobs->row_begin[i];
+      int end = y + rows < jobs->row_end[i] ? y + rows : jobs->row_end[i];
+      if (begin < end) {
+        CopyPlane(worker->databuf[i] +
+                      (begin - y) * decoder->GetComponentStride(i),
+                  decoder->GetComponentStride(i),
+                  jobs->planes[i] + (begin - jobs->row_begin[i]) * width,
+                  width, width, end - begin);
+      }
+    }
+  }
+  jpeg_abort_decompress(cinfo);
+  worker->ok = LIBYUV_TRUE;
+#else
+  (void)job_context;
+  (void)index;
+#endif
+}
+
 // The helper function which recognizes the jpeg sub-sampling type.
 JpegSubsamplingType MJpegDecoder::JpegSubsamplingTypeHelper(
     int* subsample_x,
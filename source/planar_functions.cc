@@ -17,6 +17,7 @@
 #include "libyuv/convert_from_argb.h"  // For ArgbConstants
 #include "libyuv/cpu_id.h"
 #include "libyuv/row.h"
+#include "libyuv/row_dispatch.h"
 #include "libyuv/scale_row.h"  // for ScaleRowDown2
 
 #ifdef __cplusplus
@@ -2989,6 +2990,16 @@ int ARGBBlend(const uint8_t* src_argb0,
     ARGBBlendRow = ARGBBlendRow_SSSE3;
   }
 #endif
+#if defined(HAS_ARGBBLENDROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ARGBBlendRow = ARGBBlendRow_AVX2;
+  }
+#endif
+#if defined(HAS_ARGBBLENDROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    ARGBBlendRow = ARGBBlendRow_AVX512BW;
+  }
+#endif
 #if defined(HAS_ARGBBLENDROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     ARGBBlendRow = ARGBBlendRow_NEON;
@@ -3013,6 +3024,88 @@ int ARGBBlend(const uint8_t* src_argb0,
   return 0;
 }
 
+// Alpha Blend a list of ARGB layers onto the destination, bottom layer first.
+// Each destination row is blended with every layer that covers it while the
+// row is in cache, instead of 1 pass over the image per layer.
+LIBYUV_API
+int ARGBCompositeLayers(const struct ARGBLayer* layers,
+                        int num_layers,
+                        uint8_t* dst_argb,
+                        int dst_stride_argb,
+                        int width,
+                        int height) {
+  int y;
+  int i;
+  void (*ARGBBlendRow)(const uint8_t* src_argb, const uint8_t* src_argb1,
+                       uint8_t* dst_argb, int width) = ARGBBlendRow_C;
+  if (!layers || num_layers < 0 || !dst_argb || width <= 0 || height == 0 ||
+      height == INT_MIN) {
+    return -1;
+  }
+  for (i = 0; i < num_layers; ++i) {
+    if (!layers[i].src_argb || layers[i].width < 0 || layers[i].height < 0) {
+      return -1;
+    }
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    dst_argb = dst_argb + (ptrdiff_t)(height - 1) * dst_stride_argb;
+    dst_stride_argb = -dst_stride_argb;
+  }
+#if defined(HAS_ARGBBLENDROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    ARGBBlendRow = ARGBBlendRow_SSSE3;
+  }
+#endif
+#if defined(HAS_ARGBBLENDROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ARGBBlendRow = ARGBBlendRow_AVX2;
+  }
+#endif
+#if defined(HAS_ARGBBLENDROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    ARGBBlendRow = ARGBBlendRow_AVX512BW;
+  }
+#endif
+#if defined(HAS_ARGBBLENDROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    ARGBBlendRow = ARGBBlendRow_NEON;
+  }
+#endif
+#if defined(HAS_ARGBBLENDROW_LSX)
+  if (TestCpuFlag(kCpuHasLSX)) {
+    ARGBBlendRow = ARGBBlendRow_LSX;
+  }
+#endif
+#if defined(HAS_ARGBBLENDROW_RVV)
+  if (TestCpuFlag(kCpuHasRVV)) {
+    ARGBBlendRow = ARGBBlendRow_RVV;
+  }
+#endif
+  for (y = 0; y < height; ++y) {
+    for (i = 0; i < num_layers; ++i) {
+      const struct ARGBLayer* layer = &layers[i];
+      // Clip the layer row to the destination.
+      int64_t layer_y = (int64_t)y - layer->y;
+      int64_t x0 = layer->x > 0 ? layer->x : 0;
+      int64_t x1 = (int64_t)layer->x + layer->width;
+      if (x1 > width) {
+        x1 = width;
+      }
+      if (layer_y < 0 || layer_y >= layer->height || x0 >= x1) {
+        continue;
+      }
+      ARGBBlendRow(layer->src_argb +
+                       (ptrdiff_t)layer_y * layer->src_stride_argb +
+                       (ptrdiff_t)(x0 - layer->x) * 4,
+                   dst_argb + x0 * 4, dst_argb + x0 * 4, (int)(x1 - x0));
+    }
+    dst_argb += dst_stride_argb;
+  }
+  return 0;
+}
+
 // Alpha Blend plane and store to destination.
 LIBYUV_API
 int BlendPlane(const uint8_t* src_y0,
@@ -4255,6 +4348,11 @@ int ARGBComputeCumulativeSum(const uint8_t* src_argb,
     ComputeCumulativeSumRow = ComputeCumulativeSumRow_SSE2;
   }
 #endif
+#if defined(HAS_COMPUTECUMULATIVESUMROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ComputeCumulativeSumRow = ComputeCumulativeSumRow_AVX2;
+  }
+#endif
 
   memset(dst_cumsum, 0, width * sizeof(dst_cumsum[0]) * 4);  // 4 int per pixel.
   for (y = 0; y < height; ++y) {
@@ -4267,9 +4365,9 @@ int ARGBComputeCumulativeSum(const uint8_t* src_argb,
 }
 
 // Blur ARGB image.
-// Caller should allocate CumulativeSum table of width * height * 16 bytes
-// aligned to 16 byte boundary. height can be radius * 2 + 2 to save memory
-// as the buffer is treated as circular.
+// Caller should allocate CumulativeSum table of width * (radius * 2 + 2) * 16
+// bytes aligned to 16 byte boundary, as the buffer is treated as circular.
+// If dst_cumsum is NULL the table is allocated here.
 LIBYUV_API
 int ARGBBlur(const uint8_t* src_argb,
              int src_stride_argb,
@@ -4309,11 +4407,31 @@ int ARGBBlur(const uint8_t* src_argb,
   if (radius <= 0 || height <= 1) {
     return -1;
   }
+  if (!dst_cumsum) {
+    int ret;
+    align_buffer_64(cumsum, (size_t)(radius * 2 + 2) * width * 16);
+    if (!cumsum)
+      return 1;
+    ret = ARGBBlur(src_argb, src_stride_argb, dst_argb, dst_stride_argb,
+                   (int32_t*)cumsum, width * 4, width, height, radius);
+    free_aligned_buffer_64(cumsum);
+    return ret;
+  }
 #if defined(HAS_CUMULATIVESUMTOAVERAGEROW_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
     ComputeCumulativeSumRow = ComputeCumulativeSumRow_SSE2;
     CumulativeSumToAverageRow = CumulativeSumToAverageRow_SSE2;
   }
+#endif
+#if defined(HAS_COMPUTECUMULATIVESUMROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ComputeCumulativeSumRow = ComputeCumulativeSumRow_AVX2;
+  }
+#endif
+#if defined(HAS_CUMULATIVESUMTOAVERAGEROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    CumulativeSumToAverageRow = CumulativeSumToAverageRow_AVX2;
+  }
 #endif
   // Compute enough CumulativeSum for first row to be blurred. After this
   // one row of CumulativeSum is updated at a time.
@@ -4380,6 +4498,85 @@ int ARGBBlur(const uint8_t* src_argb,
   return 0;
 }
 
+// Integral image of a plane, where each value is the sum of all values
+// above and to the left of it, inclusive.
+LIBYUV_API
+int IntegralPlane(const uint8_t* src_y,
+                  int src_stride_y,
+                  uint32_t* dst_sum,
+                  int dst_stride_sum,
+                  int width,
+                  int height) {
+  int y;
+  void (*IntegralRow)(const uint8_t* src, uint32_t* dst,
+                      const uint32_t* previous, int width) = IntegralRow_C;
+  const uint32_t* previous;
+  if (!src_y || !dst_sum || width <= 0 || height == 0 || height == INT_MIN) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    src_y = src_y + (ptrdiff_t)(height - 1) * src_stride_y;
+    src_stride_y = -src_stride_y;
+  }
+#if defined(HAS_INTEGRALROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    IntegralRow = IntegralRow_AVX2;
+  }
+#endif
+
+  // The first row adds to itself after it is cleared.
+  memset(dst_sum, 0, width * sizeof(dst_sum[0]));
+  previous = dst_sum;
+  for (y = 0; y < height; ++y) {
+    IntegralRow(src_y, dst_sum, previous, width);
+    previous = dst_sum;
+    src_y += src_stride_y;
+    dst_sum += dst_stride_sum;
+  }
+  return 0;
+}
+
+// Integral image of the squares of a plane.
+LIBYUV_API
+int IntegralPlaneSquared(const uint8_t* src_y,
+                         int src_stride_y,
+                         uint32_t* dst_sumsq,
+                         int dst_stride_sumsq,
+                         int width,
+                         int height) {
+  int y;
+  void (*IntegralSquaredRow)(const uint8_t* src, uint32_t* dst,
+                             const uint32_t* previous, int width) =
+      IntegralSquaredRow_C;
+  const uint32_t* previous;
+  if (!src_y || !dst_sumsq || width <= 0 || height == 0 || height == INT_MIN) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    src_y = src_y + (ptrdiff_t)(height - 1) * src_stride_y;
+    src_stride_y = -src_stride_y;
+  }
+#if defined(HAS_INTEGRALSQUAREDROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    IntegralSquaredRow = IntegralSquaredRow_AVX2;
+  }
+#endif
+
+  memset(dst_sumsq, 0, width * sizeof(dst_sumsq[0]));
+  previous = dst_sumsq;
+  for (y = 0; y < height; ++y) {
+    IntegralSquaredRow(src_y, dst_sumsq, previous, width);
+    previous = dst_sumsq;
+    src_y += src_stride_y;
+    dst_sumsq += dst_stride_sumsq;
+  }
+  return 0;
+}
+
 // Multiply ARGB image by a specified ARGB value.
 LIBYUV_API
 int ARGBShade(const uint8_t* src_argb,
@@ -4469,45 +4666,7 @@ int InterpolatePlane(const uint8_t* src0,
     height = 1;
     src_stride0 = src_stride1 = dst_stride = 0;
   }
-#if defined(HAS_INTERPOLATEROW_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    InterpolateRow = InterpolateRow_Any_AVX2;
-    if (IS_ALIGNED(width, 32)) {
-      InterpolateRow = InterpolateRow_AVX2;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    InterpolateRow = InterpolateRow_Any_NEON;
-    if (IS_ALIGNED(width, 16)) {
-      InterpolateRow = InterpolateRow_NEON;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_SVE2)
-  if (TestCpuFlag(kCpuHasSVE2)) {
-    InterpolateRow = InterpolateRow_SVE2;
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_SME)
-  if (TestCpuFlag(kCpuHasSME)) {
-    InterpolateRow = InterpolateRow_SME;
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_LSX)
-  if (TestCpuFlag(kCpuHasLSX)) {
-    InterpolateRow = InterpolateRow_Any_LSX;
-    if (IS_ALIGNED(width, 32)) {
-      InterpolateRow = InterpolateRow_LSX;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_RVV)
-  if (TestCpuFlag(kCpuHasRVV)) {
-    InterpolateRow = InterpolateRow_RVV;
-  }
-#endif
+  InterpolateRow = ROW_KERNEL(GetRowDispatch()->InterpolateRow, width);
 
   for (y = 0; y < height; ++y) {
     InterpolateRow(dst, src0, src1 - src0, width, interpolation);
@@ -4850,6 +5009,38 @@ int GaussPlane_F32(const float* src,
   if (TestCpuFlag(kCpuHasNEON) && IS_ALIGNED(width, 8)) {
     GaussRow_F32 = GaussRow_F32_NEON;
   }
+#endif
+#if defined(HAS_GAUSSCOL_F32_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2) && TestCpuFlag(kCpuHasFMA3)) {
+    GaussCol_F32 = GaussCol_F32_Any_AVX2;
+    if (IS_ALIGNED(width, 16)) {
+      GaussCol_F32 = GaussCol_F32_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_GAUSSROW_F32_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2) && TestCpuFlag(kCpuHasFMA3)) {
+    GaussRow_F32 = GaussRow_F32_Any_AVX2;
+    if (IS_ALIGNED(width, 16)) {
+      GaussRow_F32 = GaussRow_F32_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_GAUSSCOL_F32_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    GaussCol_F32 = GaussCol_F32_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      GaussCol_F32 = GaussCol_F32_AVX512BW;
+    }
+  }
+#endif
+#if defined(HAS_GAUSSROW_F32_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    GaussRow_F32 = GaussRow_F32_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      GaussRow_F32 = GaussRow_F32_AVX512BW;
+    }
+  }
 #endif
   {
     // 2 pixels on each side, but aligned out to 16 bytes.
@@ -4888,7 +5079,172 @@ int GaussPlane_F32(const float* src,
   return 0;
 }
 
+// Gauss blur an 8 bit plane using Gaussian 5x5 filter with
+// coefficients of 1, 4, 6, 4, 1.
+// Same as GaussPlane_F32 in fixed point.  Columns are summed to 16 bit and
+// rows are rounded back to 8 bit.
+LIBYUV_API
+int GaussPlane(const uint8_t* src,
+               int src_stride,
+               uint8_t* dst,
+               int dst_stride,
+               int width,
+               int height) {
+  int y;
+  void (*GaussCol_8)(const uint8_t* src0, const uint8_t* src1,
+                     const uint8_t* src2, const uint8_t* src3,
+                     const uint8_t* src4, uint16_t* dst, int width) =
+      GaussCol_8_C;
+  void (*GaussRow_8)(const uint16_t* src, uint8_t* dst, int width) =
+      GaussRow_8_C;
+  if (!src || !dst || width <= 0 || height == 0 || height == INT_MIN) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    src = src + (ptrdiff_t)(height - 1) * src_stride;
+    src_stride = -src_stride;
+  }
+
+#if defined(HAS_GAUSSCOL_8_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    GaussCol_8 = GaussCol_8_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      GaussCol_8 = GaussCol_8_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_GAUSSROW_8_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    GaussRow_8 = GaussRow_8_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      GaussRow_8 = GaussRow_8_AVX2;
+    }
+  }
+#endif
+  {
+    // 2 pixels on each side, but aligned out to 16 bytes.
+    align_buffer_64(rowbuf, (8 + width + 8) * 2);
+    if (!rowbuf)
+      return 1;
+    memset(rowbuf, 0, 16);
+    memset(rowbuf + (8 + width) * 2, 0, 16);
+    uint16_t* row = (uint16_t*)(rowbuf + 16);
+    const uint8_t* src0 = src;
+    const uint8_t* src1 = src;
+    const uint8_t* src2 = src;
+    const uint8_t* src3 = src2 + ((height > 1) ? src_stride : 0);
+    const uint8_t* src4 = src3 + ((height > 2) ? src_stride : 0);
+
+    for (y = 0; y < height; ++y) {
+      GaussCol_8(src0, src1, src2, src3, src4, row, width);
+
+      // Extrude edge by 2 pixels
+      row[-2] = row[-1] = row[0];
+      row[width + 1] = row[width] = row[width - 1];
+
+      GaussRow_8(row - 2, dst, width);
+
+      src0 = src1;
+      src1 = src2;
+      src2 = src3;
+      src3 = src4;
+      if ((y + 2) < (height - 1)) {
+        src4 += src_stride;
+      }
+      dst += dst_stride;
+    }
+    free_aligned_buffer_64(rowbuf);
+  }
+  return 0;
+}
+
+// Gauss blur a 16 bit plane using Gaussian 5x5 filter with
+// coefficients of 1, 4, 6, 4, 1.
+// Columns are summed to 32 bit and rows are rounded back to 16 bit.
+LIBYUV_API
+int GaussPlane_16(const uint16_t* src,
+                  int src_stride,
+                  uint16_t* dst,
+                  int dst_stride,
+                  int width,
+                  int height) {
+  int y;
+  void (*GaussCol)(const uint16_t* src0, const uint16_t* src1,
+                   const uint16_t* src2, const uint16_t* src3,
+                   const uint16_t* src4, uint32_t* dst, int width) =
+      GaussCol_C;
+  void (*GaussRow)(const uint32_t* src, uint16_t* dst, int width) =
+      GaussRow_C;
+  if (!src || !dst || width <= 0 || height == 0 || height == INT_MIN) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    src = src + (ptrdiff_t)(height - 1) * src_stride;
+    src_stride = -src_stride;
+  }
+
+#if defined(HAS_GAUSSCOL_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    GaussCol = GaussCol_Any_AVX2;
+    if (IS_ALIGNED(width, 16)) {
+      GaussCol = GaussCol_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_GAUSSROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    GaussRow = GaussRow_Any_AVX2;
+    if (IS_ALIGNED(width, 16)) {
+      GaussRow = GaussRow_AVX2;
+    }
+  }
+#endif
+  {
+    // 2 pixels on each side, but aligned out to 16 bytes.
+    align_buffer_64(rowbuf, (4 + width + 4) * 4);
+    if (!rowbuf)
+      return 1;
+    memset(rowbuf, 0, 16);
+    memset(rowbuf + (4 + width) * 4, 0, 16);
+    uint32_t* row = (uint32_t*)(rowbuf + 16);
+    const uint16_t* src0 = src;
+    const uint16_t* src1 = src;
+    const uint16_t* src2 = src;
+    const uint16_t* src3 = src2 + ((height > 1) ? src_stride : 0);
+    const uint16_t* src4 = src3 + ((height > 2) ? src_stride : 0);
+
+    for (y = 0; y < height; ++y) {
+      GaussCol(src0, src1, src2, src3, src4, row, width);
+
+      // Extrude edge by 2 pixels
+      row[-2] = row[-1] = row[0];
+      row[width + 1] = row[width] = row[width - 1];
+
+      GaussRow(row - 2, dst, width);
+
+      src0 = src1;
+      src1 = src2;
+      src2 = src3;
+      src3 = src4;
+      if ((y + 2) < (height - 1)) {
+        src4 += src_stride;
+      }
+      dst += dst_stride;
+    }
+    free_aligned_buffer_64(rowbuf);
+  }
+  return 0;
+}
+
 // Sobel ARGB effect.
+// SobelRow combines separate Sobel X and Sobel Y rows.  When allow_fused is
+// set and a SIMD SobelPlaneRow is available, the Sobel is instead computed in
+// a single pass and stored through SobelGrayRow, or directly to dst when
+// SobelGrayRow is NULL.
 static int ARGBSobelize(const uint8_t* src_argb,
                         int src_stride_argb,
                         uint8_t* dst_argb,
@@ -4898,7 +5254,11 @@ static int ARGBSobelize(const uint8_t* src_argb,
                         void (*SobelRow)(const uint8_t* src_sobelx,
                                          const uint8_t* src_sobely,
                                          uint8_t* dst,
-                                         int width)) {
+                                         int width),
+                        void (*SobelGrayRow)(const uint8_t* src_sobel,
+                                             uint8_t* dst,
+                                             int width),
+                        int allow_fused) {
   int y;
   void (*ARGBToYMatrixRow)(const uint8_t* src_argb, uint8_t* dst_g, int width,
                            const struct ArgbConstants* c) = ARGBToYMatrixRow_C;
@@ -4907,6 +5267,9 @@ static int ARGBSobelize(const uint8_t* src_argb,
   void (*SobelXRow)(const uint8_t* src_y0, const uint8_t* src_y1,
                     const uint8_t* src_y2, uint8_t* dst_sobely, int width) =
       SobelXRow_C;
+  void (*SobelPlaneRow)(const uint8_t* src_y0, const uint8_t* src_y1,
+                        const uint8_t* src_y2, uint8_t* dst_y, int width) =
+      NULL;
   const int kEdge = 16;  // Extra pixels at start of row for extrude/align.
   if (!src_argb || !dst_argb || width <= 0 || height == 0 ||
       height == INT_MIN) {
@@ -4986,26 +5349,57 @@ static int ARGBSobelize(const uint8_t* src_argb,
   }
 #endif
 
-#if defined(HAS_SOBELYROW_SSE2)
-  if (TestCpuFlag(kCpuHasSSE2)) {
-    SobelYRow = SobelYRow_SSE2;
+  if (allow_fused) {
+#if defined(HAS_SOBELPLANEROW_AVX2)
+    if (TestCpuFlag(kCpuHasAVX2)) {
+      SobelPlaneRow = SobelPlaneRow_Any_AVX2;
+      if (IS_ALIGNED(width, 32)) {
+        SobelPlaneRow = SobelPlaneRow_AVX2;
+      }
+    }
+#endif
+#if defined(HAS_SOBELPLANEROW_AVX512BW)
+    if (TestCpuFlag(kCpuHasAVX512BW)) {
+      SobelPlaneRow = SobelPlaneRow_Any_AVX512BW;
+      if (IS_ALIGNED(width, 32)) {
+        SobelPlaneRow = SobelPlaneRow_AVX512BW;
+      }
+    }
+#endif
   }
+  // The separate X and Y rows are only needed without a fused kernel.
+  if (!SobelPlaneRow) {
+#if defined(HAS_SOBELYROW_SSE2)
+    if (TestCpuFlag(kCpuHasSSE2)) {
+      SobelYRow = SobelYRow_SSE2;
+    }
 #endif
 #if defined(HAS_SOBELYROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    SobelYRow = SobelYRow_NEON;
-  }
+    if (TestCpuFlag(kCpuHasNEON)) {
+      SobelYRow = SobelYRow_NEON;
+    }
 #endif
 #if defined(HAS_SOBELXROW_SSE2)
-  if (TestCpuFlag(kCpuHasSSE2)) {
-    SobelXRow = SobelXRow_SSE2;
-  }
+    if (TestCpuFlag(kCpuHasSSE2)) {
+      SobelXRow = SobelXRow_SSE2;
+    }
 #endif
 #if defined(HAS_SOBELXROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    SobelXRow = SobelXRow_NEON;
-  }
+    if (TestCpuFlag(kCpuHasNEON)) {
+      SobelXRow = SobelXRow_NEON;
+    }
+#endif
+#if defined(HAS_SOBELYROW_AVX2)
+    if (TestCpuFlag(kCpuHasAVX2)) {
+      SobelYRow = SobelYRow_AVX2;
+    }
+#endif
+#if defined(HAS_SOBELXROW_AVX2)
+    if (TestCpuFlag(kCpuHasAVX2)) {
+      SobelXRow = SobelXRow_AVX2;
+    }
 #endif
+  }
   {
     // 3 rows with edges before/after.
     const int row_size = (width + kEdge + 31) & ~31;
@@ -5037,9 +5431,16 @@ static int ARGBSobelize(const uint8_t* src_argb,
       row_y2[-1] = row_y2[0];
       row_y2[width] = row_y2[width - 1];
 
-      SobelXRow(row_y0 - 1, row_y1 - 1, row_y2 - 1, row_sobelx, width);
-      SobelYRow(row_y0 - 1, row_y2 - 1, row_sobely, width);
-      SobelRow(row_sobelx, row_sobely, dst_argb, width);
+      if (!SobelPlaneRow) {
+        SobelXRow(row_y0 - 1, row_y1 - 1, row_y2 - 1, row_sobelx, width);
+        SobelYRow(row_y0 - 1, row_y2 - 1, row_sobely, width);
+        SobelRow(row_sobelx, row_sobely, dst_argb, width);
+      } else if (SobelGrayRow) {
+        SobelPlaneRow(row_y0 - 1, row_y1 - 1, row_y2 - 1, row_sobelx, width);
+        SobelGrayRow(row_sobelx, dst_argb, width);
+      } else {
+        SobelPlaneRow(row_y0 - 1, row_y1 - 1, row_y2 - 1, dst_argb, width);
+      }
 
       // Cycle thru circular queue of 3 row_y buffers.
       {
@@ -5066,6 +5467,9 @@ int ARGBSobel(const uint8_t* src_argb,
               int height) {
   void (*SobelRow)(const uint8_t* src_sobelx, const uint8_t* src_sobely,
                    uint8_t* dst_argb, int width) = SobelRow_C;
+  // Fused Sobel is stored as gray ARGB, the same as J400ToARGB.
+  void (*J400ToARGBRow)(const uint8_t* src_y, uint8_t* dst_argb, int width) =
+      J400ToARGBRow_C;
 #if defined(HAS_SOBELROW_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
     SobelRow = SobelRow_Any_SSE2;
@@ -5089,9 +5493,46 @@ int ARGBSobel(const uint8_t* src_argb,
       SobelRow = SobelRow_LSX;
     }
   }
+#endif
+#if defined(HAS_J400TOARGBROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    J400ToARGBRow = J400ToARGBRow_Any_AVX2;
+    if (IS_ALIGNED(width, 16)) {
+      J400ToARGBRow = J400ToARGBRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_J400TOARGBROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    J400ToARGBRow = J400ToARGBRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      J400ToARGBRow = J400ToARGBRow_AVX512BW;
+    }
+  }
+#endif
+#if defined(HAS_J400TOARGBROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    J400ToARGBRow = J400ToARGBRow_Any_NEON;
+    if (IS_ALIGNED(width, 8)) {
+      J400ToARGBRow = J400ToARGBRow_NEON;
+    }
+  }
+#endif
+#if defined(HAS_J400TOARGBROW_LSX)
+  if (TestCpuFlag(kCpuHasLSX)) {
+    J400ToARGBRow = J400ToARGBRow_Any_LSX;
+    if (IS_ALIGNED(width, 16)) {
+      J400ToARGBRow = J400ToARGBRow_LSX;
+    }
+  }
+#endif
+#if defined(HAS_J400TOARGBROW_RVV)
+  if (TestCpuFlag(kCpuHasRVV)) {
+    J400ToARGBRow = J400ToARGBRow_RVV;
+  }
 #endif
   return ARGBSobelize(src_argb, src_stride_argb, dst_argb, dst_stride_argb,
-                      width, height, SobelRow);
+                      width, height, SobelRow, J400ToARGBRow, 1);
 }
 
 // Sobel ARGB effect with planar output.
@@ -5129,7 +5570,7 @@ int ARGBSobelToPlane(const uint8_t* src_argb,
   }
 #endif
   return ARGBSobelize(src_argb, src_stride_argb, dst_y, dst_stride_y, width,
-                      height, SobelToPlaneRow);
+                      height, SobelToPlaneRow, NULL, 1);
 }
 
 // SobelXY ARGB effect.
@@ -5151,6 +5592,14 @@ int ARGBSobelXY(const uint8_t* src_argb,
     }
   }
 #endif
+#if defined(HAS_SOBELXYROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    SobelXYRow = SobelXYRow_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      SobelXYRow = SobelXYRow_AVX2;
+    }
+  }
+#endif
 #if defined(HAS_SOBELXYROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     SobelXYRow = SobelXYRow_Any_NEON;
@@ -5168,7 +5617,89 @@ int ARGBSobelXY(const uint8_t* src_argb,
   }
 #endif
   return ARGBSobelize(src_argb, src_stride_argb, dst_argb, dst_stride_argb,
-                      width, height, SobelXYRow);
+                      width, height, SobelXYRow, NULL, 0);
+}
+
+// Sobel of the 3x3 window at columns x0, x1, x2 of 3 rows, for the edges.
+static void SobelPlaneEdge(const uint8_t* src_y0,
+                           const uint8_t* src_y1,
+                           const uint8_t* src_y2,
+                           int x0,
+                           int x1,
+                           int x2,
+                           uint8_t* dst_y) {
+  uint8_t win[3][3];
+  win[0][0] = src_y0[x0];
+  win[0][1] = src_y0[x1];
+  win[0][2] = src_y0[x2];
+  win[1][0] = src_y1[x0];
+  win[1][1] = src_y1[x1];
+  win[1][2] = src_y1[x2];
+  win[2][0] = src_y2[x0];
+  win[2][1] = src_y2[x1];
+  win[2][2] = src_y2[x2];
+  SobelPlaneRow_C(win[0], win[1], win[2], dst_y, 1);
+}
+
+// Sobel edge magnitude of a Y plane.
+LIBYUV_API
+int SobelPlane(const uint8_t* src_y,
+               int src_stride_y,
+               uint8_t* dst_y,
+               int dst_stride_y,
+               int width,
+               int height) {
+  int y;
+  void (*SobelPlaneRow)(const uint8_t* src_y0, const uint8_t* src_y1,
+                        const uint8_t* src_y2, uint8_t* dst_y, int width) =
+      SobelPlaneRow_C;
+  if (!src_y || !dst_y || width <= 0 || height == 0 || height == INT_MIN) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    src_y = src_y + (ptrdiff_t)(height - 1) * src_stride_y;
+    src_stride_y = -src_stride_y;
+  }
+  // The interior of each row is width - 2 pixels.
+#if defined(HAS_SOBELPLANEROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    SobelPlaneRow = SobelPlaneRow_Any_AVX2;
+    if (IS_ALIGNED(width - 2, 32)) {
+      SobelPlaneRow = SobelPlaneRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_SOBELPLANEROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    SobelPlaneRow = SobelPlaneRow_Any_AVX512BW;
+    if (IS_ALIGNED(width - 2, 32)) {
+      SobelPlaneRow = SobelPlaneRow_AVX512BW;
+    }
+  }
+#endif
+
+  for (y = 0; y < height; ++y) {
+    // Rows above and below are clamped to the image.
+    const uint8_t* src_y0 =
+        src_y + (ptrdiff_t)(y > 0 ? y - 1 : 0) * src_stride_y;
+    const uint8_t* src_y1 = src_y + (ptrdiff_t)y * src_stride_y;
+    const uint8_t* src_y2 =
+        src_y + (ptrdiff_t)(y < height - 1 ? y + 1 : y) * src_stride_y;
+    if (width == 1) {
+      SobelPlaneEdge(src_y0, src_y1, src_y2, 0, 0, 0, dst_y);
+    } else {
+      SobelPlaneEdge(src_y0, src_y1, src_y2, 0, 0, 1, dst_y);
+      if (width > 2) {
+        SobelPlaneRow(src_y0, src_y1, src_y2, dst_y + 1, width - 2);
+      }
+      SobelPlaneEdge(src_y0, src_y1, src_y2, width - 2, width - 1, width - 1,
+                     dst_y + width - 1);
+    }
+    dst_y += dst_stride_y;
+  }
+  return 0;
 }
 
 // Apply a 4x4 polynomial to each ARGB pixel.
@@ -5727,45 +6258,7 @@ int UYVYToNV12(const uint8_t* src_uyvy,
   }
 #endif
 
-#if defined(HAS_INTERPOLATEROW_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    InterpolateRow = InterpolateRow_Any_AVX2;
-    if (IS_ALIGNED(width, 32)) {
-      InterpolateRow = InterpolateRow_AVX2;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    InterpolateRow = InterpolateRow_Any_NEON;
-    if (IS_ALIGNED(width, 16)) {
-      InterpolateRow = InterpolateRow_NEON;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_SVE2)
-  if (TestCpuFlag(kCpuHasSVE2)) {
-    InterpolateRow = InterpolateRow_SVE2;
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_SME)
-  if (TestCpuFlag(kCpuHasSME)) {
-    InterpolateRow = InterpolateRow_SME;
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_LSX)
-  if (TestCpuFlag(kCpuHasLSX)) {
-    InterpolateRow = InterpolateRow_Any_LSX;
-    if (IS_ALIGNED(width, 32)) {
-      InterpolateRow = InterpolateRow_LSX;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_RVV)
-  if (TestCpuFlag(kCpuHasRVV)) {
-    InterpolateRow = InterpolateRow_RVV;
-  }
-#endif
+  InterpolateRow = ROW_KERNEL(GetRowDispatch()->InterpolateRow, width);
 
   {
     int awidth = halfwidth * 2;
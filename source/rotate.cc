@@ -16,14 +16,47 @@
 #include "libyuv/convert.h"
 #include "libyuv/cpu_id.h"
 #include "libyuv/planar_functions.h"
+#include "libyuv/rotate_argb.h"
 #include "libyuv/rotate_row.h"
 #include "libyuv/row.h"
+#include "libyuv/row_dispatch.h"
 
 #ifdef __cplusplus
 namespace libyuv {
 extern "C" {
 #endif
 
+// Frames more than twice this wide are transposed in bands of this many
+// source columns.  Each strip of source rows writes a few bytes to every
+// destination row of its band, and destination rows are usually a page
+// apart, so a band bounds the pages a strip touches to what the TLB maps.
+// Narrower frames are faster as a single band.
+static const int kTransposeBandWidth = 2048;
+
+// Transpose a band of columns in strips of TRANSPOSE_TILE_ROWS rows.
+static void TransposeBand(const uint8_t* src,
+                          int src_stride,
+                          uint8_t* dst,
+                          int dst_stride,
+                          int width,
+                          int height,
+                          const struct RowDispatch* dispatch) {
+  int i = height;
+  TransposeWxNFunction TransposeWxN = ROW_KERNEL(dispatch->TransposeWxN, width);
+
+  // Work across the source in tiles of TRANSPOSE_TILE_ROWS rows.
+  while (i >= TRANSPOSE_TILE_ROWS) {
+    TransposeWxN(src, src_stride, dst, dst_stride, width);
+    src += TRANSPOSE_TILE_ROWS * src_stride;  // Go down a tile of rows.
+    dst += TRANSPOSE_TILE_ROWS;               // Move over as many columns.
+    i -= TRANSPOSE_TILE_ROWS;
+  }
+
+  if (i > 0) {
+    TransposeWxH_C(src, src_stride, dst, dst_stride, width, i);
+  }
+}
+
 LIBYUV_API
 void TransposePlane(const uint8_t* src,
                     int src_stride,
@@ -31,91 +64,19 @@ void TransposePlane(const uint8_t* src,
                     int dst_stride,
                     int width,
                     int height) {
-  int i = height;
-#if defined(HAS_TRANSPOSEWXH_SME)
-  void (*TransposeWxH)(const uint8_t* src, int src_stride, uint8_t* dst,
-                       int dst_stride, int width, int height) = NULL;
-#endif
-#if defined(HAS_TRANSPOSEWX16_LSX) || defined(HAS_TRANSPOSEWX16_NEON)
-  void (*TransposeWx16)(const uint8_t* src, int src_stride, uint8_t* dst,
-                        int dst_stride, int width) = TransposeWx16_C;
-#else
-  void (*TransposeWx8)(const uint8_t* src, int src_stride, uint8_t* dst,
-                       int dst_stride, int width) = TransposeWx8_C;
-#endif
-
-#if defined(HAS_TRANSPOSEWX8_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    TransposeWx8 = TransposeWx8_Any_NEON;
-    if (IS_ALIGNED(width, 8)) {
-      TransposeWx8 = TransposeWx8_NEON;
-    }
-  }
-#endif
-#if defined(HAS_TRANSPOSEWX16_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    TransposeWx16 = TransposeWx16_Any_NEON;
-    if (IS_ALIGNED(width, 16)) {
-      TransposeWx16 = TransposeWx16_NEON;
-    }
-  }
-#endif
-#if defined(HAS_TRANSPOSEWXH_SME)
-  if (TestCpuFlag(kCpuHasSME)) {
-    TransposeWxH = TransposeWxH_SME;
-  }
-#endif
-#if defined(HAS_TRANSPOSEWX8_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3)) {
-    TransposeWx8 = TransposeWx8_Any_SSSE3;
-    if (IS_ALIGNED(width, 8)) {
-      TransposeWx8 = TransposeWx8_SSSE3;
-    }
-  }
-#endif
-#if defined(HAS_TRANSPOSEWX8_FAST_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3)) {
-    TransposeWx8 = TransposeWx8_Fast_Any_SSSE3;
-    if (IS_ALIGNED(width, 16)) {
-      TransposeWx8 = TransposeWx8_Fast_SSSE3;
-    }
-  }
-#endif
-#if defined(HAS_TRANSPOSEWX16_LSX)
-  if (TestCpuFlag(kCpuHasLSX)) {
-    TransposeWx16 = TransposeWx16_Any_LSX;
-    if (IS_ALIGNED(width, 16)) {
-      TransposeWx16 = TransposeWx16_LSX;
-    }
-  }
-#endif
+  const struct RowDispatch* dispatch = GetRowDispatch();
+  int band_width =
+      width > kTransposeBandWidth * 2 ? kTransposeBandWidth : width;
+  int x;
 
-#if defined(HAS_TRANSPOSEWXH_SME)
-  if (TransposeWxH) {
-    TransposeWxH(src, src_stride, dst, dst_stride, width, height);
+  if (dispatch->TransposeWxH) {
+    dispatch->TransposeWxH(src, src_stride, dst, dst_stride, width, height);
     return;
   }
-#endif
-#if defined(HAS_TRANSPOSEWX16_LSX) || defined(HAS_TRANSPOSEWX16_NEON)
-  // Work across the source in 16x16 tiles
-  while (i >= 16) {
-    TransposeWx16(src, src_stride, dst, dst_stride, width);
-    src += 16 * src_stride;  // Go down 16 rows.
-    dst += 16;               // Move over 16 columns.
-    i -= 16;
-  }
-#else
-  // Work across the source in 8x8 tiles
-  while (i >= 8) {
-    TransposeWx8(src, src_stride, dst, dst_stride, width);
-    src += 8 * src_stride;  // Go down 8 rows.
-    dst += 8;               // Move over 8 columns.
-    i -= 8;
-  }
-#endif
-
-  if (i > 0) {
-    TransposeWxH_C(src, src_stride, dst, dst_stride, width, i);
+  for (x = 0; x < width; x += band_width) {
+    TransposeBand(src + x, src_stride, dst + (ptrdiff_t)dst_stride * x,
+                  dst_stride, width - x < band_width ? width - x : band_width,
+                  height, dispatch);
   }
 }
 
@@ -156,11 +117,7 @@ void RotatePlane180(const uint8_t* src,
                     int dst_stride,
                     int width,
                     int height) {
-  // Swap top and bottom row and mirror the content. Uses a temporary row.
-  align_buffer_64(row, width);
-  assert(row);
-  if (!row)
-    return;
+  // Swap top and bottom row and mirror the content.
   const uint8_t* src_bot = src + (ptrdiff_t)src_stride * (height - 1);
   uint8_t* dst_bot = dst + (ptrdiff_t)dst_stride * (height - 1);
   int half_height = (height + 1) >> 1;
@@ -248,17 +205,14 @@ void RotatePlane180(const uint8_t* src,
   }
 #endif
 
-  // Odd height will harmlessly mirror the middle row twice.
+  // Odd height mirrors the middle row in place.
   for (y = 0; y < half_height; ++y) {
-    CopyRow(src, row, width);        // Copy top row into buffer
-    MirrorRow(src_bot, dst, width);  // Mirror bottom row into top row
-    MirrorRow(row, dst_bot, width);  // Mirror buffer into bottom row
+    RotateRow180(src, src_bot, dst, dst_bot, width, 1, MirrorRow, CopyRow);
     src += src_stride;
     dst += dst_stride;
     src_bot -= src_stride;
     dst_bot -= dst_stride;
   }
-  free_aligned_buffer_64(row);
 }
 
 LIBYUV_API
@@ -523,9 +477,28 @@ static void TransposePlane_16(const uint16_t* src,
                               int width,
                               int height) {
   int i = height;
+  void (*TransposeWx8_16)(const uint16_t* src, int src_stride, uint16_t* dst,
+                          int dst_stride, int width) = TransposeWx8_16_C;
+#if defined(HAS_TRANSPOSEWX8_16_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    TransposeWx8_16 = TransposeWx8_16_Any_SSE2;
+    if (IS_ALIGNED(width, 8)) {
+      TransposeWx8_16 = TransposeWx8_16_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_TRANSPOSEWX8_16_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    TransposeWx8_16 = TransposeWx8_16_Any_AVX2;
+    if (IS_ALIGNED(width, 16)) {
+      TransposeWx8_16 = TransposeWx8_16_AVX2;
+    }
+  }
+#endif
+
   // Work across the source in 8x8 tiles
   while (i >= 8) {
-    TransposeWx8_16_C(src, src_stride, dst, dst_stride, width);
+    TransposeWx8_16(src, src_stride, dst, dst_stride, width);
     src += 8 * src_stride;  // Go down 8 rows.
     dst += 8;               // Move over 8 columns.
     i -= 8;
@@ -564,6 +537,15 @@ static void RotatePlane270_16(const uint16_t* src,
   TransposePlane_16(src, src_stride, dst, dst_stride, width, height);
 }
 
+// RotateRow180 adapters for the 16 bit C row functions.
+static void MirrorRow_16_Bytes(const uint8_t* src, uint8_t* dst, int width) {
+  MirrorRow_16_C((const uint16_t*)src, (uint16_t*)dst, width);
+}
+
+static void CopyRow_16_Bytes(const uint8_t* src, uint8_t* dst, int count) {
+  CopyRow_16_C((const uint16_t*)src, (uint16_t*)dst, count / 2);
+}
+
 static void RotatePlane180_16(const uint16_t* src,
                               int src_stride,
                               uint16_t* dst,
@@ -575,24 +557,16 @@ static void RotatePlane180_16(const uint16_t* src,
   int half_height = (height + 1) >> 1;
   int y;
 
-  // Swap top and bottom row and mirror the content. Uses a temporary row.
-  align_buffer_64(row, width * 2);
-  uint16_t* row_tmp = (uint16_t*)row;
-  assert(row);
-  if (!row)
-    return;
-
-  // Odd height will harmlessly mirror the middle row twice.
+  // Swap top and bottom row and mirror the content.
   for (y = 0; y < half_height; ++y) {
-    CopyRow_16_C(src, row_tmp, width);        // Copy top row into buffer
-    MirrorRow_16_C(src_bot, dst, width);      // Mirror bottom row into top row
-    MirrorRow_16_C(row_tmp, dst_bot, width);  // Mirror buffer into bottom row
+    RotateRow180((const uint8_t*)src, (const uint8_t*)src_bot, (uint8_t*)dst,
+                 (uint8_t*)dst_bot, width, 2, MirrorRow_16_Bytes,
+                 CopyRow_16_Bytes);
     src += src_stride;
     dst += dst_stride;
     src_bot -= src_stride;
     dst_bot -= dst_stride;
   }
-  free_aligned_buffer_64(row);
 }
 
 LIBYUV_API
@@ -920,6 +894,123 @@ int NV12ToI420Rotate(const uint8_t* src_y,
   return -1;
 }
 
+// The UV plane is rotated as a plane of 16 bit UV pairs so the chroma stays
+// interleaved.  UV strides must be even.
+LIBYUV_API
+int NV12Rotate(const uint8_t* src_y,
+               int src_stride_y,
+               const uint8_t* src_uv,
+               int src_stride_uv,
+               uint8_t* dst_y,
+               int dst_stride_y,
+               uint8_t* dst_uv,
+               int dst_stride_uv,
+               int width,
+               int height,
+               enum RotationMode mode) {
+  int halfwidth = (width + 1) >> 1;
+  int halfheight = (height + 1) >> 1;
+  if (!src_y || !src_uv || width <= 0 || height == 0 || height == INT_MIN ||
+      !dst_y || !dst_uv || (src_stride_uv & 1) || (dst_stride_uv & 1)) {
+    return -1;
+  }
+
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    halfheight = (height + 1) >> 1;
+    src_y = src_y + (ptrdiff_t)(height - 1) * src_stride_y;
+    src_uv = src_uv + (ptrdiff_t)(halfheight - 1) * src_stride_uv;
+    src_stride_y = -src_stride_y;
+    src_stride_uv = -src_stride_uv;
+  }
+
+  switch (mode) {
+    case kRotate0:
+      // copy frame
+      return NV12Copy(src_y, src_stride_y, src_uv, src_stride_uv, dst_y,
+                      dst_stride_y, dst_uv, dst_stride_uv, width, height);
+    case kRotate90:
+      RotatePlane90(src_y, src_stride_y, dst_y, dst_stride_y, width, height);
+      RotatePlane90_16((const uint16_t*)src_uv, src_stride_uv / 2,
+                       (uint16_t*)dst_uv, dst_stride_uv / 2, halfwidth,
+                       halfheight);
+      return 0;
+    case kRotate270:
+      RotatePlane270(src_y, src_stride_y, dst_y, dst_stride_y, width, height);
+      RotatePlane270_16((const uint16_t*)src_uv, src_stride_uv / 2,
+                        (uint16_t*)dst_uv, dst_stride_uv / 2, halfwidth,
+                        halfheight);
+      return 0;
+    case kRotate180:
+      RotatePlane180(src_y, src_stride_y, dst_y, dst_stride_y, width, height);
+      RotatePlane180_16((const uint16_t*)src_uv, src_stride_uv / 2,
+                        (uint16_t*)dst_uv, dst_stride_uv / 2, halfwidth,
+                        halfheight);
+      return 0;
+    default:
+      break;
+  }
+  return -1;
+}
+
+// Each P010 UV pair is 32 bits, so the UV plane is rotated with the ARGB
+// rotators.
+LIBYUV_API
+int P010Rotate(const uint16_t* src_y,
+               int src_stride_y,
+               const uint16_t* src_uv,
+               int src_stride_uv,
+               uint16_t* dst_y,
+               int dst_stride_y,
+               uint16_t* dst_uv,
+               int dst_stride_uv,
+               int width,
+               int height,
+               enum RotationMode mode) {
+  int halfwidth = (width + 1) >> 1;
+  int halfheight = (height + 1) >> 1;
+  if (!src_y || !src_uv || width <= 0 || height == 0 || height == INT_MIN ||
+      !dst_y || !dst_uv) {
+    return -1;
+  }
+
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    halfheight = (height + 1) >> 1;
+    src_y = src_y + (ptrdiff_t)(height - 1) * src_stride_y;
+    src_uv = src_uv + (ptrdiff_t)(halfheight - 1) * src_stride_uv;
+    src_stride_y = -src_stride_y;
+    src_stride_uv = -src_stride_uv;
+  }
+
+  switch (mode) {
+    case kRotate0:
+      // copy frame
+      CopyPlane_16(src_y, src_stride_y, dst_y, dst_stride_y, width, height);
+      CopyPlane_16(src_uv, src_stride_uv, dst_uv, dst_stride_uv, halfwidth * 2,
+                   halfheight);
+      return 0;
+    case kRotate90:
+      RotatePlane90_16(src_y, src_stride_y, dst_y, dst_stride_y, width, height);
+      break;
+    case kRotate270:
+      RotatePlane270_16(src_y, src_stride_y, dst_y, dst_stride_y, width,
+                        height);
+      break;
+    case kRotate180:
+      RotatePlane180_16(src_y, src_stride_y, dst_y, dst_stride_y, width,
+                        height);
+      break;
+    default:
+      return -1;
+  }
+  return ARGBRotate((const uint8_t*)src_uv, src_stride_uv * 2,
+                    (uint8_t*)dst_uv, dst_stride_uv * 2, halfwidth, halfheight,
+                    mode);
+}
+
 static void SplitPixels(const uint8_t* src_u,
                         int src_pixel_stride_uv,
                         uint8_t* dst_u,
@@ -46,6 +46,26 @@ TANY(TransposeWx16_Any_LSX, TransposeWx16_LSX, TransposeWx16_C, 15)
 #endif
 #undef TANY
 
+// Same as TANY for 16 bit elements.  Strides are in elements.
+#define TANY16(NAMEANY, TPOS_SIMD, TPOS_C, MASK)                      \
+  void NAMEANY(const uint16_t* src, int src_stride, uint16_t* dst,    \
+               int dst_stride, int width) {                           \
+    int r = width & MASK;                                             \
+    int n = width - r;                                                \
+    if (n > 0) {                                                      \
+      TPOS_SIMD(src, src_stride, dst, dst_stride, n);                 \
+    }                                                                 \
+    TPOS_C(src + n, src_stride, dst + n * dst_stride, dst_stride, r); \
+  }
+
+#ifdef HAS_TRANSPOSEWX8_16_SSE2
+TANY16(TransposeWx8_16_Any_SSE2, TransposeWx8_16_SSE2, TransposeWx8_16_C, 7)
+#endif
+#ifdef HAS_TRANSPOSEWX8_16_AVX2
+TANY16(TransposeWx8_16_Any_AVX2, TransposeWx8_16_AVX2, TransposeWx8_16_C, 15)
+#endif
+#undef TANY16
+
 #define TUVANY(NAMEANY, TPOS_SIMD, MASK)                                       \
   void NAMEANY(const uint8_t* src, int src_stride, uint8_t* dst_a,             \
                int dst_stride_a, uint8_t* dst_b, int dst_stride_b,             \
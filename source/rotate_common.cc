@@ -202,6 +202,52 @@ void Transpose4x4_32_C(const uint8_t* src,
   }
 }
 
+// Rotate a pair of rows by 180 degrees: the mirror of src_bot goes to dst_top
+// and the mirror of src_top goes to dst_bot.  The top row is staged through a
+// fixed stack chunk instead of a heap row, so the 180 degree rotators do not
+// allocate.  width is in pixels of bpp bytes.  src_top may equal src_bot for
+// the middle row of an odd height, and src may equal dst (in place).
+void RotateRow180(
+    const uint8_t* src_top,
+    const uint8_t* src_bot,
+    uint8_t* dst_top,
+    uint8_t* dst_bot,
+    int width,
+    int bpp,
+    void (*MirrorRow)(const uint8_t* src, uint8_t* dst, int width),
+    void (*CopyRow)(const uint8_t* src, uint8_t* dst, int count)) {
+  SIMD_ALIGNED(uint8_t chunk[kRotateChunkBytes * 2]);
+  const int chunk_width = kRotateChunkBytes / bpp;
+  int x;
+  if (src_top == src_bot && src_top == dst_top) {
+    // Middle row in place.  Swap mirrored chunks from both ends inwards, then
+    // mirror what is left in the centre through the chunk in one go.
+    for (x = 0; width - 2 * x >= 2 * chunk_width; x += chunk_width) {
+      const uint8_t* left = src_top + (ptrdiff_t)x * bpp;
+      const uint8_t* right =
+          src_top + (ptrdiff_t)(width - x - chunk_width) * bpp;
+      CopyRow(left, chunk, chunk_width * bpp);
+      MirrorRow(right, dst_top + (ptrdiff_t)x * bpp, chunk_width);
+      MirrorRow(chunk, dst_top + (ptrdiff_t)(width - x - chunk_width) * bpp,
+                chunk_width);
+    }
+    if (width - 2 * x > 0) {
+      CopyRow(src_top + (ptrdiff_t)x * bpp, chunk, (width - 2 * x) * bpp);
+      MirrorRow(chunk, dst_top + (ptrdiff_t)x * bpp, width - 2 * x);
+    }
+    return;
+  }
+  // Distinct rows.  Chunk x of the top row only overlaps chunk x of the
+  // destination top row, which is written after it has been staged.
+  for (x = 0; x < width; x += chunk_width) {
+    int n = width - x < chunk_width ? width - x : chunk_width;
+    CopyRow(src_top + (ptrdiff_t)x * bpp, chunk, n * bpp);
+    MirrorRow(src_bot + (ptrdiff_t)(width - x - n) * bpp,
+              dst_top + (ptrdiff_t)x * bpp, n);
+    MirrorRow(chunk, dst_bot + (ptrdiff_t)(width - x - n) * bpp, n);
+  }
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
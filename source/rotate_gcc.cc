@@ -368,6 +368,190 @@ void TransposeUVWx8_SSE2(const uint8_t* src,
 }
 #endif  // defined(HAS_TRANSPOSEUVWX8_SSE2)
 
+#if defined(HAS_TRANSPOSEWX8_16_SSE2)
+// Transpose 8x8 16 bit values.  Strides are in elements.  64 bit.
+void TransposeWx8_16_SSE2(const uint16_t* src,
+                          int src_stride,
+                          uint16_t* dst,
+                          int dst_stride,
+                          int width) {
+  asm volatile(
+      // Read in the data from the source pointer.
+      // First round of word swap.
+      LABELALIGN
+      "1:          \n"
+      "movdqu      (%0),%%xmm0                   \n"
+      "movdqu      (%0,%3),%%xmm1                \n"
+      "lea         (%0,%3,2),%0                  \n"
+      "movdqu      (%0),%%xmm2                   \n"
+      "movdqu      (%0,%3),%%xmm3                \n"
+      "lea         (%0,%3,2),%0                  \n"
+      "movdqu      (%0),%%xmm4                   \n"
+      "movdqu      (%0,%3),%%xmm5                \n"
+      "lea         (%0,%3,2),%0                  \n"
+      "movdqu      (%0),%%xmm6                   \n"
+      "movdqu      (%0,%3),%%xmm7                \n"
+      "lea         (%0,%3,2),%0                  \n"
+      "neg         %3                            \n"
+      "lea         0x10(%0,%3,8),%0              \n"
+      "neg         %3                            \n"
+      "movdqa      %%xmm0,%%xmm8                 \n"
+      "punpcklwd   %%xmm1,%%xmm0                 \n"
+      "punpckhwd   %%xmm1,%%xmm8                 \n"
+      "movdqa      %%xmm2,%%xmm9                 \n"
+      "punpcklwd   %%xmm3,%%xmm2                 \n"
+      "punpckhwd   %%xmm3,%%xmm9                 \n"
+      "movdqa      %%xmm4,%%xmm10                \n"
+      "punpcklwd   %%xmm5,%%xmm4                 \n"
+      "punpckhwd   %%xmm5,%%xmm10                \n"
+      "movdqa      %%xmm6,%%xmm11                \n"
+      "punpcklwd   %%xmm7,%%xmm6                 \n"
+      "punpckhwd   %%xmm7,%%xmm11                \n"
+      // Second round of dword swap.
+      "movdqa      %%xmm0,%%xmm1                 \n"
+      "punpckldq   %%xmm2,%%xmm0                 \n"
+      "punpckhdq   %%xmm2,%%xmm1                 \n"
+      "movdqa      %%xmm8,%%xmm3                 \n"
+      "punpckldq   %%xmm9,%%xmm8                 \n"
+      "punpckhdq   %%xmm9,%%xmm3                 \n"
+      "movdqa      %%xmm4,%%xmm5                 \n"
+      "punpckldq   %%xmm6,%%xmm4                 \n"
+      "punpckhdq   %%xmm6,%%xmm5                 \n"
+      "movdqa      %%xmm10,%%xmm7                \n"
+      "punpckldq   %%xmm11,%%xmm10               \n"
+      "punpckhdq   %%xmm11,%%xmm7                \n"
+      // Third round of qword swap.
+      // Write to the destination pointer.
+      "movdqa      %%xmm0,%%xmm2                 \n"
+      "punpcklqdq  %%xmm4,%%xmm0                 \n"
+      "punpckhqdq  %%xmm4,%%xmm2                 \n"
+      "movdqu      %%xmm0,(%1)                   \n"
+      "movdqu      %%xmm2,(%1,%4)                \n"
+      "lea         (%1,%4,2),%1                  \n"
+      "movdqa      %%xmm1,%%xmm6                 \n"
+      "punpcklqdq  %%xmm5,%%xmm1                 \n"
+      "punpckhqdq  %%xmm5,%%xmm6                 \n"
+      "movdqu      %%xmm1,(%1)                   \n"
+      "movdqu      %%xmm6,(%1,%4)                \n"
+      "lea         (%1,%4,2),%1                  \n"
+      "movdqa      %%xmm8,%%xmm9                 \n"
+      "punpcklqdq  %%xmm10,%%xmm8                \n"
+      "punpckhqdq  %%xmm10,%%xmm9                \n"
+      "movdqu      %%xmm8,(%1)                   \n"
+      "movdqu      %%xmm9,(%1,%4)                \n"
+      "lea         (%1,%4,2),%1                  \n"
+      "movdqa      %%xmm3,%%xmm11                \n"
+      "punpcklqdq  %%xmm7,%%xmm3                 \n"
+      "punpckhqdq  %%xmm7,%%xmm11                \n"
+      "movdqu      %%xmm3,(%1)                   \n"
+      "movdqu      %%xmm11,(%1,%4)               \n"
+      "lea         (%1,%4,2),%1                  \n"
+      "sub         $0x8,%2                       \n"
+      "jg          1b                            \n"
+      : "+r"(src),                       // %0
+        "+r"(dst),                       // %1
+        "+r"(width)                      // %2
+      : "r"((ptrdiff_t)(src_stride)*2),  // %3
+        "r"((ptrdiff_t)(dst_stride)*2)   // %4
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9", "xmm10", "xmm11");
+}
+#endif  // defined(HAS_TRANSPOSEWX8_16_SSE2)
+
+#if defined(HAS_TRANSPOSEWX8_16_AVX2)
+// Transpose 8x16 16 bit values.  Each 16 byte lane holds 8
+// columns, transposed the same way as TransposeWx8_16_SSE2.  Strides are in
+// elements.
+void TransposeWx8_16_AVX2(const uint16_t* src,
+                          int src_stride,
+                          uint16_t* dst,
+                          int dst_stride,
+                          int width) {
+  asm volatile(
+      // Read in the data from the source pointer.
+      LABELALIGN
+      "1:          \n"
+      "vmovdqu     (%0),%%ymm0                   \n"
+      "vmovdqu     (%0,%3),%%ymm1                \n"
+      "lea         (%0,%3,2),%0                  \n"
+      "vmovdqu     (%0),%%ymm2                   \n"
+      "vmovdqu     (%0,%3),%%ymm3                \n"
+      "lea         (%0,%3,2),%0                  \n"
+      "vmovdqu     (%0),%%ymm4                   \n"
+      "vmovdqu     (%0,%3),%%ymm5                \n"
+      "lea         (%0,%3,2),%0                  \n"
+      "vmovdqu     (%0),%%ymm6                   \n"
+      "vmovdqu     (%0,%3),%%ymm7                \n"
+      "lea         (%0,%3,2),%0                  \n"
+      "neg         %3                            \n"
+      "lea         0x20(%0,%3,8),%0              \n"
+      "neg         %3                            \n"
+      // First round of word swap.
+      "vpunpcklwd  %%ymm1,%%ymm0,%%ymm8          \n"
+      "vpunpckhwd  %%ymm1,%%ymm0,%%ymm9          \n"
+      "vpunpcklwd  %%ymm3,%%ymm2,%%ymm10         \n"
+      "vpunpckhwd  %%ymm3,%%ymm2,%%ymm11         \n"
+      "vpunpcklwd  %%ymm5,%%ymm4,%%ymm12         \n"
+      "vpunpckhwd  %%ymm5,%%ymm4,%%ymm13         \n"
+      "vpunpcklwd  %%ymm7,%%ymm6,%%ymm14         \n"
+      "vpunpckhwd  %%ymm7,%%ymm6,%%ymm15         \n"
+      // Second round of dword swap.
+      "vpunpckldq  %%ymm10,%%ymm8,%%ymm0         \n"
+      "vpunpckhdq  %%ymm10,%%ymm8,%%ymm1         \n"
+      "vpunpckldq  %%ymm11,%%ymm9,%%ymm2         \n"
+      "vpunpckhdq  %%ymm11,%%ymm9,%%ymm3         \n"
+      "vpunpckldq  %%ymm14,%%ymm12,%%ymm4        \n"
+      "vpunpckhdq  %%ymm14,%%ymm12,%%ymm5        \n"
+      "vpunpckldq  %%ymm15,%%ymm13,%%ymm6        \n"
+      "vpunpckhdq  %%ymm15,%%ymm13,%%ymm7        \n"
+      // Third round of qword swap.
+      "vpunpcklqdq %%ymm4,%%ymm0,%%ymm8          \n"
+      "vpunpckhqdq %%ymm4,%%ymm0,%%ymm9          \n"
+      "vpunpcklqdq %%ymm5,%%ymm1,%%ymm10         \n"
+      "vpunpckhqdq %%ymm5,%%ymm1,%%ymm11         \n"
+      "vpunpcklqdq %%ymm6,%%ymm2,%%ymm12         \n"
+      "vpunpckhqdq %%ymm6,%%ymm2,%%ymm13         \n"
+      "vpunpcklqdq %%ymm7,%%ymm3,%%ymm14         \n"
+      "vpunpckhqdq %%ymm7,%%ymm3,%%ymm15         \n"
+      // Write lane 0 to the first 8 destination rows, then the other lanes.
+      "vmovdqu     %%xmm8,(%1)                   \n"
+      "vmovdqu     %%xmm9,(%1,%4)                \n"
+      "lea         (%1,%4,2),%1                  \n"
+      "vmovdqu     %%xmm10,(%1)                  \n"
+      "vmovdqu     %%xmm11,(%1,%4)               \n"
+      "lea         (%1,%4,2),%1                  \n"
+      "vmovdqu     %%xmm12,(%1)                  \n"
+      "vmovdqu     %%xmm13,(%1,%4)               \n"
+      "lea         (%1,%4,2),%1                  \n"
+      "vmovdqu     %%xmm14,(%1)                  \n"
+      "vmovdqu     %%xmm15,(%1,%4)               \n"
+      "lea         (%1,%4,2),%1                  \n"
+      "vextracti128 $1,%%ymm8,(%1)               \n"
+      "vextracti128 $1,%%ymm9,(%1,%4)            \n"
+      "lea         (%1,%4,2),%1                  \n"
+      "vextracti128 $1,%%ymm10,(%1)              \n"
+      "vextracti128 $1,%%ymm11,(%1,%4)           \n"
+      "lea         (%1,%4,2),%1                  \n"
+      "vextracti128 $1,%%ymm12,(%1)              \n"
+      "vextracti128 $1,%%ymm13,(%1,%4)           \n"
+      "lea         (%1,%4,2),%1                  \n"
+      "vextracti128 $1,%%ymm14,(%1)              \n"
+      "vextracti128 $1,%%ymm15,(%1,%4)           \n"
+      "lea         (%1,%4,2),%1                  \n"
+      "sub         $0x10,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper  \n"
+      : "+r"(src),                       // %0
+        "+r"(dst),                       // %1
+        "+r"(width)                      // %2
+      : "r"((ptrdiff_t)(src_stride)*2),  // %3
+        "r"((ptrdiff_t)(dst_stride)*2)   // %4
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14",
+        "xmm15");
+}
+#endif  // defined(HAS_TRANSPOSEWX8_16_AVX2)
+
 #if defined(HAS_TRANSPOSE4X4_32_SSE2)
 // 4 values, little endian view
 // a b c d
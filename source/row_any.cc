@@ -743,6 +743,9 @@ ANY21(SobelToPlaneRow_Any_LSX, SobelToPlaneRow_LSX, 0, 1, 1, 1, 31)
 #ifdef HAS_SOBELXYROW_SSE2
 ANY21(SobelXYRow_Any_SSE2, SobelXYRow_SSE2, 0, 1, 1, 4, 15)
 #endif
+#ifdef HAS_SOBELXYROW_AVX2
+ANY21(SobelXYRow_Any_AVX2, SobelXYRow_AVX2, 0, 1, 1, 4, 31)
+#endif
 #ifdef HAS_SOBELXYROW_NEON
 ANY21(SobelXYRow_Any_NEON, SobelXYRow_NEON, 0, 1, 1, 4, 7)
 #endif
@@ -2543,6 +2546,145 @@ ANYDETILEMERGE(DetileToYUY2_Any_NEON, DetileToYUY2_NEON, 15)
 ANYDETILEMERGE(DetileToYUY2_Any_SSE2, DetileToYUY2_SSE2, 15)
 #endif
 
+// Any affine row.  The remainder is done in C from the advanced position.
+#define ANYAFFINE(NAMEANY, ANY_SIMD, ANY_C, MASK)                     \
+  void NAMEANY(const uint8_t* src_argb, int src_argb_stride,          \
+               uint8_t* dst_argb, const float* uv_dudv, int width) {  \
+    float uv[4];                                                      \
+    int r = width & MASK;                                             \
+    int n = width & ~MASK;                                            \
+    if (n > 0) {                                                      \
+      ANY_SIMD(src_argb, src_argb_stride, dst_argb, uv_dudv, n);      \
+    }                                                                 \
+    uv[0] = uv_dudv[0] + uv_dudv[2] * n;                              \
+    uv[1] = uv_dudv[1] + uv_dudv[3] * n;                              \
+    uv[2] = uv_dudv[2];                                               \
+    uv[3] = uv_dudv[3];                                               \
+    ANY_C(src_argb, src_argb_stride, dst_argb + n * 4, uv, r);        \
+  }
+
+#ifdef HAS_ARGBAFFINEROW_AVX2
+ANYAFFINE(ARGBAffineRow_Any_AVX2, ARGBAffineRow_AVX2, ARGBAffineRow_C, 7)
+#endif
+#ifdef HAS_ARGBAFFINEROW_AVX512BW
+ANYAFFINE(ARGBAffineRow_Any_AVX512BW,
+          ARGBAffineRow_AVX512BW,
+          ARGBAffineRow_C,
+          15)
+#endif
+#ifdef HAS_ARGBAFFINEFILTERROW_AVX2
+ANYAFFINE(ARGBAffineFilterRow_Any_AVX2,
+          ARGBAffineFilterRow_AVX2,
+          ARGBAffineFilterRow_C,
+          7)
+#endif
+#undef ANYAFFINE
+
+// Any 5 rows to 1 for the Gauss column filter.
+#define ANYGAUSSCOL(NAMEANY, ANY_SIMD, STYPE, DTYPE, MASK)                  \
+  void NAMEANY(const STYPE* src0, const STYPE* src1, const STYPE* src2,     \
+               const STYPE* src3, const STYPE* src4, DTYPE* dst,            \
+               int width) {                                                 \
+    SIMD_ALIGNED(STYPE vin[(MASK + 1) * 5]);                                \
+    SIMD_ALIGNED(DTYPE vout[MASK + 1]);                                     \
+    memset(vin, 0, sizeof(vin)); /* for msan */                             \
+    int r = width & MASK;                                                   \
+    int n = width & ~MASK;                                                  \
+    if (n > 0) {                                                            \
+      ANY_SIMD(src0, src1, src2, src3, src4, dst, n);                       \
+    }                                                                       \
+    ptrdiff_t np = n;                                                       \
+    memcpy(vin, src0 + np, r * sizeof(STYPE));                              \
+    memcpy(vin + (MASK + 1), src1 + np, r * sizeof(STYPE));                 \
+    memcpy(vin + (MASK + 1) * 2, src2 + np, r * sizeof(STYPE));             \
+    memcpy(vin + (MASK + 1) * 3, src3 + np, r * sizeof(STYPE));             \
+    memcpy(vin + (MASK + 1) * 4, src4 + np, r * sizeof(STYPE));             \
+    ANY_SIMD(vin, vin + (MASK + 1), vin + (MASK + 1) * 2,                   \
+             vin + (MASK + 1) * 3, vin + (MASK + 1) * 4, vout, MASK + 1);   \
+    memcpy(dst + np, vout, r * sizeof(DTYPE));                              \
+  }
+
+#ifdef HAS_GAUSSCOL_F32_AVX2
+ANYGAUSSCOL(GaussCol_F32_Any_AVX2, GaussCol_F32_AVX2, float, float, 15)
+#endif
+#ifdef HAS_GAUSSCOL_F32_AVX512BW
+ANYGAUSSCOL(GaussCol_F32_Any_AVX512BW,
+            GaussCol_F32_AVX512BW,
+            float,
+            float,
+            31)
+#endif
+#ifdef HAS_GAUSSCOL_AVX2
+ANYGAUSSCOL(GaussCol_Any_AVX2, GaussCol_AVX2, uint16_t, uint32_t, 15)
+#endif
+#ifdef HAS_GAUSSCOL_8_AVX2
+ANYGAUSSCOL(GaussCol_8_Any_AVX2, GaussCol_8_AVX2, uint8_t, uint16_t, 31)
+#endif
+#undef ANYGAUSSCOL
+
+// Any 1 to 1 for the Gauss row filter.  Reads 4 source values past width.
+#define ANYGAUSSROW(NAMEANY, ANY_SIMD, STYPE, DTYPE, MASK)                  \
+  void NAMEANY(const STYPE* src_ptr, DTYPE* dst_ptr, int width) {           \
+    SIMD_ALIGNED(STYPE vin[MASK + 1 + 4]);                                  \
+    SIMD_ALIGNED(DTYPE vout[MASK + 1]);                                     \
+    memset(vin, 0, sizeof(vin)); /* for msan */                             \
+    int r = width & MASK;                                                   \
+    int n = width & ~MASK;                                                  \
+    if (n > 0) {                                                            \
+      ANY_SIMD(src_ptr, dst_ptr, n);                                        \
+    }                                                                       \
+    ptrdiff_t np = n;                                                       \
+    memcpy(vin, src_ptr + np, (r + 4) * sizeof(STYPE));                     \
+    ANY_SIMD(vin, vout, MASK + 1);                                          \
+    memcpy(dst_ptr + np, vout, r * sizeof(DTYPE));                          \
+  }
+
+#ifdef HAS_GAUSSROW_F32_AVX2
+ANYGAUSSROW(GaussRow_F32_Any_AVX2, GaussRow_F32_AVX2, float, float, 15)
+#endif
+#ifdef HAS_GAUSSROW_F32_AVX512BW
+ANYGAUSSROW(GaussRow_F32_Any_AVX512BW,
+            GaussRow_F32_AVX512BW,
+            float,
+            float,
+            31)
+#endif
+#ifdef HAS_GAUSSROW_AVX2
+ANYGAUSSROW(GaussRow_Any_AVX2, GaussRow_AVX2, uint32_t, uint16_t, 15)
+#endif
+#ifdef HAS_GAUSSROW_8_AVX2
+ANYGAUSSROW(GaussRow_8_Any_AVX2, GaussRow_8_AVX2, uint16_t, uint8_t, 31)
+#endif
+#undef ANYGAUSSROW
+
+// Any 3 rows to 1 for the fused Sobel.  Reads 2 source pixels past width.
+#define ANYSOBEL(NAMEANY, ANY_SIMD, MASK)                                    \
+  void NAMEANY(const uint8_t* src_y0, const uint8_t* src_y1,                 \
+               const uint8_t* src_y2, uint8_t* dst_y, int width) {           \
+    SIMD_ALIGNED(uint8_t vin[(MASK + 3) * 3]);                               \
+    SIMD_ALIGNED(uint8_t vout[MASK + 1]);                                    \
+    memset(vin, 0, sizeof(vin)); /* for msan */                              \
+    int r = width & MASK;                                                    \
+    int n = width & ~MASK;                                                   \
+    if (n > 0) {                                                             \
+      ANY_SIMD(src_y0, src_y1, src_y2, dst_y, n);                            \
+    }                                                                        \
+    ptrdiff_t np = n;                                                        \
+    memcpy(vin, src_y0 + np, r + 2);                                         \
+    memcpy(vin + (MASK + 3), src_y1 + np, r + 2);                            \
+    memcpy(vin + (MASK + 3) * 2, src_y2 + np, r + 2);                        \
+    ANY_SIMD(vin, vin + (MASK + 3), vin + (MASK + 3) * 2, vout, MASK + 1);   \
+    memcpy(dst_y + np, vout, r);                                             \
+  }
+
+#ifdef HAS_SOBELPLANEROW_AVX2
+ANYSOBEL(SobelPlaneRow_Any_AVX2, SobelPlaneRow_AVX2, 31)
+#endif
+#ifdef HAS_SOBELPLANEROW_AVX512BW
+ANYSOBEL(SobelPlaneRow_Any_AVX512BW, SobelPlaneRow_AVX512BW, 31)
+#endif
+#undef ANYSOBEL
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
@@ -1417,6 +1417,25 @@ void SobelXYRow_C(const uint8_t* src_sobelx,
   }
 }
 
+// Sobel X and Sobel Y of a 3 row window, added with saturation.
+// Matches SobelXRow + SobelYRow + SobelToPlaneRow in a single pass.
+void SobelPlaneRow_C(const uint8_t* src_y0,
+                     const uint8_t* src_y1,
+                     const uint8_t* src_y2,
+                     uint8_t* dst_y,
+                     int width) {
+  int i;
+  for (i = 0; i < width; ++i) {
+    int sobelx = Abs((src_y0[i] - src_y0[i + 2]) +
+                     (src_y1[i] - src_y1[i + 2]) * 2 +
+                     (src_y2[i] - src_y2[i + 2]));
+    int sobely = Abs((src_y0[i] - src_y2[i]) +
+                     (src_y0[i + 1] - src_y2[i + 1]) * 2 +
+                     (src_y0[i + 2] - src_y2[i + 2]));
+    dst_y[i] = (uint8_t)(clamp255(clamp255(sobelx) + clamp255(sobely)));
+  }
+}
+
 void J400ToARGBRow_C(const uint8_t* src_y, uint8_t* dst_argb, int width) {
   // Copy a Y to RGB.
   int x;
@@ -3571,21 +3590,21 @@ void ARGBUnattenuateRow_C(const uint8_t* src_argb,
   }
 }
 
+// Sums are accumulated unsigned so that tables of large images wrap instead
+// of overflowing.  Differences of wrapped sums are still exact.
 void ComputeCumulativeSumRow_C(const uint8_t* row,
                                int32_t* cumsum,
                                const int32_t* previous_cumsum,
                                int width) {
-  int32_t row_sum[4] = {0, 0, 0, 0};
+  uint32_t row_sum[4] = {0, 0, 0, 0};
   int x;
+  int c;
   for (x = 0; x < width; ++x) {
-    row_sum[0] += row[x * 4 + 0];
-    row_sum[1] += row[x * 4 + 1];
-    row_sum[2] += row[x * 4 + 2];
-    row_sum[3] += row[x * 4 + 3];
-    cumsum[x * 4 + 0] = row_sum[0] + previous_cumsum[x * 4 + 0];
-    cumsum[x * 4 + 1] = row_sum[1] + previous_cumsum[x * 4 + 1];
-    cumsum[x * 4 + 2] = row_sum[2] + previous_cumsum[x * 4 + 2];
-    cumsum[x * 4 + 3] = row_sum[3] + previous_cumsum[x * 4 + 3];
+    for (c = 0; c < 4; ++c) {
+      row_sum[c] += row[x * 4 + c];
+      cumsum[x * 4 + c] =
+          (int32_t)(row_sum[c] + (uint32_t)previous_cumsum[x * 4 + c]);
+    }
   }
 }
 
@@ -3597,28 +3616,46 @@ void CumulativeSumToAverageRow_C(const int32_t* tl,
                                  int count) {
   float ooa;
   int i;
+  int c;
   assert(area != 0);
 
   ooa = 1.0f / STATIC_CAST(float, area);
   for (i = 0; i < count; ++i) {
-    dst[0] =
-        (uint8_t)(STATIC_CAST(float, bl[w + 0] + tl[0] - bl[0] - tl[w + 0]) *
-                  ooa);
-    dst[1] =
-        (uint8_t)(STATIC_CAST(float, bl[w + 1] + tl[1] - bl[1] - tl[w + 1]) *
-                  ooa);
-    dst[2] =
-        (uint8_t)(STATIC_CAST(float, bl[w + 2] + tl[2] - bl[2] - tl[w + 2]) *
-                  ooa);
-    dst[3] =
-        (uint8_t)(STATIC_CAST(float, bl[w + 3] + tl[3] - bl[3] - tl[w + 3]) *
-                  ooa);
+    for (c = 0; c < 4; ++c) {
+      int32_t sum = (int32_t)((uint32_t)bl[w + c] + (uint32_t)tl[c] -
+                              (uint32_t)bl[c] - (uint32_t)tl[w + c]);
+      dst[c] = (uint8_t)(STATIC_CAST(float, sum) * ooa);
+    }
     dst += 4;
     tl += 4;
     bl += 4;
   }
 }
 
+void IntegralRow_C(const uint8_t* src,
+                   uint32_t* dst,
+                   const uint32_t* previous,
+                   int width) {
+  uint32_t row_sum = 0;
+  int x;
+  for (x = 0; x < width; ++x) {
+    row_sum += src[x];
+    dst[x] = row_sum + previous[x];
+  }
+}
+
+void IntegralSquaredRow_C(const uint8_t* src,
+                          uint32_t* dst,
+                          const uint32_t* previous,
+                          int width) {
+  uint32_t row_sum = 0;
+  int x;
+  for (x = 0; x < width; ++x) {
+    row_sum += (uint32_t)src[x] * src[x];
+    dst[x] = row_sum + previous[x];
+  }
+}
+
 // Copy pixels from rotated source to destination row with a slope.
 LIBYUV_API
 void ARGBAffineRow_C(const uint8_t* src_argb,
@@ -3643,6 +3680,39 @@ void ARGBAffineRow_C(const uint8_t* src_argb,
   }
 }
 
+// Copy bilinear filtered pixels from rotated source to destination row.
+// Fractions are 6 bit.  Pixels are blended horizontally then vertically,
+// rounding after each pass.
+LIBYUV_API
+void ARGBAffineFilterRow_C(const uint8_t* src_argb,
+                           int src_argb_stride,
+                           uint8_t* dst_argb,
+                           const float* uv_dudv,
+                           int width) {
+  int i, c;
+  float uv[2];
+  uv[0] = uv_dudv[0];
+  uv[1] = uv_dudv[1];
+  for (i = 0; i < width; ++i) {
+    int x = (int)(uv[0]);
+    int y = (int)(uv[1]);
+    int fx = (int)((uv[0] - (float)x) * 64.f);
+    int fy = (int)((uv[1] - (float)y) * 64.f);
+    const uint8_t* src =
+        src_argb + (ptrdiff_t)y * src_argb_stride + (ptrdiff_t)x * 4;
+    for (c = 0; c < 4; ++c) {
+      int t = (src[c] * (64 - fx) + src[c + 4] * fx + 32) >> 6;
+      int b = (src[src_argb_stride + c] * (64 - fx) +
+               src[src_argb_stride + c + 4] * fx + 32) >>
+              6;
+      dst_argb[c] = (uint8_t)((t * (64 - fy) + b * fy + 32) >> 6);
+    }
+    dst_argb += 4;
+    uv[0] += uv_dudv[2];
+    uv[1] += uv_dudv[3];
+  }
+}
+
 // Blend 2 rows into 1.
 static void HalfRow_C(const uint8_t* src_uv,
                       ptrdiff_t src_uv_stride,
@@ -4361,6 +4431,31 @@ void GaussCol_C(const uint16_t* src0,
   }
 }
 
+// 8 bit version of GaussRow_C.  Sums of GaussCol_8_C fit in 16 bits.
+void GaussRow_8_C(const uint16_t* src, uint8_t* dst, int width) {
+  int i;
+  for (i = 0; i < width; ++i) {
+    *dst++ = STATIC_CAST(
+        uint8_t,
+        (src[0] + src[1] * 4 + src[2] * 6 + src[3] * 4 + src[4] + 128) >> 8);
+    ++src;
+  }
+}
+
+// filter 5 rows of 8 bit with 1, 4, 6, 4, 1 coefficients to produce 1 row.
+void GaussCol_8_C(const uint8_t* src0,
+                  const uint8_t* src1,
+                  const uint8_t* src2,
+                  const uint8_t* src3,
+                  const uint8_t* src4,
+                  uint16_t* dst,
+                  int width) {
+  int i;
+  for (i = 0; i < width; ++i) {
+    *dst++ = *src0++ + *src1++ * 4 + *src2++ * 6 + *src3++ * 4 + *src4++;
+  }
+}
+
 void GaussRow_F32_C(const float* src, float* dst, int width) {
   int i;
   for (i = 0; i < width; ++i) {
@@ -0,0 +1,616 @@
+/*
+ *  Copyright 2026 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "libyuv/row_dispatch.h"
+
+#include <stdlib.h>
+
+#include "libyuv/cpu_id.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>  // For _InterlockedCompareExchange()
+#endif
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Detected cpu flags, from cpu_id.cc.
+LIBYUV_API extern int cpu_info_;
+
+// Kernels are listed from least to most preferred, as the per call
+// selection in the converters did, so the last supported one wins.
+#define SET_KERNEL(kernel, any_function, full_function, kernel_align) \
+  do {                                                                \
+    (kernel).any = (any_function);                                    \
+    (kernel).full = (full_function);                                  \
+    (kernel).align = (kernel_align);                                  \
+  } while (0)
+
+LIBYUV_API
+void ResolveRowDispatch(struct RowDispatch* dispatch, int cpu_info) {
+  // Flags are tested with a local copy so that a table can be resolved for
+  // flags other than the current ones.
+#define HAS_FLAG(flag) ((cpu_info & (flag)) == (flag))
+  (void)cpu_info;
+
+  SET_KERNEL(dispatch->I422ToARGBRow, I422ToARGBRow_C, I422ToARGBRow_C, 1);
+#if defined(HAS_I422TOARGBROW_SSSE3)
+  if (HAS_FLAG(kCpuHasSSSE3)) {
+    SET_KERNEL(dispatch->I422ToARGBRow, I422ToARGBRow_Any_SSSE3,
+               I422ToARGBRow_SSSE3, 8);
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_AVX2)
+  if (HAS_FLAG(kCpuHasAVX2)) {
+    SET_KERNEL(dispatch->I422ToARGBRow, I422ToARGBRow_Any_AVX2,
+               I422ToARGBRow_AVX2, 16);
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_AVX512BW)
+  if (HAS_FLAG(kCpuHasAVX512BW | kCpuHasAVX512VL)) {
+    SET_KERNEL(dispatch->I422ToARGBRow, I422ToARGBRow_Any_AVX512BW,
+               I422ToARGBRow_AVX512BW, 32);
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_NEON)
+  if (HAS_FLAG(kCpuHasNEON)) {
+    SET_KERNEL(dispatch->I422ToARGBRow, I422ToARGBRow_Any_NEON,
+               I422ToARGBRow_NEON, 8);
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_SVE2)
+  if (HAS_FLAG(kCpuHasSVE2)) {
+    SET_KERNEL(dispatch->I422ToARGBRow, I422ToARGBRow_SVE2,
+               I422ToARGBRow_SVE2, 1);
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_SME)
+  if (HAS_FLAG(kCpuHasSME)) {
+    SET_KERNEL(dispatch->I422ToARGBRow, I422ToARGBRow_SME, I422ToARGBRow_SME,
+               1);
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_LSX)
+  if (HAS_FLAG(kCpuHasLSX)) {
+    SET_KERNEL(dispatch->I422ToARGBRow, I422ToARGBRow_Any_LSX,
+               I422ToARGBRow_LSX, 16);
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_LASX)
+  if (HAS_FLAG(kCpuHasLASX)) {
+    SET_KERNEL(dispatch->I422ToARGBRow, I422ToARGBRow_Any_LASX,
+               I422ToARGBRow_LASX, 32);
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_RVV)
+  if (HAS_FLAG(kCpuHasRVV)) {
+    SET_KERNEL(dispatch->I422ToARGBRow, I422ToARGBRow_RVV, I422ToARGBRow_RVV,
+               1);
+  }
+#endif
+
+#if TRANSPOSE_TILE_ROWS == 16
+  SET_KERNEL(dispatch->TransposeWxN, TransposeWx16_C, TransposeWx16_C, 1);
+#else
+  SET_KERNEL(dispatch->TransposeWxN, TransposeWx8_C, TransposeWx8_C, 1);
+#endif
+  dispatch->TransposeWxH = NULL;
+#if defined(HAS_TRANSPOSEWX8_NEON) && TRANSPOSE_TILE_ROWS == 8
+  if (HAS_FLAG(kCpuHasNEON)) {
+    SET_KERNEL(dispatch->TransposeWxN, TransposeWx8_Any_NEON,
+               TransposeWx8_NEON, 8);
+  }
+#endif
+#if defined(HAS_TRANSPOSEWX16_NEON)
+  if (HAS_FLAG(kCpuHasNEON)) {
+    SET_KERNEL(dispatch->TransposeWxN, TransposeWx16_Any_NEON,
+               TransposeWx16_NEON, 16);
+  }
+#endif
+#if defined(HAS_TRANSPOSEWXH_SME)
+  if (HAS_FLAG(kCpuHasSME)) {
+    dispatch->TransposeWxH = TransposeWxH_SME;
+  }
+#endif
+#if defined(HAS_TRANSPOSEWX8_SSSE3)
+  if (HAS_FLAG(kCpuHasSSSE3)) {
+    SET_KERNEL(dispatch->TransposeWxN, TransposeWx8_Any_SSSE3,
+               TransposeWx8_SSSE3, 8);
+  }
+#endif
+#if defined(HAS_TRANSPOSEWX8_FAST_SSSE3)
+  if (HAS_FLAG(kCpuHasSSSE3)) {
+    SET_KERNEL(dispatch->TransposeWxN, TransposeWx8_Fast_Any_SSSE3,
+               TransposeWx8_Fast_SSSE3, 16);
+  }
+#endif
+#if defined(HAS_TRANSPOSEWX16_LSX)
+  if (HAS_FLAG(kCpuHasLSX)) {
+    SET_KERNEL(dispatch->TransposeWxN, TransposeWx16_Any_LSX,
+               TransposeWx16_LSX, 16);
+  }
+#endif
+
+  SET_KERNEL(dispatch->ScaleRowDown2[SCALEROWDOWN2_NONE], ScaleRowDown2_C,
+             ScaleRowDown2_C, 1);
+  SET_KERNEL(dispatch->ScaleRowDown2[SCALEROWDOWN2_LINEAR],
+             ScaleRowDown2Linear_C, ScaleRowDown2Linear_C, 1);
+  SET_KERNEL(dispatch->ScaleRowDown2[SCALEROWDOWN2_BOX], ScaleRowDown2Box_C,
+             ScaleRowDown2Box_C, 1);
+#if defined(HAS_SCALEROWDOWN2_NEON)
+  if (HAS_FLAG(kCpuHasNEON)) {
+    SET_KERNEL(dispatch->ScaleRowDown2[SCALEROWDOWN2_NONE],
+               ScaleRowDown2_Any_NEON, ScaleRowDown2_NEON, 16);
+    SET_KERNEL(dispatch->ScaleRowDown2[SCALEROWDOWN2_LINEAR],
+               ScaleRowDown2Linear_Any_NEON, ScaleRowDown2Linear_NEON, 16);
+    SET_KERNEL(dispatch->ScaleRowDown2[SCALEROWDOWN2_BOX],
+               ScaleRowDown2Box_Any_NEON, ScaleRowDown2Box_NEON, 16);
+  }
+#endif
+#if defined(HAS_SCALEROWDOWN2_SME)
+  if (HAS_FLAG(kCpuHasSME)) {
+    SET_KERNEL(dispatch->ScaleRowDown2[SCALEROWDOWN2_NONE], ScaleRowDown2_SME,
+               ScaleRowDown2_SME, 1);
+    SET_KERNEL(dispatch->ScaleRowDown2[SCALEROWDOWN2_LINEAR],
+               ScaleRowDown2Linear_SME, ScaleRowDown2Linear_SME, 1);
+    SET_KERNEL(dispatch->ScaleRowDown2[SCALEROWDOWN2_BOX],
+               ScaleRowDown2Box_SME, ScaleRowDown2Box_SME, 1);
+  }
+#endif
+#if defined(HAS_SCALEROWDOWN2_SSSE3)
+  if (HAS_FLAG(kCpuHasSSSE3)) {
+    SET_KERNEL(dispatch->ScaleRowDown2[SCALEROWDOWN2_NONE],
+               ScaleRowDown2_Any_SSSE3, ScaleRowDown2_SSSE3, 16);
+    SET_KERNEL(dispatch->ScaleRowDown2[SCALEROWDOWN2_LINEAR],
+               ScaleRowDown2Linear_Any_SSSE3, ScaleRowDown2Linear_SSSE3, 16);
+    SET_KERNEL(dispatch->ScaleRowDown2[SCALEROWDOWN2_BOX],
+               ScaleRowDown2Box_Any_SSSE3, ScaleRowDown2Box_SSSE3, 16);
+  }
+#endif
+#if defined(HAS_SCALEROWDOWN2_AVX2)
+  if (HAS_FLAG(kCpuHasAVX2)) {
+    SET_KERNEL(dispatch->ScaleRowDown2[SCALEROWDOWN2_NONE],
+               ScaleRowDown2_Any_AVX2, ScaleRowDown2_AVX2, 32);
+    SET_KERNEL(dispatch->ScaleRowDown2[SCALEROWDOWN2_LINEAR],
+               ScaleRowDown2Linear_Any_AVX2, ScaleRowDown2Linear_AVX2, 32);
+    SET_KERNEL(dispatch->ScaleRowDown2[SCALEROWDOWN2_BOX],
+               ScaleRowDown2Box_Any_AVX2, ScaleRowDown2Box_AVX2, 32);
+  }
+#endif
+#if defined(HAS_SCALEROWDOWN2_LSX)
+  if (HAS_FLAG(kCpuHasLSX)) {
+    SET_KERNEL(dispatch->ScaleRowDown2[SCALEROWDOWN2_NONE],
+               ScaleRowDown2_Any_LSX, ScaleRowDown2_LSX, 32);
+    SET_KERNEL(dispatch->ScaleRowDown2[SCALEROWDOWN2_LINEAR],
+               ScaleRowDown2Linear_Any_LSX, ScaleRowDown2Linear_LSX, 32);
+    SET_KERNEL(dispatch->ScaleRowDown2[SCALEROWDOWN2_BOX],
+               ScaleRowDown2Box_Any_LSX, ScaleRowDown2Box_LSX, 32);
+  }
+#endif
+#if defined(HAS_SCALEROWDOWN2_RVV)
+  if (HAS_FLAG(kCpuHasRVV)) {
+    SET_KERNEL(dispatch->ScaleRowDown2[SCALEROWDOWN2_NONE], ScaleRowDown2_RVV,
+               ScaleRowDown2_RVV, 1);
+    SET_KERNEL(dispatch->ScaleRowDown2[SCALEROWDOWN2_LINEAR],
+               ScaleRowDown2Linear_RVV, ScaleRowDown2Linear_RVV, 1);
+    SET_KERNEL(dispatch->ScaleRowDown2[SCALEROWDOWN2_BOX],
+               ScaleRowDown2Box_RVV, ScaleRowDown2Box_RVV, 1);
+  }
+#endif
+
+  SET_KERNEL(dispatch->InterpolateRow, InterpolateRow_C, InterpolateRow_C, 1);
+#if defined(HAS_INTERPOLATEROW_AVX2)
+  if (HAS_FLAG(kCpuHasAVX2)) {
+    SET_KERNEL(dispatch->InterpolateRow, InterpolateRow_Any_AVX2,
+               InterpolateRow_AVX2, 32);
+  }
+#endif
+#if defined(HAS_INTERPOLATEROW_NEON)
+  if (HAS_FLAG(kCpuHasNEON)) {
+    SET_KERNEL(dispatch->InterpolateRow, InterpolateRow_Any_NEON,
+               InterpolateRow_NEON, 16);
+  }
+#endif
+#if defined(HAS_INTERPOLATEROW_SVE2)
+  if (HAS_FLAG(kCpuHasSVE2)) {
+    SET_KERNEL(dispatch->InterpolateRow, InterpolateRow_SVE2,
+               InterpolateRow_SVE2, 1);
+  }
+#endif
+#if defined(HAS_INTERPOLATEROW_SME)
+  if (HAS_FLAG(kCpuHasSME)) {
+    SET_KERNEL(dispatch->InterpolateRow, InterpolateRow_SME,
+               InterpolateRow_SME, 1);
+  }
+#endif
+#if defined(HAS_INTERPOLATEROW_LSX)
+  if (HAS_FLAG(kCpuHasLSX)) {
+    SET_KERNEL(dispatch->InterpolateRow, InterpolateRow_Any_LSX,
+               InterpolateRow_LSX, 32);
+  }
+#endif
+#if defined(HAS_INTERPOLATEROW_RVV)
+  if (HAS_FLAG(kCpuHasRVV)) {
+    SET_KERNEL(dispatch->InterpolateRow, InterpolateRow_RVV,
+               InterpolateRow_RVV, 1);
+  }
+#endif
+
+  SET_KERNEL(dispatch->ScaleFilterCols, ScaleFilterCols_C, ScaleFilterCols_C,
+             1);
+#if defined(HAS_SCALEFILTERCOLS_SSSE3)
+  if (HAS_FLAG(kCpuHasSSSE3)) {
+    SET_KERNEL(dispatch->ScaleFilterCols, ScaleFilterCols_SSSE3,
+               ScaleFilterCols_SSSE3, 1);
+  }
+#endif
+#if defined(HAS_SCALEFILTERCOLS_NEON)
+  if (HAS_FLAG(kCpuHasNEON)) {
+    SET_KERNEL(dispatch->ScaleFilterCols, ScaleFilterCols_Any_NEON,
+               ScaleFilterCols_NEON, 8);
+  }
+#endif
+#if defined(HAS_SCALEFILTERCOLS_LSX)
+  if (HAS_FLAG(kCpuHasLSX)) {
+    SET_KERNEL(dispatch->ScaleFilterCols, ScaleFilterCols_Any_LSX,
+               ScaleFilterCols_LSX, 16);
+  }
+#endif
+
+  SET_KERNEL(dispatch->ScaleARGBFilterCols, ScaleARGBFilterCols_C,
+             ScaleARGBFilterCols_C, 1);
+#if defined(HAS_SCALEARGBFILTERCOLS_SSSE3)
+  if (HAS_FLAG(kCpuHasSSSE3)) {
+    SET_KERNEL(dispatch->ScaleARGBFilterCols, ScaleARGBFilterCols_SSSE3,
+               ScaleARGBFilterCols_SSSE3, 1);
+  }
+#endif
+#if defined(HAS_SCALEARGBFILTERCOLS_NEON)
+  if (HAS_FLAG(kCpuHasNEON)) {
+    SET_KERNEL(dispatch->ScaleARGBFilterCols, ScaleARGBFilterCols_Any_NEON,
+               ScaleARGBFilterCols_NEON, 4);
+  }
+#endif
+#if defined(HAS_SCALEARGBFILTERCOLS_LSX)
+  if (HAS_FLAG(kCpuHasLSX)) {
+    SET_KERNEL(dispatch->ScaleARGBFilterCols, ScaleARGBFilterCols_Any_LSX,
+               ScaleARGBFilterCols_LSX, 8);
+  }
+#endif
+#if defined(HAS_SCALEARGBFILTERCOLS_RVV)
+  if (HAS_FLAG(kCpuHasRVV)) {
+    SET_KERNEL(dispatch->ScaleARGBFilterCols, ScaleARGBFilterCols_RVV,
+               ScaleARGBFilterCols_RVV, 1);
+  }
+#endif
+
+  SET_KERNEL(dispatch->ScaleARGBRowDown2[SCALEROWDOWN2_NONE],
+             ScaleARGBRowDown2_C, ScaleARGBRowDown2_C, 1);
+  SET_KERNEL(dispatch->ScaleARGBRowDown2[SCALEROWDOWN2_LINEAR],
+             ScaleARGBRowDown2Linear_C, ScaleARGBRowDown2Linear_C, 1);
+  SET_KERNEL(dispatch->ScaleARGBRowDown2[SCALEROWDOWN2_BOX],
+             ScaleARGBRowDown2Box_C, ScaleARGBRowDown2Box_C, 1);
+#if defined(HAS_SCALEARGBROWDOWN2_SSE2)
+  if (HAS_FLAG(kCpuHasSSE2)) {
+    SET_KERNEL(dispatch->ScaleARGBRowDown2[SCALEROWDOWN2_NONE],
+               ScaleARGBRowDown2_Any_SSE2, ScaleARGBRowDown2_SSE2, 4);
+    SET_KERNEL(dispatch->ScaleARGBRowDown2[SCALEROWDOWN2_LINEAR],
+               ScaleARGBRowDown2Linear_Any_SSE2, ScaleARGBRowDown2Linear_SSE2,
+               4);
+    SET_KERNEL(dispatch->ScaleARGBRowDown2[SCALEROWDOWN2_BOX],
+               ScaleARGBRowDown2Box_Any_SSE2, ScaleARGBRowDown2Box_SSE2, 4);
+  }
+#endif
+#if defined(HAS_SCALEARGBROWDOWN2_NEON)
+  if (HAS_FLAG(kCpuHasNEON)) {
+    SET_KERNEL(dispatch->ScaleARGBRowDown2[SCALEROWDOWN2_NONE],
+               ScaleARGBRowDown2_Any_NEON, ScaleARGBRowDown2_NEON, 8);
+    SET_KERNEL(dispatch->ScaleARGBRowDown2[SCALEROWDOWN2_LINEAR],
+               ScaleARGBRowDown2Linear_Any_NEON, ScaleARGBRowDown2Linear_NEON,
+               8);
+    SET_KERNEL(dispatch->ScaleARGBRowDown2[SCALEROWDOWN2_BOX],
+               ScaleARGBRowDown2Box_Any_NEON, ScaleARGBRowDown2Box_NEON, 8);
+  }
+#endif
+#if defined(HAS_SCALEARGBROWDOWN2_SME)
+  if (HAS_FLAG(kCpuHasSME)) {
+    SET_KERNEL(dispatch->ScaleARGBRowDown2[SCALEROWDOWN2_NONE],
+               ScaleARGBRowDown2_SME, ScaleARGBRowDown2_SME, 1);
+    SET_KERNEL(dispatch->ScaleARGBRowDown2[SCALEROWDOWN2_LINEAR],
+               ScaleARGBRowDown2Linear_SME, ScaleARGBRowDown2Linear_SME, 1);
+    SET_KERNEL(dispatch->ScaleARGBRowDown2[SCALEROWDOWN2_BOX],
+               ScaleARGBRowDown2Box_SME, ScaleARGBRowDown2Box_SME, 1);
+  }
+#endif
+#if defined(HAS_SCALEARGBROWDOWN2_LSX)
+  if (HAS_FLAG(kCpuHasLSX)) {
+    SET_KERNEL(dispatch->ScaleARGBRowDown2[SCALEROWDOWN2_NONE],
+               ScaleARGBRowDown2_Any_LSX, ScaleARGBRowDown2_LSX, 4);
+    SET_KERNEL(dispatch->ScaleARGBRowDown2[SCALEROWDOWN2_LINEAR],
+               ScaleARGBRowDown2Linear_Any_LSX, ScaleARGBRowDown2Linear_LSX, 4);
+    SET_KERNEL(dispatch->ScaleARGBRowDown2[SCALEROWDOWN2_BOX],
+               ScaleARGBRowDown2Box_Any_LSX, ScaleARGBRowDown2Box_LSX, 4);
+  }
+#endif
+#if defined(HAS_SCALEARGBROWDOWN2_RVV) &&       \
+    defined(HAS_SCALEARGBROWDOWN2LINEAR_RVV) && \
+    defined(HAS_SCALEARGBROWDOWN2BOX_RVV)
+  if (HAS_FLAG(kCpuHasRVV)) {
+    SET_KERNEL(dispatch->ScaleARGBRowDown2[SCALEROWDOWN2_NONE],
+               ScaleARGBRowDown2_RVV, ScaleARGBRowDown2_RVV, 1);
+    SET_KERNEL(dispatch->ScaleARGBRowDown2[SCALEROWDOWN2_LINEAR],
+               ScaleARGBRowDown2Linear_RVV, ScaleARGBRowDown2Linear_RVV, 1);
+    SET_KERNEL(dispatch->ScaleARGBRowDown2[SCALEROWDOWN2_BOX],
+               ScaleARGBRowDown2Box_RVV, ScaleARGBRowDown2Box_RVV, 1);
+  }
+#endif
+
+  // UV box kernels also serve linear, which passes a source stride of 0.
+  SET_KERNEL(dispatch->ScaleUVRowDown2[SCALEROWDOWN2_NONE], ScaleUVRowDown2_C,
+             ScaleUVRowDown2_C, 1);
+  SET_KERNEL(dispatch->ScaleUVRowDown2[SCALEROWDOWN2_LINEAR],
+             ScaleUVRowDown2Linear_C, ScaleUVRowDown2Linear_C, 1);
+  SET_KERNEL(dispatch->ScaleUVRowDown2[SCALEROWDOWN2_BOX],
+             ScaleUVRowDown2Box_C, ScaleUVRowDown2Box_C, 1);
+#if defined(HAS_SCALEUVROWDOWN2BOX_SSSE3)
+  if (HAS_FLAG(kCpuHasSSSE3)) {
+    SET_KERNEL(dispatch->ScaleUVRowDown2[SCALEROWDOWN2_LINEAR],
+               ScaleUVRowDown2Box_Any_SSSE3, ScaleUVRowDown2Box_SSSE3, 4);
+    SET_KERNEL(dispatch->ScaleUVRowDown2[SCALEROWDOWN2_BOX],
+               ScaleUVRowDown2Box_Any_SSSE3, ScaleUVRowDown2Box_SSSE3, 4);
+  }
+#endif
+#if defined(HAS_SCALEUVROWDOWN2BOX_AVX2)
+  if (HAS_FLAG(kCpuHasAVX2)) {
+    SET_KERNEL(dispatch->ScaleUVRowDown2[SCALEROWDOWN2_LINEAR],
+               ScaleUVRowDown2Box_Any_AVX2, ScaleUVRowDown2Box_AVX2, 8);
+    SET_KERNEL(dispatch->ScaleUVRowDown2[SCALEROWDOWN2_BOX],
+               ScaleUVRowDown2Box_Any_AVX2, ScaleUVRowDown2Box_AVX2, 8);
+  }
+#endif
+#if defined(HAS_SCALEUVROWDOWN2_NEON)
+  if (HAS_FLAG(kCpuHasNEON)) {
+    SET_KERNEL(dispatch->ScaleUVRowDown2[SCALEROWDOWN2_NONE],
+               ScaleUVRowDown2_Any_NEON, ScaleUVRowDown2_NEON, 8);
+  }
+#endif
+#if defined(HAS_SCALEUVROWDOWN2LINEAR_NEON)
+  if (HAS_FLAG(kCpuHasNEON)) {
+    SET_KERNEL(dispatch->ScaleUVRowDown2[SCALEROWDOWN2_LINEAR],
+               ScaleUVRowDown2Linear_Any_NEON, ScaleUVRowDown2Linear_NEON, 8);
+  }
+#endif
+#if defined(HAS_SCALEUVROWDOWN2BOX_NEON)
+  if (HAS_FLAG(kCpuHasNEON)) {
+    SET_KERNEL(dispatch->ScaleUVRowDown2[SCALEROWDOWN2_BOX],
+               ScaleUVRowDown2Box_Any_NEON, ScaleUVRowDown2Box_NEON, 8);
+  }
+#endif
+#if defined(HAS_SCALEUVROWDOWN2_SME)
+  if (HAS_FLAG(kCpuHasSME)) {
+    SET_KERNEL(dispatch->ScaleUVRowDown2[SCALEROWDOWN2_NONE],
+               ScaleUVRowDown2_SME, ScaleUVRowDown2_SME, 1);
+  }
+#endif
+#if defined(HAS_SCALEUVROWDOWN2LINEAR_SME)
+  if (HAS_FLAG(kCpuHasSME)) {
+    SET_KERNEL(dispatch->ScaleUVRowDown2[SCALEROWDOWN2_LINEAR],
+               ScaleUVRowDown2Linear_SME, ScaleUVRowDown2Linear_SME, 1);
+  }
+#endif
+#if defined(HAS_SCALEUVROWDOWN2BOX_SME)
+  if (HAS_FLAG(kCpuHasSME)) {
+    SET_KERNEL(dispatch->ScaleUVRowDown2[SCALEROWDOWN2_BOX],
+               ScaleUVRowDown2Box_SME, ScaleUVRowDown2Box_SME, 1);
+  }
+#endif
+#if defined(HAS_SCALEUVROWDOWN2_RVV)
+  if (HAS_FLAG(kCpuHasRVV)) {
+    SET_KERNEL(dispatch->ScaleUVRowDown2[SCALEROWDOWN2_NONE],
+               ScaleUVRowDown2_RVV, ScaleUVRowDown2_RVV, 1);
+  }
+#endif
+#if defined(HAS_SCALEUVROWDOWN2LINEAR_RVV)
+  if (HAS_FLAG(kCpuHasRVV)) {
+    SET_KERNEL(dispatch->ScaleUVRowDown2[SCALEROWDOWN2_LINEAR],
+               ScaleUVRowDown2Linear_RVV, ScaleUVRowDown2Linear_RVV, 1);
+  }
+#endif
+#if defined(HAS_SCALEUVROWDOWN2BOX_RVV)
+  if (HAS_FLAG(kCpuHasRVV)) {
+    SET_KERNEL(dispatch->ScaleUVRowDown2[SCALEROWDOWN2_BOX],
+               ScaleUVRowDown2Box_RVV, ScaleUVRowDown2Box_RVV, 1);
+  }
+#endif
+#undef HAS_FLAG
+
+  dispatch->cpu_info = cpu_info;
+}
+
+// Tables are resolved once per set of cpu flags into a list of tables that
+// are not written again after they are published, so a table returned to one
+// thread stays valid while another thread resolves a table for other flags.
+// A new table is resolved before it is pushed onto the list with a compare
+// and swap.  Tables are never freed, since a table may still be in use.  The
+// table last returned is cached in row_dispatch_current_, so that calls with
+// unchanged flags only load and compare it.
+struct RowDispatchNode {
+  struct RowDispatch dispatch;
+  struct RowDispatchNode* next;
+};
+static struct RowDispatchNode* row_dispatch_list_;
+static struct RowDispatch* row_dispatch_current_;
+
+// The C table, used only if a table can not be allocated.
+#define ROW_DISPATCH_EMPTY 0
+#define ROW_DISPATCH_BUSY 1
+#define ROW_DISPATCH_READY 2
+static int row_dispatch_c_state_;
+static struct RowDispatch row_dispatch_c_;
+
+// Atomic helpers.  Compilers without either builtin get plain accesses and
+// must not call GetRowDispatch from several threads at once.
+static int LoadAcquire(int* ptr) {
+#if defined(__ATOMIC_ACQUIRE)
+  return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#elif defined(_MSC_VER)
+  return (int)_InterlockedOr((volatile long*)ptr, 0);
+#else
+  return *(volatile int*)ptr;
+#endif
+}
+
+static void* LoadAcquirePtr(void** ptr) {
+#if defined(__ATOMIC_ACQUIRE)
+  return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#elif defined(_MSC_VER)
+  return _InterlockedCompareExchangePointer((void* volatile*)ptr, NULL, NULL);
+#else
+  return *(void* volatile*)ptr;
+#endif
+}
+
+static int CompareExchange(int* ptr, int expected, int desired) {
+#if defined(__ATOMIC_ACQUIRE)
+  return __atomic_compare_exchange_n(ptr, &expected, desired, 0,
+                                     __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+#elif defined(_MSC_VER)
+  return _InterlockedCompareExchange((volatile long*)ptr, desired, expected) ==
+         expected;
+#else
+  if (*(volatile int*)ptr != expected) {
+    return 0;
+  }
+  *(volatile int*)ptr = desired;
+  return 1;
+#endif
+}
+
+// On failure *expected is set to the current value.
+static int CompareExchangePtr(void** ptr, void** expected, void* desired) {
+#if defined(__ATOMIC_ACQUIRE)
+  return __atomic_compare_exchange_n(ptr, expected, desired, 0,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#elif defined(_MSC_VER)
+  void* previous = _InterlockedCompareExchangePointer((void* volatile*)ptr,
+                                                      desired, *expected);
+  if (previous == *expected) {
+    return 1;
+  }
+  *expected = previous;
+  return 0;
+#else
+  if (*(void* volatile*)ptr != *expected) {
+    *expected = *(void* volatile*)ptr;
+    return 0;
+  }
+  *(void* volatile*)ptr = desired;
+  return 1;
+#endif
+}
+
+static void StoreRelease(int* ptr, int value) {
+#if defined(__ATOMIC_RELEASE)
+  __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#elif defined(_MSC_VER)
+  _InterlockedExchange((volatile long*)ptr, value);
+#else
+  *(volatile int*)ptr = value;
+#endif
+}
+
+static void StoreReleasePtr(void** ptr, void* value) {
+#if defined(__ATOMIC_RELEASE)
+  __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#elif defined(_MSC_VER)
+  _InterlockedExchangePointer((void* volatile*)ptr, value);
+#else
+  *(void* volatile*)ptr = value;
+#endif
+}
+
+// Returns the node for cpu_info in the list from node up to end, or NULL.
+static struct RowDispatchNode* FindRowDispatch(struct RowDispatchNode* node,
+                                               struct RowDispatchNode* end,
+                                               int cpu_info) {
+  for (; node != end; node = node->next) {
+    if (node->dispatch.cpu_info == cpu_info) {
+      return node;
+    }
+  }
+  return NULL;
+}
+
+static const struct RowDispatch* GetRowDispatchC(void) {
+  while (LoadAcquire(&row_dispatch_c_state_) != ROW_DISPATCH_READY) {
+    if (CompareExchange(&row_dispatch_c_state_, ROW_DISPATCH_EMPTY,
+                        ROW_DISPATCH_BUSY)) {
+      ResolveRowDispatch(&row_dispatch_c_, kCpuInitialized);
+      StoreRelease(&row_dispatch_c_state_, ROW_DISPATCH_READY);
+    }
+  }
+  return &row_dispatch_c_;
+}
+
+// Returns the table for cpu_info from the list, resolving and adding it if
+// no thread has yet.
+static const struct RowDispatch* AddRowDispatch(int cpu_info) {
+  struct RowDispatchNode* head =
+      (struct RowDispatchNode*)LoadAcquirePtr((void**)&row_dispatch_list_);
+  struct RowDispatchNode* node = FindRowDispatch(head, NULL, cpu_info);
+  if (node) {
+    return &node->dispatch;
+  }
+  node = (struct RowDispatchNode*)malloc(sizeof(struct RowDispatchNode));
+  if (!node) {
+    return GetRowDispatchC();
+  }
+  ResolveRowDispatch(&node->dispatch, cpu_info);
+  for (;;) {
+    struct RowDispatchNode* found;
+    node->next = head;
+    if (CompareExchangePtr((void**)&row_dispatch_list_, (void**)&head,
+                           node)) {
+      return &node->dispatch;
+    }
+    // Other threads added tables, possibly for these flags.
+    found = FindRowDispatch(head, node->next, cpu_info);
+    if (found) {
+      free(node);
+      return &found->dispatch;
+    }
+  }
+}
+
+LIBYUV_API
+const struct RowDispatch* GetRowDispatch(void) {
+  int cpu_info = LoadAcquire(&cpu_info_);
+  const struct RowDispatch* dispatch =
+      (const struct RowDispatch*)LoadAcquirePtr(
+          (void**)&row_dispatch_current_);
+  if (dispatch && dispatch->cpu_info == cpu_info) {
+    return dispatch;
+  }
+  if (!cpu_info) {
+    cpu_info = InitCpuFlags();
+  }
+  dispatch = AddRowDispatch(cpu_info);
+  if (dispatch->cpu_info == cpu_info) {
+    StoreReleasePtr((void**)&row_dispatch_current_, (void*)dispatch);
+  }
+  return dispatch;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
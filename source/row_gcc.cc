@@ -1383,9 +1383,10 @@ void AB64ToARGBRow_AVX2(const uint16_t* src_ab64,
 
 // clang-format on
 
-#if defined(HAS_ARGBTOYMATRIXROW_AVX2) || \
+#if defined(HAS_ARGBTOYMATRIXROW_AVX2) ||     \
     defined(HAS_ARGBTOUV444MATRIXROW_AVX2) || \
-    defined(HAS_ARGBEXTRACTALPHAROW_AVX2)
+    defined(HAS_ARGBEXTRACTALPHAROW_AVX2) ||  \
+    defined(HAS_CUMULATIVESUMTOAVERAGEROW_AVX2)
 // vpermd for vphaddw + vpackuswb vpermd.
 static const lvec32 kPermdARGBToY_AVX = {0, 4, 1, 5, 2, 6, 3, 7};
 #endif
@@ -7683,11 +7684,13 @@ void UYVYToUV422Row_AVX2(const uint8_t* src_uyvy,
 }
 #endif  // HAS_YUY2TOYROW_AVX2
 
-#ifdef HAS_ARGBBLENDROW_SSSE3
+#if defined(HAS_ARGBBLENDROW_SSSE3) || defined(HAS_ARGBBLENDROW_AVX2)
 // Shuffle table for isolating alpha.
 static const uvec8 kShuffleAlpha = {3u,  0x80, 3u,  0x80, 7u,  0x80, 7u,  0x80,
                                     11u, 0x80, 11u, 0x80, 15u, 0x80, 15u, 0x80};
+#endif
 
+#ifdef HAS_ARGBBLENDROW_SSSE3
 // Blend 8 pixels at a time
 void ARGBBlendRow_SSSE3(const uint8_t* src_argb,
                         const uint8_t* src_argb1,
@@ -7770,6 +7773,168 @@ void ARGBBlendRow_SSSE3(const uint8_t* src_argb,
 }
 #endif  // HAS_ARGBBLENDROW_SSSE3
 
+#ifdef HAS_ARGBBLENDROW_AVX2
+// Blend 8 pixels at a time.
+void ARGBBlendRow_AVX2(const uint8_t* src_argb,
+                       const uint8_t* src_argb1,
+                       uint8_t* dst_argb,
+                       int width) {
+  asm volatile(
+      "vbroadcasti128 %4,%%ymm8                  \n"
+      "vpcmpeqb    %%ymm7,%%ymm7,%%ymm7          \n"
+      "vpsrlw      $0xf,%%ymm7,%%ymm7            \n"
+      "vpcmpeqb    %%ymm6,%%ymm6,%%ymm6          \n"
+      "vpsrlw      $0x8,%%ymm6,%%ymm6            \n"
+      "vpcmpeqb    %%ymm5,%%ymm5,%%ymm5          \n"
+      "vpsllw      $0x8,%%ymm5,%%ymm5            \n"
+      "vpcmpeqb    %%ymm4,%%ymm4,%%ymm4          \n"
+      "vpslld      $0x18,%%ymm4,%%ymm4           \n"
+      "sub         $0x8,%3                       \n"
+      "jl          49f                           \n"
+
+      // 8 pixel loop.
+      LABELALIGN
+      "40:         \n"
+      "vmovdqu     (%0),%%ymm0                   \n"
+      "lea         0x20(%0),%0                   \n"
+      "vpxor       %%ymm4,%%ymm0,%%ymm3          \n"
+      "vmovdqu     (%1),%%ymm1                   \n"
+      "lea         0x20(%1),%1                   \n"
+      "vpshufb     %%ymm8,%%ymm3,%%ymm3          \n"  // 255 - alpha
+      "vpand       %%ymm6,%%ymm1,%%ymm2          \n"
+      "vpaddw      %%ymm7,%%ymm3,%%ymm3          \n"  // 256 - alpha
+      "vpsrlw      $0x8,%%ymm1,%%ymm1            \n"
+      "vpmullw     %%ymm3,%%ymm2,%%ymm2          \n"
+      "vpmullw     %%ymm3,%%ymm1,%%ymm1          \n"
+      "vpor        %%ymm4,%%ymm0,%%ymm0          \n"
+      "vpsrlw      $0x8,%%ymm2,%%ymm2            \n"
+      "vpand       %%ymm5,%%ymm1,%%ymm1          \n"
+      "vpor        %%ymm2,%%ymm1,%%ymm1          \n"
+      "vpaddusb    %%ymm1,%%ymm0,%%ymm0          \n"
+      "vmovdqu     %%ymm0,(%2)                   \n"
+      "lea         0x20(%2),%2                   \n"
+      "sub         $0x8,%3                       \n"
+      "jge         40b                           \n"
+
+      "49:         \n"
+      "add         $0x7,%3                       \n"
+      "jl          99f                           \n"
+
+      // 1 pixel loop.
+      "91:         \n"
+      "vmovd       (%0),%%xmm0                   \n"
+      "lea         0x4(%0),%0                    \n"
+      "vpxor       %%xmm4,%%xmm0,%%xmm3          \n"
+      "vmovd       (%1),%%xmm1                   \n"
+      "lea         0x4(%1),%1                    \n"
+      "vpshufb     %%xmm8,%%xmm3,%%xmm3          \n"
+      "vpand       %%xmm6,%%xmm1,%%xmm2          \n"
+      "vpaddw      %%xmm7,%%xmm3,%%xmm3          \n"
+      "vpsrlw      $0x8,%%xmm1,%%xmm1            \n"
+      "vpmullw     %%xmm3,%%xmm2,%%xmm2          \n"
+      "vpmullw     %%xmm3,%%xmm1,%%xmm1          \n"
+      "vpor        %%xmm4,%%xmm0,%%xmm0          \n"
+      "vpsrlw      $0x8,%%xmm2,%%xmm2            \n"
+      "vpand       %%xmm5,%%xmm1,%%xmm1          \n"
+      "vpor        %%xmm2,%%xmm1,%%xmm1          \n"
+      "vpaddusb    %%xmm1,%%xmm0,%%xmm0          \n"
+      "vmovd       %%xmm0,(%2)                   \n"
+      "lea         0x4(%2),%2                    \n"
+      "sub         $0x1,%3                       \n"
+      "jge         91b                           \n"
+      "99:         \n"
+      "vzeroupper  \n"
+      : "+r"(src_argb),     // %0
+        "+r"(src_argb1),    // %1
+        "+r"(dst_argb),     // %2
+        "+r"(width)         // %3
+      : "m"(kShuffleAlpha)  // %4
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8");
+}
+#endif  // HAS_ARGBBLENDROW_AVX2
+
+#ifdef HAS_ARGBBLENDROW_AVX512BW
+// Blend 16 pixels at a time.
+void ARGBBlendRow_AVX512BW(const uint8_t* src_argb,
+                           const uint8_t* src_argb1,
+                           uint8_t* dst_argb,
+                           int width) {
+  asm volatile(
+      "vbroadcasti32x4 %4,%%zmm8                 \n"
+      "vpternlogd  $0xff,%%zmm7,%%zmm7,%%zmm7    \n"
+      "vpsrlw      $0xf,%%zmm7,%%zmm7            \n"
+      "vpternlogd  $0xff,%%zmm6,%%zmm6,%%zmm6    \n"
+      "vpsrlw      $0x8,%%zmm6,%%zmm6            \n"
+      "vpternlogd  $0xff,%%zmm5,%%zmm5,%%zmm5    \n"
+      "vpsllw      $0x8,%%zmm5,%%zmm5            \n"
+      "vpternlogd  $0xff,%%zmm4,%%zmm4,%%zmm4    \n"
+      "vpslld      $0x18,%%zmm4,%%zmm4           \n"
+      "sub         $0x10,%3                      \n"
+      "jl          49f                           \n"
+
+      // 16 pixel loop.
+      LABELALIGN
+      "40:         \n"
+      "vmovdqu64   (%0),%%zmm0                   \n"
+      "lea         0x40(%0),%0                   \n"
+      "vpxorq      %%zmm4,%%zmm0,%%zmm3          \n"
+      "vmovdqu64   (%1),%%zmm1                   \n"
+      "lea         0x40(%1),%1                   \n"
+      "vpshufb     %%zmm8,%%zmm3,%%zmm3          \n"  // 255 - alpha
+      "vpandq      %%zmm6,%%zmm1,%%zmm2          \n"
+      "vpaddw      %%zmm7,%%zmm3,%%zmm3          \n"  // 256 - alpha
+      "vpsrlw      $0x8,%%zmm1,%%zmm1            \n"
+      "vpmullw     %%zmm3,%%zmm2,%%zmm2          \n"
+      "vpmullw     %%zmm3,%%zmm1,%%zmm1          \n"
+      "vporq       %%zmm4,%%zmm0,%%zmm0          \n"
+      "vpsrlw      $0x8,%%zmm2,%%zmm2            \n"
+      "vpandq      %%zmm5,%%zmm1,%%zmm1          \n"
+      "vporq       %%zmm2,%%zmm1,%%zmm1          \n"
+      "vpaddusb    %%zmm1,%%zmm0,%%zmm0          \n"
+      "vmovdqu64   %%zmm0,(%2)                   \n"
+      "lea         0x40(%2),%2                   \n"
+      "sub         $0x10,%3                      \n"
+      "jge         40b                           \n"
+
+      "49:         \n"
+      "add         $0xf,%3                       \n"
+      "jl          99f                           \n"
+
+      // 1 pixel loop.
+      "91:         \n"
+      "vmovd       (%0),%%xmm0                   \n"
+      "lea         0x4(%0),%0                    \n"
+      "vpxor       %%xmm4,%%xmm0,%%xmm3          \n"
+      "vmovd       (%1),%%xmm1                   \n"
+      "lea         0x4(%1),%1                    \n"
+      "vpshufb     %%xmm8,%%xmm3,%%xmm3          \n"
+      "vpand       %%xmm6,%%xmm1,%%xmm2          \n"
+      "vpaddw      %%xmm7,%%xmm3,%%xmm3          \n"
+      "vpsrlw      $0x8,%%xmm1,%%xmm1            \n"
+      "vpmullw     %%xmm3,%%xmm2,%%xmm2          \n"
+      "vpmullw     %%xmm3,%%xmm1,%%xmm1          \n"
+      "vpor        %%xmm4,%%xmm0,%%xmm0          \n"
+      "vpsrlw      $0x8,%%xmm2,%%xmm2            \n"
+      "vpand       %%xmm5,%%xmm1,%%xmm1          \n"
+      "vpor        %%xmm2,%%xmm1,%%xmm1          \n"
+      "vpaddusb    %%xmm1,%%xmm0,%%xmm0          \n"
+      "vmovd       %%xmm0,(%2)                   \n"
+      "lea         0x4(%2),%2                    \n"
+      "sub         $0x1,%3                       \n"
+      "jge         91b                           \n"
+      "99:         \n"
+      "vzeroupper  \n"
+      : "+r"(src_argb),     // %0
+        "+r"(src_argb1),    // %1
+        "+r"(dst_argb),     // %2
+        "+r"(width)         // %3
+      : "m"(kShuffleAlpha)  // %4
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8");
+}
+#endif  // HAS_ARGBBLENDROW_AVX512BW
+
 #ifdef HAS_BLENDPLANEROW_SSSE3
 // Blend 8 pixels at a time.
 // unsigned version of math
@@ -8796,6 +8961,246 @@ void SobelXYRow_SSE2(const uint8_t* src_sobelx,
 }
 #endif  // HAS_SOBELXYROW_SSE2
 
+#ifdef HAS_SOBELXROW_AVX2
+void SobelXRow_AVX2(const uint8_t* src_y0,
+                    const uint8_t* src_y1,
+                    const uint8_t* src_y2,
+                    uint8_t* dst_sobelx,
+                    int width) {
+  asm volatile(
+      "sub         %0,%1                         \n"
+      "sub         %0,%2                         \n"
+      "sub         %0,%3                         \n"
+
+      // 16 pixel loop.
+      LABELALIGN
+      "1:          \n"
+      "vpmovzxbw   (%0),%%ymm0                   \n"
+      "vpmovzxbw   0x2(%0),%%ymm1                \n"
+      "vpsubw      %%ymm1,%%ymm0,%%ymm0          \n"
+      "vpmovzxbw   0x00(%0,%1,1),%%ymm1          \n"
+      "vpmovzxbw   0x02(%0,%1,1),%%ymm2          \n"
+      "vpsubw      %%ymm2,%%ymm1,%%ymm1          \n"
+      "vpmovzxbw   0x00(%0,%2,1),%%ymm2          \n"
+      "vpmovzxbw   0x02(%0,%2,1),%%ymm3          \n"
+      "vpsubw      %%ymm3,%%ymm2,%%ymm2          \n"
+      "vpaddw      %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddw      %%ymm1,%%ymm0,%%ymm0          \n"
+      "vpaddw      %%ymm1,%%ymm0,%%ymm0          \n"
+      "vpabsw      %%ymm0,%%ymm0                 \n"
+      "vextracti128 $0x1,%%ymm0,%%xmm1           \n"
+      "vpackuswb   %%xmm1,%%xmm0,%%xmm0          \n"
+      "vmovdqu     %%xmm0,0x00(%0,%3,1)          \n"
+      "lea         0x10(%0),%0                   \n"
+      "sub         $0x10,%4                      \n"
+      "jg          1b                            \n"
+      "vzeroupper  \n"
+      : "+r"(src_y0),      // %0
+        "+r"(src_y1),      // %1
+        "+r"(src_y2),      // %2
+        "+r"(dst_sobelx),  // %3
+        "+r"(width)        // %4
+      :
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3");
+}
+#endif  // HAS_SOBELXROW_AVX2
+
+#ifdef HAS_SOBELYROW_AVX2
+void SobelYRow_AVX2(const uint8_t* src_y0,
+                    const uint8_t* src_y1,
+                    uint8_t* dst_sobely,
+                    int width) {
+  asm volatile(
+      "sub         %0,%1                         \n"
+      "sub         %0,%2                         \n"
+
+      // 16 pixel loop.
+      LABELALIGN
+      "1:          \n"
+      "vpmovzxbw   (%0),%%ymm0                   \n"
+      "vpmovzxbw   0x00(%0,%1,1),%%ymm1          \n"
+      "vpsubw      %%ymm1,%%ymm0,%%ymm0          \n"
+      "vpmovzxbw   0x1(%0),%%ymm1                \n"
+      "vpmovzxbw   0x01(%0,%1,1),%%ymm2          \n"
+      "vpsubw      %%ymm2,%%ymm1,%%ymm1          \n"
+      "vpmovzxbw   0x2(%0),%%ymm2                \n"
+      "vpmovzxbw   0x02(%0,%1,1),%%ymm3          \n"
+      "vpsubw      %%ymm3,%%ymm2,%%ymm2          \n"
+      "vpaddw      %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddw      %%ymm1,%%ymm0,%%ymm0          \n"
+      "vpaddw      %%ymm1,%%ymm0,%%ymm0          \n"
+      "vpabsw      %%ymm0,%%ymm0                 \n"
+      "vextracti128 $0x1,%%ymm0,%%xmm1           \n"
+      "vpackuswb   %%xmm1,%%xmm0,%%xmm0          \n"
+      "vmovdqu     %%xmm0,0x00(%0,%2,1)          \n"
+      "lea         0x10(%0),%0                   \n"
+      "sub         $0x10,%3                      \n"
+      "jg          1b                            \n"
+      "vzeroupper  \n"
+      : "+r"(src_y0),      // %0
+        "+r"(src_y1),      // %1
+        "+r"(dst_sobely),  // %2
+        "+r"(width)        // %3
+      :
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3");
+}
+#endif  // HAS_SOBELYROW_AVX2
+
+#ifdef HAS_SOBELXYROW_AVX2
+// Mixes Sobel X, Sobel Y and Sobel into ARGB.
+// A = 255
+// R = Sobel X
+// G = Sobel
+// B = Sobel Y
+void SobelXYRow_AVX2(const uint8_t* src_sobelx,
+                     const uint8_t* src_sobely,
+                     uint8_t* dst_argb,
+                     int width) {
+  asm volatile(
+      "sub         %0,%1                         \n"
+      "vpcmpeqb    %%ymm5,%%ymm5,%%ymm5          \n"
+
+      // 32 pixel loop.
+      LABELALIGN
+      "1:          \n"
+      "vmovdqu     (%0),%%ymm0                   \n"  // R = Sobel X
+      "vmovdqu     0x00(%0,%1,1),%%ymm1          \n"  // B = Sobel Y
+      "lea         0x20(%0),%0                   \n"
+      "vpaddusb    %%ymm1,%%ymm0,%%ymm2          \n"  // G = Sobel
+      "vpunpcklbw  %%ymm5,%%ymm0,%%ymm3          \n"  // RA
+      "vpunpckhbw  %%ymm5,%%ymm0,%%ymm0          \n"
+      "vpunpcklbw  %%ymm2,%%ymm1,%%ymm4          \n"  // BG
+      "vpunpckhbw  %%ymm2,%%ymm1,%%ymm1          \n"
+      "vpunpcklwd  %%ymm3,%%ymm4,%%ymm2          \n"  // BGRA 0-3, 16-19
+      "vpunpckhwd  %%ymm3,%%ymm4,%%ymm4          \n"  // 4-7, 20-23
+      "vpunpcklwd  %%ymm0,%%ymm1,%%ymm3          \n"  // 8-11, 24-27
+      "vpunpckhwd  %%ymm0,%%ymm1,%%ymm1          \n"  // 12-15, 28-31
+      "vperm2i128  $0x20,%%ymm4,%%ymm2,%%ymm0    \n"  // 0-7
+      "vperm2i128  $0x31,%%ymm4,%%ymm2,%%ymm2    \n"  // 16-23
+      "vperm2i128  $0x20,%%ymm1,%%ymm3,%%ymm4    \n"  // 8-15
+      "vperm2i128  $0x31,%%ymm1,%%ymm3,%%ymm1    \n"  // 24-31
+      "vmovdqu     %%ymm0,(%2)                   \n"
+      "vmovdqu     %%ymm4,0x20(%2)               \n"
+      "vmovdqu     %%ymm2,0x40(%2)               \n"
+      "vmovdqu     %%ymm1,0x60(%2)               \n"
+      "lea         0x80(%2),%2                   \n"
+      "sub         $0x20,%3                      \n"
+      "jg          1b                            \n"
+      "vzeroupper  \n"
+      : "+r"(src_sobelx),  // %0
+        "+r"(src_sobely),  // %1
+        "+r"(dst_argb),    // %2
+        "+r"(width)        // %3
+      :
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5");
+}
+#endif  // HAS_SOBELXYROW_AVX2
+
+#if defined(HAS_SOBELPLANEROW_AVX2) || defined(HAS_SOBELPLANEROW_AVX512BW)
+// Sobel X and Sobel Y of 16 (ymm) or 32 (zmm) pixels at byte offset OFF.
+// %0 is row 0, %1 and %2 are the offsets of rows 1 and 2.  Result in R0 as
+// words clamped to 255 each and added.  R7 holds 255 in each word.
+#define SOBELPLANE(OFF, R0, R1, R2, R3, R4, R7)                        \
+  "vpmovzxbw   " OFF "+0(%0)," R0 "               \n" /* a0 */         \
+  "vpmovzxbw   " OFF "+2(%0)," R1 "               \n" /* a2 */         \
+  "vpmovzxbw   " OFF "+0(%0,%2,1)," R2 "          \n" /* c0 */         \
+  "vpmovzxbw   " OFF "+2(%0,%2,1)," R3 "          \n" /* c2 */         \
+  "vpsubw      " R1 "," R0 "," R4 "               \n" /* a0 - a2 */    \
+  "vpsubw      " R2 "," R0 "," R0 "               \n" /* a0 - c0 */    \
+  "vpsubw      " R3 "," R2 "," R2 "               \n" /* c0 - c2 */    \
+  "vpsubw      " R3 "," R1 "," R1 "               \n" /* a2 - c2 */    \
+  "vpaddw      " R2 "," R4 "," R4 "               \n"                  \
+  "vpaddw      " R1 "," R0 "," R0 "               \n"                  \
+  "vpmovzxbw   " OFF "+0(%0,%1,1)," R1 "          \n" /* b0 */         \
+  "vpmovzxbw   " OFF "+2(%0,%1,1)," R2 "          \n" /* b2 */         \
+  "vpsubw      " R2 "," R1 "," R1 "               \n"                  \
+  "vpaddw      " R1 "," R4 "," R4 "               \n"                  \
+  "vpaddw      " R1 "," R4 "," R4 "               \n" /* Sobel X */    \
+  "vpmovzxbw   " OFF "+1(%0)," R1 "               \n" /* a1 */         \
+  "vpmovzxbw   " OFF "+1(%0,%2,1)," R2 "          \n" /* c1 */         \
+  "vpsubw      " R2 "," R1 "," R1 "               \n"                  \
+  "vpaddw      " R1 "," R0 "," R0 "               \n"                  \
+  "vpaddw      " R1 "," R0 "," R0 "               \n" /* Sobel Y */    \
+  "vpabsw      " R4 "," R4 "                      \n"                  \
+  "vpabsw      " R0 "," R0 "                      \n"                  \
+  "vpminsw     " R7 "," R4 "," R4 "               \n"                  \
+  "vpminsw     " R7 "," R0 "," R0 "               \n"                  \
+  "vpaddw      " R4 "," R0 "," R0 "               \n"
+#endif
+
+#ifdef HAS_SOBELPLANEROW_AVX2
+// Sobel X + Sobel Y computed directly from 3 rows of luma.
+void SobelPlaneRow_AVX2(const uint8_t* src_y0,
+                        const uint8_t* src_y1,
+                        const uint8_t* src_y2,
+                        uint8_t* dst_y,
+                        int width) {
+  asm volatile(
+      "sub         %0,%1                         \n"
+      "sub         %0,%2                         \n"
+      "sub         %0,%3                         \n"
+      "vpcmpeqw    %%ymm7,%%ymm7,%%ymm7          \n"
+      "vpsrlw      $0x8,%%ymm7,%%ymm7            \n"  // 255
+
+      // 32 pixel loop.
+      LABELALIGN
+      "1:          \n"
+    SOBELPLANE("0x00", "%%ymm5", "%%ymm1", "%%ymm2", "%%ymm3", "%%ymm4",
+               "%%ymm7")
+    SOBELPLANE("0x10", "%%ymm0", "%%ymm1", "%%ymm2", "%%ymm3", "%%ymm4",
+               "%%ymm7")
+      "vpackuswb   %%ymm0,%%ymm5,%%ymm0          \n"  // mutates
+      "vpermq      $0xd8,%%ymm0,%%ymm0           \n"  // unmutate
+      "vmovdqu     %%ymm0,0x00(%0,%3,1)          \n"
+      "lea         0x20(%0),%0                   \n"
+      "sub         $0x20,%4                      \n"
+      "jg          1b                            \n"
+      "vzeroupper  \n"
+      : "+r"(src_y0),  // %0
+        "+r"(src_y1),  // %1
+        "+r"(src_y2),  // %2
+        "+r"(dst_y),   // %3
+        "+r"(width)    // %4
+      :
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+        "xmm7");
+}
+#endif  // HAS_SOBELPLANEROW_AVX2
+
+#ifdef HAS_SOBELPLANEROW_AVX512BW
+void SobelPlaneRow_AVX512BW(const uint8_t* src_y0,
+                            const uint8_t* src_y1,
+                            const uint8_t* src_y2,
+                            uint8_t* dst_y,
+                            int width) {
+  asm volatile(
+      "sub         %0,%1                         \n"
+      "sub         %0,%2                         \n"
+      "sub         %0,%3                         \n"
+      "vpternlogd  $0xff,%%zmm7,%%zmm7,%%zmm7    \n"
+      "vpsrlw      $0x8,%%zmm7,%%zmm7            \n"  // 255
+
+      // 32 pixel loop.
+      LABELALIGN
+      "1:          \n"
+    SOBELPLANE("0x00", "%%zmm0", "%%zmm1", "%%zmm2", "%%zmm3", "%%zmm4",
+               "%%zmm7")
+      "vpmovuswb   %%zmm0,0x00(%0,%3,1)          \n"
+      "lea         0x20(%0),%0                   \n"
+      "sub         $0x20,%4                      \n"
+      "jg          1b                            \n"
+      "vzeroupper  \n"
+      : "+r"(src_y0),  // %0
+        "+r"(src_y1),  // %1
+        "+r"(src_y2),  // %2
+        "+r"(dst_y),   // %3
+        "+r"(width)    // %4
+      :
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm7");
+}
+#endif  // HAS_SOBELPLANEROW_AVX512BW
+#undef SOBELPLANE
+
 #ifdef HAS_COMPUTECUMULATIVESUMROW_SSE2
 // Creates a table of cumulative sums where each value is a sum of all values
 // above and to the left of the value, inclusive of the value.
@@ -9008,58 +9413,353 @@ void CumulativeSumToAverageRow_SSE2(const int32_t* topleft,
 }
 #endif  // HAS_CUMULATIVESUMTOAVERAGEROW_SSE2
 
-#ifdef HAS_ARGBAFFINEROW_SSE2
-// Copy ARGB pixels from source image with slope to a row of destination.
-LIBYUV_API
-void ARGBAffineRow_SSE2(const uint8_t* src_argb,
-                        int src_argb_stride,
-                        uint8_t* dst_argb,
-                        const float* src_dudv,
-                        int width) {
-  ptrdiff_t src_argb_stride_temp = src_argb_stride;
-  intptr_t temp;
+#ifdef HAS_COMPUTECUMULATIVESUMROW_AVX2
+// Creates a table of cumulative sums, 4 pixels per loop.  Each 2 pixels are
+// summed within the register so the running sum is 1 add per loop.
+void ComputeCumulativeSumRow_AVX2(const uint8_t* row,
+                                  int32_t* cumsum,
+                                  const int32_t* previous_cumsum,
+                                  int width) {
   asm volatile(
-      "movq        (%3),%%xmm2                   \n"
-      "movq        0x08(%3),%%xmm7               \n"
-      "shl         $0x10,%1                      \n"
-      "add         $0x4,%1                       \n"
-      "movd        %1,%%xmm5                     \n"
-      "sub         $0x4,%4                       \n"
+      "vpxor       %%ymm0,%%ymm0,%%ymm0          \n"  // row sum in both lanes
+      "sub         $0x4,%3                       \n"
       "jl          49f                           \n"
 
-      "pshufd      $0x44,%%xmm7,%%xmm7           \n"
-      "pshufd      $0x0,%%xmm5,%%xmm5            \n"
-      "movdqa      %%xmm2,%%xmm0                 \n"
-      "addps       %%xmm7,%%xmm0                 \n"
-      "movlhps     %%xmm0,%%xmm2                 \n"
-      "movdqa      %%xmm7,%%xmm4                 \n"
-      "addps       %%xmm4,%%xmm4                 \n"
-      "movdqa      %%xmm2,%%xmm3                 \n"
-      "addps       %%xmm4,%%xmm3                 \n"
-      "addps       %%xmm4,%%xmm4                 \n"
-
-      // 4 pixel loop
+      // 4 pixel loop.
       LABELALIGN
       "40:         \n"
-      "cvttps2dq   %%xmm2,%%xmm0                 \n"  // x,y float->int first 2
-      "cvttps2dq   %%xmm3,%%xmm1                 \n"  // x,y float->int next 2
-      "packssdw    %%xmm1,%%xmm0                 \n"  // x, y as 8 shorts
-      "pmaddwd     %%xmm5,%%xmm0                 \n"  // off = x*4 + y*stride
-      "movd        %%xmm0,%k1                    \n"
-      "pshufd      $0x39,%%xmm0,%%xmm0           \n"
-      "movd        %%xmm0,%k5                    \n"
-      "pshufd      $0x39,%%xmm0,%%xmm0           \n"
-      "movd        0x00(%0,%1,1),%%xmm1          \n"
-      "movd        0x00(%0,%5,1),%%xmm6          \n"
-      "punpckldq   %%xmm6,%%xmm1                 \n"
-      "addps       %%xmm4,%%xmm2                 \n"
-      "movq        %%xmm1,(%2)                   \n"
-      "movd        %%xmm0,%k1                    \n"
-      "pshufd      $0x39,%%xmm0,%%xmm0           \n"
-      "movd        %%xmm0,%k5                    \n"
-      "movd        0x00(%0,%1,1),%%xmm0          \n"
-      "movd        0x00(%0,%5,1),%%xmm6          \n"
-      "punpckldq   %%xmm6,%%xmm0                 \n"
+      "vpmovzxbd   (%0),%%ymm2                   \n"  // p0, p1
+      "vpmovzxbd   0x8(%0),%%ymm3                \n"  // p2, p3
+      "lea         0x10(%0),%0                   \n"
+      "vperm2i128  $0x8,%%ymm2,%%ymm2,%%ymm4     \n"  // 0, p0
+      "vperm2i128  $0x8,%%ymm3,%%ymm3,%%ymm5     \n"  // 0, p2
+      "vpaddd      %%ymm4,%%ymm2,%%ymm2          \n"  // p0, p0+p1
+      "vpaddd      %%ymm5,%%ymm3,%%ymm3          \n"  // p2, p2+p3
+      "vpermq      $0xee,%%ymm2,%%ymm4           \n"  // p0+p1, p0+p1
+      "vpaddd      %%ymm4,%%ymm3,%%ymm3          \n"  // p0+p1+p2, p0+..+p3
+      "vpermq      $0xee,%%ymm3,%%ymm5           \n"  // p0+..+p3 in both lanes
+      "vpaddd      %%ymm0,%%ymm2,%%ymm2          \n"
+      "vpaddd      %%ymm0,%%ymm3,%%ymm3          \n"
+      "vpaddd      %%ymm5,%%ymm0,%%ymm0          \n"
+      "vpaddd      (%2),%%ymm2,%%ymm2            \n"
+      "vpaddd      0x20(%2),%%ymm3,%%ymm3        \n"
+      "lea         0x40(%2),%2                   \n"
+      "vmovdqu     %%ymm2,(%1)                   \n"
+      "vmovdqu     %%ymm3,0x20(%1)               \n"
+      "lea         0x40(%1),%1                   \n"
+      "sub         $0x4,%3                       \n"
+      "jge         40b                           \n"
+
+      "49:         \n"
+      "add         $0x3,%3                       \n"
+      "jl          19f                           \n"
+
+      // 1 pixel loop.
+      LABELALIGN
+      "10:         \n"
+      "vpmovzxbd   (%0),%%xmm2                   \n"
+      "lea         0x4(%0),%0                    \n"
+      "vpaddd      %%xmm2,%%xmm0,%%xmm0          \n"
+      "vpaddd      (%2),%%xmm0,%%xmm2            \n"
+      "lea         0x10(%2),%2                   \n"
+      "vmovdqu     %%xmm2,(%1)                   \n"
+      "lea         0x10(%1),%1                   \n"
+      "sub         $0x1,%3                       \n"
+      "jge         10b                           \n"
+
+      "19:         \n"
+      "vzeroupper  \n"
+      : "+r"(row),              // %0
+        "+r"(cumsum),           // %1
+        "+r"(previous_cumsum),  // %2
+        "+r"(width)             // %3
+      :
+      : "memory", "cc", "xmm0", "xmm2", "xmm3", "xmm4", "xmm5");
+}
+#endif  // HAS_COMPUTECUMULATIVESUMROW_AVX2
+
+#ifdef HAS_CUMULATIVESUMTOAVERAGEROW_AVX2
+// Same rounding as the C version: multiply by 1 / area and truncate.
+void CumulativeSumToAverageRow_AVX2(const int32_t* topleft,
+                                    const int32_t* botleft,
+                                    int width,
+                                    int area,
+                                    uint8_t* dst,
+                                    int count) {
+  const float ooa = 1.0f / (float)(area);
+  asm volatile(
+      "vbroadcastss %5,%%ymm4                    \n"
+      "vmovdqu     %6,%%ymm5                     \n"
+      "sub         $0x8,%3                       \n"
+      "jl          49f                           \n"
+
+      // 8 pixel loop.
+      LABELALIGN
+      "8:          \n"
+      "vmovdqu     (%0),%%ymm0                   \n"
+      "vmovdqu     0x20(%0),%%ymm1               \n"
+      "vmovdqu     0x40(%0),%%ymm2               \n"
+      "vmovdqu     0x60(%0),%%ymm3               \n"
+      "vpsubd      0x00(%0,%4,4),%%ymm0,%%ymm0   \n"
+      "vpsubd      0x20(%0,%4,4),%%ymm1,%%ymm1   \n"
+      "vpsubd      0x40(%0,%4,4),%%ymm2,%%ymm2   \n"
+      "vpsubd      0x60(%0,%4,4),%%ymm3,%%ymm3   \n"
+      "lea         0x80(%0),%0                   \n"
+      "vpsubd      (%1),%%ymm0,%%ymm0            \n"
+      "vpsubd      0x20(%1),%%ymm1,%%ymm1        \n"
+      "vpsubd      0x40(%1),%%ymm2,%%ymm2        \n"
+      "vpsubd      0x60(%1),%%ymm3,%%ymm3        \n"
+      "vpaddd      0x00(%1,%4,4),%%ymm0,%%ymm0   \n"
+      "vpaddd      0x20(%1,%4,4),%%ymm1,%%ymm1   \n"
+      "vpaddd      0x40(%1,%4,4),%%ymm2,%%ymm2   \n"
+      "vpaddd      0x60(%1,%4,4),%%ymm3,%%ymm3   \n"
+      "lea         0x80(%1),%1                   \n"
+      "vcvtdq2ps   %%ymm0,%%ymm0                 \n"
+      "vcvtdq2ps   %%ymm1,%%ymm1                 \n"
+      "vcvtdq2ps   %%ymm2,%%ymm2                 \n"
+      "vcvtdq2ps   %%ymm3,%%ymm3                 \n"
+      "vmulps      %%ymm4,%%ymm0,%%ymm0          \n"
+      "vmulps      %%ymm4,%%ymm1,%%ymm1          \n"
+      "vmulps      %%ymm4,%%ymm2,%%ymm2          \n"
+      "vmulps      %%ymm4,%%ymm3,%%ymm3          \n"
+      "vcvttps2dq  %%ymm0,%%ymm0                 \n"
+      "vcvttps2dq  %%ymm1,%%ymm1                 \n"
+      "vcvttps2dq  %%ymm2,%%ymm2                 \n"
+      "vcvttps2dq  %%ymm3,%%ymm3                 \n"
+      "vpackssdw   %%ymm1,%%ymm0,%%ymm0          \n"  // mutates
+      "vpackssdw   %%ymm3,%%ymm2,%%ymm2          \n"
+      "vpackuswb   %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpermd      %%ymm0,%%ymm5,%%ymm0          \n"  // unmutate
+      "vmovdqu     %%ymm0,(%2)                   \n"
+      "lea         0x20(%2),%2                   \n"
+      "sub         $0x8,%3                       \n"
+      "jge         8b                            \n"
+
+      "49:         \n"
+      "add         $0x7,%3                       \n"
+      "jl          19f                           \n"
+
+      // 1 pixel loop
+      LABELALIGN
+      "10:         \n"
+      "vmovdqu     (%0),%%xmm0                   \n"
+      "vpsubd      0x00(%0,%4,4),%%xmm0,%%xmm0   \n"
+      "lea         0x10(%0),%0                   \n"
+      "vpsubd      (%1),%%xmm0,%%xmm0            \n"
+      "vpaddd      0x00(%1,%4,4),%%xmm0,%%xmm0   \n"
+      "lea         0x10(%1),%1                   \n"
+      "vcvtdq2ps   %%xmm0,%%xmm0                 \n"
+      "vmulps      %%xmm4,%%xmm0,%%xmm0          \n"
+      "vcvttps2dq  %%xmm0,%%xmm0                 \n"
+      "vpackssdw   %%xmm0,%%xmm0,%%xmm0          \n"
+      "vpackuswb   %%xmm0,%%xmm0,%%xmm0          \n"
+      "vmovd       %%xmm0,(%2)                   \n"
+      "lea         0x4(%2),%2                    \n"
+      "sub         $0x1,%3                       \n"
+      "jge         10b                           \n"
+      "19:         \n"
+      "vzeroupper  \n"
+      : "+r"(topleft),            // %0
+        "+r"(botleft),            // %1
+        "+r"(dst),                // %2
+        "+r"(count)               // %3
+      : "r"((ptrdiff_t)(width)),  // %4
+        "m"(ooa),                 // %5
+        "m"(kPermdARGBToY_AVX)    // %6
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5");
+}
+#endif  // HAS_CUMULATIVESUMTOAVERAGEROW_AVX2
+
+#if defined(HAS_INTEGRALROW_AVX2) || defined(HAS_INTEGRALSQUAREDROW_AVX2)
+// Prefix sum of 16 values in ymm1 and ymm2, add the running sum in ymm0 and
+// the previous row, and store.  ymm6 is vpermd indices of 7.
+// clang-format off
+#define INTEGRAL16_AVX2                                   \
+  "vpslldq     $0x4,%%ymm1,%%ymm3                 \n"     \
+  "vpslldq     $0x4,%%ymm2,%%ymm4                 \n"     \
+  "vpaddd      %%ymm3,%%ymm1,%%ymm1               \n"     \
+  "vpaddd      %%ymm4,%%ymm2,%%ymm2               \n"     \
+  "vpslldq     $0x8,%%ymm1,%%ymm3                 \n"     \
+  "vpslldq     $0x8,%%ymm2,%%ymm4                 \n"     \
+  "vpaddd      %%ymm3,%%ymm1,%%ymm1               \n"     \
+  "vpaddd      %%ymm4,%%ymm2,%%ymm2               \n"     \
+  "vpshufd     $0xff,%%ymm1,%%ymm3                \n"     \
+  "vpshufd     $0xff,%%ymm2,%%ymm4                \n"     \
+  "vperm2i128  $0x8,%%ymm3,%%ymm3,%%ymm3          \n"     \
+  "vperm2i128  $0x8,%%ymm4,%%ymm4,%%ymm4          \n"     \
+  "vpaddd      %%ymm3,%%ymm1,%%ymm1               \n"     \
+  "vpaddd      %%ymm4,%%ymm2,%%ymm2               \n"     \
+  "vpermd      %%ymm1,%%ymm6,%%ymm3               \n"     \
+  "vpaddd      %%ymm3,%%ymm2,%%ymm2               \n"     \
+  "vpermd      %%ymm2,%%ymm6,%%ymm4               \n"     \
+  "vpaddd      %%ymm0,%%ymm1,%%ymm1               \n"     \
+  "vpaddd      %%ymm0,%%ymm2,%%ymm2               \n"     \
+  "vpaddd      %%ymm4,%%ymm0,%%ymm0               \n"     \
+  "vpaddd      (%2),%%ymm1,%%ymm1                 \n"     \
+  "vpaddd      0x20(%2),%%ymm2,%%ymm2             \n"     \
+  "lea         0x40(%2),%2                        \n"     \
+  "vmovdqu     %%ymm1,(%1)                        \n"     \
+  "vmovdqu     %%ymm2,0x20(%1)                    \n"     \
+  "lea         0x40(%1),%1                        \n"
+
+// Add 1 value in xmm1 to the running sum and the previous row, and store.
+#define INTEGRAL1_AVX2                                    \
+  "vpaddd      %%xmm1,%%xmm0,%%xmm0               \n"     \
+  "vmovd       (%2),%%xmm2                        \n"     \
+  "lea         0x4(%2),%2                         \n"     \
+  "vpaddd      %%xmm0,%%xmm2,%%xmm2               \n"     \
+  "vmovd       %%xmm2,(%1)                        \n"     \
+  "lea         0x4(%1),%1                         \n"
+// clang-format on
+#endif
+
+#ifdef HAS_INTEGRALROW_AVX2
+// Integral image row, 16 pixels per loop.
+void IntegralRow_AVX2(const uint8_t* src,
+                      uint32_t* dst,
+                      const uint32_t* previous,
+                      int width) {
+  asm volatile(
+      "vpxor       %%ymm0,%%ymm0,%%ymm0          \n"  // running sum
+      "vpxor       %%xmm7,%%xmm7,%%xmm7          \n"
+      "vpcmpeqb    %%ymm6,%%ymm6,%%ymm6          \n"
+      "vpsrld      $0x1d,%%ymm6,%%ymm6           \n"  // 7
+      "sub         $0x10,%3                      \n"
+      "jl          49f                           \n"
+
+      // 16 pixel loop.
+      LABELALIGN
+      "16:         \n"
+      "vpmovzxbd   (%0),%%ymm1                   \n"
+      "vpmovzxbd   0x8(%0),%%ymm2                \n"
+      "lea         0x10(%0),%0                   \n" INTEGRAL16_AVX2
+      "sub         $0x10,%3                      \n"
+      "jge         16b                           \n"
+
+      "49:         \n"
+      "add         $0xf,%3                       \n"
+      "jl          19f                           \n"
+
+      // 1 pixel loop.
+      LABELALIGN
+      "10:         \n"
+      "vpinsrb     $0x0,(%0),%%xmm7,%%xmm1       \n"
+      "lea         0x1(%0),%0                    \n" INTEGRAL1_AVX2
+      "sub         $0x1,%3                       \n"
+      "jge         10b                           \n"
+      "19:         \n"
+      "vzeroupper  \n"
+      : "+r"(src),       // %0
+        "+r"(dst),       // %1
+        "+r"(previous),  // %2
+        "+r"(width)      // %3
+      :
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_INTEGRALROW_AVX2
+
+#ifdef HAS_INTEGRALSQUAREDROW_AVX2
+// Integral image row of squares, 16 pixels per loop.
+void IntegralSquaredRow_AVX2(const uint8_t* src,
+                             uint32_t* dst,
+                             const uint32_t* previous,
+                             int width) {
+  asm volatile(
+      "vpxor       %%ymm0,%%ymm0,%%ymm0          \n"  // running sum
+      "vpxor       %%xmm7,%%xmm7,%%xmm7          \n"
+      "vpcmpeqb    %%ymm6,%%ymm6,%%ymm6          \n"
+      "vpsrld      $0x1d,%%ymm6,%%ymm6           \n"  // 7
+      "sub         $0x10,%3                      \n"
+      "jl          49f                           \n"
+
+      // 16 pixel loop.
+      LABELALIGN
+      "16:         \n"
+      "vpmovzxbd   (%0),%%ymm1                   \n"
+      "vpmovzxbd   0x8(%0),%%ymm2                \n"
+      "lea         0x10(%0),%0                   \n"
+      "vpmaddwd    %%ymm1,%%ymm1,%%ymm1          \n"  // square
+      "vpmaddwd    %%ymm2,%%ymm2,%%ymm2          \n" INTEGRAL16_AVX2
+      "sub         $0x10,%3                      \n"
+      "jge         16b                           \n"
+
+      "49:         \n"
+      "add         $0xf,%3                       \n"
+      "jl          19f                           \n"
+
+      // 1 pixel loop.
+      LABELALIGN
+      "10:         \n"
+      "vpinsrb     $0x0,(%0),%%xmm7,%%xmm1       \n"
+      "lea         0x1(%0),%0                    \n"
+      "vpmaddwd    %%xmm1,%%xmm1,%%xmm1          \n" INTEGRAL1_AVX2
+      "sub         $0x1,%3                       \n"
+      "jge         10b                           \n"
+      "19:         \n"
+      "vzeroupper  \n"
+      : "+r"(src),       // %0
+        "+r"(dst),       // %1
+        "+r"(previous),  // %2
+        "+r"(width)      // %3
+      :
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_INTEGRALSQUAREDROW_AVX2
+
+#ifdef HAS_ARGBAFFINEROW_SSE2
+// Copy ARGB pixels from source image with slope to a row of destination.
+LIBYUV_API
+void ARGBAffineRow_SSE2(const uint8_t* src_argb,
+                        int src_argb_stride,
+                        uint8_t* dst_argb,
+                        const float* src_dudv,
+                        int width) {
+  ptrdiff_t src_argb_stride_temp = src_argb_stride;
+  intptr_t temp;
+  asm volatile(
+      "movq        (%3),%%xmm2                   \n"
+      "movq        0x08(%3),%%xmm7               \n"
+      "shl         $0x10,%1                      \n"
+      "add         $0x4,%1                       \n"
+      "movd        %1,%%xmm5                     \n"
+      "sub         $0x4,%4                       \n"
+      "jl          49f                           \n"
+
+      "pshufd      $0x44,%%xmm7,%%xmm7           \n"
+      "pshufd      $0x0,%%xmm5,%%xmm5            \n"
+      "movdqa      %%xmm2,%%xmm0                 \n"
+      "addps       %%xmm7,%%xmm0                 \n"
+      "movlhps     %%xmm0,%%xmm2                 \n"
+      "movdqa      %%xmm7,%%xmm4                 \n"
+      "addps       %%xmm4,%%xmm4                 \n"
+      "movdqa      %%xmm2,%%xmm3                 \n"
+      "addps       %%xmm4,%%xmm3                 \n"
+      "addps       %%xmm4,%%xmm4                 \n"
+
+      // 4 pixel loop
+      LABELALIGN
+      "40:         \n"
+      "cvttps2dq   %%xmm2,%%xmm0                 \n"  // x,y float->int first 2
+      "cvttps2dq   %%xmm3,%%xmm1                 \n"  // x,y float->int next 2
+      "packssdw    %%xmm1,%%xmm0                 \n"  // x, y as 8 shorts
+      "pmaddwd     %%xmm5,%%xmm0                 \n"  // off = x*4 + y*stride
+      "movd        %%xmm0,%k1                    \n"
+      "pshufd      $0x39,%%xmm0,%%xmm0           \n"
+      "movd        %%xmm0,%k5                    \n"
+      "pshufd      $0x39,%%xmm0,%%xmm0           \n"
+      "movd        0x00(%0,%1,1),%%xmm1          \n"
+      "movd        0x00(%0,%5,1),%%xmm6          \n"
+      "punpckldq   %%xmm6,%%xmm1                 \n"
+      "addps       %%xmm4,%%xmm2                 \n"
+      "movq        %%xmm1,(%2)                   \n"
+      "movd        %%xmm0,%k1                    \n"
+      "pshufd      $0x39,%%xmm0,%%xmm0           \n"
+      "movd        %%xmm0,%k5                    \n"
+      "movd        0x00(%0,%1,1),%%xmm0          \n"
+      "movd        0x00(%0,%5,1),%%xmm6          \n"
+      "punpckldq   %%xmm6,%%xmm0                 \n"
       "addps       %%xmm4,%%xmm3                 \n"
       "movq        %%xmm0,0x08(%2)               \n"
       "lea         0x10(%2),%2                   \n"
@@ -9096,6 +9796,276 @@ void ARGBAffineRow_SSE2(const uint8_t* src_argb,
 }
 #endif  // HAS_ARGBAFFINEROW_SSE2
 
+#if defined(HAS_ARGBAFFINEROW_AVX2) || defined(HAS_ARGBAFFINEFILTERROW_AVX2)
+// Lane index for the first u, v of each vector.
+static const float kAffineLanes[16] = {0.f, 1.f, 2.f,  3.f,  4.f,  5.f,
+                                       6.f, 7.f, 8.f,  9.f,  10.f, 11.f,
+                                       12.f, 13.f, 14.f, 15.f};
+#endif
+
+#ifdef HAS_ARGBAFFINEROW_AVX2
+// Copy 8 ARGB pixels per loop with a gather.
+LIBYUV_API
+void ARGBAffineRow_AVX2(const uint8_t* src_argb,
+                        int src_argb_stride,
+                        uint8_t* dst_argb,
+                        const float* uv_dudv,
+                        int width) {
+  asm volatile(
+      "vbroadcastss (%3),%%ymm0                  \n"  // u
+      "vbroadcastss 0x4(%3),%%ymm1               \n"  // v
+      "vbroadcastss 0x8(%3),%%ymm2               \n"  // du
+      "vbroadcastss 0xc(%3),%%ymm3               \n"  // dv
+      "vmovups     (%5),%%ymm4                   \n"  // 0 .. 7
+      "vmulps      %%ymm4,%%ymm2,%%ymm5          \n"
+      "vmulps      %%ymm4,%%ymm3,%%ymm6          \n"
+      "vaddps      %%ymm5,%%ymm0,%%ymm0          \n"  // u + i * du
+      "vaddps      %%ymm6,%%ymm1,%%ymm1          \n"  // v + i * dv
+      "vaddps      %%ymm2,%%ymm2,%%ymm2          \n"  // du * 8
+      "vaddps      %%ymm3,%%ymm3,%%ymm3          \n"  // dv * 8
+      "vaddps      %%ymm2,%%ymm2,%%ymm2          \n"
+      "vaddps      %%ymm3,%%ymm3,%%ymm3          \n"
+      "vaddps      %%ymm2,%%ymm2,%%ymm2          \n"
+      "vaddps      %%ymm3,%%ymm3,%%ymm3          \n"
+      "vmovd       %4,%%xmm4                     \n"
+      "vpbroadcastd %%xmm4,%%ymm4                \n"  // stride
+
+      // 8 pixel loop.
+      LABELALIGN
+      "1:          \n"
+      "vcvttps2dq  %%ymm0,%%ymm5                 \n"  // x
+      "vcvttps2dq  %%ymm1,%%ymm6                 \n"  // y
+      "vpslld      $0x2,%%ymm5,%%ymm5            \n"  // x * 4 + y * stride
+      "vpmulld     %%ymm4,%%ymm6,%%ymm6          \n"
+      "vpaddd      %%ymm6,%%ymm5,%%ymm5          \n"
+      "vpcmpeqd    %%ymm7,%%ymm7,%%ymm7          \n"
+      "vpgatherdd  %%ymm7,(%0,%%ymm5,1),%%ymm6   \n"
+      "vaddps      %%ymm2,%%ymm0,%%ymm0          \n"
+      "vaddps      %%ymm3,%%ymm1,%%ymm1          \n"
+      "vmovdqu     %%ymm6,(%1)                   \n"
+      "lea         0x20(%1),%1                   \n"
+      "sub         $0x8,%2                       \n"
+      "jg          1b                            \n"
+      "vzeroupper  \n"
+      : "+r"(src_argb),        // %0
+        "+r"(dst_argb),        // %1
+        "+r"(width)            // %2
+      : "r"(uv_dudv),          // %3
+        "r"(src_argb_stride),  // %4
+        "r"(kAffineLanes)      // %5
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_ARGBAFFINEROW_AVX2
+
+#ifdef HAS_ARGBAFFINEROW_AVX512BW
+// Copy 16 ARGB pixels per loop with a gather.
+LIBYUV_API
+void ARGBAffineRow_AVX512BW(const uint8_t* src_argb,
+                            int src_argb_stride,
+                            uint8_t* dst_argb,
+                            const float* uv_dudv,
+                            int width) {
+  asm volatile(
+      "vbroadcastss (%3),%%zmm0                  \n"  // u
+      "vbroadcastss 0x4(%3),%%zmm1               \n"  // v
+      "vbroadcastss 0x8(%3),%%zmm2               \n"  // du
+      "vbroadcastss 0xc(%3),%%zmm3               \n"  // dv
+      "vmovups     (%5),%%zmm4                   \n"  // 0 .. 15
+      "vmulps      %%zmm4,%%zmm2,%%zmm5          \n"
+      "vmulps      %%zmm4,%%zmm3,%%zmm6          \n"
+      "vaddps      %%zmm5,%%zmm0,%%zmm0          \n"  // u + i * du
+      "vaddps      %%zmm6,%%zmm1,%%zmm1          \n"  // v + i * dv
+      "vaddps      %%zmm2,%%zmm2,%%zmm2          \n"  // du * 16
+      "vaddps      %%zmm3,%%zmm3,%%zmm3          \n"  // dv * 16
+      "vaddps      %%zmm2,%%zmm2,%%zmm2          \n"
+      "vaddps      %%zmm3,%%zmm3,%%zmm3          \n"
+      "vaddps      %%zmm2,%%zmm2,%%zmm2          \n"
+      "vaddps      %%zmm3,%%zmm3,%%zmm3          \n"
+      "vaddps      %%zmm2,%%zmm2,%%zmm2          \n"
+      "vaddps      %%zmm3,%%zmm3,%%zmm3          \n"
+      "vpbroadcastd %4,%%zmm4                    \n"  // stride
+
+      // 16 pixel loop.
+      LABELALIGN
+      "1:          \n"
+      "vcvttps2dq  %%zmm0,%%zmm5                 \n"  // x
+      "vcvttps2dq  %%zmm1,%%zmm6                 \n"  // y
+      "vpslld      $0x2,%%zmm5,%%zmm5            \n"  // x * 4 + y * stride
+      "vpmulld     %%zmm4,%%zmm6,%%zmm6          \n"
+      "vpaddd      %%zmm6,%%zmm5,%%zmm5          \n"
+      "kxnorw      %%k1,%%k1,%%k1                \n"
+      "vpgatherdd  (%0,%%zmm5,1),%%zmm6%{%%k1%}  \n"
+      "vaddps      %%zmm2,%%zmm0,%%zmm0          \n"
+      "vaddps      %%zmm3,%%zmm1,%%zmm1          \n"
+      "vmovdqu32   %%zmm6,(%1)                   \n"
+      "lea         0x40(%1),%1                   \n"
+      "sub         $0x10,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper  \n"
+      : "+r"(src_argb),        // %0
+        "+r"(dst_argb),        // %1
+        "+r"(width)            // %2
+      : "r"(uv_dudv),          // %3
+        "r"(src_argb_stride),  // %4
+        "r"(kAffineLanes)      // %5
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6"
+  // Mask registers are only known to the compiler when it targets AVX512.
+#if defined(__AVX512F__)
+        ,
+        "k1"
+#endif
+  );
+}
+#endif  // HAS_ARGBAFFINEROW_AVX512BW
+
+#ifdef HAS_ARGBAFFINEFILTERROW_AVX2
+// Interleave the left and right pixel of each gathered pair by channel.
+static const ulvec8 kShuffleAffinePairs = {
+    0u, 4u, 1u, 5u, 2u, 6u, 3u, 7u, 8u, 12u, 9u, 13u, 10u, 14u, 11u, 15u,
+    0u, 4u, 1u, 5u, 2u, 6u, 3u, 7u, 8u, 12u, 9u, 13u, 10u, 14u, 11u, 15u};
+
+// Repeat the weight pair of each pixel for its 4 channels.
+static const ulvec8 kShuffleAffineWeights = {
+    0u, 1u, 0u, 1u, 0u, 1u, 0u, 1u, 8u, 9u, 8u, 9u, 8u, 9u, 8u, 9u,
+    0u, 1u, 0u, 1u, 0u, 1u, 0u, 1u, 8u, 9u, 8u, 9u, 8u, 9u, 8u, 9u};
+
+static const lvec32 kAffineWeight64 = {64, 64, 64, 64, 64, 64, 64, 64};
+static const lvec16 kAffineRound32 = {32, 32, 32, 32, 32, 32, 32, 32,
+                                      32, 32, 32, 32, 32, 32, 32, 32};
+static const float kAffineFraction64 = 64.f;
+
+// Bilinear filter 8 ARGB pixels per loop.  Each pixel gathers its left and
+// right neighbours as one qword from the row and the row below.
+LIBYUV_API
+void ARGBAffineFilterRow_AVX2(const uint8_t* src_argb,
+                              int src_argb_stride,
+                              uint8_t* dst_argb,
+                              const float* uv_dudv,
+                              int width) {
+  asm volatile(
+      "vbroadcastss (%3),%%ymm0                  \n"  // u
+      "vbroadcastss 0x4(%3),%%ymm1               \n"  // v
+      "vbroadcastss 0x8(%3),%%ymm2               \n"  // du
+      "vbroadcastss 0xc(%3),%%ymm3               \n"  // dv
+      "vmovups     (%5),%%ymm4                   \n"  // 0 .. 7
+      "vmulps      %%ymm4,%%ymm2,%%ymm5          \n"
+      "vmulps      %%ymm4,%%ymm3,%%ymm6          \n"
+      "vaddps      %%ymm5,%%ymm0,%%ymm0          \n"  // u + i * du
+      "vaddps      %%ymm6,%%ymm1,%%ymm1          \n"  // v + i * dv
+      "vaddps      %%ymm2,%%ymm2,%%ymm2          \n"  // du * 8
+      "vaddps      %%ymm3,%%ymm3,%%ymm3          \n"  // dv * 8
+      "vaddps      %%ymm2,%%ymm2,%%ymm2          \n"
+      "vaddps      %%ymm3,%%ymm3,%%ymm3          \n"
+      "vaddps      %%ymm2,%%ymm2,%%ymm2          \n"
+      "vaddps      %%ymm3,%%ymm3,%%ymm3          \n"
+      "vmovd       %4,%%xmm4                     \n"
+      "vpbroadcastd %%xmm4,%%ymm4                \n"  // stride
+      "vbroadcastss %10,%%ymm15                  \n"  // 64.0
+
+      // 8 pixel loop.
+      LABELALIGN
+      "1:          \n"
+      "vcvttps2dq  %%ymm0,%%ymm5                 \n"  // x
+      "vcvttps2dq  %%ymm1,%%ymm6                 \n"  // y
+      "vcvtdq2ps   %%ymm5,%%ymm7                 \n"
+      "vcvtdq2ps   %%ymm6,%%ymm8                 \n"
+      "vsubps      %%ymm7,%%ymm0,%%ymm7          \n"  // fx = (u - x) * 64
+      "vsubps      %%ymm8,%%ymm1,%%ymm8          \n"  // fy = (v - y) * 64
+      "vmulps      %%ymm15,%%ymm7,%%ymm7         \n"
+      "vmulps      %%ymm15,%%ymm8,%%ymm8         \n"
+      "vcvttps2dq  %%ymm7,%%ymm7                 \n"
+      "vcvttps2dq  %%ymm8,%%ymm8                 \n"
+      "vpslld      $0x8,%%ymm7,%%ymm9            \n"  // bytes 64 - fx, fx
+      "vpsubd      %%ymm7,%%ymm9,%%ymm7          \n"
+      "vpaddd      %8,%%ymm7,%%ymm7              \n"
+      "vpslld      $0x8,%%ymm8,%%ymm9            \n"  // bytes 64 - fy, fy
+      "vpsubd      %%ymm8,%%ymm9,%%ymm8          \n"
+      "vpaddd      %8,%%ymm8,%%ymm8              \n"
+      "vpslld      $0x2,%%ymm5,%%ymm5            \n"  // x * 4 + y * stride
+      "vpmulld     %%ymm4,%%ymm6,%%ymm6          \n"
+      "vpaddd      %%ymm6,%%ymm5,%%ymm5          \n"
+      "vpaddd      %%ymm4,%%ymm5,%%ymm6          \n"  // row below
+      "vaddps      %%ymm2,%%ymm0,%%ymm0          \n"
+      "vaddps      %%ymm3,%%ymm1,%%ymm1          \n"
+
+      // Horizontal blend of pixels 0 to 3.
+      "vpmovzxdq   %%xmm7,%%ymm9                 \n"
+      "vpshufb     %7,%%ymm9,%%ymm9              \n"
+      "vpcmpeqd    %%ymm10,%%ymm10,%%ymm10       \n"
+      "vpgatherdq  %%ymm10,(%0,%%xmm5,1),%%ymm11 \n"
+      "vpcmpeqd    %%ymm10,%%ymm10,%%ymm10       \n"
+      "vpgatherdq  %%ymm10,(%0,%%xmm6,1),%%ymm12 \n"
+      "vpshufb     %6,%%ymm11,%%ymm11            \n"
+      "vpshufb     %6,%%ymm12,%%ymm12            \n"
+      "vpmaddubsw  %%ymm9,%%ymm11,%%ymm11        \n"
+      "vpmaddubsw  %%ymm9,%%ymm12,%%ymm12        \n"
+
+      // Horizontal blend of pixels 4 to 7.
+      "vextracti128 $0x1,%%ymm7,%%xmm7           \n"
+      "vextracti128 $0x1,%%ymm5,%%xmm5           \n"
+      "vextracti128 $0x1,%%ymm6,%%xmm6           \n"
+      "vpmovzxdq   %%xmm7,%%ymm9                 \n"
+      "vpshufb     %7,%%ymm9,%%ymm9              \n"
+      "vpcmpeqd    %%ymm10,%%ymm10,%%ymm10       \n"
+      "vpgatherdq  %%ymm10,(%0,%%xmm5,1),%%ymm13 \n"
+      "vpcmpeqd    %%ymm10,%%ymm10,%%ymm10       \n"
+      "vpgatherdq  %%ymm10,(%0,%%xmm6,1),%%ymm14 \n"
+      "vpshufb     %6,%%ymm13,%%ymm13            \n"
+      "vpshufb     %6,%%ymm14,%%ymm14            \n"
+      "vpmaddubsw  %%ymm9,%%ymm13,%%ymm13        \n"
+      "vpmaddubsw  %%ymm9,%%ymm14,%%ymm14        \n"
+
+      // Round to 8 bit and pair top with bottom.
+      "vpaddw      %9,%%ymm11,%%ymm11            \n"
+      "vpaddw      %9,%%ymm12,%%ymm12            \n"
+      "vpaddw      %9,%%ymm13,%%ymm13            \n"
+      "vpaddw      %9,%%ymm14,%%ymm14            \n"
+      "vpsrlw      $0x6,%%ymm11,%%ymm11          \n"
+      "vpsrlw      $0x6,%%ymm12,%%ymm12          \n"
+      "vpsrlw      $0x6,%%ymm13,%%ymm13          \n"
+      "vpsrlw      $0x6,%%ymm14,%%ymm14          \n"
+      "vpackuswb   %%ymm13,%%ymm11,%%ymm11       \n"  // mutates
+      "vpackuswb   %%ymm14,%%ymm12,%%ymm12       \n"
+      "vpunpcklbw  %%ymm12,%%ymm11,%%ymm13       \n"  // pixels 0 to 3
+      "vpunpckhbw  %%ymm12,%%ymm11,%%ymm14       \n"  // pixels 4 to 7
+
+      // Vertical blend.
+      "vpmovzxdq   %%xmm8,%%ymm9                 \n"
+      "vpshufb     %7,%%ymm9,%%ymm9              \n"
+      "vpmaddubsw  %%ymm9,%%ymm13,%%ymm13        \n"
+      "vextracti128 $0x1,%%ymm8,%%xmm8           \n"
+      "vpmovzxdq   %%xmm8,%%ymm9                 \n"
+      "vpshufb     %7,%%ymm9,%%ymm9              \n"
+      "vpmaddubsw  %%ymm9,%%ymm14,%%ymm14        \n"
+      "vpaddw      %9,%%ymm13,%%ymm13            \n"
+      "vpaddw      %9,%%ymm14,%%ymm14            \n"
+      "vpsrlw      $0x6,%%ymm13,%%ymm13          \n"
+      "vpsrlw      $0x6,%%ymm14,%%ymm14          \n"
+      "vpackuswb   %%ymm14,%%ymm13,%%ymm13       \n"  // mutates
+      "vpermq      $0xd8,%%ymm13,%%ymm13         \n"  // unmutates
+      "vmovdqu     %%ymm13,(%1)                  \n"
+      "lea         0x20(%1),%1                   \n"
+      "sub         $0x8,%2                       \n"
+      "jg          1b                            \n"
+      "vzeroupper  \n"
+      : "+r"(src_argb),              // %0
+        "+r"(dst_argb),              // %1
+        "+r"(width)                  // %2
+      : "r"(uv_dudv),                // %3
+        "r"(src_argb_stride),        // %4
+        "r"(kAffineLanes),           // %5
+        "m"(kShuffleAffinePairs),    // %6
+        "m"(kShuffleAffineWeights),  // %7
+        "m"(kAffineWeight64),        // %8
+        "m"(kAffineRound32),         // %9
+        "m"(kAffineFraction64)       // %10
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14",
+        "xmm15");
+}
+#endif  // HAS_ARGBAFFINEFILTERROW_AVX2
+
 #ifdef HAS_INTERPOLATEROW_AVX2
 // Bilinear filter 32x2 -> 32x1
 void InterpolateRow_AVX2(uint8_t* dst_ptr,
@@ -10185,6 +11155,427 @@ void Convert8To8Row_AVX2(const uint8_t* src_y,
 }
 #endif  // HAS_CONVERT16TO8ROW_AVX2
 
+#if defined(HAS_GAUSSROW_F32_AVX2) || defined(HAS_GAUSSCOL_F32_AVX2)
+static const float kGaussCoefficients[3] = {4.0f, 6.0f, 1.0f / 256.0f};
+#endif
+
+#ifdef HAS_GAUSSCOL_F32_AVX2
+// filter 5 rows with 1, 4, 6, 4, 1 coefficients to produce 1 row.
+// Requires FMA3.
+void GaussCol_F32_AVX2(const float* src0,
+                       const float* src1,
+                       const float* src2,
+                       const float* src3,
+                       const float* src4,
+                       float* dst,
+                       int width) {
+  asm volatile(
+      "vbroadcastss (%7),%%ymm6                  \n"  // 4
+      "vbroadcastss 4(%7),%%ymm7                 \n"  // 6
+      "sub         %0,%1                         \n"
+      "sub         %0,%2                         \n"
+      "sub         %0,%3                         \n"
+      "sub         %0,%4                         \n"
+      "sub         %0,%5                         \n"
+
+      // 16 pixel loop.
+      LABELALIGN
+      "1:          \n"
+      "vmovups     (%0),%%ymm0                   \n"  // src0 + src4
+      "vmovups     0x20(%0),%%ymm1               \n"
+      "vaddps      (%0,%4,1),%%ymm0,%%ymm0       \n"
+      "vaddps      0x20(%0,%4,1),%%ymm1,%%ymm1   \n"
+      "vmovups     (%0,%1,1),%%ymm2              \n"  // src1 + src3
+      "vmovups     0x20(%0,%1,1),%%ymm3          \n"
+      "vaddps      (%0,%3,1),%%ymm2,%%ymm2       \n"
+      "vaddps      0x20(%0,%3,1),%%ymm3,%%ymm3   \n"
+      "vfmadd231ps (%0,%2,1),%%ymm7,%%ymm0       \n"  // src2 * 6
+      "vfmadd231ps 0x20(%0,%2,1),%%ymm7,%%ymm1   \n"
+      "vfmadd231ps %%ymm6,%%ymm2,%%ymm0          \n"  // (src1 + src3) * 4
+      "vfmadd231ps %%ymm6,%%ymm3,%%ymm1          \n"
+      "vmovups     %%ymm0,(%0,%5,1)              \n"
+      "vmovups     %%ymm1,0x20(%0,%5,1)          \n"
+      "lea         0x40(%0),%0                   \n"
+      "sub         $0x10,%6                      \n"
+      "jg          1b                            \n"
+      "vzeroupper  \n"
+      : "+r"(src0),                // %0
+        "+r"(src1),                // %1
+        "+r"(src2),                // %2
+        "+r"(src3),                // %3
+        "+r"(src4),                // %4
+        "+r"(dst),                 // %5
+        "+r"(width)                // %6
+      : "r"(&kGaussCoefficients)  // %7
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm6", "xmm7");
+}
+#endif  // HAS_GAUSSCOL_F32_AVX2
+
+#ifdef HAS_GAUSSROW_F32_AVX2
+// filter 5 columns with 1, 4, 6, 4, 1 coefficients and divide by 256.
+// Requires FMA3.
+void GaussRow_F32_AVX2(const float* src, float* dst, int width) {
+  asm volatile(
+      "vbroadcastss (%3),%%ymm5                  \n"  // 4
+      "vbroadcastss 4(%3),%%ymm6                 \n"  // 6
+      "vbroadcastss 8(%3),%%ymm7                 \n"  // 1 / 256
+
+      // 16 pixel loop.
+      LABELALIGN
+      "1:          \n"
+      "vmovups     (%0),%%ymm0                   \n"  // src[0] + src[4]
+      "vmovups     0x20(%0),%%ymm1               \n"
+      "vaddps      0x10(%0),%%ymm0,%%ymm0        \n"
+      "vaddps      0x30(%0),%%ymm1,%%ymm1        \n"
+      "vmovups     0x4(%0),%%ymm2                \n"  // src[1] + src[3]
+      "vmovups     0x24(%0),%%ymm3               \n"
+      "vaddps      0xc(%0),%%ymm2,%%ymm2         \n"
+      "vaddps      0x2c(%0),%%ymm3,%%ymm3        \n"
+      "vfmadd231ps 0x8(%0),%%ymm6,%%ymm0         \n"  // src[2] * 6
+      "vfmadd231ps 0x28(%0),%%ymm6,%%ymm1        \n"
+      "vfmadd231ps %%ymm5,%%ymm2,%%ymm0          \n"  // (src[1] + src[3]) * 4
+      "vfmadd231ps %%ymm5,%%ymm3,%%ymm1          \n"
+      "vmulps      %%ymm7,%%ymm0,%%ymm0          \n"
+      "vmulps      %%ymm7,%%ymm1,%%ymm1          \n"
+      "vmovups     %%ymm0,(%1)                   \n"
+      "vmovups     %%ymm1,0x20(%1)               \n"
+      "lea         0x40(%0),%0                   \n"
+      "lea         0x40(%1),%1                   \n"
+      "sub         $0x10,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper  \n"
+      : "+r"(src),                 // %0
+        "+r"(dst),                 // %1
+        "+r"(width)                // %2
+      : "r"(&kGaussCoefficients)  // %3
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_GAUSSROW_F32_AVX2
+
+#ifdef HAS_GAUSSCOL_F32_AVX512BW
+void GaussCol_F32_AVX512BW(const float* src0,
+                           const float* src1,
+                           const float* src2,
+                           const float* src3,
+                           const float* src4,
+                           float* dst,
+                           int width) {
+  asm volatile(
+      "vbroadcastss (%7),%%zmm6                  \n"  // 4
+      "vbroadcastss 4(%7),%%zmm7                 \n"  // 6
+      "sub         %0,%1                         \n"
+      "sub         %0,%2                         \n"
+      "sub         %0,%3                         \n"
+      "sub         %0,%4                         \n"
+      "sub         %0,%5                         \n"
+
+      // 32 pixel loop.
+      LABELALIGN
+      "1:          \n"
+      "vmovups     (%0),%%zmm0                   \n"  // src0 + src4
+      "vmovups     0x40(%0),%%zmm1               \n"
+      "vaddps      (%0,%4,1),%%zmm0,%%zmm0       \n"
+      "vaddps      0x40(%0,%4,1),%%zmm1,%%zmm1   \n"
+      "vmovups     (%0,%1,1),%%zmm2              \n"  // src1 + src3
+      "vmovups     0x40(%0,%1,1),%%zmm3          \n"
+      "vaddps      (%0,%3,1),%%zmm2,%%zmm2       \n"
+      "vaddps      0x40(%0,%3,1),%%zmm3,%%zmm3   \n"
+      "vfmadd231ps (%0,%2,1),%%zmm7,%%zmm0       \n"  // src2 * 6
+      "vfmadd231ps 0x40(%0,%2,1),%%zmm7,%%zmm1   \n"
+      "vfmadd231ps %%zmm6,%%zmm2,%%zmm0          \n"  // (src1 + src3) * 4
+      "vfmadd231ps %%zmm6,%%zmm3,%%zmm1          \n"
+      "vmovups     %%zmm0,(%0,%5,1)              \n"
+      "vmovups     %%zmm1,0x40(%0,%5,1)          \n"
+      "lea         0x80(%0),%0                   \n"
+      "sub         $0x20,%6                      \n"
+      "jg          1b                            \n"
+      "vzeroupper  \n"
+      : "+r"(src0),                // %0
+        "+r"(src1),                // %1
+        "+r"(src2),                // %2
+        "+r"(src3),                // %3
+        "+r"(src4),                // %4
+        "+r"(dst),                 // %5
+        "+r"(width)                // %6
+      : "r"(&kGaussCoefficients)  // %7
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm6", "xmm7");
+}
+#endif  // HAS_GAUSSCOL_F32_AVX512BW
+
+#ifdef HAS_GAUSSROW_F32_AVX512BW
+void GaussRow_F32_AVX512BW(const float* src, float* dst, int width) {
+  asm volatile(
+      "vbroadcastss (%3),%%zmm5                  \n"  // 4
+      "vbroadcastss 4(%3),%%zmm6                 \n"  // 6
+      "vbroadcastss 8(%3),%%zmm7                 \n"  // 1 / 256
+
+      // 32 pixel loop.
+      LABELALIGN
+      "1:          \n"
+      "vmovups     (%0),%%zmm0                   \n"  // src[0] + src[4]
+      "vmovups     0x40(%0),%%zmm1               \n"
+      "vaddps      0x10(%0),%%zmm0,%%zmm0        \n"
+      "vaddps      0x50(%0),%%zmm1,%%zmm1        \n"
+      "vmovups     0x4(%0),%%zmm2                \n"  // src[1] + src[3]
+      "vmovups     0x44(%0),%%zmm3               \n"
+      "vaddps      0xc(%0),%%zmm2,%%zmm2         \n"
+      "vaddps      0x4c(%0),%%zmm3,%%zmm3        \n"
+      "vfmadd231ps 0x8(%0),%%zmm6,%%zmm0         \n"  // src[2] * 6
+      "vfmadd231ps 0x48(%0),%%zmm6,%%zmm1        \n"
+      "vfmadd231ps %%zmm5,%%zmm2,%%zmm0          \n"  // (src[1] + src[3]) * 4
+      "vfmadd231ps %%zmm5,%%zmm3,%%zmm1          \n"
+      "vmulps      %%zmm7,%%zmm0,%%zmm0          \n"
+      "vmulps      %%zmm7,%%zmm1,%%zmm1          \n"
+      "vmovups     %%zmm0,(%1)                   \n"
+      "vmovups     %%zmm1,0x40(%1)               \n"
+      "lea         0x80(%0),%0                   \n"
+      "lea         0x80(%1),%1                   \n"
+      "sub         $0x20,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper  \n"
+      : "+r"(src),                 // %0
+        "+r"(dst),                 // %1
+        "+r"(width)                // %2
+      : "r"(&kGaussCoefficients)  // %3
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_GAUSSROW_F32_AVX512BW
+
+#ifdef HAS_GAUSSCOL_AVX2
+// filter 5 rows of 16 bit with 1, 4, 6, 4, 1 coefficients to 32 bit.
+void GaussCol_AVX2(const uint16_t* src0,
+                   const uint16_t* src1,
+                   const uint16_t* src2,
+                   const uint16_t* src3,
+                   const uint16_t* src4,
+                   uint32_t* dst,
+                   int width) {
+  asm volatile(
+      "sub         %0,%1                         \n"
+      "sub         %0,%2                         \n"
+      "sub         %0,%3                         \n"
+      "sub         %0,%4                         \n"
+
+      // 16 pixel loop.
+      LABELALIGN
+      "1:          \n"
+      "vpmovzxwd   (%0),%%ymm0                   \n"  // src0 + src4
+      "vpmovzxwd   0x10(%0),%%ymm1               \n"
+      "vpmovzxwd   (%0,%4,1),%%ymm2              \n"
+      "vpmovzxwd   0x10(%0,%4,1),%%ymm3          \n"
+      "vpaddd      %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddd      %%ymm3,%%ymm1,%%ymm1          \n"
+      "vpmovzxwd   (%0,%1,1),%%ymm2              \n"  // (src1 + src3) * 4
+      "vpmovzxwd   0x10(%0,%1,1),%%ymm3          \n"
+      "vpmovzxwd   (%0,%3,1),%%ymm4              \n"
+      "vpmovzxwd   0x10(%0,%3,1),%%ymm5          \n"
+      "vpaddd      %%ymm4,%%ymm2,%%ymm2          \n"
+      "vpaddd      %%ymm5,%%ymm3,%%ymm3          \n"
+      "vpslld      $0x2,%%ymm2,%%ymm2            \n"
+      "vpslld      $0x2,%%ymm3,%%ymm3            \n"
+      "vpaddd      %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddd      %%ymm3,%%ymm1,%%ymm1          \n"
+      "vpmovzxwd   (%0,%2,1),%%ymm2              \n"  // src2 * 6
+      "vpmovzxwd   0x10(%0,%2,1),%%ymm3          \n"
+      "vpslld      $0x1,%%ymm2,%%ymm2            \n"
+      "vpslld      $0x1,%%ymm3,%%ymm3            \n"
+      "vpaddd      %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddd      %%ymm3,%%ymm1,%%ymm1          \n"
+      "vpslld      $0x1,%%ymm2,%%ymm2            \n"
+      "vpslld      $0x1,%%ymm3,%%ymm3            \n"
+      "vpaddd      %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddd      %%ymm3,%%ymm1,%%ymm1          \n"
+      "vmovdqu     %%ymm0,(%5)                   \n"
+      "vmovdqu     %%ymm1,0x20(%5)               \n"
+      "lea         0x20(%0),%0                   \n"
+      "lea         0x40(%5),%5                   \n"
+      "sub         $0x10,%6                      \n"
+      "jg          1b                            \n"
+      "vzeroupper  \n"
+      : "+r"(src0),  // %0
+        "+r"(src1),  // %1
+        "+r"(src2),  // %2
+        "+r"(src3),  // %3
+        "+r"(src4),  // %4
+        "+r"(dst),   // %5
+        "+r"(width)  // %6
+      :
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5");
+}
+#endif  // HAS_GAUSSCOL_AVX2
+
+#ifdef HAS_GAUSSROW_AVX2
+// filter 5 columns of 32 bit with 1, 4, 6, 4, 1 coefficients to 16 bit.
+void GaussRow_AVX2(const uint32_t* src, uint16_t* dst, int width) {
+  asm volatile(
+      "vpcmpeqb    %%ymm5,%%ymm5,%%ymm5          \n"  // 128 for rounding
+      "vpsrld      $0x1f,%%ymm5,%%ymm5           \n"
+      "vpslld      $0x7,%%ymm5,%%ymm5            \n"
+
+      // 16 pixel loop.
+      LABELALIGN
+      "1:          \n"
+      "vmovdqu     (%0),%%ymm0                   \n"  // src[0] + src[4]
+      "vmovdqu     0x20(%0),%%ymm1               \n"
+      "vpaddd      0x10(%0),%%ymm0,%%ymm0        \n"
+      "vpaddd      0x30(%0),%%ymm1,%%ymm1        \n"
+      "vmovdqu     0x4(%0),%%ymm2                \n"  // (src[1] + src[3]) * 4
+      "vmovdqu     0x24(%0),%%ymm3               \n"
+      "vpaddd      0xc(%0),%%ymm2,%%ymm2         \n"
+      "vpaddd      0x2c(%0),%%ymm3,%%ymm3        \n"
+      "vpslld      $0x2,%%ymm2,%%ymm2            \n"
+      "vpslld      $0x2,%%ymm3,%%ymm3            \n"
+      "vpaddd      %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddd      %%ymm3,%%ymm1,%%ymm1          \n"
+      "vmovdqu     0x8(%0),%%ymm2                \n"  // src[2] * 6
+      "vmovdqu     0x28(%0),%%ymm3               \n"
+      "vpslld      $0x1,%%ymm2,%%ymm2            \n"
+      "vpslld      $0x1,%%ymm3,%%ymm3            \n"
+      "vpaddd      %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddd      %%ymm3,%%ymm1,%%ymm1          \n"
+      "vpslld      $0x1,%%ymm2,%%ymm2            \n"
+      "vpslld      $0x1,%%ymm3,%%ymm3            \n"
+      "vpaddd      %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddd      %%ymm3,%%ymm1,%%ymm1          \n"
+      "vpaddd      %%ymm5,%%ymm0,%%ymm0          \n"  // + 128 >> 8
+      "vpaddd      %%ymm5,%%ymm1,%%ymm1          \n"
+      "vpsrld      $0x8,%%ymm0,%%ymm0            \n"
+      "vpsrld      $0x8,%%ymm1,%%ymm1            \n"
+      "vpackusdw   %%ymm1,%%ymm0,%%ymm0          \n"  // mutates
+      "vpermq      $0xd8,%%ymm0,%%ymm0           \n"  // unmutates
+      "vmovdqu     %%ymm0,(%1)                   \n"
+      "lea         0x40(%0),%0                   \n"
+      "lea         0x20(%1),%1                   \n"
+      "sub         $0x10,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper  \n"
+      : "+r"(src),   // %0
+        "+r"(dst),   // %1
+        "+r"(width)  // %2
+      :
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm5");
+}
+#endif  // HAS_GAUSSROW_AVX2
+
+#ifdef HAS_GAUSSCOL_8_AVX2
+// filter 5 rows of 8 bit with 1, 4, 6, 4, 1 coefficients to 16 bit.
+void GaussCol_8_AVX2(const uint8_t* src0,
+                     const uint8_t* src1,
+                     const uint8_t* src2,
+                     const uint8_t* src3,
+                     const uint8_t* src4,
+                     uint16_t* dst,
+                     int width) {
+  asm volatile(
+      "sub         %0,%1                         \n"
+      "sub         %0,%2                         \n"
+      "sub         %0,%3                         \n"
+      "sub         %0,%4                         \n"
+
+      // 32 pixel loop.
+      LABELALIGN
+      "1:          \n"
+      "vpmovzxbw   (%0),%%ymm0                   \n"  // src0 + src4
+      "vpmovzxbw   0x10(%0),%%ymm1               \n"
+      "vpmovzxbw   (%0,%4,1),%%ymm2              \n"
+      "vpmovzxbw   0x10(%0,%4,1),%%ymm3          \n"
+      "vpaddw      %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddw      %%ymm3,%%ymm1,%%ymm1          \n"
+      "vpmovzxbw   (%0,%1,1),%%ymm2              \n"  // (src1 + src3) * 4
+      "vpmovzxbw   0x10(%0,%1,1),%%ymm3          \n"
+      "vpmovzxbw   (%0,%3,1),%%ymm4              \n"
+      "vpmovzxbw   0x10(%0,%3,1),%%ymm5          \n"
+      "vpaddw      %%ymm4,%%ymm2,%%ymm2          \n"
+      "vpaddw      %%ymm5,%%ymm3,%%ymm3          \n"
+      "vpsllw      $0x2,%%ymm2,%%ymm2            \n"
+      "vpsllw      $0x2,%%ymm3,%%ymm3            \n"
+      "vpaddw      %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddw      %%ymm3,%%ymm1,%%ymm1          \n"
+      "vpmovzxbw   (%0,%2,1),%%ymm2              \n"  // src2 * 6
+      "vpmovzxbw   0x10(%0,%2,1),%%ymm3          \n"
+      "vpsllw      $0x1,%%ymm2,%%ymm2            \n"
+      "vpsllw      $0x1,%%ymm3,%%ymm3            \n"
+      "vpaddw      %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddw      %%ymm3,%%ymm1,%%ymm1          \n"
+      "vpsllw      $0x1,%%ymm2,%%ymm2            \n"
+      "vpsllw      $0x1,%%ymm3,%%ymm3            \n"
+      "vpaddw      %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddw      %%ymm3,%%ymm1,%%ymm1          \n"
+      "vmovdqu     %%ymm0,(%5)                   \n"
+      "vmovdqu     %%ymm1,0x20(%5)               \n"
+      "lea         0x20(%0),%0                   \n"
+      "lea         0x40(%5),%5                   \n"
+      "sub         $0x20,%6                      \n"
+      "jg          1b                            \n"
+      "vzeroupper  \n"
+      : "+r"(src0),  // %0
+        "+r"(src1),  // %1
+        "+r"(src2),  // %2
+        "+r"(src3),  // %3
+        "+r"(src4),  // %4
+        "+r"(dst),   // %5
+        "+r"(width)  // %6
+      :
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5");
+}
+#endif  // HAS_GAUSSCOL_8_AVX2
+
+#ifdef HAS_GAUSSROW_8_AVX2
+// filter 5 columns of 16 bit with 1, 4, 6, 4, 1 coefficients to 8 bit.
+// Source values are sums from GaussCol_8 so 16 bit does not overflow.
+void GaussRow_8_AVX2(const uint16_t* src, uint8_t* dst, int width) {
+  asm volatile(
+      "vpcmpeqb    %%ymm5,%%ymm5,%%ymm5          \n"  // 128 for rounding
+      "vpsrlw      $0xf,%%ymm5,%%ymm5            \n"
+      "vpsllw      $0x7,%%ymm5,%%ymm5            \n"
+
+      // 32 pixel loop.
+      LABELALIGN
+      "1:          \n"
+      "vmovdqu     (%0),%%ymm0                   \n"  // src[0] + src[4]
+      "vmovdqu     0x20(%0),%%ymm1               \n"
+      "vpaddw      0x8(%0),%%ymm0,%%ymm0         \n"
+      "vpaddw      0x28(%0),%%ymm1,%%ymm1        \n"
+      "vmovdqu     0x2(%0),%%ymm2                \n"  // (src[1] + src[3]) * 4
+      "vmovdqu     0x22(%0),%%ymm3               \n"
+      "vpaddw      0x6(%0),%%ymm2,%%ymm2         \n"
+      "vpaddw      0x26(%0),%%ymm3,%%ymm3        \n"
+      "vpsllw      $0x2,%%ymm2,%%ymm2            \n"
+      "vpsllw      $0x2,%%ymm3,%%ymm3            \n"
+      "vpaddw      %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddw      %%ymm3,%%ymm1,%%ymm1          \n"
+      "vmovdqu     0x4(%0),%%ymm2                \n"  // src[2] * 6
+      "vmovdqu     0x24(%0),%%ymm3               \n"
+      "vpsllw      $0x1,%%ymm2,%%ymm2            \n"
+      "vpsllw      $0x1,%%ymm3,%%ymm3            \n"
+      "vpaddw      %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddw      %%ymm3,%%ymm1,%%ymm1          \n"
+      "vpsllw      $0x1,%%ymm2,%%ymm2            \n"
+      "vpsllw      $0x1,%%ymm3,%%ymm3            \n"
+      "vpaddw      %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddw      %%ymm3,%%ymm1,%%ymm1          \n"
+      "vpaddw      %%ymm5,%%ymm0,%%ymm0          \n"  // + 128 >> 8
+      "vpaddw      %%ymm5,%%ymm1,%%ymm1          \n"
+      "vpsrlw      $0x8,%%ymm0,%%ymm0            \n"
+      "vpsrlw      $0x8,%%ymm1,%%ymm1            \n"
+      "vpackuswb   %%ymm1,%%ymm0,%%ymm0          \n"  // mutates
+      "vpermq      $0xd8,%%ymm0,%%ymm0           \n"  // unmutates
+      "vmovdqu     %%ymm0,(%1)                   \n"
+      "lea         0x40(%0),%0                   \n"
+      "lea         0x20(%1),%1                   \n"
+      "sub         $0x20,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper  \n"
+      : "+r"(src),   // %0
+        "+r"(dst),   // %1
+        "+r"(width)  // %2
+      :
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm5");
+}
+#endif  // HAS_GAUSSROW_8_AVX2
+
 #endif  // defined(__x86_64__) || defined(__i386__)
 
 #ifdef __cplusplus
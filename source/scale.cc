@@ -12,11 +12,13 @@
 
 #include <assert.h>
 #include <limits.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "libyuv/cpu_id.h"
 #include "libyuv/planar_functions.h"  // For CopyPlane
 #include "libyuv/row.h"
+#include "libyuv/row_dispatch.h"
 #include "libyuv/scale_row.h"
 #include "libyuv/scale_uv.h"  // For UVScale
 
@@ -32,6 +34,14 @@ static __inline int Abs(int v) {
 #define SUBSAMPLE(v, a, s) (v < 0) ? (-((-v + a) >> s)) : ((v + a) >> s)
 #define CENTERSTART(dx, s) (dx < 0) ? -((-dx >> 1) + s) : ((dx >> 1) + s)
 
+// Source y coordinate (16.16) of destination row j for a scaler that starts
+// at y, steps by dy and clamps at max_y.  Used to start a band of rows part
+// way down the destination with the same y the full plane loop would reach.
+static __inline int ScaleBandY(int y, int dy, int j, int max_y) {
+  int64_t y64 = (int64_t)y + (int64_t)dy * j;
+  return (int)(y64 > max_y ? max_y : y64);
+}
+
 // Scale plane, 1/2
 // This is an optimized version for scaling down a plane to 1/2 of
 // its original size.
@@ -46,12 +56,11 @@ static void ScalePlaneDown2(int src_width,
                             uint8_t* dst_ptr,
                             enum FilterMode filtering) {
   int y;
-  void (*ScaleRowDown2)(const uint8_t* src_ptr, ptrdiff_t src_stride,
-                        uint8_t* dst_ptr, int dst_width) =
-      filtering == kFilterNone
-          ? ScaleRowDown2_C
-          : (filtering == kFilterLinear ? ScaleRowDown2Linear_C
-                                        : ScaleRowDown2Box_C);
+  const int kernel = filtering == kFilterNone     ? SCALEROWDOWN2_NONE
+                     : filtering == kFilterLinear ? SCALEROWDOWN2_LINEAR
+                                                  : SCALEROWDOWN2_BOX;
+  ScaleRowDown2Function ScaleRowDown2 =
+      ROW_KERNEL(GetRowDispatch()->ScaleRowDown2[kernel], dst_width);
   ptrdiff_t row_stride = src_stride * 2;
   (void)src_width;
   (void)src_height;
@@ -60,83 +69,6 @@ static void ScalePlaneDown2(int src_width,
     src_stride = 0;
   }
 
-#if defined(HAS_SCALEROWDOWN2_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    ScaleRowDown2 =
-        filtering == kFilterNone
-            ? ScaleRowDown2_Any_NEON
-            : (filtering == kFilterLinear ? ScaleRowDown2Linear_Any_NEON
-                                          : ScaleRowDown2Box_Any_NEON);
-    if (IS_ALIGNED(dst_width, 16)) {
-      ScaleRowDown2 = filtering == kFilterNone ? ScaleRowDown2_NEON
-                                               : (filtering == kFilterLinear
-                                                      ? ScaleRowDown2Linear_NEON
-                                                      : ScaleRowDown2Box_NEON);
-    }
-  }
-#endif
-#if defined(HAS_SCALEROWDOWN2_SME)
-  if (TestCpuFlag(kCpuHasSME)) {
-    ScaleRowDown2 = filtering == kFilterNone     ? ScaleRowDown2_SME
-                    : filtering == kFilterLinear ? ScaleRowDown2Linear_SME
-                                                 : ScaleRowDown2Box_SME;
-  }
-#endif
-#if defined(HAS_SCALEROWDOWN2_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3)) {
-    ScaleRowDown2 =
-        filtering == kFilterNone
-            ? ScaleRowDown2_Any_SSSE3
-            : (filtering == kFilterLinear ? ScaleRowDown2Linear_Any_SSSE3
-                                          : ScaleRowDown2Box_Any_SSSE3);
-    if (IS_ALIGNED(dst_width, 16)) {
-      ScaleRowDown2 =
-          filtering == kFilterNone
-              ? ScaleRowDown2_SSSE3
-              : (filtering == kFilterLinear ? ScaleRowDown2Linear_SSSE3
-                                            : ScaleRowDown2Box_SSSE3);
-    }
-  }
-#endif
-#if defined(HAS_SCALEROWDOWN2_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    ScaleRowDown2 =
-        filtering == kFilterNone
-            ? ScaleRowDown2_Any_AVX2
-            : (filtering == kFilterLinear ? ScaleRowDown2Linear_Any_AVX2
-                                          : ScaleRowDown2Box_Any_AVX2);
-    if (IS_ALIGNED(dst_width, 32)) {
-      ScaleRowDown2 = filtering == kFilterNone ? ScaleRowDown2_AVX2
-                                               : (filtering == kFilterLinear
-                                                      ? ScaleRowDown2Linear_AVX2
-                                                      : ScaleRowDown2Box_AVX2);
-    }
-  }
-#endif
-#if defined(HAS_SCALEROWDOWN2_LSX)
-  if (TestCpuFlag(kCpuHasLSX)) {
-    ScaleRowDown2 =
-        filtering == kFilterNone
-            ? ScaleRowDown2_Any_LSX
-            : (filtering == kFilterLinear ? ScaleRowDown2Linear_Any_LSX
-                                          : ScaleRowDown2Box_Any_LSX);
-    if (IS_ALIGNED(dst_width, 32)) {
-      ScaleRowDown2 = filtering == kFilterNone ? ScaleRowDown2_LSX
-                                               : (filtering == kFilterLinear
-                                                      ? ScaleRowDown2Linear_LSX
-                                                      : ScaleRowDown2Box_LSX);
-    }
-  }
-#endif
-#if defined(HAS_SCALEROWDOWN2_RVV)
-  if (TestCpuFlag(kCpuHasRVV)) {
-    ScaleRowDown2 = filtering == kFilterNone
-                        ? ScaleRowDown2_RVV
-                        : (filtering == kFilterLinear ? ScaleRowDown2Linear_RVV
-                                                      : ScaleRowDown2Box_RVV);
-  }
-#endif
-
   if (filtering == kFilterLinear) {
     src_stride = 0;
   }
@@ -854,259 +786,184 @@ static void ScaleAddCols1_16_C(int dst_width,
 // one pixel of destination using fixed point (16.16) to step
 // through source, sampling a box of pixel with simple
 // averaging.
-static int ScalePlaneBox(int src_width,
-                         int src_height,
-                         int dst_width,
-                         int dst_height,
-                         ptrdiff_t src_stride,
-                         ptrdiff_t dst_stride,
-                         const uint8_t* src_ptr,
-                         uint8_t* dst_ptr) {
-  int j, k;
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
-  const int max_y = (src_height << 16);
-  ScaleSlope(src_width, src_height, dst_width, dst_height, kFilterBox, &x, &y,
-             &dx, &dy);
-  src_width = Abs(src_width);
-  {
-    // Allocate a row buffer of uint16_t.
-    align_buffer_64(row16, src_width * 2);
-    if (!row16)
-      return 1;
-    void (*ScaleAddCols)(int dst_width, int boxheight, int x, int dx,
-                         const uint16_t* src_ptr, uint8_t* dst_ptr) =
-        (dx & 0xffff) ? ScaleAddCols2_C
-                      : ((dx != 0x10000) ? ScaleAddCols1_C : ScaleAddCols0_C);
-    void (*ScaleAddRow)(const uint8_t* src_ptr, uint16_t* dst_ptr,
-                        int src_width) = ScaleAddRow_C;
+// Select the row functions for ScalePlaneBox.
+static void ScalePlaneBoxInit(struct ScalePlan* plan) {
+  const int src_width = plan->src_width;
+  ScaleSlope(src_width, plan->src_height, plan->dst_width, plan->dst_height,
+             kFilterBox, &plan->x, &plan->y, &plan->dx, &plan->dy);
+  plan->ScaleAddCols =
+      (plan->dx & 0xffff)
+          ? ScaleAddCols2_C
+          : ((plan->dx != 0x10000) ? ScaleAddCols1_C : ScaleAddCols0_C);
+  plan->ScaleAddRow = ScaleAddRow_C;
 #if defined(HAS_SCALEADDROW_SSE2)
-    if (TestCpuFlag(kCpuHasSSE2)) {
-      ScaleAddRow = ScaleAddRow_Any_SSE2;
-      if (IS_ALIGNED(src_width, 16)) {
-        ScaleAddRow = ScaleAddRow_SSE2;
-      }
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    plan->ScaleAddRow = ScaleAddRow_Any_SSE2;
+    if (IS_ALIGNED(src_width, 16)) {
+      plan->ScaleAddRow = ScaleAddRow_SSE2;
     }
+  }
 #endif
 #if defined(HAS_SCALEADDROW_AVX2)
-    if (TestCpuFlag(kCpuHasAVX2)) {
-      ScaleAddRow = ScaleAddRow_Any_AVX2;
-      if (IS_ALIGNED(src_width, 32)) {
-        ScaleAddRow = ScaleAddRow_AVX2;
-      }
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    plan->ScaleAddRow = ScaleAddRow_Any_AVX2;
+    if (IS_ALIGNED(src_width, 32)) {
+      plan->ScaleAddRow = ScaleAddRow_AVX2;
     }
+  }
 #endif
 #if defined(HAS_SCALEADDROW_NEON)
-    if (TestCpuFlag(kCpuHasNEON)) {
-      ScaleAddRow = ScaleAddRow_Any_NEON;
-      if (IS_ALIGNED(src_width, 16)) {
-        ScaleAddRow = ScaleAddRow_NEON;
-      }
+  if (TestCpuFlag(kCpuHasNEON)) {
+    plan->ScaleAddRow = ScaleAddRow_Any_NEON;
+    if (IS_ALIGNED(src_width, 16)) {
+      plan->ScaleAddRow = ScaleAddRow_NEON;
     }
+  }
 #endif
 #if defined(HAS_SCALEADDROW_LSX)
-    if (TestCpuFlag(kCpuHasLSX)) {
-      ScaleAddRow = ScaleAddRow_Any_LSX;
-      if (IS_ALIGNED(src_width, 16)) {
-        ScaleAddRow = ScaleAddRow_LSX;
-      }
+  if (TestCpuFlag(kCpuHasLSX)) {
+    plan->ScaleAddRow = ScaleAddRow_Any_LSX;
+    if (IS_ALIGNED(src_width, 16)) {
+      plan->ScaleAddRow = ScaleAddRow_LSX;
     }
+  }
 #endif
 #if defined(HAS_SCALEADDROW_RVV)
-    if (TestCpuFlag(kCpuHasRVV)) {
-      ScaleAddRow = ScaleAddRow_RVV;
-    }
+  if (TestCpuFlag(kCpuHasRVV)) {
+    plan->ScaleAddRow = ScaleAddRow_RVV;
+  }
 #endif
+  // A row buffer of uint16_t.
+  plan->row_size = src_width * 2;
+}
 
-    for (j = 0; j < dst_height; ++j) {
-      int boxheight;
-      int iy = y >> 16;
-      const uint8_t* src = src_ptr + iy * src_stride;
-      y += dy;
-      if (y > max_y) {
-        y = max_y;
-      }
-      boxheight = MIN1((y >> 16) - iy);
-      memset(row16, 0, src_width * 2);
-      for (k = 0; k < boxheight; ++k) {
-        ScaleAddRow(src, (uint16_t*)(row16), src_width);
-        src += src_stride;
-      }
-      ScaleAddCols(dst_width, boxheight, x, dx, (uint16_t*)(row16), dst_ptr);
-      dst_ptr += dst_stride;
+static void ScalePlaneBox(const struct ScalePlan* plan,
+                          ptrdiff_t src_stride,
+                          ptrdiff_t dst_stride,
+                          const uint8_t* src_ptr,
+                          uint8_t* dst_ptr,
+                          int dst_y_begin,
+                          int dst_y_end,
+                          uint8_t* row16) {
+  int j, k;
+  const int src_width = plan->src_width;
+  const int dst_width = plan->dst_width;
+  const int x = plan->x;
+  const int dx = plan->dx;
+  const int dy = plan->dy;
+  const int max_y = (plan->src_height << 16);
+  int y = ScaleBandY(plan->y, dy, dst_y_begin, max_y);
+  dst_ptr += dst_y_begin * dst_stride;
+  for (j = dst_y_begin; j < dst_y_end; ++j) {
+    int boxheight;
+    int iy = y >> 16;
+    const uint8_t* src = src_ptr + iy * src_stride;
+    y += dy;
+    if (y > max_y) {
+      y = max_y;
+    }
+    boxheight = MIN1((y >> 16) - iy);
+    memset(row16, 0, src_width * 2);
+    for (k = 0; k < boxheight; ++k) {
+      plan->ScaleAddRow(src, (uint16_t*)(row16), src_width);
+      src += src_stride;
     }
-    free_aligned_buffer_64(row16);
+    plan->ScaleAddCols(dst_width, boxheight, x, dx, (uint16_t*)(row16),
+                       dst_ptr);
+    dst_ptr += dst_stride;
   }
-  return 0;
 }
 
-static int ScalePlaneBox_16(int src_width,
-                            int src_height,
-                            int dst_width,
-                            int dst_height,
-                            ptrdiff_t src_stride,
-                            ptrdiff_t dst_stride,
-                            const uint16_t* src_ptr,
-                            uint16_t* dst_ptr) {
-  int j, k;
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
-  const int max_y = (src_height << 16);
-  ScaleSlope(src_width, src_height, dst_width, dst_height, kFilterBox, &x, &y,
-             &dx, &dy);
-  src_width = Abs(src_width);
-  {
-    // Allocate a row buffer of uint32_t.
-    align_buffer_64(row32, src_width * 4);
-    if (!row32)
-      return 1;
-    void (*ScaleAddCols)(int dst_width, int boxheight, int x, int dx,
-                         const uint32_t* src_ptr, uint16_t* dst_ptr) =
-        (dx & 0xffff) ? ScaleAddCols2_16_C : ScaleAddCols1_16_C;
-    void (*ScaleAddRow)(const uint16_t* src_ptr, uint32_t* dst_ptr,
-                        int src_width) = ScaleAddRow_16_C;
-
+static void ScalePlaneBoxInit_16(struct ScalePlan* plan) {
+  const int src_width = plan->src_width;
+  ScaleSlope(src_width, plan->src_height, plan->dst_width, plan->dst_height,
+             kFilterBox, &plan->x, &plan->y, &plan->dx, &plan->dy);
+  plan->ScaleAddCols_16 =
+      (plan->dx & 0xffff) ? ScaleAddCols2_16_C : ScaleAddCols1_16_C;
+  plan->ScaleAddRow_16 = ScaleAddRow_16_C;
 #if defined(HAS_SCALEADDROW_16_SSE2)
-    if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(src_width, 16)) {
-      ScaleAddRow = ScaleAddRow_16_SSE2;
-    }
+  if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(src_width, 16)) {
+    plan->ScaleAddRow_16 = ScaleAddRow_16_SSE2;
+  }
 #endif
+  // A row buffer of uint32_t.
+  plan->row_size = src_width * 4;
+}
 
-    for (j = 0; j < dst_height; ++j) {
-      int boxheight;
-      int iy = y >> 16;
-      const uint16_t* src = src_ptr + iy * src_stride;
-      y += dy;
-      if (y > max_y) {
-        y = max_y;
-      }
-      boxheight = MIN1((y >> 16) - iy);
-      memset(row32, 0, src_width * 4);
-      for (k = 0; k < boxheight; ++k) {
-        ScaleAddRow(src, (uint32_t*)(row32), src_width);
-        src += src_stride;
-      }
-      ScaleAddCols(dst_width, boxheight, x, dx, (uint32_t*)(row32), dst_ptr);
-      dst_ptr += dst_stride;
+static void ScalePlaneBox_16(const struct ScalePlan* plan,
+                             ptrdiff_t src_stride,
+                             ptrdiff_t dst_stride,
+                             const uint16_t* src_ptr,
+                             uint16_t* dst_ptr,
+                             uint8_t* row32) {
+  int j, k;
+  const int src_width = plan->src_width;
+  const int max_y = (plan->src_height << 16);
+  int y = plan->y;
+  for (j = 0; j < plan->dst_height; ++j) {
+    int boxheight;
+    int iy = y >> 16;
+    const uint16_t* src = src_ptr + iy * src_stride;
+    y += plan->dy;
+    if (y > max_y) {
+      y = max_y;
+    }
+    boxheight = MIN1((y >> 16) - iy);
+    memset(row32, 0, src_width * 4);
+    for (k = 0; k < boxheight; ++k) {
+      plan->ScaleAddRow_16(src, (uint32_t*)(row32), src_width);
+      src += src_stride;
     }
-    free_aligned_buffer_64(row32);
+    plan->ScaleAddCols_16(plan->dst_width, boxheight, plan->x, plan->dx,
+                          (uint32_t*)(row32), dst_ptr);
+    dst_ptr += dst_stride;
   }
-  return 0;
 }
 
 // Scale plane down with bilinear interpolation.
-static int ScalePlaneBilinearDown(int src_width,
-                                  int src_height,
-                                  int dst_width,
-                                  int dst_height,
-                                  ptrdiff_t src_stride,
-                                  ptrdiff_t dst_stride,
-                                  const uint8_t* src_ptr,
-                                  uint8_t* dst_ptr,
-                                  enum FilterMode filtering) {
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
+// Select the row functions for ScalePlaneBilinearDown.
+static void ScalePlaneBilinearDownInit(struct ScalePlan* plan) {
+  const struct RowDispatch* dispatch = GetRowDispatch();
+  const int src_width = plan->src_width;
+  const int dst_width = plan->dst_width;
+  ScaleSlope(src_width, plan->src_height, dst_width, plan->dst_height,
+             plan->filtering, &plan->x, &plan->y, &plan->dx, &plan->dy);
+  plan->ScaleCols = (src_width >= 32768)
+                        ? ScaleFilterCols64_C
+                        : ROW_KERNEL(dispatch->ScaleFilterCols, dst_width);
+  plan->InterpolateRow = ROW_KERNEL(dispatch->InterpolateRow, src_width);
   // TODO(fbarchard): Consider not allocating row buffer for kFilterLinear.
-  // Allocate a row buffer.
-  align_buffer_64(row, src_width);
-  if (!row)
-    return 1;
+  plan->row_size = src_width;
+}
 
-  const int max_y = (src_height - 1) << 16;
+// Scale plane down with bilinear interpolation.
+static void ScalePlaneBilinearDown(const struct ScalePlan* plan,
+                                   ptrdiff_t src_stride,
+                                   ptrdiff_t dst_stride,
+                                   const uint8_t* src_ptr,
+                                   uint8_t* dst_ptr,
+                                   int dst_y_begin,
+                                   int dst_y_end,
+                                   uint8_t* row) {
   int j;
-  void (*ScaleFilterCols)(uint8_t* dst_ptr, const uint8_t* src_ptr,
-                          int dst_width, int x, int dx) =
-      (src_width >= 32768) ? ScaleFilterCols64_C : ScaleFilterCols_C;
-  void (*InterpolateRow)(uint8_t* dst_ptr, const uint8_t* src_ptr,
-                         ptrdiff_t src_stride, int dst_width,
-                         int source_y_fraction) = InterpolateRow_C;
-  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering, &x, &y,
-             &dx, &dy);
-  src_width = Abs(src_width);
-
-#if defined(HAS_INTERPOLATEROW_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    InterpolateRow = InterpolateRow_Any_AVX2;
-    if (IS_ALIGNED(src_width, 32)) {
-      InterpolateRow = InterpolateRow_AVX2;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    InterpolateRow = InterpolateRow_Any_NEON;
-    if (IS_ALIGNED(src_width, 16)) {
-      InterpolateRow = InterpolateRow_NEON;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_SVE2)
-  if (TestCpuFlag(kCpuHasSVE2)) {
-    InterpolateRow = InterpolateRow_SVE2;
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_SME)
-  if (TestCpuFlag(kCpuHasSME)) {
-    InterpolateRow = InterpolateRow_SME;
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_LSX)
-  if (TestCpuFlag(kCpuHasLSX)) {
-    InterpolateRow = InterpolateRow_Any_LSX;
-    if (IS_ALIGNED(src_width, 32)) {
-      InterpolateRow = InterpolateRow_LSX;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_RVV)
-  if (TestCpuFlag(kCpuHasRVV)) {
-    InterpolateRow = InterpolateRow_RVV;
-  }
-#endif
-
-#if defined(HAS_SCALEFILTERCOLS_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
-    ScaleFilterCols = ScaleFilterCols_SSSE3;
-  }
-#endif
-#if defined(HAS_SCALEFILTERCOLS_NEON)
-  if (TestCpuFlag(kCpuHasNEON) && src_width < 32768) {
-    ScaleFilterCols = ScaleFilterCols_Any_NEON;
-    if (IS_ALIGNED(dst_width, 8)) {
-      ScaleFilterCols = ScaleFilterCols_NEON;
-    }
-  }
-#endif
-#if defined(HAS_SCALEFILTERCOLS_LSX)
-  if (TestCpuFlag(kCpuHasLSX) && src_width < 32768) {
-    ScaleFilterCols = ScaleFilterCols_Any_LSX;
-    if (IS_ALIGNED(dst_width, 16)) {
-      ScaleFilterCols = ScaleFilterCols_LSX;
-    }
-  }
-#endif
-  if (y > max_y) {
-    y = max_y;
-  }
-
-  for (j = 0; j < dst_height; ++j) {
+  const int src_width = plan->src_width;
+  const int dst_width = plan->dst_width;
+  const int x = plan->x;
+  const int dx = plan->dx;
+  const int dy = plan->dy;
+  const int max_y = (plan->src_height - 1) << 16;
+  int y = ScaleBandY(plan->y, dy, dst_y_begin, max_y);
+  dst_ptr += dst_y_begin * dst_stride;
+
+  for (j = dst_y_begin; j < dst_y_end; ++j) {
     int yi = y >> 16;
     const uint8_t* src = src_ptr + yi * src_stride;
-    if (filtering == kFilterLinear) {
-      ScaleFilterCols(dst_ptr, src, dst_width, x, dx);
+    if (plan->filtering == kFilterLinear) {
+      plan->ScaleCols(dst_ptr, src, dst_width, x, dx);
     } else {
       int yf = (y >> 8) & 255;
-      InterpolateRow(row, src, src_stride, src_width, yf);
-      ScaleFilterCols(dst_ptr, row, dst_width, x, dx);
+      plan->InterpolateRow(row, src, src_stride, src_width, yf);
+      plan->ScaleCols(dst_ptr, row, dst_width, x, dx);
     }
     dst_ptr += dst_stride;
     y += dy;
@@ -1114,260 +971,181 @@ static int ScalePlaneBilinearDown(int src_width,
       y = max_y;
     }
   }
-  free_aligned_buffer_64(row);
-  return 0;
 }
 
-static int ScalePlaneBilinearDown_16(int src_width,
-                                     int src_height,
-                                     int dst_width,
-                                     int dst_height,
-                                     ptrdiff_t src_stride,
-                                     ptrdiff_t dst_stride,
-                                     const uint16_t* src_ptr,
-                                     uint16_t* dst_ptr,
-                                     enum FilterMode filtering) {
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
-  // TODO(fbarchard): Consider not allocating row buffer for kFilterLinear.
-  // Allocate a row buffer.
-  align_buffer_64(row, src_width * 2);
-  if (!row)
-    return 1;
-
-  const int max_y = (src_height - 1) << 16;
-  int j;
-  void (*ScaleFilterCols)(uint16_t* dst_ptr, const uint16_t* src_ptr,
-                          int dst_width, int x, int dx) =
+static void ScalePlaneBilinearDownInit_16(struct ScalePlan* plan) {
+  const int src_width = plan->src_width;
+  ScaleSlope(src_width, plan->src_height, plan->dst_width, plan->dst_height,
+             plan->filtering, &plan->x, &plan->y, &plan->dx, &plan->dy);
+  plan->ScaleCols_16 =
       (src_width >= 32768) ? ScaleFilterCols64_16_C : ScaleFilterCols_16_C;
-  void (*InterpolateRow)(uint16_t* dst_ptr, const uint16_t* src_ptr,
-                         ptrdiff_t src_stride, int dst_width,
-                         int source_y_fraction) = InterpolateRow_16_C;
-  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering, &x, &y,
-             &dx, &dy);
-  src_width = Abs(src_width);
+  plan->InterpolateRow_16 = InterpolateRow_16_C;
 
 #if defined(HAS_INTERPOLATEROW_16_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
-    InterpolateRow = InterpolateRow_16_Any_SSSE3;
+    plan->InterpolateRow_16 = InterpolateRow_16_Any_SSSE3;
     if (IS_ALIGNED(src_width, 16)) {
-      InterpolateRow = InterpolateRow_16_SSSE3;
+      plan->InterpolateRow_16 = InterpolateRow_16_SSSE3;
     }
   }
 #endif
 #if defined(HAS_INTERPOLATEROW_16_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
-    InterpolateRow = InterpolateRow_16_Any_AVX2;
+    plan->InterpolateRow_16 = InterpolateRow_16_Any_AVX2;
     if (IS_ALIGNED(src_width, 32)) {
-      InterpolateRow = InterpolateRow_16_AVX2;
+      plan->InterpolateRow_16 = InterpolateRow_16_AVX2;
     }
   }
 #endif
 #if defined(HAS_INTERPOLATEROW_16_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
-    InterpolateRow = InterpolateRow_16_Any_NEON;
+    plan->InterpolateRow_16 = InterpolateRow_16_Any_NEON;
     if (IS_ALIGNED(src_width, 16)) {
-      InterpolateRow = InterpolateRow_16_NEON;
+      plan->InterpolateRow_16 = InterpolateRow_16_NEON;
     }
   }
 #endif
 #if defined(HAS_INTERPOLATEROW_16_SME)
   if (TestCpuFlag(kCpuHasSME)) {
-    InterpolateRow = InterpolateRow_16_SME;
+    plan->InterpolateRow_16 = InterpolateRow_16_SME;
   }
 #endif
 
 #if defined(HAS_SCALEFILTERCOLS_16_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
-    ScaleFilterCols = ScaleFilterCols_16_SSSE3;
+    plan->ScaleCols_16 = ScaleFilterCols_16_SSSE3;
   }
 #endif
+  // TODO(fbarchard): Consider not allocating row buffer for kFilterLinear.
+  plan->row_size = src_width * 2;
+}
+
+static void ScalePlaneBilinearDown_16(const struct ScalePlan* plan,
+                                      ptrdiff_t src_stride,
+                                      ptrdiff_t dst_stride,
+                                      const uint16_t* src_ptr,
+                                      uint16_t* dst_ptr,
+                                      uint8_t* row) {
+  int j;
+  const int max_y = (plan->src_height - 1) << 16;
+  int y = plan->y;
   if (y > max_y) {
     y = max_y;
   }
 
-  for (j = 0; j < dst_height; ++j) {
+  for (j = 0; j < plan->dst_height; ++j) {
     int yi = y >> 16;
     const uint16_t* src = src_ptr + yi * src_stride;
-    if (filtering == kFilterLinear) {
-      ScaleFilterCols(dst_ptr, src, dst_width, x, dx);
+    if (plan->filtering == kFilterLinear) {
+      plan->ScaleCols_16(dst_ptr, src, plan->dst_width, plan->x, plan->dx);
     } else {
       int yf = (y >> 8) & 255;
-      InterpolateRow((uint16_t*)row, src, src_stride, src_width, yf);
-      ScaleFilterCols(dst_ptr, (uint16_t*)row, dst_width, x, dx);
+      plan->InterpolateRow_16((uint16_t*)row, src, src_stride,
+                              plan->src_width, yf);
+      plan->ScaleCols_16(dst_ptr, (uint16_t*)row, plan->dst_width, plan->x,
+                         plan->dx);
     }
     dst_ptr += dst_stride;
-    y += dy;
+    y += plan->dy;
     if (y > max_y) {
       y = max_y;
     }
   }
-  free_aligned_buffer_64(row);
-  return 0;
 }
 
 // Scale up down with bilinear interpolation.
-static int ScalePlaneBilinearUp(int src_width,
-                                int src_height,
-                                int dst_width,
-                                int dst_height,
-                                ptrdiff_t src_stride,
-                                ptrdiff_t dst_stride,
-                                const uint8_t* src_ptr,
-                                uint8_t* dst_ptr,
-                                enum FilterMode filtering) {
-  assert(src_width > 0);
-  assert(src_height > 0);
-  assert(dst_width > 0);
-  assert(dst_height > 0);
-
-  int j;
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
-  const int max_y = (src_height - 1) << 16;
-  void (*InterpolateRow)(uint8_t* dst_ptr, const uint8_t* src_ptr,
-                         ptrdiff_t src_stride, int dst_width,
-                         int source_y_fraction) = InterpolateRow_C;
-  void (*ScaleFilterCols)(uint8_t* dst_ptr, const uint8_t* src_ptr,
-                          int dst_width, int x, int dx) =
-      filtering ? ScaleFilterCols_C : ScaleCols_C;
-  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering, &x, &y,
-             &dx, &dy);
-  assert(dy <= 65536);
-  src_width = Abs(src_width);
-
-#if defined(HAS_INTERPOLATEROW_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    InterpolateRow = InterpolateRow_Any_AVX2;
-    if (IS_ALIGNED(dst_width, 32)) {
-      InterpolateRow = InterpolateRow_AVX2;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    InterpolateRow = InterpolateRow_Any_NEON;
-    if (IS_ALIGNED(dst_width, 16)) {
-      InterpolateRow = InterpolateRow_NEON;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_SVE2)
-  if (TestCpuFlag(kCpuHasSVE2)) {
-    InterpolateRow = InterpolateRow_SVE2;
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_SME)
-  if (TestCpuFlag(kCpuHasSME)) {
-    InterpolateRow = InterpolateRow_SME;
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_RVV)
-  if (TestCpuFlag(kCpuHasRVV)) {
-    InterpolateRow = InterpolateRow_RVV;
-  }
-#endif
-
-  if (filtering && src_width >= 32768) {
-    ScaleFilterCols = ScaleFilterCols64_C;
-  }
-#if defined(HAS_SCALEFILTERCOLS_SSSE3)
-  if (filtering && TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
-    ScaleFilterCols = ScaleFilterCols_SSSE3;
-  }
-#endif
-#if defined(HAS_SCALEFILTERCOLS_NEON)
-  if (filtering && TestCpuFlag(kCpuHasNEON) && src_width < 32768) {
-    ScaleFilterCols = ScaleFilterCols_Any_NEON;
-    if (IS_ALIGNED(dst_width, 8)) {
-      ScaleFilterCols = ScaleFilterCols_NEON;
-    }
-  }
-#endif
-#if defined(HAS_SCALEFILTERCOLS_LSX)
-  if (filtering && TestCpuFlag(kCpuHasLSX) && src_width < 32768) {
-    ScaleFilterCols = ScaleFilterCols_Any_LSX;
-    if (IS_ALIGNED(dst_width, 16)) {
-      ScaleFilterCols = ScaleFilterCols_LSX;
-    }
-  }
-#endif
-  if (!filtering && src_width * 2 == dst_width && x < 0x8000) {
-    ScaleFilterCols = ScaleColsUp2_C;
+// Select the row functions for ScalePlaneBilinearUp.
+static void ScalePlaneBilinearUpInit(struct ScalePlan* plan) {
+  const struct RowDispatch* dispatch = GetRowDispatch();
+  const int src_width = plan->src_width;
+  const int dst_width = plan->dst_width;
+  ScaleSlope(src_width, plan->src_height, dst_width, plan->dst_height,
+             plan->filtering, &plan->x, &plan->y, &plan->dx, &plan->dy);
+  assert(plan->dy <= 65536);
+  plan->InterpolateRow = ROW_KERNEL(dispatch->InterpolateRow, dst_width);
+  plan->ScaleCols = ScaleCols_C;
+  if (plan->filtering) {
+    plan->ScaleCols = (src_width >= 32768)
+                          ? ScaleFilterCols64_C
+                          : ROW_KERNEL(dispatch->ScaleFilterCols, dst_width);
+  }
+  if (!plan->filtering && src_width * 2 == dst_width && plan->x < 0x8000) {
+    plan->ScaleCols = ScaleColsUp2_C;
 #if defined(HAS_SCALECOLS_SSE2)
     if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 8)) {
-      ScaleFilterCols = ScaleColsUp2_SSE2;
+      plan->ScaleCols = ScaleColsUp2_SSE2;
     }
 #endif
   }
+  // 2 row buffers.
+  plan->row_size = ((dst_width + 31) & ~31) * 2;
+}
 
-  if (y > max_y) {
-    y = max_y;
-  }
-  {
-    int yi = y >> 16;
-    const uint8_t* src = src_ptr + yi * src_stride;
-
-    // Allocate 2 row buffers.
-    const int row_size = (dst_width + 31) & ~31;
-    align_buffer_64(row, row_size * 2);
-    if (!row)
-      return 1;
-
-    uint8_t* rowptr = row;
-    ptrdiff_t rowstride = row_size;
-    int lasty = yi;
-
-    ScaleFilterCols(rowptr, src, dst_width, x, dx);
-    if (src_height > 1) {
-      src += src_stride;
-    }
-    ScaleFilterCols(rowptr + rowstride, src, dst_width, x, dx);
-    if (src_height > 2) {
-      src += src_stride;
+// Scale up down with bilinear interpolation.
+static void ScalePlaneBilinearUp(const struct ScalePlan* plan,
+                                 ptrdiff_t src_stride,
+                                 ptrdiff_t dst_stride,
+                                 const uint8_t* src_ptr,
+                                 uint8_t* dst_ptr,
+                                 int dst_y_begin,
+                                 int dst_y_end,
+                                 uint8_t* row) {
+  int j;
+  const int src_height = plan->src_height;
+  const int dst_width = plan->dst_width;
+  const int x = plan->x;
+  const int dx = plan->dx;
+  const int dy = plan->dy;
+  const int max_y = (src_height - 1) << 16;
+  int y = ScaleBandY(plan->y, dy, dst_y_begin, max_y);
+  int yi = y >> 16;
+  const uint8_t* src = src_ptr + yi * src_stride;
+  uint8_t* rowptr = row;
+  ptrdiff_t rowstride = (dst_width + 31) & ~31;
+  int lasty = yi;
+  dst_ptr += dst_y_begin * dst_stride;
+
+  plan->ScaleCols(rowptr, src, dst_width, x, dx);
+  if (yi + 1 < src_height) {
+    src += src_stride;
+  }
+  plan->ScaleCols(rowptr + rowstride, src, dst_width, x, dx);
+  if (yi + 2 < src_height) {
+    src += src_stride;
+  }
+
+  // 2-row rolling buffer:
+  // rowptr and (rowptr + rowstride) hold the scaled rows for yi and yi + 1.
+  // Because dy <= 65536 (dy <= 1.0 in 16.16), yi advances in unit steps.
+  // When yi != lasty:
+  // 1. Scale the next source row into the older buffer (rowptr).
+  // 2. Swap buffer pointers (rowptr += rowstride; rowstride = -rowstride;)
+  //    so rowptr points to yi and (rowptr + rowstride) points to yi + 1.
+  // 3. Advance src by 1 row if row yi + 2 exists ((y + 65536) < max_y),
+  //    otherwise clamp src at (src_height - 1) to avoid reading out of bounds.
+  for (j = dst_y_begin; j < dst_y_end; ++j) {
+    if (y > max_y) {
+      y = max_y;
     }
-
-    // 2-row rolling buffer:
-    // rowptr and (rowptr + rowstride) hold the scaled rows for yi and yi + 1.
-    // Because dy <= 65536 (dy <= 1.0 in 16.16), yi advances in unit steps.
-    // When yi != lasty:
-    // 1. Scale the next source row into the older buffer (rowptr).
-    // 2. Swap buffer pointers (rowptr += rowstride; rowstride = -rowstride;)
-    //    so rowptr points to yi and (rowptr + rowstride) points to yi + 1.
-    // 3. Advance src by 1 row if row yi + 2 exists ((y + 65536) < max_y),
-    //    otherwise clamp src at (src_height - 1) to avoid reading out of bounds.
-    for (j = 0; j < dst_height; ++j) {
-      if (y > max_y) {
-        y = max_y;
-      }
-      yi = y >> 16;
-      if (yi != lasty) {
-        ScaleFilterCols(rowptr, src, dst_width, x, dx);
-        rowptr += rowstride;
-        rowstride = -rowstride;
-        lasty = yi;
-        if ((y + 65536) < max_y) {
-          src += src_stride;
-        }
-      }
-      if (filtering == kFilterLinear) {
-        InterpolateRow(dst_ptr, rowptr, 0, dst_width, 0);
-      } else {
-        int yf = (y >> 8) & 255;
-        InterpolateRow(dst_ptr, rowptr, rowstride, dst_width, yf);
+    yi = y >> 16;
+    if (yi != lasty) {
+      plan->ScaleCols(rowptr, src, dst_width, x, dx);
+      rowptr += rowstride;
+      rowstride = -rowstride;
+      lasty = yi;
+      if ((y + 65536) < max_y) {
+        src += src_stride;
       }
-      dst_ptr += dst_stride;
-      y += dy;
     }
-    free_aligned_buffer_64(row);
+    if (plan->filtering == kFilterLinear) {
+      plan->InterpolateRow(dst_ptr, rowptr, 0, dst_width, 0);
+    } else {
+      int yf = (y >> 8) & 255;
+      plan->InterpolateRow(dst_ptr, rowptr, rowstride, dst_width, yf);
+    }
+    dst_ptr += dst_stride;
+    y += dy;
   }
-  return 0;
 }
 
 // Scale plane, horizontally up by 2 times.
@@ -1382,7 +1160,9 @@ static void ScalePlaneUp2_Linear(int src_width,
                                  ptrdiff_t src_stride,
                                  ptrdiff_t dst_stride,
                                  const uint8_t* src_ptr,
-                                 uint8_t* dst_ptr) {
+                                 uint8_t* dst_ptr,
+                                 int dst_y_begin,
+                                 int dst_y_end) {
   void (*ScaleRowUp)(const uint8_t* src_ptr, uint8_t* dst_ptr, int dst_width) =
       ScaleRowUp2_Linear_Any_C;
   int i;
@@ -1427,8 +1207,9 @@ static void ScalePlaneUp2_Linear(int src_width,
                dst_width);
   } else {
     dy = FixedDiv(src_height - 1, dst_height - 1);
-    y = (1 << 15) - 1;
-    for (i = 0; i < dst_height; ++i) {
+    y = ScaleBandY((1 << 15) - 1, dy, dst_y_begin, INT_MAX);
+    dst_ptr += dst_y_begin * dst_stride;
+    for (i = dst_y_begin; i < dst_y_end; ++i) {
       ScaleRowUp(src_ptr + (y >> 16) * src_stride, dst_ptr, dst_width);
       dst_ptr += dst_stride;
       y += dy;
@@ -1447,7 +1228,9 @@ static void ScalePlaneUp2_Bilinear(int src_width,
                                    ptrdiff_t src_stride,
                                    ptrdiff_t dst_stride,
                                    const uint8_t* src_ptr,
-                                   uint8_t* dst_ptr) {
+                                   uint8_t* dst_ptr,
+                                   int dst_y_begin,
+                                   int dst_y_end) {
   void (*Scale2RowUp)(const uint8_t* src_ptr, ptrdiff_t src_stride,
                       uint8_t* dst_ptr, ptrdiff_t dst_stride, int dst_width) =
       ScaleRowUp2_Bilinear_Any_C;
@@ -1487,16 +1270,23 @@ static void ScalePlaneUp2_Bilinear(int src_width,
   }
 #endif
 
-  Scale2RowUp(src_ptr, 0, dst_ptr, 0, dst_width);
-  dst_ptr += dst_stride;
-  for (x = 0; x < src_height - 1; ++x) {
+  // Source row pair x writes destination rows 2 * x + 1 and 2 * x + 2.  A
+  // band owns the pairs whose first row lies inside it, so adjacent bands
+  // never write the same destination row.
+  if (dst_y_begin == 0) {
+    Scale2RowUp(src_ptr, 0, dst_ptr, 0, dst_width);
+  }
+  x = dst_y_begin / 2;
+  src_ptr += x * src_stride;
+  dst_ptr += (2 * x + 1) * dst_stride;
+  for (; x < src_height - 1 && 2 * x + 1 < dst_y_end; ++x) {
     Scale2RowUp(src_ptr, src_stride, dst_ptr, dst_stride, dst_width);
     src_ptr += src_stride;
     // TODO(fbarchard): Test performance of writing one row of destination at a
     // time.
     dst_ptr += 2 * dst_stride;
   }
-  if (!(dst_height & 1)) {
+  if (!(dst_height & 1) && dst_y_end == dst_height) {
     Scale2RowUp(src_ptr, 0, dst_ptr, 0, dst_width);
   }
 }
@@ -1707,145 +1497,130 @@ static void ScalePlaneUp2_16_Bilinear(int src_width,
   }
 }
 
-static int ScalePlaneBilinearUp_16(int src_width,
-                                   int src_height,
-                                   int dst_width,
-                                   int dst_height,
-                                   ptrdiff_t src_stride,
-                                   ptrdiff_t dst_stride,
-                                   const uint16_t* src_ptr,
-                                   uint16_t* dst_ptr,
-                                   enum FilterMode filtering) {
-  assert(src_width > 0);
-  assert(src_height > 0);
-  assert(dst_width > 0);
-  assert(dst_height > 0);
-
-  int j;
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
-  const int max_y = (src_height - 1) << 16;
-  void (*InterpolateRow)(uint16_t* dst_ptr, const uint16_t* src_ptr,
-                         ptrdiff_t src_stride, int dst_width,
-                         int source_y_fraction) = InterpolateRow_16_C;
-  void (*ScaleFilterCols)(uint16_t* dst_ptr, const uint16_t* src_ptr,
-                          int dst_width, int x, int dx) =
-      filtering ? ScaleFilterCols_16_C : ScaleCols_16_C;
-  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering, &x, &y,
-             &dx, &dy);
-  assert(dy <= 65536);
-  src_width = Abs(src_width);
+static void ScalePlaneBilinearUpInit_16(struct ScalePlan* plan) {
+  const int src_width = plan->src_width;
+  const int dst_width = plan->dst_width;
+  ScaleSlope(src_width, plan->src_height, dst_width, plan->dst_height,
+             plan->filtering, &plan->x, &plan->y, &plan->dx, &plan->dy);
+  assert(plan->dy <= 65536);
+  plan->InterpolateRow_16 = InterpolateRow_16_C;
+  plan->ScaleCols_16 =
+      plan->filtering ? ScaleFilterCols_16_C : ScaleCols_16_C;
 
 #if defined(HAS_INTERPOLATEROW_16_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
-    InterpolateRow = InterpolateRow_16_Any_SSSE3;
+    plan->InterpolateRow_16 = InterpolateRow_16_Any_SSSE3;
     if (IS_ALIGNED(dst_width, 16)) {
-      InterpolateRow = InterpolateRow_16_SSSE3;
+      plan->InterpolateRow_16 = InterpolateRow_16_SSSE3;
     }
   }
 #endif
 #if defined(HAS_INTERPOLATEROW_16_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
-    InterpolateRow = InterpolateRow_16_Any_AVX2;
+    plan->InterpolateRow_16 = InterpolateRow_16_Any_AVX2;
     if (IS_ALIGNED(dst_width, 32)) {
-      InterpolateRow = InterpolateRow_16_AVX2;
+      plan->InterpolateRow_16 = InterpolateRow_16_AVX2;
     }
   }
 #endif
 #if defined(HAS_INTERPOLATEROW_16_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
-    InterpolateRow = InterpolateRow_16_Any_NEON;
+    plan->InterpolateRow_16 = InterpolateRow_16_Any_NEON;
     if (IS_ALIGNED(dst_width, 16)) {
-      InterpolateRow = InterpolateRow_16_NEON;
+      plan->InterpolateRow_16 = InterpolateRow_16_NEON;
     }
   }
 #endif
 #if defined(HAS_INTERPOLATEROW_16_SME)
   if (TestCpuFlag(kCpuHasSME)) {
-    InterpolateRow = InterpolateRow_16_SME;
+    plan->InterpolateRow_16 = InterpolateRow_16_SME;
   }
 #endif
 
-  if (filtering && src_width >= 32768) {
-    ScaleFilterCols = ScaleFilterCols64_16_C;
+  if (plan->filtering && src_width >= 32768) {
+    plan->ScaleCols_16 = ScaleFilterCols64_16_C;
   }
 #if defined(HAS_SCALEFILTERCOLS_16_SSSE3)
-  if (filtering && TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
-    ScaleFilterCols = ScaleFilterCols_16_SSSE3;
+  if (plan->filtering && TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
+    plan->ScaleCols_16 = ScaleFilterCols_16_SSSE3;
   }
 #endif
-  if (!filtering && src_width * 2 == dst_width && x < 0x8000) {
-    ScaleFilterCols = ScaleColsUp2_16_C;
+  if (!plan->filtering && src_width * 2 == dst_width && plan->x < 0x8000) {
+    plan->ScaleCols_16 = ScaleColsUp2_16_C;
 #if defined(HAS_SCALECOLS_16_SSE2)
     if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 8)) {
-      ScaleFilterCols = ScaleColsUp2_16_SSE2;
+      plan->ScaleCols_16 = ScaleColsUp2_16_SSE2;
     }
 #endif
   }
+  // 2 row buffers.
+  plan->row_size = ((dst_width + 31) & ~31) * 4;
+}
 
+static void ScalePlaneBilinearUp_16(const struct ScalePlan* plan,
+                                    ptrdiff_t src_stride,
+                                    ptrdiff_t dst_stride,
+                                    const uint16_t* src_ptr,
+                                    uint16_t* dst_ptr,
+                                    uint8_t* row) {
+  int j;
+  const int src_height = plan->src_height;
+  const int dst_width = plan->dst_width;
+  const int x = plan->x;
+  const int dx = plan->dx;
+  const int dy = plan->dy;
+  const int max_y = (src_height - 1) << 16;
+  int y = plan->y;
   if (y > max_y) {
     y = max_y;
   }
-  {
-    int yi = y >> 16;
-    const uint16_t* src = src_ptr + yi * src_stride;
-
-    // Allocate 2 row buffers.
-    const int row_size = (dst_width + 31) & ~31;
-    align_buffer_64(row, row_size * 4);
-    ptrdiff_t rowstride = row_size;
-    int lasty = yi;
-    uint16_t* rowptr = (uint16_t*)row;
-    if (!row)
-      return 1;
-
-    ScaleFilterCols(rowptr, src, dst_width, x, dx);
-    if (src_height > 1) {
-      src += src_stride;
-    }
-    ScaleFilterCols(rowptr + rowstride, src, dst_width, x, dx);
-    if (src_height > 2) {
-      src += src_stride;
+  int yi = y >> 16;
+  const uint16_t* src = src_ptr + yi * src_stride;
+  ptrdiff_t rowstride = (dst_width + 31) & ~31;
+  int lasty = yi;
+  uint16_t* rowptr = (uint16_t*)row;
+
+  plan->ScaleCols_16(rowptr, src, dst_width, x, dx);
+  if (src_height > 1) {
+    src += src_stride;
+  }
+  plan->ScaleCols_16(rowptr + rowstride, src, dst_width, x, dx);
+  if (src_height > 2) {
+    src += src_stride;
+  }
+
+  // 2-row rolling buffer:
+  // rowptr and (rowptr + rowstride) hold the scaled rows for yi and yi + 1.
+  // Because dy <= 65536 (dy <= 1.0 in 16.16), yi advances in unit steps.
+  // When yi != lasty:
+  // 1. Scale the next source row into the older buffer (rowptr).
+  // 2. Swap buffer pointers (rowptr += rowstride; rowstride = -rowstride;)
+  //    so rowptr points to yi and (rowptr + rowstride) points to yi + 1.
+  // 3. Advance src by 1 row if row yi + 2 exists ((y + 65536) < max_y),
+  //    otherwise clamp src at (src_height - 1) to avoid reading out of bounds.
+  for (j = 0; j < plan->dst_height; ++j) {
+    if (y > max_y) {
+      y = max_y;
     }
-
-    // 2-row rolling buffer:
-    // rowptr and (rowptr + rowstride) hold the scaled rows for yi and yi + 1.
-    // Because dy <= 65536 (dy <= 1.0 in 16.16), yi advances in unit steps.
-    // When yi != lasty:
-    // 1. Scale the next source row into the older buffer (rowptr).
-    // 2. Swap buffer pointers (rowptr += rowstride; rowstride = -rowstride;)
-    //    so rowptr points to yi and (rowptr + rowstride) points to yi + 1.
-    // 3. Advance src by 1 row if row yi + 2 exists ((y + 65536) < max_y),
-    //    otherwise clamp src at (src_height - 1) to avoid reading out of bounds.
-    for (j = 0; j < dst_height; ++j) {
-      if (y > max_y) {
-        y = max_y;
-      }
-      yi = y >> 16;
-      if (yi != lasty) {
-        ScaleFilterCols(rowptr, src, dst_width, x, dx);
-        rowptr += rowstride;
-        rowstride = -rowstride;
-        lasty = yi;
-        if ((y + 65536) < max_y) {
-          src += src_stride;
-        }
-      }
-      if (filtering == kFilterLinear) {
-        InterpolateRow(dst_ptr, rowptr, 0, dst_width, 0);
-      } else {
-        int yf = (y >> 8) & 255;
-        InterpolateRow(dst_ptr, rowptr, rowstride, dst_width, yf);
+    yi = y >> 16;
+    if (yi != lasty) {
+      plan->ScaleCols_16(rowptr, src, dst_width, x, dx);
+      rowptr += rowstride;
+      rowstride = -rowstride;
+      lasty = yi;
+      if ((y + 65536) < max_y) {
+        src += src_stride;
       }
-      dst_ptr += dst_stride;
-      y += dy;
     }
-    free_aligned_buffer_64(row);
+    if (plan->filtering == kFilterLinear) {
+      plan->InterpolateRow_16(dst_ptr, rowptr, 0, dst_width, 0);
+    } else {
+      int yf = (y >> 8) & 255;
+      plan->InterpolateRow_16(dst_ptr, rowptr, rowstride, dst_width, yf);
+    }
+    dst_ptr += dst_stride;
+    y += dy;
   }
-  return 0;
 }
 
 // Scale Plane to/from any dimensions, without interpolation.
@@ -1853,298 +1628,498 @@ static int ScalePlaneBilinearUp_16(int src_width,
 // of x and dx is the integer part of the source position and
 // the lower 16 bits are the fixed decimal part.
 
-static void ScalePlaneSimple(int src_width,
-                             int src_height,
-                             int dst_width,
-                             int dst_height,
-                             ptrdiff_t src_stride,
-                             ptrdiff_t dst_stride,
-                             const uint8_t* src_ptr,
-                             uint8_t* dst_ptr) {
-  int i;
-  void (*ScaleCols)(uint8_t* dst_ptr, const uint8_t* src_ptr, int dst_width,
-                    int x, int dx) = ScaleCols_C;
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
-  ScaleSlope(src_width, src_height, dst_width, dst_height, kFilterNone, &x, &y,
-             &dx, &dy);
-  src_width = Abs(src_width);
-
-  if (src_width * 2 == dst_width && x < 0x8000) {
-    ScaleCols = ScaleColsUp2_C;
+static void ScalePlaneSimpleInit(struct ScalePlan* plan) {
+  ScaleSlope(plan->src_width, plan->src_height, plan->dst_width,
+             plan->dst_height, kFilterNone, &plan->x, &plan->y, &plan->dx,
+             &plan->dy);
+  plan->ScaleCols = ScaleCols_C;
+  if (plan->src_width * 2 == plan->dst_width && plan->x < 0x8000) {
+    plan->ScaleCols = ScaleColsUp2_C;
 #if defined(HAS_SCALECOLS_SSE2)
-    if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 8)) {
-      ScaleCols = ScaleColsUp2_SSE2;
+    if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(plan->dst_width, 8)) {
+      plan->ScaleCols = ScaleColsUp2_SSE2;
     }
 #endif
   }
+}
 
-  for (i = 0; i < dst_height; ++i) {
-    ScaleCols(dst_ptr, src_ptr + (y >> 16) * src_stride, dst_width, x, dx);
+static void ScalePlaneSimple(const struct ScalePlan* plan,
+                             ptrdiff_t src_stride,
+                             ptrdiff_t dst_stride,
+                             const uint8_t* src_ptr,
+                             uint8_t* dst_ptr,
+                             int dst_y_begin,
+                             int dst_y_end) {
+  int i;
+  int y = ScaleBandY(plan->y, plan->dy, dst_y_begin, INT_MAX);
+  dst_ptr += dst_y_begin * dst_stride;
+  for (i = dst_y_begin; i < dst_y_end; ++i) {
+    plan->ScaleCols(dst_ptr, src_ptr + (y >> 16) * src_stride,
+                    plan->dst_width, plan->x, plan->dx);
     dst_ptr += dst_stride;
-    y += dy;
+    y += plan->dy;
   }
 }
 
-static void ScalePlaneSimple_16(int src_width,
-                                int src_height,
-                                int dst_width,
-                                int dst_height,
-                                ptrdiff_t src_stride,
-                                ptrdiff_t dst_stride,
-                                const uint16_t* src_ptr,
-                                uint16_t* dst_ptr) {
-  int i;
-  void (*ScaleCols)(uint16_t* dst_ptr, const uint16_t* src_ptr, int dst_width,
-                    int x, int dx) = ScaleCols_16_C;
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
-  ScaleSlope(src_width, src_height, dst_width, dst_height, kFilterNone, &x, &y,
-             &dx, &dy);
-  src_width = Abs(src_width);
-
-  if (src_width * 2 == dst_width && x < 0x8000) {
-    ScaleCols = ScaleColsUp2_16_C;
+static void ScalePlaneSimpleInit_16(struct ScalePlan* plan) {
+  ScaleSlope(plan->src_width, plan->src_height, plan->dst_width,
+             plan->dst_height, kFilterNone, &plan->x, &plan->y, &plan->dx,
+             &plan->dy);
+  plan->ScaleCols_16 = ScaleCols_16_C;
+  if (plan->src_width * 2 == plan->dst_width && plan->x < 0x8000) {
+    plan->ScaleCols_16 = ScaleColsUp2_16_C;
 #if defined(HAS_SCALECOLS_16_SSE2)
-    if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 8)) {
-      ScaleCols = ScaleColsUp2_16_SSE2;
+    if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(plan->dst_width, 8)) {
+      plan->ScaleCols_16 = ScaleColsUp2_16_SSE2;
     }
 #endif
   }
+}
 
-  for (i = 0; i < dst_height; ++i) {
-    ScaleCols(dst_ptr, src_ptr + (y >> 16) * src_stride, dst_width, x, dx);
+static void ScalePlaneSimple_16(const struct ScalePlan* plan,
+                                ptrdiff_t src_stride,
+                                ptrdiff_t dst_stride,
+                                const uint16_t* src_ptr,
+                                uint16_t* dst_ptr) {
+  int i;
+  int y = plan->y;
+  for (i = 0; i < plan->dst_height; ++i) {
+    plan->ScaleCols_16(dst_ptr, src_ptr + (y >> 16) * src_stride,
+                       plan->dst_width, plan->x, plan->dx);
     dst_ptr += dst_stride;
-    y += dy;
+    y += plan->dy;
   }
 }
 
-// Scale a plane.
-// This function dispatches to a specialized scaler based on scale factor.
-LIBYUV_API
-int ScalePlane(const uint8_t* src,
-               int src_stride,
-               int src_width,
-               int src_height,
-               uint8_t* dst,
-               int dst_stride,
-               int dst_width,
-               int dst_height,
-               enum FilterMode filtering) {
-  // Reject dimensions larger than 32768 (or smaller than -32768 for height).
-  // This prevents FixedDiv signed integer overflows that can lead to division
-  // by zero/overflow crashes (SIGFPE on x86) or incorrect step calculations.
-  if (!src || src_width <= 0 || src_height == 0 || src_width > 32768 ||
-      src_height < -32768 || src_height > 32768 || !dst || dst_width <= 0 ||
-      dst_height <= 0) {
-    return -1;
-  }
-  // Simplify filtering when possible.
-  filtering = ScaleFilterReduce(src_width, src_height, dst_width, dst_height,
-                                filtering);
-
-  // Negative height means invert the image.
-  if (src_height < 0) {
-    src_height = -src_height;
-    src = src + (src_height - 1) * (ptrdiff_t)src_stride;
-    src_stride = -src_stride;
-  }
+// Choose the scaler for a plane.
+static enum ScaleMethod ScalePlaneMethod(int src_width,
+                                         int src_height,
+                                         int dst_width,
+                                         int dst_height,
+                                         enum FilterMode filtering) {
   // Use specialized scales to improve performance for common resolutions.
   // For example, all the 1/2 scalings will use ScalePlaneDown2()
   if (dst_width == src_width && dst_height == src_height) {
     // Straight copy.
-    CopyPlane(src, src_stride, dst, dst_stride, dst_width, dst_height);
-    return 0;
+    return kScaleMethodCopy;
+  }
+  if (filtering >= kFilterBicubic) {
+    return kScaleMethodPolyphase;
   }
   if (dst_width == src_width && filtering != kFilterBox) {
-    int dy = 0;
-    int y = 0;
-    // When scaling down, use the center 2 rows to filter.
-    // When scaling up, last row of destination uses the last 2 source rows.
-    if (dst_height <= src_height) {
-      dy = FixedDiv(src_height, dst_height);
-      y = CENTERSTART(dy, -32768);  // Subtract 0.5 (32768) to center filter.
-    } else if (src_height > 1 && dst_height > 1) {
-      dy = FixedDiv1(src_height, dst_height);
-    }
     // Arbitrary scale vertically, but unscaled horizontally.
-    ScalePlaneVertical(src_height, dst_width, dst_height, src_stride,
-                       dst_stride, src, dst, 0, y, dy, /*bpp=*/1, filtering);
-    return 0;
+    return kScaleMethodVertical;
   }
-  if (dst_width <= Abs(src_width) && dst_height <= src_height) {
+  if (dst_width <= src_width && dst_height <= src_height) {
     // Scale down.
     if (4 * dst_width == 3 * src_width && 4 * dst_height == 3 * src_height) {
       // optimized, 3/4
-      ScalePlaneDown34(src_width, src_height, dst_width, dst_height, src_stride,
-                       dst_stride, src, dst, filtering);
-      return 0;
+      return kScaleMethodDown34;
     }
     if (2 * dst_width == src_width && 2 * dst_height == src_height) {
       // optimized, 1/2
-      ScalePlaneDown2(src_width, src_height, dst_width, dst_height, src_stride,
-                      dst_stride, src, dst, filtering);
-      return 0;
+      return kScaleMethodDown2;
     }
     // 3/8 rounded up for odd sized chroma height.
     if (8 * dst_width == 3 * src_width && 8 * dst_height == 3 * src_height) {
       // optimized, 3/8
-      ScalePlaneDown38(src_width, src_height, dst_width, dst_height, src_stride,
-                       dst_stride, src, dst, filtering);
-      return 0;
+      return kScaleMethodDown38;
     }
     if (4 * dst_width == src_width && 4 * dst_height == src_height &&
         (filtering == kFilterBox || filtering == kFilterNone)) {
       // optimized, 1/4
-      ScalePlaneDown4(src_width, src_height, dst_width, dst_height, src_stride,
-                      dst_stride, src, dst, filtering);
-      return 0;
+      return kScaleMethodDown4;
     }
   }
   if (filtering == kFilterBox && dst_height * 2 < src_height) {
-    return ScalePlaneBox(src_width, src_height, dst_width, dst_height,
-                         src_stride, dst_stride, src, dst);
+    return kScaleMethodBox;
   }
   if ((dst_width + 1) / 2 == src_width && filtering == kFilterLinear) {
-    ScalePlaneUp2_Linear(src_width, src_height, dst_width, dst_height,
-                         src_stride, dst_stride, src, dst);
-    return 0;
+    return kScaleMethodUp2Linear;
   }
   if ((dst_height + 1) / 2 == src_height && (dst_width + 1) / 2 == src_width &&
       (filtering == kFilterBilinear || filtering == kFilterBox)) {
-    ScalePlaneUp2_Bilinear(src_width, src_height, dst_width, dst_height,
-                           src_stride, dst_stride, src, dst);
-    return 0;
+    return kScaleMethodUp2Bilinear;
   }
   if (filtering && dst_height > src_height) {
-    return ScalePlaneBilinearUp(src_width, src_height, dst_width, dst_height,
-                                src_stride, dst_stride, src, dst, filtering);
+    return kScaleMethodBilinearUp;
   }
   if (filtering) {
-    return ScalePlaneBilinearDown(src_width, src_height, dst_width, dst_height,
-                                  src_stride, dst_stride, src, dst, filtering);
+    return kScaleMethodBilinearDown;
   }
-  ScalePlaneSimple(src_width, src_height, dst_width, dst_height, src_stride,
-                   dst_stride, src, dst);
-  return 0;
+  return kScaleMethodSimple;
 }
 
-LIBYUV_API
-int ScalePlane_16(const uint16_t* src,
-                  int src_stride,
-                  int src_width,
-                  int src_height,
-                  uint16_t* dst,
-                  int dst_stride,
-                  int dst_width,
-                  int dst_height,
-                  enum FilterMode filtering) {
+int ScalePlanInitPlane(struct ScalePlan* plan,
+                       enum ScalePlanFormat format,
+                       int src_width,
+                       int src_height,
+                       int dst_width,
+                       int dst_height,
+                       enum FilterMode filtering) {
+  const int is_16 = format == kScalePlanPlane_16;
   // Reject dimensions larger than 32768 (or smaller than -32768 for height).
   // This prevents FixedDiv signed integer overflows that can lead to division
   // by zero/overflow crashes (SIGFPE on x86) or incorrect step calculations.
-  if (!src || src_width <= 0 || src_height == 0 || src_width > 32768 ||
-      src_height < -32768 || src_height > 32768 || !dst || dst_width <= 0 ||
+  if (src_width <= 0 || src_height == 0 || src_width > 32768 ||
+      src_height < -32768 || src_height > 32768 || dst_width <= 0 ||
       dst_height <= 0) {
     return -1;
   }
+  memset(plan, 0, sizeof(*plan));
   // Simplify filtering when possible.
   filtering = ScaleFilterReduce(src_width, src_height, dst_width, dst_height,
                                 filtering);
 
   // Negative height means invert the image.
-  if (src_height < 0) {
-    src_height = -src_height;
-    src = src + (src_height - 1) * (ptrdiff_t)src_stride;
-    src_stride = -src_stride;
-  }
-  // Use specialized scales to improve performance for common resolutions.
-  // For example, all the 1/2 scalings will use ScalePlaneDown2()
-  if (dst_width == src_width && dst_height == src_height) {
-    // Straight copy.
-    CopyPlane_16(src, src_stride, dst, dst_stride, dst_width, dst_height);
-    return 0;
+  plan->invert = src_height < 0;
+  src_height = Abs(src_height);
+  plan->format = format;
+  plan->src_width = src_width;
+  plan->src_height = src_height;
+  plan->dst_width = dst_width;
+  plan->dst_height = dst_height;
+  plan->filtering = filtering;
+  plan->method = ScalePlaneMethod(src_width, src_height, dst_width,
+                                  dst_height, filtering);
+  switch (plan->method) {
+    case kScaleMethodVertical:
+      // When scaling down, use the center 2 rows to filter.
+      // When scaling up, last row of destination uses the last 2 source rows.
+      if (dst_height <= src_height) {
+        plan->dy = FixedDiv(src_height, dst_height);
+        // Subtract 0.5 (32768) to center filter.
+        plan->y = CENTERSTART(plan->dy, -32768);
+      } else if (src_height > 1 && dst_height > 1) {
+        plan->dy = FixedDiv1(src_height, dst_height);
+      }
+      break;
+    case kScaleMethodBox:
+      if (is_16) {
+        ScalePlaneBoxInit_16(plan);
+      } else {
+        ScalePlaneBoxInit(plan);
+      }
+      break;
+    case kScaleMethodBilinearUp:
+      if (is_16) {
+        ScalePlaneBilinearUpInit_16(plan);
+      } else {
+        ScalePlaneBilinearUpInit(plan);
+      }
+      break;
+    case kScaleMethodBilinearDown:
+      if (is_16) {
+        ScalePlaneBilinearDownInit_16(plan);
+      } else {
+        ScalePlaneBilinearDownInit(plan);
+      }
+      break;
+    case kScaleMethodSimple:
+      if (is_16) {
+        ScalePlaneSimpleInit_16(plan);
+      } else {
+        ScalePlaneSimpleInit(plan);
+      }
+      break;
+    case kScaleMethodPolyphase:
+      ScalePolyphaseInit(plan, dst_width, dst_height);
+      break;
+    default:
+      break;
   }
-  if (dst_width == src_width && filtering != kFilterBox) {
-    int dy = 0;
-    int y = 0;
-    // When scaling down, use the center 2 rows to filter.
-    // When scaling up, last row of destination uses the last 2 source rows.
-    if (dst_height <= src_height) {
-      dy = FixedDiv(src_height, dst_height);
-      y = CENTERSTART(dy, -32768);  // Subtract 0.5 (32768) to center filter.
-      // When scaling up, ensure the last row of destination uses the last
-      // source. Avoid divide by zero for dst_height but will do no scaling
-      // later.
-    } else if (src_height > 1 && dst_height > 1) {
-      dy = FixedDiv1(src_height, dst_height);
-    }
-    // Arbitrary scale vertically, but unscaled horizontally.
-    ScalePlaneVertical_16(src_height, dst_width, dst_height, src_stride,
-                          dst_stride, src, dst, 0, y, dy, /*bpp=*/1, filtering);
-    return 0;
+  return 0;
+}
+
+// Scale rows [dst_y_begin, dst_y_end) of a plane.  Produces the same pixels
+// as scaling the whole plane, so a plane can be split into horizontal bands
+// and each band scaled independently.  dst_y_begin must be a multiple of 3
+// for the 3/4 and 3/8 scalers, which work on groups of 3 destination rows.
+// src and dst point to the first row of the full plane, already inverted if
+// the plan inverts.
+static void ScalePlaneRows(const struct ScalePlan* plan,
+                           const uint8_t* src,
+                           ptrdiff_t src_stride,
+                           uint8_t* dst,
+                           ptrdiff_t dst_stride,
+                           int dst_y_begin,
+                           int dst_y_end,
+                           uint8_t* row) {
+  const int src_width = plan->src_width;
+  const int src_height = plan->src_height;
+  const int dst_width = plan->dst_width;
+  const int dst_height = plan->dst_height;
+  const enum FilterMode filtering = plan->filtering;
+  const int band_height = dst_y_end - dst_y_begin;
+  uint8_t* dst_band = dst + dst_y_begin * dst_stride;
+  switch (plan->method) {
+    case kScaleMethodCopy:
+      CopyPlane(src + dst_y_begin * src_stride, (int)src_stride, dst_band,
+                (int)dst_stride, dst_width, band_height);
+      break;
+    case kScaleMethodVertical:
+      ScalePlaneVertical(src_height, dst_width, band_height, (int)src_stride,
+                         (int)dst_stride, src, dst_band, 0,
+                         ScaleBandY(plan->y, plan->dy, dst_y_begin, INT_MAX),
+                         plan->dy, /*bpp=*/1, filtering);
+      break;
+    case kScaleMethodDown34:
+      assert(dst_y_begin % 3 == 0);
+      ScalePlaneDown34(src_width, src_height, dst_width, band_height,
+                       src_stride, dst_stride,
+                       src + dst_y_begin / 3 * 4 * src_stride, dst_band,
+                       filtering);
+      break;
+    case kScaleMethodDown2:
+      ScalePlaneDown2(src_width, src_height, dst_width, band_height,
+                      src_stride, dst_stride,
+                      src + dst_y_begin * 2 * src_stride, dst_band, filtering);
+      break;
+    case kScaleMethodDown38:
+      assert(dst_y_begin % 3 == 0);
+      ScalePlaneDown38(src_width, src_height, dst_width, band_height,
+                       src_stride, dst_stride,
+                       src + dst_y_begin / 3 * 8 * src_stride, dst_band,
+                       filtering);
+      break;
+    case kScaleMethodDown4:
+      ScalePlaneDown4(src_width, src_height, dst_width, band_height,
+                      src_stride, dst_stride,
+                      src + dst_y_begin * 4 * src_stride, dst_band, filtering);
+      break;
+    case kScaleMethodBox:
+      ScalePlaneBox(plan, src_stride, dst_stride, src, dst, dst_y_begin,
+                    dst_y_end, row);
+      break;
+    case kScaleMethodUp2Linear:
+      ScalePlaneUp2_Linear(src_width, src_height, dst_width, dst_height,
+                           src_stride, dst_stride, src, dst, dst_y_begin,
+                           dst_y_end);
+      break;
+    case kScaleMethodUp2Bilinear:
+      ScalePlaneUp2_Bilinear(src_width, src_height, dst_width, dst_height,
+                             src_stride, dst_stride, src, dst, dst_y_begin,
+                             dst_y_end);
+      break;
+    case kScaleMethodBilinearUp:
+      ScalePlaneBilinearUp(plan, src_stride, dst_stride, src, dst,
+                           dst_y_begin, dst_y_end, row);
+      break;
+    case kScaleMethodBilinearDown:
+      ScalePlaneBilinearDown(plan, src_stride, dst_stride, src, dst,
+                             dst_y_begin, dst_y_end, row);
+      break;
+    case kScaleMethodPolyphase:
+      ScalePolyphase(plan, src, src_stride, dst_band, dst_stride, dst_y_begin,
+                     dst_y_end, row);
+      break;
+    default:
+      ScalePlaneSimple(plan, src_stride, dst_stride, src, dst, dst_y_begin,
+                       dst_y_end);
+      break;
   }
-  if (dst_width <= Abs(src_width) && dst_height <= src_height) {
-    // Scale down.
-    if (4 * dst_width == 3 * src_width && 4 * dst_height == 3 * src_height) {
-      // optimized, 3/4
+}
+
+static void ScalePlaneRows_16(const struct ScalePlan* plan,
+                              const uint16_t* src,
+                              ptrdiff_t src_stride,
+                              uint16_t* dst,
+                              ptrdiff_t dst_stride,
+                              uint8_t* row) {
+  const int src_width = plan->src_width;
+  const int src_height = plan->src_height;
+  const int dst_width = plan->dst_width;
+  const int dst_height = plan->dst_height;
+  const enum FilterMode filtering = plan->filtering;
+  switch (plan->method) {
+    case kScaleMethodCopy:
+      CopyPlane_16(src, (int)src_stride, dst, (int)dst_stride, dst_width,
+                   dst_height);
+      break;
+    case kScaleMethodVertical:
+      ScalePlaneVertical_16(src_height, dst_width, dst_height, (int)src_stride,
+                            (int)dst_stride, src, dst, 0, plan->y, plan->dy,
+                            /*bpp=*/1, filtering);
+      break;
+    case kScaleMethodDown34:
       ScalePlaneDown34_16(src_width, src_height, dst_width, dst_height,
                           src_stride, dst_stride, src, dst, filtering);
-      return 0;
-    }
-    if (2 * dst_width == src_width && 2 * dst_height == src_height) {
-      // optimized, 1/2
+      break;
+    case kScaleMethodDown2:
       ScalePlaneDown2_16(src_width, src_height, dst_width, dst_height,
                          src_stride, dst_stride, src, dst, filtering);
-      return 0;
-    }
-    // 3/8 rounded up for odd sized chroma height.
-    if (8 * dst_width == 3 * src_width && 8 * dst_height == 3 * src_height) {
-      // optimized, 3/8
+      break;
+    case kScaleMethodDown38:
       ScalePlaneDown38_16(src_width, src_height, dst_width, dst_height,
                           src_stride, dst_stride, src, dst, filtering);
-      return 0;
-    }
-    if (4 * dst_width == src_width && 4 * dst_height == src_height &&
-        (filtering == kFilterBox || filtering == kFilterNone)) {
-      // optimized, 1/4
+      break;
+    case kScaleMethodDown4:
       ScalePlaneDown4_16(src_width, src_height, dst_width, dst_height,
                          src_stride, dst_stride, src, dst, filtering);
+      break;
+    case kScaleMethodBox:
+      ScalePlaneBox_16(plan, src_stride, dst_stride, src, dst, row);
+      break;
+    case kScaleMethodUp2Linear:
+      ScalePlaneUp2_16_Linear(src_width, src_height, dst_width, dst_height,
+                              src_stride, dst_stride, src, dst);
+      break;
+    case kScaleMethodUp2Bilinear:
+      ScalePlaneUp2_16_Bilinear(src_width, src_height, dst_width, dst_height,
+                                src_stride, dst_stride, src, dst);
+      break;
+    case kScaleMethodBilinearUp:
+      ScalePlaneBilinearUp_16(plan, src_stride, dst_stride, src, dst, row);
+      break;
+    case kScaleMethodBilinearDown:
+      ScalePlaneBilinearDown_16(plan, src_stride, dst_stride, src, dst, row);
+      break;
+    case kScaleMethodPolyphase:
+      ScalePolyphase(plan, (const uint8_t*)src, src_stride * 2, (uint8_t*)dst,
+                     dst_stride * 2, 0, dst_height, row);
+      break;
+    default:
+      ScalePlaneSimple_16(plan, src_stride, dst_stride, src, dst);
+      break;
+  }
+}
+
+// Scale an image with a plan.  For 16 bit planes src and dst point to
+// uint16_t and the strides are in elements.
+static int ScalePlanRun(const struct ScalePlan* plan,
+                        const uint8_t* src,
+                        int src_stride,
+                        uint8_t* dst,
+                        int dst_stride,
+                        uint8_t* row) {
+  ptrdiff_t src_step = src_stride;
+  switch (plan->format) {
+    case kScalePlanARGB:
+      return ScalePlanRunARGB(plan, src, src_stride, dst, dst_stride, row);
+    case kScalePlanUV:
+      return ScalePlanRunUV(plan, src, src_stride, dst, dst_stride, row);
+    case kScalePlanPlane_16:
+      if (plan->invert) {
+        src += (plan->src_height - 1) * src_step * 2;
+        src_step = -src_step;
+      }
+      ScalePlaneRows_16(plan, (const uint16_t*)src, src_step, (uint16_t*)dst,
+                        dst_stride, row);
+      return 0;
+    default:
+      if (plan->invert) {
+        src += (plan->src_height - 1) * src_step;
+        src_step = -src_step;
+      }
+      ScalePlaneRows(plan, src, src_step, dst, dst_stride, 0,
+                     plan->dst_height, row);
       return 0;
-    }
   }
-  if (filtering == kFilterBox && dst_height * 2 < src_height) {
-    return ScalePlaneBox_16(src_width, src_height, dst_width, dst_height,
-                            src_stride, dst_stride, src, dst);
+}
+
+int ScalePlanRunOnce(const struct ScalePlan* plan,
+                     const uint8_t* src,
+                     int src_stride,
+                     uint8_t* dst,
+                     int dst_stride) {
+  int r;
+  if (plan->row_size == 0) {
+    return ScalePlanRun(plan, src, src_stride, dst, dst_stride, NULL);
   }
-  if ((dst_width + 1) / 2 == src_width && filtering == kFilterLinear) {
-    ScalePlaneUp2_16_Linear(src_width, src_height, dst_width, dst_height,
-                            src_stride, dst_stride, src, dst);
-    return 0;
+  {
+    align_buffer_64(row, plan->row_size);
+    if (!row)
+      return 1;
+    r = ScalePlanRun(plan, src, src_stride, dst, dst_stride, row);
+    free_aligned_buffer_64(row);
   }
-  if ((dst_height + 1) / 2 == src_height && (dst_width + 1) / 2 == src_width &&
-      (filtering == kFilterBilinear || filtering == kFilterBox)) {
-    ScalePlaneUp2_16_Bilinear(src_width, src_height, dst_width, dst_height,
-                              src_stride, dst_stride, src, dst);
-    return 0;
+  return r;
+}
+
+void ScalePlanRowRangePlane(const struct ScalePlan* plan,
+                            int dst_y_begin,
+                            int dst_y_end,
+                            int* src_y_begin,
+                            int* src_y_end) {
+  // Every other scaler reads rows within 3 rows of the source rows that the
+  // destination rows map to, including filter taps and 3/4 and 3/8 groups.
+  const int64_t src_height = plan->src_height;
+  const int64_t dst_height = plan->dst_height;
+  int64_t y_begin;
+  int64_t y_end;
+  if (plan->method == kScaleMethodPolyphase) {
+    ScalePolyphaseRowRange(plan, dst_y_begin, dst_y_end, src_y_begin,
+                           src_y_end);
+    return;
+  }
+  y_begin = dst_y_begin * src_height / dst_height - 3;
+  y_end = (dst_y_end * src_height + dst_height - 1) / dst_height + 3;
+  y_begin = y_begin < 0 ? 0 : y_begin;
+  y_begin = y_begin > src_height - 1 ? src_height - 1 : y_begin;
+  y_end = y_end > src_height ? src_height : y_end;
+  y_end = y_end <= y_begin ? y_begin + 1 : y_end;
+  *src_y_begin = (int)y_begin;
+  *src_y_end = (int)y_end;
+}
+
+int ScalePlanRunBandPlane(const struct ScalePlan* plan,
+                          int dst_y_begin,
+                          int dst_y_end,
+                          const uint8_t* src,
+                          int src_stride,
+                          int src_y_begin,
+                          uint8_t* dst,
+                          int dst_stride,
+                          uint8_t* row) {
+  if (plan->format != kScalePlanPlane || plan->invert) {
+    return -1;
   }
-  if (filtering && dst_height > src_height) {
-    return ScalePlaneBilinearUp_16(src_width, src_height, dst_width, dst_height,
-                                   src_stride, dst_stride, src, dst, filtering);
+  // Rows are addressed from row 0 of the source and destination.
+  ScalePlaneRows(plan, src - (ptrdiff_t)src_y_begin * src_stride, src_stride,
+                 dst - (ptrdiff_t)dst_y_begin * dst_stride, dst_stride,
+                 dst_y_begin, dst_y_end, row);
+  return 0;
+}
+
+// Scale a plane.
+// This function dispatches to a specialized scaler based on scale factor.
+LIBYUV_API
+int ScalePlane(const uint8_t* src,
+               int src_stride,
+               int src_width,
+               int src_height,
+               uint8_t* dst,
+               int dst_stride,
+               int dst_width,
+               int dst_height,
+               enum FilterMode filtering) {
+  struct ScalePlan plan;
+  if (!src || !dst ||
+      ScalePlanInitPlane(&plan, kScalePlanPlane, src_width, src_height,
+                         dst_width, dst_height, filtering)) {
+    return -1;
   }
-  if (filtering) {
-    return ScalePlaneBilinearDown_16(src_width, src_height, dst_width,
-                                     dst_height, src_stride, dst_stride, src,
-                                     dst, filtering);
+  return ScalePlanRunOnce(&plan, src, src_stride, dst, dst_stride);
+}
+
+LIBYUV_API
+int ScalePlane_16(const uint16_t* src,
+                  int src_stride,
+                  int src_width,
+                  int src_height,
+                  uint16_t* dst,
+                  int dst_stride,
+                  int dst_width,
+                  int dst_height,
+                  enum FilterMode filtering) {
+  struct ScalePlan plan;
+  if (!src || !dst ||
+      ScalePlanInitPlane(&plan, kScalePlanPlane_16, src_width, src_height,
+                         dst_width, dst_height, filtering)) {
+    return -1;
   }
-  ScalePlaneSimple_16(src_width, src_height, dst_width, dst_height, src_stride,
-                      dst_stride, src, dst);
-  return 0;
+  return ScalePlanRunOnce(&plan, (const uint8_t*)src, src_stride,
+                          (uint8_t*)dst, dst_stride);
 }
 
 LIBYUV_API
@@ -2659,6 +2634,825 @@ int NV24Scale(const uint8_t* src_y,
   return r;
 }
 
+// Most destinations of I420ScaleMulti and NV12ScaleMulti.
+#define SCALE_MULTI_MAX 8
+
+// Source rows read per band by ScalePlaneMulti.
+#define SCALE_MULTI_BAND_ROWS 32
+
+// One destination plane of a multi scale.
+typedef struct ScaleMultiPlane {
+  uint8_t* dst;
+  int dst_stride;
+  int dst_width;
+  int dst_height;
+  int parent;  // Destination it is cascaded from, or -1 for the source.
+} ScaleMultiPlane;
+
+// Order destinations largest first, so each follows the destination it is
+// cascaded from, and set the parent of destinations exactly half the size of
+// another.  Chroma planes take the order and parents of the luma planes.
+static void ScaleMultiCascade(ScaleMultiPlane* planes,
+                              int* order,
+                              int num_dst,
+                              enum FilterMode filtering) {
+  int i, k;
+  for (i = 0; i < num_dst; ++i) {
+    const int64_t area = (int64_t)planes[i].dst_width * planes[i].dst_height;
+    for (k = i; k > 0; --k) {
+      const ScaleMultiPlane* prev = &planes[order[k - 1]];
+      if ((int64_t)prev->dst_width * prev->dst_height >= area) {
+        break;
+      }
+      order[k] = order[k - 1];
+    }
+    order[k] = i;
+  }
+  for (i = 0; i < num_dst; ++i) {
+    ScaleMultiPlane* d = &planes[order[i]];
+    d->parent = -1;
+    if (filtering != kFilterBilinear && filtering != kFilterBox) {
+      continue;
+    }
+    for (k = 0; k < i; ++k) {
+      const ScaleMultiPlane* p = &planes[order[k]];
+      if (p->dst_width == d->dst_width * 2 &&
+          p->dst_height == d->dst_height * 2) {
+        d->parent = order[k];
+        break;
+      }
+    }
+  }
+}
+
+// Scale a plane or UV plane to each of num_dst destinations in one pass down
+// the source.  Each band of source rows is scaled into every destination,
+// in order, before the next band is read.  A cascaded destination follows the
+// destination it is scaled from, reading rows just written while they are
+// still in cache.
+static int ScalePlaneMulti(enum ScalePlanFormat format,
+                           const uint8_t* src,
+                           int src_stride,
+                           int src_width,
+                           int src_height,
+                           const ScaleMultiPlane* dst,
+                           const int* order,
+                           int num_dst,
+                           enum FilterMode filtering) {
+  struct ScalePlan plan[SCALE_MULTI_MAX];
+  int done[SCALE_MULTI_MAX];
+  int row_offset[SCALE_MULTI_MAX];
+  int row_size = 0;
+  int src_end = 0;
+  int r = 0;
+  int i;
+  // Negative height means invert the image.
+  if (src_height < 0) {
+    src_height = -src_height;
+    src = src + (src_height - 1) * (ptrdiff_t)src_stride;
+    src_stride = -src_stride;
+  }
+  for (i = 0; i < num_dst; ++i) {
+    const ScaleMultiPlane* d = &dst[i];
+    const int from_width =
+        d->parent >= 0 ? dst[d->parent].dst_width : src_width;
+    const int from_height =
+        d->parent >= 0 ? dst[d->parent].dst_height : src_height;
+    r = format == kScalePlanUV
+            ? ScalePlanInitUV(&plan[i], from_width, from_height, d->dst_width,
+                              d->dst_height, filtering)
+            : ScalePlanInitPlane(&plan[i], kScalePlanPlane, from_width,
+                                 from_height, d->dst_width, d->dst_height,
+                                 filtering);
+    if (r != 0) {
+      return r;
+    }
+    // Each destination has its own row buffer, so that polyphase tables are
+    // built once rather than for every band.
+    row_offset[i] = row_size;
+    row_size += (plan[i].row_size + 63) & ~63;
+    done[i] = 0;
+  }
+
+  align_buffer_64(row, row_size);
+  if (!row)
+    return 1;
+  for (i = 0; i < num_dst; ++i) {
+    if (plan[i].method == kScaleMethodPolyphase) {
+      ScalePolyphaseTables(&plan[i], row + row_offset[i]);
+    }
+  }
+  while (src_end < src_height && r == 0) {
+    src_end = src_end + SCALE_MULTI_BAND_ROWS < src_height
+                  ? src_end + SCALE_MULTI_BAND_ROWS
+                  : src_height;
+    for (i = 0; i < num_dst && r == 0; ++i) {
+      const int j = order[i];
+      const ScaleMultiPlane* d = &dst[j];
+      const struct ScalePlan* pl = &plan[j];
+      const uint8_t* from = d->parent >= 0 ? dst[d->parent].dst : src;
+      const int from_stride =
+          d->parent >= 0 ? dst[d->parent].dst_stride : src_stride;
+      const int from_end = d->parent >= 0 ? done[d->parent] : src_end;
+      // Polyphase filters read taps_y rows around the source row.
+      const int margin =
+          pl->method == kScaleMethodPolyphase ? pl->taps_y : 3;
+      int y_end = pl->dst_height;
+      if (from_end < pl->src_height) {
+        if (format == kScalePlanUV && !ScalePlanBandableUV(pl)) {
+          continue;
+        }
+        // Rows whose source rows, with the margin of ScalePlanRowRangePlane,
+        // have been read or written.
+        y_end = (int)((int64_t)(from_end - margin) * pl->dst_height /
+                      pl->src_height);
+        y_end -= y_end % SCALE_BAND_ALIGN;
+      }
+      if (y_end <= done[j]) {
+        continue;
+      }
+      if (format != kScalePlanUV) {
+        r = ScalePlanRunBandPlane(pl, done[j], y_end, from, from_stride, 0,
+                                  d->dst + (ptrdiff_t)done[j] * d->dst_stride,
+                                  d->dst_stride, row + row_offset[j]);
+      } else if (ScalePlanBandableUV(pl)) {
+        r = ScalePlanRunBandUV(pl, done[j], y_end, from, from_stride,
+                               d->dst + (ptrdiff_t)done[j] * d->dst_stride,
+                               d->dst_stride, row + row_offset[j]);
+      } else {
+        r = ScalePlanRunUV(pl, from, from_stride, d->dst, d->dst_stride,
+                           row + row_offset[j]);
+      }
+      done[j] = y_end;
+    }
+  }
+  free_aligned_buffer_64(row);
+  return r;
+}
+
+LIBYUV_API
+int I420ScaleMulti(const uint8_t* src_y,
+                   int src_stride_y,
+                   const uint8_t* src_u,
+                   int src_stride_u,
+                   const uint8_t* src_v,
+                   int src_stride_v,
+                   int src_width,
+                   int src_height,
+                   const struct I420ScaleDest* dst,
+                   int num_dst,
+                   enum FilterMode filtering) {
+  ScaleMultiPlane planes_y[SCALE_MULTI_MAX];
+  ScaleMultiPlane planes_u[SCALE_MULTI_MAX];
+  ScaleMultiPlane planes_v[SCALE_MULTI_MAX];
+  int order[SCALE_MULTI_MAX];
+  int r;
+  int i;
+  if (!src_y || !src_u || !src_v || src_width <= 0 || src_height == 0 ||
+      src_height == INT_MIN || !dst || num_dst <= 0 ||
+      num_dst > SCALE_MULTI_MAX) {
+    return -1;
+  }
+  for (i = 0; i < num_dst; ++i) {
+    if (!dst[i].dst_y || !dst[i].dst_u || !dst[i].dst_v ||
+        dst[i].dst_width <= 0 || dst[i].dst_height <= 0) {
+      return -1;
+    }
+    planes_y[i].dst = dst[i].dst_y;
+    planes_y[i].dst_stride = dst[i].dst_stride_y;
+    planes_y[i].dst_width = dst[i].dst_width;
+    planes_y[i].dst_height = dst[i].dst_height;
+  }
+  ScaleMultiCascade(planes_y, order, num_dst, filtering);
+  for (i = 0; i < num_dst; ++i) {
+    planes_u[i].dst = dst[i].dst_u;
+    planes_u[i].dst_stride = dst[i].dst_stride_u;
+    planes_u[i].dst_width = SUBSAMPLE(dst[i].dst_width, 1, 1);
+    planes_u[i].dst_height = SUBSAMPLE(dst[i].dst_height, 1, 1);
+    planes_u[i].parent = planes_y[i].parent;
+    planes_v[i] = planes_u[i];
+    planes_v[i].dst = dst[i].dst_v;
+    planes_v[i].dst_stride = dst[i].dst_stride_v;
+  }
+  int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+  int src_halfheight = SUBSAMPLE(src_height, 1, 1);
+
+  r = ScalePlaneMulti(kScalePlanPlane, src_y, src_stride_y, src_width,
+                      src_height, planes_y, order, num_dst, filtering);
+  if (r != 0) {
+    return r;
+  }
+  r = ScalePlaneMulti(kScalePlanPlane, src_u, src_stride_u, src_halfwidth,
+                      src_halfheight, planes_u, order, num_dst, filtering);
+  if (r != 0) {
+    return r;
+  }
+  r = ScalePlaneMulti(kScalePlanPlane, src_v, src_stride_v, src_halfwidth,
+                      src_halfheight, planes_v, order, num_dst, filtering);
+  return r;
+}
+
+LIBYUV_API
+int NV12ScaleMulti(const uint8_t* src_y,
+                   int src_stride_y,
+                   const uint8_t* src_uv,
+                   int src_stride_uv,
+                   int src_width,
+                   int src_height,
+                   const struct NV12ScaleDest* dst,
+                   int num_dst,
+                   enum FilterMode filtering) {
+  ScaleMultiPlane planes_y[SCALE_MULTI_MAX];
+  ScaleMultiPlane planes_uv[SCALE_MULTI_MAX];
+  int order[SCALE_MULTI_MAX];
+  int r;
+  int i;
+  if (!src_y || !src_uv || src_width <= 0 || src_height == 0 ||
+      src_height == INT_MIN || !dst || num_dst <= 0 ||
+      num_dst > SCALE_MULTI_MAX) {
+    return -1;
+  }
+  for (i = 0; i < num_dst; ++i) {
+    if (!dst[i].dst_y || !dst[i].dst_uv || dst[i].dst_width <= 0 ||
+        dst[i].dst_height <= 0) {
+      return -1;
+    }
+    planes_y[i].dst = dst[i].dst_y;
+    planes_y[i].dst_stride = dst[i].dst_stride_y;
+    planes_y[i].dst_width = dst[i].dst_width;
+    planes_y[i].dst_height = dst[i].dst_height;
+  }
+  ScaleMultiCascade(planes_y, order, num_dst, filtering);
+  for (i = 0; i < num_dst; ++i) {
+    planes_uv[i].dst = dst[i].dst_uv;
+    planes_uv[i].dst_stride = dst[i].dst_stride_uv;
+    planes_uv[i].dst_width = SUBSAMPLE(dst[i].dst_width, 1, 1);
+    planes_uv[i].dst_height = SUBSAMPLE(dst[i].dst_height, 1, 1);
+    planes_uv[i].parent = planes_y[i].parent;
+  }
+  int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+  int src_halfheight = SUBSAMPLE(src_height, 1, 1);
+
+  r = ScalePlaneMulti(kScalePlanPlane, src_y, src_stride_y, src_width,
+                      src_height, planes_y, order, num_dst, filtering);
+  if (r != 0) {
+    return r;
+  }
+  r = ScalePlaneMulti(kScalePlanUV, src_uv, src_stride_uv, src_halfwidth,
+                      src_halfheight, planes_uv, order, num_dst, filtering);
+  return r;
+}
+
+// Band of rows of a plane, scaled as one job of a multithreaded scale.
+typedef struct ScaleBand {
+  const struct ScalePlan* plan;  // Shared by all bands of the plane.
+  const uint8_t* src;
+  ptrdiff_t src_stride;
+  uint8_t* dst;
+  ptrdiff_t dst_stride;
+  int dst_y_begin;
+  int dst_y_end;
+  uint8_t* row;  // Row buffer of this band alone, NULL if the plan needs none.
+  int result;
+} ScaleBand;
+
+static void ScaleBandJob(void* job_context, int index) {
+  ScaleBand* band = (ScaleBand*)(job_context) + index;
+  const struct ScalePlan* plan = band->plan;
+  if (plan->format == kScalePlanUV) {
+    if (!ScalePlanBandableUV(plan)) {
+      // Interleaved UV plane that can not be split, scaled in one job.
+      band->result = ScalePlanRun(plan, band->src, (int)band->src_stride,
+                                  band->dst, (int)band->dst_stride, band->row);
+      return;
+    }
+    band->result = ScalePlanRunBandUV(
+        plan, band->dst_y_begin, band->dst_y_end, band->src,
+        (int)band->src_stride,
+        band->dst + band->dst_y_begin * band->dst_stride,
+        (int)band->dst_stride, band->row);
+    return;
+  }
+  band->result = 0;
+  ScalePlaneRows(plan, band->src, band->src_stride, band->dst,
+                 band->dst_stride, band->dst_y_begin, band->dst_y_end,
+                 band->row);
+}
+
+// Split a plane into at most num_bands bands.  bands may be NULL to count
+// them.  Returns the number of bands.
+static int ScalePlaneSplit(const struct ScalePlan* plan,
+                           const uint8_t* src,
+                           int src_stride,
+                           uint8_t* dst,
+                           int dst_stride,
+                           int num_bands,
+                           ScaleBand* bands) {
+  const int dst_height = plan->dst_height;
+  int band_rows;
+  int count = 0;
+  int y;
+  ptrdiff_t src_step = src_stride;
+  if (plan->format == kScalePlanUV && !ScalePlanBandableUV(plan)) {
+    // Scaled whole by ScalePlanRun, which inverts the plane itself.
+    num_bands = 1;
+  } else if (plan->invert) {
+    src = src + (plan->src_height - 1) * src_step;
+    src_step = -src_step;
+  }
+  if (num_bands < 1) {
+    num_bands = 1;
+  }
+  band_rows = (dst_height + num_bands - 1) / num_bands;
+  band_rows = (band_rows + SCALE_BAND_ALIGN - 1) / SCALE_BAND_ALIGN *
+              SCALE_BAND_ALIGN;
+  for (y = 0; y < dst_height; y += band_rows) {
+    if (bands) {
+      ScaleBand* band = &bands[count];
+      band->plan = plan;
+      band->src = src;
+      band->src_stride = src_step;
+      band->dst = dst;
+      band->dst_stride = dst_stride;
+      band->dst_y_begin = y;
+      band->dst_y_end =
+          (dst_height - y) < band_rows ? dst_height : y + band_rows;
+      band->row = NULL;
+      band->result = 0;
+    }
+    ++count;
+  }
+  return count;
+}
+
+// Bytes of row buffer that each band of a plane needs, rounded up so that
+// the buffers of consecutive bands stay 64 byte aligned.
+static size_t ScaleBandRowSize(const struct ScalePlan* plan) {
+  return ((size_t)plan->row_size + 63) & ~(size_t)63;
+}
+
+// Hand each band its own row buffer, carved in order from rows.
+static void ScaleBandSetRows(ScaleBand* bands, int count, uint8_t* rows) {
+  int i;
+  for (i = 0; i < count; ++i) {
+    if (bands[i].plan->row_size > 0) {
+      bands[i].row = rows;
+      rows += ScaleBandRowSize(bands[i].plan);
+    }
+  }
+}
+
+// Run the bands on the executor, or on the calling thread if there is none.
+static int ScaleRunBands(ScaleBand* bands,
+                         int count,
+                         ScaleExecutor executor,
+                         void* executor_context) {
+  int i;
+  if (executor) {
+    executor(executor_context, ScaleBandJob, bands, count);
+  } else {
+    for (i = 0; i < count; ++i) {
+      ScaleBandJob(bands, i);
+    }
+  }
+  for (i = 0; i < count; ++i) {
+    if (bands[i].result != 0) {
+      return bands[i].result;
+    }
+  }
+  return 0;
+}
+
+LIBYUV_API
+int ScalePlaneMT(const uint8_t* src,
+                 int src_stride,
+                 int src_width,
+                 int src_height,
+                 uint8_t* dst,
+                 int dst_stride,
+                 int dst_width,
+                 int dst_height,
+                 enum FilterMode filtering,
+                 int num_bands,
+                 ScaleExecutor executor,
+                 void* executor_context) {
+  struct ScalePlan plan;
+  int r;
+  int count;
+  size_t rows_size;
+  if (!src || !dst ||
+      ScalePlanInitPlane(&plan, kScalePlanPlane, src_width, src_height,
+                         dst_width, dst_height, filtering)) {
+    return -1;
+  }
+  count = ScalePlaneSplit(&plan, src, src_stride, dst, dst_stride, num_bands,
+                          NULL);
+  // The row buffers of all bands, followed by the bands, in one block.
+  rows_size = count * ScaleBandRowSize(&plan);
+  align_buffer_64(rows, rows_size + count * sizeof(ScaleBand));
+  if (!rows) {
+    return 1;
+  }
+  ScaleBand* bands = (ScaleBand*)(rows + rows_size);
+  ScalePlaneSplit(&plan, src, src_stride, dst, dst_stride, num_bands, bands);
+  ScaleBandSetRows(bands, count, rows);
+  r = ScaleRunBands(bands, count, executor, executor_context);
+  free_aligned_buffer_64(rows);
+  return r;
+}
+
+LIBYUV_API
+int I420ScaleMT(const uint8_t* src_y,
+                int src_stride_y,
+                const uint8_t* src_u,
+                int src_stride_u,
+                const uint8_t* src_v,
+                int src_stride_v,
+                int src_width,
+                int src_height,
+                uint8_t* dst_y,
+                int dst_stride_y,
+                uint8_t* dst_u,
+                int dst_stride_u,
+                uint8_t* dst_v,
+                int dst_stride_v,
+                int dst_width,
+                int dst_height,
+                enum FilterMode filtering,
+                int num_bands,
+                ScaleExecutor executor,
+                void* executor_context) {
+  struct ScalePlan plan_y;
+  struct ScalePlan plan_uv;  // Same for the U and V planes.
+  int r;
+  int count_y, count_u, count_v;
+  size_t rows_size;
+
+  if (!src_y || !src_u || !src_v || src_width <= 0 || src_height == 0 ||
+      src_height == INT_MIN || !dst_y || !dst_u || !dst_v || dst_width <= 0 ||
+      dst_height <= 0) {
+    return -1;
+  }
+  int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+  int src_halfheight = SUBSAMPLE(src_height, 1, 1);
+  int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
+  int dst_halfheight = SUBSAMPLE(dst_height, 1, 1);
+
+  if (ScalePlanInitPlane(&plan_y, kScalePlanPlane, src_width, src_height,
+                         dst_width, dst_height, filtering) ||
+      ScalePlanInitPlane(&plan_uv, kScalePlanPlane, src_halfwidth,
+                         src_halfheight, dst_halfwidth, dst_halfheight,
+                         filtering)) {
+    return -1;
+  }
+  count_y = ScalePlaneSplit(&plan_y, src_y, src_stride_y, dst_y, dst_stride_y,
+                            num_bands, NULL);
+  count_u = ScalePlaneSplit(&plan_uv, src_u, src_stride_u, dst_u,
+                            dst_stride_u, num_bands, NULL);
+  count_v = count_u;
+  // The row buffers of all bands, followed by the bands, in one block.
+  rows_size = count_y * ScaleBandRowSize(&plan_y) +
+              (count_u + count_v) * ScaleBandRowSize(&plan_uv);
+  align_buffer_64(rows, rows_size + (count_y + count_u + count_v) *
+                                        sizeof(ScaleBand));
+  if (!rows) {
+    return 1;
+  }
+  ScaleBand* bands = (ScaleBand*)(rows + rows_size);
+  ScalePlaneSplit(&plan_y, src_y, src_stride_y, dst_y, dst_stride_y, num_bands,
+                  bands);
+  ScalePlaneSplit(&plan_uv, src_u, src_stride_u, dst_u, dst_stride_u,
+                  num_bands, bands + count_y);
+  ScalePlaneSplit(&plan_uv, src_v, src_stride_v, dst_v, dst_stride_v,
+                  num_bands, bands + count_y + count_u);
+  ScaleBandSetRows(bands, count_y + count_u + count_v, rows);
+  r = ScaleRunBands(bands, count_y + count_u + count_v, executor,
+                    executor_context);
+  free_aligned_buffer_64(rows);
+  return r;
+}
+
+LIBYUV_API
+int NV12ScaleMT(const uint8_t* src_y,
+                int src_stride_y,
+                const uint8_t* src_uv,
+                int src_stride_uv,
+                int src_width,
+                int src_height,
+                uint8_t* dst_y,
+                int dst_stride_y,
+                uint8_t* dst_uv,
+                int dst_stride_uv,
+                int dst_width,
+                int dst_height,
+                enum FilterMode filtering,
+                int num_bands,
+                ScaleExecutor executor,
+                void* executor_context) {
+  struct ScalePlan plan_y;
+  struct ScalePlan plan_uv;
+  int r;
+  int count_y, count_uv;
+  size_t rows_size;
+
+  if (!src_y || !src_uv || src_width <= 0 || src_height == 0 ||
+      src_height == INT_MIN || !dst_y || !dst_uv || dst_width <= 0 ||
+      dst_height <= 0) {
+    return -1;
+  }
+  int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+  int src_halfheight = SUBSAMPLE(src_height, 1, 1);
+  int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
+  int dst_halfheight = SUBSAMPLE(dst_height, 1, 1);
+
+  if (ScalePlanInitPlane(&plan_y, kScalePlanPlane, src_width, src_height,
+                         dst_width, dst_height, filtering) ||
+      ScalePlanInitUV(&plan_uv, src_halfwidth, src_halfheight, dst_halfwidth,
+                      dst_halfheight, filtering)) {
+    return -1;
+  }
+  count_y = ScalePlaneSplit(&plan_y, src_y, src_stride_y, dst_y, dst_stride_y,
+                            num_bands, NULL);
+  count_uv = ScalePlaneSplit(&plan_uv, src_uv, src_stride_uv, dst_uv,
+                             dst_stride_uv, num_bands, NULL);
+  // The row buffers of all bands, followed by the bands, in one block.
+  rows_size = count_y * ScaleBandRowSize(&plan_y) +
+              count_uv * ScaleBandRowSize(&plan_uv);
+  align_buffer_64(rows, rows_size + (count_y + count_uv) * sizeof(ScaleBand));
+  if (!rows) {
+    return 1;
+  }
+  ScaleBand* bands = (ScaleBand*)(rows + rows_size);
+  ScalePlaneSplit(&plan_y, src_y, src_stride_y, dst_y, dst_stride_y, num_bands,
+                  bands);
+  ScalePlaneSplit(&plan_uv, src_uv, src_stride_uv, dst_uv, dst_stride_uv,
+                  num_bands, bands + count_y);
+  ScaleBandSetRows(bands, count_y + count_uv, rows);
+  r = ScaleRunBands(bands, count_y + count_uv, executor, executor_context);
+  free_aligned_buffer_64(rows);
+  return r;
+}
+
+// Fill in a plan for any public format.
+static int ScalePlanInitFormat(struct ScalePlan* plan,
+                               enum ScalePlanFormat format,
+                               int src_width,
+                               int src_height,
+                               int dst_width,
+                               int dst_height,
+                               enum FilterMode filtering) {
+  int r;
+  switch (format) {
+    case kScalePlanPlane:
+    case kScalePlanPlane_16:
+      r = ScalePlanInitPlane(plan, format, src_width, src_height, dst_width,
+                             dst_height, filtering);
+      break;
+    case kScalePlanARGB:
+      r = (src_width > 32768 || src_height > 32768)
+              ? -1
+              : ScalePlanInitARGB(plan, src_width, src_height, dst_width,
+                                  dst_height, 0, 0, dst_width, dst_height,
+                                  filtering);
+      break;
+    case kScalePlanUV:
+      r = ScalePlanInitUV(plan, src_width, src_height, dst_width, dst_height,
+                          filtering);
+      break;
+    default:
+      r = -1;
+      break;
+  }
+  return r;
+}
+
+// Plans from ScalePlanCreate own a row buffer so that executing them does
+// not allocate.
+LIBYUV_API
+struct ScalePlan* ScalePlanCreate(enum ScalePlanFormat format,
+                                  int src_width,
+                                  int src_height,
+                                  int dst_width,
+                                  int dst_height,
+                                  enum FilterMode filtering) {
+  struct ScalePlan* plan = (struct ScalePlan*)malloc(sizeof(struct ScalePlan));
+  int r;
+  if (!plan) {
+    return NULL;
+  }
+  r = ScalePlanInitFormat(plan, format, src_width, src_height, dst_width,
+                          dst_height, filtering);
+  if (r != 0) {
+    free(plan);
+    return NULL;
+  }
+  if (plan->row_size > 0) {
+    plan->row_mem = (uint8_t*)malloc(plan->row_size + 63);
+    if (!plan->row_mem) {
+      free(plan);
+      return NULL;
+    }
+    plan->row = (uint8_t*)(((uintptr_t)(plan->row_mem) + 63) & ~63);
+  }
+  if (plan->method == kScaleMethodPolyphase) {
+    ScalePolyphaseTables(plan, plan->row);
+  }
+  return plan;
+}
+
+LIBYUV_API
+int ScalePlanExecute(struct ScalePlan* plan,
+                     const uint8_t* src,
+                     int src_stride,
+                     uint8_t* dst,
+                     int dst_stride) {
+  if (!plan || plan->format == kScalePlanPlane_16 || !src || !dst) {
+    return -1;
+  }
+  return ScalePlanRun(plan, src, src_stride, dst, dst_stride, plan->row);
+}
+
+LIBYUV_API
+int ScalePlanExecute_16(struct ScalePlan* plan,
+                        const uint16_t* src,
+                        int src_stride,
+                        uint16_t* dst,
+                        int dst_stride) {
+  if (!plan || plan->format != kScalePlanPlane_16 || !src || !dst) {
+    return -1;
+  }
+  return ScalePlanRun(plan, (const uint8_t*)src, src_stride, (uint8_t*)dst,
+                      dst_stride, plan->row);
+}
+
+LIBYUV_API
+void ScalePlanDestroy(struct ScalePlan* plan) {
+  if (plan) {
+    free(plan->row_mem);
+    free(plan);
+  }
+}
+
+LIBYUV_API
+int ScaleScratchSize(enum ScalePlanFormat format,
+                     int src_width,
+                     int src_height,
+                     int dst_width,
+                     int dst_height,
+                     enum FilterMode filtering) {
+  struct ScalePlan plan;
+  if (ScalePlanInitFormat(&plan, format, src_width, src_height, dst_width,
+                          dst_height, filtering)) {
+    return -1;
+  }
+  return plan.row_size > 0 ? plan.row_size + 63 : 0;
+}
+
+// Scale with a plan on the stack and the row buffer carved from scratch, or
+// allocated if scratch is NULL.
+static int ScaleWithScratch(enum ScalePlanFormat format,
+                            const uint8_t* src,
+                            int src_stride,
+                            int src_width,
+                            int src_height,
+                            uint8_t* dst,
+                            int dst_stride,
+                            int dst_width,
+                            int dst_height,
+                            enum FilterMode filtering,
+                            uint8_t* scratch,
+                            int scratch_size) {
+  struct ScalePlan plan;
+  if (!src || !dst ||
+      ScalePlanInitFormat(&plan, format, src_width, src_height, dst_width,
+                          dst_height, filtering)) {
+    return -1;
+  }
+  if (!scratch) {
+    return ScalePlanRunOnce(&plan, src, src_stride, dst, dst_stride);
+  }
+  if (scratch_size < (plan.row_size > 0 ? plan.row_size + 63 : 0)) {
+    return -1;  // Scratch too small.
+  }
+  return ScalePlanRun(&plan, src, src_stride, dst, dst_stride,
+                      plan.row_size > 0
+                          ? (uint8_t*)(((uintptr_t)scratch + 63) & ~63)
+                          : NULL);
+}
+
+LIBYUV_API
+int ScaleScratch(enum ScalePlanFormat format,
+                 const uint8_t* src,
+                 int src_stride,
+                 int src_width,
+                 int src_height,
+                 uint8_t* dst,
+                 int dst_stride,
+                 int dst_width,
+                 int dst_height,
+                 enum FilterMode filtering,
+                 uint8_t* scratch,
+                 int scratch_size) {
+  if (format == kScalePlanPlane_16) {
+    return -1;
+  }
+  return ScaleWithScratch(format, src, src_stride, src_width, src_height, dst,
+                          dst_stride, dst_width, dst_height, filtering, scratch,
+                          scratch_size);
+}
+
+LIBYUV_API
+int ScaleScratch_16(const uint16_t* src,
+                    int src_stride,
+                    int src_width,
+                    int src_height,
+                    uint16_t* dst,
+                    int dst_stride,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering,
+                    uint8_t* scratch,
+                    int scratch_size) {
+  return ScaleWithScratch(kScalePlanPlane_16, (const uint8_t*)src, src_stride,
+                          src_width, src_height, (uint8_t*)dst, dst_stride,
+                          dst_width, dst_height, filtering, scratch,
+                          scratch_size);
+}
+
+// The Y and chroma planes run one after another, so they share the scratch.
+LIBYUV_API
+int I420ScaleScratchSize(int src_width,
+                         int src_height,
+                         int dst_width,
+                         int dst_height,
+                         enum FilterMode filtering) {
+  int y_size;
+  int uv_size;
+  if (src_width <= 0 || src_height == 0 || src_height == INT_MIN ||
+      dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+  y_size = ScaleScratchSize(kScalePlanPlane, src_width, src_height, dst_width,
+                            dst_height, filtering);
+  uv_size = ScaleScratchSize(
+      kScalePlanPlane, SUBSAMPLE(src_width, 1, 1), SUBSAMPLE(src_height, 1, 1),
+      SUBSAMPLE(dst_width, 1, 1), SUBSAMPLE(dst_height, 1, 1), filtering);
+  if (y_size < 0 || uv_size < 0) {
+    return -1;
+  }
+  return y_size > uv_size ? y_size : uv_size;
+}
+
+LIBYUV_API
+int I420ScaleScratch(const uint8_t* src_y,
+                     int src_stride_y,
+                     const uint8_t* src_u,
+                     int src_stride_u,
+                     const uint8_t* src_v,
+                     int src_stride_v,
+                     int src_width,
+                     int src_height,
+                     uint8_t* dst_y,
+                     int dst_stride_y,
+                     uint8_t* dst_u,
+                     int dst_stride_u,
+                     uint8_t* dst_v,
+                     int dst_stride_v,
+                     int dst_width,
+                     int dst_height,
+                     enum FilterMode filtering,
+                     uint8_t* scratch,
+                     int scratch_size) {
+  int r;
+
+  if (!src_y || !src_u || !src_v || src_width <= 0 || src_height == 0 ||
+      src_height == INT_MIN || !dst_y || !dst_u || !dst_v || dst_width <= 0 ||
+      dst_height <= 0) {
+    return -1;
+  }
+  int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+  int src_halfheight = SUBSAMPLE(src_height, 1, 1);
+  int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
+  int dst_halfheight = SUBSAMPLE(dst_height, 1, 1);
+
+  r = ScaleScratch(kScalePlanPlane, src_y, src_stride_y, src_width, src_height,
+                   dst_y, dst_stride_y, dst_width, dst_height, filtering,
+                   scratch, scratch_size);
+  if (r != 0) {
+    return r;
+  }
+  r = ScaleScratch(kScalePlanPlane, src_u, src_stride_u, src_halfwidth,
+                   src_halfheight, dst_u, dst_stride_u, dst_halfwidth,
+                   dst_halfheight, filtering, scratch, scratch_size);
+  if (r != 0) {
+    return r;
+  }
+  r = ScaleScratch(kScalePlanPlane, src_v, src_stride_v, src_halfwidth,
+                   src_halfheight, dst_v, dst_stride_v, dst_halfwidth,
+                   dst_halfheight, filtering, scratch, scratch_size);
+  return r;
+}
+
 // Deprecated api
 LIBYUV_API
 int Scale(const uint8_t* src_y,
@@ -566,6 +566,42 @@ CANY(ScaleARGBFilterCols_Any_LSX,
 #endif
 #undef CANY
 
+// Polyphase filter rows.  The remainder is filtered by C, with the same
+// coefficients, so any width is supported.
+#ifdef HAS_SCALEPOLYPHASECOLS_AVX2
+void ScalePolyphaseCols_Any_AVX2(const uint8_t* src_ptr,
+                                 uint16_t* dst_ptr,
+                                 int dst_width,
+                                 const int32_t* starts,
+                                 const int16_t* coeffs,
+                                 int taps) {
+  int n = dst_width & ~7;
+  if (n > 0) {
+    ScalePolyphaseCols_AVX2(src_ptr, dst_ptr, n, starts, coeffs, taps);
+  }
+  ScalePolyphaseCols_C(src_ptr, dst_ptr + n, dst_width & 7, starts + n,
+                       coeffs + n * taps, taps);
+}
+#endif
+#ifdef HAS_SCALEPOLYPHASEROWS_AVX2
+void ScalePolyphaseRows_Any_AVX2(const uint16_t* const* src_rows,
+                                 const int16_t* coeffs,
+                                 int taps,
+                                 uint8_t* dst_ptr,
+                                 int width) {
+  const uint16_t* rows[SCALE_POLYPHASE_MAX_TAPS];
+  int n = width & ~15;
+  int j;
+  if (n > 0) {
+    ScalePolyphaseRows_AVX2(src_rows, coeffs, taps, dst_ptr, n);
+  }
+  for (j = 0; j < taps; ++j) {
+    rows[j] = src_rows[j] + n;
+  }
+  ScalePolyphaseRows_C(rows, coeffs, taps, dst_ptr + n, width & 15);
+}
+#endif
+
 // Scale up horizontally 2 times using linear filter.
 #define SUH2LANY(NAME, SIMD, C, MASK, PTYPE)                       \
   void NAME(const PTYPE* src_ptr, PTYPE* dst_ptr, int dst_width) { \
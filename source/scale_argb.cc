@@ -11,16 +11,21 @@
 #include "libyuv/scale.h"
 
 #include <assert.h>
+#include <float.h>
 #include <limits.h>
+#include <math.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "libyuv/convert_argb.h"
 #include "libyuv/cpu_id.h"
 #include "libyuv/planar_functions.h"  // For CopyARGB
 #include "libyuv/row.h"
+#include "libyuv/row_dispatch.h"
 #include "libyuv/scale_argb.h"
 #include "libyuv/scale_row.h"
+#include "libyuv/video_common.h"
 
 #ifdef __cplusplus
 namespace libyuv {
@@ -49,12 +54,11 @@ static void ScaleARGBDown2(int src_width,
                            enum FilterMode filtering) {
   int j;
   ptrdiff_t row_stride = src_stride * (dy >> 16);
-  void (*ScaleARGBRowDown2)(const uint8_t* src_argb, ptrdiff_t src_stride,
-                            uint8_t* dst_argb, int dst_width) =
-      filtering == kFilterNone
-          ? ScaleARGBRowDown2_C
-          : (filtering == kFilterLinear ? ScaleARGBRowDown2Linear_C
-                                        : ScaleARGBRowDown2Box_C);
+  const int kernel = filtering == kFilterNone     ? SCALEROWDOWN2_NONE
+                     : filtering == kFilterLinear ? SCALEROWDOWN2_LINEAR
+                                                  : SCALEROWDOWN2_BOX;
+  ScaleRowDown2Function ScaleARGBRowDown2 =
+      ROW_KERNEL(GetRowDispatch()->ScaleARGBRowDown2[kernel], dst_width);
   (void)src_width;
   (void)src_height;
   (void)dx;
@@ -67,74 +71,6 @@ static void ScaleARGBDown2(int src_width,
     src_argb += (y >> 16) * src_stride + ((x >> 16) - 1) * 4;
   }
 
-#if defined(HAS_SCALEARGBROWDOWN2_SSE2)
-  if (TestCpuFlag(kCpuHasSSE2)) {
-    ScaleARGBRowDown2 =
-        filtering == kFilterNone
-            ? ScaleARGBRowDown2_Any_SSE2
-            : (filtering == kFilterLinear ? ScaleARGBRowDown2Linear_Any_SSE2
-                                          : ScaleARGBRowDown2Box_Any_SSE2);
-    if (IS_ALIGNED(dst_width, 4)) {
-      ScaleARGBRowDown2 =
-          filtering == kFilterNone
-              ? ScaleARGBRowDown2_SSE2
-              : (filtering == kFilterLinear ? ScaleARGBRowDown2Linear_SSE2
-                                            : ScaleARGBRowDown2Box_SSE2);
-    }
-  }
-#endif
-#if defined(HAS_SCALEARGBROWDOWN2_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    ScaleARGBRowDown2 =
-        filtering == kFilterNone
-            ? ScaleARGBRowDown2_Any_NEON
-            : (filtering == kFilterLinear ? ScaleARGBRowDown2Linear_Any_NEON
-                                          : ScaleARGBRowDown2Box_Any_NEON);
-    if (IS_ALIGNED(dst_width, 8)) {
-      ScaleARGBRowDown2 =
-          filtering == kFilterNone
-              ? ScaleARGBRowDown2_NEON
-              : (filtering == kFilterLinear ? ScaleARGBRowDown2Linear_NEON
-                                            : ScaleARGBRowDown2Box_NEON);
-    }
-  }
-#endif
-#if defined(HAS_SCALEARGBROWDOWN2_SME)
-  if (TestCpuFlag(kCpuHasSME)) {
-    ScaleARGBRowDown2 = filtering == kFilterNone ? ScaleARGBRowDown2_SME
-                        : filtering == kFilterLinear
-                            ? ScaleARGBRowDown2Linear_SME
-                            : ScaleARGBRowDown2Box_SME;
-  }
-#endif
-#if defined(HAS_SCALEARGBROWDOWN2_LSX)
-  if (TestCpuFlag(kCpuHasLSX)) {
-    ScaleARGBRowDown2 =
-        filtering == kFilterNone
-            ? ScaleARGBRowDown2_Any_LSX
-            : (filtering == kFilterLinear ? ScaleARGBRowDown2Linear_Any_LSX
-                                          : ScaleARGBRowDown2Box_Any_LSX);
-    if (IS_ALIGNED(dst_width, 4)) {
-      ScaleARGBRowDown2 =
-          filtering == kFilterNone
-              ? ScaleARGBRowDown2_LSX
-              : (filtering == kFilterLinear ? ScaleARGBRowDown2Linear_LSX
-                                            : ScaleARGBRowDown2Box_LSX);
-    }
-  }
-#endif
-#if defined(HAS_SCALEARGBROWDOWN2_RVV) &&       \
-    defined(HAS_SCALEARGBROWDOWN2LINEAR_RVV) && \
-    defined(HAS_SCALEARGBROWDOWN2BOX_RVV)
-  if (TestCpuFlag(kCpuHasRVV)) {
-    ScaleARGBRowDown2 =
-        filtering == kFilterNone
-            ? ScaleARGBRowDown2_RVV
-            : (filtering == kFilterLinear ? ScaleARGBRowDown2Linear_RVV
-                                          : ScaleARGBRowDown2Box_RVV);
-  }
-#endif
-
   if (filtering == kFilterLinear) {
     src_stride = 0;
   }
@@ -147,32 +83,28 @@ static void ScaleARGBDown2(int src_width,
 
 // ScaleARGB ARGB, 1/4
 // This is an optimized version for scaling down a ARGB to 1/4 of
-// its original size.
-static int ScaleARGBDown4Box(int src_width,
-                             int src_height,
-                             int dst_width,
-                             int dst_height,
-                             ptrdiff_t src_stride,
-                             ptrdiff_t dst_stride,
-                             const uint8_t* src_argb,
-                             uint8_t* dst_argb,
-                             int x,
-                             int dx,
-                             int y,
-                             int dy) {
+// its original size.  row holds 2 rows of ARGB, plan->row_size bytes.
+static void ScaleARGBDown4Box(int src_width,
+                              int src_height,
+                              int dst_width,
+                              int dst_height,
+                              ptrdiff_t src_stride,
+                              ptrdiff_t dst_stride,
+                              const uint8_t* src_argb,
+                              uint8_t* dst_argb,
+                              int x,
+                              int dx,
+                              int y,
+                              int dy,
+                              uint8_t* row) {
   int j;
-  // Allocate 2 rows of ARGB.
   const int row_size = (dst_width * 2 * 4 + 31) & ~31;
   // TODO(fbarchard): Remove this row buffer and implement a ScaleARGBRowDown4
   // but implemented via a 2 pass wrapper that uses a very small array on the
   // stack with a horizontal loop.
-  align_buffer_64(row, row_size * 2);
-  if (!row)
-    return 1;
   ptrdiff_t row_stride = src_stride * (dy >> 16);
-  void (*ScaleARGBRowDown2)(const uint8_t* src_argb, ptrdiff_t src_stride,
-                            uint8_t* dst_argb, int dst_width) =
-      ScaleARGBRowDown2Box_C;
+  ScaleRowDown2Function ScaleARGBRowDown2 = ROW_KERNEL(
+      GetRowDispatch()->ScaleARGBRowDown2[SCALEROWDOWN2_BOX], dst_width);
   // Advance to odd row, even column.
   src_argb += (y >> 16) * src_stride + (x >> 16) * 4;
   (void)src_width;
@@ -180,33 +112,6 @@ static int ScaleARGBDown4Box(int src_width,
   (void)dx;
   assert(dx == 65536 * 4);      // Test scale factor of 4.
   assert((dy & 0x3ffff) == 0);  // Test vertical scale is multiple of 4.
-#if defined(HAS_SCALEARGBROWDOWN2_SSE2)
-  if (TestCpuFlag(kCpuHasSSE2)) {
-    ScaleARGBRowDown2 = ScaleARGBRowDown2Box_Any_SSE2;
-    if (IS_ALIGNED(dst_width, 4)) {
-      ScaleARGBRowDown2 = ScaleARGBRowDown2Box_SSE2;
-    }
-  }
-#endif
-#if defined(HAS_SCALEARGBROWDOWN2_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    ScaleARGBRowDown2 = ScaleARGBRowDown2Box_Any_NEON;
-    if (IS_ALIGNED(dst_width, 8)) {
-      ScaleARGBRowDown2 = ScaleARGBRowDown2Box_NEON;
-    }
-  }
-#endif
-#if defined(HAS_SCALEARGBROWDOWN2_SME)
-  if (TestCpuFlag(kCpuHasSME)) {
-    ScaleARGBRowDown2 = ScaleARGBRowDown2Box_SME;
-  }
-#endif
-#if defined(HAS_SCALEARGBROWDOWN2BOX_RVV)
-  if (TestCpuFlag(kCpuHasRVV)) {
-    ScaleARGBRowDown2 = ScaleARGBRowDown2Box_RVV;
-  }
-#endif
-
   for (j = 0; j < dst_height; ++j) {
     ScaleARGBRowDown2(src_argb, src_stride, row, dst_width * 2);
     ScaleARGBRowDown2(src_argb + src_stride * 2, src_stride, row + row_size,
@@ -215,8 +120,6 @@ static int ScaleARGBDown4Box(int src_width,
     src_argb += row_stride;
     dst_argb += dst_stride;
   }
-  free_aligned_buffer_64(row);
-  return 0;
 }
 
 // ScaleARGB ARGB Even
@@ -297,30 +200,19 @@ static void ScaleARGBDownEven(int src_width,
   }
 }
 
-// Scale ARGB down with bilinear interpolation.
-static int ScaleARGBBilinearDown(int src_width,
-                                 int src_height,
-                                 int dst_width,
-                                 int dst_height,
-                                 ptrdiff_t src_stride,
-                                 ptrdiff_t dst_stride,
-                                 const uint8_t* src_argb,
-                                 uint8_t* dst_argb,
-                                 int x,
-                                 int dx,
-                                 int y,
-                                 int dy,
-                                 enum FilterMode filtering) {
-  int j;
-  void (*InterpolateRow)(uint8_t* dst_argb, const uint8_t* src_argb,
-                         ptrdiff_t src_stride, int dst_width,
-                         int source_y_fraction) = InterpolateRow_C;
-  void (*ScaleARGBFilterCols)(uint8_t* dst_argb, const uint8_t* src_argb,
-                              int dst_width, int x, int dx) =
-      (src_width >= 32768) ? ScaleARGBFilterCols64_C : ScaleARGBFilterCols_C;
-  int64_t xlast = x + (int64_t)(dst_width - 1) * dx;
-  int64_t xl = (dx >= 0) ? x : xlast;
-  int64_t xr = (dx >= 0) ? xlast : x;
+// Select the row functions for ScaleARGBBilinearDown and clip the source
+// to the columns it reads.
+static void ScaleARGBBilinearDownInit(struct ScalePlan* plan) {
+  const struct RowDispatch* dispatch = GetRowDispatch();
+  const int src_width = plan->src_width;
+  const int dst_width = plan->dst_width;
+  const int dx = plan->dx;
+  plan->ScaleCols = (src_width >= 32768)
+                        ? ScaleARGBFilterCols64_C
+                        : ROW_KERNEL(dispatch->ScaleARGBFilterCols, dst_width);
+  int64_t xlast = plan->x + (int64_t)(dst_width - 1) * dx;
+  int64_t xl = (dx >= 0) ? plan->x : xlast;
+  int64_t xr = (dx >= 0) ? xlast : plan->x;
   int clip_src_width;
   xl = (xl >> 16) & ~3;    // Left edge aligned.
   xr = (xr >> 16) + 1;     // Right most pixel used.  Bilinear uses 2 pixels.
@@ -329,294 +221,165 @@ static int ScaleARGBBilinearDown(int src_width,
     xr = src_width;
   }
   clip_src_width = (int)(xr - xl) * 4;  // Width aligned to 4.
-  src_argb += xl * 4;
-  x -= (int)(xl << 16);
-#if defined(HAS_INTERPOLATEROW_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    InterpolateRow = InterpolateRow_Any_AVX2;
-    if (IS_ALIGNED(clip_src_width, 32)) {
-      InterpolateRow = InterpolateRow_AVX2;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    InterpolateRow = InterpolateRow_Any_NEON;
-    if (IS_ALIGNED(clip_src_width, 16)) {
-      InterpolateRow = InterpolateRow_NEON;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_SVE2)
-  if (TestCpuFlag(kCpuHasSVE2)) {
-    InterpolateRow = InterpolateRow_SVE2;
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_SME)
-  if (TestCpuFlag(kCpuHasSME)) {
-    InterpolateRow = InterpolateRow_SME;
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_LSX)
-  if (TestCpuFlag(kCpuHasLSX)) {
-    InterpolateRow = InterpolateRow_Any_LSX;
-    if (IS_ALIGNED(clip_src_width, 32)) {
-      InterpolateRow = InterpolateRow_LSX;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_RVV)
-  if (TestCpuFlag(kCpuHasRVV)) {
-    InterpolateRow = InterpolateRow_RVV;
-  }
-#endif
-#if defined(HAS_SCALEARGBFILTERCOLS_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
-    ScaleARGBFilterCols = ScaleARGBFilterCols_SSSE3;
-  }
-#endif
-#if defined(HAS_SCALEARGBFILTERCOLS_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    ScaleARGBFilterCols = ScaleARGBFilterCols_Any_NEON;
-    if (IS_ALIGNED(dst_width, 4)) {
-      ScaleARGBFilterCols = ScaleARGBFilterCols_NEON;
-    }
-  }
-#endif
-#if defined(HAS_SCALEARGBFILTERCOLS_LSX)
-  if (TestCpuFlag(kCpuHasLSX)) {
-    ScaleARGBFilterCols = ScaleARGBFilterCols_Any_LSX;
-    if (IS_ALIGNED(dst_width, 8)) {
-      ScaleARGBFilterCols = ScaleARGBFilterCols_LSX;
-    }
-  }
-#endif
-#if defined(HAS_SCALEARGBFILTERCOLS_RVV)
-  if (TestCpuFlag(kCpuHasRVV)) {
-    ScaleARGBFilterCols = ScaleARGBFilterCols_RVV;
-  }
-#endif
-
+  plan->src_offset_x += (int)xl;
+  plan->x -= (int)(xl << 16);
+  plan->InterpolateRow =
+      ROW_KERNEL(dispatch->InterpolateRow, clip_src_width);
   // TODO(fbarchard): Consider not allocating row buffer for kFilterLinear.
-  // Allocate a row of ARGB.
-  {
-    align_buffer_64(row, clip_src_width * 4);
-    if (!row)
-      return 1;
-
-    const int64_t max_y = (int64_t)(src_height - 1) << 16;
-    int64_t y64 = y;
-    for (j = 0; j < dst_height; ++j) {
-      if (y64 > max_y) {
-        y64 = max_y;
-      }
-      int yi = (int)(y64 >> 16);
-      const uint8_t* src = src_argb + yi * src_stride;
-      if (filtering == kFilterLinear) {
-        ScaleARGBFilterCols(dst_argb, src, dst_width, x, dx);
-      } else {
-        int yf = (int)((y64 >> 8) & 255);
-        InterpolateRow(row, src, src_stride, clip_src_width, yf);
-        ScaleARGBFilterCols(dst_argb, row, dst_width, x, dx);
-      }
-      dst_argb += dst_stride;
-      y64 += dy;
-    }
-    free_aligned_buffer_64(row);
-  }
-  return 0;
+  plan->interpolate_width = clip_src_width;
+  plan->row_size = clip_src_width * 4;
 }
 
-// Scale ARGB up with bilinear interpolation.
-static int ScaleARGBBilinearUp(int src_width,
-                               int src_height,
-                               int dst_width,
-                               int dst_height,
-                               ptrdiff_t src_stride,
-                               ptrdiff_t dst_stride,
-                               const uint8_t* src_argb,
-                               uint8_t* dst_argb,
-                               int x,
-                               int dx,
-                               int y,
-                               int dy,
-                               enum FilterMode filtering) {
-  assert(src_width > 0);
-  assert(src_height > 0);
-  assert(dst_width > 0);
-  assert(dst_height > 0);
-  assert(dy <= 65536);
-
+// Scale ARGB down with bilinear interpolation.
+static void ScaleARGBBilinearDown(const struct ScalePlan* plan,
+                                  ptrdiff_t src_stride,
+                                  ptrdiff_t dst_stride,
+                                  const uint8_t* src_argb,
+                                  uint8_t* dst_argb,
+                                  uint8_t* row) {
   int j;
-  void (*InterpolateRow)(uint8_t* dst_argb, const uint8_t* src_argb,
-                         ptrdiff_t src_stride, int dst_width,
-                         int source_y_fraction) = InterpolateRow_C;
-  void (*ScaleARGBFilterCols)(uint8_t* dst_argb, const uint8_t* src_argb,
-                              int dst_width, int x, int dx) =
-      filtering ? ScaleARGBFilterCols_C : ScaleARGBCols_C;
+  const int src_height = plan->src_height;
+  const int dst_width = plan->dst_width;
+  const int dst_height = plan->dst_height;
+  const int x = plan->x;
+  const int dx = plan->dx;
+  const int dy = plan->dy;
   const int64_t max_y = (int64_t)(src_height - 1) << 16;
-#if defined(HAS_INTERPOLATEROW_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    InterpolateRow = InterpolateRow_Any_AVX2;
-    if (IS_ALIGNED(dst_width, 8)) {
-      InterpolateRow = InterpolateRow_AVX2;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    InterpolateRow = InterpolateRow_Any_NEON;
-    if (IS_ALIGNED(dst_width, 4)) {
-      InterpolateRow = InterpolateRow_NEON;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_SVE2)
-  if (TestCpuFlag(kCpuHasSVE2)) {
-    InterpolateRow = InterpolateRow_SVE2;
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_SME)
-  if (TestCpuFlag(kCpuHasSME)) {
-    InterpolateRow = InterpolateRow_SME;
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_LSX)
-  if (TestCpuFlag(kCpuHasLSX)) {
-    InterpolateRow = InterpolateRow_Any_LSX;
-    if (IS_ALIGNED(dst_width, 8)) {
-      InterpolateRow = InterpolateRow_LSX;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_RVV)
-  if (TestCpuFlag(kCpuHasRVV)) {
-    InterpolateRow = InterpolateRow_RVV;
-  }
-#endif
-  if (src_width >= 32768) {
-    ScaleARGBFilterCols =
-        filtering ? ScaleARGBFilterCols64_C : ScaleARGBCols64_C;
-  }
-#if defined(HAS_SCALEARGBFILTERCOLS_SSSE3)
-  if (filtering && TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
-    ScaleARGBFilterCols = ScaleARGBFilterCols_SSSE3;
-  }
-#endif
-#if defined(HAS_SCALEARGBFILTERCOLS_NEON)
-  if (filtering && TestCpuFlag(kCpuHasNEON)) {
-    ScaleARGBFilterCols = ScaleARGBFilterCols_Any_NEON;
-    if (IS_ALIGNED(dst_width, 4)) {
-      ScaleARGBFilterCols = ScaleARGBFilterCols_NEON;
+  int64_t y64 = plan->y;
+  for (j = 0; j < dst_height; ++j) {
+    if (y64 > max_y) {
+      y64 = max_y;
     }
-  }
-#endif
-#if defined(HAS_SCALEARGBFILTERCOLS_LSX)
-  if (filtering && TestCpuFlag(kCpuHasLSX)) {
-    ScaleARGBFilterCols = ScaleARGBFilterCols_Any_LSX;
-    if (IS_ALIGNED(dst_width, 8)) {
-      ScaleARGBFilterCols = ScaleARGBFilterCols_LSX;
+    int yi = (int)(y64 >> 16);
+    const uint8_t* src = src_argb + yi * src_stride;
+    if (plan->filtering == kFilterLinear) {
+      plan->ScaleCols(dst_argb, src, dst_width, x, dx);
+    } else {
+      int yf = (int)((y64 >> 8) & 255);
+      plan->InterpolateRow(row, src, src_stride, plan->interpolate_width, yf);
+      plan->ScaleCols(dst_argb, row, dst_width, x, dx);
     }
+    dst_argb += dst_stride;
+    y64 += dy;
   }
-#endif
-#if defined(HAS_SCALEARGBFILTERCOLS_RVV)
-  if (filtering && TestCpuFlag(kCpuHasRVV)) {
-    ScaleARGBFilterCols = ScaleARGBFilterCols_RVV;
+}
+
+// Select the row functions for ScaleARGBBilinearUp.
+static void ScaleARGBBilinearUpInit(struct ScalePlan* plan) {
+  const struct RowDispatch* dispatch = GetRowDispatch();
+  const int src_width = plan->src_width;
+  const int dst_width = plan->dst_width;
+  assert(plan->dy <= 65536);
+  plan->InterpolateRow = ROW_KERNEL(dispatch->InterpolateRow, dst_width * 4);
+  if (plan->filtering) {
+    plan->ScaleCols =
+        (src_width >= 32768)
+            ? ScaleARGBFilterCols64_C
+            : ROW_KERNEL(dispatch->ScaleARGBFilterCols, dst_width);
+  } else {
+    plan->ScaleCols =
+        (src_width >= 32768) ? ScaleARGBCols64_C : ScaleARGBCols_C;
   }
-#endif
 #if defined(HAS_SCALEARGBCOLS_SSE2)
-  if (!filtering && TestCpuFlag(kCpuHasSSE2) && src_width < 32768) {
-    ScaleARGBFilterCols = ScaleARGBCols_SSE2;
+  if (!plan->filtering && TestCpuFlag(kCpuHasSSE2) && src_width < 32768) {
+    plan->ScaleCols = ScaleARGBCols_SSE2;
   }
 #endif
 #if defined(HAS_SCALEARGBCOLS_NEON)
-  if (!filtering && TestCpuFlag(kCpuHasNEON)) {
-    ScaleARGBFilterCols = ScaleARGBCols_Any_NEON;
+  if (!plan->filtering && TestCpuFlag(kCpuHasNEON)) {
+    plan->ScaleCols = ScaleARGBCols_Any_NEON;
     if (IS_ALIGNED(dst_width, 8)) {
-      ScaleARGBFilterCols = ScaleARGBCols_NEON;
+      plan->ScaleCols = ScaleARGBCols_NEON;
     }
   }
 #endif
 #if defined(HAS_SCALEARGBCOLS_LSX)
-  if (!filtering && TestCpuFlag(kCpuHasLSX)) {
-    ScaleARGBFilterCols = ScaleARGBCols_Any_LSX;
+  if (!plan->filtering && TestCpuFlag(kCpuHasLSX)) {
+    plan->ScaleCols = ScaleARGBCols_Any_LSX;
     if (IS_ALIGNED(dst_width, 4)) {
-      ScaleARGBFilterCols = ScaleARGBCols_LSX;
+      plan->ScaleCols = ScaleARGBCols_LSX;
     }
   }
 #endif
-  if (!filtering && src_width * 2 == dst_width && x < 0x8000) {
-    ScaleARGBFilterCols = ScaleARGBColsUp2_C;
+  if (!plan->filtering && src_width * 2 == dst_width && plan->x < 0x8000) {
+    plan->ScaleCols = ScaleARGBColsUp2_C;
 #if defined(HAS_SCALEARGBCOLSUP2_SSE2)
     if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 8)) {
-      ScaleARGBFilterCols = ScaleARGBColsUp2_SSE2;
+      plan->ScaleCols = ScaleARGBColsUp2_SSE2;
     }
 #endif
   }
+  // 2 rows of ARGB.
+  plan->row_size = ((dst_width * 4 + 31) & ~31) * 2;
+}
 
-  int64_t y64 = y;
+// Scale ARGB up with bilinear interpolation.
+static void ScaleARGBBilinearUp(const struct ScalePlan* plan,
+                                ptrdiff_t src_stride,
+                                ptrdiff_t dst_stride,
+                                const uint8_t* src_argb,
+                                uint8_t* dst_argb,
+                                uint8_t* row) {
+  int j;
+  const int src_height = plan->src_height;
+  const int dst_width = plan->dst_width;
+  const int dst_height = plan->dst_height;
+  const int x = plan->x;
+  const int dx = plan->dx;
+  const int dy = plan->dy;
+  const int64_t max_y = (int64_t)(src_height - 1) << 16;
+  int64_t y64 = plan->y;
   if (y64 > max_y) {
     y64 = max_y;
   }
 
-  {
-    int yi = (int)(y64 >> 16);
-    const uint8_t* src = src_argb + yi * src_stride;
+  int yi = (int)(y64 >> 16);
+  const uint8_t* src = src_argb + yi * src_stride;
+  uint8_t* rowptr = row;
+  ptrdiff_t rowstride = plan->row_size / 2;
+  int lasty = yi;
 
-    // Allocate 2 rows of ARGB.
-    const int row_size = (dst_width * 4 + 31) & ~31;
-    align_buffer_64(row, row_size * 2);
-    if (!row)
-      return 1;
-
-    uint8_t* rowptr = row;
-    ptrdiff_t rowstride = row_size;
-    int lasty = yi;
+  plan->ScaleCols(rowptr, src, dst_width, x, dx);
+  if (src_height > 1) {
+    src += src_stride;
+  }
+  plan->ScaleCols(rowptr + rowstride, src, dst_width, x, dx);
+  if (src_height > 2) {
+    src += src_stride;
+  }
 
-    ScaleARGBFilterCols(rowptr, src, dst_width, x, dx);
-    if (src_height > 1) {
-      src += src_stride;
-    }
-    ScaleARGBFilterCols(rowptr + rowstride, src, dst_width, x, dx);
-    if (src_height > 2) {
-      src += src_stride;
+  // 2-row rolling buffer:
+  // rowptr and (rowptr + rowstride) hold the scaled rows for yi and yi + 1.
+  // Because dy <= 65536 (dy <= 1.0 in 16.16), yi advances in unit steps.
+  // When yi != lasty:
+  // 1. Scale the next source row into the older buffer (rowptr).
+  // 2. Swap buffer pointers (rowptr += rowstride; rowstride = -rowstride;)
+  //    so rowptr points to yi and (rowptr + rowstride) points to yi + 1.
+  // 3. Advance src by 1 row if row yi + 2 exists ((y64 + 65536) < max_y),
+  //    otherwise clamp src at (src_height - 1) to avoid reading out of bounds.
+  for (j = 0; j < dst_height; ++j) {
+    if (y64 > max_y) {
+      y64 = max_y;
     }
-
-    // 2-row rolling buffer:
-    // rowptr and (rowptr + rowstride) hold the scaled rows for yi and yi + 1.
-    // Because dy <= 65536 (dy <= 1.0 in 16.16), yi advances in unit steps.
-    // When yi != lasty:
-    // 1. Scale the next source row into the older buffer (rowptr).
-    // 2. Swap buffer pointers (rowptr += rowstride; rowstride = -rowstride;)
-    //    so rowptr points to yi and (rowptr + rowstride) points to yi + 1.
-    // 3. Advance src by 1 row if row yi + 2 exists ((y64 + 65536) < max_y),
-    //    otherwise clamp src at (src_height - 1) to avoid reading out of bounds.
-    for (j = 0; j < dst_height; ++j) {
-      if (y64 > max_y) {
-        y64 = max_y;
-      }
-      yi = (int)(y64 >> 16);
-      if (yi != lasty) {
-        ScaleARGBFilterCols(rowptr, src, dst_width, x, dx);
-        rowptr += rowstride;
-        rowstride = -rowstride;
-        lasty = yi;
-        if ((y64 + 65536) < max_y) {
-          src += src_stride;
-        }
+    yi = (int)(y64 >> 16);
+    if (yi != lasty) {
+      plan->ScaleCols(rowptr, src, dst_width, x, dx);
+      rowptr += rowstride;
+      rowstride = -rowstride;
+      lasty = yi;
+      if ((y64 + 65536) < max_y) {
+        src += src_stride;
       }
-      if (filtering == kFilterLinear) {
-        InterpolateRow(dst_argb, rowptr, 0, dst_width * 4, 0);
-      } else {
-        int yf = (int)((y64 >> 8) & 255);
-        InterpolateRow(dst_argb, rowptr, rowstride, dst_width * 4, yf);
-      }
-      dst_argb += dst_stride;
-      y64 += dy;
     }
-    free_aligned_buffer_64(row);
+    if (plan->filtering == kFilterLinear) {
+      plan->InterpolateRow(dst_argb, rowptr, 0, dst_width * 4, 0);
+    } else {
+      int yf = (int)((y64 >> 8) & 255);
+      plan->InterpolateRow(dst_argb, rowptr, rowstride, dst_width * 4, yf);
+    }
+    dst_argb += dst_stride;
+    y64 += dy;
   }
-  return 0;
 }
 
 // Scale ARGB to/from any dimensions, without interpolation.
@@ -624,113 +387,133 @@ static int ScaleARGBBilinearUp(int src_width,
 // of x and dx is the integer part of the source position and
 // the lower 16 bits are the fixed decimal part.
 
-static void ScaleARGBSimple(int src_width,
-                            int src_height,
-                            int dst_width,
-                            int dst_height,
-                            ptrdiff_t src_stride,
-                            ptrdiff_t dst_stride,
-                            const uint8_t* src_argb,
-                            uint8_t* dst_argb,
-                            int x,
-                            int dx,
-                            int y,
-                            int dy) {
-  int j;
-  void (*ScaleARGBCols)(uint8_t* dst_argb, const uint8_t* src_argb,
-                        int dst_width, int x, int dx) =
-      (src_width >= 32768) ? ScaleARGBCols64_C : ScaleARGBCols_C;
-  const int64_t max_y = (int64_t)(src_height - 1) << 16;
+static void ScaleARGBSimpleInit(struct ScalePlan* plan) {
+  const int src_width = plan->src_width;
+  const int dst_width = plan->dst_width;
+  plan->ScaleCols = (src_width >= 32768) ? ScaleARGBCols64_C : ScaleARGBCols_C;
 #if defined(HAS_SCALEARGBCOLS_SSE2)
   if (TestCpuFlag(kCpuHasSSE2) && src_width < 32768) {
-    ScaleARGBCols = ScaleARGBCols_SSE2;
+    plan->ScaleCols = ScaleARGBCols_SSE2;
   }
 #endif
 #if defined(HAS_SCALEARGBCOLS_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
-    ScaleARGBCols = ScaleARGBCols_Any_NEON;
+    plan->ScaleCols = ScaleARGBCols_Any_NEON;
     if (IS_ALIGNED(dst_width, 8)) {
-      ScaleARGBCols = ScaleARGBCols_NEON;
+      plan->ScaleCols = ScaleARGBCols_NEON;
     }
   }
 #endif
 #if defined(HAS_SCALEARGBCOLS_LSX)
   if (TestCpuFlag(kCpuHasLSX)) {
-    ScaleARGBCols = ScaleARGBCols_Any_LSX;
+    plan->ScaleCols = ScaleARGBCols_Any_LSX;
     if (IS_ALIGNED(dst_width, 4)) {
-      ScaleARGBCols = ScaleARGBCols_LSX;
+      plan->ScaleCols = ScaleARGBCols_LSX;
     }
   }
 #endif
-  if (src_width * 2 == dst_width && x < 0x8000) {
-    ScaleARGBCols = ScaleARGBColsUp2_C;
+  if (src_width * 2 == dst_width && plan->x < 0x8000) {
+    plan->ScaleCols = ScaleARGBColsUp2_C;
 #if defined(HAS_SCALEARGBCOLSUP2_SSE2)
     if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 8)) {
-      ScaleARGBCols = ScaleARGBColsUp2_SSE2;
+      plan->ScaleCols = ScaleARGBColsUp2_SSE2;
     }
 #endif
   }
+}
 
-  int64_t y64 = y;
+static void ScaleARGBSimple(const struct ScalePlan* plan,
+                            ptrdiff_t src_stride,
+                            ptrdiff_t dst_stride,
+                            const uint8_t* src_argb,
+                            uint8_t* dst_argb) {
+  int j;
+  const int dst_width = plan->dst_width;
+  const int dst_height = plan->dst_height;
+  const int x = plan->x;
+  const int dx = plan->dx;
+  const int dy = plan->dy;
+  const int64_t max_y = (int64_t)(plan->src_height - 1) << 16;
+  int64_t y64 = plan->y;
   for (j = 0; j < dst_height; ++j) {
     if (y64 > max_y) {
       y64 = max_y;
     }
-    ScaleARGBCols(dst_argb, src_argb + (y64 >> 16) * src_stride, dst_width, x,
-                  dx);
+    plan->ScaleCols(dst_argb, src_argb + (y64 >> 16) * src_stride, dst_width,
+                    x, dx);
     dst_argb += dst_stride;
     y64 += dy;
   }
 }
 
-// ScaleARGB a ARGB.
-// This function in turn calls a scaling function
-// suitable for handling the desired resolutions.
-static int ScaleARGB(const uint8_t* src,
-                     int src_stride,
-                     int src_width,
-                     int src_height,
-                     uint8_t* dst,
-                     int dst_stride,
-                     int dst_width,
-                     int dst_height,
-                     int clip_x,
-                     int clip_y,
-                     int clip_width,
-                     int clip_height,
-                     enum FilterMode filtering) {
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
+// Fill in a plan for ARGBScaleClip.
+// This function chooses a scaling function suitable for handling the
+// desired resolutions.
+int ScalePlanInitARGB(struct ScalePlan* plan,
+                      int src_width,
+                      int src_height,
+                      int dst_width,
+                      int dst_height,
+                      int clip_x,
+                      int clip_y,
+                      int clip_width,
+                      int clip_height,
+                      enum FilterMode filtering) {
+  if (src_width == 0 || src_height == 0 || src_height == INT_MIN ||
+      dst_width <= 0 || dst_height <= 0 || clip_x < 0 || clip_y < 0 ||
+      clip_width > 32768 || clip_height > 32768 ||
+      (clip_x + clip_width) > dst_width ||
+      (clip_y + clip_height) > dst_height) {
+    return -1;
+  }
+  memset(plan, 0, sizeof(*plan));
   // ARGB does not support box filter yet, but allow the user to pass it.
   // Simplify filtering when possible.
   filtering = ScaleFilterReduce(src_width, src_height, dst_width, dst_height,
                                 filtering);
 
-  // Negative src_height means invert the image.
-  if (src_height < 0) {
-    src_height = -src_height;
-    src = src + (src_height - 1) * (ptrdiff_t)src_stride;
-    src_stride = -src_stride;
-  }
-  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering, &x, &y,
-             &dx, &dy);
+  // Negative src_width means mirror and negative src_height means invert.
+  plan->mirror = src_width < 0;
+  plan->invert = src_height < 0;
+  src_height = Abs(src_height);
+  // Initial source x/y coordinate and step values as 16.16 fixed point.
+  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering, &plan->x,
+             &plan->y, &plan->dx, &plan->dy);
   src_width = Abs(src_width);
+  if (filtering >= kFilterBicubic) {
+    // The clip is filtered as part of the whole destination, from source
+    // pixel (0, 0).
+    plan->format = kScalePlanARGB;
+    plan->src_width = src_width;
+    plan->src_height = src_height;
+    plan->dst_width = clip_width;
+    plan->dst_height = clip_height;
+    plan->dst_offset_x = clip_x;
+    plan->dst_offset_y = clip_y;
+    plan->filtering = filtering;
+    ScalePolyphaseInit(plan, dst_width, dst_height);
+    return 0;
+  }
   if (clip_x) {
-    int64_t clipf = (int64_t)(clip_x)*dx;
-    x += (clipf & 0xffff);
-    src += (clipf >> 16) * 4;
-    dst += clip_x * 4;
+    int64_t clipf = (int64_t)(clip_x)*plan->dx;
+    plan->x += (clipf & 0xffff);
+    plan->src_offset_x = (int)(clipf >> 16);
+    plan->dst_offset_x = clip_x;
   }
   if (clip_y) {
-    int64_t clipf = (int64_t)(clip_y)*dy;
-    y += (clipf & 0xffff);
-    src += (clipf >> 16) * (ptrdiff_t)src_stride;
-    dst += clip_y * (ptrdiff_t)dst_stride;
-  }
+    int64_t clipf = (int64_t)(clip_y)*plan->dy;
+    plan->y += (clipf & 0xffff);
+    plan->src_offset_y = (int)(clipf >> 16);
+    plan->dst_offset_y = clip_y;
+  }
+  plan->format = kScalePlanARGB;
+  plan->src_width = src_width;
+  plan->src_height = src_height;
+  plan->dst_width = clip_width;
+  plan->dst_height = clip_height;
 
+  const int dx = plan->dx;
+  const int dy = plan->dy;
   // Special case for integer step values.
   if (((dx | dy) & 0xffff) == 0) {
     if (!dx || !dy) {  // 1 pixel wide and/or tall.
@@ -738,22 +521,18 @@ static int ScaleARGB(const uint8_t* src,
     } else {
       // Optimized even scale down. ie 2, 4, 6, 8, 10x.
       if (!(dx & 0x10000) && !(dy & 0x10000)) {
+        plan->filtering = filtering;
         if (dx == 0x20000 && dy == 0x20000) {
           // Optimized 1/2 downsample.
-          ScaleARGBDown2(src_width, src_height, clip_width, clip_height,
-                         src_stride, dst_stride, src, dst, x, dx, y, dy,
-                         filtering);
-          return 0;
-        }
-        if (dx == 0x40000 && dy == 0x40000 && filtering == kFilterBox) {
+          plan->method = kScaleMethodDown2;
+        } else if (dx == 0x40000 && dy == 0x40000 &&
+                   filtering == kFilterBox) {
           // Optimized 1/4 box downsample.
-          return ScaleARGBDown4Box(src_width, src_height, clip_width,
-                                   clip_height, src_stride, dst_stride, src,
-                                   dst, x, dx, y, dy);
+          plan->method = kScaleMethodDown4Box;
+          plan->row_size = ((clip_width * 2 * 4 + 31) & ~31) * 2;
+        } else {
+          plan->method = kScaleMethodDownEven;
         }
-        ScaleARGBDownEven(src_width, src_height, clip_width, clip_height,
-                          src_stride, dst_stride, src, dst, x, dx, y, dy,
-                          filtering);
         return 0;
       }
       // Optimized odd scale down. ie 3, 5, 7, 9x.
@@ -761,32 +540,155 @@ static int ScaleARGB(const uint8_t* src,
         filtering = kFilterNone;
         if (dx == 0x10000 && dy == 0x10000) {
           // Straight copy.
-          ARGBCopy(src + (y >> 16) * (ptrdiff_t)src_stride + (x >> 16) * 4,
-                   src_stride, dst, dst_stride, clip_width, clip_height);
+          plan->method = kScaleMethodCopy;
+          plan->filtering = filtering;
           return 0;
         }
       }
     }
   }
-  if (dx == 0x10000 && (x & 0xffff) == 0) {
+  plan->filtering = filtering;
+  if (dx == 0x10000 && (plan->x & 0xffff) == 0) {
     // Arbitrary scale vertically, but unscaled horizontally.
-    ScalePlaneVertical(src_height, clip_width, clip_height, src_stride,
-                       dst_stride, src, dst, x, y, dy, /*bpp=*/4, filtering);
-    return 0;
+    plan->method = kScaleMethodVertical;
+  } else if (filtering && dy < 65536) {
+    plan->method = kScaleMethodBilinearUp;
+    ScaleARGBBilinearUpInit(plan);
+  } else if (filtering) {
+    plan->method = kScaleMethodBilinearDown;
+    ScaleARGBBilinearDownInit(plan);
+  } else {
+    plan->method = kScaleMethodSimple;
+    ScaleARGBSimpleInit(plan);
   }
-  if (filtering && dy < 65536) {
-    return ScaleARGBBilinearUp(src_width, src_height, clip_width, clip_height,
-                               src_stride, dst_stride, src, dst, x, dx, y, dy,
-                               filtering);
+  return 0;
+}
+
+int ScalePlanRunARGB(const struct ScalePlan* plan,
+                     const uint8_t* src,
+                     int src_stride,
+                     uint8_t* dst,
+                     int dst_stride,
+                     uint8_t* row) {
+  const int src_width = plan->src_width;
+  const int src_height = plan->src_height;
+  const int clip_width = plan->dst_width;
+  const int clip_height = plan->dst_height;
+  const int x = plan->x;
+  const int y = plan->y;
+  const int dx = plan->dx;
+  const int dy = plan->dy;
+  if (plan->invert) {
+    src = src + (src_height - 1) * (ptrdiff_t)src_stride;
+    src_stride = -src_stride;
   }
-  if (filtering) {
-    return ScaleARGBBilinearDown(src_width, src_height, clip_width, clip_height,
-                                 src_stride, dst_stride, src, dst, x, dx, y, dy,
-                                 filtering);
+  src += plan->src_offset_y * (ptrdiff_t)src_stride + plan->src_offset_x * 4;
+  dst += plan->dst_offset_y * (ptrdiff_t)dst_stride + plan->dst_offset_x * 4;
+  switch (plan->method) {
+    case kScaleMethodDown2:
+      ScaleARGBDown2(src_width, src_height, clip_width, clip_height,
+                     src_stride, dst_stride, src, dst, x, dx, y, dy,
+                     plan->filtering);
+      return 0;
+    case kScaleMethodDown4Box:
+      ScaleARGBDown4Box(src_width, src_height, clip_width, clip_height,
+                        src_stride, dst_stride, src, dst, x, dx, y, dy, row);
+      return 0;
+    case kScaleMethodDownEven:
+      ScaleARGBDownEven(src_width, src_height, clip_width, clip_height,
+                        src_stride, dst_stride, src, dst, x, dx, y, dy,
+                        plan->filtering);
+      return 0;
+    case kScaleMethodCopy:
+      ARGBCopy(src + (y >> 16) * (ptrdiff_t)src_stride + (x >> 16) * 4,
+               src_stride, dst, dst_stride, clip_width, clip_height);
+      return 0;
+    case kScaleMethodVertical:
+      ScalePlaneVertical(src_height, clip_width, clip_height, src_stride,
+                         dst_stride, src, dst, x, y, dy, /*bpp=*/4,
+                         plan->filtering);
+      return 0;
+    case kScaleMethodBilinearUp:
+      ScaleARGBBilinearUp(plan, src_stride, dst_stride, src, dst, row);
+      return 0;
+    case kScaleMethodBilinearDown:
+      ScaleARGBBilinearDown(plan, src_stride, dst_stride, src, dst, row);
+      return 0;
+    case kScaleMethodPolyphase:
+      ScalePolyphase(plan, src, src_stride, dst, dst_stride, 0, clip_height,
+                     row);
+      return 0;
+    default:
+      ScaleARGBSimple(plan, src_stride, dst_stride, src, dst);
+      return 0;
   }
-  ScaleARGBSimple(src_width, src_height, clip_width, clip_height, src_stride,
-                  dst_stride, src, dst, x, dx, y, dy);
-  return 0;
+}
+
+// Number of destination rows scaled per band when row streaming.
+#define ARGB_BAND_ROWS 32
+
+void ScalePlanRowRangeARGB(const struct ScalePlan* plan,
+                           int dst_y_begin,
+                           int dst_y_end,
+                           int* src_y_begin,
+                           int* src_y_end) {
+  // Margin of 2 rows each side covers the filter taps and box offsets.
+  const int64_t y0 = plan->y + (int64_t)plan->dy * dst_y_begin;
+  const int64_t y1 = plan->y + (int64_t)plan->dy * dst_y_end;
+  int y_begin = plan->src_offset_y + (int)(y0 >> 16) - 2;
+  int y_end = plan->src_offset_y + (int)(y1 >> 16) + 3;
+  if (plan->method == kScaleMethodPolyphase) {
+    ScalePolyphaseRowRange(plan, dst_y_begin, dst_y_end, &y_begin, &y_end);
+  }
+  y_begin = y_begin < 0 ? 0 : y_begin;
+  y_begin = y_begin > plan->src_height - 1 ? plan->src_height - 1 : y_begin;
+  y_end = y_end > plan->src_height ? plan->src_height : y_end;
+  y_end = y_end <= y_begin ? y_begin + 1 : y_end;
+  *src_y_begin = y_begin;
+  *src_y_end = y_end;
+}
+
+int ScalePlanBandRowsARGB(const struct ScalePlan* plan, int* max_src_rows) {
+  int band_rows = ARGB_BAND_ROWS;
+  int64_t src_rows;
+  if (plan->dy > 65536) {
+    band_rows = (int)(((int64_t)ARGB_BAND_ROWS << 16) / plan->dy);
+    band_rows = band_rows < 1 ? 1 : band_rows;
+  }
+  src_rows = (((int64_t)band_rows * plan->dy) >> 16) +
+             (plan->method == kScaleMethodPolyphase ? plan->taps_y + 2 : 6);
+  *max_src_rows =
+      src_rows > plan->src_height ? plan->src_height : (int)src_rows;
+  return band_rows;
+}
+
+int ScalePlanRunBandARGB(const struct ScalePlan* plan,
+                         int dst_y_begin,
+                         int dst_y_end,
+                         const uint8_t* src,
+                         int src_stride,
+                         int src_x_begin,
+                         int src_y_begin,
+                         uint8_t* dst,
+                         int dst_stride,
+                         uint8_t* row) {
+  struct ScalePlan band = *plan;
+  if (plan->method == kScaleMethodPolyphase) {
+    // Polyphase rows are addressed from row 0 of the source and destination.
+    ScalePolyphase(plan,
+                   src - (ptrdiff_t)src_y_begin * src_stride - src_x_begin * 4,
+                   src_stride,
+                   dst + plan->dst_offset_y * (ptrdiff_t)dst_stride +
+                       plan->dst_offset_x * 4,
+                   dst_stride, dst_y_begin, dst_y_end, row);
+    return 0;
+  }
+  band.y = (int)(plan->y + (int64_t)plan->dy * dst_y_begin);
+  band.dst_height = dst_y_end - dst_y_begin;
+  band.src_offset_x = plan->src_offset_x - src_x_begin;
+  band.src_offset_y = plan->src_offset_y - src_y_begin;
+  band.invert = 0;
+  return ScalePlanRunARGB(&band, src, src_stride, dst, dst_stride, row);
 }
 
 LIBYUV_API
@@ -803,16 +705,14 @@ int ARGBScaleClip(const uint8_t* src_argb,
                   int clip_width,
                   int clip_height,
                   enum FilterMode filtering) {
-  if (!src_argb || src_width == 0 || src_height == 0 || src_height == INT_MIN ||
-      !dst_argb || dst_width <= 0 || dst_height <= 0 || clip_x < 0 ||
-      clip_y < 0 || clip_width > 32768 || clip_height > 32768 ||
-      (clip_x + clip_width) > dst_width ||
-      (clip_y + clip_height) > dst_height) {
+  struct ScalePlan plan;
+  if (!src_argb || !dst_argb ||
+      ScalePlanInitARGB(&plan, src_width, src_height, dst_width, dst_height,
+                        clip_x, clip_y, clip_width, clip_height, filtering)) {
     return -1;
   }
-  return ScaleARGB(src_argb, src_stride_argb, src_width, src_height, dst_argb,
-                   dst_stride_argb, dst_width, dst_height, clip_x, clip_y,
-                   clip_width, clip_height, filtering);
+  return ScalePlanRunOnce(&plan, src_argb, src_stride_argb, dst_argb,
+                          dst_stride_argb);
 }
 
 // Scale an ARGB image.
@@ -826,17 +726,19 @@ int ARGBScale(const uint8_t* src_argb,
               int dst_width,
               int dst_height,
               enum FilterMode filtering) {
-  if (!src_argb || src_width == 0 || src_height == 0 || src_height == INT_MIN ||
-      src_width > 32768 || src_height > 32768 || !dst_argb || dst_width <= 0 ||
-      dst_height <= 0) {
+  struct ScalePlan plan;
+  if (!src_argb || src_width > 32768 || src_height > 32768 || !dst_argb ||
+      ScalePlanInitARGB(&plan, src_width, src_height, dst_width, dst_height, 0,
+                        0, dst_width, dst_height, filtering)) {
     return -1;
   }
-  return ScaleARGB(src_argb, src_stride_argb, src_width, src_height, dst_argb,
-                   dst_stride_argb, dst_width, dst_height, 0, 0, dst_width,
-                   dst_height, filtering);
+  return ScalePlanRunOnce(&plan, src_argb, src_stride_argb, dst_argb,
+                          dst_stride_argb);
 }
 
 // Scale with YUV conversion to ARGB and clipping.
+// Source rows are converted to ARGB a band at a time, and only the columns
+// that the clip rectangle reads, so no full frame ARGB buffer is needed.
 LIBYUV_API
 int YUVToARGBScaleClip(const uint8_t* src_y,
                        int src_stride_y,
@@ -857,36 +759,345 @@ int YUVToARGBScaleClip(const uint8_t* src_y,
                        int clip_width,
                        int clip_height,
                        enum FilterMode filtering) {
+  struct ScalePlan plan;
+  const struct YuvConstants* yuvconstants;
+  const struct YuvConstants* yvuconstants;
   int r;
-  (void)src_fourcc;  // TODO(fbarchard): implement and/or assert.
-  (void)dst_fourcc;
   if (!src_y || !src_u || !src_v || !dst_argb || src_width <= 0 ||
       src_width > INT_MAX / 4 || src_height == 0 || src_height == INT_MIN ||
       dst_width <= 0 || dst_height <= 0 || clip_width <= 0 ||
       clip_height <= 0) {
     return -1;
   }
+  switch (CanonicalFourCC(src_fourcc)) {
+    case FOURCC_I420:
+    case FOURCC_YV12:
+      yuvconstants = &kYuvI601Constants;
+      yvuconstants = &kYvuI601Constants;
+      break;
+    case FOURCC_J420:
+      yuvconstants = &kYuvJPEGConstants;
+      yvuconstants = &kYvuJPEGConstants;
+      break;
+    case FOURCC_H420:
+      yuvconstants = &kYuvH709Constants;
+      yvuconstants = &kYvuH709Constants;
+      break;
+    case FOURCC_U420:
+      yuvconstants = &kYuv2020Constants;
+      yvuconstants = &kYvu2020Constants;
+      break;
+    default:
+      return -1;
+  }
+  if (CanonicalFourCC(src_fourcc) == FOURCC_YV12) {
+    const uint8_t* src_tmp = src_u;
+    int stride_tmp = src_stride_u;
+    src_u = src_v;
+    src_stride_u = src_stride_v;
+    src_v = src_tmp;
+    src_stride_v = stride_tmp;
+  }
+  // ABGR is ARGB with U and V swapped and the mirrored matrix.
+  if (dst_fourcc == FOURCC_ABGR) {
+    const uint8_t* src_tmp = src_u;
+    int stride_tmp = src_stride_u;
+    src_u = src_v;
+    src_stride_u = src_stride_v;
+    src_v = src_tmp;
+    src_stride_v = stride_tmp;
+    yuvconstants = yvuconstants;
+  } else if (dst_fourcc != FOURCC_ARGB) {
+    return -1;
+  }
+
   const int abs_src_height = (src_height < 0) ? -src_height : src_height;
-  const uint64_t argb_buffer_size = (uint64_t)src_width * abs_src_height * 4;
+  r = ScalePlanInitARGB(&plan, src_width, abs_src_height, dst_width,
+                        dst_height, clip_x, clip_y, clip_width, clip_height,
+                        filtering);
+  if (r != 0) {
+    return r;
+  }
+
+  // Source columns read by the clip, with a margin for filter taps.
+  const int64_t x_end = plan.x + (int64_t)plan.dx * plan.dst_width;
+  int col_lo = plan.src_offset_x + (plan.x >> 16) - 2;
+  int col_hi = plan.src_offset_x + (int)(x_end >> 16) + 2;
+  if (plan.method == kScaleMethodBilinearDown &&
+      col_hi < plan.src_offset_x + plan.interpolate_width) {
+    col_hi = plan.src_offset_x + plan.interpolate_width;
+  }
+  if (plan.method == kScaleMethodPolyphase) {
+    col_lo = 0;
+    col_hi = src_width - 1;
+  }
+  col_lo = (col_lo < 0 ? 0 : col_lo) & ~1;  // Even for subsampled chroma.
+  col_hi = col_hi > src_width - 1 ? src_width - 1 : col_hi;
+  const int band_width = col_hi - col_lo + 1;
+  const int band_stride = (band_width * 4 + 63) & ~63;
+
+  int max_src_rows;
+  const int band_rows = ScalePlanBandRowsARGB(&plan, &max_src_rows);
+  // One more row to start bands on an even row.
+  const uint64_t band_size = (uint64_t)(max_src_rows + 1) * band_stride;
+  const uint64_t buffer_size = band_size + ((plan.row_size + 63) & ~63);
 #if UINT64_MAX > SIZE_MAX
-  if (argb_buffer_size > SIZE_MAX) {
+  if (buffer_size > SIZE_MAX) {
     return -1;  // Invalid size.
   }
 #endif
-  uint8_t* argb_buffer = (uint8_t*)malloc((size_t)argb_buffer_size);
-  if (!argb_buffer) {
+  align_buffer_64(band, (size_t)buffer_size);
+  if (!band) {
     return 1;  // Out of memory runtime error.
   }
-  I420ToARGB(src_y, src_stride_y, src_u, src_stride_u, src_v, src_stride_v,
-             argb_buffer, src_width * 4, src_width, src_height);
+  uint8_t* row = plan.row_size ? band + band_size : NULL;
 
-  r = ARGBScaleClip(argb_buffer, src_width * 4, src_width, abs_src_height,
-                    dst_argb, dst_stride_argb, dst_width, dst_height, clip_x,
-                    clip_y, clip_width, clip_height, filtering);
-  free(argb_buffer);
+  int y;
+  for (y = 0; y < plan.dst_height && r == 0; y += band_rows) {
+    const int y_end =
+        y + band_rows < plan.dst_height ? y + band_rows : plan.dst_height;
+    int src_y_begin;
+    int src_y_end;
+    int band_y;
+    ScalePlanRowRangeARGB(&plan, y, y_end, &src_y_begin, &src_y_end);
+    // Convert the source rows starting on an even row so that chroma rows
+    // pair with the same luma rows as a full frame conversion.
+    if (src_height < 0) {
+      const int s0 = (abs_src_height - src_y_end) & ~1;
+      const int s1 = abs_src_height - 1 - src_y_begin;
+      band_y = src_y_begin;
+      r = I420ToARGBMatrix(
+          src_y + (ptrdiff_t)s0 * src_stride_y + col_lo, src_stride_y,
+          src_u + (ptrdiff_t)(s0 / 2) * src_stride_u + col_lo / 2,
+          src_stride_u,
+          src_v + (ptrdiff_t)(s0 / 2) * src_stride_v + col_lo / 2,
+          src_stride_v, band, band_stride, yuvconstants, band_width,
+          -(s1 - s0 + 1));
+    } else {
+      const int s0 = src_y_begin & ~1;
+      band_y = s0;
+      r = I420ToARGBMatrix(
+          src_y + (ptrdiff_t)s0 * src_stride_y + col_lo, src_stride_y,
+          src_u + (ptrdiff_t)(s0 / 2) * src_stride_u + col_lo / 2,
+          src_stride_u,
+          src_v + (ptrdiff_t)(s0 / 2) * src_stride_v + col_lo / 2,
+          src_stride_v, band, band_stride, yuvconstants, band_width,
+          src_y_end - s0);
+    }
+    if (r == 0) {
+      r = ScalePlanRunBandARGB(
+          &plan, y, y_end, band, band_stride, col_lo, band_y,
+          dst_argb + (ptrdiff_t)y * dst_stride_argb, dst_stride_argb, row);
+    }
+  }
+  free_aligned_buffer_64(band);
   return r;
 }
 
+// Destination tile size of ARGBWarpAffine.  A tile of a rotated image reads
+// a source region small enough to stay in cache.
+#define WARP_TILE 64
+
+// Sample one ARGBWarpAffine pixel near or outside the source edges.  u, v
+// are the source coordinates of the destination pixel center.
+static void WarpAffinePixel(const uint8_t* src_argb,
+                            int src_stride_argb,
+                            int src_width,
+                            int src_height,
+                            double u,
+                            double v,
+                            int filter,
+                            uint32_t border_argb,
+                            uint8_t* dst_argb) {
+  const uint8_t* s00;
+  const uint8_t* s01;
+  const uint8_t* s10;
+  const uint8_t* s11;
+  int x0, y0, x1, y1, fx, fy, c;
+  if (!(u >= 0. && v >= 0. && u < src_width && v < src_height)) {
+    *(uint32_t*)(dst_argb) = border_argb;
+    return;
+  }
+  if (!filter) {
+    *(uint32_t*)(dst_argb) =
+        *(const uint32_t*)(src_argb + (ptrdiff_t)(int)v * src_stride_argb +
+                           (int)u * 4);
+    return;
+  }
+  // Bilinear between pixel centers with the edge pixels repeated.
+  u -= 0.5;
+  v -= 0.5;
+  x0 = (int)floor(u);
+  y0 = (int)floor(v);
+  fx = (int)((u - x0) * 64.);
+  fy = (int)((v - y0) * 64.);
+  x1 = x0 + 1 < src_width ? x0 + 1 : src_width - 1;
+  y1 = y0 + 1 < src_height ? y0 + 1 : src_height - 1;
+  x0 = x0 < 0 ? 0 : x0;
+  y0 = y0 < 0 ? 0 : y0;
+  s00 = src_argb + (ptrdiff_t)y0 * src_stride_argb + x0 * 4;
+  s01 = src_argb + (ptrdiff_t)y0 * src_stride_argb + x1 * 4;
+  s10 = src_argb + (ptrdiff_t)y1 * src_stride_argb + x0 * 4;
+  s11 = src_argb + (ptrdiff_t)y1 * src_stride_argb + x1 * 4;
+  for (c = 0; c < 4; ++c) {
+    int t = (s00[c] * (64 - fx) + s01[c] * fx + 32) >> 6;
+    int b = (s10[c] * (64 - fx) + s11[c] * fx + 32) >> 6;
+    dst_argb[c] = (uint8_t)((t * (64 - fy) + b * fy + 32) >> 6);
+  }
+}
+
+// Narrow [*x0, *x1] to the x where lo <= a + d * x <= hi.
+static void WarpAffineSpan(double a,
+                           double d,
+                           double lo,
+                           double hi,
+                           double* x0,
+                           double* x1) {
+  double p, q;
+  if (lo > hi) {  // Source too small for the margin.
+    *x1 = *x0 - 1.;
+    return;
+  }
+  if (d == 0.) {
+    if (!(a >= lo && a <= hi)) {
+      *x1 = *x0 - 1.;
+    }
+    return;
+  }
+  p = (lo - a) / d;
+  q = (hi - a) / d;
+  if (p > q) {
+    double t = p;
+    p = q;
+    q = t;
+  }
+  *x0 = p > *x0 ? p : *x0;
+  *x1 = q < *x1 ? q : *x1;
+}
+
+// Warp an ARGB image with an affine transform.
+// Each destination row of a tile is split into a span that the row kernel
+// samples without bounds checks, and edge pixels done one at a time.
+LIBYUV_API
+int ARGBWarpAffine(const uint8_t* src_argb,
+                   int src_stride_argb,
+                   int src_width,
+                   int src_height,
+                   uint8_t* dst_argb,
+                   int dst_stride_argb,
+                   int dst_width,
+                   int dst_height,
+                   const float* matrix,
+                   enum FilterMode filtering,
+                   uint32_t border_argb) {
+  const int filter = filtering != kFilterNone;
+  // The filter kernel samples between pixel centers and reads 1 pixel right
+  // and below.
+  const double shift = filter ? 0.5 : 0.;
+  double margin, hi_u, hi_v;
+  int tx, ty, x, y;
+  void (*AffineRow)(const uint8_t* src_argb, int src_argb_stride,
+                    uint8_t* dst_argb, const float* uv_dudv, int width) =
+      filter ? ARGBAffineFilterRow_C : ARGBAffineRow_C;
+  if (!src_argb || !dst_argb || !matrix || src_width <= 0 ||
+      src_width > INT_MAX / 4 || src_height == 0 || src_height == INT_MIN ||
+      dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (src_height < 0) {
+    src_height = -src_height;
+    src_argb = src_argb + (ptrdiff_t)(src_height - 1) * src_stride_argb;
+    src_stride_argb = -src_stride_argb;
+  }
+  // Kernel coordinates are float and drift along a span.  Keep spans far
+  // enough inside the source that the drift cannot reach past the edge.
+  margin = 1. + (src_width > src_height ? src_width : src_height) * 256. *
+                    FLT_EPSILON;
+  hi_u = (filter ? src_width - 1 : src_width) - margin;
+  hi_v = (filter ? src_height - 1 : src_height) - margin;
+  // SIMD kernels compute offsets in 32 bits, and SSE2 in 16 bits.
+  if ((int64_t)src_height * Abs(src_stride_argb) <= INT_MAX) {
+    if (!filter) {
+#if defined(HAS_ARGBAFFINEROW_SSE2)
+      if (TestCpuFlag(kCpuHasSSE2) && Abs(src_stride_argb) <= 32767 &&
+          src_width <= 32767 && src_height <= 32767) {
+        AffineRow = ARGBAffineRow_SSE2;
+      }
+#endif
+#if defined(HAS_ARGBAFFINEROW_AVX2)
+      if (TestCpuFlag(kCpuHasAVX2)) {
+        AffineRow = ARGBAffineRow_Any_AVX2;
+      }
+#endif
+#if defined(HAS_ARGBAFFINEROW_AVX512BW)
+      if (TestCpuFlag(kCpuHasAVX512BW)) {
+        AffineRow = ARGBAffineRow_Any_AVX512BW;
+      }
+#endif
+    } else {
+#if defined(HAS_ARGBAFFINEFILTERROW_AVX2)
+      if (TestCpuFlag(kCpuHasAVX2)) {
+        AffineRow = ARGBAffineFilterRow_Any_AVX2;
+      }
+#endif
+    }
+  }
+
+  for (ty = 0; ty < dst_height; ty += WARP_TILE) {
+    const int ty_end =
+        ty + WARP_TILE < dst_height ? ty + WARP_TILE : dst_height;
+    for (tx = 0; tx < dst_width; tx += WARP_TILE) {
+      const int tx_end =
+          tx + WARP_TILE < dst_width ? tx + WARP_TILE : dst_width;
+      for (y = ty; y < ty_end; ++y) {
+        uint8_t* dst = dst_argb + (ptrdiff_t)y * dst_stride_argb;
+        // Source coordinates at x = 0 of this row, shifted for the kernel.
+        const double a_u = 0.5 * matrix[0] + (y + 0.5) * matrix[1] +
+                           matrix[2] - shift;
+        const double a_v = 0.5 * matrix[3] + (y + 0.5) * matrix[4] +
+                           matrix[5] - shift;
+        double x0 = tx;
+        double x1 = tx_end - 1;
+        int span_begin, span_end;
+        WarpAffineSpan(a_u, matrix[0], margin, hi_u, &x0, &x1);
+        WarpAffineSpan(a_v, matrix[3], margin, hi_v, &x0, &x1);
+        if (x0 <= x1) {
+          span_begin = (int)ceil(x0);
+          span_end = (int)floor(x1) + 1;
+        } else {
+          span_begin = span_end = tx_end;
+        }
+        if (span_begin >= span_end) {
+          span_begin = span_end = tx_end;
+        }
+        for (x = tx; x < span_begin; ++x) {
+          WarpAffinePixel(src_argb, src_stride_argb, src_width, src_height,
+                          a_u + x * matrix[0] + shift,
+                          a_v + x * matrix[3] + shift, filter, border_argb,
+                          dst + x * 4);
+        }
+        if (span_begin < span_end) {
+          float uv_dudv[4];
+          uv_dudv[0] = (float)(a_u + span_begin * matrix[0]);
+          uv_dudv[1] = (float)(a_v + span_begin * matrix[3]);
+          uv_dudv[2] = matrix[0];
+          uv_dudv[3] = matrix[3];
+          AffineRow(src_argb, src_stride_argb, dst + span_begin * 4, uv_dudv,
+                    span_end - span_begin);
+        }
+        for (x = span_end; x < tx_end; ++x) {
+          WarpAffinePixel(src_argb, src_stride_argb, src_width, src_height,
+                          a_u + x * matrix[0] + shift,
+                          a_v + x * matrix[3] + shift, filter, border_argb,
+                          dst + x * 4);
+        }
+      }
+    }
+  }
+  return 0;
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
@@ -11,11 +11,13 @@
 #include "libyuv/scale.h"
 
 #include <assert.h>
+#include <math.h>
 #include <string.h>
 
 #include "libyuv/cpu_id.h"
 #include "libyuv/planar_functions.h"  // For CopyARGB
 #include "libyuv/row.h"
+#include "libyuv/row_dispatch.h"
 #include "libyuv/scale_row.h"
 
 #ifdef __cplusplus
@@ -1456,6 +1458,130 @@ void ScaleUVFilterCols64_C(uint8_t* dst_uv,
 #undef BLENDERC
 #undef BLENDER
 
+// Polyphase filters.  Coefficients are 14 bit fixed point.  8 bit pixels are
+// filtered horizontally to 6 bits of fraction, clamped to 0 to 255 << 6, and
+// filtered vertically back to 8 bits.  16 bit pixels stay 16 bit and are
+// clamped to the range of the source pixels under the kernel, as a 16 bit
+// plane may hold 10 or 12 bit values that ringing must not push out of range.
+static __inline void ScalePolyphaseColsBpp_C(const uint8_t* src_ptr,
+                                             uint16_t* dst_ptr,
+                                             int dst_width,
+                                             const int32_t* starts,
+                                             const int16_t* coeffs,
+                                             int taps,
+                                             int bpp) {
+  int i, j, c;
+  for (i = 0; i < dst_width; ++i) {
+    const uint8_t* src = src_ptr + starts[i] * bpp;
+    for (c = 0; c < bpp; ++c) {
+      int sum = 0;
+      for (j = 0; j < taps; ++j) {
+        sum += src[j * bpp + c] * coeffs[j];
+      }
+      sum = (sum + 128) >> 8;
+      sum = sum < 0 ? 0 : sum;
+      dst_ptr[c] = (uint16_t)(sum > (255 << 6) ? (255 << 6) : sum);
+    }
+    coeffs += taps;
+    dst_ptr += bpp;
+  }
+}
+
+void ScalePolyphaseCols_C(const uint8_t* src_ptr,
+                          uint16_t* dst_ptr,
+                          int dst_width,
+                          const int32_t* starts,
+                          const int16_t* coeffs,
+                          int taps) {
+  ScalePolyphaseColsBpp_C(src_ptr, dst_ptr, dst_width, starts, coeffs, taps,
+                          1);
+}
+
+void ScaleUVPolyphaseCols_C(const uint8_t* src_uv,
+                            uint16_t* dst_ptr,
+                            int dst_width,
+                            const int32_t* starts,
+                            const int16_t* coeffs,
+                            int taps) {
+  ScalePolyphaseColsBpp_C(src_uv, dst_ptr, dst_width, starts, coeffs, taps, 2);
+}
+
+void ScaleARGBPolyphaseCols_C(const uint8_t* src_argb,
+                              uint16_t* dst_ptr,
+                              int dst_width,
+                              const int32_t* starts,
+                              const int16_t* coeffs,
+                              int taps) {
+  ScalePolyphaseColsBpp_C(src_argb, dst_ptr, dst_width, starts, coeffs, taps,
+                          4);
+}
+
+void ScalePolyphaseCols_16_C(const uint16_t* src_ptr,
+                             uint16_t* dst_ptr,
+                             int dst_width,
+                             const int32_t* starts,
+                             const int16_t* coeffs,
+                             int taps) {
+  int i, j;
+  for (i = 0; i < dst_width; ++i) {
+    const uint16_t* src = src_ptr + starts[i];
+    int64_t sum = 0;
+    int lo = 65535;
+    int hi = 0;
+    for (j = 0; j < taps; ++j) {
+      sum += (int64_t)src[j] * coeffs[j];
+      if (coeffs[j]) {
+        lo = src[j] < lo ? src[j] : lo;
+        hi = src[j] > hi ? src[j] : hi;
+      }
+    }
+    sum = (sum + 8192) >> 14;
+    sum = sum < lo ? lo : sum;
+    dst_ptr[i] = (uint16_t)(sum > hi ? hi : sum);
+    coeffs += taps;
+  }
+}
+
+void ScalePolyphaseRows_C(const uint16_t* const* src_rows,
+                          const int16_t* coeffs,
+                          int taps,
+                          uint8_t* dst_ptr,
+                          int width) {
+  int x, j;
+  for (x = 0; x < width; ++x) {
+    int sum = 0;
+    for (j = 0; j < taps; ++j) {
+      sum += src_rows[j][x] * coeffs[j];
+    }
+    sum = (sum + (1 << 19)) >> 20;
+    sum = sum < 0 ? 0 : sum;
+    dst_ptr[x] = (uint8_t)(sum > 255 ? 255 : sum);
+  }
+}
+
+void ScalePolyphaseRows_16_C(const uint16_t* const* src_rows,
+                             const int16_t* coeffs,
+                             int taps,
+                             uint16_t* dst_ptr,
+                             int width) {
+  int x, j;
+  for (x = 0; x < width; ++x) {
+    int64_t sum = 0;
+    int lo = 65535;
+    int hi = 0;
+    for (j = 0; j < taps; ++j) {
+      sum += (int64_t)src_rows[j][x] * coeffs[j];
+      if (coeffs[j]) {
+        lo = src_rows[j][x] < lo ? src_rows[j][x] : lo;
+        hi = src_rows[j][x] > hi ? src_rows[j][x] : hi;
+      }
+    }
+    sum = (sum + 8192) >> 14;
+    sum = sum < lo ? lo : sum;
+    dst_ptr[x] = (uint16_t)(sum > hi ? hi : sum);
+  }
+}
+
 // Scale plane vertically with bilinear interpolation.
 void ScalePlaneVertical(int src_height,
                         int dst_width,
@@ -1483,45 +1609,8 @@ void ScalePlaneVertical(int src_height,
   assert(dst_width > 0);
   assert(dst_height > 0);
   src_argb += (x >> 16) * bpp;
-#if defined(HAS_INTERPOLATEROW_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    InterpolateRow = InterpolateRow_Any_AVX2;
-    if (IS_ALIGNED(dst_width_bytes, 32)) {
-      InterpolateRow = InterpolateRow_AVX2;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    InterpolateRow = InterpolateRow_Any_NEON;
-    if (IS_ALIGNED(dst_width_bytes, 16)) {
-      InterpolateRow = InterpolateRow_NEON;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_SVE2)
-  if (TestCpuFlag(kCpuHasSVE2)) {
-    InterpolateRow = InterpolateRow_SVE2;
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_SME)
-  if (TestCpuFlag(kCpuHasSME)) {
-    InterpolateRow = InterpolateRow_SME;
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_LSX)
-  if (TestCpuFlag(kCpuHasLSX)) {
-    InterpolateRow = InterpolateRow_Any_LSX;
-    if (IS_ALIGNED(dst_width_bytes, 32)) {
-      InterpolateRow = InterpolateRow_LSX;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_RVV)
-  if (TestCpuFlag(kCpuHasRVV)) {
-    InterpolateRow = InterpolateRow_RVV;
-  }
-#endif
+  InterpolateRow =
+      ROW_KERNEL(GetRowDispatch()->InterpolateRow, dst_width_bytes);
 
   for (j = 0; j < dst_height; ++j) {
     int yi;
@@ -1620,6 +1709,15 @@ enum FilterMode ScaleFilterReduce(int src_width,
   if (src_height < 0) {
     src_height = -src_height;
   }
+  if (filtering >= kFilterBicubic) {
+    // Polyphase filters are not needed to copy and are slow for large
+    // reductions, where a box filter looks as good.
+    if (dst_width == src_width && dst_height == src_height) {
+      filtering = kFilterNone;
+    } else if (src_width > dst_width * 10 || src_height > dst_height * 10) {
+      filtering = kFilterBox;
+    }
+  }
   if (filtering == kFilterBox) {
     // If scaling either axis to 0.5 or larger, switch from Box to Bilinear.
     if (dst_width * 2 >= src_width || dst_height * 2 >= src_height) {
@@ -1738,6 +1836,318 @@ void ScaleSlope(int src_width,
 }
 #undef CENTERSTART
 
+// Polyphase scaling.  Each destination pixel is a weighted sum of the source
+// pixels under a kernel centered on it.  When scaling down the kernel is
+// stretched by the scale factor so it also low pass filters.
+static const double kScalePolyphasePi = 3.14159265358979323846;
+
+static double ScalePolyphaseSupport(enum FilterMode filtering) {
+  return filtering == kFilterLanczos3 ? 3.0 : 2.0;
+}
+
+static double ScalePolyphaseKernel(enum FilterMode filtering, double x) {
+  x = fabs(x);
+  if (filtering == kFilterLanczos3) {
+    if (x < 1e-8) {
+      return 1.0;
+    }
+    if (x >= 3.0) {
+      return 0.0;
+    }
+    return 3.0 * sin(kScalePolyphasePi * x) *
+           sin(kScalePolyphasePi * x / 3.0) /
+           (kScalePolyphasePi * kScalePolyphasePi * x * x);
+  }
+  // Bicubic with a = -0.5, as used by Catmull-Rom splines.
+  if (x < 1.0) {
+    return (1.5 * x - 2.5) * x * x + 1.0;
+  }
+  if (x < 2.0) {
+    return ((-0.5 * x + 2.5) * x - 4.0) * x + 2.0;
+  }
+  return 0.0;
+}
+
+// Number of coefficients per pixel for scaling src_size to dst_size.
+static int ScalePolyphaseTaps(enum FilterMode filtering,
+                              int src_size,
+                              int dst_size) {
+  const double scale = (double)src_size / dst_size;
+  int taps;
+  if (src_size == dst_size) {
+    return 1;
+  }
+  taps = (int)ceil(ScalePolyphaseSupport(filtering) *
+                   (scale > 1.0 ? scale : 1.0) * 2.0) +
+         1;
+  taps = taps < src_size ? taps : src_size;
+  return taps < SCALE_POLYPHASE_MAX_TAPS ? taps : SCALE_POLYPHASE_MAX_TAPS;
+}
+
+// Fill in the first source pixel and the coefficients, which add up to 16384,
+// of destination pixels [begin, end) of dst_size.  Coefficients outside the
+// kernel are 0, so the number of taps may be padded for row functions.
+static void ScalePolyphaseTable(enum FilterMode filtering,
+                                int src_size,
+                                int dst_size,
+                                int taps,
+                                int begin,
+                                int end,
+                                int32_t* starts,
+                                int16_t* coeffs) {
+  const double scale = (double)src_size / dst_size;
+  const double stretch = scale > 1.0 ? scale : 1.0;
+  const double support = ScalePolyphaseSupport(filtering) * stretch;
+  double weights[SCALE_POLYPHASE_MAX_TAPS];
+  int i, j;
+  for (i = begin; i < end; ++i) {
+    const double center = (i + 0.5) * scale;
+    int xmin = (int)floor(center - support + 0.5);
+    int xmax = (int)floor(center + support + 0.5);
+    int start;
+    int largest = 0;
+    int total = 0;
+    double sum = 0.0;
+    if (src_size == dst_size) {
+      xmin = i;
+      xmax = i + 1;
+    }
+    xmin = xmin < 0 ? 0 : xmin;
+    xmax = xmax > src_size ? src_size : xmax;
+    xmax = xmax - xmin > taps ? xmin + taps : xmax;
+    start = xmin < src_size - taps ? xmin : src_size - taps;
+    for (j = 0; j < taps; ++j) {
+      const int x = start + j;
+      weights[j] =
+          (x >= xmin && x < xmax)
+              ? ScalePolyphaseKernel(filtering, (x + 0.5 - center) / stretch)
+              : 0.0;
+      sum += weights[j];
+    }
+    if (fabs(sum) < 1e-6) {
+      // Only kernel zero crossings are covered.  Use the nearest pixel.
+      for (j = 0; j < taps; ++j) {
+        weights[j] = 0.0;
+      }
+      j = (int)center - start;
+      weights[j < 0 ? 0 : (j >= taps ? taps - 1 : j)] = 1.0;
+      sum = 1.0;
+    }
+    for (j = 0; j < taps; ++j) {
+      const int c = (int)floor(weights[j] / sum * 16384.0 + 0.5);
+      coeffs[j] = (int16_t)c;
+      total += c;
+      if (weights[j] > weights[largest]) {
+        largest = j;
+      }
+    }
+    coeffs[largest] = (int16_t)(coeffs[largest] + 16384 - total);
+    starts[i - begin] = start;
+    coeffs += taps;
+  }
+}
+
+static int ScalePolyphaseBpp(const struct ScalePlan* plan) {
+  return plan->format == kScalePlanARGB ? 4
+         : plan->format == kScalePlanUV ? 2
+                                        : 1;
+}
+
+#define SCALE_POLYPHASE_ALIGN(n) (((n) + 63) & ~63)
+
+// Byte offsets in the row buffer of the vertical tables and the ring.  The
+// horizontal starts are at 0, followed by the horizontal coefficients.
+static int ScalePolyphaseCoeffsX(const struct ScalePlan* plan) {
+  return SCALE_POLYPHASE_ALIGN(plan->dst_width * 4);
+}
+
+static int ScalePolyphaseStartsY(const struct ScalePlan* plan) {
+  return ScalePolyphaseCoeffsX(plan) +
+         SCALE_POLYPHASE_ALIGN(plan->dst_width * plan->taps_x * 2);
+}
+
+static int ScalePolyphaseCoeffsY(const struct ScalePlan* plan) {
+  return ScalePolyphaseStartsY(plan) +
+         SCALE_POLYPHASE_ALIGN(plan->dst_height * 4);
+}
+
+static int ScalePolyphaseRing(const struct ScalePlan* plan) {
+  return ScalePolyphaseCoeffsY(plan) +
+         SCALE_POLYPHASE_ALIGN(plan->dst_height * plan->taps_y * 2);
+}
+
+void ScalePolyphaseInit(struct ScalePlan* plan,
+                        int dst_width,
+                        int dst_height) {
+  const int is_16 = plan->format == kScalePlanPlane_16;
+  const int bpp = ScalePolyphaseBpp(plan);
+  int taps_x =
+      ScalePolyphaseTaps(plan->filtering, plan->src_width, dst_width);
+  int taps_y =
+      ScalePolyphaseTaps(plan->filtering, plan->src_height, dst_height);
+  plan->method = kScaleMethodPolyphase;
+  plan->filter_dst_width = dst_width;
+  plan->filter_dst_height = dst_height;
+  plan->polyphase_tables = NULL;
+  plan->PolyphaseCols = bpp == 4   ? ScaleARGBPolyphaseCols_C
+                        : bpp == 2 ? ScaleUVPolyphaseCols_C
+                                   : ScalePolyphaseCols_C;
+  plan->PolyphaseCols_16 = ScalePolyphaseCols_16_C;
+  plan->PolyphaseRows = ScalePolyphaseRows_C;
+  plan->PolyphaseRows_16 = ScalePolyphaseRows_16_C;
+  // The AVX2 row functions filter 8 taps horizontally and 2 taps vertically
+  // at a time.  Padding with 0 coefficients gives the same result as C.
+#if defined(HAS_SCALEPOLYPHASECOLS_AVX2)
+  if (!is_16 && bpp == 1 && taps_x > 1 && TestCpuFlag(kCpuHasAVX2) &&
+      ((taps_x + 7) & ~7) <= plan->src_width) {
+    taps_x = (taps_x + 7) & ~7;
+    plan->PolyphaseCols = ScalePolyphaseCols_Any_AVX2;
+    if (IS_ALIGNED(plan->dst_width, 8)) {
+      plan->PolyphaseCols = ScalePolyphaseCols_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_SCALEPOLYPHASEROWS_AVX2)
+  if (!is_16 && TestCpuFlag(kCpuHasAVX2) &&
+      ((taps_y + 1) & ~1) <= plan->src_height) {
+    taps_y = (taps_y + 1) & ~1;
+    plan->PolyphaseRows = ScalePolyphaseRows_Any_AVX2;
+    if (IS_ALIGNED(plan->dst_width * bpp, 16)) {
+      plan->PolyphaseRows = ScalePolyphaseRows_AVX2;
+    }
+  }
+#endif
+  (void)is_16;
+  plan->taps_x = taps_x;
+  plan->taps_y = taps_y;
+  // Coefficient tables, then a ring of taps_y filtered rows.
+  plan->row_size = ScalePolyphaseRing(plan) +
+                   taps_y * SCALE_POLYPHASE_ALIGN(plan->dst_width * bpp * 2);
+}
+
+// Build the horizontal table and the vertical table of destination rows
+// [dst_y_begin, dst_y_end) into row.
+static void ScalePolyphaseBuild(const struct ScalePlan* plan,
+                                uint8_t* row,
+                                int dst_y_begin,
+                                int dst_y_end) {
+  const int dst_width = plan->dst_width;
+  const int taps_x = plan->taps_x;
+  const int taps_y = plan->taps_y;
+  int32_t* starts_x = (int32_t*)row;
+  int16_t* coeffs_x = (int16_t*)(row + ScalePolyphaseCoeffsX(plan));
+  int32_t* starts_y = (int32_t*)(row + ScalePolyphaseStartsY(plan));
+  int16_t* coeffs_y = (int16_t*)(row + ScalePolyphaseCoeffsY(plan));
+  ScalePolyphaseTable(plan->filtering, plan->src_width, plan->filter_dst_width,
+                      taps_x, plan->dst_offset_x,
+                      plan->dst_offset_x + dst_width, starts_x, coeffs_x);
+  if (plan->mirror) {
+    // Filter the mirrored source by reflecting the taps of each column.
+    int i, j;
+    for (i = 0; i < dst_width; ++i) {
+      int16_t* c = coeffs_x + i * taps_x;
+      starts_x[i] = plan->src_width - taps_x - starts_x[i];
+      for (j = 0; j < taps_x / 2; ++j) {
+        int16_t t = c[j];
+        c[j] = c[taps_x - 1 - j];
+        c[taps_x - 1 - j] = t;
+      }
+    }
+  }
+  ScalePolyphaseTable(plan->filtering, plan->src_height,
+                      plan->filter_dst_height, taps_y,
+                      plan->dst_offset_y + dst_y_begin,
+                      plan->dst_offset_y + dst_y_end, starts_y + dst_y_begin,
+                      coeffs_y + dst_y_begin * taps_y);
+}
+
+void ScalePolyphaseTables(struct ScalePlan* plan, uint8_t* row) {
+  ScalePolyphaseBuild(plan, row, 0, plan->dst_height);
+  plan->polyphase_tables = row;
+}
+
+void ScalePolyphase(const struct ScalePlan* plan,
+                    const uint8_t* src,
+                    ptrdiff_t src_stride,
+                    uint8_t* dst,
+                    ptrdiff_t dst_stride,
+                    int dst_y_begin,
+                    int dst_y_end,
+                    uint8_t* row) {
+  const int is_16 = plan->format == kScalePlanPlane_16;
+  const int bpp = ScalePolyphaseBpp(plan);
+  const int dst_width = plan->dst_width;
+  const int taps_x = plan->taps_x;
+  const int taps_y = plan->taps_y;
+  const int ring_stride = SCALE_POLYPHASE_ALIGN(dst_width * bpp * 2) / 2;
+  const uint8_t* tables = plan->polyphase_tables;
+  const int32_t* starts_x;
+  const int16_t* coeffs_x;
+  const int32_t* starts_y;
+  const int16_t* coeffs_y;
+  uint16_t* ring = (uint16_t*)(row + ScalePolyphaseRing(plan));
+  const uint16_t* rows[SCALE_POLYPHASE_MAX_TAPS];
+  int ring_end = -1;  // Source rows before ring_end are in the ring.
+  int y, j;
+  if (!tables) {
+    ScalePolyphaseBuild(plan, row, dst_y_begin, dst_y_end);
+    tables = row;
+  }
+  starts_x = (const int32_t*)tables;
+  coeffs_x = (const int16_t*)(tables + ScalePolyphaseCoeffsX(plan));
+  starts_y = (const int32_t*)(tables + ScalePolyphaseStartsY(plan));
+  coeffs_y = (const int16_t*)(tables + ScalePolyphaseCoeffsY(plan));
+  for (y = dst_y_begin; y < dst_y_end; ++y) {
+    const int start_y = starts_y[y];
+    // Rows advance monotonically, so rows from start_y to ring_end are still
+    // in the ring.
+    if (start_y > ring_end) {
+      ring_end = start_y;
+    }
+    for (; ring_end < start_y + taps_y; ++ring_end) {
+      const uint8_t* src_row = src + ring_end * src_stride;
+      uint16_t* ring_row = ring + (ring_end % taps_y) * ring_stride;
+      if (is_16) {
+        plan->PolyphaseCols_16((const uint16_t*)src_row, ring_row, dst_width,
+                               starts_x, coeffs_x, taps_x);
+      } else {
+        plan->PolyphaseCols(src_row, ring_row, dst_width, starts_x, coeffs_x,
+                            taps_x);
+      }
+    }
+    for (j = 0; j < taps_y; ++j) {
+      rows[j] = ring + ((start_y + j) % taps_y) * ring_stride;
+    }
+    if (is_16) {
+      plan->PolyphaseRows_16(rows, coeffs_y + y * taps_y, taps_y,
+                             (uint16_t*)dst, dst_width);
+    } else {
+      plan->PolyphaseRows(rows, coeffs_y + y * taps_y, taps_y, dst,
+                          dst_width * bpp);
+    }
+    dst += dst_stride;
+  }
+}
+#undef SCALE_POLYPHASE_ALIGN
+
+void ScalePolyphaseRowRange(const struct ScalePlan* plan,
+                            int dst_y_begin,
+                            int dst_y_end,
+                            int* src_y_begin,
+                            int* src_y_end) {
+  int16_t coeffs[SCALE_POLYPHASE_MAX_TAPS];
+  int32_t start;
+  const int y = plan->dst_offset_y;
+  ScalePolyphaseTable(plan->filtering, plan->src_height,
+                      plan->filter_dst_height, plan->taps_y, y + dst_y_begin,
+                      y + dst_y_begin + 1, &start, coeffs);
+  *src_y_begin = start;
+  ScalePolyphaseTable(plan->filtering, plan->src_height,
+                      plan->filter_dst_height, plan->taps_y, y + dst_y_end - 1,
+                      y + dst_y_end, &start, coeffs);
+  *src_y_end = start + plan->taps_y;
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
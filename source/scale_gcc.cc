@@ -2933,6 +2933,151 @@ void ScaleUVRowUp2_Bilinear_16_AVX2(const uint16_t* src_ptr,
 }
 #endif
 
+#ifdef HAS_SCALEPOLYPHASECOLS_AVX2
+static const int32_t kPolyphaseColsRound = 128;
+static const uint16_t kPolyphaseColsMax = 255 << 6;
+
+// Filter pixel N in the low lane and pixel N + 4 in the high lane into ACC.
+#define POLYPHASECOLS_PAIR(N, ACC)                                            \
+  "movslq      " #N "*4(%2),%4                \n"                             \
+  "movslq      4*4+" #N "*4(%2),%5            \n"                             \
+  "add         %8,%4                         \n"                              \
+  "add         %8,%5                         \n"                              \
+  "lea         (%3,%9,8),%6                  \n"                              \
+  "xor         %7,%7                         \n"                              \
+  "vpxor       " ACC "," ACC "," ACC "        \n"                             \
+  "1:          \n"                                                            \
+  "vpmovzxbw   (%4,%7,1),%%xmm0              \n"                              \
+  "vpmovzxbw   (%5,%7,1),%%xmm1              \n"                              \
+  "vinserti128 $1,%%xmm1,%%ymm0,%%ymm0       \n"                              \
+  "vmovdqu     (%3,%7,2),%%xmm1              \n"                              \
+  "vinserti128 $1,(%6,%7,2),%%ymm1,%%ymm1    \n"                              \
+  "vpmaddwd    %%ymm1,%%ymm0,%%ymm0          \n"                              \
+  "vpaddd      %%ymm0," ACC "," ACC "         \n"                             \
+  "add         $0x8,%7                       \n"                              \
+  "cmp         %9,%7                         \n"                              \
+  "jl          1b                            \n"                              \
+  "lea         (%3,%9,2),%3                  \n"
+
+// Filter 8 pixels per loop, 8 taps at a time.  taps is a multiple of 8.
+void ScalePolyphaseCols_AVX2(const uint8_t* src_ptr,
+                             uint16_t* dst_ptr,
+                             int dst_width,
+                             const int32_t* starts,
+                             const int16_t* coeffs,
+                             int taps) {
+  intptr_t src0;
+  intptr_t src4;
+  intptr_t coeffs4;
+  intptr_t tap;
+  asm volatile(
+      "vpbroadcastd %10,%%ymm2                   \n"
+      "vpbroadcastw %11,%%ymm3                   \n"
+
+      LABELALIGN
+      "2:          \n"
+      POLYPHASECOLS_PAIR(0, "%%ymm4")
+      POLYPHASECOLS_PAIR(1, "%%ymm5")
+      POLYPHASECOLS_PAIR(2, "%%ymm6")
+      POLYPHASECOLS_PAIR(3, "%%ymm7")
+      "lea         (%3,%9,8),%3                  \n"  // skip pixels 4 to 7
+      "vphaddd     %%ymm5,%%ymm4,%%ymm4          \n"
+      "vphaddd     %%ymm7,%%ymm6,%%ymm6          \n"
+      "vphaddd     %%ymm6,%%ymm4,%%ymm4          \n"  // 0123 4567
+      "vpaddd      %%ymm2,%%ymm4,%%ymm4          \n"
+      "vpsrad      $0x8,%%ymm4,%%ymm4            \n"
+      "vpackusdw   %%ymm4,%%ymm4,%%ymm4          \n"
+      "vpminuw     %%ymm3,%%ymm4,%%ymm4          \n"
+      "vpermq      $0x08,%%ymm4,%%ymm4           \n"
+      "vmovdqu     %%xmm4,(%0)                   \n"
+      "lea         0x20(%2),%2                   \n"
+      "lea         0x10(%0),%0                   \n"
+      "sub         $0x8,%1                       \n"
+      "jg          2b                            \n"
+      "vzeroupper  \n"
+      : "+r"(dst_ptr),    // %0
+        "+r"(dst_width),  // %1
+        "+r"(starts),     // %2
+        "+r"(coeffs),     // %3
+        "=&r"(src0),      // %4
+        "=&r"(src4),      // %5
+        "=&r"(coeffs4),   // %6
+        "=&r"(tap)        // %7
+      : "r"(src_ptr),               // %8
+        "r"((intptr_t)(taps)),      // %9
+        "m"(kPolyphaseColsRound),   // %10
+        "m"(kPolyphaseColsMax)      // %11
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+        "xmm6", "xmm7");
+}
+#undef POLYPHASECOLS_PAIR
+#endif  // HAS_SCALEPOLYPHASECOLS_AVX2
+
+#ifdef HAS_SCALEPOLYPHASEROWS_AVX2
+static const int32_t kPolyphaseRowsRound = 1 << 19;
+
+// Filter 16 pixels per loop, 2 rows at a time.  taps is even.
+void ScalePolyphaseRows_AVX2(const uint16_t* const* src_rows,
+                             const int16_t* coeffs,
+                             int taps,
+                             uint8_t* dst_ptr,
+                             int width) {
+  intptr_t x;
+  intptr_t tap;
+  intptr_t row0;
+  intptr_t row1;
+  asm volatile(
+      "vpbroadcastd %9,%%ymm5                    \n"
+      "xor         %2,%2                         \n"
+
+      LABELALIGN
+      "2:          \n"
+      "vpxor       %%ymm2,%%ymm2,%%ymm2          \n"
+      "vpxor       %%ymm3,%%ymm3,%%ymm3          \n"
+      "xor         %3,%3                         \n"
+      "1:          \n"
+      "mov         (%6,%3,8),%4                  \n"
+      "mov         0x8(%6,%3,8),%5               \n"
+      "vmovdqu     (%4,%2,1),%%ymm0              \n"
+      "vmovdqu     (%5,%2,1),%%ymm1              \n"
+      "vpbroadcastd (%7,%3,2),%%ymm4             \n"
+      "vpunpckhwd  %%ymm1,%%ymm0,%%ymm6          \n"
+      "vpunpcklwd  %%ymm1,%%ymm0,%%ymm0          \n"
+      "vpmaddwd    %%ymm4,%%ymm0,%%ymm0          \n"
+      "vpmaddwd    %%ymm4,%%ymm6,%%ymm6          \n"
+      "vpaddd      %%ymm0,%%ymm2,%%ymm2          \n"
+      "vpaddd      %%ymm6,%%ymm3,%%ymm3          \n"
+      "add         $0x2,%3                       \n"
+      "cmp         %8,%3                         \n"
+      "jl          1b                            \n"
+      "vpaddd      %%ymm5,%%ymm2,%%ymm2          \n"
+      "vpaddd      %%ymm5,%%ymm3,%%ymm3          \n"
+      "vpsrad      $20,%%ymm2,%%ymm2             \n"
+      "vpsrad      $20,%%ymm3,%%ymm3             \n"
+      "vpackssdw   %%ymm3,%%ymm2,%%ymm2          \n"
+      "vpackuswb   %%ymm2,%%ymm2,%%ymm2          \n"
+      "vpermq      $0x08,%%ymm2,%%ymm2           \n"
+      "vmovdqu     %%xmm2,(%0)                   \n"
+      "lea         0x10(%0),%0                   \n"
+      "add         $0x20,%2                      \n"
+      "sub         $0x10,%1                      \n"
+      "jg          2b                            \n"
+      "vzeroupper  \n"
+      : "+r"(dst_ptr),  // %0
+        "+r"(width),    // %1
+        "=&r"(x),       // %2
+        "=&r"(tap),     // %3
+        "=&r"(row0),    // %4
+        "=&r"(row1)     // %5
+      : "r"(src_rows),              // %6
+        "r"(coeffs),                // %7
+        "r"((intptr_t)(taps)),      // %8
+        "m"(kPolyphaseRowsRound)    // %9
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+        "xmm6");
+}
+#endif  // HAS_SCALEPOLYPHASEROWS_AVX2
+
 #endif  // defined(__x86_64__) || defined(__i386__)
 
 #ifdef __cplusplus
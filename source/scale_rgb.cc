@@ -21,63 +21,148 @@
 #include "libyuv/row.h"
 #include "libyuv/scale_argb.h"
 #include "libyuv/scale_rgb.h"
+#include "libyuv/scale_row.h"
 
 #ifdef __cplusplus
 namespace libyuv {
 extern "C" {
 #endif
 
+// Set up the ARGB plan for a 24 bit scale and return the bytes of band and
+// row buffer it needs, or 0 if the sizes are not supported.
+static uint64_t RGBScaleInit(struct ScalePlan* plan,
+                             int src_width,
+                             int src_height,
+                             int dst_width,
+                             int dst_height,
+                             enum FilterMode filtering) {
+  if (src_width <= 0 || src_width > INT_MAX / 4 || src_height == 0 ||
+      src_height == INT_MIN || dst_width <= 0 || dst_width > INT_MAX / 4 ||
+      dst_height <= 0) {
+    return 0;
+  }
+  const int abs_src_height = (src_height < 0) ? -src_height : src_height;
+  if (ScalePlanInitARGB(plan, src_width, abs_src_height, dst_width, dst_height,
+                        0, 0, dst_width, dst_height, filtering)) {
+    return 0;
+  }
+  int max_src_rows;
+  const int band_rows = ScalePlanBandRowsARGB(plan, &max_src_rows);
+  const uint64_t src_band_size =
+      (uint64_t)max_src_rows * ((src_width * 4 + 63) & ~63);
+  const uint64_t dst_band_size =
+      (uint64_t)band_rows * ((dst_width * 4 + 63) & ~63);
+  return src_band_size + dst_band_size + ((plan->row_size + 63) & ~63);
+}
+
+LIBYUV_API
+int RGBScaleScratchSize(int src_width,
+                        int src_height,
+                        int dst_width,
+                        int dst_height,
+                        enum FilterMode filtering) {
+  struct ScalePlan plan;
+  const uint64_t argb_size = RGBScaleInit(&plan, src_width, src_height,
+                                          dst_width, dst_height, filtering);
+  if (argb_size == 0 || argb_size > INT_MAX - 63) {
+    return -1;
+  }
+  return (int)argb_size + 63;
+}
+
 // Scale a 24 bit image.
-// Converts to ARGB as intermediate step
+// Converts a band of rows at a time to ARGB as intermediate step, scales
+// them, and converts the destination band back to 24 bit.
 
 LIBYUV_API
-int RGBScale(const uint8_t* src_rgb,
-             int src_stride_rgb,
-             int src_width,
-             int src_height,
-             uint8_t* dst_rgb,
-             int dst_stride_rgb,
-             int dst_width,
-             int dst_height,
-             enum FilterMode filtering) {
-  int r;
-  if (!src_rgb || !dst_rgb || src_width <= 0 || src_width > INT_MAX / 4 ||
-      src_height == 0 || src_height == INT_MIN || dst_width <= 0 ||
-      dst_width > INT_MAX / 4 || dst_height <= 0) {
+int RGBScaleScratch(const uint8_t* src_rgb,
+                    int src_stride_rgb,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst_rgb,
+                    int dst_stride_rgb,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering,
+                    uint8_t* scratch,
+                    int scratch_size) {
+  struct ScalePlan plan;
+  int r = 0;
+  if (!src_rgb || !dst_rgb) {
     return -1;
   }
-  const int abs_src_height = (src_height < 0) ? -src_height : src_height;
-  const uint64_t src_argb_size = (uint64_t)src_width * abs_src_height * 4;
-  const uint64_t dst_argb_size = (uint64_t)dst_width * dst_height * 4;
-  if (src_argb_size > (UINT64_MAX - dst_argb_size)) {
-    return -1;  // Invalid size.
+  const uint64_t argb_size = RGBScaleInit(&plan, src_width, src_height,
+                                          dst_width, dst_height, filtering);
+  if (argb_size == 0) {
+    return -1;
   }
-  const uint64_t argb_size = src_argb_size + dst_argb_size;
 #if UINT64_MAX > SIZE_MAX
   if (argb_size > SIZE_MAX) {
     return -1;  // Invalid size.
   }
 #endif
-  uint8_t* src_argb = (uint8_t*)malloc((size_t)argb_size);
+  if (scratch && (uint64_t)scratch_size < argb_size + 63) {
+    return -1;  // Scratch too small.
+  }
+  const int abs_src_height = (src_height < 0) ? -src_height : src_height;
+  int max_src_rows;
+  const int band_rows = ScalePlanBandRowsARGB(&plan, &max_src_rows);
+  const int src_band_stride = (src_width * 4 + 63) & ~63;
+  const int dst_band_stride = (dst_width * 4 + 63) & ~63;
+  const uint64_t src_band_size = (uint64_t)max_src_rows * src_band_stride;
+  const uint64_t dst_band_size = (uint64_t)band_rows * dst_band_stride;
+  align_buffer_64_scratch(src_argb, (size_t)argb_size, scratch);
   if (!src_argb) {
     return 1;  // Out of memory runtime error.
   }
-  uint8_t* dst_argb = src_argb + (size_t)src_argb_size;
+  uint8_t* dst_argb = src_argb + src_band_size;
+  uint8_t* row = plan.row_size ? dst_argb + dst_band_size : NULL;
 
-  r = RGB24ToARGB(src_rgb, src_stride_rgb, src_argb, src_width * 4, src_width,
-                  src_height);
-  if (!r) {
-    r = ARGBScale(src_argb, src_width * 4, src_width, abs_src_height, dst_argb,
-                  dst_width * 4, dst_width, dst_height, filtering);
+  int y;
+  for (y = 0; y < dst_height && r == 0; y += band_rows) {
+    const int y_end = y + band_rows < dst_height ? y + band_rows : dst_height;
+    int src_y_begin;
+    int src_y_end;
+    ScalePlanRowRangeARGB(&plan, y, y_end, &src_y_begin, &src_y_end);
+    if (src_height < 0) {
+      r = RGB24ToARGB(
+          src_rgb + (ptrdiff_t)(abs_src_height - src_y_end) * src_stride_rgb,
+          src_stride_rgb, src_argb, src_band_stride, src_width,
+          src_y_begin - src_y_end);
+    } else {
+      r = RGB24ToARGB(src_rgb + (ptrdiff_t)src_y_begin * src_stride_rgb,
+                      src_stride_rgb, src_argb, src_band_stride, src_width,
+                      src_y_end - src_y_begin);
+    }
     if (!r) {
-      r = ARGBToRGB24(dst_argb, dst_width * 4, dst_rgb, dst_stride_rgb,
-                      dst_width, dst_height);
+      r = ScalePlanRunBandARGB(&plan, y, y_end, src_argb, src_band_stride, 0,
+                               src_y_begin, dst_argb, dst_band_stride, row);
+    }
+    if (!r) {
+      r = ARGBToRGB24(dst_argb, dst_band_stride,
+                      dst_rgb + (ptrdiff_t)y * dst_stride_rgb, dst_stride_rgb,
+                      dst_width, y_end - y);
     }
   }
-  free(src_argb);
+  free_aligned_buffer_64(src_argb);
   return r;
 }
 
+LIBYUV_API
+int RGBScale(const uint8_t* src_rgb,
+             int src_stride_rgb,
+             int src_width,
+             int src_height,
+             uint8_t* dst_rgb,
+             int dst_stride_rgb,
+             int dst_width,
+             int dst_height,
+             enum FilterMode filtering) {
+  return RGBScaleScratch(src_rgb, src_stride_rgb, src_width, src_height,
+                         dst_rgb, dst_stride_rgb, dst_width, dst_height,
+                         filtering, NULL, 0);
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
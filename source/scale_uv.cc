@@ -17,6 +17,7 @@
 #include "libyuv/cpu_id.h"
 #include "libyuv/planar_functions.h"  // For CopyUV
 #include "libyuv/row.h"
+#include "libyuv/row_dispatch.h"
 #include "libyuv/scale_row.h"
 
 #ifdef __cplusplus
@@ -71,12 +72,11 @@ static void ScaleUVDown2(int src_width,
                          enum FilterMode filtering) {
   int j;
   ptrdiff_t row_stride = src_stride * (dy >> 16);
-  void (*ScaleUVRowDown2)(const uint8_t* src_uv, ptrdiff_t src_stride,
-                          uint8_t* dst_uv, int dst_width) =
-      filtering == kFilterNone
-          ? ScaleUVRowDown2_C
-          : (filtering == kFilterLinear ? ScaleUVRowDown2Linear_C
-                                        : ScaleUVRowDown2Box_C);
+  const int kernel = filtering == kFilterNone     ? SCALEROWDOWN2_NONE
+                     : filtering == kFilterLinear ? SCALEROWDOWN2_LINEAR
+                                                  : SCALEROWDOWN2_BOX;
+  ScaleRowDown2Function ScaleUVRowDown2 =
+      ROW_KERNEL(GetRowDispatch()->ScaleUVRowDown2[kernel], dst_width);
   (void)src_width;
   (void)src_height;
   (void)dx;
@@ -89,73 +89,6 @@ static void ScaleUVDown2(int src_width,
     src_uv += (y >> 16) * src_stride + ((x >> 16) - 1) * 2;
   }
 
-#if defined(HAS_SCALEUVROWDOWN2BOX_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3) && filtering) {
-    ScaleUVRowDown2 = ScaleUVRowDown2Box_Any_SSSE3;
-    if (IS_ALIGNED(dst_width, 4)) {
-      ScaleUVRowDown2 = ScaleUVRowDown2Box_SSSE3;
-    }
-  }
-#endif
-#if defined(HAS_SCALEUVROWDOWN2BOX_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2) && filtering) {
-    ScaleUVRowDown2 = ScaleUVRowDown2Box_Any_AVX2;
-    if (IS_ALIGNED(dst_width, 8)) {
-      ScaleUVRowDown2 = ScaleUVRowDown2Box_AVX2;
-    }
-  }
-#endif
-#if defined(HAS_SCALEUVROWDOWN2_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    ScaleUVRowDown2 =
-        filtering == kFilterNone
-            ? ScaleUVRowDown2_Any_NEON
-            : (filtering == kFilterLinear ? ScaleUVRowDown2Linear_Any_NEON
-                                          : ScaleUVRowDown2Box_Any_NEON);
-    if (IS_ALIGNED(dst_width, 8)) {
-      ScaleUVRowDown2 =
-          filtering == kFilterNone
-              ? ScaleUVRowDown2_NEON
-              : (filtering == kFilterLinear ? ScaleUVRowDown2Linear_NEON
-                                            : ScaleUVRowDown2Box_NEON);
-    }
-  }
-#endif
-#if defined(HAS_SCALEUVROWDOWN2_SME)
-  if (TestCpuFlag(kCpuHasSME)) {
-    ScaleUVRowDown2 = filtering == kFilterNone     ? ScaleUVRowDown2_SME
-                      : filtering == kFilterLinear ? ScaleUVRowDown2Linear_SME
-                                                   : ScaleUVRowDown2Box_SME;
-  }
-#endif
-#if defined(HAS_SCALEUVROWDOWN2_RVV)
-  if (TestCpuFlag(kCpuHasRVV)) {
-    ScaleUVRowDown2 =
-        filtering == kFilterNone
-            ? ScaleUVRowDown2_RVV
-            : (filtering == kFilterLinear ? ScaleUVRowDown2Linear_RVV
-                                          : ScaleUVRowDown2Box_RVV);
-  }
-#endif
-
-// This code is not enabled.  Only box filter is available at this time.
-#if defined(HAS_SCALEUVROWDOWN2_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3)) {
-    ScaleUVRowDown2 =
-        filtering == kFilterNone
-            ? ScaleUVRowDown2_Any_SSSE3
-            : (filtering == kFilterLinear ? ScaleUVRowDown2Linear_Any_SSSE3
-                                          : ScaleUVRowDown2Box_Any_SSSE3);
-    if (IS_ALIGNED(dst_width, 2)) {
-      ScaleUVRowDown2 =
-          filtering == kFilterNone
-              ? ScaleUVRowDown2_SSSE3
-              : (filtering == kFilterLinear ? ScaleUVRowDown2Linear_SSSE3
-                                            : ScaleUVRowDown2Box_SSSE3);
-    }
-  }
-#endif
-
   if (filtering == kFilterLinear) {
     src_stride = 0;
   }
@@ -169,30 +102,26 @@ static void ScaleUVDown2(int src_width,
 
 // ScaleUV, 1/4
 // This is an optimized version for scaling down a UV to 1/4 of
-// its original size.
+// its original size.  row holds 2 rows of UV, plan->row_size bytes.
 #if HAS_SCALEUVDOWN4BOX
-static int ScaleUVDown4Box(int src_width,
-                           int src_height,
-                           int dst_width,
-                           int dst_height,
-                           ptrdiff_t src_stride,
-                           ptrdiff_t dst_stride,
-                           const uint8_t* src_uv,
-                           uint8_t* dst_uv,
-                           int x,
-                           int dx,
-                           int y,
-                           int dy) {
+static void ScaleUVDown4Box(int src_width,
+                            int src_height,
+                            int dst_width,
+                            int dst_height,
+                            ptrdiff_t src_stride,
+                            ptrdiff_t dst_stride,
+                            const uint8_t* src_uv,
+                            uint8_t* dst_uv,
+                            int x,
+                            int dx,
+                            int y,
+                            int dy,
+                            uint8_t* row) {
   int j;
-  // Allocate 2 rows of UV.
   const int row_size = (dst_width * 2 * 2 + 15) & ~15;
-  align_buffer_64(row, row_size * 2);
-  if (!row)
-    return 1;
   ptrdiff_t row_stride = src_stride * (dy >> 16);
-  void (*ScaleUVRowDown2)(const uint8_t* src_uv, ptrdiff_t src_stride,
-                          uint8_t* dst_uv, int dst_width) =
-      ScaleUVRowDown2Box_C;
+  ScaleRowDown2Function ScaleUVRowDown2 = ROW_KERNEL(
+      GetRowDispatch()->ScaleUVRowDown2[SCALEROWDOWN2_BOX], dst_width);
   // Advance to odd row, even column.
   src_uv += (y >> 16) * src_stride + (x >> 16) * 2;
   (void)src_width;
@@ -201,41 +130,6 @@ static int ScaleUVDown4Box(int src_width,
   assert(dx == 65536 * 4);      // Test scale factor of 4.
   assert((dy & 0x3ffff) == 0);  // Test vertical scale is multiple of 4.
 
-#if defined(HAS_SCALEUVROWDOWN2BOX_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3)) {
-    ScaleUVRowDown2 = ScaleUVRowDown2Box_Any_SSSE3;
-    if (IS_ALIGNED(dst_width, 4)) {
-      ScaleUVRowDown2 = ScaleUVRowDown2Box_SSSE3;
-    }
-  }
-#endif
-#if defined(HAS_SCALEUVROWDOWN2BOX_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    ScaleUVRowDown2 = ScaleUVRowDown2Box_Any_AVX2;
-    if (IS_ALIGNED(dst_width, 8)) {
-      ScaleUVRowDown2 = ScaleUVRowDown2Box_AVX2;
-    }
-  }
-#endif
-#if defined(HAS_SCALEUVROWDOWN2BOX_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    ScaleUVRowDown2 = ScaleUVRowDown2Box_Any_NEON;
-    if (IS_ALIGNED(dst_width, 8)) {
-      ScaleUVRowDown2 = ScaleUVRowDown2Box_NEON;
-    }
-  }
-#endif
-#if defined(HAS_SCALEUVROWDOWN2BOX_SME)
-  if (TestCpuFlag(kCpuHasSME)) {
-    ScaleUVRowDown2 = ScaleUVRowDown2Box_SME;
-  }
-#endif
-#if defined(HAS_SCALEUVROWDOWN2BOX_RVV)
-  if (TestCpuFlag(kCpuHasRVV)) {
-    ScaleUVRowDown2 = ScaleUVRowDown2Box_RVV;
-  }
-#endif
-
   for (j = 0; j < dst_height; ++j) {
     ScaleUVRowDown2(src_uv, src_stride, row, dst_width * 2);
     ScaleUVRowDown2(src_uv + src_stride * 2, src_stride, row + row_size,
@@ -244,8 +138,6 @@ static int ScaleUVDown4Box(int src_width,
     src_uv += row_stride;
     dst_uv += dst_stride;
   }
-  free_aligned_buffer_64(row);
-  return 0;
 }
 #endif  // HAS_SCALEUVDOWN4BOX
 
@@ -329,31 +221,18 @@ static void ScaleUVDownEven(int src_width,
 }
 #endif
 
-// Scale UV down with bilinear interpolation.
 #if HAS_SCALEUVBILINEARDOWN
-static int ScaleUVBilinearDown(int src_width,
-                               int src_height,
-                               int dst_width,
-                               int dst_height,
-                               ptrdiff_t src_stride,
-                               ptrdiff_t dst_stride,
-                               const uint8_t* src_uv,
-                               uint8_t* dst_uv,
-                               int x,
-                               int dx,
-                               int y,
-                               int dy,
-                               enum FilterMode filtering) {
-  int j;
-  void (*InterpolateRow)(uint8_t* dst_uv, const uint8_t* src_uv,
-                         ptrdiff_t src_stride, int dst_width,
-                         int source_y_fraction) = InterpolateRow_C;
-  void (*ScaleUVFilterCols)(uint8_t* dst_uv, const uint8_t* src_uv,
-                            int dst_width, int x, int dx) =
+// Select the row functions for ScaleUVBilinearDown and clip the source
+// to the columns it reads.
+static void ScaleUVBilinearDownInit(struct ScalePlan* plan) {
+  const int src_width = plan->src_width;
+  const int dst_width = plan->dst_width;
+  const int dx = plan->dx;
+  plan->ScaleCols =
       (src_width >= 32768) ? ScaleUVFilterCols64_C : ScaleUVFilterCols_C;
-  int64_t xlast = x + (int64_t)(dst_width - 1) * dx;
-  int64_t xl = (dx >= 0) ? x : xlast;
-  int64_t xr = (dx >= 0) ? xlast : x;
+  int64_t xlast = plan->x + (int64_t)(dst_width - 1) * dx;
+  int64_t xl = (dx >= 0) ? plan->x : xlast;
+  int64_t xr = (dx >= 0) ? xlast : plan->x;
   int clip_src_width;
   xl = (xl >> 16) & ~3;    // Left edge aligned.
   xr = (xr >> 16) + 1;     // Right most pixel used.  Bilinear uses 2 pixels.
@@ -362,260 +241,185 @@ static int ScaleUVBilinearDown(int src_width,
     xr = src_width;
   }
   clip_src_width = (int)(xr - xl) * 2;  // Width aligned to 2.
-  src_uv += xl * 2;
-  x -= (int)(xl << 16);
-#if defined(HAS_INTERPOLATEROW_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    InterpolateRow = InterpolateRow_Any_AVX2;
-    if (IS_ALIGNED(clip_src_width, 32)) {
-      InterpolateRow = InterpolateRow_AVX2;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    InterpolateRow = InterpolateRow_Any_NEON;
-    if (IS_ALIGNED(clip_src_width, 16)) {
-      InterpolateRow = InterpolateRow_NEON;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_SVE2)
-  if (TestCpuFlag(kCpuHasSVE2)) {
-    InterpolateRow = InterpolateRow_SVE2;
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_SME)
-  if (TestCpuFlag(kCpuHasSME)) {
-    InterpolateRow = InterpolateRow_SME;
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_LSX)
-  if (TestCpuFlag(kCpuHasLSX)) {
-    InterpolateRow = InterpolateRow_Any_LSX;
-    if (IS_ALIGNED(clip_src_width, 32)) {
-      InterpolateRow = InterpolateRow_LSX;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_RVV)
-  if (TestCpuFlag(kCpuHasRVV)) {
-    InterpolateRow = InterpolateRow_RVV;
-  }
-#endif
+  plan->src_offset_x += (int)xl;
+  plan->x -= (int)(xl << 16);
+  plan->InterpolateRow =
+      ROW_KERNEL(GetRowDispatch()->InterpolateRow, clip_src_width);
 #if defined(HAS_SCALEUVFILTERCOLS_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
-    ScaleUVFilterCols = ScaleUVFilterCols_SSSE3;
+    plan->ScaleCols = ScaleUVFilterCols_SSSE3;
   }
 #endif
 #if defined(HAS_SCALEUVFILTERCOLS_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
-    ScaleUVFilterCols = ScaleUVFilterCols_Any_NEON;
+    plan->ScaleCols = ScaleUVFilterCols_Any_NEON;
     if (IS_ALIGNED(dst_width, 4)) {
-      ScaleUVFilterCols = ScaleUVFilterCols_NEON;
+      plan->ScaleCols = ScaleUVFilterCols_NEON;
     }
   }
 #endif
+
   // TODO(fbarchard): Consider not allocating row buffer for kFilterLinear.
-  // Allocate a row of UV.
-  {
-    const int max_y = (src_height - 1) << 16;
-    align_buffer_64(row, clip_src_width * 2);
-    if (!row)
-      return 1;
-    if (y > max_y) {
-      y = max_y;
-    }
-    for (j = 0; j < dst_height; ++j) {
-      int yi = y >> 16;
-      const uint8_t* src = src_uv + yi * src_stride;
-      if (filtering == kFilterLinear) {
-        ScaleUVFilterCols(dst_uv, src, dst_width, x, dx);
-      } else {
-        int yf = (y >> 8) & 255;
-        InterpolateRow(row, src, src_stride, clip_src_width, yf);
-        ScaleUVFilterCols(dst_uv, row, dst_width, x, dx);
-      }
-      dst_uv += dst_stride;
-      y += dy;
-      if (y > max_y) {
-        y = max_y;
-      }
-    }
-    free_aligned_buffer_64(row);
-  }
-  return 0;
+  plan->interpolate_width = clip_src_width;
+  plan->row_size = clip_src_width * 2;
 }
-#endif
-
-// Scale UV up with bilinear interpolation.
-#if HAS_SCALEUVBILINEARUP
-static int ScaleUVBilinearUp(int src_width,
-                             int src_height,
-                             int dst_width,
-                             int dst_height,
-                             ptrdiff_t src_stride,
-                             ptrdiff_t dst_stride,
-                             const uint8_t* src_uv,
-                             uint8_t* dst_uv,
-                             int x,
-                             int dx,
-                             int y,
-                             int dy,
-                             enum FilterMode filtering) {
-  assert(src_width > 0);
-  assert(src_height > 0);
-  assert(dst_width > 0);
-  assert(dst_height > 0);
-  assert(dy <= 65536);
 
+// Scale UV down with bilinear interpolation.
+// Scale UV down with bilinear interpolation.
+static void ScaleUVBilinearDown(const struct ScalePlan* plan,
+                                ptrdiff_t src_stride,
+                                ptrdiff_t dst_stride,
+                                const uint8_t* src_uv,
+                                uint8_t* dst_uv,
+                                uint8_t* row) {
   int j;
-  void (*InterpolateRow)(uint8_t* dst_uv, const uint8_t* src_uv,
-                         ptrdiff_t src_stride, int dst_width,
-                         int source_y_fraction) = InterpolateRow_C;
-  void (*ScaleUVFilterCols)(uint8_t* dst_uv, const uint8_t* src_uv,
-                            int dst_width, int x, int dx) =
-      filtering ? ScaleUVFilterCols_C : ScaleUVCols_C;
+  const int src_height = plan->src_height;
+  const int dst_width = plan->dst_width;
+  const int dst_height = plan->dst_height;
+  const int x = plan->x;
+  const int dx = plan->dx;
+  const int dy = plan->dy;
+  int y = plan->y;
   const int max_y = (src_height - 1) << 16;
-#if defined(HAS_INTERPOLATEROW_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    InterpolateRow = InterpolateRow_Any_AVX2;
-    if (IS_ALIGNED(dst_width, 16)) {
-      InterpolateRow = InterpolateRow_AVX2;
-    }
+  if (y > max_y) {
+    y = max_y;
   }
-#endif
-#if defined(HAS_INTERPOLATEROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    InterpolateRow = InterpolateRow_Any_NEON;
-    if (IS_ALIGNED(dst_width, 8)) {
-      InterpolateRow = InterpolateRow_NEON;
+  for (j = 0; j < dst_height; ++j) {
+    int yi = y >> 16;
+    const uint8_t* src = src_uv + yi * src_stride;
+    if (plan->filtering == kFilterLinear) {
+      plan->ScaleCols(dst_uv, src, dst_width, x, dx);
+    } else {
+      int yf = (y >> 8) & 255;
+      plan->InterpolateRow(row, src, src_stride, plan->interpolate_width, yf);
+      plan->ScaleCols(dst_uv, row, dst_width, x, dx);
     }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_SVE2)
-  if (TestCpuFlag(kCpuHasSVE2)) {
-    InterpolateRow = InterpolateRow_SVE2;
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_SME)
-  if (TestCpuFlag(kCpuHasSME)) {
-    InterpolateRow = InterpolateRow_SME;
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_LSX)
-  if (TestCpuFlag(kCpuHasLSX)) {
-    InterpolateRow = InterpolateRow_Any_LSX;
-    if (IS_ALIGNED(dst_width, 16)) {
-      InterpolateRow = InterpolateRow_LSX;
+    dst_uv += dst_stride;
+    y += dy;
+    if (y > max_y) {
+      y = max_y;
     }
   }
+}
 #endif
-#if defined(HAS_INTERPOLATEROW_RVV)
-  if (TestCpuFlag(kCpuHasRVV)) {
-    InterpolateRow = InterpolateRow_RVV;
-  }
-#endif
+
+#if HAS_SCALEUVBILINEARUP
+// Select the row functions for ScaleUVBilinearUp.
+static void ScaleUVBilinearUpInit(struct ScalePlan* plan) {
+  const int src_width = plan->src_width;
+  const int dst_width = plan->dst_width;
+  assert(plan->dy <= 65536);
+  plan->ScaleCols = plan->filtering ? ScaleUVFilterCols_C : ScaleUVCols_C;
+  plan->InterpolateRow =
+      ROW_KERNEL(GetRowDispatch()->InterpolateRow, dst_width * 2);
   if (src_width >= 32768) {
-    ScaleUVFilterCols = filtering ? ScaleUVFilterCols64_C : ScaleUVCols64_C;
+    plan->ScaleCols = plan->filtering ? ScaleUVFilterCols64_C : ScaleUVCols64_C;
   }
 #if defined(HAS_SCALEUVFILTERCOLS_SSSE3)
-  if (filtering && TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
-    ScaleUVFilterCols = ScaleUVFilterCols_SSSE3;
+  if (plan->filtering && TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
+    plan->ScaleCols = ScaleUVFilterCols_SSSE3;
   }
 #endif
 #if defined(HAS_SCALEUVFILTERCOLS_NEON)
-  if (filtering && TestCpuFlag(kCpuHasNEON)) {
-    ScaleUVFilterCols = ScaleUVFilterCols_Any_NEON;
+  if (plan->filtering && TestCpuFlag(kCpuHasNEON)) {
+    plan->ScaleCols = ScaleUVFilterCols_Any_NEON;
     if (IS_ALIGNED(dst_width, 8)) {
-      ScaleUVFilterCols = ScaleUVFilterCols_NEON;
+      plan->ScaleCols = ScaleUVFilterCols_NEON;
     }
   }
 #endif
 #if defined(HAS_SCALEUVCOLS_SSSE3)
-  if (!filtering && TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
-    ScaleUVFilterCols = ScaleUVCols_SSSE3;
+  if (!plan->filtering && TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
+    plan->ScaleCols = ScaleUVCols_SSSE3;
   }
 #endif
 #if defined(HAS_SCALEUVCOLS_NEON)
-  if (!filtering && TestCpuFlag(kCpuHasNEON)) {
-    ScaleUVFilterCols = ScaleUVCols_Any_NEON;
+  if (!plan->filtering && TestCpuFlag(kCpuHasNEON)) {
+    plan->ScaleCols = ScaleUVCols_Any_NEON;
     if (IS_ALIGNED(dst_width, 16)) {
-      ScaleUVFilterCols = ScaleUVCols_NEON;
+      plan->ScaleCols = ScaleUVCols_NEON;
     }
   }
 #endif
-  if (!filtering && src_width * 2 == dst_width && x < 0x8000) {
-    ScaleUVFilterCols = ScaleUVColsUp2_C;
+  if (!plan->filtering && src_width * 2 == dst_width && plan->x < 0x8000) {
+    plan->ScaleCols = ScaleUVColsUp2_C;
 #if defined(HAS_SCALEUVCOLSUP2_SSSE3)
     if (TestCpuFlag(kCpuHasSSSE3) && IS_ALIGNED(dst_width, 8)) {
-      ScaleUVFilterCols = ScaleUVColsUp2_SSSE3;
+      plan->ScaleCols = ScaleUVColsUp2_SSSE3;
     }
 #endif
   }
+  // 2 rows of UV.
+  plan->row_size = ((dst_width * 2 + 15) & ~15) * 2;
+}
 
+// Scale UV up with bilinear interpolation.
+static void ScaleUVBilinearUp(const struct ScalePlan* plan,
+                              ptrdiff_t src_stride,
+                              ptrdiff_t dst_stride,
+                              const uint8_t* src_uv,
+                              uint8_t* dst_uv,
+                              uint8_t* row) {
+  int j;
+  const int src_height = plan->src_height;
+  const int dst_width = plan->dst_width;
+  const int dst_height = plan->dst_height;
+  const int x = plan->x;
+  const int dx = plan->dx;
+  const int dy = plan->dy;
+  int y = plan->y;
+  const int max_y = (src_height - 1) << 16;
   if (y > max_y) {
     y = max_y;
   }
 
-  {
-    int yi = y >> 16;
-    const uint8_t* src = src_uv + yi * src_stride;
-
-    // Allocate 2 rows of UV.
-    const int row_size = (dst_width * 2 + 15) & ~15;
-    align_buffer_64(row, row_size * 2);
-    if (!row)
-      return 1;
+  int yi = y >> 16;
+  const uint8_t* src = src_uv + yi * src_stride;
+  uint8_t* rowptr = row;
+  ptrdiff_t rowstride = plan->row_size / 2;
+  int lasty = yi;
 
-    uint8_t* rowptr = row;
-    ptrdiff_t rowstride = row_size;
-    int lasty = yi;
+  plan->ScaleCols(rowptr, src, dst_width, x, dx);
+  if (src_height > 1) {
+    src += src_stride;
+  }
+  plan->ScaleCols(rowptr + rowstride, src, dst_width, x, dx);
+  if (src_height > 2) {
+    src += src_stride;
+  }
 
-    ScaleUVFilterCols(rowptr, src, dst_width, x, dx);
-    if (src_height > 1) {
-      src += src_stride;
-    }
-    ScaleUVFilterCols(rowptr + rowstride, src, dst_width, x, dx);
-    if (src_height > 2) {
-      src += src_stride;
+  // 2-row rolling buffer:
+  // rowptr and (rowptr + rowstride) hold the scaled rows for yi and yi + 1.
+  // Because dy <= 65536 (dy <= 1.0 in 16.16), yi advances in unit steps.
+  // When yi != lasty:
+  // 1. Scale the next source row into the older buffer (rowptr).
+  // 2. Swap buffer pointers (rowptr += rowstride; rowstride = -rowstride;)
+  //    so rowptr points to yi and (rowptr + rowstride) points to yi + 1.
+  // 3. Advance src by 1 row if row yi + 2 exists ((y + 65536) < max_y),
+  //    otherwise clamp src at (src_height - 1) to avoid reading out of bounds.
+  for (j = 0; j < dst_height; ++j) {
+    if (y > max_y) {
+      y = max_y;
     }
-
-    // 2-row rolling buffer:
-    // rowptr and (rowptr + rowstride) hold the scaled rows for yi and yi + 1.
-    // Because dy <= 65536 (dy <= 1.0 in 16.16), yi advances in unit steps.
-    // When yi != lasty:
-    // 1. Scale the next source row into the older buffer (rowptr).
-    // 2. Swap buffer pointers (rowptr += rowstride; rowstride = -rowstride;)
-    //    so rowptr points to yi and (rowptr + rowstride) points to yi + 1.
-    // 3. Advance src by 1 row if row yi + 2 exists ((y + 65536) < max_y),
-    //    otherwise clamp src at (src_height - 1) to avoid reading out of bounds.
-    for (j = 0; j < dst_height; ++j) {
-      if (y > max_y) {
-        y = max_y;
-      }
-      yi = y >> 16;
-      if (yi != lasty) {
-        ScaleUVFilterCols(rowptr, src, dst_width, x, dx);
-        rowptr += rowstride;
-        rowstride = -rowstride;
-        lasty = yi;
-        if ((y + 65536) < max_y) {
-          src += src_stride;
-        }
-      }
-      if (filtering == kFilterLinear) {
-        InterpolateRow(dst_uv, rowptr, 0, dst_width * 2, 0);
-      } else {
-        int yf = (y >> 8) & 255;
-        InterpolateRow(dst_uv, rowptr, rowstride, dst_width * 2, yf);
+    yi = y >> 16;
+    if (yi != lasty) {
+      plan->ScaleCols(rowptr, src, dst_width, x, dx);
+      rowptr += rowstride;
+      rowstride = -rowstride;
+      lasty = yi;
+      if ((y + 65536) < max_y) {
+        src += src_stride;
       }
-      dst_uv += dst_stride;
-      y += dy;
     }
-    free_aligned_buffer_64(row);
+    if (plan->filtering == kFilterLinear) {
+      plan->InterpolateRow(dst_uv, rowptr, 0, dst_width * 2, 0);
+    } else {
+      int yf = (y >> 8) & 255;
+      plan->InterpolateRow(dst_uv, rowptr, rowstride, dst_width * 2, yf);
+    }
+    dst_uv += dst_stride;
+    y += dy;
   }
-  return 0;
 }
 #endif  // HAS_SCALEUVBILINEARUP
 
@@ -852,47 +656,47 @@ static void ScaleUVBilinearUp2_16(int src_width,
 // of x and dx is the integer part of the source position and
 // the lower 16 bits are the fixed decimal part.
 
-static void ScaleUVSimple(int src_width,
-                          int src_height,
-                          int dst_width,
-                          int dst_height,
-                          ptrdiff_t src_stride,
-                          ptrdiff_t dst_stride,
-                          const uint8_t* src_uv,
-                          uint8_t* dst_uv,
-                          int x,
-                          int dx,
-                          int y,
-                          int dy) {
-  int j;
-  void (*ScaleUVCols)(uint8_t* dst_uv, const uint8_t* src_uv, int dst_width,
-                      int x, int dx) =
-      (src_width >= 32768) ? ScaleUVCols64_C : ScaleUVCols_C;
-  (void)src_height;
+static void ScaleUVSimpleInit(struct ScalePlan* plan) {
+  const int src_width = plan->src_width;
+  const int dst_width = plan->dst_width;
+  plan->ScaleCols = (src_width >= 32768) ? ScaleUVCols64_C : ScaleUVCols_C;
 #if defined(HAS_SCALEUVCOLS_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
-    ScaleUVCols = ScaleUVCols_SSSE3;
+    plan->ScaleCols = ScaleUVCols_SSSE3;
   }
 #endif
 #if defined(HAS_SCALEUVCOLS_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
-    ScaleUVCols = ScaleUVCols_Any_NEON;
+    plan->ScaleCols = ScaleUVCols_Any_NEON;
     if (IS_ALIGNED(dst_width, 8)) {
-      ScaleUVCols = ScaleUVCols_NEON;
+      plan->ScaleCols = ScaleUVCols_NEON;
     }
   }
 #endif
-  if (src_width * 2 == dst_width && x < 0x8000) {
-    ScaleUVCols = ScaleUVColsUp2_C;
+  if (src_width * 2 == dst_width && plan->x < 0x8000) {
+    plan->ScaleCols = ScaleUVColsUp2_C;
 #if defined(HAS_SCALEUVCOLSUP2_SSSE3)
     if (TestCpuFlag(kCpuHasSSSE3) && IS_ALIGNED(dst_width, 8)) {
-      ScaleUVCols = ScaleUVColsUp2_SSSE3;
+      plan->ScaleCols = ScaleUVColsUp2_SSSE3;
     }
 #endif
   }
+}
 
+static void ScaleUVSimple(const struct ScalePlan* plan,
+                          ptrdiff_t src_stride,
+                          ptrdiff_t dst_stride,
+                          const uint8_t* src_uv,
+                          uint8_t* dst_uv) {
+  int j;
+  const int dst_width = plan->dst_width;
+  const int dst_height = plan->dst_height;
+  const int x = plan->x;
+  const int dx = plan->dx;
+  const int dy = plan->dy;
+  int y = plan->y;
   for (j = 0; j < dst_height; ++j) {
-    ScaleUVCols(dst_uv, src_uv + (y >> 16) * src_stride, dst_width, x, dx);
+    plan->ScaleCols(dst_uv, src_uv + (y >> 16) * src_stride, dst_width, x, dx);
     dst_uv += dst_stride;
     y += dy;
   }
@@ -941,54 +745,46 @@ static int UVCopy_16(const uint16_t* src_uv,
 }
 #endif  // HAS_UVCOPY
 
-// Scale a UV plane (from NV12)
-// This function in turn calls a scaling function
-// suitable for handling the desired resolutions.
-static int ScaleUV(const uint8_t* src,
-                   int src_stride,
-                   int src_width,
-                   int src_height,
-                   uint8_t* dst,
-                   int dst_stride,
-                   int dst_width,
-                   int dst_height,
-                   int clip_x,
-                   int clip_y,
-                   int clip_width,
-                   int clip_height,
-                   enum FilterMode filtering) {
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
+// Fill in a plan for a UV plane (from NV12).
+// This function chooses a scaling function suitable for handling the
+// desired resolutions.
+int ScalePlanInitUV(struct ScalePlan* plan,
+                    int src_width,
+                    int src_height,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering) {
+  if (src_width <= 0 || src_height == 0 || src_width > 32768 ||
+      src_height < -32768 || src_height > 32768 || dst_width <= 0 ||
+      dst_height <= 0) {
+    return -1;
+  }
+  memset(plan, 0, sizeof(*plan));
   // UV does not support box filter yet, but allow the user to pass it.
   // Simplify filtering when possible.
   filtering = ScaleFilterReduce(src_width, src_height, dst_width, dst_height,
                                 filtering);
 
   // Negative src_height means invert the image.
-  if (src_height < 0) {
-    src_height = -src_height;
-    src = src + (src_height - 1) * (ptrdiff_t)src_stride;
-    src_stride = -src_stride;
-  }
-  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering, &x, &y,
-             &dx, &dy);
+  plan->invert = src_height < 0;
+  src_height = Abs(src_height);
+  // Initial source x/y coordinate and step values as 16.16 fixed point.
+  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering, &plan->x,
+             &plan->y, &plan->dx, &plan->dy);
   src_width = Abs(src_width);
-  if (clip_x) {
-    int64_t clipf = (int64_t)(clip_x)*dx;
-    x += (clipf & 0xffff);
-    src += (clipf >> 16) * 2;
-    dst += clip_x * 2;
-  }
-  if (clip_y) {
-    int64_t clipf = (int64_t)(clip_y)*dy;
-    y += (clipf & 0xffff);
-    src += (clipf >> 16) * (ptrdiff_t)src_stride;
-    dst += clip_y * (ptrdiff_t)dst_stride;
+  plan->format = kScalePlanUV;
+  plan->src_width = src_width;
+  plan->src_height = src_height;
+  plan->dst_width = dst_width;
+  plan->dst_height = dst_height;
+  if (filtering >= kFilterBicubic) {
+    plan->filtering = filtering;
+    ScalePolyphaseInit(plan, dst_width, dst_height);
+    return 0;
   }
 
+  const int dx = plan->dx;
+  const int dy = plan->dy;
   // Special case for integer step values.
   if (((dx | dy) & 0xffff) == 0) {
     if (!dx || !dy) {  // 1 pixel wide and/or tall.
@@ -996,27 +792,24 @@ static int ScaleUV(const uint8_t* src,
     } else {
       // Optimized even scale down. ie 2, 4, 6, 8, 10x.
       if (!(dx & 0x10000) && !(dy & 0x10000)) {
+        plan->filtering = filtering;
 #if HAS_SCALEUVDOWN2
         if (dx == 0x20000 && dy == 0x20000) {
           // Optimized 1/2 downsample.
-          ScaleUVDown2(src_width, src_height, clip_width, clip_height,
-                       src_stride, dst_stride, src, dst, x, dx, y, dy,
-                       filtering);
+          plan->method = kScaleMethodDown2;
           return 0;
         }
 #endif
 #if HAS_SCALEUVDOWN4BOX
         if (dx == 0x40000 && dy == 0x40000 && filtering == kFilterBox) {
           // Optimized 1/4 box downsample.
-          return ScaleUVDown4Box(src_width, src_height, clip_width, clip_height,
-                                 src_stride, dst_stride, src, dst, x, dx, y,
-                                 dy);
+          plan->method = kScaleMethodDown4Box;
+          plan->row_size = ((dst_width * 2 * 2 + 15) & ~15) * 2;
+          return 0;
         }
 #endif
 #if HAS_SCALEUVDOWNEVEN
-        ScaleUVDownEven(src_width, src_height, clip_width, clip_height,
-                        src_stride, dst_stride, src, dst, x, dx, y, dy,
-                        filtering);
+        plan->method = kScaleMethodDownEven;
         return 0;
 #endif
       }
@@ -1026,51 +819,155 @@ static int ScaleUV(const uint8_t* src,
 #ifdef HAS_UVCOPY
         if (dx == 0x10000 && dy == 0x10000) {
           // Straight copy.
-          return UVCopy(src + (y >> 16) * (ptrdiff_t)src_stride + (x >> 16) * 2,
-                        src_stride, dst, dst_stride, clip_width, clip_height);
+          plan->method = kScaleMethodCopy;
+          plan->filtering = filtering;
+          return 0;
         }
 #endif
       }
     }
   }
+  plan->filtering = filtering;
   // HAS_SCALEPLANEVERTICAL
-  if (dx == 0x10000 && (x & 0xffff) == 0) {
+  if (dx == 0x10000 && (plan->x & 0xffff) == 0) {
     // Arbitrary scale vertically, but unscaled horizontally.
-    ScalePlaneVertical(src_height, clip_width, clip_height, src_stride,
-                       dst_stride, src, dst, x, y, dy, /*bpp=*/2, filtering);
+    plan->method = kScaleMethodVertical;
     return 0;
   }
   if ((filtering == kFilterLinear) && ((dst_width + 1) / 2 == src_width)) {
-    ScaleUVLinearUp2(src_width, src_height, clip_width, clip_height, src_stride,
-                     dst_stride, src, dst);
+    plan->method = kScaleMethodUp2Linear;
     return 0;
   }
-  if ((clip_height + 1) / 2 == src_height &&
-      (clip_width + 1) / 2 == src_width &&
+  if ((dst_height + 1) / 2 == src_height && (dst_width + 1) / 2 == src_width &&
       (filtering == kFilterBilinear || filtering == kFilterBox)) {
-    ScaleUVBilinearUp2(src_width, src_height, clip_width, clip_height,
-                       src_stride, dst_stride, src, dst);
+    plan->method = kScaleMethodUp2Bilinear;
     return 0;
   }
 #if HAS_SCALEUVBILINEARUP
   if (filtering && dy < 65536) {
-    return ScaleUVBilinearUp(src_width, src_height, clip_width, clip_height,
-                             src_stride, dst_stride, src, dst, x, dx, y, dy,
-                             filtering);
+    plan->method = kScaleMethodBilinearUp;
+    ScaleUVBilinearUpInit(plan);
+    return 0;
   }
 #endif
 #if HAS_SCALEUVBILINEARDOWN
   if (filtering) {
-    return ScaleUVBilinearDown(src_width, src_height, clip_width, clip_height,
-                               src_stride, dst_stride, src, dst, x, dx, y, dy,
-                               filtering);
+    plan->method = kScaleMethodBilinearDown;
+    ScaleUVBilinearDownInit(plan);
+    return 0;
   }
 #endif
-  ScaleUVSimple(src_width, src_height, clip_width, clip_height, src_stride,
-                dst_stride, src, dst, x, dx, y, dy);
+  plan->method = kScaleMethodSimple;
+  ScaleUVSimpleInit(plan);
   return 0;
 }
 
+int ScalePlanRunUV(const struct ScalePlan* plan,
+                   const uint8_t* src,
+                   int src_stride,
+                   uint8_t* dst,
+                   int dst_stride,
+                   uint8_t* row) {
+  const int src_width = plan->src_width;
+  const int src_height = plan->src_height;
+  const int dst_width = plan->dst_width;
+  const int dst_height = plan->dst_height;
+  const int x = plan->x;
+  const int y = plan->y;
+  const int dx = plan->dx;
+  const int dy = plan->dy;
+  if (plan->invert) {
+    src = src + (src_height - 1) * (ptrdiff_t)src_stride;
+    src_stride = -src_stride;
+  }
+  src += plan->src_offset_x * 2;
+  switch (plan->method) {
+#if HAS_SCALEUVDOWN2
+    case kScaleMethodDown2:
+      ScaleUVDown2(src_width, src_height, dst_width, dst_height, src_stride,
+                   dst_stride, src, dst, x, dx, y, dy, plan->filtering);
+      return 0;
+#endif
+#if HAS_SCALEUVDOWN4BOX
+    case kScaleMethodDown4Box:
+      ScaleUVDown4Box(src_width, src_height, dst_width, dst_height, src_stride,
+                      dst_stride, src, dst, x, dx, y, dy, row);
+      return 0;
+#endif
+#if HAS_SCALEUVDOWNEVEN
+    case kScaleMethodDownEven:
+      ScaleUVDownEven(src_width, src_height, dst_width, dst_height, src_stride,
+                      dst_stride, src, dst, x, dx, y, dy, plan->filtering);
+      return 0;
+#endif
+#ifdef HAS_UVCOPY
+    case kScaleMethodCopy:
+      return UVCopy(src + (y >> 16) * (ptrdiff_t)src_stride + (x >> 16) * 2,
+                    src_stride, dst, dst_stride, dst_width, dst_height);
+#endif
+    case kScaleMethodVertical:
+      ScalePlaneVertical(src_height, dst_width, dst_height, src_stride,
+                         dst_stride, src, dst, x, y, dy, /*bpp=*/2,
+                         plan->filtering);
+      return 0;
+    case kScaleMethodUp2Linear:
+      ScaleUVLinearUp2(src_width, src_height, dst_width, dst_height,
+                       src_stride, dst_stride, src, dst);
+      return 0;
+    case kScaleMethodUp2Bilinear:
+      ScaleUVBilinearUp2(src_width, src_height, dst_width, dst_height,
+                         src_stride, dst_stride, src, dst);
+      return 0;
+#if HAS_SCALEUVBILINEARUP
+    case kScaleMethodBilinearUp:
+      ScaleUVBilinearUp(plan, src_stride, dst_stride, src, dst, row);
+      return 0;
+#endif
+#if HAS_SCALEUVBILINEARDOWN
+    case kScaleMethodBilinearDown:
+      ScaleUVBilinearDown(plan, src_stride, dst_stride, src, dst, row);
+      return 0;
+#endif
+    case kScaleMethodPolyphase:
+      ScalePolyphase(plan, src, src_stride, dst, dst_stride, 0, dst_height,
+                     row);
+      return 0;
+    default:
+      ScaleUVSimple(plan, src_stride, dst_stride, src, dst);
+      return 0;
+  }
+}
+
+int ScalePlanBandableUV(const struct ScalePlan* plan) {
+  return !plan->invert && plan->method != kScaleMethodUp2Linear &&
+         plan->method != kScaleMethodUp2Bilinear &&
+         plan->method != kScaleMethodBilinearUp;
+}
+
+int ScalePlanRunBandUV(const struct ScalePlan* plan,
+                       int dst_y_begin,
+                       int dst_y_end,
+                       const uint8_t* src,
+                       int src_stride,
+                       uint8_t* dst,
+                       int dst_stride,
+                       uint8_t* row) {
+  struct ScalePlan band = *plan;
+  if (!ScalePlanBandableUV(plan)) {
+    return -1;
+  }
+  if (plan->method == kScaleMethodPolyphase) {
+    ScalePolyphase(plan, src, src_stride, dst, dst_stride, dst_y_begin,
+                   dst_y_end, row);
+    return 0;
+  }
+  // The remaining scalers step y from the first row and clamp it per row,
+  // so a band starts at the y the whole plane loop reaches.
+  band.y = (int)(plan->y + (int64_t)plan->dy * dst_y_begin);
+  band.dst_height = dst_y_end - dst_y_begin;
+  return ScalePlanRunUV(&band, src, src_stride, dst, dst_stride, row);
+}
+
 // Scale an UV image.
 LIBYUV_API
 int UVScale(const uint8_t* src_uv,
@@ -1082,14 +979,14 @@ int UVScale(const uint8_t* src_uv,
             int dst_width,
             int dst_height,
             enum FilterMode filtering) {
-  if (!src_uv || src_width <= 0 || src_height == 0 || src_width > 32768 ||
-      src_height < -32768 || src_height > 32768 || !dst_uv || dst_width <= 0 ||
-      dst_height <= 0) {
+  struct ScalePlan plan;
+  if (!src_uv || !dst_uv ||
+      ScalePlanInitUV(&plan, src_width, src_height, dst_width, dst_height,
+                      filtering)) {
     return -1;
   }
-  return ScaleUV(src_uv, src_stride_uv, src_width, src_height, dst_uv,
-                 dst_stride_uv, dst_width, dst_height, 0, 0, dst_width,
-                 dst_height, filtering);
+  return ScalePlanRunOnce(&plan, src_uv, src_stride_uv, dst_uv,
+                          dst_stride_uv);
 }
 
 // Scale a 16 bit UV image.
@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <float.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
@@ -37,6 +38,63 @@ static uint32_t ReferenceHashDjb2(const uint8_t* src,
   return hash;
 }
 
+// SSIM of each 8x8 window computed directly from its 64 pixels.
+static double ReferenceSsim8x8(const uint8_t* src_a,
+                               int stride_a,
+                               const uint8_t* src_b,
+                               int stride_b) {
+  int64_t sum_a = 0;
+  int64_t sum_b = 0;
+  int64_t sum_sq_a = 0;
+  int64_t sum_sq_b = 0;
+  int64_t sum_axb = 0;
+  for (int i = 0; i < 8; ++i) {
+    for (int j = 0; j < 8; ++j) {
+      sum_a += src_a[j];
+      sum_b += src_b[j];
+      sum_sq_a += src_a[j] * src_a[j];
+      sum_sq_b += src_b[j] * src_b[j];
+      sum_axb += src_a[j] * src_b[j];
+    }
+    src_a += stride_a;
+    src_b += stride_b;
+  }
+  const int64_t count = 64;
+  const int64_t c1 = (26634 * count * count) >> 12;
+  const int64_t c2 = (239708 * count * count) >> 12;
+  const int64_t sum_a_x_sum_b = sum_a * sum_b;
+  const int64_t ssim_n = (2 * sum_a_x_sum_b + c1) *
+                         (2 * count * sum_axb - 2 * sum_a_x_sum_b + c2);
+  const int64_t sum_a_sq = sum_a * sum_a;
+  const int64_t sum_b_sq = sum_b * sum_b;
+  const int64_t ssim_d =
+      (sum_a_sq + sum_b_sq + c1) *
+      (count * sum_sq_a - sum_a_sq + count * sum_sq_b - sum_b_sq + c2);
+  if (ssim_d == 0) {
+    return DBL_MAX;
+  }
+  return (double)ssim_n / (double)ssim_d;
+}
+
+static double ReferenceFrameSsim(const uint8_t* src_a,
+                                 int stride_a,
+                                 const uint8_t* src_b,
+                                 int stride_b,
+                                 int width,
+                                 int height) {
+  int samples = 0;
+  double ssim_total = 0;
+  for (int i = 0; i < height - 8; i += 4) {
+    for (int j = 0; j < width - 8; j += 4) {
+      ssim_total += ReferenceSsim8x8(src_a + j, stride_a, src_b + j, stride_b);
+      samples++;
+    }
+    src_a += stride_a * 4;
+    src_b += stride_b * 4;
+  }
+  return ssim_total / samples;
+}
+
 TEST_F(LibYUVCompareTest, Djb2_Test) {
   const int kMaxTest = benchmark_width_ * benchmark_height_;
   align_buffer_page_end(src_a, kMaxTest);
@@ -736,4 +794,68 @@ TEST_F(LibYUVCompareTest, Ssim) {
   free_aligned_buffer_page_end(src_b);
 }
 
+// Compare block sum SSIM to the per window reference at sizes that leave
+// remainders for each SIMD width.
+TEST_F(LibYUVCompareTest, SsimReference) {
+  static const int kSizes[] = {9, 12, 13, 67, 131, 200, 263};
+  const int kMaxSize = 263;
+  align_buffer_page_end(src_a, kMaxSize * kMaxSize);
+  align_buffer_page_end(src_b, kMaxSize * kMaxSize);
+  MemRandomize(src_a, kMaxSize * kMaxSize);
+  MemRandomize(src_b, kMaxSize * kMaxSize);
+
+  for (int w = 0; w < static_cast<int>(sizeof(kSizes) / sizeof(kSizes[0]));
+       ++w) {
+    const int kWidth = kSizes[w];
+    const int kHeight = kSizes[(w + 3) % 7];
+    const double ref_err =
+        ReferenceFrameSsim(src_a, kMaxSize, src_b, kMaxSize, kWidth, kHeight);
+
+    MaskCpuFlags(disable_cpu_flags_);
+    const double c_err =
+        CalcFrameSsim(src_a, kMaxSize, src_b, kMaxSize, kWidth, kHeight);
+    MaskCpuFlags(benchmark_cpu_info_);
+    const double opt_err =
+        CalcFrameSsim(src_a, kMaxSize, src_b, kMaxSize, kWidth, kHeight);
+
+    EXPECT_EQ(ref_err, c_err) << kWidth << "x" << kHeight;
+    EXPECT_EQ(ref_err, opt_err) << kWidth << "x" << kHeight;
+  }
+
+  free_aligned_buffer_page_end(src_a);
+  free_aligned_buffer_page_end(src_b);
+}
+
+TEST_F(LibYUVCompareTest, BenchmarkSsim_1080p) {
+  const int kWidth = 1920;
+  const int kHeight = 1080;
+  align_buffer_page_end(src_a, kWidth * kHeight);
+  align_buffer_page_end(src_b, kWidth * kHeight);
+  MemRandomize(src_a, kWidth * kHeight);
+  MemRandomize(src_b, kWidth * kHeight);
+
+  MaskCpuFlags(disable_cpu_flags_);
+  double c_err = 0.0;
+  double c_time = get_time();
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    c_err = CalcFrameSsim(src_a, kWidth, src_b, kWidth, kWidth, kHeight);
+  }
+  c_time = (get_time() - c_time) / benchmark_iterations_;
+
+  MaskCpuFlags(benchmark_cpu_info_);
+  double opt_err = 0.0;
+  double opt_time = get_time();
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    opt_err = CalcFrameSsim(src_a, kWidth, src_b, kWidth, kWidth, kHeight);
+  }
+  opt_time = (get_time() - opt_time) / benchmark_iterations_;
+  printf("BenchmarkSsim_1080p - %8.2f us c - %8.2f us opt - %4.2fx\n",
+         c_time * 1e6, opt_time * 1e6, c_time / opt_time);
+
+  EXPECT_EQ(c_err, opt_err);
+
+  free_aligned_buffer_page_end(src_a);
+  free_aligned_buffer_page_end(src_b);
+}
+
 }  // namespace libyuv
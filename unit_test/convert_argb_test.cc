@@ -3000,4 +3000,397 @@ TESTATOBP(RAW, uint8_t, 3, 3, 1, NV21, 2, 2)
 TESTATOBP(RGB24, uint8_t, 3, 3, 1, NV12, 2, 2)
 TESTATOBP(RAW, uint8_t, 3, 3, 1, JNV21, 2, 2)
 
+// The filter functions with caller scratch match the allocating ones.
+TEST_F(LibYUVConvertTest, MatrixFilterScratch) {
+  const int kWidth = benchmark_width_ | 1;
+  const int kHeight = benchmark_height_ | 1;
+  const int kHalfWidth = (kWidth + 1) / 2;
+  const int kHalfHeight = (kHeight + 1) / 2;
+  const int scratch_size = YUVToRGBMatrixFilterScratchSize(kWidth);
+  EXPECT_LT(0, scratch_size);
+  align_buffer_page_end(src_y, kWidth * kHeight * 2);
+  align_buffer_page_end(src_u, kHalfWidth * kHeight * 2);
+  align_buffer_page_end(src_v, kHalfWidth * kHeight * 2);
+  align_buffer_page_end(dst_c, kWidth * kHeight * 4);
+  align_buffer_page_end(dst_opt, kWidth * kHeight * 4);
+  align_buffer_page_end(scratch, scratch_size);
+  MemRandomize(src_y, kWidth * kHeight * 2);
+  MemRandomize(src_u, kHalfWidth * kHeight * 2);
+  MemRandomize(src_v, kHalfWidth * kHeight * 2);
+  uint16_t* src_y_16 = reinterpret_cast<uint16_t*>(src_y);
+  uint16_t* src_u_16 = reinterpret_cast<uint16_t*>(src_u);
+  uint16_t* src_v_16 = reinterpret_cast<uint16_t*>(src_v);
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    src_y_16[i] &= 0x3ff;
+  }
+  for (int i = 0; i < kHalfWidth * kHeight; ++i) {
+    src_u_16[i] &= 0x3ff;
+    src_v_16[i] &= 0x3ff;
+  }
+
+  for (int n = 0; n < 3; ++n) {
+    memset(dst_c, 1, kWidth * kHeight * 4);
+    memset(dst_opt, 2, kWidth * kHeight * 4);
+    if (n == 0) {
+      EXPECT_EQ(0, I420ToARGBMatrixFilter(
+                       src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+                       dst_c, kWidth * 4, &kYuvI601Constants, kWidth, kHeight,
+                       kFilterBilinear));
+      EXPECT_EQ(0, I420ToARGBMatrixFilterScratch(
+                       src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+                       dst_opt, kWidth * 4, &kYuvI601Constants, kWidth,
+                       kHeight, kFilterBilinear, scratch, scratch_size));
+    } else if (n == 1) {
+      EXPECT_EQ(0, I422ToARGBMatrixFilter(
+                       src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+                       dst_c, kWidth * 4, &kYuvI601Constants, kWidth, kHeight,
+                       kFilterLinear));
+      EXPECT_EQ(0, I422ToARGBMatrixFilterScratch(
+                       src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+                       dst_opt, kWidth * 4, &kYuvI601Constants, kWidth,
+                       kHeight, kFilterLinear, scratch, scratch_size));
+    } else {
+      EXPECT_EQ(0, I010ToAR30MatrixFilter(
+                       src_y_16, kWidth, src_u_16, kHalfWidth, src_v_16,
+                       kHalfWidth, dst_c, kWidth * 4, &kYuvI601Constants,
+                       kWidth, kHalfHeight * 2 - 1, kFilterBilinear));
+      EXPECT_EQ(0, I010ToAR30MatrixFilterScratch(
+                       src_y_16, kWidth, src_u_16, kHalfWidth, src_v_16,
+                       kHalfWidth, dst_opt, kWidth * 4, &kYuvI601Constants,
+                       kWidth, kHalfHeight * 2 - 1, kFilterBilinear, scratch,
+                       scratch_size));
+    }
+    for (int i = 0; i < kWidth * kHeight * 4; ++i) {
+      ASSERT_EQ(dst_c[i], dst_opt[i]) << "function " << n << " at " << i;
+    }
+  }
+  // A scratch buffer smaller than required is rejected.
+  EXPECT_EQ(-1, I420ToARGBMatrixFilterScratch(
+                    src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+                    dst_opt, kWidth * 4, &kYuvI601Constants, kWidth, kHeight,
+                    kFilterBilinear, scratch, scratch_size - 1));
+
+  free_aligned_buffer_page_end(scratch);
+  free_aligned_buffer_page_end(dst_opt);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(src_v);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_y);
+}
+
+// I420ToRGB565Dither converts in chunks; rows wider than a chunk match a
+// whole row conversion.
+TEST_F(LibYUVConvertTest, I420ToRGB565DitherWide) {
+  const int kWidth = 1301;
+  const int kHeight = 5;
+  const int kHalfWidth = (kWidth + 1) / 2;
+  const int kHalfHeight = (kHeight + 1) / 2;
+  static const uint8_t kDither[16] = {0, 4, 1, 5, 6, 2, 7, 3,
+                                      1, 5, 0, 4, 7, 3, 6, 2};
+  align_buffer_page_end(src_y, kWidth * kHeight);
+  align_buffer_page_end(src_u, kHalfWidth * kHalfHeight);
+  align_buffer_page_end(src_v, kHalfWidth * kHalfHeight);
+  align_buffer_page_end(argb, kWidth * kHeight * 4);
+  align_buffer_page_end(dst_ref, kWidth * kHeight * 2);
+  align_buffer_page_end(dst, kWidth * kHeight * 2);
+  MemRandomize(src_y, kWidth * kHeight);
+  MemRandomize(src_u, kHalfWidth * kHalfHeight);
+  MemRandomize(src_v, kHalfWidth * kHalfHeight);
+
+  EXPECT_EQ(0, I420ToARGB(src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+                          argb, kWidth * 4, kWidth, kHeight));
+  EXPECT_EQ(0, ARGBToRGB565Dither(argb, kWidth * 4, dst_ref, kWidth * 2,
+                                  kDither, kWidth, kHeight));
+  EXPECT_EQ(0, I420ToRGB565Dither(src_y, kWidth, src_u, kHalfWidth, src_v,
+                                  kHalfWidth, dst, kWidth * 2, kDither, kWidth,
+                                  kHeight));
+  for (int i = 0; i < kWidth * kHeight * 2; ++i) {
+    ASSERT_EQ(dst_ref[i], dst[i]) << i;
+  }
+
+  free_aligned_buffer_page_end(dst);
+  free_aligned_buffer_page_end(dst_ref);
+  free_aligned_buffer_page_end(argb);
+  free_aligned_buffer_page_end(src_v);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_y);
+}
+
+// Chroma with a pixel stride of 3 takes the general Android420 path, which
+// converts in chunks narrower than this image.
+TEST_F(LibYUVConvertTest, Android420ToARGBWide) {
+  const int kWidth = 2301;
+  const int kHeight = 5;
+  const int kHalfWidth = (kWidth + 1) / 2;
+  const int kHalfHeight = (kHeight + 1) / 2;
+  const int kStrideUV = kHalfWidth * 3;
+  align_buffer_page_end(src_y, kWidth * kHeight);
+  align_buffer_page_end(src_uv, kStrideUV * kHalfHeight);
+  align_buffer_page_end(src_u, kHalfWidth * kHalfHeight);
+  align_buffer_page_end(src_v, kHalfWidth * kHalfHeight);
+  align_buffer_page_end(dst_ref, kWidth * kHeight * 4);
+  align_buffer_page_end(dst, kWidth * kHeight * 4);
+  MemRandomize(src_y, kWidth * kHeight);
+  MemRandomize(src_uv, kStrideUV * kHalfHeight);
+  for (int y = 0; y < kHalfHeight; ++y) {
+    for (int x = 0; x < kHalfWidth; ++x) {
+      src_u[y * kHalfWidth + x] = src_uv[y * kStrideUV + x * 3];
+      src_v[y * kHalfWidth + x] = src_uv[y * kStrideUV + x * 3 + 1];
+    }
+  }
+
+  for (int invert = 0; invert < 2; ++invert) {
+    const int height = invert ? -kHeight : kHeight;
+    memset(dst_ref, 1, kWidth * kHeight * 4);
+    memset(dst, 2, kWidth * kHeight * 4);
+    EXPECT_EQ(0, I420ToARGB(src_y, kWidth, src_u, kHalfWidth, src_v,
+                            kHalfWidth, dst_ref, kWidth * 4, kWidth, height));
+    EXPECT_EQ(0, Android420ToARGB(src_y, kWidth, src_uv, kStrideUV,
+                                  src_uv + 1, kStrideUV, 3, dst, kWidth * 4,
+                                  kWidth, height));
+    for (int i = 0; i < kWidth * kHeight * 4; ++i) {
+      ASSERT_EQ(dst_ref[i], dst[i]) << i;
+    }
+  }
+
+  free_aligned_buffer_page_end(dst);
+  free_aligned_buffer_page_end(dst_ref);
+  free_aligned_buffer_page_end(src_v);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_uv);
+  free_aligned_buffer_page_end(src_y);
+}
+
+// The *Rotate converters match rotating the YUV frame and then converting.
+static void TestYUVToARGBRotate(int width,
+                                int height,
+                                RotationMode mode,
+                                bool nv12,
+                                bool abgr,
+                                int benchmark_iterations) {
+  const int abs_height = Abs(height);
+  const int halfwidth = (width + 1) / 2;
+  const int halfheight = (abs_height + 1) / 2;
+  const int dst_width = mode == kRotate90 || mode == kRotate270 ? abs_height
+                                                                : width;
+  const int dst_height =
+      mode == kRotate90 || mode == kRotate270 ? width : abs_height;
+  const int dst_halfwidth = (dst_width + 1) / 2;
+  const int dst_halfheight = (dst_height + 1) / 2;
+  align_buffer_page_end(src_y, width * abs_height);
+  align_buffer_page_end(src_u, halfwidth * halfheight);
+  align_buffer_page_end(src_v, halfwidth * halfheight);
+  align_buffer_page_end(src_uv, halfwidth * halfheight * 2);
+  align_buffer_page_end(rot_y, dst_width * dst_height);
+  align_buffer_page_end(rot_u, dst_halfwidth * dst_halfheight);
+  align_buffer_page_end(rot_v, dst_halfwidth * dst_halfheight);
+  align_buffer_page_end(dst_ref, dst_width * dst_height * 4);
+  align_buffer_page_end(dst, dst_width * dst_height * 4);
+  MemRandomize(src_y, width * abs_height);
+  MemRandomize(src_u, halfwidth * halfheight);
+  MemRandomize(src_v, halfwidth * halfheight);
+  MergeUVPlane(src_u, halfwidth, src_v, halfwidth, src_uv, halfwidth * 2,
+               halfwidth, halfheight);
+  memset(dst, 0, dst_width * dst_height * 4);
+
+  if (nv12) {
+    EXPECT_EQ(0, NV12ToI420Rotate(src_y, width, src_uv, halfwidth * 2, rot_y,
+                                  dst_width, rot_u, dst_halfwidth, rot_v,
+                                  dst_halfwidth, width, height, mode));
+  } else {
+    EXPECT_EQ(0, I420Rotate(src_y, width, src_u, halfwidth, src_v, halfwidth,
+                            rot_y, dst_width, rot_u, dst_halfwidth, rot_v,
+                            dst_halfwidth, width, height, mode));
+  }
+  if (abgr) {
+    EXPECT_EQ(0, I420ToABGR(rot_y, dst_width, rot_u, dst_halfwidth, rot_v,
+                            dst_halfwidth, dst_ref, dst_width * 4, dst_width,
+                            dst_height));
+  } else {
+    EXPECT_EQ(0, I420ToARGB(rot_y, dst_width, rot_u, dst_halfwidth, rot_v,
+                            dst_halfwidth, dst_ref, dst_width * 4, dst_width,
+                            dst_height));
+  }
+
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    if (nv12 && abgr) {
+      EXPECT_EQ(0, NV12ToABGRRotate(src_y, width, src_uv, halfwidth * 2, dst,
+                                    dst_width * 4, width, height, mode));
+    } else if (nv12) {
+      EXPECT_EQ(0, NV12ToARGBRotate(src_y, width, src_uv, halfwidth * 2, dst,
+                                    dst_width * 4, width, height, mode));
+    } else if (abgr) {
+      EXPECT_EQ(0, I420ToABGRRotate(src_y, width, src_u, halfwidth, src_v,
+                                    halfwidth, dst, dst_width * 4, width,
+                                    height, mode));
+    } else {
+      EXPECT_EQ(0, I420ToARGBRotate(src_y, width, src_u, halfwidth, src_v,
+                                    halfwidth, dst, dst_width * 4, width,
+                                    height, mode));
+    }
+  }
+
+  for (int i = 0; i < dst_width * dst_height * 4; ++i) {
+    ASSERT_EQ(dst_ref[i], dst[i]) << i;
+  }
+
+  free_aligned_buffer_page_end(dst);
+  free_aligned_buffer_page_end(dst_ref);
+  free_aligned_buffer_page_end(rot_v);
+  free_aligned_buffer_page_end(rot_u);
+  free_aligned_buffer_page_end(rot_y);
+  free_aligned_buffer_page_end(src_uv);
+  free_aligned_buffer_page_end(src_v);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_y);
+}
+
+TEST_F(LibYUVConvertTest, I420ToARGBRotate90) {
+  TestYUVToARGBRotate(benchmark_width_, benchmark_height_, kRotate90, false,
+                      false, benchmark_iterations_);
+}
+
+TEST_F(LibYUVConvertTest, I420ToARGBRotate180) {
+  TestYUVToARGBRotate(benchmark_width_, benchmark_height_, kRotate180, false,
+                      false, benchmark_iterations_);
+}
+
+TEST_F(LibYUVConvertTest, I420ToARGBRotate270) {
+  TestYUVToARGBRotate(benchmark_width_, benchmark_height_, kRotate270, false,
+                      false, benchmark_iterations_);
+}
+
+TEST_F(LibYUVConvertTest, I420ToARGBRotate_Odd) {
+  TestYUVToARGBRotate(benchmark_width_ + 1, benchmark_height_ + 1, kRotate0,
+                      false, false, 1);
+  TestYUVToARGBRotate(benchmark_width_ + 1, benchmark_height_ + 1, kRotate90,
+                      false, false, 1);
+  TestYUVToARGBRotate(benchmark_width_ + 1, benchmark_height_ + 1, kRotate180,
+                      false, false, 1);
+  TestYUVToARGBRotate(benchmark_width_ + 1, benchmark_height_ + 1, kRotate270,
+                      false, false, 1);
+  // More than one band.
+  TestYUVToARGBRotate(131, 203, kRotate90, false, false, 1);
+  TestYUVToARGBRotate(202, 130, kRotate180, false, false, 1);
+  TestYUVToARGBRotate(130, 203, kRotate270, false, false, 1);
+}
+
+TEST_F(LibYUVConvertTest, I420ToARGBRotate_Invert) {
+  TestYUVToARGBRotate(benchmark_width_, -benchmark_height_, kRotate90, false,
+                      false, 1);
+  TestYUVToARGBRotate(benchmark_width_, -benchmark_height_, kRotate180, false,
+                      false, 1);
+}
+
+TEST_F(LibYUVConvertTest, I420ToABGRRotate90) {
+  TestYUVToARGBRotate(benchmark_width_, benchmark_height_, kRotate90, false,
+                      true, benchmark_iterations_);
+}
+
+TEST_F(LibYUVConvertTest, NV12ToARGBRotate90) {
+  TestYUVToARGBRotate(benchmark_width_, benchmark_height_, kRotate90, true,
+                      false, benchmark_iterations_);
+}
+
+TEST_F(LibYUVConvertTest, NV12ToARGBRotate270) {
+  TestYUVToARGBRotate(benchmark_width_, benchmark_height_, kRotate270, true,
+                      false, benchmark_iterations_);
+}
+
+TEST_F(LibYUVConvertTest, NV12ToARGBRotate_Odd) {
+  TestYUVToARGBRotate(benchmark_width_ + 1, benchmark_height_ + 1, kRotate90,
+                      true, false, 1);
+  TestYUVToARGBRotate(benchmark_width_ + 1, benchmark_height_ + 1, kRotate180,
+                      true, false, 1);
+  TestYUVToARGBRotate(benchmark_width_ + 1, benchmark_height_ + 1, kRotate270,
+                      true, false, 1);
+}
+
+TEST_F(LibYUVConvertTest, NV12ToABGRRotate90) {
+  TestYUVToARGBRotate(benchmark_width_, benchmark_height_, kRotate90, true,
+                      true, benchmark_iterations_);
+}
+
+TEST_F(LibYUVConvertTest, I420ToARGBRotate_1080p) {
+  TestYUVToARGBRotate(1920, 1080, kRotate90, false, false,
+                      benchmark_iterations_);
+}
+
+TEST_F(LibYUVConvertTest, I420ToARGBRotate_BadArgs) {
+  align_buffer_page_end(frame, 64 * 64 * 4);
+  EXPECT_EQ(-1, I420ToARGBRotate(frame, 8, frame, 4, frame, 4, frame, 32, 8, 0,
+                                 kRotate90));
+  EXPECT_EQ(-1, I420ToARGBRotate(frame, 8, frame, 4, frame, 4, frame, 32, 8, 8,
+                                 (RotationMode)45));
+  free_aligned_buffer_page_end(frame);
+}
+
+// The rotate functions with caller scratch match the allocating ones.
+TEST_F(LibYUVConvertTest, MatrixRotateScratch) {
+  const int kWidth = 131;
+  const int kHeight = 203;
+  const int kHalfWidth = (kWidth + 1) / 2;
+  const int kHalfHeight = (kHeight + 1) / 2;
+  const RotationMode kModes[3] = {kRotate90, kRotate180, kRotate270};
+  align_buffer_page_end(src_y, kWidth * kHeight);
+  align_buffer_page_end(src_u, kHalfWidth * kHalfHeight);
+  align_buffer_page_end(src_v, kHalfWidth * kHalfHeight);
+  align_buffer_page_end(src_uv, kHalfWidth * kHalfHeight * 2);
+  align_buffer_page_end(dst_c, kWidth * kHeight * 4);
+  align_buffer_page_end(dst_opt, kWidth * kHeight * 4);
+  MemRandomize(src_y, kWidth * kHeight);
+  MemRandomize(src_u, kHalfWidth * kHalfHeight);
+  MemRandomize(src_v, kHalfWidth * kHalfHeight);
+  MemRandomize(src_uv, kHalfWidth * kHalfHeight * 2);
+
+  for (int m = 0; m < 3; ++m) {
+    const RotationMode mode = kModes[m];
+    const int dst_stride = (mode == kRotate180 ? kWidth : kHeight) * 4;
+    const int scratch_size =
+        YUVToARGBMatrixRotateScratchSize(kWidth, kHeight, mode);
+    EXPECT_LT(0, scratch_size);
+    align_buffer_page_end(scratch, scratch_size);
+    for (int n = 0; n < 2; ++n) {
+      memset(dst_c, 1, kWidth * kHeight * 4);
+      memset(dst_opt, 2, kWidth * kHeight * 4);
+      if (n == 0) {
+        EXPECT_EQ(0, I420ToARGBMatrixRotate(
+                         src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+                         dst_c, dst_stride, &kYuvI601Constants, kWidth,
+                         kHeight, mode));
+        EXPECT_EQ(0, I420ToARGBMatrixRotateScratch(
+                         src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+                         dst_opt, dst_stride, &kYuvI601Constants, kWidth,
+                         kHeight, mode, scratch, scratch_size));
+      } else {
+        EXPECT_EQ(0, NV12ToARGBMatrixRotate(src_y, kWidth, src_uv,
+                                            kHalfWidth * 2, dst_c, dst_stride,
+                                            &kYuvI601Constants, kWidth,
+                                            kHeight, mode));
+        EXPECT_EQ(0, NV12ToARGBMatrixRotateScratch(
+                         src_y, kWidth, src_uv, kHalfWidth * 2, dst_opt,
+                         dst_stride, &kYuvI601Constants, kWidth, kHeight,
+                         mode, scratch, scratch_size));
+      }
+      for (int i = 0; i < kWidth * kHeight * 4; ++i) {
+        ASSERT_EQ(dst_c[i], dst_opt[i])
+            << "mode " << mode << " function " << n << " at " << i;
+      }
+    }
+    // A scratch buffer smaller than required is rejected.
+    EXPECT_EQ(-1, I420ToARGBMatrixRotateScratch(
+                      src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+                      dst_opt, dst_stride, &kYuvI601Constants, kWidth,
+                      kHeight, mode, scratch, scratch_size - 1));
+    free_aligned_buffer_page_end(scratch);
+  }
+
+  free_aligned_buffer_page_end(dst_opt);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(src_uv);
+  free_aligned_buffer_page_end(src_v);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_y);
+}
+
 }  // namespace libyuv
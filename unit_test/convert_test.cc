@@ -9,8 +9,13 @@
  */
 
 #include <assert.h>
+#include <stdio.h>  // For jpeglib.h.
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 #include "libyuv/basic_types.h"
 #include "libyuv/compare.h"
@@ -21,10 +26,14 @@
 #include "libyuv/cpu_id.h"
 #ifdef HAVE_JPEG
 #include "libyuv/mjpeg_decoder.h"
+extern "C" {
+#include <jpeglib.h>  // For encoding frames with restart markers.
+}
 #endif
 #include "../unit_test/unit_test.h"
 #include "libyuv/planar_functions.h"
 #include "libyuv/rotate.h"
+#include "libyuv/scale.h"
 #include "libyuv/video_common.h"
 
 #if (defined(__riscv) && !defined(__clang__)) || defined(__hexagon__)
@@ -1801,6 +1810,667 @@ TEST_F(LibYUVConvertTest, TestMJPGInfo) {
   ASSERT_EQ(1, ShowJPegInfo(kTest4Jpg,
                             kTest4JpgLen));  // Valid but unsupported.
 }
+
+TEST_F(LibYUVConvertTest, TestMJPGSessionToI420) {
+  int width = 0;
+  int height = 0;
+  int ret = MJPGSize(kTest2Jpg, kTest2JpgLen, &width, &height);
+  ASSERT_EQ(0, ret);
+
+  int half_width = (width + 1) / 2;
+  int half_height = (height + 1) / 2;
+  int benchmark_iterations = benchmark_iterations_ * benchmark_width_ *
+                             benchmark_height_ / (width * height);
+  if (benchmark_iterations < 1) {
+    benchmark_iterations = 1;
+  }
+
+  align_buffer_page_end(dst_y, width * height);
+  align_buffer_page_end(dst_u, half_width * half_height);
+  align_buffer_page_end(dst_v, half_width * half_height);
+  struct MJPGSession* session = MJPGSessionCreate();
+  ASSERT_TRUE(session != NULL);
+  for (int times = 0; times < benchmark_iterations; ++times) {
+    ret = MJPGSessionToI420(session, kTest2Jpg, kTest2JpgLen, dst_y, width,
+                            dst_u, half_width, dst_v, half_width, width,
+                            height, width, height);
+  }
+  MJPGSessionDestroy(session);
+  // Expect sucesss
+  ASSERT_EQ(0, ret);
+
+  // Test result matches MJPGToI420 hash value.
+  uint32_t dst_y_hash = HashDjb2(dst_y, width * height, 5381);
+  uint32_t dst_u_hash = HashDjb2(dst_u, half_width * half_height, 5381);
+  uint32_t dst_v_hash = HashDjb2(dst_v, half_width * half_height, 5381);
+  ASSERT_EQ(dst_y_hash, 2682851208u);
+  ASSERT_EQ(dst_u_hash, 2501859930u);
+  ASSERT_EQ(dst_v_hash, 2126459123u);
+
+  free_aligned_buffer_page_end(dst_y);
+  free_aligned_buffer_page_end(dst_u);
+  free_aligned_buffer_page_end(dst_v);
+}
+
+// Decode a stream of frames that changes geometry and subsampling, and
+// includes unsupported and truncated frames, with one session for each
+// format.  Each frame must match the stateless functions.
+TEST_F(LibYUVConvertTest, TestMJPGSessionStream) {
+  const uint8_t* frames[] = {kTest2Jpg, kTest0Jpg, kTest0Jpg, kTest4Jpg,
+                             kTest1Jpg, kTest2Jpg, kTest3Jpg, kTest2Jpg};
+  const size_t frame_sizes[] = {kTest2JpgLen, kTest0JpgLen, kTest0JpgLen / 2,
+                                kTest4JpgLen, kTest1JpgLen, kTest2JpgLen,
+                                kTest3JpgLen, kTest2JpgLen};
+  struct MJPGSession* session_i420 = MJPGSessionCreate();
+  struct MJPGSession* session_nv12 = MJPGSessionCreate();
+  struct MJPGSession* session_nv21 = MJPGSessionCreate();
+  struct MJPGSession* session_argb = MJPGSessionCreate();
+  ASSERT_TRUE(session_i420 && session_nv12 && session_nv21 && session_argb);
+
+  for (size_t f = 0; f < sizeof(frames) / sizeof(frames[0]); ++f) {
+    int width = 0;
+    int height = 0;
+    MJPGSize(frames[f], frame_sizes[f], &width, &height);
+    int half_width = (width + 1) / 2;
+    int half_height = (height + 1) / 2;
+    int size = width * height;
+    int half_size = half_width * half_height;
+    align_buffer_page_end(dst_i420, size + half_size * 2);
+    align_buffer_page_end(dst_i420_opt, size + half_size * 2);
+    align_buffer_page_end(dst_nv, size + half_size * 2);
+    align_buffer_page_end(dst_nv_opt, size + half_size * 2);
+    align_buffer_page_end(dst_argb, size * 4);
+    align_buffer_page_end(dst_argb_opt, size * 4);
+    memset(dst_i420, 1, size + half_size * 2);
+    memset(dst_i420_opt, 1, size + half_size * 2);
+    memset(dst_argb, 2, size * 4);
+    memset(dst_argb_opt, 2, size * 4);
+
+    int ret = MJPGToI420(frames[f], frame_sizes[f], dst_i420, width,
+                         dst_i420 + size, half_width,
+                         dst_i420 + size + half_size, half_width, width,
+                         height, width, height);
+    int ret_opt = MJPGSessionToI420(
+        session_i420, frames[f], frame_sizes[f], dst_i420_opt, width,
+        dst_i420_opt + size, half_width, dst_i420_opt + size + half_size,
+        half_width, width, height, width, height);
+    EXPECT_EQ(ret, ret_opt);
+    if (ret == 0) {
+      EXPECT_EQ(0, memcmp(dst_i420, dst_i420_opt, size + half_size * 2));
+    }
+
+    for (int nv21 = 0; nv21 < 2; ++nv21) {
+      memset(dst_nv, 3, size + half_size * 2);
+      memset(dst_nv_opt, 3, size + half_size * 2);
+      if (nv21) {
+        ret = MJPGToNV21(frames[f], frame_sizes[f], dst_nv, width,
+                         dst_nv + size, half_width * 2, width, height, width,
+                         height);
+        ret_opt = MJPGSessionToNV21(session_nv21, frames[f], frame_sizes[f],
+                                    dst_nv_opt, width, dst_nv_opt + size,
+                                    half_width * 2, width, height, width,
+                                    height);
+      } else {
+        ret = MJPGToNV12(frames[f], frame_sizes[f], dst_nv, width,
+                         dst_nv + size, half_width * 2, width, height, width,
+                         height);
+        ret_opt = MJPGSessionToNV12(session_nv12, frames[f], frame_sizes[f],
+                                    dst_nv_opt, width, dst_nv_opt + size,
+                                    half_width * 2, width, height, width,
+                                    height);
+      }
+      EXPECT_EQ(ret, ret_opt);
+      if (ret == 0) {
+        EXPECT_EQ(0, memcmp(dst_nv, dst_nv_opt, size + half_size * 2));
+      }
+    }
+
+    ret = MJPGToARGB(frames[f], frame_sizes[f], dst_argb, width * 4, width,
+                     height, width, height);
+    ret_opt = MJPGSessionToARGB(session_argb, frames[f], frame_sizes[f],
+                                dst_argb_opt, width * 4, width, height, width,
+                                height);
+    EXPECT_EQ(ret, ret_opt);
+    if (ret == 0) {
+      EXPECT_EQ(0, memcmp(dst_argb, dst_argb_opt, size * 4));
+    }
+
+    free_aligned_buffer_page_end(dst_i420);
+    free_aligned_buffer_page_end(dst_i420_opt);
+    free_aligned_buffer_page_end(dst_nv);
+    free_aligned_buffer_page_end(dst_nv_opt);
+    free_aligned_buffer_page_end(dst_argb);
+    free_aligned_buffer_page_end(dst_argb_opt);
+  }
+  MJPGSessionDestroy(session_i420);
+  MJPGSessionDestroy(session_nv12);
+  MJPGSessionDestroy(session_nv21);
+  MJPGSessionDestroy(session_argb);
+}
+
+// DCT scaled decode gives the frame size divided by the denominator, in the
+// layout that the sub-sampling factors describe.
+TEST_F(LibYUVConvertTest, MJpegDecoderScaleDenom) {
+  const uint8_t* frames[] = {kTest0Jpg, kTest1Jpg, kTest2Jpg, kTest3Jpg};
+  const size_t frame_sizes[] = {kTest0JpgLen, kTest1JpgLen, kTest2JpgLen,
+                                kTest3JpgLen};
+  MJpegDecoder decoder;
+  EXPECT_FALSE(decoder.SetScaleDenom(3));
+  EXPECT_FALSE(decoder.SetScaleDenom(0));
+  for (int f = 0; f < 4; ++f) {
+    for (int scale_denom = 1; scale_denom <= 8; scale_denom *= 2) {
+      ASSERT_TRUE(decoder.SetScaleDenom(scale_denom));
+      ASSERT_TRUE(decoder.LoadFrame(frames[f], frame_sizes[f]));
+      int width = decoder.GetOutputWidth();
+      int height = decoder.GetOutputHeight();
+      EXPECT_EQ((decoder.GetWidth() + scale_denom - 1) / scale_denom, width);
+      EXPECT_EQ((decoder.GetHeight() + scale_denom - 1) / scale_denom, height);
+      uint8_t* planes[3];
+      uint8_t* ends[3];
+      for (int i = 0; i < decoder.GetNumComponents(); ++i) {
+        EXPECT_EQ((width + decoder.GetHorizSubSampFactor(i) - 1) /
+                      decoder.GetHorizSubSampFactor(i),
+                  decoder.GetComponentWidth(i));
+        planes[i] = new uint8_t[decoder.GetComponentSize(i)];
+        ends[i] = planes[i] + decoder.GetComponentSize(i);
+      }
+      uint8_t* starts[3] = {planes[0], planes[1], planes[2]};
+      EXPECT_TRUE(decoder.DecodeToBuffers(planes, width, height));
+      for (int i = 0; i < decoder.GetNumComponents(); ++i) {
+        EXPECT_EQ(ends[i], planes[i]);
+        delete[] starts[i];
+      }
+    }
+  }
+}
+
+TEST_F(LibYUVConvertTest, TestMJPGToI420Scaled) {
+  int width = 0;
+  int height = 0;
+  int ret = MJPGSize(kTest2Jpg, kTest2JpgLen, &width, &height);
+  ASSERT_EQ(0, ret);
+
+  // Full size decodes without scaling.
+  int half_width = (width + 1) / 2;
+  int half_height = (height + 1) / 2;
+  align_buffer_page_end(dst_y, width * height);
+  align_buffer_page_end(dst_u, half_width * half_height);
+  align_buffer_page_end(dst_v, half_width * half_height);
+  ret = MJPGToI420Scaled(kTest2Jpg, kTest2JpgLen, dst_y, width, dst_u,
+                         half_width, dst_v, half_width, width, height, width,
+                         height, kFilterBox);
+  ASSERT_EQ(0, ret);
+  EXPECT_EQ(2682851208u, HashDjb2(dst_y, width * height, 5381));
+  EXPECT_EQ(2501859930u, HashDjb2(dst_u, half_width * half_height, 5381));
+  EXPECT_EQ(2126459123u, HashDjb2(dst_v, half_width * half_height, 5381));
+
+  // A quarter size preview is close to a full decode box filtered down.
+  int dst_width = (width + 3) / 4;
+  int dst_height = (height + 3) / 4;
+  int dst_half_width = (dst_width + 1) / 2;
+  int dst_half_height = (dst_height + 1) / 2;
+  int dst_size = dst_width * dst_height + dst_half_width * dst_half_height * 2;
+  align_buffer_page_end(dst_scaled, dst_size);
+  align_buffer_page_end(dst_scaled_opt, dst_size);
+  uint8_t* dst_scaled_u = dst_scaled + dst_width * dst_height;
+  uint8_t* dst_scaled_v = dst_scaled_u + dst_half_width * dst_half_height;
+  uint8_t* dst_scaled_opt_u = dst_scaled_opt + dst_width * dst_height;
+  uint8_t* dst_scaled_opt_v =
+      dst_scaled_opt_u + dst_half_width * dst_half_height;
+  ASSERT_EQ(0, I420Scale(dst_y, width, dst_u, half_width, dst_v, half_width,
+                         width, height, dst_scaled, dst_width, dst_scaled_u,
+                         dst_half_width, dst_scaled_v, dst_half_width,
+                         dst_width, dst_height, kFilterBox));
+  int benchmark_iterations = benchmark_iterations_ * benchmark_width_ *
+                             benchmark_height_ / (width * height);
+  if (benchmark_iterations < 1) {
+    benchmark_iterations = 1;
+  }
+  for (int times = 0; times < benchmark_iterations; ++times) {
+    ret = MJPGToI420Scaled(kTest2Jpg, kTest2JpgLen, dst_scaled_opt, dst_width,
+                           dst_scaled_opt_u, dst_half_width, dst_scaled_opt_v,
+                           dst_half_width, width, height, dst_width,
+                           dst_height, kFilterBox);
+  }
+  ASSERT_EQ(0, ret);
+  int64_t total_diff = 0;
+  for (int i = 0; i < dst_size; ++i) {
+    total_diff += abs(dst_scaled[i] - dst_scaled_opt[i]);
+  }
+  EXPECT_LE(total_diff, dst_size * 2);
+
+  free_aligned_buffer_page_end(dst_y);
+  free_aligned_buffer_page_end(dst_u);
+  free_aligned_buffer_page_end(dst_v);
+  free_aligned_buffer_page_end(dst_scaled);
+  free_aligned_buffer_page_end(dst_scaled_opt);
+}
+
+// MJPGToNV12Scaled matches MJPGToI420Scaled converted to NV12, for sizes that
+// need DCT scaling only, DCT scaling and the scaler, or only the scaler.
+TEST_F(LibYUVConvertTest, TestMJPGToNV12Scaled) {
+  int width = 0;
+  int height = 0;
+  int ret = MJPGSize(kTest2Jpg, kTest2JpgLen, &width, &height);
+  ASSERT_EQ(0, ret);
+  const int kDivisors[] = {2, 3, 8, 13};
+  for (int d = 0; d < 4; ++d) {
+    int dst_width = (width + kDivisors[d] - 1) / kDivisors[d];
+    int dst_height = (height + kDivisors[d] - 1) / kDivisors[d];
+    if (d == 3) {
+      dst_width = width - 2;
+      dst_height = height - 3;
+    }
+    int dst_half_width = (dst_width + 1) / 2;
+    int dst_half_height = (dst_height + 1) / 2;
+    int size_y = dst_width * dst_height;
+    int size_uv = dst_half_width * dst_half_height;
+    align_buffer_page_end(dst_i420, size_y + size_uv * 2);
+    align_buffer_page_end(dst_nv12, size_y + size_uv * 2);
+    align_buffer_page_end(dst_nv12_opt, size_y + size_uv * 2);
+    ret = MJPGToI420Scaled(kTest2Jpg, kTest2JpgLen, dst_i420, dst_width,
+                           dst_i420 + size_y, dst_half_width,
+                           dst_i420 + size_y + size_uv, dst_half_width, width,
+                           height, dst_width, dst_height, kFilterBilinear);
+    ASSERT_EQ(0, ret);
+    I420ToNV12(dst_i420, dst_width, dst_i420 + size_y, dst_half_width,
+               dst_i420 + size_y + size_uv, dst_half_width, dst_nv12,
+               dst_width, dst_nv12 + size_y, dst_half_width * 2, dst_width,
+               dst_height);
+    ret = MJPGToNV12Scaled(kTest2Jpg, kTest2JpgLen, dst_nv12_opt, dst_width,
+                           dst_nv12_opt + size_y, dst_half_width * 2, width,
+                           height, dst_width, dst_height, kFilterBilinear);
+    ASSERT_EQ(0, ret);
+    EXPECT_EQ(0, memcmp(dst_nv12, dst_nv12_opt, size_y + size_uv * 2));
+    free_aligned_buffer_page_end(dst_i420);
+    free_aligned_buffer_page_end(dst_nv12);
+    free_aligned_buffer_page_end(dst_nv12_opt);
+  }
+  // Unexpected source size.
+  uint8_t dst[16 * 16 * 2];
+  EXPECT_EQ(1, MJPGToNV12Scaled(kTest2Jpg, kTest2JpgLen, dst, 16, dst + 256,
+                                16, width + 1, height, 16, 16,
+                                kFilterBilinear));
+  EXPECT_EQ(-1, MJPGToNV12Scaled(kTest2Jpg, kTest2JpgLen, dst, 16, NULL, 16,
+                                 width, height, 16, 16, kFilterBilinear));
+}
+
+// Executor that runs jobs on 4 threads, each taking the next job index until
+// none are left.
+static void ThreadedExecutor(void* executor_context,
+                             ScaleJobFunc job,
+                             void* job_context,
+                             int count) {
+  std::atomic<int> next(0);
+  (void)executor_context;
+  auto worker = [&]() {
+    for (int i = next++; i < count; i = next++) {
+      job(job_context, i);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 3; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+// Encode a noisy frame with a restart marker after every MCU row.
+// Subsampling is 1 for J400, 2 for J422 or 3 for J420.
+static std::vector<uint8_t> EncodeRestartJpeg(int width,
+                                              int height,
+                                              int subsampling) {
+  jpeg_compress_struct cinfo;
+  jpeg_error_mgr jerr;
+  cinfo.err = jpeg_std_error(&jerr);
+  jpeg_create_compress(&cinfo);
+  unsigned char* jpeg = NULL;
+  unsigned long jpeg_size = 0;  // NOLINT
+  jpeg_mem_dest(&cinfo, &jpeg, &jpeg_size);
+  cinfo.image_width = width;
+  cinfo.image_height = height;
+  cinfo.input_components = subsampling == 1 ? 1 : 3;
+  cinfo.in_color_space = subsampling == 1 ? JCS_GRAYSCALE : JCS_RGB;
+  jpeg_set_defaults(&cinfo);
+  if (subsampling == 2) {
+    cinfo.comp_info[0].v_samp_factor = 1;
+  }
+  cinfo.restart_in_rows = 1;
+  jpeg_set_quality(&cinfo, 90, TRUE);
+  jpeg_start_compress(&cinfo, TRUE);
+  std::vector<uint8_t> row(width * cinfo.input_components);
+  for (int y = 0; y < height; ++y) {
+    for (size_t x = 0; x < row.size(); ++x) {
+      row[x] = static_cast<uint8_t>((x + y * 3) ^ (fastrand() & 31));
+    }
+    JSAMPROW rows[1] = {row.data()};
+    jpeg_write_scanlines(&cinfo, rows, 1);
+  }
+  jpeg_finish_compress(&cinfo);
+  jpeg_destroy_compress(&cinfo);
+  std::vector<uint8_t> result(jpeg, jpeg + jpeg_size);
+  free(jpeg);
+  return result;
+}
+
+struct RestartCallbackFrame {
+  int num_components;
+  uint8_t* planes[3];
+  int widths[3];
+  int subsample_y[3];
+};
+
+// Append the rows passed to the callback to planes.
+static void RestartCallback(void* opaque,
+                            const uint8_t* const* data,
+                            const int* strides,
+                            int rows) {
+  RestartCallbackFrame* frame = static_cast<RestartCallbackFrame*>(opaque);
+  for (int i = 0; i < frame->num_components; ++i) {
+    int component_rows =
+        (rows + frame->subsample_y[i] - 1) / frame->subsample_y[i];
+    CopyPlane(data[i], strides[i], frame->planes[i], frame->widths[i],
+              frame->widths[i], component_rows);
+    frame->planes[i] += component_rows * frame->widths[i];
+  }
+}
+
+// Decode with and without restart interval jobs and compare the output of
+// DecodeToBuffers and DecodeToCallback, cropped to dst_height.
+static void TestMJpegDecoderRestart(const std::vector<uint8_t>& jpeg,
+                                    int scale_denom,
+                                    int dst_height,
+                                    int benchmark_iterations) {
+  MJpegDecoder decoder;
+  MJpegDecoder decoder_mt;
+  decoder.SetScaleDenom(scale_denom);
+  decoder_mt.SetScaleDenom(scale_denom);
+  decoder_mt.SetExecutor(&ThreadedExecutor, NULL, 4);
+  ASSERT_TRUE(decoder.LoadFrame(jpeg.data(), jpeg.size()));
+  EXPECT_EQ(0, decoder.GetNumRestartSegments());
+  int width = decoder.GetOutputWidth();
+  int num_components = decoder.GetNumComponents();
+  decoder.UnloadFrame();
+  int sizes[3];
+  align_buffer_page_end(dst, width * dst_height * 3);
+  align_buffer_page_end(dst_mt, width * dst_height * 3);
+  memset(dst, 1, width * dst_height * 3);
+  memset(dst_mt, 2, width * dst_height * 3);
+
+  for (int callback = 0; callback < 2; ++callback) {
+    for (int mt = 0; mt < 2; ++mt) {
+      MJpegDecoder* d = mt ? &decoder_mt : &decoder;
+      uint8_t* frame = mt ? dst_mt : dst;
+      for (int n = 0; n < (mt ? benchmark_iterations : 1); ++n) {
+        ASSERT_TRUE(d->LoadFrame(jpeg.data(), jpeg.size()));
+        if (mt) {
+          int imcu_lines = d->GetImageScanlinesPerImcuRow();
+          EXPECT_EQ((d->GetOutputHeight() + imcu_lines - 1) / imcu_lines,
+                    d->GetNumRestartSegments());
+        }
+        RestartCallbackFrame planes;
+        planes.num_components = num_components;
+        uint8_t* data = frame;
+        for (int i = 0; i < num_components; ++i) {
+          planes.planes[i] = data;
+          planes.widths[i] = d->GetComponentWidth(i);
+          planes.subsample_y[i] = d->GetVertSubSampFactor(i);
+          sizes[i] = planes.widths[i] *
+                     ((dst_height + planes.subsample_y[i] - 1) /
+                      planes.subsample_y[i]);
+          data += sizes[i];
+        }
+        if (callback) {
+          ASSERT_TRUE(d->DecodeToCallback(&RestartCallback, &planes, width,
+                                          dst_height));
+        } else {
+          ASSERT_TRUE(d->DecodeToBuffers(planes.planes, width, dst_height));
+        }
+        // Plane pointers advance past the rows written.
+        data = frame;
+        for (int i = 0; i < num_components; ++i) {
+          data += sizes[i];
+          EXPECT_EQ(data, planes.planes[i]);
+        }
+        d->UnloadFrame();
+      }
+    }
+    int size = 0;
+    for (int i = 0; i < num_components; ++i) {
+      size += sizes[i];
+    }
+    EXPECT_EQ(0, memcmp(dst, dst_mt, size));
+  }
+  free_aligned_buffer_page_end(dst);
+  free_aligned_buffer_page_end(dst_mt);
+}
+
+TEST_F(LibYUVConvertTest, MJpegDecoderRestart_J420) {
+  std::vector<uint8_t> jpeg = EncodeRestartJpeg(
+      benchmark_width_, benchmark_height_, 3);
+  TestMJpegDecoderRestart(jpeg, 1, benchmark_height_, benchmark_iterations_);
+}
+
+TEST_F(LibYUVConvertTest, MJpegDecoderRestart_J422) {
+  std::vector<uint8_t> jpeg = EncodeRestartJpeg(
+      benchmark_width_, benchmark_height_, 2);
+  TestMJpegDecoderRestart(jpeg, 1, benchmark_height_, benchmark_iterations_);
+}
+
+TEST_F(LibYUVConvertTest, MJpegDecoderRestart_J400) {
+  std::vector<uint8_t> jpeg = EncodeRestartJpeg(
+      benchmark_width_, benchmark_height_, 1);
+  TestMJpegDecoderRestart(jpeg, 1, benchmark_height_, benchmark_iterations_);
+}
+
+TEST_F(LibYUVConvertTest, MJpegDecoderRestart_Crop) {
+  std::vector<uint8_t> jpeg = EncodeRestartJpeg(641, 483, 3);
+  TestMJpegDecoderRestart(jpeg, 1, 483, 1);
+  TestMJpegDecoderRestart(jpeg, 1, 479, 1);
+  TestMJpegDecoderRestart(jpeg, 1, 443, 1);
+  TestMJpegDecoderRestart(jpeg, 1, 95, 1);
+}
+
+TEST_F(LibYUVConvertTest, MJpegDecoderRestart_Scaled) {
+  std::vector<uint8_t> jpeg = EncodeRestartJpeg(641, 483, 3);
+  TestMJpegDecoderRestart(jpeg, 2, 242, 1);
+  TestMJpegDecoderRestart(jpeg, 2, 200, 1);
+  TestMJpegDecoderRestart(jpeg, 4, 121, 1);
+  TestMJpegDecoderRestart(jpeg, 8, 61, 1);
+  jpeg = EncodeRestartJpeg(320, 240, 2);
+  TestMJpegDecoderRestart(jpeg, 2, 120, 1);
+}
+
+// Frames without restart markers decode sequentially with an executor set.
+TEST_F(LibYUVConvertTest, MJpegDecoderRestart_None) {
+  MJpegDecoder decoder;
+  decoder.SetExecutor(&ThreadedExecutor, NULL, 4);
+  ASSERT_TRUE(decoder.LoadFrame(kTest2Jpg, kTest2JpgLen));
+  EXPECT_EQ(0, decoder.GetNumRestartSegments());
+  decoder.UnloadFrame();
+  std::vector<uint8_t> jpeg = EncodeRestartJpeg(64, 16, 3);
+  ASSERT_TRUE(decoder.LoadFrame(jpeg.data(), jpeg.size()));
+  EXPECT_EQ(0, decoder.GetNumRestartSegments());  // Only one iMCU row.
+  decoder.UnloadFrame();
+}
+
+// Decode a rectangle with MJPGToI420Crop and compare it to the same rectangle
+// of a full MJPGToI420 decode. crop_x and crop_y must be even.
+static void TestMJPGToI420Crop(const std::vector<uint8_t>& jpeg,
+                               int width,
+                               int height,
+                               int crop_x,
+                               int crop_y,
+                               int crop_width,
+                               int crop_height,
+                               int iterations) {
+  int half_width = (width + 1) / 2;
+  int half_height = (height + 1) / 2;
+  int size_y = width * height;
+  int size_uv = half_width * half_height;
+  align_buffer_page_end(dst, size_y + size_uv * 2);
+  ASSERT_EQ(0, MJPGToI420(jpeg.data(), jpeg.size(), dst, width, dst + size_y,
+                          half_width, dst + size_y + size_uv, half_width,
+                          width, height, width, height));
+
+  int crop_half_width = (crop_width + 1) / 2;
+  int crop_half_height = (crop_height + 1) / 2;
+  int crop_size_y = crop_width * crop_height;
+  int crop_size_uv = crop_half_width * crop_half_height;
+  align_buffer_page_end(dst_crop, crop_size_y + crop_size_uv * 2);
+  uint8_t* dst_crop_u = dst_crop + crop_size_y;
+  uint8_t* dst_crop_v = dst_crop_u + crop_size_uv;
+  int ret = 0;
+  for (int i = 0; i < iterations; ++i) {
+    ret = MJPGToI420Crop(jpeg.data(), jpeg.size(), dst_crop, crop_width,
+                         dst_crop_u, crop_half_width, dst_crop_v,
+                         crop_half_width, width, height, crop_x, crop_y,
+                         crop_width, crop_height);
+  }
+  ASSERT_EQ(0, ret);
+
+  for (int y = 0; y < crop_height; ++y) {
+    ASSERT_EQ(0, memcmp(dst + (crop_y + y) * width + crop_x,
+                        dst_crop + y * crop_width, crop_width))
+        << "row " << y;
+  }
+  for (int y = 0; y < crop_half_height; ++y) {
+    int offset = (crop_y / 2 + y) * half_width + crop_x / 2;
+    ASSERT_EQ(0, memcmp(dst + size_y + offset,
+                        dst_crop_u + y * crop_half_width, crop_half_width))
+        << "u row " << y;
+    ASSERT_EQ(0, memcmp(dst + size_y + size_uv + offset,
+                        dst_crop_v + y * crop_half_width, crop_half_width))
+        << "v row " << y;
+  }
+  free_aligned_buffer_page_end(dst);
+  free_aligned_buffer_page_end(dst_crop);
+}
+
+TEST_F(LibYUVConvertTest, MJPGToI420Crop_J420) {
+  std::vector<uint8_t> jpeg = EncodeRestartJpeg(641, 483, 3);
+  TestMJPGToI420Crop(jpeg, 641, 483, 0, 0, 641, 483, 1);
+  TestMJPGToI420Crop(jpeg, 641, 483, 160, 120, 320, 240, 1);
+  TestMJPGToI420Crop(jpeg, 641, 483, 0, 0, 33, 17, 1);
+  TestMJPGToI420Crop(jpeg, 641, 483, 600, 440, 41, 43, 1);
+  TestMJPGToI420Crop(jpeg, 641, 483, 2, 478, 5, 1, 1);
+}
+
+TEST_F(LibYUVConvertTest, MJPGToI420Crop_J422) {
+  std::vector<uint8_t> jpeg = EncodeRestartJpeg(320, 240, 2);
+  TestMJPGToI420Crop(jpeg, 320, 240, 0, 0, 320, 240, 1);
+  // J422 chroma is halved vertically per callback, which is only exact for
+  // even row counts, so keep the height even.
+  TestMJPGToI420Crop(jpeg, 320, 240, 18, 34, 101, 62, 1);
+}
+
+TEST_F(LibYUVConvertTest, MJPGToI420Crop_J400) {
+  std::vector<uint8_t> jpeg = EncodeRestartJpeg(320, 240, 1);
+  TestMJPGToI420Crop(jpeg, 320, 240, 0, 0, 320, 240, 1);
+  TestMJPGToI420Crop(jpeg, 320, 240, 98, 76, 121, 99, 1);
+}
+
+// Decode time scales with the area of the rectangle: compare the timing of
+// the full frame, the centre quarter and the centre sixteenth.
+TEST_F(LibYUVConvertTest, MJPGToI420Crop_Full) {
+  std::vector<uint8_t> jpeg =
+      EncodeRestartJpeg(benchmark_width_, benchmark_height_, 3);
+  TestMJPGToI420Crop(jpeg, benchmark_width_, benchmark_height_, 0, 0,
+                     benchmark_width_, benchmark_height_,
+                     benchmark_iterations_);
+}
+
+TEST_F(LibYUVConvertTest, MJPGToI420Crop_Quarter) {
+  std::vector<uint8_t> jpeg =
+      EncodeRestartJpeg(benchmark_width_, benchmark_height_, 3);
+  int crop_width = (benchmark_width_ + 1) / 2;
+  int crop_height = (benchmark_height_ + 1) / 2;
+  TestMJPGToI420Crop(jpeg, benchmark_width_, benchmark_height_,
+                     ((benchmark_width_ - crop_width) / 2) & ~1,
+                     ((benchmark_height_ - crop_height) / 2) & ~1, crop_width,
+                     crop_height, benchmark_iterations_);
+}
+
+TEST_F(LibYUVConvertTest, MJPGToI420Crop_Sixteenth) {
+  std::vector<uint8_t> jpeg =
+      EncodeRestartJpeg(benchmark_width_, benchmark_height_, 3);
+  int crop_width = (benchmark_width_ + 3) / 4;
+  int crop_height = (benchmark_height_ + 3) / 4;
+  TestMJPGToI420Crop(jpeg, benchmark_width_, benchmark_height_,
+                     ((benchmark_width_ - crop_width) / 2) & ~1,
+                     ((benchmark_height_ - crop_height) / 2) & ~1, crop_width,
+                     crop_height, benchmark_iterations_);
+}
+
+// MJPGToNV12Crop and MJPGToARGBCrop match the same rectangle of a full decode.
+TEST_F(LibYUVConvertTest, MJPGToNV12Crop) {
+  const int kWidth = 320;
+  const int kHeight = 240;
+  const int kCropX = 44;
+  const int kCropY = 62;
+  const int kCropWidth = 155;
+  const int kCropHeight = 101;
+  const int kHalfWidth = (kWidth + 1) / 2;
+  const int kCropHalfWidth = (kCropWidth + 1) / 2;
+  const int kCropHalfHeight = (kCropHeight + 1) / 2;
+  std::vector<uint8_t> jpeg = EncodeRestartJpeg(kWidth, kHeight, 3);
+  align_buffer_page_end(dst, kWidth * kHeight + kHalfWidth * 2 * kHeight);
+  align_buffer_page_end(dst_crop, kCropWidth * kCropHeight +
+                                      kCropHalfWidth * 2 * kCropHalfHeight);
+  uint8_t* dst_uv = dst + kWidth * kHeight;
+  uint8_t* dst_crop_uv = dst_crop + kCropWidth * kCropHeight;
+  ASSERT_EQ(0, MJPGToNV12(jpeg.data(), jpeg.size(), dst, kWidth, dst_uv,
+                          kHalfWidth * 2, kWidth, kHeight, kWidth, kHeight));
+  ASSERT_EQ(0, MJPGToNV12Crop(jpeg.data(), jpeg.size(), dst_crop, kCropWidth,
+                              dst_crop_uv, kCropHalfWidth * 2, kWidth,
+                              kHeight, kCropX, kCropY, kCropWidth,
+                              kCropHeight));
+  for (int y = 0; y < kCropHeight; ++y) {
+    ASSERT_EQ(0, memcmp(dst + (kCropY + y) * kWidth + kCropX,
+                        dst_crop + y * kCropWidth, kCropWidth));
+  }
+  for (int y = 0; y < kCropHalfHeight; ++y) {
+    ASSERT_EQ(0, memcmp(dst_uv + (kCropY / 2 + y) * kHalfWidth * 2 + kCropX,
+                        dst_crop_uv + y * kCropHalfWidth * 2,
+                        kCropHalfWidth * 2));
+  }
+  EXPECT_EQ(-1, MJPGToNV12Crop(jpeg.data(), jpeg.size(), dst_crop, kCropWidth,
+                               dst_crop_uv, kCropHalfWidth * 2, kWidth,
+                               kHeight, kWidth - kCropWidth + 2, 0,
+                               kCropWidth, kCropHeight));
+  EXPECT_EQ(1, MJPGToNV12Crop(jpeg.data(), jpeg.size(), dst_crop, kCropWidth,
+                              dst_crop_uv, kCropHalfWidth * 2, kWidth + 2,
+                              kHeight, kCropX, kCropY, kCropWidth,
+                              kCropHeight));
+  free_aligned_buffer_page_end(dst);
+  free_aligned_buffer_page_end(dst_crop);
+}
+
+TEST_F(LibYUVConvertTest, MJPGToARGBCrop) {
+  const int kWidth = 320;
+  const int kHeight = 240;
+  const int kCropX = 36;
+  const int kCropY = 20;
+  const int kCropWidth = 171;
+  const int kCropHeight = 97;
+  std::vector<uint8_t> jpeg = EncodeRestartJpeg(kWidth, kHeight, 3);
+  align_buffer_page_end(dst, kWidth * kHeight * 4);
+  align_buffer_page_end(dst_crop, kCropWidth * kCropHeight * 4);
+  ASSERT_EQ(0, MJPGToARGB(jpeg.data(), jpeg.size(), dst, kWidth * 4, kWidth,
+                          kHeight, kWidth, kHeight));
+  ASSERT_EQ(0, MJPGToARGBCrop(jpeg.data(), jpeg.size(), dst_crop,
+                              kCropWidth * 4, kWidth, kHeight, kCropX, kCropY,
+                              kCropWidth, kCropHeight));
+  for (int y = 0; y < kCropHeight; ++y) {
+    ASSERT_EQ(0, memcmp(dst + (kCropY + y) * kWidth * 4 + kCropX * 4,
+                        dst_crop + y * kCropWidth * 4, kCropWidth * 4));
+  }
+  free_aligned_buffer_page_end(dst);
+  free_aligned_buffer_page_end(dst_crop);
+}
 #endif  // HAVE_JPEG
 
 TEST_F(LibYUVConvertTest, NV12Crop) {
@@ -1955,6 +2625,246 @@ TEST_F(LibYUVConvertTest, I420CropOddY) {
   free_aligned_buffer_page_end(src_y);
 }
 
+// Rotating a fourcc without a one pass rotator through caller scratch.
+TEST_F(LibYUVConvertTest, ConvertToI420Scratch) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kHalfWidth = (kWidth + 1) / 2;
+  const int kHalfHeight = (kHeight + 1) / 2;
+  const int kSampleSize = kHalfWidth * 4 * kHeight;
+  align_buffer_page_end(src_yuy2, kSampleSize);
+  align_buffer_page_end(dst_c, kWidth * kHeight + kHalfWidth * kHalfHeight * 2);
+  align_buffer_page_end(dst_opt,
+                        kWidth * kHeight + kHalfWidth * kHalfHeight * 2);
+  MemRandomize(src_yuy2, kSampleSize);
+
+  // Rotated by 90 the I420 destination is kHeight wide.
+  const int kDstHalfWidth = (kHeight + 1) / 2;
+  uint8_t* dst_c_u = dst_c + kWidth * kHeight;
+  uint8_t* dst_c_v = dst_c_u + kDstHalfWidth * kHalfWidth;
+  uint8_t* dst_opt_u = dst_opt + kWidth * kHeight;
+  uint8_t* dst_opt_v = dst_opt_u + kDstHalfWidth * kHalfWidth;
+  const int scratch_size = ConvertToI420ScratchSize(kWidth, kHeight);
+  EXPECT_EQ(kWidth * kHeight + kHalfWidth * kHalfHeight * 2, scratch_size);
+  EXPECT_EQ(-1, ConvertToI420ScratchSize(0, kHeight));
+  align_buffer_page_end(scratch, scratch_size);
+
+  EXPECT_EQ(0, ConvertToI420(src_yuy2, kSampleSize, dst_c, kHeight, dst_c_u,
+                             kDstHalfWidth, dst_c_v, kDstHalfWidth, 0, 0,
+                             kWidth, kHeight, kWidth, kHeight, kRotate90,
+                             FOURCC_YUY2));
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    EXPECT_EQ(0, ConvertToI420Scratch(
+                     src_yuy2, kSampleSize, dst_opt, kHeight, dst_opt_u,
+                     kDstHalfWidth, dst_opt_v, kDstHalfWidth, 0, 0, kWidth,
+                     kHeight, kWidth, kHeight, kRotate90, FOURCC_YUY2, scratch,
+                     scratch_size));
+  }
+  for (int i = 0; i < kWidth * kHeight + kDstHalfWidth * kHalfWidth * 2; ++i) {
+    ASSERT_EQ(dst_c[i], dst_opt[i]);
+  }
+  EXPECT_EQ(-1, ConvertToI420Scratch(
+                    src_yuy2, kSampleSize, dst_opt, kHeight, dst_opt_u,
+                    kDstHalfWidth, dst_opt_v, kDstHalfWidth, 0, 0, kWidth,
+                    kHeight, kWidth, kHeight, kRotate90, FOURCC_YUY2, scratch,
+                    scratch_size - 1));
+
+  free_aligned_buffer_page_end(scratch);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+  free_aligned_buffer_page_end(src_yuy2);
+}
+
+// Bytes of a src_width by src_height sample of a fourcc.
+static int CropScaleSampleSize(uint32_t fourcc, int width, int height) {
+  const int halfwidth = (width + 1) / 2;
+  const int halfheight = (height + 1) / 2;
+  switch (fourcc) {
+    case FOURCC_YUY2:
+      return halfwidth * 4 * height;
+    case FOURCC_24BG:
+      return width * 3 * height;
+    case FOURCC_ARGB:
+      return width * 4 * height;
+    default:  // I420 and NV12.
+      return width * height + halfwidth * halfheight * 2;
+  }
+}
+
+// ConvertCropScale against ConvertToI420, I420Scale and a conversion from
+// I420.  The destination is one buffer with the planes of dst_fourcc.
+static void TestConvertCropScale(int width,
+                                 int height,
+                                 uint32_t src_fourcc,
+                                 int crop_x,
+                                 int crop_y,
+                                 int crop_width,
+                                 int crop_height,
+                                 int dst_width,
+                                 int dst_height,
+                                 FilterMode filtering,
+                                 uint32_t dst_fourcc,
+                                 int benchmark_iterations) {
+  const int abs_height = height < 0 ? -height : height;
+  const int sample_size = CropScaleSampleSize(src_fourcc, width, abs_height);
+  const int crop_halfwidth = (crop_width + 1) / 2;
+  const int crop_halfheight = (crop_height + 1) / 2;
+  const int dst_halfwidth = (dst_width + 1) / 2;
+  const int dst_halfheight = (dst_height + 1) / 2;
+  const int dst_size = dst_width * dst_height * 4;
+  align_buffer_page_end(sample, sample_size);
+  align_buffer_page_end(crop_i420, crop_width * crop_height +
+                                       crop_halfwidth * crop_halfheight * 2);
+  align_buffer_page_end(scale_i420, dst_width * dst_height +
+                                        dst_halfwidth * dst_halfheight * 2);
+  align_buffer_page_end(dst_c, dst_size);
+  align_buffer_page_end(dst_opt, dst_size);
+  MemRandomize(sample, sample_size);
+  memset(dst_c, 1, dst_size);
+  memset(dst_opt, 2, dst_size);
+
+  uint8_t* crop_u = crop_i420 + crop_width * crop_height;
+  uint8_t* crop_v = crop_u + crop_halfwidth * crop_halfheight;
+  uint8_t* scale_u = scale_i420 + dst_width * dst_height;
+  uint8_t* scale_v = scale_u + dst_halfwidth * dst_halfheight;
+  EXPECT_EQ(0, ConvertToI420(sample, sample_size, crop_i420, crop_width,
+                             crop_u, crop_halfwidth, crop_v, crop_halfwidth,
+                             crop_x, crop_y, width, height, crop_width,
+                             crop_height, kRotate0, src_fourcc));
+  EXPECT_EQ(0, I420Scale(crop_i420, crop_width, crop_u, crop_halfwidth, crop_v,
+                         crop_halfwidth, crop_width, crop_height, scale_i420,
+                         dst_width, scale_u, dst_halfwidth, scale_v,
+                         dst_halfwidth, dst_width, dst_height, filtering));
+
+  // Planes of the destination buffer.
+  uint8_t* dst_c_u = dst_c + dst_width * dst_height;
+  uint8_t* dst_c_v = dst_c_u + dst_halfwidth * dst_halfheight;
+  uint8_t* dst_opt_u = dst_opt + dst_width * dst_height;
+  uint8_t* dst_opt_v = dst_opt_u + dst_halfwidth * dst_halfheight;
+  int dst_stride_y = dst_width;
+  switch (dst_fourcc) {
+    case FOURCC_I420:
+      I420Copy(scale_i420, dst_width, scale_u, dst_halfwidth, scale_v,
+               dst_halfwidth, dst_c, dst_width, dst_c_u, dst_halfwidth,
+               dst_c_v, dst_halfwidth, dst_width, dst_height);
+      break;
+    case FOURCC_NV12:
+      I420ToNV12(scale_i420, dst_width, scale_u, dst_halfwidth, scale_v,
+                 dst_halfwidth, dst_c, dst_width, dst_c_u, dst_halfwidth * 2,
+                 dst_width, dst_height);
+      break;
+    default:  // ARGB.
+      dst_stride_y = dst_width * 4;
+      I420ToARGB(scale_i420, dst_width, scale_u, dst_halfwidth, scale_v,
+                 dst_halfwidth, dst_c, dst_stride_y, dst_width, dst_height);
+      break;
+  }
+  const int dst_stride_u =
+      dst_fourcc == FOURCC_NV12 ? dst_halfwidth * 2 : dst_halfwidth;
+  const int compare_size =
+      dst_fourcc == FOURCC_ARGB
+          ? dst_size
+          : dst_width * dst_height + dst_halfwidth * dst_halfheight * 2;
+
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    EXPECT_EQ(0, ConvertCropScale(sample, sample_size, width, height,
+                                  src_fourcc, crop_x, crop_y, crop_width,
+                                  crop_height, dst_opt, dst_stride_y,
+                                  dst_opt_u, dst_stride_u, dst_opt_v,
+                                  dst_halfwidth, dst_width, dst_height,
+                                  filtering, dst_fourcc));
+  }
+  for (int i = 0; i < compare_size; ++i) {
+    ASSERT_EQ(dst_c[i], dst_opt[i]) << "offset " << i;
+  }
+
+  // Again with caller scratch.
+  const int scratch_size = ConvertCropScaleScratchSize(
+      width, height, src_fourcc, crop_width, crop_height, dst_width,
+      dst_height, filtering, dst_fourcc);
+  ASSERT_GT(scratch_size, 0);
+  align_buffer_page_end(scratch, scratch_size);
+  memset(dst_opt, 2, dst_size);
+  EXPECT_EQ(0, ConvertCropScaleScratch(
+                   sample, sample_size, width, height, src_fourcc, crop_x,
+                   crop_y, crop_width, crop_height, dst_opt, dst_stride_y,
+                   dst_opt_u, dst_stride_u, dst_opt_v, dst_halfwidth,
+                   dst_width, dst_height, filtering, dst_fourcc, scratch,
+                   scratch_size));
+  for (int i = 0; i < compare_size; ++i) {
+    ASSERT_EQ(dst_c[i], dst_opt[i]) << "offset " << i;
+  }
+  EXPECT_EQ(-1, ConvertCropScaleScratch(
+                    sample, sample_size, width, height, src_fourcc, crop_x,
+                    crop_y, crop_width, crop_height, dst_opt, dst_stride_y,
+                    dst_opt_u, dst_stride_u, dst_opt_v, dst_halfwidth,
+                    dst_width, dst_height, filtering, dst_fourcc, scratch,
+                    scratch_size - 1));
+  free_aligned_buffer_page_end(scratch);
+
+  free_aligned_buffer_page_end(sample);
+  free_aligned_buffer_page_end(crop_i420);
+  free_aligned_buffer_page_end(scale_i420);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+}
+
+// Crop from (CROP_X, CROP_Y) to 2 pixels from the right and bottom, and scale
+// by DST_NUM / DST_DEN.
+#define TESTCROPSCALE(NAME, SRC_FOURCC, INVERT, CROP_X, CROP_Y, DST_NUM,      \
+                      DST_DEN, FILTER, DST_FOURCC)                            \
+  TEST_F(LibYUVConvertTest, ConvertCropScale##NAME) {                         \
+    const int kWidth = benchmark_width_ + 8;                                  \
+    const int kHeight = benchmark_height_ + 8;                                \
+    const int kCropWidth = kWidth - (CROP_X) - 2;                             \
+    const int kCropHeight = kHeight - (CROP_Y) - 2;                           \
+    TestConvertCropScale(kWidth, (INVERT) ? -kHeight : kHeight, SRC_FOURCC,   \
+                         CROP_X, CROP_Y, kCropWidth, kCropHeight,             \
+                         kCropWidth * (DST_NUM) / (DST_DEN),                  \
+                         kCropHeight * (DST_NUM) / (DST_DEN), FILTER,         \
+                         DST_FOURCC, benchmark_iterations_);                  \
+  }
+
+TESTCROPSCALE(YUY2ToI420Box, FOURCC_YUY2, 0, 3, 2, 1, 2, kFilterBox,
+              FOURCC_I420)
+TESTCROPSCALE(YUY2ToNV12Bilinear, FOURCC_YUY2, 0, 2, 4, 3, 4,
+              kFilterBilinear, FOURCC_NV12)
+TESTCROPSCALE(ARGBToNV12Box, FOURCC_ARGB, 0, 1, 1, 2, 5, kFilterBox,
+              FOURCC_NV12)
+TESTCROPSCALE(ARGBToARGBLinear, FOURCC_ARGB, 0, 4, 2, 3, 8, kFilterLinear,
+              FOURCC_ARGB)
+TESTCROPSCALE(RGB24InvertToI420Bilinear, FOURCC_24BG, 1, 2, 2, 2, 3,
+              kFilterBilinear, FOURCC_I420)
+TESTCROPSCALE(RGB24InvertToARGBNone, FOURCC_24BG, 1, 1, 3, 1, 4, kFilterNone,
+              FOURCC_ARGB)
+TESTCROPSCALE(I420ToARGBUp, FOURCC_I420, 0, 2, 2, 5, 3, kFilterBilinear,
+              FOURCC_ARGB)
+TESTCROPSCALE(I420ToI420Box, FOURCC_I420, 0, 3, 1, 1, 3, kFilterBox,
+              FOURCC_I420)
+TESTCROPSCALE(NV12ToNV12Up2, FOURCC_NV12, 0, 2, 2, 2, 1, kFilterBilinear,
+              FOURCC_NV12)
+TESTCROPSCALE(NV12ToARGBCopy, FOURCC_NV12, 0, 2, 2, 1, 1, kFilterBox,
+              FOURCC_ARGB)
+
+TEST_F(LibYUVConvertTest, ConvertCropScaleInvalid) {
+  uint8_t sample[64 * 4 * 16];
+  uint8_t dst[32 * 4 * 8];
+  memset(sample, 0, sizeof(sample));
+  EXPECT_EQ(0, ConvertCropScale(sample, sizeof(sample), 64, 16, FOURCC_ARGB,
+                                0, 0, 64, 16, dst, 32 * 4, NULL, 0, NULL, 0,
+                                32, 8, kFilterBox, FOURCC_ARGB));
+  // Unsupported destination, missing chroma and a crop outside the source.
+  EXPECT_EQ(-1, ConvertCropScale(sample, sizeof(sample), 64, 16, FOURCC_ARGB,
+                                 0, 0, 64, 16, dst, 32 * 4, NULL, 0, NULL, 0,
+                                 32, 8, kFilterBox, FOURCC_RGBA));
+  EXPECT_EQ(-1, ConvertCropScale(sample, sizeof(sample), 64, 16, FOURCC_ARGB,
+                                 0, 0, 64, 16, dst, 32, NULL, 0, NULL, 0, 32,
+                                 8, kFilterBox, FOURCC_NV12));
+  EXPECT_EQ(-1, ConvertCropScale(sample, sizeof(sample), 64, 16, FOURCC_ARGB,
+                                 2, 0, 64, 16, dst, 32 * 4, NULL, 0, NULL, 0,
+                                 32, 8, kFilterBox, FOURCC_ARGB));
+}
+
 #define TESTPTOB(NAME, UYVYTOI420, UYVYTONV12)                                \
   TEST_F(LibYUVConvertTest, NAME) {                                           \
     const int kWidth = benchmark_width_;                                      \
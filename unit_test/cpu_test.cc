@@ -22,6 +22,10 @@
 #include "libyuv/cpu_id.h"
 #include "libyuv/version.h"
 
+#ifdef ENABLE_ROW_TESTS
+#include "libyuv/row_dispatch.h"
+#endif
+
 namespace libyuv {
 
 #if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || \
@@ -426,4 +430,75 @@ TEST_F(LibYUVBaseTest, MAYBE_TestSetCpuFlags) {
   MaskCpuFlags(benchmark_cpu_info_);
 }
 
+#ifdef ENABLE_ROW_TESTS
+// The row dispatch table follows the cpu flags set with MaskCpuFlags.
+TEST_F(LibYUVBaseTest, TestRowDispatch) {
+  struct RowDispatch c_dispatch;
+  ResolveRowDispatch(&c_dispatch, kCpuInitialized);
+  EXPECT_EQ(kCpuInitialized, c_dispatch.cpu_info);
+  EXPECT_TRUE(c_dispatch.I422ToARGBRow.any == I422ToARGBRow_C);
+  EXPECT_TRUE(c_dispatch.I422ToARGBRow.full == I422ToARGBRow_C);
+  EXPECT_TRUE(c_dispatch.TransposeWxH == NULL);
+  EXPECT_TRUE(c_dispatch.ScaleRowDown2[SCALEROWDOWN2_BOX].any ==
+              ScaleRowDown2Box_C);
+  EXPECT_TRUE(c_dispatch.InterpolateRow.full == InterpolateRow_C);
+  EXPECT_TRUE(c_dispatch.ScaleFilterCols.full == ScaleFilterCols_C);
+  EXPECT_TRUE(c_dispatch.ScaleARGBFilterCols.full == ScaleARGBFilterCols_C);
+  EXPECT_TRUE(c_dispatch.ScaleARGBRowDown2[SCALEROWDOWN2_NONE].any ==
+              ScaleARGBRowDown2_C);
+  EXPECT_TRUE(c_dispatch.ScaleUVRowDown2[SCALEROWDOWN2_LINEAR].any ==
+              ScaleUVRowDown2Linear_C);
+
+  MaskCpuFlags(1);
+  const struct RowDispatch* dispatch = GetRowDispatch();
+  EXPECT_EQ(TestCpuFlag(-1), dispatch->cpu_info);
+  EXPECT_TRUE(ROW_KERNEL(dispatch->I422ToARGBRow, 64) == I422ToARGBRow_C);
+
+  MaskCpuFlags(benchmark_cpu_info_);
+  dispatch = GetRowDispatch();
+  EXPECT_EQ(TestCpuFlag(-1), dispatch->cpu_info);
+  struct RowDispatch expected;
+  ResolveRowDispatch(&expected, TestCpuFlag(-1));
+  EXPECT_TRUE(dispatch->I422ToARGBRow.any == expected.I422ToARGBRow.any);
+  EXPECT_TRUE(dispatch->I422ToARGBRow.full == expected.I422ToARGBRow.full);
+  EXPECT_EQ(expected.I422ToARGBRow.align, dispatch->I422ToARGBRow.align);
+  // Widths that are a multiple of the alignment use the full kernel.
+  EXPECT_TRUE(ROW_KERNEL(dispatch->I422ToARGBRow,
+                         dispatch->I422ToARGBRow.align * 3) ==
+              dispatch->I422ToARGBRow.full);
+#if defined(HAS_I422TOARGBROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    EXPECT_TRUE(dispatch->I422ToARGBRow.any != I422ToARGBRow_C);
+  }
+#endif
+#if defined(HAS_INTERPOLATEROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    EXPECT_TRUE(ROW_KERNEL(dispatch->InterpolateRow, 64) ==
+                InterpolateRow_AVX2);
+    EXPECT_TRUE(ROW_KERNEL(dispatch->InterpolateRow, 65) ==
+                InterpolateRow_Any_AVX2);
+  }
+#endif
+
+  // Tables are not rewritten when the flags change, so a table in use by
+  // another thread keeps its kernels.
+  MaskCpuFlags(1);
+  const struct RowDispatch* c_table = GetRowDispatch();
+  MaskCpuFlags(benchmark_cpu_info_);
+  EXPECT_TRUE(dispatch == GetRowDispatch());
+  EXPECT_EQ(kCpuInitialized, c_table->cpu_info);
+  EXPECT_TRUE(c_table->I422ToARGBRow.full == I422ToARGBRow_C);
+
+  // Every set of flags gets its own table, however many sets are used.
+  for (int i = 1; i < 31; ++i) {
+    for (int j = i; j < 31; ++j) {
+      int flags = MaskCpuFlags(benchmark_cpu_info_ & ~(1 << i) & ~(1 << j));
+      EXPECT_EQ(flags, GetRowDispatch()->cpu_info);
+    }
+  }
+  MaskCpuFlags(benchmark_cpu_info_);
+  EXPECT_TRUE(dispatch == GetRowDispatch());
+}
+#endif  // ENABLE_ROW_TESTS
+
 }  // namespace libyuv
@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <limits.h>
 #include <math.h>
 #include <stdlib.h>
 #include <time.h>
@@ -1337,6 +1338,70 @@ TEST_F(LibYUVPlanarTest, ARGBBlend_Opt) {
   ASSERT_LE(max_diff, 1);
 }
 
+TEST_F(LibYUVPlanarTest, ARGBCompositeLayers_Opt) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kStride = kWidth * 4;
+  const int kLayerWidth = kWidth / 2 + 1;
+  const int kLayerHeight = kHeight / 2 + 1;
+  align_buffer_page_end(background, kStride * kHeight);
+  align_buffer_page_end(layer_full, kStride * kHeight);
+  align_buffer_page_end(layer_small, kLayerWidth * 4 * kLayerHeight);
+  align_buffer_page_end(dst_argb_ref, kStride * kHeight);
+  align_buffer_page_end(dst_argb_opt, kStride * kHeight);
+  MemRandomize(background, kStride * kHeight);
+  MemRandomize(layer_full, kStride * kHeight);
+  MemRandomize(layer_small, kLayerWidth * 4 * kLayerHeight);
+  ARGBAttenuate(layer_full, kStride, layer_full, kStride, kWidth, kHeight);
+  ARGBAttenuate(layer_small, kLayerWidth * 4, layer_small, kLayerWidth * 4,
+                kLayerWidth, kLayerHeight);
+
+  // A full frame layer, a small layer inside and the same layer clipped by
+  // the top left and by the bottom right.
+  struct ARGBLayer layers[4] = {
+      {layer_full, kStride, 0, 0, kWidth, kHeight},
+      {layer_small, kLayerWidth * 4, kWidth / 4, kHeight / 4, kLayerWidth,
+       kLayerHeight},
+      {layer_small, kLayerWidth * 4, -3, -5, kLayerWidth, kLayerHeight},
+      {layer_small, kLayerWidth * 4, kWidth - kLayerWidth / 2,
+       kHeight - kLayerHeight / 2, kLayerWidth, kLayerHeight}};
+
+  // Reference is 1 ARGBBlend per layer on the clipped rectangle.
+  memcpy(dst_argb_ref, background, kStride * kHeight);
+  for (int i = 0; i < 4; ++i) {
+    int x0 = layers[i].x > 0 ? layers[i].x : 0;
+    int y0 = layers[i].y > 0 ? layers[i].y : 0;
+    int x1 = layers[i].x + layers[i].width;
+    int y1 = layers[i].y + layers[i].height;
+    x1 = x1 < kWidth ? x1 : kWidth;
+    y1 = y1 < kHeight ? y1 : kHeight;
+    if (x0 < x1 && y0 < y1) {
+      const uint8_t* src = layers[i].src_argb +
+                           (y0 - layers[i].y) * layers[i].src_stride_argb +
+                           (x0 - layers[i].x) * 4;
+      uint8_t* dst = dst_argb_ref + y0 * kStride + x0 * 4;
+      ARGBBlend(src, layers[i].src_stride_argb, dst, kStride, dst, kStride,
+                x1 - x0, y1 - y0);
+    }
+  }
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    memcpy(dst_argb_opt, background, kStride * kHeight);
+    EXPECT_EQ(0, ARGBCompositeLayers(layers, 4, dst_argb_opt, kStride, kWidth,
+                                     kHeight));
+  }
+  for (int i = 0; i < kStride * kHeight; ++i) {
+    EXPECT_EQ(dst_argb_ref[i], dst_argb_opt[i]);
+  }
+  EXPECT_EQ(-1, ARGBCompositeLayers(NULL, 4, dst_argb_opt, kStride, kWidth,
+                                    kHeight));
+
+  free_aligned_buffer_page_end(background);
+  free_aligned_buffer_page_end(layer_full);
+  free_aligned_buffer_page_end(layer_small);
+  free_aligned_buffer_page_end(dst_argb_ref);
+  free_aligned_buffer_page_end(dst_argb_opt);
+}
+
 static void TestBlendPlane(int width,
                            int height,
                            int benchmark_iterations,
@@ -2274,6 +2339,114 @@ TEST_F(LibYUVPlanarTest, ARGBSobelXY_Opt) {
   ASSERT_EQ(0, max_diff);
 }
 
+static int TestSobelPlane(int width,
+                          int height,
+                          int benchmark_iterations,
+                          int disable_cpu_flags,
+                          int benchmark_cpu_info,
+                          int invert,
+                          int off) {
+  if (width < 1) {
+    width = 1;
+  }
+  const int kStride = width;
+  const size_t kSize = (size_t)kStride * abs(height);
+  align_buffer_page_end(src_y, kSize + off);
+  align_buffer_page_end(dst_y_c, kSize);
+  align_buffer_page_end(dst_y_opt, kSize);
+  for (int i = 0; i < kStride * height; ++i) {
+    src_y[i + off] = (fastrand() & 0xff);
+  }
+  memset(dst_y_c, 1, kSize);
+  memset(dst_y_opt, 2, kSize);
+
+  MaskCpuFlags(disable_cpu_flags);
+  SobelPlane(src_y + off, kStride, dst_y_c, kStride, width, invert * height);
+  MaskCpuFlags(benchmark_cpu_info);
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    SobelPlane(src_y + off, kStride, dst_y_opt, kStride, width,
+               invert * height);
+  }
+  int max_diff = 0;
+  for (int i = 0; i < kStride * height; ++i) {
+    int abs_diff =
+        abs(static_cast<int>(dst_y_c[i]) - static_cast<int>(dst_y_opt[i]));
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(dst_y_c);
+  free_aligned_buffer_page_end(dst_y_opt);
+  return max_diff;
+}
+
+TEST_F(LibYUVPlanarTest, SobelPlane_Any) {
+  int max_diff = TestSobelPlane(benchmark_width_ + 1, benchmark_height_,
+                                benchmark_iterations_, disable_cpu_flags_,
+                                benchmark_cpu_info_, +1, 0);
+  ASSERT_EQ(0, max_diff);
+}
+
+TEST_F(LibYUVPlanarTest, SobelPlane_Unaligned) {
+  int max_diff =
+      TestSobelPlane(benchmark_width_, benchmark_height_, benchmark_iterations_,
+                     disable_cpu_flags_, benchmark_cpu_info_, +1, 1);
+  ASSERT_EQ(0, max_diff);
+}
+
+TEST_F(LibYUVPlanarTest, SobelPlane_Invert) {
+  int max_diff =
+      TestSobelPlane(benchmark_width_, benchmark_height_, benchmark_iterations_,
+                     disable_cpu_flags_, benchmark_cpu_info_, -1, 0);
+  ASSERT_EQ(0, max_diff);
+}
+
+TEST_F(LibYUVPlanarTest, SobelPlane_Opt) {
+  int max_diff =
+      TestSobelPlane(benchmark_width_, benchmark_height_, benchmark_iterations_,
+                     disable_cpu_flags_, benchmark_cpu_info_, +1, 0);
+  ASSERT_EQ(0, max_diff);
+}
+
+// SobelPlane of a Y plane, ARGBSobelToPlane of the same plane as gray ARGB
+// and the G channel of ARGBSobelXY should all match.
+TEST_F(LibYUVPlanarTest, SobelPlane_MatchesARGBSobel) {
+  const int kSizes[] = {1, 2, 3, 17, 64, 67};
+  for (int w : kSizes) {
+    for (int h : kSizes) {
+      align_buffer_page_end(src_y, w * h);
+      align_buffer_page_end(src_argb, w * h * 4);
+      align_buffer_page_end(dst_y, w * h);
+      align_buffer_page_end(dst_argb_y, w * h);
+      align_buffer_page_end(dst_sobel, w * h * 4);
+      align_buffer_page_end(dst_sobelxy, w * h * 4);
+      for (int i = 0; i < w * h; ++i) {
+        src_y[i] = (fastrand() & 0xff);
+      }
+      J400ToARGB(src_y, w, src_argb, w * 4, w, h);
+      EXPECT_EQ(0, SobelPlane(src_y, w, dst_y, w, w, h));
+      EXPECT_EQ(0, ARGBSobelToPlane(src_argb, w * 4, dst_argb_y, w, w, h));
+      EXPECT_EQ(0, ARGBSobel(src_argb, w * 4, dst_sobel, w * 4, w, h));
+      EXPECT_EQ(0, ARGBSobelXY(src_argb, w * 4, dst_sobelxy, w * 4, w, h));
+      for (int i = 0; i < w * h; ++i) {
+        EXPECT_EQ(dst_y[i], dst_argb_y[i]);
+        EXPECT_EQ(dst_y[i], dst_sobelxy[i * 4 + 1]);
+        EXPECT_EQ(dst_y[i], dst_sobel[i * 4 + 0]);
+        EXPECT_EQ(dst_y[i], dst_sobel[i * 4 + 1]);
+        EXPECT_EQ(dst_y[i], dst_sobel[i * 4 + 2]);
+        EXPECT_EQ(255, dst_sobel[i * 4 + 3]);
+      }
+      free_aligned_buffer_page_end(src_y);
+      free_aligned_buffer_page_end(src_argb);
+      free_aligned_buffer_page_end(dst_y);
+      free_aligned_buffer_page_end(dst_argb_y);
+      free_aligned_buffer_page_end(dst_sobel);
+      free_aligned_buffer_page_end(dst_sobelxy);
+    }
+  }
+}
+
 static int TestBlur(int width,
                     int height,
                     int benchmark_iterations,
@@ -2387,6 +2560,30 @@ TEST_F(LibYUVPlanarTest, DISABLED_ARM(ARGBBlurSmall_Opt)) {
   ASSERT_LE(max_diff, 1);
 }
 
+// A NULL table allocates the sliding window internally.
+TEST_F(LibYUVPlanarTest, ARGBBlur_NoTable) {
+  const int kWidth = 67;
+  const int kHeight = 33;
+  const int kRadius = 5;
+  align_buffer_page_end(src_argb, kWidth * kHeight * 4);
+  align_buffer_page_end(dst_cumsum, kWidth * (kRadius * 2 + 2) * 16);
+  align_buffer_page_end(dst_argb_a, kWidth * kHeight * 4);
+  align_buffer_page_end(dst_argb_b, kWidth * kHeight * 4);
+  MemRandomize(src_argb, kWidth * kHeight * 4);
+  EXPECT_EQ(0, ARGBBlur(src_argb, kWidth * 4, dst_argb_a, kWidth * 4,
+                        reinterpret_cast<int32_t*>(dst_cumsum), kWidth * 4,
+                        kWidth, kHeight, kRadius));
+  EXPECT_EQ(0, ARGBBlur(src_argb, kWidth * 4, dst_argb_b, kWidth * 4, NULL, 0,
+                        kWidth, kHeight, kRadius));
+  for (int i = 0; i < kWidth * kHeight * 4; ++i) {
+    EXPECT_EQ(dst_argb_a[i], dst_argb_b[i]);
+  }
+  free_aligned_buffer_page_end(src_argb);
+  free_aligned_buffer_page_end(dst_cumsum);
+  free_aligned_buffer_page_end(dst_argb_a);
+  free_aligned_buffer_page_end(dst_argb_b);
+}
+
 TEST_F(LibYUVPlanarTest, DISABLED_ARM(TestARGBPolynomial)) {
   SIMD_ALIGNED(uint8_t orig_pixels[1280][4]);
   SIMD_ALIGNED(uint8_t dst_pixels_opt[1280][4]);
@@ -4608,6 +4805,12 @@ TEST_F(LibYUVPlanarTest, TestGaussRow_F32_Opt) {
     } else {
       GaussRow_F32_C(&orig_pixels[0], &dst_pixels_opt[0], 1280);
     }
+#elif defined(HAS_GAUSSROW_F32_AVX2)
+    if (TestCpuFlag(kCpuHasAVX2) && TestCpuFlag(kCpuHasFMA3)) {
+      GaussRow_F32_AVX2(&orig_pixels[0], &dst_pixels_opt[0], 1280);
+    } else {
+      GaussRow_F32_C(&orig_pixels[0], &dst_pixels_opt[0], 1280);
+    }
 #else
     GaussRow_F32_C(&orig_pixels[0], &dst_pixels_opt[0], 1280);
 #endif
@@ -4646,6 +4849,16 @@ TEST_F(LibYUVPlanarTest, TestGaussCol_F32_Opt) {
                      &orig_pixels[1280 * 2], &orig_pixels[1280 * 3],
                      &orig_pixels[1280 * 4], &dst_pixels_opt[0], 1280);
     }
+#elif defined(HAS_GAUSSCOL_F32_AVX2)
+    if (TestCpuFlag(kCpuHasAVX2) && TestCpuFlag(kCpuHasFMA3)) {
+      GaussCol_F32_AVX2(&orig_pixels[0], &orig_pixels[1280],
+                        &orig_pixels[1280 * 2], &orig_pixels[1280 * 3],
+                        &orig_pixels[1280 * 4], &dst_pixels_opt[0], 1280);
+    } else {
+      GaussCol_F32_C(&orig_pixels[0], &orig_pixels[1280],
+                     &orig_pixels[1280 * 2], &orig_pixels[1280 * 3],
+                     &orig_pixels[1280 * 4], &dst_pixels_opt[0], 1280);
+    }
 #else
     GaussCol_F32_C(&orig_pixels[0], &orig_pixels[1280], &orig_pixels[1280 * 2],
                    &orig_pixels[1280 * 3], &orig_pixels[1280 * 4],
@@ -4724,6 +4937,174 @@ TEST_F(LibYUVPlanarTest, TestGaussPlane_F32) {
   free_aligned_buffer_page_end(orig_pixels);
 }
 
+// Blur 8 and 16 bit planes in C and SIMD and compare exactly.  The 8 bit
+// result is also compared to the rounded float blur.
+static int TestGaussPlane(int width,
+                          int height,
+                          int benchmark_iterations,
+                          int disable_cpu_flags,
+                          int benchmark_cpu_info) {
+  const int kPixels = width * height;
+  align_buffer_page_end(src_pixels, kPixels);
+  align_buffer_page_end(dst_pixels_c, kPixels);
+  align_buffer_page_end(dst_pixels_opt, kPixels);
+  align_buffer_page_end(src_pixels_16, kPixels * 2);
+  align_buffer_page_end(dst_pixels_16_c, kPixels * 2);
+  align_buffer_page_end(dst_pixels_16_opt, kPixels * 2);
+  align_buffer_page_end(src_pixels_f, kPixels * 4);
+  align_buffer_page_end(dst_pixels_f, kPixels * 4);
+  uint16_t* src_16 = reinterpret_cast<uint16_t*>(src_pixels_16);
+  uint16_t* dst_16_c = reinterpret_cast<uint16_t*>(dst_pixels_16_c);
+  uint16_t* dst_16_opt = reinterpret_cast<uint16_t*>(dst_pixels_16_opt);
+  float* src_f = reinterpret_cast<float*>(src_pixels_f);
+  float* dst_f = reinterpret_cast<float*>(dst_pixels_f);
+
+  MemRandomize(src_pixels, kPixels);
+  for (int i = 0; i < kPixels; ++i) {
+    src_16[i] = fastrand() & 0xffff;
+    src_f[i] = static_cast<float>(src_pixels[i]);
+  }
+  memset(dst_pixels_c, 1, kPixels);
+  memset(dst_pixels_opt, 2, kPixels);
+  memset(dst_pixels_16_c, 1, kPixels * 2);
+  memset(dst_pixels_16_opt, 2, kPixels * 2);
+
+  MaskCpuFlags(disable_cpu_flags);
+  GaussPlane(src_pixels, width, dst_pixels_c, width, width, height);
+  GaussPlane_16(src_16, width, dst_16_c, width, width, height);
+  MaskCpuFlags(benchmark_cpu_info);
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    GaussPlane(src_pixels, width, dst_pixels_opt, width, width, height);
+  }
+  GaussPlane_16(src_16, width, dst_16_opt, width, width, height);
+  GaussPlane_F32(src_f, width, dst_f, width, width, height);
+
+  int max_diff = 0;
+  for (int i = 0; i < kPixels; ++i) {
+    int abs_diff = abs(dst_pixels_c[i] - dst_pixels_opt[i]);
+    max_diff = abs_diff > max_diff ? abs_diff : max_diff;
+    abs_diff = abs(dst_16_c[i] - dst_16_opt[i]);
+    max_diff = abs_diff > max_diff ? abs_diff : max_diff;
+    abs_diff = abs(dst_pixels_c[i] - static_cast<int>(dst_f[i] + 0.5f));
+    max_diff = abs_diff > max_diff ? abs_diff : max_diff;
+  }
+
+  free_aligned_buffer_page_end(src_pixels);
+  free_aligned_buffer_page_end(dst_pixels_c);
+  free_aligned_buffer_page_end(dst_pixels_opt);
+  free_aligned_buffer_page_end(src_pixels_16);
+  free_aligned_buffer_page_end(dst_pixels_16_c);
+  free_aligned_buffer_page_end(dst_pixels_16_opt);
+  free_aligned_buffer_page_end(src_pixels_f);
+  free_aligned_buffer_page_end(dst_pixels_f);
+  return max_diff;
+}
+
+TEST_F(LibYUVPlanarTest, TestGaussPlane_Opt) {
+  int max_diff =
+      TestGaussPlane(benchmark_width_, benchmark_height_, benchmark_iterations_,
+                     disable_cpu_flags_, benchmark_cpu_info_);
+  EXPECT_EQ(0, max_diff);
+}
+
+TEST_F(LibYUVPlanarTest, TestGaussPlane_Any) {
+  int max_diff = TestGaussPlane(benchmark_width_ + 1, benchmark_height_,
+                                benchmark_iterations_, disable_cpu_flags_,
+                                benchmark_cpu_info_);
+  EXPECT_EQ(0, max_diff);
+}
+
+// Compare C and optimized integral images, and check box sums.
+static int TestIntegralPlane(int width,
+                             int height,
+                             int benchmark_iterations,
+                             int disable_cpu_flags,
+                             int benchmark_cpu_info) {
+  const int kPixels = width * height;
+  align_buffer_page_end(src_pixels, kPixels);
+  align_buffer_page_end(dst_sum_c, kPixels * 4);
+  align_buffer_page_end(dst_sum_opt, kPixels * 4);
+  align_buffer_page_end(dst_sumsq_c, kPixels * 4);
+  align_buffer_page_end(dst_sumsq_opt, kPixels * 4);
+  uint32_t* sum_c = reinterpret_cast<uint32_t*>(dst_sum_c);
+  uint32_t* sum_opt = reinterpret_cast<uint32_t*>(dst_sum_opt);
+  uint32_t* sumsq_c = reinterpret_cast<uint32_t*>(dst_sumsq_c);
+  uint32_t* sumsq_opt = reinterpret_cast<uint32_t*>(dst_sumsq_opt);
+  MemRandomize(src_pixels, kPixels);
+
+  MaskCpuFlags(disable_cpu_flags);
+  IntegralPlane(src_pixels, width, sum_c, width, width, height);
+  IntegralPlaneSquared(src_pixels, width, sumsq_c, width, width, height);
+  MaskCpuFlags(benchmark_cpu_info);
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    IntegralPlane(src_pixels, width, sum_opt, width, width, height);
+    IntegralPlaneSquared(src_pixels, width, sumsq_opt, width, width, height);
+  }
+
+  int max_diff = 0;
+  for (int i = 0; i < kPixels; ++i) {
+    max_diff |= sum_c[i] != sum_opt[i];
+    max_diff |= sumsq_c[i] != sumsq_opt[i];
+  }
+  // Sum of a box away from the edges.
+  if (width > 8 && height > 8) {
+    uint32_t box = 0;
+    uint32_t boxsq = 0;
+    for (int y = 1; y <= 8; ++y) {
+      for (int x = 1; x <= 8; ++x) {
+        box += src_pixels[y * width + x];
+        boxsq += src_pixels[y * width + x] * src_pixels[y * width + x];
+      }
+    }
+    EXPECT_EQ(box, sum_opt[8 * width + 8] - sum_opt[8] - sum_opt[8 * width] +
+                       sum_opt[0]);
+    EXPECT_EQ(boxsq, sumsq_opt[8 * width + 8] - sumsq_opt[8] -
+                         sumsq_opt[8 * width] + sumsq_opt[0]);
+  }
+  free_aligned_buffer_page_end(src_pixels);
+  free_aligned_buffer_page_end(dst_sum_c);
+  free_aligned_buffer_page_end(dst_sum_opt);
+  free_aligned_buffer_page_end(dst_sumsq_c);
+  free_aligned_buffer_page_end(dst_sumsq_opt);
+  return max_diff;
+}
+
+TEST_F(LibYUVPlanarTest, TestIntegralPlane_Opt) {
+  int max_diff = TestIntegralPlane(benchmark_width_, benchmark_height_,
+                                   benchmark_iterations_, disable_cpu_flags_,
+                                   benchmark_cpu_info_);
+  EXPECT_EQ(0, max_diff);
+}
+
+TEST_F(LibYUVPlanarTest, TestIntegralPlane_Any) {
+  int max_diff = TestIntegralPlane(benchmark_width_ + 1, benchmark_height_,
+                                   benchmark_iterations_, disable_cpu_flags_,
+                                   benchmark_cpu_info_);
+  EXPECT_EQ(0, max_diff);
+}
+
+TEST_F(LibYUVPlanarTest, TestIntegralPlane) {
+  SIMD_ALIGNED(uint8_t orig_pixels[16][17]);
+  SIMD_ALIGNED(uint32_t sum[16][17]);
+  SIMD_ALIGNED(uint32_t sumsq[16][17]);
+  memset(orig_pixels, 3, sizeof(orig_pixels));
+
+  EXPECT_EQ(0, IntegralPlane(&orig_pixels[0][0], 17, &sum[0][0], 17, 17, 16));
+  EXPECT_EQ(0, IntegralPlaneSquared(&orig_pixels[0][0], 17, &sumsq[0][0], 17,
+                                    17, 16));
+  for (int y = 0; y < 16; ++y) {
+    for (int x = 0; x < 17; ++x) {
+      EXPECT_EQ((x + 1) * (y + 1) * 3u, sum[y][x]);
+      EXPECT_EQ((x + 1) * (y + 1) * 9u, sumsq[y][x]);
+    }
+  }
+  EXPECT_EQ(-1, IntegralPlane(NULL, 17, &sum[0][0], 17, 17, 16));
+  EXPECT_EQ(-1,
+            IntegralPlane(&orig_pixels[0][0], 17, &sum[0][0], 17, 17, INT_MIN));
+  EXPECT_EQ(-1, IntegralPlaneSquared(&orig_pixels[0][0], 17, &sumsq[0][0], 17,
+                                     17, INT_MIN));
+}
+
 TEST_F(LibYUVPlanarTest, HalfMergeUVPlane_Opt) {
   int dst_width = (benchmark_width_ + 1) / 2;
   int dst_height = (benchmark_height_ + 1) / 2;
@@ -119,6 +119,70 @@ TEST_F(LibYUVRotateTest, ARGBRotate270_Opt) {
                  disable_cpu_flags_, benchmark_cpu_info_);
 }
 
+// Rotate by 90 or 270 and check every pixel against its source pixel.
+static void ARGBTestRotateReference(int width,
+                                    int height,
+                                    libyuv::RotationMode mode,
+                                    int benchmark_iterations) {
+  int src_stride_argb = width * 4;
+  int dst_stride_argb = height * 4;
+  align_buffer_page_end(src_argb, src_stride_argb * height);
+  align_buffer_page_end(dst_argb, dst_stride_argb * width);
+  for (int i = 0; i < src_stride_argb * height; ++i) {
+    src_argb[i] = fastrand() & 0xff;
+  }
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    ARGBRotate(src_argb, src_stride_argb, dst_argb, dst_stride_argb, width,
+               height, mode);
+  }
+  const uint32_t* src = reinterpret_cast<const uint32_t*>(src_argb);
+  const uint32_t* dst = reinterpret_cast<const uint32_t*>(dst_argb);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      int dst_x = mode == kRotate90 ? height - 1 - y : y;
+      int dst_y = mode == kRotate90 ? x : width - 1 - x;
+      ASSERT_EQ(src[y * width + x], dst[dst_y * height + dst_x])
+          << "x " << x << " y " << y;
+    }
+  }
+  free_aligned_buffer_page_end(src_argb);
+  free_aligned_buffer_page_end(dst_argb);
+}
+
+TEST_F(LibYUVRotateTest, ARGBRotate90_Reference) {
+  ARGBTestRotateReference(1, 1, kRotate90, 1);
+  ARGBTestRotateReference(3, 37, kRotate90, 1);
+  ARGBTestRotateReference(37, 3, kRotate90, 1);
+  ARGBTestRotateReference(67, 45, kRotate90, 1);
+  ARGBTestRotateReference(64, 48, kRotate90, 1);
+}
+
+TEST_F(LibYUVRotateTest, ARGBRotate270_Reference) {
+  ARGBTestRotateReference(1, 1, kRotate270, 1);
+  ARGBTestRotateReference(3, 37, kRotate270, 1);
+  ARGBTestRotateReference(37, 3, kRotate270, 1);
+  ARGBTestRotateReference(67, 45, kRotate270, 1);
+  ARGBTestRotateReference(64, 48, kRotate270, 1);
+}
+
+// Screen capture sizes, where gathering a column per destination row is
+// bound by TLB misses.
+TEST_F(LibYUVRotateTest, ARGBRotate90_1080p) {
+  ARGBTestRotateReference(1920, 1080, kRotate90, benchmark_iterations_);
+}
+
+TEST_F(LibYUVRotateTest, ARGBRotate270_1080p) {
+  ARGBTestRotateReference(1920, 1080, kRotate270, benchmark_iterations_);
+}
+
+TEST_F(LibYUVRotateTest, ARGBRotate90_4K) {
+  ARGBTestRotateReference(3840, 2160, kRotate90, benchmark_iterations_);
+}
+
+TEST_F(LibYUVRotateTest, ARGBRotate270_4K) {
+  ARGBTestRotateReference(3840, 2160, kRotate270, benchmark_iterations_);
+}
+
 static void TestRotatePlane(int src_width,
                             int src_height,
                             int dst_width,
@@ -331,4 +395,60 @@ TEST_F(LibYUVRotateTest, RotatePlane270_16_Odd) {
                      benchmark_cpu_info_);
 }
 
+// Rows wider than the 180 degree rotation chunk, odd sizes and in place.
+TEST_F(LibYUVRotateTest, Rotate180Reference) {
+  const int kWidths[] = {1, 3, 511, 512, 513, 1300, 2049, 4100};
+  const int kHeights[] = {1, 2, 3, 5};
+  for (int wi = 0; wi < 8; ++wi) {
+    for (int hi = 0; hi < 4; ++hi) {
+      const int width = kWidths[wi];
+      const int height = kHeights[hi];
+      for (int bpp = 1; bpp <= 4; bpp *= 2) {
+        const int stride = width * bpp;
+        const int size = stride * height;
+        align_buffer_page_end(src, size);
+        align_buffer_page_end(dst, size);
+        align_buffer_page_end(ref, size);
+        for (int i = 0; i < size; ++i) {
+          src[i] = fastrand() & 0xff;
+        }
+        for (int y = 0; y < height; ++y) {
+          for (int x = 0; x < width; ++x) {
+            memcpy(ref + (height - 1 - y) * stride + (width - 1 - x) * bpp,
+                   src + y * stride + x * bpp, bpp);
+          }
+        }
+        memset(dst, 0, size);
+        for (int pass = 0; pass < 2; ++pass) {
+          // Pass 1 rotates dst in place from a copy of src.
+          const uint8_t* from = src;
+          if (pass == 1) {
+            memcpy(dst, src, size);
+            from = dst;
+          }
+          if (bpp == 1) {
+            EXPECT_EQ(0, RotatePlane(from, stride, dst, stride, width, height,
+                                     kRotate180));
+          } else if (bpp == 2) {
+            EXPECT_EQ(0, RotatePlane_16((const uint16_t*)from, width,
+                                        (uint16_t*)dst, width, width, height,
+                                        kRotate180));
+          } else {
+            EXPECT_EQ(0, ARGBRotate(from, stride, dst, stride, width, height,
+                                    kRotate180));
+          }
+          for (int i = 0; i < size; ++i) {
+            ASSERT_EQ(ref[i], dst[i]) << width << "x" << height << " bpp "
+                                      << bpp << " pass " << pass << " at "
+                                      << i;
+          }
+        }
+        free_aligned_buffer_page_end(src);
+        free_aligned_buffer_page_end(dst);
+        free_aligned_buffer_page_end(ref);
+      }
+    }
+  }
+}
+
 }  // namespace libyuv
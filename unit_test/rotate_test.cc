@@ -12,6 +12,7 @@
 
 #include "../unit_test/unit_test.h"
 #include "libyuv/cpu_id.h"
+#include "libyuv/planar_functions.h"
 #include "libyuv/rotate.h"
 
 #ifdef ENABLE_ROW_TESTS
@@ -485,6 +486,134 @@ TEST_F(LibYUVRotateTest, NV12Rotate270_Invert) {
                  disable_cpu_flags_, benchmark_cpu_info_);
 }
 
+// NV12Rotate should match NV12ToI420Rotate followed by MergeUVPlane.
+static void NV12ToNV12TestRotate(int src_width,
+                                 int src_height,
+                                 int dst_width,
+                                 int dst_height,
+                                 libyuv::RotationMode mode,
+                                 int benchmark_iterations,
+                                 int disable_cpu_flags,
+                                 int benchmark_cpu_info) {
+  if (src_width < 1) {
+    src_width = 1;
+  }
+  if (src_height == 0) {  // allow negative for inversion test.
+    src_height = 1;
+  }
+  if (dst_width < 1) {
+    dst_width = 1;
+  }
+  if (dst_height < 1) {
+    dst_height = 1;
+  }
+  int src_y_size = src_width * Abs(src_height);
+  int src_uv_size = ((src_width + 1) / 2) * ((Abs(src_height) + 1) / 2) * 2;
+  int src_nv12_size = src_y_size + src_uv_size;
+  align_buffer_page_end(src_nv12, src_nv12_size);
+  for (int i = 0; i < src_nv12_size; ++i) {
+    src_nv12[i] = fastrand() & 0xff;
+  }
+
+  int dst_halfwidth = (dst_width + 1) / 2;
+  int dst_y_size = dst_width * dst_height;
+  int dst_uv_size = dst_halfwidth * ((dst_height + 1) / 2);
+  int dst_nv12_size = dst_y_size + dst_uv_size * 2;
+  align_buffer_page_end(dst_i420_c, dst_y_size + dst_uv_size * 2);
+  align_buffer_page_end(dst_nv12_c, dst_nv12_size);
+  align_buffer_page_end(dst_nv12_opt, dst_nv12_size);
+  memset(dst_nv12_c, 2, dst_nv12_size);
+  memset(dst_nv12_opt, 3, dst_nv12_size);
+
+  MaskCpuFlags(disable_cpu_flags);  // Disable all CPU optimization.
+  NV12ToI420Rotate(src_nv12, src_width, src_nv12 + src_y_size,
+                   (src_width + 1) & ~1, dst_i420_c, dst_width,
+                   dst_i420_c + dst_y_size, dst_halfwidth,
+                   dst_i420_c + dst_y_size + dst_uv_size, dst_halfwidth,
+                   src_width, src_height, mode);
+  memcpy(dst_nv12_c, dst_i420_c, dst_y_size);
+  MergeUVPlane(dst_i420_c + dst_y_size, dst_halfwidth,
+               dst_i420_c + dst_y_size + dst_uv_size, dst_halfwidth,
+               dst_nv12_c + dst_y_size, dst_halfwidth * 2, dst_halfwidth,
+               (dst_height + 1) / 2);
+
+  MaskCpuFlags(benchmark_cpu_info);  // Enable all CPU optimization.
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    EXPECT_EQ(0, NV12Rotate(src_nv12, src_width, src_nv12 + src_y_size,
+                            (src_width + 1) & ~1, dst_nv12_opt, dst_width,
+                            dst_nv12_opt + dst_y_size, dst_halfwidth * 2,
+                            src_width, src_height, mode));
+  }
+
+  // Rotation should be exact.
+  for (int i = 0; i < dst_nv12_size; ++i) {
+    ASSERT_EQ(dst_nv12_c[i], dst_nv12_opt[i]);
+  }
+
+  free_aligned_buffer_page_end(dst_i420_c);
+  free_aligned_buffer_page_end(dst_nv12_c);
+  free_aligned_buffer_page_end(dst_nv12_opt);
+  free_aligned_buffer_page_end(src_nv12);
+}
+
+TEST_F(LibYUVRotateTest, NV12ToNV12Rotate0_Opt) {
+  NV12ToNV12TestRotate(benchmark_width_, benchmark_height_, benchmark_width_,
+                       benchmark_height_, kRotate0, benchmark_iterations_,
+                       disable_cpu_flags_, benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, NV12ToNV12Rotate90_Opt) {
+  NV12ToNV12TestRotate(benchmark_width_, benchmark_height_, benchmark_height_,
+                       benchmark_width_, kRotate90, benchmark_iterations_,
+                       disable_cpu_flags_, benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, NV12ToNV12Rotate180_Opt) {
+  NV12ToNV12TestRotate(benchmark_width_, benchmark_height_, benchmark_width_,
+                       benchmark_height_, kRotate180, benchmark_iterations_,
+                       disable_cpu_flags_, benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, NV12ToNV12Rotate270_Opt) {
+  NV12ToNV12TestRotate(benchmark_width_, benchmark_height_, benchmark_height_,
+                       benchmark_width_, kRotate270, benchmark_iterations_,
+                       disable_cpu_flags_, benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, NV12ToNV12Rotate90_Odd) {
+  NV12ToNV12TestRotate(benchmark_width_ + 1, benchmark_height_ + 1,
+                       benchmark_height_ + 1, benchmark_width_ + 1, kRotate90,
+                       benchmark_iterations_, disable_cpu_flags_,
+                       benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, NV12ToNV12Rotate180_Odd) {
+  NV12ToNV12TestRotate(benchmark_width_ + 1, benchmark_height_ + 1,
+                       benchmark_width_ + 1, benchmark_height_ + 1, kRotate180,
+                       benchmark_iterations_, disable_cpu_flags_,
+                       benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, NV12ToNV12Rotate270_Odd) {
+  NV12ToNV12TestRotate(benchmark_width_ + 1, benchmark_height_ + 1,
+                       benchmark_height_ + 1, benchmark_width_ + 1, kRotate270,
+                       benchmark_iterations_, disable_cpu_flags_,
+                       benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, NV12ToNV12Rotate90_Invert) {
+  NV12ToNV12TestRotate(benchmark_width_, -benchmark_height_, benchmark_height_,
+                       benchmark_width_, kRotate90, benchmark_iterations_,
+                       disable_cpu_flags_, benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, NV12ToNV12Rotate_OddStride) {
+  align_buffer_page_end(frame, 64 * 64 * 2);
+  EXPECT_EQ(-1, NV12Rotate(frame, 32, frame + 32 * 32, 33, frame + 32 * 64, 32,
+                           frame + 32 * 96, 32, 32, 32, kRotate90));
+  free_aligned_buffer_page_end(frame);
+}
+
 // Test Android 420 to I420 Rotate
 #define TESTAPLANARTOPI(SRC_FMT_PLANAR, PIXEL_STRIDE, SRC_SUBSAMP_X,          \
                         SRC_SUBSAMP_Y, FMT_PLANAR, SUBSAMP_X, SUBSAMP_Y,      \
@@ -688,6 +817,122 @@ TEST_F(LibYUVRotateTest, I010Rotate270_Opt) {
                  disable_cpu_flags_, benchmark_cpu_info_);
 }
 
+// P010Rotate should match I010Rotate followed by MergeUVPlane_16.
+static void P010TestRotate(int src_width,
+                           int src_height,
+                           int dst_width,
+                           int dst_height,
+                           libyuv::RotationMode mode,
+                           int benchmark_iterations,
+                           int disable_cpu_flags,
+                           int benchmark_cpu_info) {
+  if (src_width < 1) {
+    src_width = 1;
+  }
+  if (src_height < 1) {
+    src_height = 1;
+  }
+  if (dst_width < 1) {
+    dst_width = 1;
+  }
+  if (dst_height < 1) {
+    dst_height = 1;
+  }
+  int src_halfwidth = (src_width + 1) / 2;
+  int src_y_size = src_width * src_height;
+  int src_uv_size = src_halfwidth * ((src_height + 1) / 2);
+  int src_i010_size = src_y_size + src_uv_size * 2;
+  align_buffer_page_end_16(src_i010, src_i010_size);
+  align_buffer_page_end_16(src_p010, src_i010_size);
+  for (int i = 0; i < src_i010_size; ++i) {
+    src_i010[i] = fastrand() & 0x3ff;
+  }
+  memcpy(src_p010, src_i010, src_y_size * 2);
+  MergeUVPlane_16(src_i010 + src_y_size, src_halfwidth,
+                  src_i010 + src_y_size + src_uv_size, src_halfwidth,
+                  src_p010 + src_y_size, src_halfwidth * 2, src_halfwidth,
+                  (src_height + 1) / 2, 10);
+
+  int dst_halfwidth = (dst_width + 1) / 2;
+  int dst_y_size = dst_width * dst_height;
+  int dst_uv_size = dst_halfwidth * ((dst_height + 1) / 2);
+  int dst_p010_size = dst_y_size + dst_uv_size * 2;
+  align_buffer_page_end_16(dst_i010_c, dst_p010_size);
+  align_buffer_page_end_16(dst_p010_c, dst_p010_size);
+  align_buffer_page_end_16(dst_p010_opt, dst_p010_size);
+  memset(dst_p010_c, 2, dst_p010_size * 2);
+  memset(dst_p010_opt, 3, dst_p010_size * 2);
+
+  MaskCpuFlags(disable_cpu_flags);  // Disable all CPU optimization.
+  I010Rotate(src_i010, src_width, src_i010 + src_y_size, src_halfwidth,
+             src_i010 + src_y_size + src_uv_size, src_halfwidth, dst_i010_c,
+             dst_width, dst_i010_c + dst_y_size, dst_halfwidth,
+             dst_i010_c + dst_y_size + dst_uv_size, dst_halfwidth, src_width,
+             src_height, mode);
+  memcpy(dst_p010_c, dst_i010_c, dst_y_size * 2);
+  MergeUVPlane_16(dst_i010_c + dst_y_size, dst_halfwidth,
+                  dst_i010_c + dst_y_size + dst_uv_size, dst_halfwidth,
+                  dst_p010_c + dst_y_size, dst_halfwidth * 2, dst_halfwidth,
+                  (dst_height + 1) / 2, 10);
+
+  MaskCpuFlags(benchmark_cpu_info);  // Enable all CPU optimization.
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    EXPECT_EQ(0, P010Rotate(src_p010, src_width, src_p010 + src_y_size,
+                            src_halfwidth * 2, dst_p010_opt, dst_width,
+                            dst_p010_opt + dst_y_size, dst_halfwidth * 2,
+                            src_width, src_height, mode));
+  }
+
+  // Rotation should be exact.
+  for (int i = 0; i < dst_p010_size; ++i) {
+    ASSERT_EQ(dst_p010_c[i], dst_p010_opt[i]);
+  }
+
+  free_aligned_buffer_page_end_16(dst_i010_c);
+  free_aligned_buffer_page_end_16(dst_p010_c);
+  free_aligned_buffer_page_end_16(dst_p010_opt);
+  free_aligned_buffer_page_end_16(src_i010);
+  free_aligned_buffer_page_end_16(src_p010);
+}
+
+TEST_F(LibYUVRotateTest, P010Rotate0_Opt) {
+  P010TestRotate(benchmark_width_, benchmark_height_, benchmark_width_,
+                 benchmark_height_, kRotate0, benchmark_iterations_,
+                 disable_cpu_flags_, benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, P010Rotate90_Opt) {
+  P010TestRotate(benchmark_width_, benchmark_height_, benchmark_height_,
+                 benchmark_width_, kRotate90, benchmark_iterations_,
+                 disable_cpu_flags_, benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, P010Rotate180_Opt) {
+  P010TestRotate(benchmark_width_, benchmark_height_, benchmark_width_,
+                 benchmark_height_, kRotate180, benchmark_iterations_,
+                 disable_cpu_flags_, benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, P010Rotate270_Opt) {
+  P010TestRotate(benchmark_width_, benchmark_height_, benchmark_height_,
+                 benchmark_width_, kRotate270, benchmark_iterations_,
+                 disable_cpu_flags_, benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, P010Rotate90_Odd) {
+  P010TestRotate(benchmark_width_ + 1, benchmark_height_ + 1,
+                 benchmark_height_ + 1, benchmark_width_ + 1, kRotate90,
+                 benchmark_iterations_, disable_cpu_flags_,
+                 benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, P010Rotate270_Odd) {
+  P010TestRotate(benchmark_width_ + 1, benchmark_height_ + 1,
+                 benchmark_height_ + 1, benchmark_width_ + 1, kRotate270,
+                 benchmark_iterations_, disable_cpu_flags_,
+                 benchmark_cpu_info_);
+}
+
 static void I210TestRotate(int src_width,
                            int src_height,
                            int dst_width,
@@ -862,6 +1107,105 @@ TEST_F(LibYUVRotateTest, I410Rotate270_Opt) {
                  disable_cpu_flags_, benchmark_cpu_info_);
 }
 
+// Rotate a plane by 90 or 270 and check every pixel against its source
+// pixel.  Frames wider than 4096 are transposed in bands of columns.
+static void TestRotatePlaneReference(int width,
+                                     int height,
+                                     libyuv::RotationMode mode,
+                                     int benchmark_iterations) {
+  align_buffer_page_end(src, width * height);
+  align_buffer_page_end(dst, width * height);
+  MemRandomize(src, width * height);
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    RotatePlane(src, width, dst, height, width, height, mode);
+  }
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      int dst_x = mode == kRotate90 ? height - 1 - y : y;
+      int dst_y = mode == kRotate90 ? x : width - 1 - x;
+      ASSERT_EQ(src[y * width + x], dst[dst_y * height + dst_x])
+          << "x " << x << " y " << y;
+    }
+  }
+  free_aligned_buffer_page_end(src);
+  free_aligned_buffer_page_end(dst);
+}
+
+TEST_F(LibYUVRotateTest, RotatePlane90_Wide) {
+  TestRotatePlaneReference(4097, 19, kRotate90, 1);
+  TestRotatePlaneReference(6150, 24, kRotate90, 1);
+}
+
+TEST_F(LibYUVRotateTest, RotatePlane270_Wide) {
+  TestRotatePlaneReference(4097, 19, kRotate270, 1);
+  TestRotatePlaneReference(6150, 24, kRotate270, 1);
+}
+
+TEST_F(LibYUVRotateTest, RotatePlane90_4K) {
+  TestRotatePlaneReference(3840, 2160, kRotate90, benchmark_iterations_);
+}
+
+TEST_F(LibYUVRotateTest, RotatePlane90_8K) {
+  TestRotatePlaneReference(7680, 4320, kRotate90, benchmark_iterations_);
+}
+
+TEST_F(LibYUVRotateTest, I420Rotate90_8K) {
+  I420TestRotate(7680, 4320, 4320, 7680, kRotate90, benchmark_iterations_,
+                 disable_cpu_flags_, benchmark_cpu_info_);
+}
+
+static void TestRotatePlane_16Reference(int width,
+                                        int height,
+                                        libyuv::RotationMode mode,
+                                        int benchmark_iterations) {
+  align_buffer_page_end_16(src, width * height);
+  align_buffer_page_end_16(dst, width * height);
+  MemRandomize((uint8_t*)src, width * height * 2);
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    RotatePlane_16(src, width, dst, height, width, height, mode);
+  }
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      int dst_x = mode == kRotate90 ? height - 1 - y : y;
+      int dst_y = mode == kRotate90 ? x : width - 1 - x;
+      ASSERT_EQ(src[y * width + x], dst[dst_y * height + dst_x])
+          << "x " << x << " y " << y;
+    }
+  }
+  free_aligned_buffer_page_end_16(src);
+  free_aligned_buffer_page_end_16(dst);
+}
+
+// Widths that leave remainders for each transpose kernel.
+TEST_F(LibYUVRotateTest, RotatePlane90_16_Reference) {
+  TestRotatePlane_16Reference(1279, 721, kRotate90, 1);
+  TestRotatePlane_16Reference(39, 13, kRotate90, 1);
+}
+
+TEST_F(LibYUVRotateTest, RotatePlane270_16_Reference) {
+  TestRotatePlane_16Reference(1279, 721, kRotate270, 1);
+  TestRotatePlane_16Reference(39, 13, kRotate270, 1);
+}
+
+TEST_F(LibYUVRotateTest, RotatePlane90_16_4K) {
+  TestRotatePlane_16Reference(3840, 2160, kRotate90, benchmark_iterations_);
+}
+
+TEST_F(LibYUVRotateTest, I010Rotate90_4K) {
+  I010TestRotate(3840, 2160, 2160, 3840, kRotate90, benchmark_iterations_,
+                 disable_cpu_flags_, benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, I210Rotate90_4K) {
+  I210TestRotate(3840, 2160, 2160, 3840, kRotate90, benchmark_iterations_,
+                 disable_cpu_flags_, benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, I410Rotate90_4K) {
+  I410TestRotate(3840, 2160, 2160, 3840, kRotate90, benchmark_iterations_,
+                 disable_cpu_flags_, benchmark_cpu_info_);
+}
+
 #if defined(ENABLE_ROW_TESTS)
 
 TEST_F(LibYUVRotateTest, Transpose4x4_Test) {
@@ -957,6 +1301,48 @@ TEST_F(LibYUVRotateTest, Transpose4x4_Opt) {
   free_aligned_buffer_page_end(dst_pixels_opt);
 }
 
+TEST_F(LibYUVRotateTest, TransposeWx8_16_Opt) {
+  // Source is 8 rows of width values.  Width leaves a remainder for the Any
+  // variant.
+  const int width = (benchmark_width_ * benchmark_height_ + 7) / 8 + 3;
+  const int height = 8;
+  align_buffer_page_end_16(src_pixels, width * height);
+  align_buffer_page_end_16(dst_pixels_c, width * height);
+  align_buffer_page_end_16(dst_pixels_opt, width * height);
+
+  MemRandomize((uint8_t*)src_pixels, width * height * 2);
+  memset(dst_pixels_c, 1, width * height * 2);
+  memset(dst_pixels_opt, 2, width * height * 2);
+
+  TransposeWx8_16_C(src_pixels, width, dst_pixels_c, height, width);
+
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+#if defined(HAS_TRANSPOSEWX8_16_AVX2)
+    if (TestCpuFlag(kCpuHasAVX2)) {
+      TransposeWx8_16_Any_AVX2(src_pixels, width, dst_pixels_opt, height,
+                               width);
+    } else
+#endif
+#if defined(HAS_TRANSPOSEWX8_16_SSE2)
+    if (TestCpuFlag(kCpuHasSSE2)) {
+      TransposeWx8_16_Any_SSE2(src_pixels, width, dst_pixels_opt, height,
+                               width);
+    } else
+#endif
+    {
+      TransposeWx8_16_C(src_pixels, width, dst_pixels_opt, height, width);
+    }
+  }
+
+  for (int i = 0; i < width * height; ++i) {
+    ASSERT_EQ(dst_pixels_c[i], dst_pixels_opt[i]);
+  }
+
+  free_aligned_buffer_page_end_16(src_pixels);
+  free_aligned_buffer_page_end_16(dst_pixels_c);
+  free_aligned_buffer_page_end_16(dst_pixels_opt);
+}
+
 #endif  // ENABLE_ROW_TESTS
 
 }  // namespace libyuv
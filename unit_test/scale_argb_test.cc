@@ -14,6 +14,8 @@
 #include "../unit_test/unit_test.h"
 #include "libyuv/convert_argb.h"
 #include "libyuv/cpu_id.h"
+#include "libyuv/planar_functions.h"
+#include "libyuv/rotate_argb.h"
 #include "libyuv/scale_argb.h"
 #include "libyuv/video_common.h"
 
@@ -284,6 +286,8 @@ TEST_FACTOR(8, 1, 8)
 TEST_FACTOR(3by4, 3, 4)
 TEST_FACTOR(3by8, 3, 8)
 TEST_FACTOR(3, 1, 3)
+TEST_FACTOR1(, 2, Bicubic, 1, 2, 0)
+TEST_FACTOR1(, 3by4, Lanczos3, 3, 4, 0)
 #undef TEST_FACTOR1
 #undef TEST_FACTOR
 #undef SX
@@ -467,14 +471,14 @@ static void YUVToARGBTestFilter(int src_width,
   YUVToARGBScaleReference2(src_y, src_stride_y, src_u, src_stride_uv, src_v,
                            src_stride_uv, libyuv::FOURCC_I420, src_width,
                            src_height, dst_argb_c, dst_stride_argb,
-                           libyuv::FOURCC_I420, dst_width, dst_height, 0, 0,
+                           libyuv::FOURCC_ARGB, dst_width, dst_height, 0, 0,
                            dst_width, dst_height, f);
 
   for (int i = 0; i < benchmark_iterations; ++i) {
     YUVToARGBScaleClip(src_y, src_stride_y, src_u, src_stride_uv, src_v,
                        src_stride_uv, libyuv::FOURCC_I420, src_width,
                        src_height, dst_argb_opt, dst_stride_argb,
-                       libyuv::FOURCC_I420, dst_width, dst_height, 0, 0,
+                       libyuv::FOURCC_ARGB, dst_width, dst_height, 0, 0,
                        dst_width, dst_height, f);
   }
   int max_diff = 0;
@@ -523,6 +527,200 @@ TEST_F(LibYUVScaleTest, YUVToRGBScaleDown) {
   ASSERT_LE(diff, 10);
 }
 
+// Compare YUVToARGBScaleClip to a full frame conversion followed by
+// ARGBScaleClip.  Both use the same row functions, so results are exact.
+static int YUVToARGBClipTestFilter(int src_width,
+                                   int src_height,
+                                   int dst_width,
+                                   int dst_height,
+                                   int clip_x,
+                                   int clip_y,
+                                   int clip_width,
+                                   int clip_height,
+                                   uint32_t src_fourcc,
+                                   uint32_t dst_fourcc,
+                                   FilterMode f) {
+  const int abs_src_height = Abs(src_height);
+  const int src_stride_uv = (src_width + 1) / 2;
+  const int src_uv_height = (abs_src_height + 1) / 2;
+  const int dst_stride_argb = dst_width * 4;
+  align_buffer_page_end(src_y, src_width * abs_src_height);
+  align_buffer_page_end(src_u, src_stride_uv * src_uv_height);
+  align_buffer_page_end(src_v, src_stride_uv * src_uv_height);
+  align_buffer_page_end(argb_buffer, src_width * abs_src_height * 4);
+  align_buffer_page_end(dst_argb_c, dst_stride_argb * dst_height);
+  align_buffer_page_end(dst_argb_opt, dst_stride_argb * dst_height);
+  MemRandomize(src_y, src_width * abs_src_height);
+  MemRandomize(src_u, src_stride_uv * src_uv_height);
+  MemRandomize(src_v, src_stride_uv * src_uv_height);
+  memset(dst_argb_c, 2, dst_stride_argb * dst_height);
+  memset(dst_argb_opt, 2, dst_stride_argb * dst_height);
+
+  const uint8_t* ref_u = src_u;
+  const uint8_t* ref_v = src_v;
+  if (src_fourcc == libyuv::FOURCC_YV12) {
+    ref_u = src_v;
+    ref_v = src_u;
+  }
+  if (dst_fourcc == libyuv::FOURCC_ABGR) {
+    I420ToABGR(src_y, src_width, ref_u, src_stride_uv, ref_v, src_stride_uv,
+               argb_buffer, src_width * 4, src_width, src_height);
+  } else {
+    I420ToARGB(src_y, src_width, ref_u, src_stride_uv, ref_v, src_stride_uv,
+               argb_buffer, src_width * 4, src_width, src_height);
+  }
+  ARGBScaleClip(argb_buffer, src_width * 4, src_width, abs_src_height,
+                dst_argb_c, dst_stride_argb, dst_width, dst_height, clip_x,
+                clip_y, clip_width, clip_height, f);
+  int r = YUVToARGBScaleClip(src_y, src_width, src_u, src_stride_uv, src_v,
+                             src_stride_uv, src_fourcc, src_width, src_height,
+                             dst_argb_opt, dst_stride_argb, dst_fourcc,
+                             dst_width, dst_height, clip_x, clip_y,
+                             clip_width, clip_height, f);
+  int max_diff = r == 0 ? 0 : 256;
+  for (int i = 0; i < dst_stride_argb * dst_height; ++i) {
+    int abs_diff = Abs(dst_argb_c[i] - dst_argb_opt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(dst_argb_c);
+  free_aligned_buffer_page_end(dst_argb_opt);
+  free_aligned_buffer_page_end(argb_buffer);
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_v);
+  return max_diff;
+}
+
+#define TEST_YUVTOARGBCLIP(name, sw, sh, dw, dh, cx, cy, cw, ch, srcfourcc, \
+                           dstfourcc)                                        \
+  TEST_F(LibYUVScaleTest, YUVToARGBScaleClip_##name##_None) {               \
+    EXPECT_EQ(0, YUVToARGBClipTestFilter(sw, sh, dw, dh, cx, cy, cw, ch,    \
+                                         libyuv::srcfourcc,                 \
+                                         libyuv::dstfourcc, kFilterNone));  \
+  }                                                                         \
+  TEST_F(LibYUVScaleTest, YUVToARGBScaleClip_##name##_Linear) {             \
+    EXPECT_EQ(0, YUVToARGBClipTestFilter(                                   \
+                     sw, sh, dw, dh, cx, cy, cw, ch, libyuv::srcfourcc,     \
+                     libyuv::dstfourcc, kFilterLinear));                    \
+  }                                                                         \
+  TEST_F(LibYUVScaleTest, YUVToARGBScaleClip_##name##_Bilinear) {           \
+    EXPECT_EQ(0, YUVToARGBClipTestFilter(                                   \
+                     sw, sh, dw, dh, cx, cy, cw, ch, libyuv::srcfourcc,     \
+                     libyuv::dstfourcc, kFilterBilinear));                  \
+  }                                                                         \
+  TEST_F(LibYUVScaleTest, YUVToARGBScaleClip_##name##_Box) {                \
+    EXPECT_EQ(0, YUVToARGBClipTestFilter(sw, sh, dw, dh, cx, cy, cw, ch,    \
+                                         libyuv::srcfourcc,                 \
+                                         libyuv::dstfourcc, kFilterBox));   \
+  }
+
+TEST_YUVTOARGBCLIP(Down, 1281, 721, 640, 360, 0, 0, 640, 360, FOURCC_I420,
+                   FOURCC_ARGB)
+TEST_YUVTOARGBCLIP(DownClip, 1281, 721, 640, 360, 101, 67, 211, 153,
+                   FOURCC_I420, FOURCC_ARGB)
+TEST_YUVTOARGBCLIP(Down2Clip, 1280, 720, 640, 360, 64, 33, 300, 200,
+                   FOURCC_I420, FOURCC_ARGB)
+TEST_YUVTOARGBCLIP(Down4Clip, 1280, 720, 320, 180, 10, 11, 100, 101,
+                   FOURCC_I420, FOURCC_ARGB)
+TEST_YUVTOARGBCLIP(DownBigClip, 1920, 1080, 160, 90, 31, 17, 40, 30,
+                   FOURCC_I420, FOURCC_ARGB)
+TEST_YUVTOARGBCLIP(UpClip, 321, 241, 1280, 720, 333, 101, 400, 301,
+                   FOURCC_I420, FOURCC_ARGB)
+TEST_YUVTOARGBCLIP(CopyClip, 640, 360, 640, 360, 5, 7, 100, 99, FOURCC_I420,
+                   FOURCC_ARGB)
+TEST_YUVTOARGBCLIP(VerticalClip, 640, 361, 640, 200, 3, 9, 401, 151,
+                   FOURCC_I420, FOURCC_ARGB)
+TEST_YUVTOARGBCLIP(InvertClip, 641, -363, 320, 180, 13, 15, 200, 151,
+                   FOURCC_I420, FOURCC_ARGB)
+TEST_YUVTOARGBCLIP(InvertUpClip, 161, -91, 640, 360, 77, 79, 300, 201,
+                   FOURCC_I420, FOURCC_ARGB)
+TEST_YUVTOARGBCLIP(YV12, 640, 360, 320, 180, 0, 0, 320, 180, FOURCC_YV12,
+                   FOURCC_ARGB)
+TEST_YUVTOARGBCLIP(ABGR, 640, 360, 480, 270, 11, 13, 100, 100, FOURCC_I420,
+                   FOURCC_ABGR)
+TEST_YUVTOARGBCLIP(YV12ABGR, 640, 360, 480, 270, 11, 13, 100, 100,
+                   FOURCC_YV12, FOURCC_ABGR)
+
+// Polyphase filters scale a clip with the coefficients of the whole image.
+TEST_F(LibYUVScaleTest, YUVToARGBScaleClip_Polyphase) {
+  EXPECT_EQ(0, YUVToARGBClipTestFilter(1281, 721, 640, 360, 101, 67, 211, 153,
+                                       libyuv::FOURCC_I420,
+                                       libyuv::FOURCC_ARGB, kFilterLanczos3));
+  EXPECT_EQ(0, YUVToARGBClipTestFilter(321, 241, 1280, 720, 333, 101, 400, 301,
+                                       libyuv::FOURCC_I420,
+                                       libyuv::FOURCC_ARGB, kFilterBicubic));
+  EXPECT_EQ(0, YUVToARGBClipTestFilter(641, -363, 320, 180, 13, 15, 200, 151,
+                                       libyuv::FOURCC_I420,
+                                       libyuv::FOURCC_ARGB, kFilterLanczos3));
+}
+
+TEST_F(LibYUVScaleTest, ARGBScaleClip_Polyphase) {
+  EXPECT_EQ(0, ARGBClipTestFilter(640, 360, 427, 239, kFilterLanczos3, 1));
+  EXPECT_EQ(0, ARGBClipTestFilter(320, 180, 641, 361, kFilterBicubic, 1));
+}
+
+// Polyphase filters scale a negative src_width as a mirrored copy of the
+// source, including clips.
+static int ARGBMirrorTestFilter(int src_width,
+                                int src_height,
+                                int dst_width,
+                                int dst_height,
+                                int clip_x,
+                                int clip_width,
+                                FilterMode f) {
+  const int kBpp = 4;
+  const int src_stride = src_width * kBpp;
+  const int dst_stride = dst_width * kBpp;
+  const int64_t src_size = (int64_t)src_stride * src_height;
+  const int64_t dst_size = (int64_t)dst_stride * dst_height;
+  int diff = 0;
+  int64_t i;
+  align_buffer_page_end(src, src_size);
+  align_buffer_page_end(src_mirror, src_size);
+  align_buffer_page_end(dst_mirror, dst_size);
+  align_buffer_page_end(dst_ref, dst_size);
+  MemRandomize(src, src_size);
+  memset(dst_mirror, 2, dst_size);
+  memset(dst_ref, 2, dst_size);
+  ARGBMirror(src, src_stride, src_mirror, src_stride, src_width, src_height);
+  EXPECT_EQ(0, ARGBScaleClip(src, src_stride, -src_width, src_height,
+                             dst_mirror, dst_stride, dst_width, dst_height,
+                             clip_x, 0, clip_width, dst_height, f));
+  EXPECT_EQ(0, ARGBScaleClip(src_mirror, src_stride, src_width, src_height,
+                             dst_ref, dst_stride, dst_width, dst_height, clip_x,
+                             0, clip_width, dst_height, f));
+  for (i = 0; i < dst_size; ++i) {
+    diff += dst_mirror[i] != dst_ref[i];
+  }
+  free_aligned_buffer_page_end(src);
+  free_aligned_buffer_page_end(src_mirror);
+  free_aligned_buffer_page_end(dst_mirror);
+  free_aligned_buffer_page_end(dst_ref);
+  return diff;
+}
+
+TEST_F(LibYUVScaleTest, ARGBScaleMirror_Polyphase) {
+  EXPECT_EQ(0, ARGBMirrorTestFilter(640, 360, 427, 239, 0, 427,
+                                    kFilterLanczos3));
+  EXPECT_EQ(0, ARGBMirrorTestFilter(321, 181, 641, 361, 0, 641,
+                                    kFilterBicubic));
+  EXPECT_EQ(0, ARGBMirrorTestFilter(641, 361, 320, 180, 37, 101,
+                                    kFilterLanczos3));
+  EXPECT_EQ(0, ARGBMirrorTestFilter(7, 5, 33, 17, 0, 33, kFilterBicubic));
+}
+
+TEST_F(LibYUVScaleTest, YUVToARGBScaleClip_BadFourCC) {
+  EXPECT_EQ(256, YUVToARGBClipTestFilter(64, 64, 32, 32, 0, 0, 32, 32,
+                                         libyuv::FOURCC_NV12,
+                                         libyuv::FOURCC_ARGB, kFilterNone));
+  EXPECT_EQ(256, YUVToARGBClipTestFilter(64, 64, 32, 32, 0, 0, 32, 32,
+                                         libyuv::FOURCC_I420,
+                                         libyuv::FOURCC_I420, kFilterNone));
+}
+
 TEST_F(LibYUVScaleTest, ARGBTest3x) {
   const int kSrcStride = 480 * 4;
   const int kDstStride = 160 * 4;
@@ -635,4 +833,300 @@ TEST_F(LibYUVScaleTest, ARGBScale_LargeHeightOverflow) {
   free_aligned_buffer_page_end(orig_pixels);
 }
 
+// Test that a plan, executed several times, matches ARGBScale.
+static int ARGBTestFilterPlan(int src_width,
+                              int src_height,
+                              int dst_width,
+                              int dst_height,
+                              FilterMode f) {
+  if (!SizeValid(src_width, src_height, dst_width, dst_height)) {
+    return 0;
+  }
+  int i, j;
+  const int kBpp = 4;
+  int src_stride = Abs(src_width) * kBpp;
+  int dst_stride = dst_width * kBpp;
+  int64_t src_size = src_stride * Abs(src_height);
+  int64_t dst_size = dst_stride * dst_height;
+  align_buffer_page_end(src, src_size);
+  align_buffer_page_end(dst_c, dst_size);
+  align_buffer_page_end(dst_opt, dst_size);
+
+  ScalePlan* plan = ScalePlanCreate(kScalePlanARGB, src_width, src_height,
+                                    dst_width, dst_height, f);
+  EXPECT_TRUE(plan != NULL);
+  int diff = 0;
+  for (j = 0; plan && j < 2; ++j) {
+    MemRandomize(src, src_size);
+    ARGBScale(src, src_stride, src_width, src_height, dst_c, dst_stride,
+              dst_width, dst_height, f);
+    EXPECT_EQ(0, ScalePlanExecute(plan, src, src_stride, dst_opt, dst_stride));
+    for (i = 0; i < dst_size; ++i) {
+      diff += dst_c[i] != dst_opt[i];
+    }
+  }
+
+  ScalePlanDestroy(plan);
+  free_aligned_buffer_page_end(src);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+  return diff;
+}
+
+#define TEST_SCALEPLAN1(name, src_width, src_height, dst_width, dst_height, \
+                        filter)                                             \
+  TEST_F(LibYUVScaleTest, ARGBScalePlan##name##_##filter) {                 \
+    ASSERT_EQ(0, ARGBTestFilterPlan(src_width, src_height, dst_width,       \
+                                    dst_height, kFilter##filter));          \
+  }
+
+#define TEST_SCALEPLAN(name, src_width, src_height, dst_width, dst_height)    \
+  TEST_SCALEPLAN1(name, src_width, src_height, dst_width, dst_height, None)   \
+  TEST_SCALEPLAN1(name, src_width, src_height, dst_width, dst_height, Linear) \
+  TEST_SCALEPLAN1(name, src_width, src_height, dst_width, dst_height,         \
+                  Bilinear)                                                   \
+  TEST_SCALEPLAN1(name, src_width, src_height, dst_width, dst_height, Box)
+
+TEST_SCALEPLAN(Copy, 320, 180, 320, 180)
+TEST_SCALEPLAN(Vertical, 320, 180, 320, 97)
+TEST_SCALEPLAN(Down2, 640, 360, 320, 180)
+TEST_SCALEPLAN(Down4, 640, 360, 160, 90)
+TEST_SCALEPLAN(Down, 640, 360, 427, 239)
+TEST_SCALEPLAN(Up, 320, 180, 641, 361)
+TEST_SCALEPLAN(Up2, 320, 180, 640, 360)
+TEST_SCALEPLAN(Invert, 320, -180, 213, 120)
+TEST_SCALEPLAN1(Down, 640, 360, 427, 239, Lanczos3)
+TEST_SCALEPLAN1(Up, 320, 180, 641, 361, Bicubic)
+TEST_SCALEPLAN1(Mirror, -320, 180, 213, 120, Lanczos3)
+TEST_SCALEPLAN1(MirrorInvert, -320, -180, 641, 361, Bicubic)
+#undef TEST_SCALEPLAN1
+#undef TEST_SCALEPLAN
+
+// Warp with C and optimized row functions.  Matrix entries that are
+// multiples of 1/256 keep the float coordinates exact, so both match.
+static int ARGBWarpAffineTestFilter(int src_width,
+                                    int src_height,
+                                    int dst_width,
+                                    int dst_height,
+                                    const float* matrix,
+                                    FilterMode f,
+                                    int benchmark_iterations,
+                                    int disable_cpu_flags,
+                                    int benchmark_cpu_info) {
+  int i;
+  const int kBpp = 4;
+  const int src_stride = src_width * kBpp;
+  const int dst_stride = dst_width * kBpp;
+  const int64_t src_size = static_cast<int64_t>(src_stride) * src_height;
+  const int64_t dst_size = static_cast<int64_t>(dst_stride) * dst_height;
+  align_buffer_page_end(src_argb, src_size);
+  align_buffer_page_end(dst_argb_c, dst_size);
+  align_buffer_page_end(dst_argb_opt, dst_size);
+  MemRandomize(src_argb, src_size);
+  memset(dst_argb_c, 2, dst_size);
+  memset(dst_argb_opt, 3, dst_size);
+
+  MaskCpuFlags(disable_cpu_flags);  // Disable all CPU optimization.
+  double c_time = get_time();
+  EXPECT_EQ(0, ARGBWarpAffine(src_argb, src_stride, src_width, src_height,
+                              dst_argb_c, dst_stride, dst_width, dst_height,
+                              matrix, f, 0x80402010u));
+  c_time = (get_time() - c_time);
+
+  MaskCpuFlags(benchmark_cpu_info);  // Enable all CPU optimization.
+  double opt_time = get_time();
+  for (i = 0; i < benchmark_iterations; ++i) {
+    ARGBWarpAffine(src_argb, src_stride, src_width, src_height, dst_argb_opt,
+                   dst_stride, dst_width, dst_height, matrix, f, 0x80402010u);
+  }
+  opt_time = (get_time() - opt_time) / benchmark_iterations;
+  printf("filter %d - %8d us C - %8d us OPT\n", f,
+         static_cast<int>(c_time * 1e6), static_cast<int>(opt_time * 1e6));
+
+  int max_diff = 0;
+  for (i = 0; i < dst_size; ++i) {
+    int abs_diff = Abs(dst_argb_c[i] - dst_argb_opt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(src_argb);
+  free_aligned_buffer_page_end(dst_argb_c);
+  free_aligned_buffer_page_end(dst_argb_opt);
+  return max_diff;
+}
+
+// Rotate by about 14 degrees around the center.
+#define TEST_WARPAFFINE(filter)                                             \
+  TEST_F(LibYUVScaleTest, ARGBWarpAffine_##filter) {                        \
+    const int kWidth = benchmark_width_ | 1;                                \
+    const int kHeight = benchmark_height_;                                  \
+    const float kMatrix[6] = {                                              \
+        0.96875f, -0.25f, 0.015625f * static_cast<int>(kWidth * 1.25f),     \
+        0.25f,    0.96875f, -0.015625f * static_cast<int>(kWidth * 7.5f)};  \
+    int diff = ARGBWarpAffineTestFilter(                                    \
+        kWidth, kHeight, kWidth, kHeight, kMatrix, kFilter##filter,         \
+        benchmark_iterations_, disable_cpu_flags_, benchmark_cpu_info_);    \
+    EXPECT_EQ(0, diff);                                                     \
+  }
+
+TEST_WARPAFFINE(None)
+TEST_WARPAFFINE(Bilinear)
+#undef TEST_WARPAFFINE
+
+TEST_F(LibYUVScaleTest, ARGBWarpAffine_Zoom) {
+  // Scale by 3/4 and pan by a fraction of a pixel.
+  const float kMatrix[6] = {0.75f, 0.f, 3.375f, 0.f, 0.75f, -1.5f};
+  EXPECT_EQ(0, ARGBWarpAffineTestFilter(
+                   301, 167, 257, 203, kMatrix, kFilterBilinear, 1,
+                   disable_cpu_flags_, benchmark_cpu_info_));
+  EXPECT_EQ(0, ARGBWarpAffineTestFilter(301, 167, 257, 203, kMatrix,
+                                        kFilterNone, 1, disable_cpu_flags_,
+                                        benchmark_cpu_info_));
+}
+
+TEST_F(LibYUVScaleTest, ARGBWarpAffine_Identity) {
+  const int kWidth = 131;
+  const int kHeight = 67;
+  const float kMatrix[6] = {1.f, 0.f, 0.f, 0.f, 1.f, 0.f};
+  align_buffer_page_end(src_argb, kWidth * kHeight * 4);
+  align_buffer_page_end(dst_argb, kWidth * kHeight * 4);
+  MemRandomize(src_argb, kWidth * kHeight * 4);
+  for (int f = 0; f < 2; ++f) {
+    memset(dst_argb, 0, kWidth * kHeight * 4);
+    EXPECT_EQ(0, ARGBWarpAffine(src_argb, kWidth * 4, kWidth, kHeight,
+                                dst_argb, kWidth * 4, kWidth, kHeight, kMatrix,
+                                f ? kFilterBilinear : kFilterNone, 0u));
+    for (int i = 0; i < kWidth * kHeight * 4; ++i) {
+      EXPECT_EQ(src_argb[i], dst_argb[i]);
+    }
+  }
+  free_aligned_buffer_page_end(src_argb);
+  free_aligned_buffer_page_end(dst_argb);
+}
+
+TEST_F(LibYUVScaleTest, ARGBWarpAffine_Rotate) {
+  const int kWidth = 131;
+  const int kHeight = 67;
+  // 180 degrees and 90 degrees clockwise.
+  const float kMatrix180[6] = {-1.f, 0.f, kWidth, 0.f, -1.f, kHeight};
+  const float kMatrix90[6] = {0.f, 1.f, 0.f, -1.f, 0.f, kHeight};
+  align_buffer_page_end(src_argb, kWidth * kHeight * 4);
+  align_buffer_page_end(dst_argb, kWidth * kHeight * 4);
+  align_buffer_page_end(dst_rotate, kWidth * kHeight * 4);
+  MemRandomize(src_argb, kWidth * kHeight * 4);
+
+  ARGBRotate(src_argb, kWidth * 4, dst_rotate, kWidth * 4, kWidth, kHeight,
+             kRotate180);
+  EXPECT_EQ(0, ARGBWarpAffine(src_argb, kWidth * 4, kWidth, kHeight, dst_argb,
+                              kWidth * 4, kWidth, kHeight, kMatrix180,
+                              kFilterNone, 0u));
+  for (int i = 0; i < kWidth * kHeight * 4; ++i) {
+    EXPECT_EQ(dst_rotate[i], dst_argb[i]);
+  }
+
+  ARGBRotate(src_argb, kWidth * 4, dst_rotate, kHeight * 4, kWidth, kHeight,
+             kRotate90);
+  EXPECT_EQ(0, ARGBWarpAffine(src_argb, kWidth * 4, kWidth, kHeight, dst_argb,
+                              kHeight * 4, kHeight, kWidth, kMatrix90,
+                              kFilterBilinear, 0u));
+  for (int i = 0; i < kWidth * kHeight * 4; ++i) {
+    EXPECT_EQ(dst_rotate[i], dst_argb[i]);
+  }
+
+  free_aligned_buffer_page_end(src_argb);
+  free_aligned_buffer_page_end(dst_argb);
+  free_aligned_buffer_page_end(dst_rotate);
+}
+
+TEST_F(LibYUVScaleTest, ARGBWarpAffine_Invert) {
+  const int kWidth = 44;
+  const int kHeight = 47;
+  const int kStride = 184;
+  const int kDstWidth = 28;
+  const int kDstHeight = 116;
+  const float kMatrix[6] = {-0.3502f, -2.0706f, 2.6667f,
+                            2.0706f,  -0.3502f, -17.667f};
+  align_buffer_page_end(src_argb, kStride * kHeight);
+  align_buffer_page_end(src_flip, kStride * kHeight);
+  align_buffer_page_end(dst_argb, kDstWidth * kDstHeight * 4);
+  align_buffer_page_end(dst_flip, kDstWidth * kDstHeight * 4);
+  MemRandomize(src_argb, kStride * kHeight);
+  ARGBCopy(src_argb, kStride, src_flip, kStride, kWidth, -kHeight);
+  for (int f = 0; f < 2; ++f) {
+    const FilterMode kFilter = f ? kFilterBilinear : kFilterNone;
+    memset(dst_argb, 1, kDstWidth * kDstHeight * 4);
+    memset(dst_flip, 2, kDstWidth * kDstHeight * 4);
+    EXPECT_EQ(0, ARGBWarpAffine(src_argb, kStride, kWidth, -kHeight, dst_argb,
+                                kDstWidth * 4, kDstWidth, kDstHeight, kMatrix,
+                                kFilter, 0x80402010u));
+    EXPECT_EQ(0, ARGBWarpAffine(src_flip, kStride, kWidth, kHeight, dst_flip,
+                                kDstWidth * 4, kDstWidth, kDstHeight, kMatrix,
+                                kFilter, 0x80402010u));
+    for (int i = 0; i < kDstWidth * kDstHeight * 4; ++i) {
+      EXPECT_EQ(dst_flip[i], dst_argb[i]);
+    }
+  }
+  free_aligned_buffer_page_end(src_argb);
+  free_aligned_buffer_page_end(src_flip);
+  free_aligned_buffer_page_end(dst_argb);
+  free_aligned_buffer_page_end(dst_flip);
+}
+
+// Sources of 1 or 2 pixels wide or high are smaller than the span margin and
+// are sampled entirely by the edge path.
+TEST_F(LibYUVScaleTest, ARGBWarpAffine_Tiny) {
+  const float kMatrix[6] = {0.96875f, -0.25f, 0.5f, 0.25f, 0.96875f, -0.75f};
+  const float kZoom[6] = {0.171875f, 0.f, 0.f, 0.f, 0.0625f, 0.f};
+  for (int f = 0; f < 2; ++f) {
+    const FilterMode kFilter = f ? kFilterBilinear : kFilterNone;
+    for (int n = 1; n <= 2; ++n) {
+      EXPECT_EQ(0, ARGBWarpAffineTestFilter(n, 37, 64, 19, kMatrix, kFilter, 1,
+                                            disable_cpu_flags_,
+                                            benchmark_cpu_info_));
+      EXPECT_EQ(0, ARGBWarpAffineTestFilter(37, n, 64, 19, kMatrix, kFilter, 1,
+                                            disable_cpu_flags_,
+                                            benchmark_cpu_info_));
+      EXPECT_EQ(0, ARGBWarpAffineTestFilter(n, 37, 64, 19, kZoom, kFilter, 1,
+                                            disable_cpu_flags_,
+                                            benchmark_cpu_info_));
+    }
+    EXPECT_EQ(0, ARGBWarpAffineTestFilter(11, 1, 64, 19, kZoom, kFilter, 1,
+                                          disable_cpu_flags_,
+                                          benchmark_cpu_info_));
+  }
+}
+
+TEST_F(LibYUVScaleTest, ARGBWarpAffine_Border) {
+  const int kWidth = 64;
+  const int kHeight = 32;
+  const uint32_t kBorder = 0xff00ff00u;
+  // Pan right by half the width and down by 4 rows.
+  const float kMatrix[6] = {1.f, 0.f, -32.f, 0.f, 1.f, -4.f};
+  align_buffer_page_end(src_argb, kWidth * kHeight * 4);
+  align_buffer_page_end(dst_argb, kWidth * kHeight * 4);
+  MemRandomize(src_argb, kWidth * kHeight * 4);
+  EXPECT_EQ(0, ARGBWarpAffine(src_argb, kWidth * 4, kWidth, kHeight, dst_argb,
+                              kWidth * 4, kWidth, kHeight, kMatrix,
+                              kFilterNone, kBorder));
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      uint32_t d;
+      memcpy(&d, dst_argb + (y * kWidth + x) * 4, 4);
+      if (x < 32 || y < 4) {
+        EXPECT_EQ(kBorder, d);
+      } else {
+        EXPECT_EQ(0, memcmp(dst_argb + (y * kWidth + x) * 4,
+                            src_argb + ((y - 4) * kWidth + x - 32) * 4, 4));
+      }
+    }
+  }
+  EXPECT_EQ(-1, ARGBWarpAffine(src_argb, kWidth * 4, kWidth, kHeight, dst_argb,
+                               kWidth * 4, kWidth, kHeight, NULL, kFilterNone,
+                               kBorder));
+  free_aligned_buffer_page_end(src_argb);
+  free_aligned_buffer_page_end(dst_argb);
+}
+
 }  // namespace libyuv
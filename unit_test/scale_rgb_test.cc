@@ -12,7 +12,10 @@
 #include <time.h>
 
 #include "../unit_test/unit_test.h"
+#include "libyuv/convert_argb.h"
+#include "libyuv/convert_from_argb.h"
 #include "libyuv/cpu_id.h"
+#include "libyuv/scale_argb.h"
 #include "libyuv/scale_rgb.h"
 
 namespace libyuv {
@@ -277,4 +280,90 @@ TEST_F(LibYUVScaleTest, RGBTest4x) {
   free_aligned_buffer_page_end(orig_pixels);
 }
 
+// Compare row streamed RGBScale to converting the whole frame to ARGB,
+// scaling it and converting back.  Results are exact.
+static int RGBTestReference(int src_width,
+                            int src_height,
+                            int dst_width,
+                            int dst_height,
+                            FilterMode f) {
+  const int abs_src_height = Abs(src_height);
+  const int src_stride_rgb = src_width * 3;
+  const int dst_stride_rgb = dst_width * 3;
+  align_buffer_page_end(src_rgb, src_stride_rgb * abs_src_height);
+  align_buffer_page_end(src_argb, src_width * abs_src_height * 4);
+  align_buffer_page_end(dst_argb, dst_width * dst_height * 4);
+  align_buffer_page_end(dst_rgb_ref, dst_stride_rgb * dst_height);
+  align_buffer_page_end(dst_rgb, dst_stride_rgb * dst_height);
+  MemRandomize(src_rgb, src_stride_rgb * abs_src_height);
+  memset(dst_rgb_ref, 2, dst_stride_rgb * dst_height);
+  memset(dst_rgb, 3, dst_stride_rgb * dst_height);
+
+  RGB24ToARGB(src_rgb, src_stride_rgb, src_argb, src_width * 4, src_width,
+              src_height);
+  ARGBScale(src_argb, src_width * 4, src_width, abs_src_height, dst_argb,
+            dst_width * 4, dst_width, dst_height, f);
+  ARGBToRGB24(dst_argb, dst_width * 4, dst_rgb_ref, dst_stride_rgb, dst_width,
+              dst_height);
+  EXPECT_EQ(0, RGBScale(src_rgb, src_stride_rgb, src_width, src_height,
+                        dst_rgb, dst_stride_rgb, dst_width, dst_height, f));
+
+  // The same scale with caller scratch.
+  const int scratch_size =
+      RGBScaleScratchSize(src_width, src_height, dst_width, dst_height, f);
+  EXPECT_LT(0, scratch_size);
+  align_buffer_page_end(scratch, scratch_size);
+  align_buffer_page_end(dst_rgb_scratch, dst_stride_rgb * dst_height);
+  memset(dst_rgb_scratch, 4, dst_stride_rgb * dst_height);
+  EXPECT_EQ(0, RGBScaleScratch(src_rgb, src_stride_rgb, src_width, src_height,
+                               dst_rgb_scratch, dst_stride_rgb, dst_width,
+                               dst_height, f, scratch, scratch_size));
+  EXPECT_EQ(-1, RGBScaleScratch(src_rgb, src_stride_rgb, src_width, src_height,
+                                dst_rgb_scratch, dst_stride_rgb, dst_width,
+                                dst_height, f, scratch, scratch_size - 1));
+
+  int max_diff = 0;
+  for (int i = 0; i < dst_stride_rgb * dst_height; ++i) {
+    int abs_diff = Abs(dst_rgb_ref[i] - dst_rgb[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+    abs_diff = Abs(dst_rgb[i] - dst_rgb_scratch[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(dst_rgb_scratch);
+  free_aligned_buffer_page_end(scratch);
+  free_aligned_buffer_page_end(dst_rgb);
+  free_aligned_buffer_page_end(dst_rgb_ref);
+  free_aligned_buffer_page_end(dst_argb);
+  free_aligned_buffer_page_end(src_argb);
+  free_aligned_buffer_page_end(src_rgb);
+  return max_diff;
+}
+
+#define TEST_RGBREFERENCE(name, sw, sh, dw, dh)                           \
+  TEST_F(LibYUVScaleTest, RGBScaleReference_##name##_None) {             \
+    EXPECT_EQ(0, RGBTestReference(sw, sh, dw, dh, kFilterNone));         \
+  }                                                                      \
+  TEST_F(LibYUVScaleTest, RGBScaleReference_##name##_Bilinear) {         \
+    EXPECT_EQ(0, RGBTestReference(sw, sh, dw, dh, kFilterBilinear));     \
+  }                                                                      \
+  TEST_F(LibYUVScaleTest, RGBScaleReference_##name##_Box) {              \
+    EXPECT_EQ(0, RGBTestReference(sw, sh, dw, dh, kFilterBox));          \
+  }
+
+TEST_RGBREFERENCE(Down2, 1280, 720, 640, 360)
+TEST_RGBREFERENCE(Down4, 1280, 720, 320, 180)
+TEST_RGBREFERENCE(Down, 1281, 723, 301, 177)
+TEST_RGBREFERENCE(DownBig, 2560, 1440, 80, 45)
+TEST_RGBREFERENCE(Up, 161, 91, 640, 361)
+TEST_RGBREFERENCE(Vertical, 640, 361, 640, 200)
+TEST_RGBREFERENCE(Copy, 321, 241, 321, 241)
+TEST_RGBREFERENCE(Invert, 641, -363, 320, 180)
+TEST_RGBREFERENCE(InvertUp, 161, -91, 640, 360)
+#undef TEST_RGBREFERENCE
+
 }  // namespace libyuv
@@ -11,9 +11,16 @@
 #include <stdlib.h>
 #include <time.h>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include "../unit_test/unit_test.h"
 #include "libyuv/cpu_id.h"
 #include "libyuv/scale.h"
+#include "libyuv/scale_argb.h"
+#include "libyuv/scale_uv.h"
 
 #ifdef ENABLE_ROW_TESTS
 #include "libyuv/scale_row.h"  // For ScaleRowDown2Box_Odd_C
@@ -921,6 +928,14 @@ TEST_FACTOR(8, 1, 8, 0)
 TEST_FACTOR(3by4, 3, 4, 1)
 TEST_FACTOR(3by8, 3, 8, 1)
 TEST_FACTOR(3, 1, 3, 0)
+// Polyphase filters are bit exact for SIMD vs C, which the I420, I444 and
+// NV12 tests check.  The DISABLED_ argument only applies to the _12 and _16
+// tests, which compare the 8 bit scaler to the 16 bit one.  For polyphase
+// those differ by design: 8 bit clamps ringing to 0 to 255, while 16 bit
+// clamps to the pixels under the kernel so a 10 or 12 bit plane stays in
+// range.
+TEST_FACTOR1(DISABLED_, 2, Bicubic, 1, 2, 0)
+TEST_FACTOR1(DISABLED_, 3by4, Lanczos3, 3, 4, 0)
 #undef TEST_FACTOR1
 #undef TEST_FACTOR
 #undef SX
@@ -1059,6 +1074,9 @@ TEST_SCALETO(Scale, 1280, 720)
 TEST_SCALETO(Scale, 1920, 1080)
 TEST_SCALETO(Scale, 1080, 1920)  // for rotated phones
 #endif                           // DISABLE_SLOW_TESTS
+// Polyphase.  Only the _12 and _16 tests are disabled, as for TEST_FACTOR1.
+TEST_SCALETO1(DISABLED_, Scale, 569, 480, Bicubic, 0)
+TEST_SCALETO1(DISABLED_, Scale, 640, 360, Lanczos3, 0)
 #undef TEST_SCALETO1
 #undef TEST_SCALETO
 
@@ -1132,4 +1150,645 @@ TEST_SCALESWAPXY1(DISABLED_, Scale, Box, 3)
 #endif
 #undef TEST_SCALESWAPXY1
 
+// Executor for the MT scalers that runs jobs on 4 threads, each taking the
+// next job index until none are left.
+static void ThreadedExecutor(void* executor_context,
+                             ScaleJobFunc job,
+                             void* job_context,
+                             int count) {
+  std::atomic<int> next(0);
+  (void)executor_context;
+  auto worker = [&]() {
+    for (int i = next++; i < count; i = next++) {
+      job(job_context, i);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 3; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+// Test I420ScaleMT and NV12ScaleMT against the single threaded scalers.
+// Returns the number of pixels that differ.  0 = exact.
+static int I420TestFilterMT(int src_width,
+                            int src_height,
+                            int dst_width,
+                            int dst_height,
+                            FilterMode f,
+                            int num_bands,
+                            int benchmark_iterations) {
+  if (!SizeValid(src_width, src_height, dst_width, dst_height)) {
+    return 0;
+  }
+  int i;
+  int src_width_uv = (Abs(src_width) + 1) >> 1;
+  int src_height_uv = (Abs(src_height) + 1) >> 1;
+  int dst_width_uv = (dst_width + 1) >> 1;
+  int dst_height_uv = (dst_height + 1) >> 1;
+  int64_t src_y_plane_size = Abs(src_width) * Abs(src_height);
+  int64_t src_uv_plane_size = src_width_uv * src_height_uv * 2;
+  int64_t dst_y_plane_size = dst_width * dst_height;
+  int64_t dst_uv_plane_size = dst_width_uv * dst_height_uv * 2;
+
+  align_buffer_page_end(src_y, src_y_plane_size);
+  align_buffer_page_end(src_uv, src_uv_plane_size);
+  align_buffer_page_end(dst_y_c, dst_y_plane_size);
+  align_buffer_page_end(dst_uv_c, dst_uv_plane_size);
+  align_buffer_page_end(dst_y_opt, dst_y_plane_size);
+  align_buffer_page_end(dst_uv_opt, dst_uv_plane_size);
+  MemRandomize(src_y, src_y_plane_size);
+  MemRandomize(src_uv, src_uv_plane_size);
+  memset(dst_y_opt, 1, dst_y_plane_size);
+  memset(dst_uv_opt, 2, dst_uv_plane_size);
+
+  // I420 with U and V as the two halves of the uv buffers.
+  const uint8_t* src_u = src_uv;
+  const uint8_t* src_v = src_uv + src_uv_plane_size / 2;
+  uint8_t* dst_u_c = dst_uv_c;
+  uint8_t* dst_v_c = dst_uv_c + dst_uv_plane_size / 2;
+  uint8_t* dst_u_opt = dst_uv_opt;
+  uint8_t* dst_v_opt = dst_uv_opt + dst_uv_plane_size / 2;
+  I420Scale(src_y, Abs(src_width), src_u, src_width_uv, src_v, src_width_uv,
+            src_width, src_height, dst_y_c, dst_width, dst_u_c, dst_width_uv,
+            dst_v_c, dst_width_uv, dst_width, dst_height, f);
+  for (i = 0; i < benchmark_iterations; ++i) {
+    I420ScaleMT(src_y, Abs(src_width), src_u, src_width_uv, src_v,
+                src_width_uv, src_width, src_height, dst_y_opt, dst_width,
+                dst_u_opt, dst_width_uv, dst_v_opt, dst_width_uv, dst_width,
+                dst_height, f, num_bands, ThreadedExecutor, NULL);
+  }
+  int diff = 0;
+  for (i = 0; i < dst_y_plane_size; ++i) {
+    diff += dst_y_c[i] != dst_y_opt[i];
+  }
+  for (i = 0; i < dst_uv_plane_size; ++i) {
+    diff += dst_uv_c[i] != dst_uv_opt[i];
+  }
+
+  NV12Scale(src_y, Abs(src_width), src_uv, src_width_uv * 2, src_width,
+            src_height, dst_y_c, dst_width, dst_uv_c, dst_width_uv * 2,
+            dst_width, dst_height, f);
+  NV12ScaleMT(src_y, Abs(src_width), src_uv, src_width_uv * 2, src_width,
+              src_height, dst_y_opt, dst_width, dst_uv_opt, dst_width_uv * 2,
+              dst_width, dst_height, f, num_bands, ThreadedExecutor, NULL);
+  for (i = 0; i < dst_y_plane_size; ++i) {
+    diff += dst_y_c[i] != dst_y_opt[i];
+  }
+  for (i = 0; i < dst_uv_plane_size; ++i) {
+    diff += dst_uv_c[i] != dst_uv_opt[i];
+  }
+
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_uv);
+  free_aligned_buffer_page_end(dst_y_c);
+  free_aligned_buffer_page_end(dst_uv_c);
+  free_aligned_buffer_page_end(dst_y_opt);
+  free_aligned_buffer_page_end(dst_uv_opt);
+  return diff;
+}
+
+// Multithreaded scaling must be bit exact with the single threaded path for
+// every specialized scaler, so sizes cover each of them.
+#define TEST_SCALEMT1(name, src_width, src_height, dst_width, dst_height,   \
+                      filter)                                               \
+  TEST_F(LibYUVScaleTest, I420ScaleMT##name##_##filter) {                   \
+    int diff = I420TestFilterMT(src_width, src_height, dst_width,           \
+                                dst_height, kFilter##filter, 7,             \
+                                benchmark_iterations_);                     \
+    ASSERT_EQ(0, diff);                                                     \
+  }
+
+#define TEST_SCALEMT(name, src_width, src_height, dst_width, dst_height)      \
+  TEST_SCALEMT1(name, src_width, src_height, dst_width, dst_height, None)     \
+  TEST_SCALEMT1(name, src_width, src_height, dst_width, dst_height, Linear)   \
+  TEST_SCALEMT1(name, src_width, src_height, dst_width, dst_height, Bilinear) \
+  TEST_SCALEMT1(name, src_width, src_height, dst_width, dst_height, Box)
+
+TEST_SCALEMT(Copy, 640, 360, 640, 360)
+TEST_SCALEMT(Vertical, 640, 360, 640, 250)
+TEST_SCALEMT(VerticalUp, 640, 360, 640, 577)
+TEST_SCALEMT(Down2, 1280, 720, 640, 360)
+TEST_SCALEMT(Down4, 1280, 720, 320, 180)
+TEST_SCALEMT(Down34, 1280, 720, 960, 540)
+TEST_SCALEMT(Down38, 1280, 720, 480, 270)
+TEST_SCALEMT(Down, 1280, 720, 853, 480)
+TEST_SCALEMT(DownBox, 1920, 1080, 423, 233)
+TEST_SCALEMT(Up, 640, 360, 1280, 721)
+TEST_SCALEMT(Up2, 640, 360, 1280, 720)
+TEST_SCALEMT(Up2Odd, 321, 181, 641, 361)
+TEST_SCALEMT(SwapXY, 640, 360, 360, 640)
+TEST_SCALEMT(Invert, 640, -360, 853, 480)
+TEST_SCALEMT1(Down, 1280, 720, 853, 480, Lanczos3)
+TEST_SCALEMT1(DownLarge, 1920, 1080, 320, 180, Bicubic)
+TEST_SCALEMT1(Up, 640, 360, 1280, 721, Bicubic)
+TEST_SCALEMT1(SwapXY, 640, 360, 360, 640, Lanczos3)
+#undef TEST_SCALEMT1
+#undef TEST_SCALEMT
+
+// Test I420ScaleMulti and NV12ScaleMulti against I420Scale and NV12Scale of
+// each destination, from the source or, for a destination cascaded from one
+// twice its size, from that destination.  sizes holds num_dst width and
+// height pairs.  Returns the number of pixels that differ.  0 = exact.
+static int I420TestFilterMulti(int src_width,
+                               int src_height,
+                               const int* sizes,
+                               int num_dst,
+                               FilterMode f,
+                               int benchmark_iterations) {
+  int i, j, k;
+  const int src_width_uv = (src_width + 1) >> 1;
+  const int src_height_uv = (Abs(src_height) + 1) >> 1;
+  const int64_t src_y_plane_size = src_width * Abs(src_height);
+  const int64_t src_uv_plane_size = src_width_uv * src_height_uv * 2;
+  int64_t dst_offset[8 + 1];
+  dst_offset[0] = 0;
+  for (j = 0; j < num_dst; ++j) {
+    const int dst_width_uv = (sizes[j * 2] + 1) >> 1;
+    const int dst_height_uv = (sizes[j * 2 + 1] + 1) >> 1;
+    dst_offset[j + 1] = dst_offset[j] + sizes[j * 2] * sizes[j * 2 + 1] +
+                        dst_width_uv * dst_height_uv * 2;
+  }
+  const int64_t dst_size = dst_offset[num_dst];
+
+  align_buffer_page_end(src_y, src_y_plane_size);
+  align_buffer_page_end(src_uv, src_uv_plane_size);
+  align_buffer_page_end(dst_c, dst_size);
+  align_buffer_page_end(dst_opt, dst_size);
+  MemRandomize(src_y, src_y_plane_size);
+  MemRandomize(src_uv, src_uv_plane_size);
+  memset(dst_opt, 1, dst_size);
+
+  // I420 with U and V as the two halves of the uv buffers.
+  I420ScaleDest dst_i420[8];
+  NV12ScaleDest dst_nv12[8];
+  for (j = 0; j < num_dst; ++j) {
+    const int dst_width = sizes[j * 2];
+    const int dst_height = sizes[j * 2 + 1];
+    const int dst_width_uv = (dst_width + 1) >> 1;
+    const int dst_height_uv = (dst_height + 1) >> 1;
+    uint8_t* dst_y = dst_opt + dst_offset[j];
+    uint8_t* dst_u = dst_y + dst_width * dst_height;
+    dst_i420[j] = {dst_y,
+                   dst_width,
+                   dst_u,
+                   dst_width_uv,
+                   dst_u + dst_width_uv * dst_height_uv,
+                   dst_width_uv,
+                   dst_width,
+                   dst_height};
+    dst_nv12[j] = {dst_y, dst_width, dst_u, dst_width_uv * 2,
+                   dst_width, dst_height};
+  }
+
+  // References are made largest first, so cascaded destinations are scaled
+  // from a finished reference.
+  int order[8];
+  for (j = 0; j < num_dst; ++j) {
+    order[j] = j;
+  }
+  std::stable_sort(order, order + num_dst, [sizes](int a, int b) {
+    return sizes[a * 2] * sizes[a * 2 + 1] > sizes[b * 2] * sizes[b * 2 + 1];
+  });
+
+  int diff = 0;
+  for (k = 0; k < 2; ++k) {
+    const bool nv12 = k == 1;
+    for (int n = 0; n < num_dst; ++n) {
+      j = order[n];
+      const int dst_width = sizes[j * 2];
+      const int dst_height = sizes[j * 2 + 1];
+      const int dst_width_uv = (dst_width + 1) >> 1;
+      const int dst_height_uv = (dst_height + 1) >> 1;
+      const uint8_t* from_y = src_y;
+      const uint8_t* from_uv = src_uv;
+      int from_width = src_width;
+      int from_height = src_height;
+      int from_width_uv = src_width_uv;
+      int from_height_uv = src_height_uv;
+      // Cascaded from the first destination with twice the size.
+      for (i = 0; i < num_dst && (f == kFilterBilinear || f == kFilterBox);
+           ++i) {
+        if (sizes[i * 2] == dst_width * 2 &&
+            sizes[i * 2 + 1] == dst_height * 2) {
+          from_y = dst_c + dst_offset[i];
+          from_uv = from_y + sizes[i * 2] * sizes[i * 2 + 1];
+          from_width = sizes[i * 2];
+          from_height = sizes[i * 2 + 1];
+          from_width_uv = (from_width + 1) >> 1;
+          from_height_uv = (from_height + 1) >> 1;
+          break;
+        }
+      }
+      uint8_t* dst_y = dst_c + dst_offset[j];
+      uint8_t* dst_u = dst_y + dst_width * dst_height;
+      if (nv12) {
+        NV12Scale(from_y, from_width, from_uv, from_width_uv * 2, from_width,
+                  from_height, dst_y, dst_width, dst_u, dst_width_uv * 2,
+                  dst_width, dst_height, f);
+      } else {
+        I420Scale(from_y, from_width, from_uv, from_width_uv,
+                  from_uv + from_width_uv * from_height_uv, from_width_uv,
+                  from_width, from_height, dst_y, dst_width, dst_u,
+                  dst_width_uv, dst_u + dst_width_uv * dst_height_uv,
+                  dst_width_uv, dst_width, dst_height, f);
+      }
+    }
+    for (i = 0; i < benchmark_iterations; ++i) {
+      if (nv12) {
+        EXPECT_EQ(0, NV12ScaleMulti(src_y, src_width, src_uv, src_width_uv * 2,
+                                    src_width, src_height, dst_nv12, num_dst,
+                                    f));
+      } else {
+        EXPECT_EQ(0, I420ScaleMulti(src_y, src_width, src_uv, src_width_uv,
+                                    src_uv + src_uv_plane_size / 2,
+                                    src_width_uv, src_width, src_height,
+                                    dst_i420, num_dst, f));
+      }
+    }
+    for (i = 0; i < dst_size; ++i) {
+      diff += dst_c[i] != dst_opt[i];
+    }
+  }
+
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_uv);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+  return diff;
+}
+
+#define TEST_SCALEMULTI1(name, src_width, src_height, filter, ...)           \
+  TEST_F(LibYUVScaleTest, I420ScaleMulti##name##_##filter) {                \
+    static const int kSizes[] = {__VA_ARGS__};                              \
+    int diff = I420TestFilterMulti(                                         \
+        src_width, src_height, kSizes,                                      \
+        static_cast<int>(sizeof(kSizes) / sizeof(kSizes[0]) / 2),           \
+        kFilter##filter, benchmark_iterations_);                            \
+    ASSERT_EQ(0, diff);                                                     \
+  }
+
+#define TEST_SCALEMULTI(name, src_width, src_height, ...)                   \
+  TEST_SCALEMULTI1(name, src_width, src_height, None, __VA_ARGS__)          \
+  TEST_SCALEMULTI1(name, src_width, src_height, Linear, __VA_ARGS__)        \
+  TEST_SCALEMULTI1(name, src_width, src_height, Bilinear, __VA_ARGS__)      \
+  TEST_SCALEMULTI1(name, src_width, src_height, Box, __VA_ARGS__)
+
+TEST_SCALEMULTI(Ladder1080, 1920, 1080, 1920, 1080, 960, 540, 480, 270)
+TEST_SCALEMULTI(Ladder720, 1920, 1080, 320, 180, 1280, 720, 640, 360)
+TEST_SCALEMULTI(Mixed, 1280, 720, 853, 480, 427, 240, 640, 360, 160, 90, 320,
+                180, 1280, 719)
+TEST_SCALEMULTI(Up, 640, 360, 1280, 720, 641, 361, 320, 180)
+TEST_SCALEMULTI(Odd, 321, 181, 160, 90, 80, 45, 107, 61)
+TEST_SCALEMULTI(Invert, 640, -360, 320, 180, 160, 90, 213, 120)
+TEST_SCALEMULTI1(Ladder720, 1920, 1080, Lanczos3, 320, 180, 1280, 720, 640, 360)
+TEST_SCALEMULTI1(Up, 640, 360, Bicubic, 1280, 720, 641, 361, 320, 180)
+#undef TEST_SCALEMULTI1
+#undef TEST_SCALEMULTI
+
+TEST_F(LibYUVScaleTest, I420ScaleMulti_BadArgs) {
+  align_buffer_page_end(buf, 64 * 64 * 2);
+  I420ScaleDest dst = {buf, 32, buf, 16, buf, 16, 32, 32};
+  I420ScaleDest dst9[9];
+  for (int i = 0; i < 9; ++i) {
+    dst9[i] = dst;
+  }
+  EXPECT_EQ(0, I420ScaleMulti(buf, 64, buf, 32, buf, 32, 64, 64, &dst, 1,
+                              kFilterBox));
+  EXPECT_EQ(-1, I420ScaleMulti(buf, 64, buf, 32, buf, 32, 64, 64, dst9, 9,
+                               kFilterBox));
+  EXPECT_EQ(-1, I420ScaleMulti(buf, 64, buf, 32, buf, 32, 64, 64, &dst, 0,
+                               kFilterBox));
+  EXPECT_EQ(-1, I420ScaleMulti(buf, 64, buf, 32, buf, 32, 64, 64, NULL, 1,
+                               kFilterBox));
+  dst.dst_v = NULL;
+  EXPECT_EQ(-1, I420ScaleMulti(buf, 64, buf, 32, buf, 32, 64, 64, &dst, 1,
+                               kFilterBox));
+  NV12ScaleDest dst_nv12 = {buf, 32, buf, 32, 32, 0};
+  EXPECT_EQ(-1, NV12ScaleMulti(buf, 64, buf, 64, 64, 64, &dst_nv12, 1,
+                               kFilterBox));
+  free_aligned_buffer_page_end(buf);
+}
+
+// Test that a plan, executed several times, matches ScalePlane and
+// ScalePlane_16.
+static int PlaneTestFilterPlan(int src_width,
+                               int src_height,
+                               int dst_width,
+                               int dst_height,
+                               FilterMode f,
+                               int benchmark_iterations) {
+  if (!SizeValid(src_width, src_height, dst_width, dst_height)) {
+    return 0;
+  }
+  int i, j;
+  int64_t src_plane_size = Abs(src_width) * Abs(src_height);
+  int64_t dst_plane_size = dst_width * dst_height;
+  align_buffer_page_end(src, src_plane_size * 2);
+  align_buffer_page_end(dst_c, dst_plane_size * 2);
+  align_buffer_page_end(dst_opt, dst_plane_size * 2);
+  uint16_t* src_16 = reinterpret_cast<uint16_t*>(src);
+  uint16_t* dst_c_16 = reinterpret_cast<uint16_t*>(dst_c);
+  uint16_t* dst_opt_16 = reinterpret_cast<uint16_t*>(dst_opt);
+
+  ScalePlan* plan = ScalePlanCreate(kScalePlanPlane, src_width, src_height,
+                                    dst_width, dst_height, f);
+  ScalePlan* plan_16 = ScalePlanCreate(kScalePlanPlane_16, src_width,
+                                       src_height, dst_width, dst_height, f);
+  EXPECT_TRUE(plan != NULL);
+  EXPECT_TRUE(plan_16 != NULL);
+  if (!plan || !plan_16) {
+    ScalePlanDestroy(plan);
+    ScalePlanDestroy(plan_16);
+    free_aligned_buffer_page_end(src);
+    free_aligned_buffer_page_end(dst_c);
+    free_aligned_buffer_page_end(dst_opt);
+    return 1;
+  }
+
+  int diff = 0;
+  // Reuse the plans for different images.
+  for (j = 0; j < 2; ++j) {
+    MemRandomize(src, src_plane_size * 2);
+    ScalePlane(src, Abs(src_width), src_width, src_height, dst_c, dst_width,
+               dst_width, dst_height, f);
+    for (i = 0; i < benchmark_iterations; ++i) {
+      EXPECT_EQ(0, ScalePlanExecute(plan, src, Abs(src_width), dst_opt,
+                                    dst_width));
+    }
+    for (i = 0; i < dst_plane_size; ++i) {
+      diff += dst_c[i] != dst_opt[i];
+    }
+
+    for (i = 0; i < src_plane_size; ++i) {
+      src_16[i] &= 0xfff;
+    }
+    ScalePlane_16(src_16, Abs(src_width), src_width, src_height, dst_c_16,
+                  dst_width, dst_width, dst_height, f);
+    EXPECT_EQ(0, ScalePlanExecute_16(plan_16, src_16, Abs(src_width),
+                                     dst_opt_16, dst_width));
+    for (i = 0; i < dst_plane_size; ++i) {
+      diff += dst_c_16[i] != dst_opt_16[i];
+    }
+  }
+  // Formats are checked.
+  EXPECT_EQ(-1, ScalePlanExecute(plan_16, src, Abs(src_width), dst_opt,
+                                 dst_width));
+  EXPECT_EQ(-1, ScalePlanExecute_16(plan, src_16, Abs(src_width), dst_opt_16,
+                                    dst_width));
+
+  ScalePlanDestroy(plan);
+  ScalePlanDestroy(plan_16);
+  free_aligned_buffer_page_end(src);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+  return diff;
+}
+
+#define TEST_SCALEPLAN1(name, src_width, src_height, dst_width, dst_height, \
+                        filter)                                             \
+  TEST_F(LibYUVScaleTest, ScalePlan##name##_##filter) {                     \
+    int diff = PlaneTestFilterPlan(src_width, src_height, dst_width,        \
+                                   dst_height, kFilter##filter,             \
+                                   benchmark_iterations_);                  \
+    ASSERT_EQ(0, diff);                                                     \
+  }
+
+#define TEST_SCALEPLAN(name, src_width, src_height, dst_width, dst_height)    \
+  TEST_SCALEPLAN1(name, src_width, src_height, dst_width, dst_height, None)   \
+  TEST_SCALEPLAN1(name, src_width, src_height, dst_width, dst_height, Linear) \
+  TEST_SCALEPLAN1(name, src_width, src_height, dst_width, dst_height,         \
+                  Bilinear)                                                   \
+  TEST_SCALEPLAN1(name, src_width, src_height, dst_width, dst_height, Box)
+
+TEST_SCALEPLAN(Copy, 320, 180, 320, 180)
+TEST_SCALEPLAN(Vertical, 320, 180, 320, 97)
+TEST_SCALEPLAN(Down2, 640, 360, 320, 180)
+TEST_SCALEPLAN(Down, 640, 360, 427, 239)
+TEST_SCALEPLAN(DownBox, 1280, 720, 320, 171)
+TEST_SCALEPLAN(Up, 320, 180, 641, 361)
+TEST_SCALEPLAN(Up2, 320, 180, 640, 360)
+TEST_SCALEPLAN(Invert, 320, -180, 213, 120)
+TEST_SCALEPLAN1(Down, 640, 360, 427, 239, Lanczos3)
+TEST_SCALEPLAN1(Up, 320, 180, 641, 361, Bicubic)
+TEST_SCALEPLAN1(Invert, 320, -180, 213, 120, Lanczos3)
+#undef TEST_SCALEPLAN1
+#undef TEST_SCALEPLAN
+
+// Polyphase filters keep flat images flat, including next to the edges where
+// the kernel is cut off.
+TEST_F(LibYUVScaleTest, ScalePlane_PolyphaseFlat) {
+  static const int kSizes[][4] = {{640, 360, 427, 239},
+                                  {320, 180, 641, 361},
+                                  {33, 17, 7, 5},
+                                  {7, 5, 33, 17}};
+  static const FilterMode kFilters[] = {kFilterBicubic, kFilterLanczos3};
+  for (const FilterMode f : kFilters) {
+    for (const auto& size : kSizes) {
+      const int src_size = size[0] * size[1];
+      const int dst_size = size[2] * size[3];
+      align_buffer_page_end(src, src_size * 2);
+      align_buffer_page_end(dst, dst_size * 2);
+      uint16_t* src_16 = reinterpret_cast<uint16_t*>(src);
+      uint16_t* dst_16 = reinterpret_cast<uint16_t*>(dst);
+      int i;
+      memset(src, 173, src_size);
+      EXPECT_EQ(0, ScalePlane(src, size[0], size[0], size[1], dst, size[2],
+                              size[2], size[3], f));
+      for (i = 0; i < dst_size; ++i) {
+        ASSERT_EQ(173, dst[i]);
+      }
+      for (i = 0; i < src_size; ++i) {
+        src_16[i] = 3001;
+      }
+      EXPECT_EQ(0, ScalePlane_16(src_16, size[0], size[0], size[1], dst_16,
+                                 size[2], size[2], size[3], f));
+      for (i = 0; i < dst_size; ++i) {
+        ASSERT_EQ(3001, dst_16[i]);
+      }
+      free_aligned_buffer_page_end(src);
+      free_aligned_buffer_page_end(dst);
+    }
+  }
+}
+
+// 12 bit pixels filtered with negative lobes must stay 12 bit.
+TEST_F(LibYUVScaleTest, ScalePlane_12_PolyphaseRange) {
+  static const FilterMode kFilters[] = {kFilterBicubic, kFilterLanczos3};
+  const int src_width = 320;
+  const int src_height = 180;
+  const int dst_width = 533;
+  const int dst_height = 301;
+  align_buffer_page_end(src, src_width * src_height * 2);
+  align_buffer_page_end(dst, dst_width * dst_height * 2);
+  uint16_t* src_12 = reinterpret_cast<uint16_t*>(src);
+  uint16_t* dst_12 = reinterpret_cast<uint16_t*>(dst);
+  int i;
+  // Alternating black and white columns ring the most.
+  for (i = 0; i < src_width * src_height; ++i) {
+    src_12[i] = (i & 1) ? 4095 : (fastrand() & 15);
+  }
+  for (const FilterMode f : kFilters) {
+    EXPECT_EQ(0, ScalePlane_12(src_12, src_width, src_width, src_height,
+                               dst_12, dst_width, dst_width, dst_height, f));
+    for (i = 0; i < dst_width * dst_height; ++i) {
+      ASSERT_GE(4095, dst_12[i]);
+    }
+  }
+  free_aligned_buffer_page_end(src);
+  free_aligned_buffer_page_end(dst);
+}
+
+// Scale with caller scratch and compare to the allocating scalers.
+static int PlaneTestFilterScratch(int src_width,
+                                  int src_height,
+                                  int dst_width,
+                                  int dst_height,
+                                  FilterMode f) {
+  const int src_halfwidth = (src_width + 1) >> 1;
+  const int src_halfheight = (Abs(src_height) + 1) >> 1;
+  const int dst_halfwidth = (dst_width + 1) >> 1;
+  const int dst_halfheight = (dst_height + 1) >> 1;
+  const int src_y_size = src_width * Abs(src_height);
+  const int src_uv_size = src_halfwidth * src_halfheight;
+  const int dst_y_size = dst_width * dst_height;
+  const int dst_uv_size = dst_halfwidth * dst_halfheight;
+  const int scratch_size =
+      I420ScaleScratchSize(src_width, src_height, dst_width, dst_height, f);
+  const int scratch_size_16 = ScaleScratchSize(
+      kScalePlanPlane_16, src_width, src_height, dst_width, dst_height, f);
+  EXPECT_LE(0, scratch_size);
+  EXPECT_LE(0, scratch_size_16);
+  if (scratch_size < 0 || scratch_size_16 < 0) {
+    return 1;
+  }
+  align_buffer_page_end(src, (src_y_size + src_uv_size * 2) * 2);
+  align_buffer_page_end(dst_c, (dst_y_size + dst_uv_size * 2) * 2);
+  align_buffer_page_end(dst_opt, (dst_y_size + dst_uv_size * 2) * 2);
+  align_buffer_page_end(scratch, scratch_size + scratch_size_16 + 1);
+  uint16_t* src_16 = reinterpret_cast<uint16_t*>(src);
+  uint16_t* dst_c_16 = reinterpret_cast<uint16_t*>(dst_c);
+  uint16_t* dst_opt_16 = reinterpret_cast<uint16_t*>(dst_opt);
+  int i;
+  MemRandomize(src, (src_y_size + src_uv_size * 2) * 2);
+
+  I420Scale(src, src_width, src + src_y_size, src_halfwidth,
+            src + src_y_size + src_uv_size, src_halfwidth, src_width,
+            src_height, dst_c, dst_width, dst_c + dst_y_size, dst_halfwidth,
+            dst_c + dst_y_size + dst_uv_size, dst_halfwidth, dst_width,
+            dst_height, f);
+  // An odd scratch address is aligned internally.
+  EXPECT_EQ(0, I420ScaleScratch(
+                   src, src_width, src + src_y_size, src_halfwidth,
+                   src + src_y_size + src_uv_size, src_halfwidth, src_width,
+                   src_height, dst_opt, dst_width, dst_opt + dst_y_size,
+                   dst_halfwidth, dst_opt + dst_y_size + dst_uv_size,
+                   dst_halfwidth, dst_width, dst_height, f, scratch + 1,
+                   scratch_size));
+  int diff = 0;
+  for (i = 0; i < dst_y_size + dst_uv_size * 2; ++i) {
+    diff += dst_c[i] != dst_opt[i];
+  }
+
+  for (i = 0; i < src_y_size; ++i) {
+    src_16[i] &= 0xfff;
+  }
+  ScalePlane_16(src_16, src_width, src_width, src_height, dst_c_16, dst_width,
+                dst_width, dst_height, f);
+  EXPECT_EQ(0, ScaleScratch_16(src_16, src_width, src_width, src_height,
+                               dst_opt_16, dst_width, dst_width, dst_height, f,
+                               scratch, scratch_size_16));
+  for (i = 0; i < dst_y_size; ++i) {
+    diff += dst_c_16[i] != dst_opt_16[i];
+  }
+
+  // Too small a scratch is rejected rather than overrun.
+  if (scratch_size > 0) {
+    EXPECT_EQ(-1, ScaleScratch(kScalePlanPlane, src, src_width, src_width,
+                               src_height, dst_opt, dst_width, dst_width,
+                               dst_height, f, scratch, scratch_size - 64));
+  }
+  EXPECT_EQ(-1, ScaleScratch(kScalePlanPlane_16, src, src_width, src_width,
+                             src_height, dst_opt, dst_width, dst_width,
+                             dst_height, f, scratch, scratch_size_16));
+
+  // A NULL scratch allocates.
+  memset(dst_opt_16, 0, dst_y_size * 2);
+  EXPECT_EQ(0, ScaleScratch_16(src_16, src_width, src_width, src_height,
+                               dst_opt_16, dst_width, dst_width, dst_height, f,
+                               NULL, 0));
+  for (i = 0; i < dst_y_size; ++i) {
+    diff += dst_c_16[i] != dst_opt_16[i];
+  }
+
+  free_aligned_buffer_page_end(src);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+  free_aligned_buffer_page_end(scratch);
+  return diff;
+}
+
+#define TEST_SCALESCRATCH1(name, src_width, src_height, dst_width, dst_height, \
+                           filter)                                             \
+  TEST_F(LibYUVScaleTest, ScaleScratch##name##_##filter) {                     \
+    int diff = PlaneTestFilterScratch(src_width, src_height, dst_width,        \
+                                      dst_height, kFilter##filter);            \
+    ASSERT_EQ(0, diff);                                                        \
+  }
+
+#define TEST_SCALESCRATCH(name, src_width, src_height, dst_width, dst_height)  \
+  TEST_SCALESCRATCH1(name, src_width, src_height, dst_width, dst_height, None) \
+  TEST_SCALESCRATCH1(name, src_width, src_height, dst_width, dst_height,       \
+                     Bilinear)                                                 \
+  TEST_SCALESCRATCH1(name, src_width, src_height, dst_width, dst_height, Box)
+
+TEST_SCALESCRATCH(Down, 640, 360, 427, 239)
+TEST_SCALESCRATCH(DownBox, 1280, 720, 320, 171)
+TEST_SCALESCRATCH(Up, 320, 180, 641, 361)
+TEST_SCALESCRATCH(Invert, 320, -180, 213, 120)
+#undef TEST_SCALESCRATCH1
+#undef TEST_SCALESCRATCH
+
+// The ARGB and UV 1/4 box scalers use the scratch for their rows.
+TEST_F(LibYUVScaleTest, ScaleScratchDown4Box) {
+  const int kSrcWidth = 256;
+  const int kSrcHeight = 128;
+  const int kDstWidth = kSrcWidth / 4;
+  const int kDstHeight = kSrcHeight / 4;
+  align_buffer_page_end(src, kSrcWidth * kSrcHeight * 4);
+  align_buffer_page_end(dst_c, kDstWidth * kDstHeight * 4);
+  align_buffer_page_end(dst_opt, kDstWidth * kDstHeight * 4);
+  MemRandomize(src, kSrcWidth * kSrcHeight * 4);
+  for (int bpp = 2; bpp <= 4; bpp += 2) {
+    const enum ScalePlanFormat format =
+        bpp == 4 ? kScalePlanARGB : kScalePlanUV;
+    const int scratch_size = ScaleScratchSize(format, kSrcWidth, kSrcHeight,
+                                              kDstWidth, kDstHeight, kFilterBox);
+    EXPECT_LT(0, scratch_size);
+    align_buffer_page_end(scratch, scratch_size);
+    if (bpp == 4) {
+      ARGBScale(src, kSrcWidth * 4, kSrcWidth, kSrcHeight, dst_c,
+                kDstWidth * 4, kDstWidth, kDstHeight, kFilterBox);
+    } else {
+      UVScale(src, kSrcWidth * 2, kSrcWidth, kSrcHeight, dst_c, kDstWidth * 2,
+              kDstWidth, kDstHeight, kFilterBox);
+    }
+    memset(dst_opt, 0, kDstWidth * kDstHeight * bpp);
+    EXPECT_EQ(0, ScaleScratch(format, src, kSrcWidth * bpp, kSrcWidth,
+                              kSrcHeight, dst_opt, kDstWidth * bpp, kDstWidth,
+                              kDstHeight, kFilterBox, scratch, scratch_size));
+    for (int i = 0; i < kDstWidth * kDstHeight * bpp; ++i) {
+      ASSERT_EQ(dst_c[i], dst_opt[i]);
+    }
+    free_aligned_buffer_page_end(scratch);
+  }
+  free_aligned_buffer_page_end(src);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+}
+
 }  // namespace libyuv
@@ -122,6 +122,8 @@ TEST_FACTOR(4, 1, 4)
 TEST_FACTOR(3by4, 3, 4)
 TEST_FACTOR(3by8, 3, 8)
 TEST_FACTOR(3, 1, 3)
+TEST_FACTOR1(2, Bicubic, 1, 2)
+TEST_FACTOR1(3by4, Lanczos3, 3, 4)
 #undef TEST_FACTOR1
 #undef TEST_FACTOR
 #undef SX
@@ -246,4 +248,69 @@ TEST_F(LibYUVScaleTest, UVTest4x) {
   free_aligned_buffer_page_end(orig_pixels);
 }
 
+// Test that a plan, executed several times, matches UVScale.
+static int UVTestFilterPlan(int src_width,
+                            int src_height,
+                            int dst_width,
+                            int dst_height,
+                            FilterMode f) {
+  if (!SizeValid(src_width, src_height, dst_width, dst_height)) {
+    return 0;
+  }
+  int i, j;
+  const int kBpp = 2;
+  int src_stride = Abs(src_width) * kBpp;
+  int dst_stride = dst_width * kBpp;
+  int64_t src_size = src_stride * Abs(src_height);
+  int64_t dst_size = dst_stride * dst_height;
+  align_buffer_page_end(src, src_size);
+  align_buffer_page_end(dst_c, dst_size);
+  align_buffer_page_end(dst_opt, dst_size);
+
+  ScalePlan* plan = ScalePlanCreate(kScalePlanUV, src_width, src_height,
+                                    dst_width, dst_height, f);
+  EXPECT_TRUE(plan != NULL);
+  int diff = 0;
+  for (j = 0; plan && j < 2; ++j) {
+    MemRandomize(src, src_size);
+    UVScale(src, src_stride, src_width, src_height, dst_c, dst_stride,
+            dst_width, dst_height, f);
+    EXPECT_EQ(0, ScalePlanExecute(plan, src, src_stride, dst_opt, dst_stride));
+    for (i = 0; i < dst_size; ++i) {
+      diff += dst_c[i] != dst_opt[i];
+    }
+  }
+
+  ScalePlanDestroy(plan);
+  free_aligned_buffer_page_end(src);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+  return diff;
+}
+
+#define TEST_SCALEPLAN1(name, src_width, src_height, dst_width, dst_height, \
+                        filter)                                             \
+  TEST_F(LibYUVScaleTest, UVScalePlan##name##_##filter) {                   \
+    ASSERT_EQ(0, UVTestFilterPlan(src_width, src_height, dst_width,         \
+                                  dst_height, kFilter##filter));            \
+  }
+
+#define TEST_SCALEPLAN(name, src_width, src_height, dst_width, dst_height)    \
+  TEST_SCALEPLAN1(name, src_width, src_height, dst_width, dst_height, None)   \
+  TEST_SCALEPLAN1(name, src_width, src_height, dst_width, dst_height, Linear) \
+  TEST_SCALEPLAN1(name, src_width, src_height, dst_width, dst_height,         \
+                  Bilinear)                                                   \
+  TEST_SCALEPLAN1(name, src_width, src_height, dst_width, dst_height, Box)
+
+TEST_SCALEPLAN(Copy, 320, 180, 320, 180)
+TEST_SCALEPLAN(Vertical, 320, 180, 320, 97)
+TEST_SCALEPLAN(Down2, 640, 360, 320, 180)
+TEST_SCALEPLAN(Down4, 640, 360, 160, 90)
+TEST_SCALEPLAN(Down, 640, 360, 427, 239)
+TEST_SCALEPLAN(Up, 320, 180, 641, 361)
+TEST_SCALEPLAN(Up2, 320, 180, 640, 360)
+TEST_SCALEPLAN(Invert, 320, -180, 213, 120)
+#undef TEST_SCALEPLAN1
+#undef TEST_SCALEPLAN
+
 }  // namespace libyuv
@@ -0,0 +1,895 @@
+/*
+ *  Copyright 2026 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Measure throughput of row kernels and top level functions.
+// Usage: libyuv_bench [-options]
+// Reports Mpix/s and GB/s per function and resolution, with warm caches
+// (one frame reused) and cold caches (frames rotated through more memory
+// than the last level cache), as text, CSV or JSON.
+
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "libyuv/convert.h"
+#include "libyuv/convert_argb.h"
+#include "libyuv/convert_from.h"
+#include "libyuv/convert_from_argb.h"
+#include "libyuv/cpu_id.h"
+#include "libyuv/planar_functions.h"
+#include "libyuv/rotate.h"
+#include "libyuv/rotate_argb.h"
+#include "libyuv/rotate_row.h"
+#include "libyuv/row.h"
+#include "libyuv/scale.h"
+#include "libyuv/scale_argb.h"
+#include "libyuv/scale_row.h"
+#include "libyuv/scale_uv.h"
+#include "libyuv/version.h"
+#include "libyuv/video_common.h"
+
+// options
+static const char* filter_name = NULL;  // Only run benchmarks containing this.
+static const char* isa_list = "all";    // Comma separated isa names.
+static const char* output_name = NULL;  // Output file. stdout if NULL.
+static int benchmark_cpu_info = 0;  // Explicit cpu flags. 0 to use isa_list.
+static int num_iterations = 0;      // Iterations per measurement. 0 = auto.
+static double min_time = 0.25;      // Seconds per measurement for auto.
+static int llc_mbytes = 64;         // Memory rotated through for cold caches.
+static bool run_warm = true;
+static bool run_cold = true;
+static bool list_only = false;
+
+enum OutputFormat { kOutputText, kOutputCSV, kOutputJSON };
+static OutputFormat output_format = kOutputText;
+
+#define kMaxSizes 32
+static int num_sizes = 0;
+static int size_width[kMaxSizes];
+static int size_height[kMaxSizes];
+
+static const int kDefaultWidth[] = {176, 640, 1280, 1920, 3840};
+static const int kDefaultHeight[] = {144, 360, 720, 1080, 2160};
+
+static double GetTime() {
+#if defined(_WIN32)
+  LARGE_INTEGER t, f;
+  QueryPerformanceCounter(&t);
+  QueryPerformanceFrequency(&f);
+  return static_cast<double>(t.QuadPart) / static_cast<double>(f.QuadPart);
+#else
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+#endif
+}
+
+// One source and one destination buffer, each large enough for an ARGB
+// frame.  Planar formats are laid out contiguously from the start.
+struct BenchFrame {
+  int width;
+  int height;
+  uint8_t* src;
+  uint8_t* dst;
+};
+
+static size_t FrameBytes(int width, int height) {
+  return static_cast<size_t>(width) * height * 4 + 64;
+}
+
+static int HalfWidth(const BenchFrame* f) {
+  return (f->width + 1) >> 1;
+}
+
+static int HalfHeight(const BenchFrame* f) {
+  return (f->height + 1) >> 1;
+}
+
+// I420 planes of a buffer.
+static void I420Planes(const BenchFrame* f,
+                       uint8_t* buf,
+                       uint8_t** y,
+                       uint8_t** u,
+                       uint8_t** v) {
+  *y = buf;
+  *u = buf + f->width * f->height;
+  *v = *u + HalfWidth(f) * HalfHeight(f);
+}
+
+static void BenchCopyPlane(const BenchFrame* f) {
+  libyuv::CopyPlane(f->src, f->width, f->dst, f->width, f->width, f->height);
+}
+
+static void BenchI420ToARGB(const BenchFrame* f) {
+  uint8_t *y, *u, *v;
+  I420Planes(f, f->src, &y, &u, &v);
+  libyuv::I420ToARGB(y, f->width, u, HalfWidth(f), v, HalfWidth(f), f->dst,
+                     f->width * 4, f->width, f->height);
+}
+
+static void BenchNV12ToARGB(const BenchFrame* f) {
+  uint8_t* uv = f->src + f->width * f->height;
+  libyuv::NV12ToARGB(f->src, f->width, uv, HalfWidth(f) * 2, f->dst,
+                     f->width * 4, f->width, f->height);
+}
+
+static void BenchARGBToI420(const BenchFrame* f) {
+  uint8_t *y, *u, *v;
+  I420Planes(f, f->dst, &y, &u, &v);
+  libyuv::ARGBToI420(f->src, f->width * 4, y, f->width, u, HalfWidth(f), v,
+                     HalfWidth(f), f->width, f->height);
+}
+
+static void BenchI420ToNV12(const BenchFrame* f) {
+  uint8_t *y, *u, *v;
+  I420Planes(f, f->src, &y, &u, &v);
+  libyuv::I420ToNV12(y, f->width, u, HalfWidth(f), v, HalfWidth(f), f->dst,
+                     f->width, f->dst + f->width * f->height, HalfWidth(f) * 2,
+                     f->width, f->height);
+}
+
+static void BenchI444ToARGB(const BenchFrame* f) {
+  uint8_t* u = f->src + f->width * f->height;
+  uint8_t* v = u + f->width * f->height;
+  libyuv::I444ToARGB(f->src, f->width, u, f->width, v, f->width, f->dst,
+                     f->width * 4, f->width, f->height);
+}
+
+static void BenchI420ToRGB24(const BenchFrame* f) {
+  uint8_t *y, *u, *v;
+  I420Planes(f, f->src, &y, &u, &v);
+  libyuv::I420ToRGB24(y, f->width, u, HalfWidth(f), v, HalfWidth(f), f->dst,
+                      f->width * 3, f->width, f->height);
+}
+
+static void BenchARGBToNV12(const BenchFrame* f) {
+  libyuv::ARGBToNV12(f->src, f->width * 4, f->dst, f->width,
+                     f->dst + f->width * f->height, HalfWidth(f) * 2,
+                     f->width, f->height);
+}
+
+static void BenchRGB24ToARGB(const BenchFrame* f) {
+  libyuv::RGB24ToARGB(f->src, f->width * 3, f->dst, f->width * 4, f->width,
+                      f->height);
+}
+
+static void BenchARGBToRGB24(const BenchFrame* f) {
+  libyuv::ARGBToRGB24(f->src, f->width * 4, f->dst, f->width * 3, f->width,
+                      f->height);
+}
+
+static void BenchYUY2ToI420(const BenchFrame* f) {
+  uint8_t *y, *u, *v;
+  I420Planes(f, f->dst, &y, &u, &v);
+  libyuv::YUY2ToI420(f->src, HalfWidth(f) * 4, y, f->width, u, HalfWidth(f),
+                     v, HalfWidth(f), f->width, f->height);
+}
+
+static void BenchI420Mirror(const BenchFrame* f) {
+  uint8_t *src_y, *src_u, *src_v;
+  uint8_t *dst_y, *dst_u, *dst_v;
+  I420Planes(f, f->src, &src_y, &src_u, &src_v);
+  I420Planes(f, f->dst, &dst_y, &dst_u, &dst_v);
+  libyuv::I420Mirror(src_y, f->width, src_u, HalfWidth(f), src_v,
+                     HalfWidth(f), dst_y, f->width, dst_u, HalfWidth(f), dst_v,
+                     HalfWidth(f), f->width, f->height);
+}
+
+static void BenchI420Rotate90(const BenchFrame* f) {
+  uint8_t *src_y, *src_u, *src_v;
+  uint8_t *dst_y, *dst_u, *dst_v;
+  I420Planes(f, f->src, &src_y, &src_u, &src_v);
+  I420Planes(f, f->dst, &dst_y, &dst_u, &dst_v);
+  libyuv::I420Rotate(src_y, f->width, src_u, HalfWidth(f), src_v,
+                     HalfWidth(f), dst_y, f->height, dst_u, HalfHeight(f),
+                     dst_v, HalfHeight(f), f->width, f->height,
+                     libyuv::kRotate90);
+}
+
+static void BenchI420Rotate180(const BenchFrame* f) {
+  uint8_t *src_y, *src_u, *src_v;
+  uint8_t *dst_y, *dst_u, *dst_v;
+  I420Planes(f, f->src, &src_y, &src_u, &src_v);
+  I420Planes(f, f->dst, &dst_y, &dst_u, &dst_v);
+  libyuv::I420Rotate(src_y, f->width, src_u, HalfWidth(f), src_v,
+                     HalfWidth(f), dst_y, f->width, dst_u, HalfWidth(f), dst_v,
+                     HalfWidth(f), f->width, f->height, libyuv::kRotate180);
+}
+
+static void BenchI420Rotate270(const BenchFrame* f) {
+  uint8_t *src_y, *src_u, *src_v;
+  uint8_t *dst_y, *dst_u, *dst_v;
+  I420Planes(f, f->src, &src_y, &src_u, &src_v);
+  I420Planes(f, f->dst, &dst_y, &dst_u, &dst_v);
+  libyuv::I420Rotate(src_y, f->width, src_u, HalfWidth(f), src_v,
+                     HalfWidth(f), dst_y, f->height, dst_u, HalfHeight(f),
+                     dst_v, HalfHeight(f), f->width, f->height,
+                     libyuv::kRotate270);
+}
+
+static void BenchNV12ToI420Rotate90(const BenchFrame* f) {
+  uint8_t* uv = f->src + f->width * f->height;
+  uint8_t *dst_y, *dst_u, *dst_v;
+  I420Planes(f, f->dst, &dst_y, &dst_u, &dst_v);
+  libyuv::NV12ToI420Rotate(f->src, f->width, uv, HalfWidth(f) * 2, dst_y,
+                           f->height, dst_u, HalfHeight(f), dst_v,
+                           HalfHeight(f), f->width, f->height,
+                           libyuv::kRotate90);
+}
+
+static void BenchARGBRotate90(const BenchFrame* f) {
+  libyuv::ARGBRotate(f->src, f->width * 4, f->dst, f->height * 4, f->width,
+                     f->height, libyuv::kRotate90);
+}
+
+static void BenchARGBRotate180(const BenchFrame* f) {
+  libyuv::ARGBRotate(f->src, f->width * 4, f->dst, f->width * 4, f->width,
+                     f->height, libyuv::kRotate180);
+}
+
+static void I420ScaleTo(const BenchFrame* f,
+                        int dst_width,
+                        int dst_height,
+                        libyuv::FilterMode filtering) {
+  int dst_halfwidth = (dst_width + 1) >> 1;
+  int dst_halfheight = (dst_height + 1) >> 1;
+  uint8_t *src_y, *src_u, *src_v;
+  I420Planes(f, f->src, &src_y, &src_u, &src_v);
+  uint8_t* dst_y = f->dst;
+  uint8_t* dst_u = dst_y + dst_width * dst_height;
+  uint8_t* dst_v = dst_u + dst_halfwidth * dst_halfheight;
+  libyuv::I420Scale(src_y, f->width, src_u, HalfWidth(f), src_v, HalfWidth(f),
+                    f->width, f->height, dst_y, dst_width, dst_u,
+                    dst_halfwidth, dst_v, dst_halfwidth, dst_width, dst_height,
+                    filtering);
+}
+
+static void BenchI420ScaleDown2Box(const BenchFrame* f) {
+  I420ScaleTo(f, f->width / 2, f->height / 2, libyuv::kFilterBox);
+}
+
+static void BenchI420ScaleDown34Bilinear(const BenchFrame* f) {
+  I420ScaleTo(f, f->width * 3 / 4, f->height * 3 / 4, libyuv::kFilterBilinear);
+}
+
+static void BenchI420ScaleDown34Lanczos3(const BenchFrame* f) {
+  I420ScaleTo(f, f->width * 3 / 4, f->height * 3 / 4, libyuv::kFilterLanczos3);
+}
+
+static void BenchARGBScaleDown2Bilinear(const BenchFrame* f) {
+  libyuv::ARGBScale(f->src, f->width * 4, f->width, f->height, f->dst,
+                    f->width / 2 * 4, f->width / 2, f->height / 2,
+                    libyuv::kFilterBilinear);
+}
+
+static void BenchARGBScaleDown4Box(const BenchFrame* f) {
+  libyuv::ARGBScale(f->src, f->width * 4, f->width & ~3, f->height & ~3,
+                    f->dst, f->width / 4 * 4, f->width / 4, f->height / 4,
+                    libyuv::kFilterBox);
+}
+
+// Scaling up reads the top left 3/4 of the source so that the destination
+// fits in a frame.
+static void ARGBScaleUp43(const BenchFrame* f, libyuv::FilterMode filtering) {
+  libyuv::ARGBScale(f->src, f->width * 4, f->width * 3 / 4, f->height * 3 / 4,
+                    f->dst, f->width * 4, f->width, f->height, filtering);
+}
+
+static void BenchARGBScaleDown34None(const BenchFrame* f) {
+  libyuv::ARGBScale(f->src, f->width * 4, f->width, f->height, f->dst,
+                    f->width * 3 / 4 * 4, f->width * 3 / 4, f->height * 3 / 4,
+                    libyuv::kFilterNone);
+}
+
+static void BenchARGBScaleUp43Bilinear(const BenchFrame* f) {
+  ARGBScaleUp43(f, libyuv::kFilterBilinear);
+}
+
+static void BenchARGBScaleUp43Bicubic(const BenchFrame* f) {
+  ARGBScaleUp43(f, libyuv::kFilterBicubic);
+}
+
+// The UV plane of an NV12 frame.
+static void UVScaleTo(const BenchFrame* f,
+                      int src_width,
+                      int src_height,
+                      int dst_width,
+                      int dst_height,
+                      libyuv::FilterMode filtering) {
+  libyuv::UVScale(f->src, HalfWidth(f) * 2, src_width, src_height, f->dst,
+                  dst_width * 2, dst_width, dst_height, filtering);
+}
+
+static void BenchUVScaleDown34Bilinear(const BenchFrame* f) {
+  UVScaleTo(f, HalfWidth(f), HalfHeight(f), HalfWidth(f) * 3 / 4,
+            HalfHeight(f) * 3 / 4, libyuv::kFilterBilinear);
+}
+
+static void BenchUVScaleUp43Bilinear(const BenchFrame* f) {
+  UVScaleTo(f, HalfWidth(f) * 3 / 4, HalfHeight(f) * 3 / 4, HalfWidth(f),
+            HalfHeight(f), libyuv::kFilterBilinear);
+}
+
+static void BenchConvertCropScaleYUY2ToNV12(const BenchFrame* f) {
+  int dst_width = f->width / 2;
+  int dst_height = f->height / 2;
+  libyuv::ConvertCropScale(
+      f->src, FrameBytes(f->width, f->height), f->width, f->height,
+      libyuv::FOURCC_YUY2, 0, 0, f->width, f->height, f->dst, dst_width,
+      f->dst + dst_width * dst_height, (dst_width + 1) / 2 * 2, NULL, 0,
+      dst_width, dst_height, libyuv::kFilterBilinear, libyuv::FOURCC_NV12);
+}
+
+// Row kernels applied to every row of a frame.  Each picks the kernel for
+// the current cpu flags, least to most preferred, as the unit tests do.
+static void BenchI422ToARGBRow(const BenchFrame* f) {
+  void (*I422ToARGBRow)(const uint8_t* y_buf, const uint8_t* u_buf,
+                        const uint8_t* v_buf, uint8_t* rgb_buf,
+                        const struct libyuv::YuvConstants* yuvconstants,
+                        int width) = libyuv::I422ToARGBRow_C;
+#if defined(HAS_I422TOARGBROW_SSSE3)
+  if (libyuv::TestCpuFlag(libyuv::kCpuHasSSSE3)) {
+    I422ToARGBRow = libyuv::I422ToARGBRow_Any_SSSE3;
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_AVX2)
+  if (libyuv::TestCpuFlag(libyuv::kCpuHasAVX2)) {
+    I422ToARGBRow = libyuv::I422ToARGBRow_Any_AVX2;
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_AVX512BW)
+  if (libyuv::TestCpuFlag(libyuv::kCpuHasAVX512BW) &&
+      libyuv::TestCpuFlag(libyuv::kCpuHasAVX512VL)) {
+    I422ToARGBRow = libyuv::I422ToARGBRow_Any_AVX512BW;
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_NEON)
+  if (libyuv::TestCpuFlag(libyuv::kCpuHasNEON)) {
+    I422ToARGBRow = libyuv::I422ToARGBRow_Any_NEON;
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_SVE2)
+  if (libyuv::TestCpuFlag(libyuv::kCpuHasSVE2)) {
+    I422ToARGBRow = libyuv::I422ToARGBRow_SVE2;
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_LSX)
+  if (libyuv::TestCpuFlag(libyuv::kCpuHasLSX)) {
+    I422ToARGBRow = libyuv::I422ToARGBRow_Any_LSX;
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_LASX)
+  if (libyuv::TestCpuFlag(libyuv::kCpuHasLASX)) {
+    I422ToARGBRow = libyuv::I422ToARGBRow_Any_LASX;
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_RVV)
+  if (libyuv::TestCpuFlag(libyuv::kCpuHasRVV)) {
+    I422ToARGBRow = libyuv::I422ToARGBRow_RVV;
+  }
+#endif
+  uint8_t *y, *u, *v;
+  I420Planes(f, f->src, &y, &u, &v);
+  for (int i = 0; i < f->height; ++i) {
+    I422ToARGBRow(y + i * f->width, u + (i >> 1) * HalfWidth(f),
+                  v + (i >> 1) * HalfWidth(f), f->dst + i * f->width * 4,
+                  &libyuv::kYuvI601Constants, f->width);
+  }
+}
+
+static void BenchTransposeWxN(const BenchFrame* f) {
+  void (*TransposeWxN)(const uint8_t* src, int src_stride, uint8_t* dst,
+                       int dst_stride, int width) = libyuv::TransposeWx8_C;
+  int tile_rows = 8;
+#if defined(HAS_TRANSPOSEWX8_NEON)
+  if (libyuv::TestCpuFlag(libyuv::kCpuHasNEON)) {
+    TransposeWxN = libyuv::TransposeWx8_Any_NEON;
+  }
+#endif
+#if defined(HAS_TRANSPOSEWX16_NEON)
+  if (libyuv::TestCpuFlag(libyuv::kCpuHasNEON)) {
+    TransposeWxN = libyuv::TransposeWx16_Any_NEON;
+    tile_rows = 16;
+  }
+#endif
+#if defined(HAS_TRANSPOSEWX8_SSSE3)
+  if (libyuv::TestCpuFlag(libyuv::kCpuHasSSSE3)) {
+    TransposeWxN = libyuv::TransposeWx8_Any_SSSE3;
+  }
+#endif
+#if defined(HAS_TRANSPOSEWX8_FAST_SSSE3)
+  if (libyuv::TestCpuFlag(libyuv::kCpuHasSSSE3)) {
+    TransposeWxN = libyuv::TransposeWx8_Fast_Any_SSSE3;
+  }
+#endif
+#if defined(HAS_TRANSPOSEWX16_LSX)
+  if (libyuv::TestCpuFlag(libyuv::kCpuHasLSX)) {
+    TransposeWxN = libyuv::TransposeWx16_Any_LSX;
+    tile_rows = 16;
+  }
+#endif
+  for (int i = 0; i + tile_rows <= f->height; i += tile_rows) {
+    TransposeWxN(f->src + i * f->width, f->width, f->dst + i, f->height,
+                 f->width);
+  }
+}
+
+static void BenchScaleRowDown2Box(const BenchFrame* f) {
+  void (*ScaleRowDown2)(const uint8_t* src_ptr, ptrdiff_t src_stride,
+                        uint8_t* dst_ptr, int dst_width) =
+      libyuv::ScaleRowDown2Box_C;
+#if defined(HAS_SCALEROWDOWN2_NEON)
+  if (libyuv::TestCpuFlag(libyuv::kCpuHasNEON)) {
+    ScaleRowDown2 = libyuv::ScaleRowDown2Box_Any_NEON;
+  }
+#endif
+#if defined(HAS_SCALEROWDOWN2_SSSE3)
+  if (libyuv::TestCpuFlag(libyuv::kCpuHasSSSE3)) {
+    ScaleRowDown2 = libyuv::ScaleRowDown2Box_Any_SSSE3;
+  }
+#endif
+#if defined(HAS_SCALEROWDOWN2_AVX2)
+  if (libyuv::TestCpuFlag(libyuv::kCpuHasAVX2)) {
+    ScaleRowDown2 = libyuv::ScaleRowDown2Box_Any_AVX2;
+  }
+#endif
+#if defined(HAS_SCALEROWDOWN2_LSX)
+  if (libyuv::TestCpuFlag(libyuv::kCpuHasLSX)) {
+    ScaleRowDown2 = libyuv::ScaleRowDown2Box_Any_LSX;
+  }
+#endif
+#if defined(HAS_SCALEROWDOWN2_RVV)
+  if (libyuv::TestCpuFlag(libyuv::kCpuHasRVV)) {
+    ScaleRowDown2 = libyuv::ScaleRowDown2Box_RVV;
+  }
+#endif
+  int dst_width = f->width / 2;
+  for (int i = 0; i < f->height / 2; ++i) {
+    ScaleRowDown2(f->src + i * 2 * f->width, f->width,
+                  f->dst + i * dst_width, dst_width);
+  }
+}
+
+struct Benchmark {
+  const char* name;
+  const char* kind;        // "row" for kernels, "api" for functions.
+  double bytes_per_pixel;  // Bytes read and written per source pixel.
+  void (*run)(const BenchFrame* f);
+};
+
+static const Benchmark kBenchmarks[] = {
+    {"I422ToARGBRow", "row", 1 + 1 + 4, BenchI422ToARGBRow},
+    {"TransposeWxN", "row", 1 + 1, BenchTransposeWxN},
+    {"ScaleRowDown2Box", "row", 1 + 0.25, BenchScaleRowDown2Box},
+    {"CopyPlane", "api", 1 + 1, BenchCopyPlane},
+    {"I420ToARGB", "api", 1.5 + 4, BenchI420ToARGB},
+    {"NV12ToARGB", "api", 1.5 + 4, BenchNV12ToARGB},
+    {"ARGBToI420", "api", 4 + 1.5, BenchARGBToI420},
+    {"I420ToNV12", "api", 1.5 + 1.5, BenchI420ToNV12},
+    {"I444ToARGB", "api", 3 + 4, BenchI444ToARGB},
+    {"I420ToRGB24", "api", 1.5 + 3, BenchI420ToRGB24},
+    {"ARGBToNV12", "api", 4 + 1.5, BenchARGBToNV12},
+    {"RGB24ToARGB", "api", 3 + 4, BenchRGB24ToARGB},
+    {"ARGBToRGB24", "api", 4 + 3, BenchARGBToRGB24},
+    {"YUY2ToI420", "api", 2 + 1.5, BenchYUY2ToI420},
+    {"I420Mirror", "api", 1.5 + 1.5, BenchI420Mirror},
+    {"I420Rotate90", "api", 1.5 + 1.5, BenchI420Rotate90},
+    {"I420Rotate180", "api", 1.5 + 1.5, BenchI420Rotate180},
+    {"I420Rotate270", "api", 1.5 + 1.5, BenchI420Rotate270},
+    {"NV12ToI420Rotate90", "api", 1.5 + 1.5, BenchNV12ToI420Rotate90},
+    {"ARGBRotate90", "api", 4 + 4, BenchARGBRotate90},
+    {"ARGBRotate180", "api", 4 + 4, BenchARGBRotate180},
+    {"I420ScaleDown2Box", "api", 1.5 + 0.375, BenchI420ScaleDown2Box},
+    {"I420ScaleDown34Bilinear", "api", 1.5 + 0.84375,
+     BenchI420ScaleDown34Bilinear},
+    {"I420ScaleDown34Lanczos3", "api", 1.5 + 0.84375,
+     BenchI420ScaleDown34Lanczos3},
+    {"ARGBScaleDown2Bilinear", "api", 4 + 1, BenchARGBScaleDown2Bilinear},
+    {"ARGBScaleDown4Box", "api", 4 + 0.25, BenchARGBScaleDown4Box},
+    {"ARGBScaleDown34None", "api", 2.25 + 2.25, BenchARGBScaleDown34None},
+    {"ARGBScaleUp43Bilinear", "api", 2.25 + 4, BenchARGBScaleUp43Bilinear},
+    {"ARGBScaleUp43Bicubic", "api", 2.25 + 4, BenchARGBScaleUp43Bicubic},
+    {"UVScaleDown34Bilinear", "api", 0.5 + 0.28125,
+     BenchUVScaleDown34Bilinear},
+    {"UVScaleUp43Bilinear", "api", 0.28125 + 0.5, BenchUVScaleUp43Bilinear},
+    {"ConvertCropScaleYUY2ToNV12", "api", 2 + 0.375,
+     BenchConvertCropScaleYUY2ToNV12},
+};
+
+static const int kNumBenchmarks =
+    static_cast<int>(sizeof(kBenchmarks) / sizeof(kBenchmarks[0]));
+
+// Cpu flags for an isa name, as for LIBYUV_CPU_INFO.  Each level enables
+// the levels below it.  Returns 0 for an unknown name.
+static int IsaCpuInfo(const char* isa) {
+  if (!strcmp(isa, "all")) {
+    return -1;
+  }
+  if (!strcmp(isa, "c")) {
+    return 1;
+  }
+  const int x86 = libyuv::kCpuInitialized | libyuv::kCpuHasX86;
+  const int sse2 = x86 | libyuv::kCpuHasSSE2;
+  const int ssse3 = sse2 | libyuv::kCpuHasSSSE3;
+  const int sse4 = ssse3 | libyuv::kCpuHasSSE41 | libyuv::kCpuHasSSE42;
+  const int avx2 = sse4 | libyuv::kCpuHasAVX | libyuv::kCpuHasAVX2 |
+                   libyuv::kCpuHasERMS | libyuv::kCpuHasFSMR |
+                   libyuv::kCpuHasFMA3 | libyuv::kCpuHasF16C;
+  const int arm = libyuv::kCpuInitialized | libyuv::kCpuHasARM;
+  const int neon = arm | libyuv::kCpuHasNEON | libyuv::kCpuHasNeonDotProd |
+                   libyuv::kCpuHasNeonI8MM;
+  const int rvv = libyuv::kCpuInitialized | libyuv::kCpuHasRISCV |
+                  libyuv::kCpuHasRVV;
+  const int lsx = libyuv::kCpuInitialized | libyuv::kCpuHasLOONGARCH |
+                  libyuv::kCpuHasLSX;
+  if (!strcmp(isa, "sse2")) {
+    return sse2;
+  }
+  if (!strcmp(isa, "ssse3")) {
+    return ssse3;
+  }
+  if (!strcmp(isa, "sse4")) {
+    return sse4;
+  }
+  if (!strcmp(isa, "avx2")) {
+    return avx2;
+  }
+  if (!strcmp(isa, "avx512")) {
+    return avx2 | libyuv::kCpuHasAVX512BW | libyuv::kCpuHasAVX512VL |
+           libyuv::kCpuHasAVX512VNNI | libyuv::kCpuHasAVX512VBMI |
+           libyuv::kCpuHasAVX512VBMI2 | libyuv::kCpuHasAVX512VBITALG;
+  }
+  if (!strcmp(isa, "neon")) {
+    return neon;
+  }
+  if (!strcmp(isa, "sve")) {
+    return neon | libyuv::kCpuHasSVE | libyuv::kCpuHasSVE2;
+  }
+  if (!strcmp(isa, "sme")) {
+    return neon | libyuv::kCpuHasSVE | libyuv::kCpuHasSVE2 |
+           libyuv::kCpuHasSME | libyuv::kCpuHasSME2;
+  }
+  if (!strcmp(isa, "rvv")) {
+    return rvv;
+  }
+  if (!strcmp(isa, "lsx")) {
+    return lsx;
+  }
+  if (!strcmp(isa, "lasx")) {
+    return lsx | libyuv::kCpuHasLASX;
+  }
+  return 0;
+}
+
+static void PrintHelp(const char* program) {
+  printf("%s [-options]\n", program);
+  printf(" -s <width> <height> .... add a resolution to the sweep.\n");
+  printf("                          Default 176x144 to 3840x2160.\n");
+  printf(" -isa <name,...> ........ cpu features to benchmark: all (default),\n"
+         "                          c, sse2, ssse3, sse4, avx2, avx512, neon,\n"
+         "                          sve, sme, rvv, lsx, lasx.\n");
+  printf(" -cpu <flags> ........... cpu flags as for LIBYUV_CPU_INFO.\n");
+  printf(" -filter <name> ......... only benchmarks containing name.\n");
+  printf(" -iter <num> ............ iterations per measurement.\n");
+  printf(" -time <seconds> ........ time per measurement when -iter is 0.\n");
+  printf(" -llc <mbytes> .......... memory rotated through for cold cache.\n");
+  printf(" -warm .................. only measure with warm cache.\n");
+  printf(" -cold .................. only measure with cold cache.\n");
+  printf(" -csv ................... CSV output.\n");
+  printf(" -json .................. JSON output.\n");
+  printf(" -o <file> .............. write results to file.\n");
+  printf(" -list .................. list benchmarks.\n");
+  printf(" -h ..................... this help\n");
+  exit(0);
+}
+
+static void ParseOptions(int argc, const char* argv[]) {
+  const char* cpu_info = getenv("LIBYUV_CPU_INFO");
+  if (cpu_info) {
+    benchmark_cpu_info = atoi(cpu_info);  // NOLINT
+  }
+  for (int c = 1; c < argc; ++c) {
+    if (!strcmp(argv[c], "-h") || !strcmp(argv[c], "-help")) {
+      PrintHelp(argv[0]);
+    } else if (!strcmp(argv[c], "-s") && c + 2 < argc) {
+      if (num_sizes < kMaxSizes) {
+        size_width[num_sizes] = atoi(argv[++c]);    // NOLINT
+        size_height[num_sizes] = atoi(argv[++c]);   // NOLINT
+        ++num_sizes;
+      } else {
+        c += 2;
+      }
+    } else if (!strcmp(argv[c], "-isa") && c + 1 < argc) {
+      isa_list = argv[++c];
+    } else if (!strcmp(argv[c], "-cpu") && c + 1 < argc) {
+      benchmark_cpu_info = atoi(argv[++c]);  // NOLINT
+    } else if (!strcmp(argv[c], "-filter") && c + 1 < argc) {
+      filter_name = argv[++c];
+    } else if (!strcmp(argv[c], "-iter") && c + 1 < argc) {
+      num_iterations = atoi(argv[++c]);  // NOLINT
+    } else if (!strcmp(argv[c], "-time") && c + 1 < argc) {
+      min_time = atof(argv[++c]);  // NOLINT
+    } else if (!strcmp(argv[c], "-llc") && c + 1 < argc) {
+      llc_mbytes = atoi(argv[++c]);  // NOLINT
+    } else if (!strcmp(argv[c], "-warm")) {
+      run_cold = false;
+    } else if (!strcmp(argv[c], "-cold")) {
+      run_warm = false;
+    } else if (!strcmp(argv[c], "-csv")) {
+      output_format = kOutputCSV;
+    } else if (!strcmp(argv[c], "-json")) {
+      output_format = kOutputJSON;
+    } else if (!strcmp(argv[c], "-o") && c + 1 < argc) {
+      output_name = argv[++c];
+    } else if (!strcmp(argv[c], "-list")) {
+      list_only = true;
+    } else {
+      fprintf(stderr, "Unknown option. %s\n", argv[c]);
+      PrintHelp(argv[0]);
+    }
+  }
+  if (num_sizes == 0) {
+    num_sizes = static_cast<int>(sizeof(kDefaultWidth) / sizeof(int));
+    for (int i = 0; i < num_sizes; ++i) {
+      size_width[i] = kDefaultWidth[i];
+      size_height[i] = kDefaultHeight[i];
+    }
+  }
+  for (int i = 0; i < num_sizes; ++i) {
+    if (size_width[i] < 2 || size_height[i] < 2) {
+      fprintf(stderr, "Resolution incorrect %dx%d\n", size_width[i],
+              size_height[i]);
+      exit(1);
+    }
+  }
+  if (num_iterations < 0 || min_time <= 0. || llc_mbytes <= 0) {
+    fprintf(stderr, "Iterations, time or llc incorrect\n");
+    exit(1);
+  }
+  if (!run_warm && !run_cold) {
+    run_warm = run_cold = true;
+  }
+}
+
+struct BenchResult {
+  const char* isa;
+  int cpu_info;
+  const Benchmark* benchmark;
+  int width;
+  int height;
+  const char* cache;
+  int iterations;
+  double seconds;  // Per iteration.
+};
+
+static void PrintHeader(FILE* out) {
+  if (output_format == kOutputText) {
+    fprintf(out, "%-8s %-28s %-4s %11s %-5s %8s %10s %10s %8s\n", "isa",
+            "benchmark", "kind", "resolution", "cache", "iter", "ms",
+            "Mpix/s", "GB/s");
+  } else if (output_format == kOutputCSV) {
+    fprintf(out,
+            "isa,cpu_info,benchmark,kind,width,height,cache,iterations,ms,"
+            "mpix_per_s,gbytes_per_s\n");
+  } else {
+    fprintf(out, "{\n  \"version\": %d,\n  \"results\": [", LIBYUV_VERSION);
+  }
+}
+
+static void PrintResult(FILE* out, const BenchResult* r, bool first) {
+  double pixels = static_cast<double>(r->width) * r->height;
+  double mpix = pixels / r->seconds * 1e-6;
+  double gbytes = pixels * r->benchmark->bytes_per_pixel / r->seconds * 1e-9;
+  double ms = r->seconds * 1e3;
+  if (output_format == kOutputText) {
+    char resolution[32];
+    snprintf(resolution, sizeof(resolution), "%dx%d", r->width, r->height);
+    fprintf(out, "%-8s %-28s %-4s %11s %-5s %8d %10.4f %10.1f %8.2f\n",
+            r->isa, r->benchmark->name, r->benchmark->kind, resolution,
+            r->cache, r->iterations, ms, mpix, gbytes);
+  } else if (output_format == kOutputCSV) {
+    fprintf(out, "%s,0x%x,%s,%s,%d,%d,%s,%d,%.6f,%.3f,%.4f\n", r->isa,
+            r->cpu_info, r->benchmark->name, r->benchmark->kind, r->width,
+            r->height, r->cache, r->iterations, ms, mpix, gbytes);
+  } else {
+    fprintf(out,
+            "%s\n    {\"isa\": \"%s\", \"cpu_info\": %d, \"benchmark\": "
+            "\"%s\", \"kind\": \"%s\", \"width\": %d, \"height\": %d, "
+            "\"cache\": \"%s\", \"iterations\": %d, \"ms\": %.6f, "
+            "\"mpix_per_s\": %.3f, \"gbytes_per_s\": %.4f}",
+            first ? "" : ",", r->isa, r->cpu_info, r->benchmark->name,
+            r->benchmark->kind, r->width, r->height, r->cache, r->iterations,
+            ms, mpix, gbytes);
+  }
+  fflush(out);
+}
+
+static void PrintFooter(FILE* out) {
+  if (output_format == kOutputJSON) {
+    fprintf(out, "\n  ]\n}\n");
+  }
+}
+
+// Runs a benchmark over frames in turn and returns seconds per iteration.
+static double TimeBenchmark(const Benchmark* b,
+                            const BenchFrame* frames,
+                            int num_frames,
+                            int iterations) {
+  double start = GetTime();
+  for (int i = 0; i < iterations; ++i) {
+    b->run(&frames[i % num_frames]);
+  }
+  return (GetTime() - start) / iterations;
+}
+
+static int AutoIterations(double seconds, int min_iterations) {
+  int iterations = min_iterations;
+  if (seconds > 0.) {
+    double n = min_time / seconds;
+    if (n > 1000000.) {
+      n = 1000000.;
+    }
+    if (n > iterations) {
+      iterations = static_cast<int>(n);
+    }
+  }
+  return iterations;
+}
+
+static bool MatchFilter(const Benchmark* b) {
+  return !filter_name || strstr(b->name, filter_name);
+}
+
+// Runs all benchmarks for one resolution with the current cpu flags.
+static void RunResolution(FILE* out,
+                          const char* isa,
+                          int cpu_info,
+                          BenchFrame* frames,
+                          int num_frames,
+                          bool* first) {
+  for (int i = 0; i < kNumBenchmarks; ++i) {
+    const Benchmark* b = &kBenchmarks[i];
+    if (!MatchFilter(b)) {
+      continue;
+    }
+    BenchResult r;
+    r.isa = isa;
+    r.cpu_info = cpu_info;
+    r.benchmark = b;
+    r.width = frames[0].width;
+    r.height = frames[0].height;
+    if (run_warm) {
+      double seconds = TimeBenchmark(b, frames, 1, 1);
+      r.cache = "warm";
+      r.iterations = num_iterations ? num_iterations
+                                    : AutoIterations(seconds, 1);
+      r.seconds = TimeBenchmark(b, frames, 1, r.iterations);
+      PrintResult(out, &r, *first);
+      *first = false;
+    }
+    if (run_cold) {
+      // Each frame is reused only after all the others, so it has been
+      // evicted from the last level cache by then.
+      double seconds = TimeBenchmark(b, frames, num_frames, num_frames);
+      r.cache = "cold";
+      r.iterations = num_iterations ? num_iterations
+                                    : AutoIterations(seconds, num_frames);
+      r.seconds = TimeBenchmark(b, frames, num_frames, r.iterations);
+      PrintResult(out, &r, *first);
+      *first = false;
+    }
+  }
+}
+
+static void FillRandom(uint8_t* p, size_t size, uint32_t* seed) {
+  for (size_t i = 0; i < size; ++i) {
+    *seed = *seed * 1664525u + 1013904223u;
+    p[i] = static_cast<uint8_t>(*seed >> 24);
+  }
+}
+
+int main(int argc, const char* argv[]) {
+  ParseOptions(argc, argv);
+  if (list_only) {
+    for (int i = 0; i < kNumBenchmarks; ++i) {
+      if (MatchFilter(&kBenchmarks[i])) {
+        printf("%-28s %s\n", kBenchmarks[i].name, kBenchmarks[i].kind);
+      }
+    }
+    return 0;
+  }
+
+  FILE* out = stdout;
+  if (output_name) {
+    out = fopen(output_name, "w");
+    if (!out) {
+      fprintf(stderr, "Unable to open %s\n", output_name);
+      return 1;
+    }
+  }
+
+  // Split the isa list, or use the explicit cpu flags.
+  char isa_buf[256];
+  const char* isa_names[32];
+  int num_isas = 0;
+  if (benchmark_cpu_info) {
+    isa_names[num_isas++] = "cpu";
+  } else {
+    strncpy(isa_buf, isa_list, sizeof(isa_buf) - 1);
+    isa_buf[sizeof(isa_buf) - 1] = '\0';
+    for (char* name = strtok(isa_buf, ","); name && num_isas < 32;
+         name = strtok(NULL, ",")) {
+      if (!IsaCpuInfo(name)) {
+        fprintf(stderr, "Unknown isa %s\n", name);
+        return 1;
+      }
+      isa_names[num_isas++] = name;
+    }
+  }
+
+  PrintHeader(out);
+  bool first = true;
+  uint32_t seed = 0xfaceb00c;
+  for (int s = 0; s < num_sizes; ++s) {
+    int width = size_width[s];
+    int height = size_height[s];
+    size_t frame_bytes = FrameBytes(width, height);
+    int num_frames = 1;
+    if (run_cold) {
+      num_frames = static_cast<int>(
+          (static_cast<size_t>(llc_mbytes) * 1024 * 1024) / (frame_bytes * 2) +
+          2);
+    }
+    BenchFrame* frames =
+        static_cast<BenchFrame*>(malloc(num_frames * sizeof(BenchFrame)));
+    uint8_t* memory =
+        static_cast<uint8_t*>(malloc(frame_bytes * 2 * num_frames + 63));
+    if (!frames || !memory) {
+      fprintf(stderr, "Unable to allocate %d frames of %dx%d\n", num_frames,
+              width, height);
+      return 1;
+    }
+    uint8_t* aligned = reinterpret_cast<uint8_t*>(
+        (reinterpret_cast<uintptr_t>(memory) + 63) & ~63);
+    for (int i = 0; i < num_frames; ++i) {
+      frames[i].width = width;
+      frames[i].height = height;
+      frames[i].src = aligned + frame_bytes * 2 * i;
+      frames[i].dst = frames[i].src + frame_bytes;
+      FillRandom(frames[i].src, frame_bytes * 2, &seed);
+    }
+
+    for (int i = 0; i < num_isas; ++i) {
+      int cpu_info =
+          benchmark_cpu_info ? benchmark_cpu_info : IsaCpuInfo(isa_names[i]);
+      int enabled = libyuv::MaskCpuFlags(cpu_info);
+      RunResolution(out, isa_names[i], enabled, frames, num_frames, &first);
+    }
+    free(memory);
+    free(frames);
+  }
+  PrintFooter(out);
+  libyuv::MaskCpuFlags(-1);
+  if (out != stdout) {
+    fclose(out);
+  }
+  return 0;
+}
@@ -27,6 +27,7 @@ LOCAL_OBJ_FILES = \
 	source/rotate_common.o\
 	source/row_any.o\
 	source/row_common.o\
+	source/row_dispatch.o\
 	source/scale.o\
 	source/scale_any.o\
 	source/scale_argb.o\